@@ -0,0 +1,140 @@
+##########################################################################
+#
+#  Copyright (c) 2017, Image Engine Design Inc. All rights reserved.
+#
+#  Redistribution and use in source and binary forms, with or without
+#  modification, are permitted provided that the following conditions are
+#  met:
+#
+#      * Redistributions of source code must retain the above
+#        copyright notice, this list of conditions and the following
+#        disclaimer.
+#
+#      * Redistributions in binary form must reproduce the above
+#        copyright notice, this list of conditions and the following
+#        disclaimer in the documentation and/or other materials provided with
+#        the distribution.
+#
+#      * Neither the name of John Haddon nor the names of
+#        any other contributors to this software may be used to endorse or
+#        promote products derived from this software without specific prior
+#        written permission.
+#
+#  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+#  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+#  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+#  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+#  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+#  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+#  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+#  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+#  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+#  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+#  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#
+##########################################################################
+
+import os
+import sys
+import time
+
+import IECore
+
+import Gaffer
+
+class computeServer( Gaffer.Application ) :
+
+	def __init__( self ) :
+
+		Gaffer.Application.__init__(
+			self,
+			"""
+			Serves computations for a script to Gaffer sessions running on other
+			machines, allowing heavy subgraphs to be evaluated on a more powerful
+			machine. Sessions connect using a Gaffer.ComputeClient, and offload the
+			nodes flagged with "computeRemotely" metadata. The server must load the
+			same script as the clients, and must be restarted if the script is
+			edited - until then, computations which are affected by the edits are
+			performed locally by the clients.
+
+			Example usage :
+
+			```
+			gaffer computeServer -script lookdev.gfr -port 41100
+			```
+
+			And then in the client session :
+
+			```
+			Gaffer.ValuePlug.setComputeClient( Gaffer.ComputeClient( "bigserver", 41100 ) )
+			Gaffer.Metadata.registerValue( script["Box"], "computeRemotely", True )
+			```
+			"""
+		)
+
+		self.parameters().addParameters(
+
+			[
+				IECore.FileNameParameter(
+					name = "script",
+					description = "The script to serve computations for.",
+					defaultValue = "",
+					allowEmptyString = False,
+					extensions = "gfr",
+					check = IECore.FileNameParameter.CheckType.MustExist,
+				),
+
+				IECore.BoolParameter(
+					name = "ignoreScriptLoadErrors",
+					description = "Causes errors which occur while loading the script "
+						"to be ignored. Not recommended.",
+					defaultValue = False,
+				),
+
+				IECore.IntParameter(
+					name = "port",
+					description = "The port to listen on. A value of 0 picks "
+						"a free port automatically.",
+					defaultValue = 0,
+					minValue = 0,
+				),
+
+			]
+
+		)
+
+		self.parameters().userData()["parser"] = IECore.CompoundObject(
+			{
+				"flagless" : IECore.StringVectorData( [ "script" ] )
+			}
+		)
+
+	def _run( self, args ) :
+
+		scriptNode = Gaffer.ScriptNode()
+		scriptNode["fileName"].setValue( os.path.abspath( args["script"].value ) )
+		try :
+			scriptNode.load( continueOnError = args["ignoreScriptLoadErrors"].value )
+		except Exception as exception :
+			IECore.msg( IECore.Msg.Level.Error, "gaffer computeServer : loading \"%s\"" % scriptNode["fileName"].getValue(), str( exception ) )
+			return 1
+
+		self.root()["scripts"].addChild( scriptNode )
+
+		server = Gaffer.ComputeServer( scriptNode, args["port"].value )
+
+		# Clients and tests rely on this line to discover the port.
+		sys.stdout.write( "Serving on port %d\n" % server.port() )
+		sys.stdout.flush()
+
+		try :
+			while True :
+				time.sleep( 1 )
+		except KeyboardInterrupt :
+			pass
+
+		server.stop()
+
+		return 0
+
+IECore.registerRunTimeTyped( computeServer )
@@ -35,7 +35,7 @@
 #
 ##########################################################################
 
-import os, sys, traceback
+import os, sys, traceback, json, hashlib, time, fcntl
 
 import IECore
 
@@ -94,6 +94,26 @@ class execute( Gaffer.Application ) :
 					allowEmptyList = False,
 				),
 
+				IECore.BoolParameter(
+					name = "worker",
+					description = "Runs as a persistent worker process for the LocalDispatcher. "
+						"Rather than executing once and exiting, the worker reads execution "
+						"requests from stdin, one per line, and writes a reply line to stdout "
+						"as each completes. The script is kept loaded between requests, and "
+						"is only reloaded when its contents change. Anything else written to "
+						"stdout by the executed tasks is redirected to stderr.",
+					defaultValue = False,
+				),
+
+				IECore.StringParameter(
+					name = "timingsFile",
+					description = "A JSON file in which to record the average time taken "
+						"to execute a single frame of each node. This is used by dispatchers "
+						"to choose sensible task sizes for subsequent dispatches. The file "
+						"may be shared safely by many concurrent executions.",
+					defaultValue = "",
+				),
+
 				IECore.StringVectorParameter(
 					name = "context",
 					description = "The context used during execution. Note that the frames "
@@ -118,19 +138,36 @@ class execute( Gaffer.Application ) :
 
 	def _run( self, args ) :
 
+		if args["worker"].value :
+			return self.__runWorker()
+
+		scriptNode = self.__loadScript( args["script"].value, args["ignoreScriptLoadErrors"].value )
+		if scriptNode is None :
+			return 1
+
+		frames = self.parameters()["frames"].getFrameListValue().asList()
+
+		return self.__execute( scriptNode, args["nodes"], frames, args["context"], args["timingsFile"].value )
+
+	def __loadScript( self, fileName, ignoreScriptLoadErrors ) :
+
 		scriptNode = Gaffer.ScriptNode()
-		scriptNode["fileName"].setValue( os.path.abspath( args["script"].value ) )
+		scriptNode["fileName"].setValue( os.path.abspath( fileName ) )
 		try :
-			scriptNode.load( continueOnError = args["ignoreScriptLoadErrors"].value )
+			scriptNode.load( continueOnError = ignoreScriptLoadErrors )
 		except Exception as exception :
 			IECore.msg( IECore.Msg.Level.Error, "gaffer execute : loading \"%s\"" % scriptNode["fileName"].getValue(), str( exception ) )
-			return 1
+			return None
 
 		self.root()["scripts"].addChild( scriptNode )
 
+		return scriptNode
+
+	def __execute( self, scriptNode, nodeNames, frames, contextArgs, timingsFile = "" ) :
+
 		nodes = []
-		if len( args["nodes"] ) :
-			for nodeName in args["nodes"] :
+		if len( nodeNames ) :
+			for nodeName in nodeNames :
 				node = scriptNode.descendant( nodeName )
 				if node is None :
 					IECore.msg( IECore.Msg.Level.Error, "gaffer execute", "Node \"%s\" does not exist" % nodeName )
@@ -147,21 +184,22 @@ class execute( Gaffer.Application ) :
 				IECore.msg( IECore.Msg.Level.Error, "gaffer execute", "Script has no executable nodes" )
 				return 1
 
-		if len(args["context"]) % 2 :
+		if len( contextArgs ) % 2 :
 			IECore.msg( IECore.Msg.Level.Error, "gaffer execute", "Context parameter must have matching entry/value pairs" )
 			return 1
 
 		context = Gaffer.Context( scriptNode.context() )
-		for i in range( 0, len(args["context"]), 2 ) :
-			entry = args["context"][i].lstrip( "-" )
-			context[entry] = eval( args["context"][i+1] )
-
-		frames = self.parameters()["frames"].getFrameListValue().asList()
+		for i in range( 0, len( contextArgs ), 2 ) :
+			entry = contextArgs[i].lstrip( "-" )
+			context[entry] = eval( contextArgs[i+1] )
 
+		timings = {}
 		with context :
 			for node in nodes :
 				try :
+					startTime = time.time()
 					node["task"].executeSequence( frames )
+					timings[node.relativeName( scriptNode )] = ( time.time() - startTime ) / len( frames )
 				except Exception as exception :
 					IECore.msg(
 						IECore.Msg.Level.Debug,
@@ -175,6 +213,77 @@ class execute( Gaffer.Application ) :
 					)
 					return 1
 
+		if timingsFile :
+			self.__recordTimings( timingsFile, timings )
+
+		return 0
+
+	def __recordTimings( self, fileName, timings ) :
+
+		try :
+			with open( fileName, "a+" ) as f :
+				# Other executions may be updating the file
+				# at the same time, so we must lock it while
+				# we merge our timings in.
+				fcntl.flock( f, fcntl.LOCK_EX )
+				f.seek( 0 )
+				contents = f.read()
+				allTimings = json.loads( contents ) if contents else {}
+				allTimings.update( timings )
+				f.seek( 0 )
+				f.truncate()
+				f.write( json.dumps( allTimings, indent = 4 ) )
+		except ( IOError, ValueError ) as e :
+			# Failing to record timings shouldn't fail the execution.
+			IECore.msg( IECore.Msg.Level.Warning, "gaffer execute : recording timings to \"%s\"" % fileName, str( e ) )
+
+	def __runWorker( self ) :
+
+		# Keep the real stdout for our replies, and redirect
+		# everything else that would be written to it (by the
+		# tasks themselves, or by subprocesses they launch) to
+		# stderr, so that it can't be confused with a reply.
+
+		sys.stdout.flush()
+		replies = os.fdopen( os.dup( sys.stdout.fileno() ), "w", 0 )
+		os.dup2( sys.stderr.fileno(), sys.stdout.fileno() )
+
+		scriptNode = None
+		scriptKey = None
+
+		while True :
+
+			line = sys.stdin.readline()
+			if not line :
+				# The dispatcher has closed the pipe,
+				# so there's no more work for us.
+				break
+
+			request = json.loads( line )
+
+			# Reuse the script from the previous request if it has the
+			# same contents - the dispatcher writes a fresh file for each
+			# job, but consecutive jobs are frequently identical.
+
+			with open( request["script"] ) as f :
+				key = ( hashlib.md5( f.read() ).hexdigest(), request["ignoreScriptLoadErrors"] )
+
+			if key != scriptKey or scriptNode is None :
+				if scriptNode is not None :
+					self.root()["scripts"].removeChild( scriptNode )
+				scriptNode = self.__loadScript( request["script"], request["ignoreScriptLoadErrors"] )
+				scriptKey = key if scriptNode is not None else None
+			else :
+				scriptNode["fileName"].setValue( os.path.abspath( request["script"] ) )
+
+			if scriptNode is None :
+				result = 1
+			else :
+				frames = IECore.FrameList.parse( request["frames"] ).asList()
+				result = self.__execute( scriptNode, request["nodes"], frames, request["context"] )
+
+			replies.write( json.dumps( { "result" : result } ) + "\n" )
+
 		return 0
 
 IECore.registerRunTimeTyped( execute )
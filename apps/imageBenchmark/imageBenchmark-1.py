@@ -0,0 +1,520 @@
+##########################################################################
+#
+#  Copyright (c) 2017, Image Engine Design Inc. All rights reserved.
+#
+#  Redistribution and use in source and binary forms, with or without
+#  modification, are permitted provided that the following conditions are
+#  met:
+#
+#      * Redistributions of source code must retain the above
+#        copyright notice, this list of conditions and the following
+#        disclaimer.
+#
+#      * Redistributions in binary form must reproduce the above
+#        copyright notice, this list of conditions and the following
+#        disclaimer in the documentation and/or other materials provided with
+#        the distribution.
+#
+#      * Neither the name of John Haddon nor the names of
+#        any other contributors to this software may be used to endorse or
+#        promote products derived from this software without specific prior
+#        written permission.
+#
+#  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+#  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+#  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+#  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+#  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+#  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+#  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+#  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+#  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+#  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+#  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#
+##########################################################################
+
+import os
+import sys
+import json
+import time
+import fnmatch
+import shutil
+import tempfile
+import subprocess
+import collections
+
+import IECore
+
+import Gaffer
+
+class imageBenchmark( Gaffer.Application ) :
+
+	def __init__( self ) :
+
+		Gaffer.Application.__init__(
+			self,
+			"""
+			Measures the performance of the GafferImage nodes, using a standard
+			set of benchmarks. Each benchmark processes all the tiles of an image
+			and reports the throughput in megapixels per second, both from a
+			cold cache and with the node's input already cached. The timings
+			may be written to a JSON file so that they can be compared between
+			releases.
+
+			To run all benchmarks :
+
+			```
+			gaffer imageBenchmark
+			```
+
+			To run only the Blur and Resample benchmarks, writing the results
+			to a file :
+
+			```
+			gaffer imageBenchmark -benchmarks "Blur*" "Resample*" -json results.json
+			```
+
+			To measure scaling across thread counts :
+
+			```
+			gaffer imageBenchmark -threadCounts 1 2 4 8
+			```
+			"""
+		)
+
+		self.parameters().addParameters(
+
+			[
+				IECore.StringVectorParameter(
+					name = "benchmarks",
+					description = "The names of the benchmarks to run. These may "
+						"contain wildcards. Use -list to see the available benchmarks.",
+					defaultValue = IECore.StringVectorData( [ "*" ] ),
+				),
+
+				IECore.BoolParameter(
+					name = "list",
+					description = "Lists the available benchmarks without running them.",
+					defaultValue = False,
+				),
+
+				IECore.V2iParameter(
+					name = "resolution",
+					description = "The resolution of the input images.",
+					defaultValue = IECore.V2i( 2048, 1556 ),
+				),
+
+				IECore.FileNameParameter(
+					name = "inputImage",
+					description = "An image file used as the real-world input for "
+						"the benchmarks. It is resized to the benchmark resolution.",
+					defaultValue = "$GAFFER_ROOT/python/GafferImageTest/images/checker.exr",
+					allowEmptyString = False,
+				),
+
+				IECore.IntParameter(
+					name = "repeats",
+					description = "The number of times each benchmark is run. The "
+						"fastest time is reported.",
+					defaultValue = 3,
+					minValue = 1,
+				),
+
+				IECore.IntVectorParameter(
+					name = "threadCounts",
+					description = "Runs the benchmarks once for each of the specified "
+						"numbers of threads, to measure scaling. If this is not specified, "
+						"the benchmarks are run once, using the number of threads given "
+						"by -threads.",
+					defaultValue = IECore.IntVectorData(),
+				),
+
+				IECore.FileNameParameter(
+					name = "json",
+					description = "A file to write the results to, in JSON format.",
+					defaultValue = "",
+					allowEmptyString = True,
+					extensions = "json",
+				),
+
+			]
+
+		)
+
+	def _run( self, args ) :
+
+		names = [
+			n for n in _benchmarks().keys()
+			if any( fnmatch.fnmatchcase( n, p ) for p in args["benchmarks"] )
+		]
+
+		if args["list"].value :
+			for n in names :
+				print n
+			return 0
+
+		if not names :
+			IECore.msg( IECore.Msg.Level.Error, "imageBenchmark", "No benchmarks match \"%s\"" % " ".join( args["benchmarks"] ) )
+			return 1
+
+		if len( args["threadCounts"] ) :
+			results = []
+			for threads in args["threadCounts"] :
+				results.extend( self.__runSubprocess( args, threads ) )
+		else :
+			results = self.__runBenchmarks( args, names )
+
+		if args["json"].value :
+			with open( args["json"].value, "w" ) as f :
+				json.dump(
+					{
+						"gafferVersion" : Gaffer.About.versionString(),
+						"resolution" : [ args["resolution"].value.x, args["resolution"].value.y ],
+						"results" : results,
+					},
+					f, indent = 4
+				)
+
+		return 0
+
+	def __runSubprocess( self, args, threads ) :
+
+		# The size of the TBB thread pool can't be changed once it
+		# has been initialised, so we launch a separate process for
+		# each thread count.
+
+		resultsFile = tempfile.mkstemp( suffix = ".json" )
+		os.close( resultsFile[0] )
+
+		try :
+			subprocess.check_call(
+				[
+					"gaffer", "imageBenchmark",
+					"-threads", str( threads ),
+					"-benchmarks" ] + list( args["benchmarks"] ) + [
+					"-resolution", str( args["resolution"].value.x ), str( args["resolution"].value.y ),
+					"-inputImage", args["inputImage"].value,
+					"-repeats", str( args["repeats"].value ),
+					"-json", resultsFile[1],
+				]
+			)
+			with open( resultsFile[1] ) as f :
+				return json.load( f )["results"]
+		finally :
+			os.remove( resultsFile[1] )
+
+	def __runBenchmarks( self, args, names ) :
+
+		tempDir = tempfile.mkdtemp( prefix = "gafferImageBenchmark" )
+		threads = args["threads"].value or IECore.hardwareConcurrency()
+
+		print "Threads : %d\n" % threads
+
+		results = []
+		try :
+
+			for name in names :
+
+				script = Gaffer.ScriptNode()
+				inputs = _Inputs( script, args["resolution"].value, os.path.expandvars( args["inputImage"].value ) )
+				benchmark = _benchmarks()[name]( script, inputs, tempDir )
+
+				coldTime = None
+				warmTime = None
+				for i in range( 0, args["repeats"].value ) :
+
+					# Cold : nothing cached, so the input is computed
+					# as part of the benchmark.
+
+					self.__clearCaches()
+					with _Timer() as t :
+						benchmark.run()
+					coldTime = min( coldTime, t.time ) if coldTime is not None else t.time
+
+					# Warm : the input is cached, so only the
+					# node itself is computed.
+
+					self.__clearCaches()
+					benchmark.prepare()
+					with _Timer() as t :
+						benchmark.run()
+					warmTime = min( warmTime, t.time ) if warmTime is not None else t.time
+
+				megapixels = benchmark.pixels() / 1000000.0
+				result = {
+					"name" : name,
+					"threads" : threads,
+					"megapixels" : megapixels,
+					"coldTime" : coldTime,
+					"warmTime" : warmTime,
+					"coldMegapixelsPerSecond" : megapixels / max( coldTime, 1e-6 ),
+					"warmMegapixelsPerSecond" : megapixels / max( warmTime, 1e-6 ),
+				}
+				results.append( result )
+
+				print "  {name:<32}{cold:>10.2f} MP/s (cold){warm:>10.2f} MP/s (warm)".format(
+					name = name,
+					cold = result["coldMegapixelsPerSecond"],
+					warm = result["warmMegapixelsPerSecond"],
+				)
+				sys.stdout.flush()
+
+		finally :
+
+			shutil.rmtree( tempDir )
+
+		return results
+
+	def __clearCaches( self ) :
+
+		import GafferImage
+
+		Gaffer.ValuePlug.clearCache()
+		Gaffer.ValuePlug.clearHashCache()
+
+		# Shrinking the OpenImageIO cache evicts the file data it holds,
+		# so that the readers really do go back to disk.
+		limit = GafferImage.OpenImageIOReader.getCacheMemoryLimit()
+		GafferImage.OpenImageIOReader.setCacheMemoryLimit( 0 )
+		GafferImage.OpenImageIOReader.setCacheMemoryLimit( limit )
+
+# Provides the standard inputs used by the benchmarks.
+class _Inputs( object ) :
+
+	def __init__( self, script, resolution, fileName ) :
+
+		self.__script = script
+		self.__resolution = resolution
+		self.__fileName = fileName
+
+	def constant( self ) :
+
+		import GafferImage
+
+		if "constant" not in self.__script :
+			self.__script["constant"] = GafferImage.Constant()
+			self.__script["constant"]["format"].setValue( GafferImage.Format( self.__resolution.x, self.__resolution.y ) )
+			self.__script["constant"]["color"].setValue( IECore.Color4f( 0.25, 0.5, 0.75, 1 ) )
+
+		return self.__script["constant"]["out"]
+
+	def image( self ) :
+
+		import GafferImage
+
+		if "image" not in self.__script :
+			self.__script["reader"] = GafferImage.ImageReader()
+			self.__script["reader"]["fileName"].setValue( self.__fileName )
+			self.__script["image"] = GafferImage.Resize()
+			self.__script["image"]["in"].setInput( self.__script["reader"]["out"] )
+			self.__script["image"]["format"].setValue( GafferImage.Format( self.__resolution.x, self.__resolution.y ) )
+
+		return self.__script["image"]["out"]
+
+# Base class for benchmarks that process an image.
+class _ImageBenchmark( object ) :
+
+	def __init__( self, output, input ) :
+
+		self.__output = output
+		self.__input = input
+
+	def prepare( self ) :
+
+		import GafferImageTest
+		GafferImageTest.processTiles( self.__input )
+
+	def run( self ) :
+
+		import GafferImageTest
+		GafferImageTest.processTiles( self.__output )
+
+	def pixels( self ) :
+
+		return self.__output["dataWindow"].getValue().size().x * self.__output["dataWindow"].getValue().size().y
+
+# Benchmark for writing an image to disk.
+class _WriterBenchmark( object ) :
+
+	def __init__( self, writer, input ) :
+
+		self.__writer = writer
+		self.__input = input
+
+	def prepare( self ) :
+
+		import GafferImageTest
+		GafferImageTest.processTiles( self.__input )
+
+	def run( self ) :
+
+		self.__writer["task"].execute()
+
+	def pixels( self ) :
+
+		return self.__input["dataWindow"].getValue().size().x * self.__input["dataWindow"].getValue().size().y
+
+def _node( nodeType, values = {}, inputFunction = "image" ) :
+
+	def create( script, inputs, tempDir ) :
+
+		input = getattr( inputs, inputFunction )()
+		script["node"] = nodeType()
+		script["node"]["in"].setInput( input )
+		for name, value in values.items() :
+			script["node"].descendant( name ).setValue( value )
+
+		return _ImageBenchmark( script["node"]["out"], input )
+
+	return create
+
+def _merge( operation ) :
+
+	def create( script, inputs, tempDir ) :
+
+		import GafferImage
+
+		script["node"] = GafferImage.Merge()
+		script["node"]["in"][0].setInput( inputs.constant() )
+		script["node"]["in"][1].setInput( inputs.image() )
+		script["node"]["operation"].setValue( operation )
+
+		return _MergeBenchmark( script["node"]["out"], inputs )
+
+	return create
+
+# The Merge has two inputs, both of which must be
+# cached for the warm timings.
+class _MergeBenchmark( _ImageBenchmark ) :
+
+	def __init__( self, output, inputs ) :
+
+		_ImageBenchmark.__init__( self, output, inputs.image() )
+		self.__constant = inputs.constant()
+
+	def prepare( self ) :
+
+		import GafferImageTest
+		_ImageBenchmark.prepare( self )
+		GafferImageTest.processTiles( self.__constant )
+
+def _uvWarp( script, inputs, tempDir ) :
+
+	import GafferImage
+
+	script["uv"] = GafferImage.Constant()
+	script["uv"]["format"].setInput( inputs.image()["format"] )
+	script["uv"]["color"].setValue( IECore.Color4f( 0.25, 0.75, 0, 1 ) )
+
+	script["node"] = GafferImage.UVWarp()
+	script["node"]["in"].setInput( inputs.image() )
+	script["node"]["uv"].setInput( script["uv"]["out"] )
+
+	return _ImageBenchmark( script["node"]["out"], inputs.image() )
+
+def _writer( extension ) :
+
+	def create( script, inputs, tempDir ) :
+
+		import GafferImage
+
+		script["node"] = GafferImage.ImageWriter()
+		script["node"]["in"].setInput( inputs.image() )
+		script["node"]["fileName"].setValue( os.path.join( tempDir, "writerBenchmark." + extension ) )
+
+		return _WriterBenchmark( script["node"], inputs.image() )
+
+	return create
+
+def _reader( extension ) :
+
+	def create( script, inputs, tempDir ) :
+
+		import GafferImage
+
+		fileName = os.path.join( tempDir, "readerBenchmark." + extension )
+		if not os.path.exists( fileName ) :
+			script["writer"] = GafferImage.ImageWriter()
+			script["writer"]["in"].setInput( inputs.image() )
+			script["writer"]["fileName"].setValue( fileName )
+			script["writer"]["task"].execute()
+
+		script["node"] = GafferImage.ImageReader()
+		script["node"]["fileName"].setValue( fileName )
+
+		return _ReaderBenchmark( script["node"]["out"] )
+
+	return create
+
+# Benchmark for a node which has no input.
+class _ReaderBenchmark( _ImageBenchmark ) :
+
+	def __init__( self, output ) :
+
+		_ImageBenchmark.__init__( self, output, None )
+
+	def prepare( self ) :
+
+		pass
+
+# Returns an ordered dictionary mapping from benchmark name to a
+# function which creates the benchmark, with the signature
+# `f( script, inputs, tempDir )`. New benchmarks should be added
+# here.
+_registeredBenchmarks = None
+def _benchmarks() :
+
+	global _registeredBenchmarks
+	if _registeredBenchmarks is not None :
+		return _registeredBenchmarks
+
+	import GafferImage
+
+	result = collections.OrderedDict()
+
+	result["Constant"] = lambda script, inputs, tempDir : _ReaderBenchmark( inputs.constant() )
+
+	for f in GafferImage.Resample.filters() :
+		result["Resample/" + f] = _node(
+			GafferImage.Resize,
+			{ "format" : GafferImage.Format( 1024, 778 ), "filter" : f },
+		)
+
+	for radius in ( 1, 10, 50 ) :
+		result["Blur/%d" % radius] = _node( GafferImage.Blur, { "radius" : IECore.V2f( radius ) } )
+
+	for operation in ( "Add", "Multiply", "Over", "Difference" ) :
+		result["Merge/" + operation] = _merge( getattr( GafferImage.Merge.Operation, operation ) )
+
+	result["Grade"] = _node( GafferImage.Grade, { "gain" : IECore.Color3f( 2, 1.5, 1 ), "gamma" : IECore.Color3f( 1.2 ) } )
+	result["CDL"] = _node( GafferImage.CDL )
+	result["Clamp"] = _node( GafferImage.Clamp )
+	result["Premultiply"] = _node( GafferImage.Premultiply )
+	result["ColorSpace"] = _node( GafferImage.ColorSpace, { "inputSpace" : "linear", "outputSpace" : "sRGB" } )
+	result["Mirror"] = _node( GafferImage.Mirror, { "horizontal" : True, "vertical" : True } )
+	result["Offset"] = _node( GafferImage.Offset, { "offset" : IECore.V2i( 13, 17 ) } )
+	result["Crop"] = _node( GafferImage.Crop, { "area" : IECore.Box2i( IECore.V2i( 100 ), IECore.V2i( 1000 ) ) } )
+	result["ImageTransform/rotate"] = _node( GafferImage.ImageTransform, { "transform.rotate" : 15.0 } )
+	result["ImageTransform/scale"] = _node( GafferImage.ImageTransform, { "transform.scale" : IECore.V2f( 0.5 ) } )
+	result["UVWarp"] = _uvWarp
+
+	for extension in ( "exr", "tif", "jpg", "png" ) :
+		result["ImageWriter/" + extension] = _writer( extension )
+		result["ImageReader/" + extension] = _reader( extension )
+
+	_registeredBenchmarks = result
+	return result
+
+class _Timer( object ) :
+
+	def __enter__( self ) :
+
+		self.__time = time.time()
+		return self
+
+	def __exit__( self, type, value, traceBack ) :
+
+		self.time = time.time() - self.__time
+
+IECore.registerRunTimeTyped( imageBenchmark )
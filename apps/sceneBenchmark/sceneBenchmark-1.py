@@ -0,0 +1,453 @@
+##########################################################################
+#
+#  Copyright (c) 2017, Image Engine Design Inc. All rights reserved.
+#
+#  Redistribution and use in source and binary forms, with or without
+#  modification, are permitted provided that the following conditions are
+#  met:
+#
+#      * Redistributions of source code must retain the above
+#        copyright notice, this list of conditions and the following
+#        disclaimer.
+#
+#      * Redistributions in binary form must reproduce the above
+#        copyright notice, this list of conditions and the following
+#        disclaimer in the documentation and/or other materials provided with
+#        the distribution.
+#
+#      * Neither the name of John Haddon nor the names of
+#        any other contributors to this software may be used to endorse or
+#        promote products derived from this software without specific prior
+#        written permission.
+#
+#  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+#  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+#  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+#  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+#  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+#  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+#  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+#  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+#  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+#  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+#  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#
+##########################################################################
+
+import os
+import sys
+import json
+import time
+import fnmatch
+import tempfile
+import subprocess
+import collections
+
+import IECore
+
+import Gaffer
+
+class sceneBenchmark( Gaffer.Application ) :
+
+	def __init__( self ) :
+
+		Gaffer.Application.__init__(
+			self,
+			"""
+			Measures the performance of scene generation, using a set of
+			synthetic scenes of configurable size. For each scene the following
+			are timed :
+
+			- compute : A full traversal, computing every aspect of every location.
+			- hash : A full traversal, hashing but not computing each location.
+			- full : Computation of fullTransform() and fullAttributes() for every location.
+			- sets : Computation of every set.
+			- edit : A full traversal following an upstream edit, as happens
+			  during interactive rendering.
+			- render : End to end output to the "Null" renderer.
+
+			All timings other than "edit" are made with empty caches. The
+			results may be written to a JSON file so that they can be compared
+			between releases.
+
+			To run all benchmarks :
+
+			```
+			gaffer sceneBenchmark
+			```
+
+			To measure the scaling of instancer traversals across thread counts :
+
+			```
+			gaffer sceneBenchmark -benchmarks "instancer/*" -threadCounts 1 2 4 8
+			```
+			"""
+		)
+
+		self.parameters().addParameters(
+
+			[
+				IECore.StringVectorParameter(
+					name = "benchmarks",
+					description = "The names of the benchmarks to run. These may "
+						"contain wildcards. Use -list to see the available benchmarks.",
+					defaultValue = IECore.StringVectorData( [ "*" ] ),
+				),
+
+				IECore.BoolParameter(
+					name = "list",
+					description = "Lists the available benchmarks without running them.",
+					defaultValue = False,
+				),
+
+				IECore.IntParameter(
+					name = "depth",
+					description = "The depth of the deep hierarchy. Each level doubles "
+						"the number of locations.",
+					defaultValue = 12,
+					minValue = 1,
+				),
+
+				IECore.IntParameter(
+					name = "width",
+					description = "The number of children in the wide scenes. For the "
+						"instancer this is the number of points along each side of the "
+						"grid, so that width * width instances are made.",
+					defaultValue = 100,
+					minValue = 1,
+				),
+
+				IECore.IntParameter(
+					name = "attributes",
+					description = "The number of attributes assigned to each location "
+						"in the heavy attributes scene.",
+					defaultValue = 100,
+					minValue = 1,
+				),
+
+				IECore.IntParameter(
+					name = "repeats",
+					description = "The number of times each benchmark is run. The "
+						"fastest time is reported.",
+					defaultValue = 3,
+					minValue = 1,
+				),
+
+				IECore.IntVectorParameter(
+					name = "threadCounts",
+					description = "Runs the benchmarks once for each of the specified "
+						"numbers of threads, to measure scaling. If this is not specified, "
+						"the benchmarks are run once, using the number of threads given "
+						"by -threads.",
+					defaultValue = IECore.IntVectorData(),
+				),
+
+				IECore.FileNameParameter(
+					name = "json",
+					description = "A file to write the results to, in JSON format.",
+					defaultValue = "",
+					allowEmptyString = True,
+					extensions = "json",
+				),
+
+			]
+
+		)
+
+	def _run( self, args ) :
+
+		names = [
+			"%s/%s" % ( scene, measurement )
+			for scene in _scenes.keys()
+			for measurement in _measurements.keys()
+			if any( fnmatch.fnmatchcase( "%s/%s" % ( scene, measurement ), p ) for p in args["benchmarks"] )
+		]
+
+		if args["list"].value :
+			for n in names :
+				print n
+			return 0
+
+		if not names :
+			IECore.msg( IECore.Msg.Level.Error, "sceneBenchmark", "No benchmarks match \"%s\"" % " ".join( args["benchmarks"] ) )
+			return 1
+
+		if len( args["threadCounts"] ) :
+			results = []
+			for threads in args["threadCounts"] :
+				results.extend( self.__runSubprocess( args, threads ) )
+		else :
+			results = self.__runBenchmarks( args, names )
+
+		if args["json"].value :
+			with open( args["json"].value, "w" ) as f :
+				json.dump(
+					{
+						"gafferVersion" : Gaffer.About.versionString(),
+						"depth" : args["depth"].value,
+						"width" : args["width"].value,
+						"attributes" : args["attributes"].value,
+						"results" : results,
+					},
+					f, indent = 4
+				)
+
+		return 0
+
+	def __runSubprocess( self, args, threads ) :
+
+		# The size of the TBB thread pool can't be changed once it
+		# has been initialised, so we launch a separate process for
+		# each thread count.
+
+		resultsFile = tempfile.mkstemp( suffix = ".json" )
+		os.close( resultsFile[0] )
+
+		try :
+			subprocess.check_call(
+				[
+					"gaffer", "sceneBenchmark",
+					"-threads", str( threads ),
+					"-benchmarks" ] + list( args["benchmarks"] ) + [
+					"-depth", str( args["depth"].value ),
+					"-width", str( args["width"].value ),
+					"-attributes", str( args["attributes"].value ),
+					"-repeats", str( args["repeats"].value ),
+					"-json", resultsFile[1],
+				]
+			)
+			with open( resultsFile[1] ) as f :
+				return json.load( f )["results"]
+		finally :
+			os.remove( resultsFile[1] )
+
+	def __runBenchmarks( self, args, names ) :
+
+		import GafferSceneTest
+
+		threads = args["threads"].value or IECore.hardwareConcurrency()
+		print "Threads : %d\n" % threads
+
+		results = []
+		for name in names :
+
+			sceneName, measurementName = name.split( "/" )
+
+			script = Gaffer.ScriptNode()
+			scene, editPlug = _scenes[sceneName]( script, args )
+			measurement = _measurements[measurementName]
+
+			# Count the locations up front, so that throughput
+			# can be reported.
+			self.__clearCaches()
+			locations = _countLocations( scene )
+
+			bestTime = None
+			for i in range( 0, args["repeats"].value ) :
+				self.__clearCaches()
+				t = measurement( scene, editPlug )
+				bestTime = min( bestTime, t ) if bestTime is not None else t
+
+			result = {
+				"name" : name,
+				"threads" : threads,
+				"locations" : locations,
+				"time" : bestTime,
+				"locationsPerSecond" : locations / max( bestTime, 1e-6 ),
+			}
+			results.append( result )
+
+			print "  {name:<40}{time:>10.3f}s{rate:>14.0f} locations/s".format(
+				name = name, time = bestTime, rate = result["locationsPerSecond"]
+			)
+			sys.stdout.flush()
+
+		return results
+
+	def __clearCaches( self ) :
+
+		Gaffer.ValuePlug.clearCache()
+		Gaffer.ValuePlug.clearHashCache()
+
+## Scenes
+# Each is a function `f( script, args )` which adds the nodes
+# for the scene to the script and returns a tuple containing the
+# output ScenePlug and a plug to be modified for the interactive
+# edit measurement.
+##########################################################################
+
+def _deepHierarchy( script, args ) :
+
+	import GafferScene
+
+	script["sphere"] = GafferScene.Sphere()
+	lastPlug = script["sphere"]["out"]
+	for i in range( 0, args["depth"].value ) :
+		group = GafferScene.Group( "group%d" % i )
+		script.addChild( group )
+		group["in"][0].setInput( lastPlug )
+		group["in"][1].setInput( lastPlug )
+		lastPlug = group["out"]
+
+	return lastPlug, script["sphere"]["radius"]
+
+def _instancer( script, args ) :
+
+	import GafferScene
+
+	script["plane"] = GafferScene.Plane()
+	script["plane"]["divisions"].setValue( IECore.V2i( max( args["width"].value - 1, 1 ) ) )
+
+	script["sphere"] = GafferScene.Sphere()
+
+	script["instancer"] = GafferScene.Instancer()
+	script["instancer"]["in"].setInput( script["plane"]["out"] )
+	script["instancer"]["instance"].setInput( script["sphere"]["out"] )
+	script["instancer"]["parent"].setValue( "/plane" )
+
+	return script["instancer"]["out"], script["sphere"]["radius"]
+
+def _wideGroup( script, args ) :
+
+	import GafferScene
+
+	script["sphere"] = GafferScene.Sphere()
+	script["group"] = GafferScene.Group()
+	for i in range( 0, args["width"].value ) :
+		script["group"]["in"][i].setInput( script["sphere"]["out"] )
+
+	return script["group"]["out"], script["sphere"]["radius"]
+
+def _heavyAttributes( script, args ) :
+
+	import GafferScene
+
+	_wideGroup( script, args )
+
+	script["attributes"] = GafferScene.CustomAttributes()
+	script["attributes"]["in"].setInput( script["group"]["out"] )
+	for i in range( 0, args["attributes"].value ) :
+		script["attributes"]["attributes"].addMember( "user:test%d" % i, IECore.StringData( "x" * 100 ) )
+
+	script["filter"] = GafferScene.PathFilter()
+	script["filter"]["paths"].setValue( IECore.StringVectorData( [ "/group/*" ] ) )
+	script["attributes"]["filter"].setInput( script["filter"]["out"] )
+
+	return script["attributes"]["out"], script["attributes"]["attributes"][0]["value"]
+
+def _sets( script, args ) :
+
+	import GafferScene
+
+	lastPlug, editPlug = _instancer( script, args )
+	for i in range( 0, 10 ) :
+
+		filter = GafferScene.PathFilter( "setFilter%d" % i )
+		script.addChild( filter )
+		filter["paths"].setValue( IECore.StringVectorData( [ "/plane/instances/*%d" % i ] ) )
+
+		set = GafferScene.Set( "set%d" % i )
+		script.addChild( set )
+		set["name"].setValue( "set%d" % i )
+		set["in"].setInput( lastPlug )
+		set["filter"].setInput( filter["out"] )
+		lastPlug = set["out"]
+
+	return lastPlug, editPlug
+
+_scenes = collections.OrderedDict( [
+	( "deepHierarchy", _deepHierarchy ),
+	( "instancer", _instancer ),
+	( "wideGroup", _wideGroup ),
+	( "heavyAttributes", _heavyAttributes ),
+	( "sets", _sets ),
+] )
+
+## Measurements
+# Each is a function `f( scene, editPlug )` which returns
+# the time taken in seconds.
+##########################################################################
+
+def _compute( scene, editPlug ) :
+
+	import GafferSceneTest
+
+	with _Timer() as t :
+		GafferSceneTest.traverseScene( scene )
+	return t.time
+
+def _hash( scene, editPlug ) :
+
+	import GafferSceneTest
+
+	with _Timer() as t :
+		GafferSceneTest.traverseSceneHashes( scene )
+	return t.time
+
+def _full( scene, editPlug ) :
+
+	import GafferSceneTest
+
+	with _Timer() as t :
+		GafferSceneTest.traverseSceneFullTransformsAndAttributes( scene )
+	return t.time
+
+def _setsMeasurement( scene, editPlug ) :
+
+	with _Timer() as t :
+		for setName in scene.setNames() :
+			scene.set( setName, _copy = False )
+	return t.time
+
+def _edit( scene, editPlug ) :
+
+	import GafferSceneTest
+
+	GafferSceneTest.traverseScene( scene )
+
+	if isinstance( editPlug, Gaffer.StringPlug ) :
+		editPlug.setValue( editPlug.getValue() + "x" )
+	else :
+		editPlug.setValue( editPlug.getValue() + 1 )
+
+	with _Timer() as t :
+		GafferSceneTest.traverseScene( scene )
+	return t.time
+
+def _render( scene, editPlug ) :
+
+	import GafferSceneTest
+
+	with _Timer() as t :
+		GafferSceneTest.outputScene( scene, "Null" )
+	return t.time
+
+_measurements = collections.OrderedDict( [
+	( "compute", _compute ),
+	( "hash", _hash ),
+	( "full", _full ),
+	( "sets", _setsMeasurement ),
+	( "edit", _edit ),
+	( "render", _render ),
+] )
+
+def _countLocations( scene, path = "/" ) :
+
+	result = 1
+	for childName in scene.childNames( path ) :
+		result += _countLocations( scene, path.rstrip( "/" ) + "/" + str( childName ) )
+
+	return result
+
+class _Timer( object ) :
+
+	def __enter__( self ) :
+
+		self.__time = time.time()
+		return self
+
+	def __exit__( self, type, value, traceBack ) :
+
+		self.time = time.time() - self.__time
+
+IECore.registerRunTimeTyped( sceneBenchmark )
@@ -37,8 +37,12 @@
 import os
 import gc
 import sys
+import json
 import time
 import resource
+import tempfile
+import threading
+import subprocess
 import collections
 
 import IECore
@@ -75,6 +79,20 @@ class stats( Gaffer.Application ) :
 			```
 			gaffer stats fileName.gfr -image NameOfNode -performanceMonitor
 			```
+
+			To record a timeline of all processes, for viewing in
+			Chrome's `chrome://tracing` viewer :
+
+			```
+			gaffer stats fileName.gfr -scene NameOfNode -performanceMonitorTimeline timeline.json
+			```
+
+			To benchmark a scene repeatedly with cold caches, at a range of
+			thread counts, writing the results to a file for later comparison :
+
+			```
+			gaffer stats fileName.gfr -scene NameOfNode -iterations 5 -clearCaches -threadCounts 1 4 16 -json results.json
+			```
 			"""
 		)
 
@@ -102,6 +120,15 @@ class stats( Gaffer.Application ) :
 					defaultValue = "",
 				),
 
+				IECore.StringParameter(
+					name = "renderer",
+					description = "The name of a renderer to output the scene to, in the same way "
+						"as the Render node does. The statistics reported by the renderer are "
+						"printed, including the number of objects and shaders translated, and "
+						"the time spent doing so.",
+					defaultValue = "",
+				),
+
 				IECore.StringParameter(
 					name = "image",
 					description = "The name of an ImageNode or ImagePlug to examine.",
@@ -115,6 +142,25 @@ class stats( Gaffer.Application ) :
 					defaultValue = False,
 				),
 
+				IECore.BoolParameter(
+					name = "performanceMonitorNodes",
+					description = "Outputs the performance monitor statistics summed "
+						"per node, in addition to the statistics per plug. Statistics "
+						"for a node include those of any nodes it contains. Implies "
+						"-performanceMonitor.",
+					defaultValue = False,
+				),
+
+				IECore.FileNameParameter(
+					name = "performanceMonitorTimeline",
+					description = "Writes a timeline of all processes to the specified "
+						"file, in the JSON trace event format used by Chrome's "
+						"chrome://tracing viewer. Implies -performanceMonitor.",
+					defaultValue = "",
+					allowEmptyString = True,
+					extensions = "json",
+				),
+
 				IECore.IntParameter(
 					name = "maxLinesPerMetric",
 					description = "The maximum number of plugs to list for each metric "
@@ -135,7 +181,85 @@ class stats( Gaffer.Application ) :
 						"context monitor. Statistics will only be captured for this root "
 						"downwards.",
 					defaultValue = "",
-				)
+				),
+
+				IECore.BoolParameter(
+					name = "hotspotMonitor",
+					description = "Turns on a hotspot monitor, to report the most "
+						"expensive scene locations and image tiles, and the plugs "
+						"responsible for them. The number of entries listed is "
+						"controlled by -maxLinesPerMetric.",
+					defaultValue = False,
+				),
+
+				IECore.BoolParameter(
+					name = "vtuneMonitor",
+					description = "Turns on a monitor which annotates each process "
+						"with ITT task events, so that profilers such as VTune "
+						"can attribute time to individual nodes and plugs. Requires "
+						"a build of Gaffer with GafferVTune.",
+					defaultValue = False,
+				),
+
+				IECore.IntParameter(
+					name = "iterations",
+					description = "The number of times to evaluate the scene or image. "
+						"When this is greater than one, the minimum, median and maximum "
+						"times are reported in addition to the time for the first "
+						"iteration.",
+					defaultValue = 1,
+					minValue = 1,
+				),
+
+				IECore.BoolParameter(
+					name = "clearCaches",
+					description = "Clears the Gaffer and OpenImageIO caches before each "
+						"iteration, so that every iteration is measured with cold caches. "
+						"Otherwise only the first iteration is cold, and the remaining "
+						"iterations measure performance with warm caches.",
+					defaultValue = False,
+				),
+
+				IECore.IntVectorParameter(
+					name = "threadCounts",
+					description = "Evaluates the scene or image once for each of the "
+						"specified numbers of threads, to measure scaling. Each thread "
+						"count is run in a separate process, and the monitors are not "
+						"used.",
+					defaultValue = IECore.IntVectorData(),
+				),
+
+				IECore.FloatParameter(
+					name = "memorySampleInterval",
+					description = "Samples the resident set size and cache memory usage "
+						"at the specified interval (in seconds) while the scene or image "
+						"is being evaluated, and reports the peak values. The default "
+						"value of zero disables sampling.",
+					defaultValue = 0,
+					minValue = 0,
+				),
+
+				IECore.IntParameter(
+					name = "memoryLimit",
+					description = "Enables the memory governor with a total budget "
+						"for the process, specified in megabytes. The budget is shared "
+						"between the caches, which are trimmed if the process comes "
+						"under memory pressure. The governor is updated at the "
+						"-memorySampleInterval, or every second if that isn't specified. "
+						"The default value of zero leaves the caches with their "
+						"individual limits.",
+					defaultValue = 0,
+					minValue = 0,
+				),
+
+				IECore.FileNameParameter(
+					name = "json",
+					description = "A file to write the timings and memory statistics "
+						"to, in JSON format.",
+					defaultValue = "",
+					allowEmptyString = True,
+					extensions = "json",
+				),
 
 			]
 
@@ -149,8 +273,13 @@ class stats( Gaffer.Application ) :
 
 	def _run( self, args ) :
 
+		if len( args["threadCounts"] ) :
+			return self.__runThreadCounts( args )
+
 		self.__timers = collections.OrderedDict()
 		self.__memory = collections.OrderedDict()
+		self.__iterations = collections.OrderedDict()
+		self.__memorySamples = collections.OrderedDict()
 
 		self.__memory["Application"] = _Memory.maxRSS()
 
@@ -163,8 +292,13 @@ class stats( Gaffer.Application ) :
 
 		self.__memory["Script"] = _Memory.maxRSS() - self.__memory["Application"]
 
-		if args["performanceMonitor"].value :
+		if args["memoryLimit"].value :
+			Gaffer.MemoryGovernor.setMemoryLimit( args["memoryLimit"].value * 1024 * 1024 )
+			Gaffer.MemoryGovernor.update()
+
+		if args["performanceMonitor"].value or args["performanceMonitorNodes"].value or args["performanceMonitorTimeline"].value :
 			self.__performanceMonitor = Gaffer.PerformanceMonitor()
+			self.__performanceMonitor.setTimelineEnabled( bool( args["performanceMonitorTimeline"].value ) )
 		else :
 			self.__performanceMonitor = None
 
@@ -179,6 +313,21 @@ class stats( Gaffer.Application ) :
 		else :
 			self.__contextMonitor = None
 
+		if args["hotspotMonitor"].value :
+			self.__hotspotMonitor = Gaffer.HotspotMonitor( [ "scene:path", "image:tileOrigin" ] )
+		else :
+			self.__hotspotMonitor = None
+
+		if args["vtuneMonitor"].value :
+			try :
+				import GafferVTune
+			except ImportError :
+				IECore.msg( IECore.Msg.Level.Error, "stats", "GafferVTune is not available" )
+				return 1
+			self.__vtuneMonitor = GafferVTune.VTuneMonitor()
+		else :
+			self.__vtuneMonitor = None
+
 		with Gaffer.Context( script.context() ) as context :
 
 			context.setFrame( args["frame"].value )
@@ -219,12 +368,122 @@ class stats( Gaffer.Application ) :
 
 		print ""
 
+		self.__printHotspots( script, args )
+
+		print ""
+
 		self.__printContext( script, args )
 
 		print
 
+		if args["json"].value :
+			self.__writeJSON( script, args )
+
 		return 0
 
+	def __runThreadCounts( self, args ) :
+
+		# The size of the TBB thread pool can't be changed once it
+		# has been initialised, so we launch a separate process for
+		# each thread count.
+
+		results = []
+		for threads in args["threadCounts"] :
+
+			resultsFile = tempfile.mkstemp( suffix = ".json" )
+			os.close( resultsFile[0] )
+
+			command = [
+				"gaffer", "stats", args["script"].value,
+				"-threads", str( threads ),
+				"-frame", str( args["frame"].value ),
+				"-iterations", str( args["iterations"].value ),
+				"-memorySampleInterval", str( args["memorySampleInterval"].value ),
+				"-json", resultsFile[1],
+			]
+			if args["clearCaches"].value :
+				command.append( "-clearCaches" )
+			for name in ( "scene", "image" ) :
+				if args[name].value :
+					command.extend( [ "-" + name, args[name].value ] )
+
+			try :
+				if subprocess.call( command ) != 0 :
+					return 1
+				with open( resultsFile[1] ) as f :
+					results.append( json.load( f ) )
+			finally :
+				os.remove( resultsFile[1] )
+
+		items = []
+		for result in results :
+			for name, timer in result["timers"].items() :
+				if name == "Loading" :
+					continue
+				value = "%.3fs (wall)" % timer["wallTime"]
+				if name in result["iterations"] :
+					value += ", %.3fs (median %s)" % ( result["iterations"][name]["median"], result["iterations"][name]["cache"] )
+				items.append( ( "%s (%d threads)" % ( name, result["threads"] ), value ) )
+
+		print "\nThread scaling :\n"
+		self.__printItems( items )
+		print
+
+		if args["json"].value :
+			with open( args["json"].value, "w" ) as f :
+				json.dump(
+					{
+						"gafferVersion" : Gaffer.About.versionString(),
+						"script" : args["script"].value,
+						"threadCounts" : results,
+					},
+					f, indent = 4
+				)
+
+		return 0
+
+	def __writeJSON( self, script, args ) :
+
+		iterations = collections.OrderedDict()
+		for name, timers in self.__iterations.items() :
+			iterations[name] = {
+				"cache" : timers.cache,
+				"wallTimes" : [ t.wallTime for t in timers ],
+				"cpuTimes" : [ t.cpuTime for t in timers ],
+				"min" : timers.min(),
+				"median" : timers.median(),
+				"max" : timers.max(),
+			}
+
+		with open( args["json"].value, "w" ) as f :
+			json.dump(
+				{
+					"gafferVersion" : Gaffer.About.versionString(),
+					"script" : args["script"].value,
+					"frame" : args["frame"].value,
+					"threads" : args["threads"].value or IECore.hardwareConcurrency(),
+					"timers" : collections.OrderedDict(
+						( name, { "wallTime" : t.wallTime, "cpuTime" : t.cpuTime } )
+						for name, t in self.__timers.items()
+					),
+					"iterations" : iterations,
+					"memory" : collections.OrderedDict(
+						( name, int( m ) ) for name, m in self.__memory.items()
+					),
+					"memorySamples" : self.__memorySamples,
+					"hotspots" : [
+						{
+							"plug" : h.plug.relativeName( script ),
+							"variables" : { k : str( v ) for k, v in self.__hotspotVariables( h ) },
+							"count" : h.count,
+							"duration" : h.duration,
+						}
+						for h in self.__hotspotMonitor.hotspots()
+					] if self.__hotspotMonitor is not None else [],
+				},
+				f, indent = 4
+			)
+
 	def __printVersion( self, script ) :
 
 		numbers = [ Gaffer.Metadata.nodeValue( script, "serialiser:" + x + "Version" ) for x in ( "milestone", "major", "minor", "patch" ) ]
@@ -326,17 +585,40 @@ class stats( Gaffer.Application ) :
 			IECore.msg( IECore.Msg.Level.Error, "stats", "Scene \"%s\" does not exist" % args["scene"].value )
 			return
 
-		memory = _Memory.maxRSS()
-		with _Timer() as sceneTimer :
-			with self.__performanceMonitor or _NullContextManager(), self.__contextMonitor or _NullContextManager() :
-				GafferSceneTest.traverseScene( scene )
-		self.__timers["Scene generation"] = sceneTimer
-		self.__memory["Scene generation"] = _Memory.maxRSS() - memory
+		self.__evaluate( "Scene generation", lambda : GafferSceneTest.traverseScene( scene ), args )
+
+		if args["renderer"].value :
+			self.__printRenderer( scene, args )
 
 		## \todo Calculate and print scene stats
 		#  - Locations
 		#  - Unique objects, attributes etc
 
+	def __printRenderer( self, scene, args ) :
+
+		import GafferScene
+		import GafferSceneTest
+
+		rendererType = args["renderer"].value
+		if rendererType not in GafferScene.Private.IECoreScenePreview.Renderer.types() :
+			# Renderers are registered by their Gaffer modules, which
+			# may not have been imported by the script.
+			with IECore.IgnoredExceptions( ImportError ) :
+				__import__( "Gaffer" + rendererType )
+
+		if rendererType not in GafferScene.Private.IECoreScenePreview.Renderer.types() :
+			IECore.msg( IECore.Msg.Level.Error, "stats", "Renderer \"%s\" is not registered" % rendererType )
+			return
+
+		statistics = []
+		def outputScene() :
+			statistics[:] = [ GafferSceneTest.outputSceneStatistics( scene, rendererType ) ]
+
+		self.__evaluate( "Scene output", outputScene, args )
+
+		print "\nRenderer :\n"
+		self.__printItems( sorted( ( k, v.value ) for k, v in statistics[0].items() ) )
+
 	def __printImage( self, script, args ) :
 
 		import GafferImage
@@ -350,12 +632,7 @@ class stats( Gaffer.Application ) :
 			IECore.msg( IECore.Msg.Level.Error, "stats", "Image \"%s\" does not exist" % args["image"].value )
 			return
 
-		memory = _Memory.maxRSS()
-		with _Timer() as imageTimer :
-			with self.__performanceMonitor or _NullContextManager(), self.__contextMonitor or _NullContextManager() :
-				GafferImageTest.processTiles( image )
-		self.__timers["Image generation"] = imageTimer
-		self.__memory["Image generation"] = _Memory.maxRSS() - memory
+		self.__evaluate( "Image generation", lambda : GafferImageTest.processTiles( image ), args )
 		self.__memory["OIIO cache limit"] = _Memory( GafferImage.OpenImageIOReader.getCacheMemoryLimit() )
 		self.__memory["OIIO cache usage"] = _Memory( GafferImage.OpenImageIOReader.cacheMemoryUsage() )
 
@@ -368,6 +645,52 @@ class stats( Gaffer.Application ) :
 		print "\nImage :\n"
 		self.__printItems( items )
 
+	def __evaluate( self, name, function, args ) :
+
+		clearCaches = args["clearCaches"].value
+		sampleInterval = args["memorySampleInterval"].value or ( 1.0 if args["memoryLimit"].value else 0 )
+		sampler = _MemorySampler( sampleInterval ) if sampleInterval else None
+
+		memory = _Memory.maxRSS()
+		timers = []
+		with sampler or _NullContextManager() :
+			for i in range( 0, args["iterations"].value ) :
+				if clearCaches :
+					self.__clearCaches()
+				with _Timer() as timer :
+					with self.__performanceMonitor or _NullContextManager(), self.__contextMonitor or _NullContextManager(), self.__hotspotMonitor or _NullContextManager(), self.__vtuneMonitor or _NullContextManager() :
+						function()
+				timers.append( timer )
+
+		self.__timers[name] = timers[0]
+		self.__memory[name] = _Memory.maxRSS() - memory
+
+		if len( timers ) > 1 :
+			# Without `-clearCaches`, the first iteration is the only
+			# cold one, so we leave it out of the warm statistics.
+			self.__iterations[name] = _Timers(
+				timers if clearCaches else timers[1:],
+				"cold" if clearCaches else "warm"
+			)
+
+		if sampler is not None :
+			self.__memory[name + " (peak RSS)"] = _Memory( max( s["rss"] for s in sampler.samples ) )
+			self.__memory[name + " (peak cache usage)"] = _Memory( max( s["cacheUsage"] for s in sampler.samples ) )
+			self.__memorySamples[name] = sampler.samples
+
+	def __clearCaches( self ) :
+
+		Gaffer.ValuePlug.clearCache()
+		Gaffer.ValuePlug.clearHashCache()
+
+		if "GafferImage" in sys.modules :
+			# Shrinking the OpenImageIO cache evicts the file data it holds,
+			# so that the readers really do go back to disk.
+			import GafferImage
+			limit = GafferImage.OpenImageIOReader.getCacheMemoryLimit()
+			GafferImage.OpenImageIOReader.setCacheMemoryLimit( 0 )
+			GafferImage.OpenImageIOReader.setCacheMemoryLimit( limit )
+
 	def __printMemory( self ) :
 
 		objectPool = IECore.ObjectPool.defaultObjectPool()
@@ -385,6 +708,17 @@ class stats( Gaffer.Application ) :
 			( "Max resident size", _Memory.maxRSS() ),
 		] )
 
+		if Gaffer.MemoryGovernor.getMemoryLimit() :
+			items.extend( [
+				( "", "" ),
+				( "Governor limit", _Memory( Gaffer.MemoryGovernor.getMemoryLimit() ) ),
+			] )
+			for cache in Gaffer.MemoryGovernor.registeredCaches() :
+				items.extend( [
+					( "Governor %s limit" % cache, _Memory( Gaffer.MemoryGovernor.cacheMemoryLimit( cache ) ) ),
+					( "Governor %s usage" % cache, _Memory( Gaffer.MemoryGovernor.cacheMemoryUsage( cache ) ) ),
+				] )
+
 		print "Memory :\n"
 		self.__printItems( items )
 
@@ -399,12 +733,74 @@ class stats( Gaffer.Application ) :
 			print "Performance :\n"
 			self.__printItems( self.__timers.items() )
 
+			if self.__iterations :
+				items = [
+					( "%s (%d %s)" % ( name, len( timers ), timers.cache ), timers )
+					for name, timers in self.__iterations.items()
+				]
+				print "\nIterations :\n"
+				self.__printItems( items )
+
 			if self.__performanceMonitor is not None :
 				print "\n" + Gaffer.MonitorAlgo.formatStatistics(
 					self.__performanceMonitor,
 					maxLinesPerMetric = args["maxLinesPerMetric"].value
 				)
 
+				if args["performanceMonitorNodes"].value :
+					print "\n" + Gaffer.MonitorAlgo.formatNodeStatistics(
+						self.__performanceMonitor,
+						maxLinesPerMetric = args["maxLinesPerMetric"].value
+					)
+
+				if args["performanceMonitorTimeline"].value :
+					self.__performanceMonitor.writeTimeline( args["performanceMonitorTimeline"].value )
+					print "\nTimeline written to \"%s\"" % args["performanceMonitorTimeline"].value
+
+	def __printHotspots( self, script, args ) :
+
+			if self.__hotspotMonitor is None :
+				return
+
+			hotspots = self.__hotspotMonitor.hotspots()
+			printed = False
+			for title, variableName in (
+				( "Most expensive locations", "scene:path" ),
+				( "Most expensive tiles", "image:tileOrigin" ),
+			) :
+
+				items = []
+				for h in hotspots :
+					variables = dict( self.__hotspotVariables( h ) )
+					if variableName in variables :
+						items.append( (
+							"%s %s" % ( variables[variableName], h.plug.relativeName( script ) ),
+							"%.3fs (%d processes)" % ( h.duration / 1000000000.0, h.count )
+						) )
+					if len( items ) >= args["maxLinesPerMetric"].value :
+						break
+
+				if items :
+					if printed :
+						print ""
+					print "%s :\n" % title
+					self.__printItems( items )
+					printed = True
+
+	@staticmethod
+	def __hotspotVariables( hotspot ) :
+
+		result = []
+		for name in sorted( hotspot.variables.keys() ) :
+			value = hotspot.variables[name]
+			if isinstance( value, IECore.InternedStringVectorData ) :
+				value = "/" + "/".join( value )
+			else :
+				value = value.value
+			result.append( ( name, value ) )
+
+		return result
+
 	def __printContext( self, script, args ) :
 
 			if self.__contextMonitor is None :
@@ -426,19 +822,49 @@ class _Timer( object ) :
 
 	def __enter__( self ) :
 
-		self.__time = time.time()
-		self.__clock = time.clock()
+		self.wallTime = time.time()
+		self.cpuTime = time.clock()
 
 		return self
 
 	def __exit__( self, type, value, traceBack ) :
 
-		self.__time = time.time() - self.__time
-		self.__clock = time.clock() - self.__clock
+		self.wallTime = time.time() - self.wallTime
+		self.cpuTime = time.clock() - self.cpuTime
 
 	def __str__( self ) :
 
-		return "%.3fs (wall), %.3fs (CPU)" % ( self.__time, self.__clock )
+		return "%.3fs (wall), %.3fs (CPU)" % ( self.wallTime, self.cpuTime )
+
+# A list of timers from repeated iterations, providing
+# statistics on their wall times.
+class _Timers( list ) :
+
+	def __init__( self, timers, cache ) :
+
+		list.__init__( self, timers )
+		self.cache = cache
+
+	def min( self ) :
+
+		return min( t.wallTime for t in self )
+
+	def max( self ) :
+
+		return max( t.wallTime for t in self )
+
+	def median( self ) :
+
+		times = sorted( t.wallTime for t in self )
+		middle = len( times ) // 2
+		if len( times ) % 2 :
+			return times[middle]
+		else :
+			return ( times[middle-1] + times[middle] ) / 2.0
+
+	def __str__( self ) :
+
+		return "%.3fs (min), %.3fs (median), %.3fs (max)" % ( self.min(), self.median(), self.max() )
 
 class _Memory( object ) :
 
@@ -454,6 +880,21 @@ class _Memory( object ) :
 		else :
 			return cls( resource.getrusage( resource.RUSAGE_SELF ).ru_maxrss * 1024 )
 
+	## Returns the current resident set size where the platform
+	# provides it, and the maximum resident set size otherwise.
+	@classmethod
+	def currentRSS( cls ) :
+
+		try :
+			with open( "/proc/self/statm" ) as f :
+				return cls( int( f.read().split()[1] ) * resource.getpagesize() )
+		except IOError :
+			return cls.maxRSS()
+
+	def __int__( self ) :
+
+		return self.__bytes
+
 	def __str__( self ) :
 
 		return "%.3fM" % ( self.__bytes / ( 1024 * 1024. ) )
@@ -462,6 +903,51 @@ class _Memory( object ) :
 
 		return _Memory( self.__bytes - other.__bytes )
 
+# Samples memory usage on a background thread. The evaluations
+# performed by the stats app release the GIL, so this doesn't
+# hold them up.
+class _MemorySampler( object ) :
+
+	def __init__( self, interval ) :
+
+		self.__interval = interval
+		self.__stop = threading.Event()
+		self.samples = []
+
+	def __enter__( self ) :
+
+		self.__startTime = time.time()
+		self.__thread = threading.Thread( target = self.__sampleLoop )
+		self.__thread.daemon = True
+		self.__thread.start()
+
+		return self
+
+	def __exit__( self, type, value, traceBack ) :
+
+		self.__stop.set()
+		self.__thread.join()
+		self.__sample()
+
+	def __sampleLoop( self ) :
+
+		while not self.__stop.is_set() :
+			self.__sample()
+			self.__stop.wait( self.__interval )
+
+	def __sample( self ) :
+
+		# Trim the caches if we're under memory pressure. This is a
+		# no-op unless the governor has been given a limit.
+		Gaffer.MemoryGovernor.update()
+
+		self.samples.append( {
+			"time" : time.time() - self.__startTime,
+			"rss" : int( _Memory.currentRSS() ),
+			"cacheUsage" : Gaffer.ValuePlug.cacheMemoryUsage(),
+			"objectPoolUsage" : IECore.ObjectPool.defaultObjectPool().memoryUsage(),
+		} )
+
 class _NullContextManager( object ) :
 
 	def __enter__( self ) :
@@ -132,6 +132,13 @@ class Action : public IECore::RunTimeTyped
 		/// implementation before performing their own merging.
 		virtual void merge( const Action *other ) = 0;
 
+		/// May be reimplemented by derived classes to return an
+		/// estimate of the memory in bytes held by the action.
+		/// This is used to limit the memory used by the undo
+		/// queue - see ScriptNode::setUndoMemoryLimit(). The default
+		/// implementation returns the size of the Action itself.
+		virtual size_t memoryUsage() const;
+
 	private :
 
 		friend class ScriptNode;
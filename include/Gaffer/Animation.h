@@ -116,10 +116,16 @@ class Animation : public ComputeNode
 				Key previousKey( float time ) const;
 				Key nextKey( float time ) const;
 
-				typedef std::set<Key> Keys;
+				/// Keys are stored contiguously, sorted by time.
+				typedef std::vector<Key> Keys;
 				const Keys &keys() const;
 
 				float evaluate( float time ) const;
+				/// Evaluates the curve at each of `n` times, placing the
+				/// results in `results`. This is quicker than repeated calls
+				/// to evaluate(), particularly when the times are sorted,
+				/// as is typical for motion blur samples.
+				void evaluate( const float *times, float *results, size_t n ) const;
 
 				/// Output plug for evaluating the curve
 				/// over time - use this as the input to
@@ -130,6 +136,11 @@ class Animation : public ComputeNode
 			private :
 
 				void addOrRemoveKeyInternal( const Key &key );
+				// Returns the first key with time >= `time`, using `hint`
+				// as a first guess, to avoid a binary search in the common
+				// case of evaluating at successive times.
+				Keys::const_iterator lowerBound( float time, Keys::const_iterator hint ) const;
+				float evaluate( float time, Keys::const_iterator right ) const;
 
 				Keys m_keys;
 
@@ -0,0 +1,102 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2017, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//      * Redistributions of source code must retain the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer.
+//
+//      * Redistributions in binary form must reproduce the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer in the documentation and/or other materials provided with
+//        the distribution.
+//
+//      * Neither the name of John Haddon nor the names of
+//        any other contributors to this software may be used to endorse or
+//        promote products derived from this software without specific prior
+//        written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+
+#ifndef GAFFER_CANCELLER_H
+#define GAFFER_CANCELLER_H
+
+#include "tbb/atomic.h"
+
+#include "boost/noncopyable.hpp"
+
+#include "IECore/Exception.h"
+
+namespace Gaffer
+{
+
+/// Exception thrown by Canceller::check() when
+/// cancellation has been requested.
+class Cancelled : public IECore::Exception
+{
+
+	public :
+
+		Cancelled();
+
+};
+
+/// Provides a means of cancelling long running computations.
+/// A Canceller may be passed to a Context, and computations
+/// performed in that context may then poll for cancellation
+/// using `Canceller::check( context->canceller() )`, abandoning
+/// their work by throwing a Cancelled exception if it has been
+/// requested. Cancellation does not mark plugs as errored, and
+/// the results of cancelled computations are never cached.
+///
+/// It is the responsibility of the client to ensure that the
+/// Canceller outlives any Context that references it.
+class Canceller : boost::noncopyable
+{
+
+	public :
+
+		Canceller();
+
+		/// Requests cancellation. May be called
+		/// from any thread.
+		void cancel();
+		bool cancelled() const { return m_cancelled; }
+
+		/// Throws Cancelled if `canceller` is non-null and
+		/// cancellation has been requested. Cheap enough to be
+		/// called frequently from within inner loops.
+		static void check( const Canceller *canceller )
+		{
+			if( canceller && canceller->cancelled() )
+			{
+				throw Cancelled();
+			}
+		}
+
+	private :
+
+		tbb::atomic<bool> m_cancelled;
+
+};
+
+} // namespace Gaffer
+
+#endif // GAFFER_CANCELLER_H
@@ -38,6 +38,8 @@
 #ifndef GAFFER_COMPOUNDDATAPLUG_H
 #define GAFFER_COMPOUNDDATAPLUG_H
 
+#include "tbb/spin_mutex.h"
+
 #include "IECore/CompoundData.h"
 #include "IECore/CompoundObject.h"
 
@@ -121,6 +123,13 @@ class CompoundDataPlug : public Gaffer::ValuePlug
 		void fillCompoundData( IECore::CompoundDataMap &compoundDataMap ) const;
 		/// As above but fills a CompoundObjectMap instead.
 		void fillCompoundObject( IECore::CompoundObject::ObjectMap &compoundObjectMap ) const;
+		/// Returns CompoundData containing all the enabled members. When no
+		/// member can vary with context (there are no input connections
+		/// and no string substitutions) the result is computed only
+		/// once and then reused until the plug is next dirtied, so
+		/// repeated calls don't scale with the number of members.
+		/// The result must not be modified.
+		IECore::ConstCompoundDataPtr compoundData() const;
 
 		/// Creates an appropriate plug to hold the specified data.
 		/// \todo This is exposed so it may be reused elsewhere, but is there a better place for it? What about PlugType.h?
@@ -128,11 +137,34 @@ class CompoundDataPlug : public Gaffer::ValuePlug
 		/// Extracts a Data value from a plug previously created with createPlugFromData().
 		static IECore::DataPtr extractDataFromPlug( const ValuePlug *plug );
 
+		/// Reimplemented to reuse the combined hash of all members
+		/// when none of them vary with context, as for compoundData().
 		virtual IECore::MurmurHash hash() const;
 		void hash( IECore::MurmurHash &h ) const;
 
 	private :
 
+		IECore::MurmurHash hashMembers() const;
+		bool membersVaryWithContext( uint64_t dirtyCount ) const;
+		void membersChanged();
+
+		// Results reused for as long as dirtyCount() is unchanged.
+		// Each is tagged with the dirtyCount it was computed for, and
+		// a tag of 0 is never valid.
+		struct MemberCache
+		{
+			MemberCache();
+			uint64_t variesWithContextDirtyCount;
+			bool variesWithContext;
+			uint64_t hashDirtyCount;
+			IECore::MurmurHash hash;
+			uint64_t dataDirtyCount;
+			IECore::ConstCompoundDataPtr data;
+		};
+
+		mutable tbb::spin_mutex m_memberCacheMutex;
+		mutable MemberCache m_memberCache;
+
 		template<typename T>
 		static ValuePlugPtr boxValuePlug( const std::string &name, Plug::Direction direction, unsigned flags, const T *value );
 
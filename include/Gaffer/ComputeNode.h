@@ -38,9 +38,13 @@
 #ifndef GAFFER_COMPUTENODE_H
 #define GAFFER_COMPUTENODE_H
 
+#include <vector>
+
+#include "IECore/InternedString.h"
 #include "IECore/MurmurHash.h"
 
 #include "Gaffer/DependencyNode.h"
+#include "Gaffer/ValuePlug.h"
 
 namespace Gaffer
 {
@@ -77,6 +81,30 @@ class ComputeNode : public DependencyNode
 		/// Called to compute the values for output Plugs. Must be implemented to compute
 		/// an appropriate value and apply it using output->setValue().
 		virtual void compute( ValuePlug *output, const Context *context ) const = 0;
+		/// Called to determine how the results of compute() will be cached.
+		/// The default implementation returns ValuePlug::Standard. It is
+		/// essential that computes which use TBB tasks internally return
+		/// ValuePlug::TaskIsolation.
+		virtual ValuePlug::CachePolicy computeCachePolicy( const ValuePlug *output ) const;
+		/// May be implemented to declare that in the specified context, the value
+		/// of output is exactly the value of an input plug of the same type. When
+		/// a plug is returned, ValuePlug evaluates it directly in place of output,
+		/// without calling hash() or compute() and without creating cache entries
+		/// for output. It is still necessary to implement hash() and compute() to
+		/// pass through the input, because derived classes may call them directly.
+		/// This is called whenever the hash for output isn't cached, so must be
+		/// cheap. The default implementation returns NULL.
+		virtual const ValuePlug *passThrough( const ValuePlug *output, const Context *context ) const;
+		/// May be implemented to declare that in the specified context, the value
+		/// of output depends only on the context variables named in `variables`, in
+		/// which case true should be returned. Hashes are then cached without regard
+		/// to any other variables, so that contexts which differ only in unrelated
+		/// variables (the frame for a static asset, or the variables set by a Wedge)
+		/// share cache entries. Implementations must account for any variables
+		/// used by upstream nodes, and must be cheap, because this is called
+		/// before every hash cache lookup. The default implementation returns
+		/// false, meaning that output may depend on any variable.
+		virtual bool contextDependencies( const ValuePlug *output, const Context *context, std::vector<IECore::InternedString> &variables ) const;
 
 	private :
 
@@ -37,6 +37,8 @@
 #ifndef GAFFER_CONTEXT_H
 #define GAFFER_CONTEXT_H
 
+#include <vector>
+
 #include "boost/container/flat_map.hpp"
 #include "boost/signals.hpp"
 
@@ -44,6 +46,8 @@
 #include "IECore/Data.h"
 #include "IECore/MurmurHash.h"
 
+#include "Gaffer/Canceller.h"
+
 namespace Gaffer
 {
 
@@ -105,6 +109,10 @@ class Context : public IECore::RefCounted
 		/// context is const and outlives the temporary context, the constraints
 		/// required of client code are met with little effort.
 		Context( const Context &other, Ownership ownership = Copied );
+		/// As above, but additionally specifying a Canceller which may be used
+		/// to cancel computations performed in the new context. The canceller
+		/// is not owned by the context, and must outlive it.
+		Context( const Context &other, const Canceller &canceller, Ownership ownership = Copied );
 		~Context();
 
 		IE_CORE_DECLAREMEMBERPTR( Context )
@@ -172,6 +180,16 @@ class Context : public IECore::RefCounted
 		ChangedSignal &changedSignal();
 
 		IECore::MurmurHash hash() const;
+		/// Returns a hash of just the named variables, as if the
+		/// context contained nothing else. Names must not be repeated.
+		IECore::MurmurHash variablesHash( const std::vector<IECore::InternedString> &names ) const;
+
+		/// Returns the canceller for this context, which may be NULL. Long
+		/// running computations should poll for cancellation using
+		/// `Canceller::check( context->canceller() )`. The canceller is
+		/// inherited by copies of the context, and does not contribute
+		/// to the hash.
+		const Canceller *canceller() const;
 
 		bool operator == ( const Context &other ) const;
 		bool operator != ( const Context &other ) const;
@@ -213,6 +231,63 @@ class Context : public IECore::RefCounted
 		/// false, it is guaranteed that substitute( input ) == input.
 		static bool hasSubstitutions( const std::string &input );
 
+		/// A string which has been parsed in advance to locate the
+		/// substitutions it contains. This allows the same string to
+		/// be substituted repeatedly, without the cost of parsing it
+		/// each time. It is used by StringPlug to accelerate
+		/// substitutions on its value.
+		class SubstitutionTemplate
+		{
+
+			public :
+
+				SubstitutionTemplate( const std::string &input, unsigned substitutions = AllSubstitutions );
+
+				/// Returns false if substitute( substitutionTemplate )
+				/// is guaranteed to return the input string unchanged.
+				bool hasSubstitutions() const;
+				/// The names of the variables referenced directly by
+				/// the template. Note that string variables may contain
+				/// further substitutions of their own, which are not
+				/// reflected here.
+				const std::vector<IECore::InternedString> &variables() const;
+
+			private :
+
+				friend class Context;
+
+				enum TokenType
+				{
+					Literal,
+					Variable,
+					Frame,
+					Tilde
+				};
+
+				struct Token
+				{
+					TokenType type;
+					// The text for Literal tokens.
+					std::string text;
+					// The name for Variable tokens.
+					IECore::InternedString variable;
+					// The number of digits for Frame tokens.
+					int padding;
+				};
+
+				typedef std::vector<Token> Tokens;
+				Tokens m_tokens;
+				std::vector<IECore::InternedString> m_variables;
+				unsigned m_substitutions;
+				size_t m_inputSize;
+				bool m_hasSubstitutions;
+
+		};
+
+		/// Equivalent to `substitute( input, substitutions )` for the input
+		/// and substitutions the template was constructed with, but faster.
+		std::string substitute( const SubstitutionTemplate &substitutionTemplate ) const;
+
 		/// The Scope class is used to push and pop the current context on
 		/// the calling thread.
 		class Scope : boost::noncopyable
@@ -231,29 +306,103 @@ class Context : public IECore::RefCounted
 
 		};
 
+		/// The EditableScope class provides a temporary Context which
+		/// borrows all the values of an existing Context, and makes it
+		/// current on the calling thread. Values may then be set via the
+		/// scope, overriding those from the original Context. This is
+		/// the preferred way of modifying the context within a compute(),
+		/// and within the bodies of parallel loops, because it performs
+		/// no heap allocation in the common case : the temporary Contexts
+		/// are pooled per thread, and values set via the scope are written
+		/// into storage which is reused each time the same variable is set.
+		///
+		/// As for Borrowed ownership, it is the responsibility of client code
+		/// to ensure that the original Context outlives the scope.
+		class EditableScope : boost::noncopyable
+		{
+
+			public :
+
+				EditableScope( const Context *context );
+				~EditableScope();
+
+				/// Sets a variable on the temporary Context. T must be
+				/// a simple type rather than an IECore::Data derived type.
+				template<typename T>
+				void set( const IECore::InternedString &name, const T &value );
+
+				void setFrame( float frame );
+				void setTime( float timeInSeconds );
+
+				void remove( const IECore::InternedString &name );
+
+				/// Returns the temporary Context. This must not be
+				/// referenced beyond the lifetime of the scope.
+				const Context *context() const;
+
+			private :
+
+				struct Pooled;
+
+				// Returns data of the specified type for the named
+				// variable, which is owned solely by the scope and
+				// therefore may be modified freely.
+				template<typename DataType>
+				DataType *scratchData( const IECore::InternedString &name );
+				IECore::Data *scratchData( const IECore::InternedString &name, IECore::TypeId typeId );
+
+				Pooled *m_pooled;
+				Context *m_context;
+
+		};
+
 		/// Returns the current context for the calling thread.
 		static const Context *current();
 
 	private :
 
+		// Applies the ownership to all entries, after
+		// the map has been copied from another context.
+		void initOwnership( Ownership ownership );
+
+		// Used by EditableScope to reference data
+		// without taking ownership.
+		void borrow( const IECore::InternedString &name, const IECore::Data *data );
+
 		void substituteInternal( const char *s, std::string &result, const int recursionDepth, unsigned substitutions ) const;
+		void substituteVariable( const IECore::InternedString &name, std::string &result, const int recursionDepth, unsigned substitutions ) const;
+		void substituteFrame( int padding, std::string &result ) const;
+		static void substituteTilde( std::string &result );
 
 		// Storage for each entry.
 		struct Storage
 		{
-			Storage() : data( NULL ), ownership( Copied ) {}
+			Storage() : data( NULL ), ownership( Copied ), hashValid( false ) {}
 			// We reference the data with a raw pointer to avoid the compulsory
 			// overhead of an intrusive pointer.
 			const IECore::Data *data;
 			// And use this ownership flag to tell us when we need to do explicit
 			// reference count management.
 			Ownership ownership;
+			// Hash of the name and value for this entry. The hash for the
+			// whole Context is the sum of the hashes for all entries, so
+			// that changing a single entry is O(1) rather than O(entries).
+			mutable IECore::MurmurHash hash;
+			mutable bool hashValid;
 		};
 
+		// Must be called whenever the data for an entry is changed, to
+		// update the entry hash and the hash for the whole Context.
+		void entryChanged( const IECore::InternedString &name, Storage &storage );
+		static void updateEntryHash( const IECore::InternedString &name, const Storage &storage );
+
 		typedef boost::container::flat_map<IECore::InternedString, Storage> Map;
 
 		Map m_map;
 		ChangedSignal *m_changedSignal;
+		const Canceller *m_canceller;
+		// When valid, this is the sum of all the entry hashes,
+		// and all entry hashes are also valid.
 		mutable IECore::MurmurHash m_hash;
 		mutable bool m_hashValid;
 
@@ -181,7 +181,7 @@ void Context::set( const IECore::InternedString &name, const T &value )
 	Storage &s = m_map[name];
 	if( Accessor<T>().set( s, value ) )
 	{
-		m_hashValid = false;
+		entryChanged( name, s );
 		if( m_changedSignal )
 		{
 			(*m_changedSignal)( this, name );
@@ -211,6 +211,33 @@ typename Context::Accessor<T>::ResultType Context::get( const IECore::InternedSt
 	return Accessor<T>().get( it->second.data );
 }
 
+template<typename T>
+void Context::EditableScope::set( const IECore::InternedString &name, const T &value )
+{
+	typedef typename Accessor<T>::DataType DataType;
+
+	Map::const_iterator it = m_context->m_map.find( name );
+	if( it != m_context->m_map.end() )
+	{
+		const DataType *d = IECore::runTimeCast<const DataType>( it->second.data );
+		if( d && d->readable() == value )
+		{
+			// No change, so early out.
+			return;
+		}
+	}
+
+	DataType *d = scratchData<DataType>( name );
+	d->writable() = value;
+	m_context->borrow( name, d );
+}
+
+template<typename DataType>
+DataType *Context::EditableScope::scratchData( const IECore::InternedString &name )
+{
+	return static_cast<DataType *>( scratchData( name, DataType::staticTypeId() ) );
+}
+
 } // namespace Gaffer
 
 #endif // GAFFER_CONTEXT_INL
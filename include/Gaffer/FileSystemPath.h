@@ -77,6 +77,9 @@ class FileSystemPath : public Path
 		void setIncludeSequences( bool includeSequences );
 		// Returns true if the path represents a FileSequence.
 		bool isFileSequence() const;
+		// Returns true if the path is a file which could form
+		// part of a FileSequence.
+		bool isSequentialFile() const;
 		// Returns the FileSequence that represents the current leaf
 		// or NULL if this path is not a leaf, or does not represent
 		// a FileSequence.
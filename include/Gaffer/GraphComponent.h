@@ -243,6 +243,9 @@ class GraphComponent : public IECore::RunTimeTyped, public boost::signals::track
 		static std::string unprefixedTypeName( const char *typeName );
 
 		void throwIfChildRejected( const GraphComponent *potentialChild ) const;
+		// Returns the child with the specified name, using the
+		// name index if we have one and a linear search otherwise.
+		const GraphComponent *childInternal( const IECore::InternedString &name ) const;
 		void setNameInternal( const IECore::InternedString &name );
 		void addChildInternal( GraphComponentPtr child );
 		void removeChildInternal( GraphComponentPtr child, bool emitParentChanged );
@@ -262,6 +265,14 @@ class GraphComponent : public IECore::RunTimeTyped, public boost::signals::track
 		GraphComponent *m_parent;
 		ChildContainer m_children;
 
+		// Secondary index of our children by name, used to provide
+		// constant time child lookups and unique name allocation.
+		// We only build it once we have enough children for linear
+		// searches to become costly, so that the many GraphComponents
+		// with only a few children don't pay for it.
+		struct NameIndex;
+		NameIndex *m_nameIndex;
+
 };
 
 } // namespace Gaffer
@@ -0,0 +1,153 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2017, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//      * Redistributions of source code must retain the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer.
+//
+//      * Redistributions in binary form must reproduce the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer in the documentation and/or other materials provided with
+//        the distribution.
+//
+//      * Neither the name of John Haddon nor the names of
+//        any other contributors to this software may be used to endorse or
+//        promote products derived from this software without specific prior
+//        written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#ifndef GAFFER_HOTSPOTMONITOR_H
+#define GAFFER_HOTSPOTMONITOR_H
+
+#include <stack>
+#include <utility>
+#include <vector>
+
+#include "tbb/enumerable_thread_specific.h"
+
+#include "boost/unordered_map.hpp"
+#include "boost/chrono.hpp"
+
+#include "IECore/RefCounted.h"
+#include "IECore/MurmurHash.h"
+#include "IECore/CompoundData.h"
+
+#include "Gaffer/Monitor.h"
+
+namespace Gaffer
+{
+
+IE_CORE_FORWARDDECLARE( Plug )
+
+/// A monitor which attributes the time spent in hash and compute
+/// processes to individual plugs evaluated with individual values
+/// of a set of context variables. For instance, monitoring "scene:path"
+/// reveals which locations are the most expensive to generate, and
+/// monitoring "image:tileOrigin" does the same for tiles. Processes
+/// in contexts containing none of the variables are ignored.
+///
+/// Time is measured exclusively - a process is not billed for the
+/// time spent in its child processes. To keep memory usage bounded,
+/// only the most expensive hotspots are retained. Hotspots which are
+/// discarded and subsequently reappear start afresh, so the results
+/// are approximate for entries near the cutoff.
+class HotspotMonitor : public Monitor
+{
+
+	public :
+
+		HotspotMonitor( const std::vector<IECore::InternedString> &variableNames, size_t maxHotspots = 1000 );
+		virtual ~HotspotMonitor();
+
+		struct Hotspot
+		{
+
+			Hotspot();
+
+			ConstPlugPtr plug;
+			/// The values of the monitored variables
+			/// which were present in the context.
+			IECore::ConstCompoundDataPtr variables;
+			/// The number of hash and compute processes.
+			size_t count;
+			/// The exclusive time spent in those processes.
+			boost::chrono::nanoseconds duration;
+
+		};
+
+		typedef std::vector<Hotspot> Hotspots;
+
+		const std::vector<IECore::InternedString> &variableNames() const;
+		size_t maxHotspots() const;
+
+		/// Returns the most expensive hotspots, sorted in order
+		/// of decreasing duration.
+		const Hotspots &hotspots() const;
+
+	protected :
+
+		virtual void processStarted( const Process *process );
+		virtual void processFinished( const Process *process );
+
+	private :
+
+		typedef std::pair<const Plug *, IECore::MurmurHash> Key;
+		typedef boost::unordered_map<Key, Hotspot> HotspotMap;
+
+		// Keeps only the most expensive `maxHotspots()` entries.
+		void prune( HotspotMap &hotspots ) const;
+
+		// For performance reasons we accumulate our statistics into
+		// thread local storage while computations are running.
+		struct Frame
+		{
+			Key key;
+			// False if the context contained none of the
+			// variables, in which case the time is discarded.
+			bool monitored;
+			boost::chrono::nanoseconds duration;
+		};
+
+		struct ThreadData
+		{
+			HotspotMap hotspots;
+			// The top of the stack is the process we're billing
+			// the current chunk of time to.
+			std::stack<Frame> frames;
+			// The last time measurement we made.
+			boost::chrono::high_resolution_clock::time_point then;
+		};
+
+		tbb::enumerable_thread_specific<ThreadData, tbb::cache_aligned_allocator<ThreadData>, tbb::ets_key_per_instance> m_threadData;
+
+		const std::vector<IECore::InternedString> m_variableNames;
+		const size_t m_maxHotspots;
+
+		// Then when we want to query it, we collate it into m_hotspots.
+		void collate() const;
+		mutable HotspotMap m_hotspotMap;
+		mutable Hotspots m_hotspots;
+
+};
+
+} // namespace Gaffer
+
+#endif // GAFFER_HOTSPOTMONITOR_H
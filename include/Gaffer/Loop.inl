@@ -37,6 +37,7 @@
 #include "boost/bind.hpp"
 
 #include "Gaffer/Loop.h"
+#include "Gaffer/Context.h"
 
 namespace Gaffer
 {
@@ -190,8 +191,21 @@ void Loop<BaseType>::hash( const ValuePlug *output, const Context *context, IECo
 		if( index >= 0 )
 		{
 			ContextPtr tmpContext = new Context( *context, Context::Borrowed );
-			tmpContext->set<int>( indexVariable, index );
 			Context::Scope scopedContext( tmpContext.get() );
+			if( iterative( output ) && ValuePlug::getHashCacheSizeLimit() )
+			{
+				// Hashing the final iteration would recurse through every
+				// previous iteration in turn, with the depth of the stack
+				// growing with the number of iterations. Instead we hash the
+				// iterations in order, so that each one finds the hash of
+				// its predecessor in the hash cache.
+				for( int i = 0; i < index; ++i )
+				{
+					tmpContext->set<int>( indexVariable, i );
+					plug->hash();
+				}
+			}
+			tmpContext->set<int>( indexVariable, index );
 			h = plug->hash();
 		}
 		else
@@ -214,8 +228,20 @@ void Loop<BaseType>::compute( ValuePlug *output, const Context *context ) const
 		if( index >= 0 )
 		{
 			ContextPtr tmpContext = new Context( *context, Context::Borrowed );
-			tmpContext->set<int>( indexVariable, index );
 			Context::Scope scopedContext( tmpContext.get() );
+			if( iterative( output ) && ValuePlug::getCacheMemoryLimit() )
+			{
+				// As for hash(), we compute the iterations in order, so that
+				// each finds the value of its predecessor in the cache.
+				const std::vector<const ValuePlug *> plugs( 1, plug );
+				const std::vector<const Context *> contexts;
+				for( int i = 0; i < index; ++i )
+				{
+					tmpContext->set<int>( indexVariable, i );
+					ValuePlug::prefetch( plugs, contexts );
+				}
+			}
+			tmpContext->set<int>( indexVariable, index );
 			output->setFrom( plug );
 		}
 		else
@@ -396,4 +422,15 @@ const ValuePlug *Loop<BaseType>::sourcePlug( const ValuePlug *output, const Cont
 	return NULL;
 }
 
+template<typename BaseType>
+bool Loop<BaseType>::iterative( const ValuePlug *output ) const
+{
+	// We only iterate when evaluating the output of the loop. Evaluations
+	// of previousPlug() are made from within the loop body, and will find
+	// their predecessors cached already if the output is being evaluated.
+	// Iterating for them too would give quadratic behaviour.
+	std::vector<IECore::InternedString> relativeName;
+	return ancestorPlug( output, relativeName ) == outPlugInternal();
+}
+
 } // namespace Gaffer
@@ -0,0 +1,105 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2017, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//      * Redistributions of source code must retain the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer.
+//
+//      * Redistributions in binary form must reproduce the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer in the documentation and/or other materials provided with
+//        the distribution.
+//
+//      * Neither the name of John Haddon nor the names of
+//        any other contributors to this software may be used to endorse or
+//        promote products derived from this software without specific prior
+//        written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#ifndef GAFFER_MEMORYGOVERNOR_H
+#define GAFFER_MEMORYGOVERNOR_H
+
+#include <string>
+#include <vector>
+
+#include "boost/function.hpp"
+
+namespace Gaffer
+{
+
+/// Coordinates the memory limits of the various caches used by Gaffer,
+/// so that together they respect a single memory budget for the whole
+/// process. Each cache is registered with a relative priority, and
+/// update() divides the memory that isn't being used by the rest of the
+/// process between the caches according to those priorities. Calling
+/// update() periodically therefore trims the caches when the process
+/// comes under memory pressure, and lets them grow again when the
+/// pressure is relieved.
+///
+/// The governor is disabled by default, in which case the caches keep
+/// whatever limits they have been given individually.
+class MemoryGovernor
+{
+
+	public :
+
+		/// Returns the memory currently used by a cache, in bytes.
+		typedef boost::function<size_t ()> UsageFunction;
+		/// Sets the memory limit for a cache, in bytes.
+		typedef boost::function<void ( size_t )> SetLimitFunction;
+
+		/// Registers a cache to be governed. If a cache is already
+		/// registered with the same name it is replaced.
+		static void registerCache( const std::string &name, UsageFunction usage, SetLimitFunction setLimit, float priority = 1.0f );
+		static void deregisterCache( const std::string &name );
+		static std::vector<std::string> registeredCaches();
+
+		/// Relative priorities determine the share of the budget given
+		/// to each cache. A cache with priority 2 is given twice as much
+		/// memory as a cache with priority 1, and a cache with priority
+		/// 0 is given none at all.
+		static void setPriority( const std::string &name, float priority );
+		static float getPriority( const std::string &name );
+
+		/// The total memory budget in bytes. A limit of 0 disables
+		/// the governor.
+		static void setMemoryLimit( size_t bytes );
+		static size_t getMemoryLimit();
+
+		/// Recomputes the cache limits from the current memory usage and
+		/// applies them. Does nothing if the governor is disabled.
+		static void update();
+
+		/// Returns the usage reported by a registered cache.
+		static size_t cacheMemoryUsage( const std::string &name );
+		/// Returns the limit most recently applied to a cache by update(),
+		/// or 0 if none has been applied.
+		static size_t cacheMemoryLimit( const std::string &name );
+
+		/// Returns the resident set size of the process in bytes, or 0 if
+		/// it can't be determined on this platform.
+		static size_t processMemoryUsage();
+
+};
+
+} // namespace Gaffer
+
+#endif // GAFFER_MEMORYGOVERNOR_H
@@ -37,12 +37,15 @@
 #ifndef GAFFER_MONITOR_H
 #define GAFFER_MONITOR_H
 
+#include <cstddef>
+
 #include "boost/noncopyable.hpp"
 
 namespace Gaffer
 {
 
 class Process;
+class Plug;
 
 /// Base class for monitoring node graph processes.
 class Monitor : boost::noncopyable
@@ -53,6 +56,20 @@ class Monitor : boost::noncopyable
 		Monitor();
 		virtual ~Monitor();
 
+		/// Interactions with the caches maintained by ValuePlug,
+		/// as reported to cacheEvent().
+		enum CacheEvent
+		{
+			/// A hash was retrieved from the hash cache.
+			HashCacheHit,
+			/// A value was retrieved from the compute cache.
+			ComputeCacheHit,
+			/// A value was not found in the compute cache.
+			ComputeCacheMiss,
+			/// A value was stored in the compute cache.
+			ComputeCacheStore
+		};
+
 		void setActive( bool active );
 		bool getActive() const;
 
@@ -81,6 +98,12 @@ class Monitor : boost::noncopyable
 		virtual void processStarted( const Process *process ) = 0;
 		/// Implementations must be safe to call concurrently.
 		virtual void processFinished( const Process *process ) = 0;
+		/// Called when a cache is used on behalf of a plug. For
+		/// ComputeCacheStore events, `bytes` is the memory usage of
+		/// the stored value, and for all other events it is 0. The
+		/// default implementation does nothing. Implementations must
+		/// be safe to call concurrently.
+		virtual void cacheEvent( CacheEvent event, const Plug *plug, size_t bytes );
 
 };
 
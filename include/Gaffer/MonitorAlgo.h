@@ -58,14 +58,22 @@ enum PerformanceMetric
 	HashCount,
 	ComputeCount,
 	HashesPerCompute,
+	HashCacheHitRate,
+	ComputeCacheHitRate,
+	CacheBytesStored,
+	BytesAllocated,
 
 	First = TotalDuration,
-	Last = HashesPerCompute
+	Last = BytesAllocated
 };
 
 std::string formatStatistics( const PerformanceMonitor &monitor, size_t maxLinesPerMetric = 50 );
 std::string formatStatistics( const PerformanceMonitor &monitor, PerformanceMetric metric, size_t maxLines = 50 );
 
+/// As above, but using the statistics rolled up per node.
+std::string formatNodeStatistics( const PerformanceMonitor &monitor, size_t maxLinesPerMetric = 50 );
+std::string formatNodeStatistics( const PerformanceMonitor &monitor, PerformanceMetric metric, size_t maxLines = 50 );
+
 } // namespace MonitorAlgo
 
 /// \todo Remove this temporary backwards compatibility.
@@ -0,0 +1,115 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2017, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//      * Redistributions of source code must retain the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer.
+//
+//      * Redistributions in binary form must reproduce the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer in the documentation and/or other materials provided with
+//        the distribution.
+//
+//      * Neither the name of John Haddon nor the names of
+//        any other contributors to this software may be used to endorse or
+//        promote products derived from this software without specific prior
+//        written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#ifndef GAFFER_NUMA_H
+#define GAFFER_NUMA_H
+
+#include "boost/noncopyable.hpp"
+
+#include "tbb/task_arena.h"
+
+namespace Gaffer
+{
+
+/// Provides optional NUMA awareness for machines with more than one
+/// memory node, such as multi-socket render nodes. When enabled by
+/// setting the GAFFER_NUMA environment variable to 1, a task arena is
+/// created for each node, and the TBB threads working in an arena are
+/// pinned to the processors of its node. Parallel algorithms such as
+/// ImageAlgo::parallelProcessTiles() and SceneAlgo::parallelProcessLocations()
+/// then partition their work between the arenas, so that each socket
+/// works on its own portion of the image or scene. Because memory is
+/// placed on the node of the thread that first touches it, the tiles
+/// and cache entries computed by a socket are then local to it.
+///
+/// Work launched from within one of the arenas is never repartitioned,
+/// so nested parallelism stays on the node that launched it.
+class NUMA
+{
+
+	public :
+
+		/// Returns the number of nodes that work is partitioned between.
+		/// This is 1 unless NUMA awareness has been enabled and more than
+		/// one node with available processors was found.
+		static size_t numNodes();
+		/// Returns the number of processors available to a node.
+		static size_t nodeConcurrency( size_t node );
+		/// Returns the node the calling thread is working for, or -1 if
+		/// it isn't running in one of the per-node arenas.
+		static int currentNode();
+		/// Returns true if parallel work launched from the calling thread
+		/// should be partitioned between nodes.
+		static bool partitionWork();
+
+		/// Returns the arena for a node, or NULL if NUMA awareness is
+		/// disabled.
+		static tbb::task_arena *arena( size_t node );
+
+		/// Calls `f( node )` concurrently for each node, each call running
+		/// in the node's arena, and waits for all the calls to complete.
+		/// Must only be used when partitionWork() returns true.
+		template<typename F>
+		static void parallelForNodes( F &f );
+
+	private :
+
+		// Marks the calling thread as working for a node for
+		// the lifetime of the scope.
+		class ScopedCurrentNode : boost::noncopyable
+		{
+
+			public :
+
+				ScopedCurrentNode( int node );
+				~ScopedCurrentNode();
+
+			private :
+
+				int m_previousNode;
+
+		};
+
+		template<typename F>
+		struct NodeTask;
+
+};
+
+} // namespace Gaffer
+
+#include "Gaffer/NUMA.inl"
+
+#endif // GAFFER_NUMA_H
@@ -0,0 +1,157 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2017, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//      * Redistributions of source code must retain the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer.
+//
+//      * Redistributions in binary form must reproduce the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer in the documentation and/or other materials provided with
+//        the distribution.
+//
+//      * Neither the name of John Haddon nor the names of
+//        any other contributors to this software may be used to endorse or
+//        promote products derived from this software without specific prior
+//        written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#ifndef GAFFER_NUMA_INL
+#define GAFFER_NUMA_INL
+
+#include "boost/scoped_array.hpp"
+
+#include "tbb/task_group.h"
+
+namespace Gaffer
+{
+
+template<typename F>
+struct NUMA::NodeTask
+{
+
+	NodeTask( F &f, size_t node )
+		:	m_f( f ), m_node( node )
+	{
+	}
+
+	void operator()() const
+	{
+		ScopedCurrentNode currentNode( m_node );
+		m_f( m_node );
+	}
+
+	private :
+
+		F &m_f;
+		const size_t m_node;
+
+};
+
+namespace Detail
+{
+
+template<typename T>
+struct NUMARunTask
+{
+
+	NUMARunTask( tbb::task_group &taskGroup, const T &task )
+		:	m_taskGroup( taskGroup ), m_task( task )
+	{
+	}
+
+	void operator()() const
+	{
+		m_taskGroup.run( m_task );
+	}
+
+	private :
+
+		tbb::task_group &m_taskGroup;
+		const T m_task;
+
+};
+
+struct NUMAWaitTask
+{
+
+	NUMAWaitTask( tbb::task_group &taskGroup )
+		:	m_taskGroup( taskGroup )
+	{
+	}
+
+	void operator()() const
+	{
+		m_taskGroup.wait();
+	}
+
+	private :
+
+		tbb::task_group &m_taskGroup;
+
+};
+
+} // namespace Detail
+
+template<typename F>
+void NUMA::parallelForNodes( F &f )
+{
+	const size_t n = numNodes();
+	boost::scoped_array<tbb::task_group> taskGroups( new tbb::task_group[n] );
+
+	// Launch the work for every node before waiting for any of it,
+	// so that all the arenas are busy at once. Waiting from within
+	// an arena lets the calling thread help out on that node.
+	for( size_t i = 0; i < n; ++i )
+	{
+		arena( i )->execute( Detail::NUMARunTask<NodeTask<F> >( taskGroups[i], NodeTask<F>( f, i ) ) );
+	}
+
+	size_t i = 0;
+	try
+	{
+		for( ; i < n; ++i )
+		{
+			arena( i )->execute( Detail::NUMAWaitTask( taskGroups[i] ) );
+		}
+	}
+	catch( ... )
+	{
+		// The task groups must all be waited on before they are
+		// destroyed, so we wait on the remainder before rethrowing
+		// the first exception.
+		for( ++i; i < n; ++i )
+		{
+			try
+			{
+				arena( i )->execute( Detail::NUMAWaitTask( taskGroups[i] ) );
+			}
+			catch( ... )
+			{
+			}
+		}
+		throw;
+	}
+}
+
+} // namespace Gaffer
+
+#endif // GAFFER_NUMA_INL
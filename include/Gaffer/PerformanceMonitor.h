@@ -38,11 +38,14 @@
 #define GAFFER_PERFORMANCEMONITOR_H
 
 #include <stack>
+#include <string>
+#include <vector>
 
 #include "tbb/enumerable_thread_specific.h"
 
 #include "boost/unordered_map.hpp"
 #include "boost/chrono.hpp"
+#include "boost/cstdint.hpp"
 
 #include "IECore/RefCounted.h"
 
@@ -52,9 +55,14 @@ namespace Gaffer
 {
 
 IE_CORE_FORWARDDECLARE( Plug )
+IE_CORE_FORWARDDECLARE( Node )
 
 /// A monitor which collects statistics about the frequency
-/// and duration of hash and compute processes per plug.
+/// and duration of hash and compute processes per plug, the
+/// memory they allocate, and the effectiveness of the caches. Statistics are also
+/// available rolled up per node. Optionally, a timeline of
+/// all processes may be recorded, for viewing in a trace
+/// viewer such as Chrome's `chrome://tracing`.
 class PerformanceMonitor : public Monitor
 {
 
@@ -70,13 +78,35 @@ class PerformanceMonitor : public Monitor
 				size_t hashCount = 0,
 				size_t computeCount = 0,
 				boost::chrono::nanoseconds hashDuration = boost::chrono::nanoseconds( 0 ),
-				boost::chrono::nanoseconds computeDuration = boost::chrono::nanoseconds( 0 )
+				boost::chrono::nanoseconds computeDuration = boost::chrono::nanoseconds( 0 ),
+				size_t hashCacheHits = 0,
+				size_t computeCacheHits = 0,
+				size_t computeCacheMisses = 0,
+				size_t cacheBytesStored = 0,
+				size_t bytesAllocated = 0
 			);
 
 			size_t hashCount;
 			size_t computeCount;
 			boost::chrono::nanoseconds hashDuration;
 			boost::chrono::nanoseconds computeDuration;
+			/// Number of times a hash was reused from the cache
+			/// rather than being computed by a hash process.
+			size_t hashCacheHits;
+			/// Number of times a value was found in the cache.
+			size_t computeCacheHits;
+			/// Number of times a value was not found in the
+			/// cache, and was either computed or shared with an
+			/// identical computation on another thread.
+			size_t computeCacheMisses;
+			/// Total memory usage of the values stored in the
+			/// cache.
+			size_t cacheBytesStored;
+			/// Total number of bytes allocated by the processes
+			/// themselves, excluding allocations made by upstream
+			/// processes. This is only available when Gaffer is run
+			/// with `GAFFER_ALLOCATOR=jemalloc`, and is zero otherwise.
+			size_t bytesAllocated;
 
 			Statistics & operator += ( const Statistics &rhs );
 
@@ -90,17 +120,49 @@ class PerformanceMonitor : public Monitor
 		const StatisticsMap &allStatistics() const;
 		const Statistics &plugStatistics( const Plug *plug ) const;
 
+		/// Statistics for each node are the sum of the statistics for
+		/// all the plugs of the node, and of all the nodes it contains.
+		typedef boost::unordered_map<ConstNodePtr, Statistics> NodeStatisticsMap;
+
+		const NodeStatisticsMap &allNodeStatistics() const;
+		const Statistics &nodeStatistics( const Node *node ) const;
+
+		/// When enabled, the start and end of every process is recorded
+		/// in a timeline, which can be written out using writeTimeline().
+		/// The timeline is off by default, because it consumes memory
+		/// proportional to the number of processes. It should only be
+		/// enabled or disabled while the monitor is inactive.
+		void setTimelineEnabled( bool enabled );
+		bool getTimelineEnabled() const;
+
+		/// Writes the timeline in the JSON trace event format understood
+		/// by Chrome's `chrome://tracing` viewer. Must not be called while
+		/// the monitor is active.
+		void writeTimeline( const std::string &fileName ) const;
+
 	protected :
 
 		virtual void processStarted( const Process *process );
 		virtual void processFinished( const Process *process );
+		virtual void cacheEvent( CacheEvent event, const Plug *plug, size_t bytes );
 
 	private :
 
 		// For performance reasons we accumulate our statistics into
 		// thread local storage while computations are running.
+		struct TimelineEvent
+		{
+			ConstPlugPtr plug;
+			bool compute;
+			boost::chrono::high_resolution_clock::time_point start;
+			boost::chrono::high_resolution_clock::time_point end;
+		};
+
 		struct ThreadData
 		{
+			ThreadData();
+			// Index used to identify the thread in the timeline.
+			int threadIndex;
 			// Stores the per-plug statistics captured by this thread.
 			StatisticsMap statistics;
 			// Stack of durations pointing into the statistics map.
@@ -110,6 +172,20 @@ class PerformanceMonitor : public Monitor
 			DurationStack durationStack;
 			// The last time measurement we made.
 			boost::chrono::high_resolution_clock::time_point then;
+			// Stack of allocation counts pointing into the statistics
+			// map, billed in the same way as the durations above.
+			typedef std::stack<size_t *> AllocationStack;
+			AllocationStack allocationStack;
+			// The allocator's running count of bytes allocated by this
+			// thread, or NULL if the allocator doesn't provide one.
+			const boost::uint64_t *allocatedCounter;
+			// The value of the counter when we last read it.
+			boost::uint64_t allocatedThen;
+			// Timeline events, and a stack of indices of the events
+			// which are currently in progress.
+			typedef std::vector<TimelineEvent> Timeline;
+			Timeline timeline;
+			std::stack<size_t> timelineStack;
 		};
 
 		tbb::enumerable_thread_specific<ThreadData, tbb::cache_aligned_allocator<ThreadData>, tbb::ets_key_per_instance> m_threadData;
@@ -117,6 +193,11 @@ class PerformanceMonitor : public Monitor
 		// Then when we want to query it, we collate it into m_statistics.
 		void collate() const;
 		mutable StatisticsMap m_statistics;
+		mutable NodeStatisticsMap m_nodeStatistics;
+		mutable bool m_nodeStatisticsDirty;
+
+		bool m_timelineEnabled;
+		const boost::chrono::high_resolution_clock::time_point m_startTime;
 
 };
 
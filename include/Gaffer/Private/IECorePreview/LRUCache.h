@@ -39,9 +39,11 @@
 
 #include "tbb/spin_mutex.h"
 #include "tbb/spin_rw_mutex.h"
+#include "tbb/atomic.h"
 
 #include "boost/noncopyable.hpp"
 #include "boost/function.hpp"
+#include "boost/optional.hpp"
 #include "boost/unordered_map.hpp"
 
 namespace IECorePreview
@@ -51,7 +53,8 @@ namespace IECorePreview
 /// supplied function. Recently computed values are stored in the cache to accelerate
 /// subsequent lookups. Each value has a cost associated with it, and the cache has
 /// a maximum total cost above which it will remove the (approximately) least recently
-/// accessed items.
+/// accessed items. Items may also be given a retention, allowing values which
+/// are expensive to recreate to survive longer than cheap ones of the same cost.
 ///
 /// The Key type must be hashable using boost::hash().
 ///
@@ -67,6 +70,11 @@ class LRUCache : private boost::noncopyable
 	public:
 
 		typedef size_t Cost;
+		/// The number of additional eviction sweeps an unused item
+		/// survives before being discarded. Zero gives standard LRU
+		/// behaviour, and values should be kept small, since each
+		/// unit may require a further sweep of the entire cache.
+		typedef unsigned char Retention;
 
 		/// The GetterFunction is responsible for computing the value and cost for a cache entry
 		/// when given the key. It should throw a descriptive exception if it can't get the data for
@@ -87,12 +95,27 @@ class LRUCache : private boost::noncopyable
 		/// Throws if the item can not be computed.
 		Value get( const Key &key );
 
+		/// Retrieves an item from the cache if it has been cached already,
+		/// without ever calling the GetterFunction. Only a read lock is
+		/// required, and no entry is created if the item is missing, so this
+		/// is significantly cheaper than get() when used with a null getter.
+		boost::optional<Value> getIfCached( const Key &key );
+
 		/// Adds an item to the cache directly, bypassing the GetterFunction.
 		/// Returns true for success and false on failure - failure can occur
 		/// if the cost exceeds the maximum cost for the cache. Note that even
 		/// when true is returned, the item may be removed from the cache by a
 		/// subsequent (or concurrent) operation.
-		bool set( const Key &key, const Value &value, Cost cost );
+		bool set( const Key &key, const Value &value, Cost cost, Retention retention = 0 );
+
+		typedef boost::function<Cost ( const Value &value )> CostFunction;
+		typedef boost::function<Retention ( Cost cost )> RetentionFunction;
+		/// As for set(), but does nothing if the item is already cached. The
+		/// costFunction is only called if the item needs to be stored, which
+		/// is useful when the cost is expensive to compute. Returns true if
+		/// the item was stored. The optional retentionFunction is passed the
+		/// cost, so that retention may be weighed against it.
+		bool setIfUncached( const Key &key, const Value &value, CostFunction costFunction, RetentionFunction retentionFunction = RetentionFunction() );
 
 		/// Returns true if the object is in the cache. Note that the
 		/// return value may be invalidated immediately by operations performed
@@ -146,7 +169,12 @@ class LRUCache : private boost::noncopyable
 			Cost cost; // the cost for this item
 
 			char status; // status of this item
-			bool recentlyUsed;
+			Retention retention; // extra sweeps survived when unused
+			Retention sweepsRemaining; // sweeps left before removal
+			// Atomic so that it can be updated by
+			// getIfCached() while only holding a
+			// read lock.
+			tbb::atomic<bool> recentlyUsed;
 		};
 
 		// Map from keys to items - this forms the basis of
@@ -173,6 +201,7 @@ class LRUCache : private boost::noncopyable
 
 		typedef std::vector<boost::shared_ptr<Bin> > Bins;
 		Bins m_bins;
+		void initBins();
 
 		// Handle class to abstract away the binned
 		// storage strategy. Internally holds an iterator
@@ -357,13 +386,14 @@ class LRUCache : private boost::noncopyable
 		// These methods set/erase a cached value, updating the current
 		// cost appropriately. The caller must hold the lock for the bin
 		// containing the value.
-		bool setInternal( MapValue &mapValue, const Value &value, Cost cost );
+		bool setInternal( MapValue &mapValue, const Value &value, Cost cost, Retention retention );
 		bool eraseInternal( MapValue &mapValue );
 
 		// When our current cost goes over the limit, we must discard
 		// cached values until the cost is back under the threshold.
 		// We do this by cycling through our cache using a "second chance"
-		// algorithm to determine what to remove. No locks must be held
+		// algorithm to determine what to remove, extended so that entries
+		// with a retention get further chances. No locks must be held
 		// when calling limitCost().
 		tbb::spin_mutex m_limitCostMutex;
 		Key m_limitCostSweepPosition;
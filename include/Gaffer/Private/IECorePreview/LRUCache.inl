@@ -37,6 +37,7 @@
 #define IECOREPREVIEW_LRUCACHE_INL
 
 #include <cassert>
+#include <algorithm>
 
 #include "tbb/tbb_thread.h"
 
@@ -47,36 +48,30 @@ namespace IECorePreview
 
 template<typename Key, typename Value>
 LRUCache<Key, Value>::CacheEntry::CacheEntry()
-	:	value(), cost( 0 ), status( New ), recentlyUsed( false )
+	:	value(), cost( 0 ), status( New ), retention( 0 ), sweepsRemaining( 0 )
 {
+	recentlyUsed = false;
 }
 
 template<typename Key, typename Value>
 LRUCache<Key, Value>::CacheEntry::CacheEntry( const CacheEntry &other )
-	:	value( other.value ), cost( other.cost ), status( other.status ), recentlyUsed( other.recentlyUsed )
+	:	value( other.value ), cost( other.cost ), status( other.status ), retention( other.retention ), sweepsRemaining( other.sweepsRemaining )
 {
+	recentlyUsed = other.recentlyUsed;
 }
 
 template<typename Key, typename Value>
 LRUCache<Key, Value>::LRUCache( GetterFunction getter, Cost maxCost )
 	:	m_getter( getter ), m_removalCallback( nullRemovalCallback ), m_maxCost( maxCost )
 {
-	m_currentCost = 0;
-	for( size_t i = 0, e = tbb::tbb_thread::hardware_concurrency(); i < e; ++i )
-	{
-		m_bins.push_back( boost::shared_ptr<Bin>( new Bin ) );
-	}
+	initBins();
 }
 
 template<typename Key, typename Value>
 LRUCache<Key, Value>::LRUCache( GetterFunction getter, RemovalCallback removalCallback, Cost maxCost )
 	:	m_getter( getter ), m_removalCallback( removalCallback ), m_maxCost( maxCost )
 {
-	m_currentCost = 0;
-	for( size_t i = 0, e = tbb::tbb_thread::hardware_concurrency(); i < e; ++i )
-	{
-		m_bins.push_back( boost::shared_ptr<Bin>( new Bin ) );
-	}
+	initBins();
 }
 
 template<typename Key, typename Value>
@@ -84,6 +79,26 @@ LRUCache<Key, Value>::~LRUCache()
 {
 }
 
+template<typename Key, typename Value>
+void LRUCache<Key, Value>::initBins()
+{
+	m_currentCost = 0;
+	// We use several bins per thread, so that the chances of two threads
+	// contending for the same bin are low even when every thread is
+	// accessing the cache at once. A power of two is used so that the
+	// low bits of the key hash are distributed evenly.
+	size_t numBins = 1;
+	const size_t minBins = std::max( tbb::tbb_thread::hardware_concurrency(), 1u ) * 4;
+	while( numBins < minBins )
+	{
+		numBins *= 2;
+	}
+	for( size_t i = 0; i < numBins; ++i )
+	{
+		m_bins.push_back( boost::shared_ptr<Bin>( new Bin ) );
+	}
+}
+
 template<typename Key, typename Value>
 void LRUCache<Key, Value>::clear()
 {
@@ -163,7 +178,7 @@ Value LRUCache<Key, Value>::get( const Key& key )
 		assert( cacheEntry.status != Cached ); // this would indicate that another thread somehow
 		assert( cacheEntry.status != Failed ); // loaded the same thing as us, which is not the intention.
 
-		setInternal( *handle, value, cost );
+		setInternal( *handle, value, cost, 0 );
 
 		assert( cacheEntry.status == Cached || cacheEntry.status == TooCostly );
 
@@ -186,12 +201,67 @@ Value LRUCache<Key, Value>::get( const Key& key )
 }
 
 template<typename Key, typename Value>
-bool LRUCache<Key, Value>::set( const Key &key, const Value &value, Cost cost )
+boost::optional<Value> LRUCache<Key, Value>::getIfCached( const Key &key )
+{
+	Handle handle;
+	handle.acquire( this, key, /* write = */ false, /* createIfMissing = */ false );
+	if( !handle.valid() )
+	{
+		return boost::none;
+	}
+
+	CacheEntry &cacheEntry = handle->second;
+	if( cacheEntry.status != Cached )
+	{
+		return boost::none;
+	}
+
+	// Safe to write with only a read lock,
+	// because the flag is atomic.
+	cacheEntry.recentlyUsed = true;
+	return cacheEntry.value;
+}
+
+template<typename Key, typename Value>
+bool LRUCache<Key, Value>::set( const Key &key, const Value &value, Cost cost, Retention retention )
 {
 	Handle handle;
 	handle.acquire( this, key, /* write = */ true, /* createIfMissing = */ true );
 
-	const bool result = setInternal( *handle, value, cost );
+	const bool result = setInternal( *handle, value, cost, retention );
+
+	handle.release();
+	limitCost();
+
+	return result;
+}
+
+template<typename Key, typename Value>
+bool LRUCache<Key, Value>::setIfUncached( const Key &key, const Value &value, CostFunction costFunction, RetentionFunction retentionFunction )
+{
+	// Early out with just a read lock, so that we
+	// don't contend with readers in the common case
+	// that the item has been cached already.
+	if( cached( key ) )
+	{
+		return false;
+	}
+
+	// Compute the cost without holding any lock,
+	// since it may be expensive.
+	const Cost cost = costFunction( value );
+	const Retention retention = retentionFunction ? retentionFunction( cost ) : 0;
+
+	Handle handle;
+	handle.acquire( this, key, /* write = */ true, /* createIfMissing = */ true );
+	if( handle->second.status == Cached )
+	{
+		// Another thread stored the item
+		// while we computed the cost.
+		return false;
+	}
+
+	const bool result = setInternal( *handle, value, cost, retention );
 
 	handle.release();
 	limitCost();
@@ -222,7 +292,7 @@ bool LRUCache<Key, Value>::erase( const Key &key )
 }
 
 template<typename Key, typename Value>
-bool LRUCache<Key, Value>::setInternal( MapValue &mapValue, const Value &value, Cost cost )
+bool LRUCache<Key, Value>::setInternal( MapValue &mapValue, const Value &value, Cost cost, Retention retention )
 {
 	// Erase the old value, adjusting the current cost.
 	eraseInternal( mapValue );
@@ -236,6 +306,8 @@ bool LRUCache<Key, Value>::setInternal( MapValue &mapValue, const Value &value,
 		cacheEntry.value = value;
 		cacheEntry.cost = cost;
 		cacheEntry.status = Cached;
+		cacheEntry.retention = retention;
+		cacheEntry.sweepsRemaining = retention;
 		cacheEntry.recentlyUsed = true;
 		m_currentCost += cost;
 	}
@@ -289,19 +361,28 @@ void LRUCache<Key, Value>::limitCost()
 	size_t numFullCycles = 0;
 	while( m_currentCost > m_maxCost && handle.valid() && numFullCycles < 100 )
 	{
-		if( !handle->second.recentlyUsed )
-		{
-			eraseInternal( *handle );
-			handle.eraseAndIncrement();
-		}
-		else
+		CacheEntry &cacheEntry = handle->second;
+		if( cacheEntry.recentlyUsed )
 		{
 			// We'll erase this guy text time round,
 			// if he hasn't been used by some other
 			// thread by then.
-			handle->second.recentlyUsed = false;
+			cacheEntry.recentlyUsed = false;
+			cacheEntry.sweepsRemaining = cacheEntry.retention;
 			handle.increment();
 		}
+		else if( cacheEntry.sweepsRemaining )
+		{
+			// Expensive to recreate, so give it
+			// another chance.
+			cacheEntry.sweepsRemaining--;
+			handle.increment();
+		}
+		else
+		{
+			eraseInternal( *handle );
+			handle.eraseAndIncrement();
+		}
 		if( !handle.valid() )
 		{
 			// We're at the end but may not have
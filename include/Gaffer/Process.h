@@ -43,11 +43,12 @@
 
 #include "IECore/InternedString.h"
 
+#include "Gaffer/Monitor.h"
+
 namespace Gaffer
 {
 
 class Plug;
-class Monitor;
 
 /// Base class representing a node graph process being
 /// performed on behalf of a plug. Processes are never
@@ -94,6 +95,12 @@ class Process : public boost::noncopyable
 		/// we use C++11's current_exception() in our destructor perhaps?
 		void handleException();
 
+		/// Reports a cache event to all active monitors. This
+		/// is provided for use by processes which maintain caches,
+		/// since no process is launched when a cached result is
+		/// reused.
+		static void cacheEvent( Monitor::CacheEvent event, const Plug *plug, size_t bytes = 0 );
+
 	private :
 
 		// Friendship allows monitors to register and deregister
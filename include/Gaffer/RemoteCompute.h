@@ -0,0 +1,154 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2017, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//      * Redistributions of source code must retain the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer.
+//
+//      * Redistributions in binary form must reproduce the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer in the documentation and/or other materials provided with
+//        the distribution.
+//
+//      * Neither the name of John Haddon nor the names of
+//        any other contributors to this software may be used to endorse or
+//        promote products derived from this software without specific prior
+//        written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#ifndef GAFFER_REMOTECOMPUTE_H
+#define GAFFER_REMOTECOMPUTE_H
+
+#include <string>
+
+#include "boost/shared_ptr.hpp"
+
+#include "IECore/RefCounted.h"
+#include "IECore/MurmurHash.h"
+#include "IECore/Object.h"
+
+namespace Gaffer
+{
+
+IE_CORE_FORWARDDECLARE( ScriptNode )
+IE_CORE_FORWARDDECLARE( ValuePlug )
+
+/// Remote computation allows heavy parts of a graph to be evaluated by
+/// another process, typically running on a more powerful machine. The
+/// remote process loads a copy of the script and serves computations
+/// using a ComputeServer. The local process installs a ComputeClient
+/// with ValuePlug::setComputeClient(), and flags the subgraphs to be
+/// offloaded by registering "computeRemotely" metadata on a node,
+/// typically a Box. Cache misses for output plugs within flagged nodes
+/// are then sent to the server, and the results are stored in the local
+/// compute cache by hash, exactly as if they had been computed locally.
+///
+/// Hashes are always computed locally, and each request includes the
+/// hash expected by the client. The server checks it against its own
+/// hash, so if the scripts have diverged the request is refused and
+/// the value is computed locally instead. The same applies if the
+/// server can't be reached. Errors raised by the computation itself
+/// are rethrown by the client.
+///
+/// Values are transferred using Cortex serialisation, so values of
+/// types which can't be serialised are always computed locally.
+/// As with the disk cache, the processes must use identical versions
+/// of Gaffer and any extensions.
+
+/// Serves computations for a script to ComputeClients in other
+/// processes. Each client connection is served on a thread of its
+/// own, and the computations themselves use TBB as usual.
+class ComputeServer : public IECore::RefCounted
+{
+
+	public :
+
+		/// Starts serving on the specified port. A port of 0 chooses
+		/// a free port automatically; the port in use is returned
+		/// by port().
+		ComputeServer( ScriptNodePtr script, int port = 0 );
+		/// Calls stop().
+		virtual ~ComputeServer();
+
+		IE_CORE_DECLAREMEMBERPTR( ComputeServer )
+
+		ScriptNode *script();
+		const ScriptNode *script() const;
+
+		int port() const;
+
+		/// Closes all connections and waits for any computations
+		/// in progress to complete.
+		void stop();
+
+	private :
+
+		// Computes the value of a plug in the current context, as
+		// the Object stored internally by the plug.
+		static IECore::ConstObjectPtr objectValue( const ValuePlug *plug );
+
+		class Implementation;
+		boost::shared_ptr<Implementation> m_implementation;
+
+};
+
+IE_CORE_DECLAREPTR( ComputeServer )
+
+/// Sends computations to a ComputeServer. Each thread uses its
+/// own connection, so that computations requested by different
+/// threads are performed concurrently on the server.
+class ComputeClient : public IECore::RefCounted
+{
+
+	public :
+
+		ComputeClient( const std::string &host, int port );
+		virtual ~ComputeClient();
+
+		IE_CORE_DECLAREMEMBERPTR( ComputeClient )
+
+		const std::string &host() const;
+		int port() const;
+
+		/// Returns true if the plug belongs to a node flagged
+		/// with "computeRemotely" metadata, or to a descendant
+		/// of one.
+		static bool computeRemotely( const ValuePlug *plug );
+
+		/// Requests the value of the plug in the current context,
+		/// returning NULL if the request could not be served, in
+		/// which case the value should be computed locally. The
+		/// expected hash must be the hash of the plug in the
+		/// current context.
+		IECore::ConstObjectPtr compute( const ValuePlug *plug, const IECore::MurmurHash &expectedHash ) const;
+
+	private :
+
+		class Implementation;
+		boost::shared_ptr<Implementation> m_implementation;
+
+};
+
+IE_CORE_DECLAREPTR( ComputeClient )
+
+} // namespace Gaffer
+
+#endif // GAFFER_REMOTECOMPUTE_H
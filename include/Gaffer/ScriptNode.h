@@ -120,6 +120,11 @@ class ScriptNode : public Node
 		ActionSignal &actionSignal();
 		/// A signal emitted when an item is added to the undo stack.
 		UndoAddedSignal &undoAddedSignal();
+		/// Limits the memory used by the undo queue, discarding the oldest
+		/// undo entries as necessary. The most recent entry is always kept.
+		/// A limit of 0, which is the default, means there is no limit.
+		void setUndoMemoryLimit( size_t bytes );
+		size_t getUndoMemoryLimit() const;
 		//@}
 
 		//! @name Editing
@@ -255,6 +260,7 @@ class ScriptNode : public Node
 		void pushUndoState( UndoContext::State state, const std::string &mergeGroup );
 		void addAction( ActionPtr action );
 		void popUndoState();
+		void limitUndoMemory();
 
 		typedef std::stack<UndoContext::State> UndoStateStack;
 		typedef std::list<CompoundActionPtr> UndoList;
@@ -267,6 +273,7 @@ class ScriptNode : public Node
 		UndoList m_undoList; // then the accumulated actions are transferred to this list for storage
 		UndoIterator m_undoIterator; // points to the next thing to redo
 		Action::Stage m_currentActionStage;
+		size_t m_undoMemoryLimit;
 
 		// Serialisation and execution
 		// ===========================
@@ -38,6 +38,10 @@
 #ifndef GAFFER_STRINGPLUG_H
 #define GAFFER_STRINGPLUG_H
 
+#include "boost/scoped_ptr.hpp"
+
+#include "IECore/SimpleTypedData.h"
+
 #include "Gaffer/ValuePlug.h"
 #include "Gaffer/Context.h"
 
@@ -111,6 +115,10 @@ class StringPlug : public ValuePlug
 		/// for details of the optional precomputedHash argument - and use
 		/// with care!
 		std::string getValue( const IECore::MurmurHash *precomputedHash = NULL ) const;
+		/// Returns true if getValue() will perform substitutions on the
+		/// current value, and therefore may return different results
+		/// in different contexts.
+		bool hasSubstitutions() const;
 
 		virtual void setFrom( const ValuePlug *other );
 
@@ -119,10 +127,26 @@ class StringPlug : public ValuePlug
 		/// ValuePlug::hash( h )
 		using ValuePlug::hash;
 
+	protected :
+
+		/// Reimplemented to update the substitution template
+		/// for our value.
+		virtual void dirty();
+
 	private :
 
+		void updateSubstitutionTemplate();
+		std::string substitute( const IECore::StringData *value ) const;
+
 		unsigned m_substitutions;
 
+		// Our static value is parsed in advance, so that substitutions
+		// don't need to reparse it each time getValue() is called. We hold
+		// a reference to the value the template was made for, so that we
+		// can check it is still applicable.
+		IECore::ConstStringDataPtr m_substitutionTemplateValue;
+		boost::scoped_ptr<const Context::SubstitutionTemplate> m_substitutionTemplate;
+
 };
 
 IE_CORE_DECLAREPTR( StringPlug );
@@ -109,6 +109,9 @@ class Switch : public BaseType
 		// not inherit from ComputeNode.
 		virtual void hash( const ValuePlug *output, const Context *context, IECore::MurmurHash &h ) const;
 		virtual void compute( ValuePlug *output, const Context *context ) const;
+		// Implemented to declare the input branch as a pass-through, so that
+		// ValuePlug can bypass hash() and compute() entirely.
+		virtual const ValuePlug *passThrough( const ValuePlug *output, const Context *context ) const;
 
 	private :
 
@@ -128,6 +131,13 @@ class Switch : public BaseType
 		template<typename T>
 		void computeInternal( ValuePlug *output, const Context *context, typename boost::disable_if<boost::is_base_of<ComputeNode, T> >::type *enabler = 0 ) const;
 
+		// The internal implementation for passThrough(). Returns NULL when BaseType is not a
+		// ComputeNode, and the appropriate input when it is.
+		template<typename T>
+		const ValuePlug *passThroughInternal( const ValuePlug *output, const Context *context, typename boost::enable_if<boost::is_base_of<ComputeNode, T> >::type *enabler = 0 ) const;
+		template<typename T>
+		const ValuePlug *passThroughInternal( const ValuePlug *output, const Context *context, typename boost::disable_if<boost::is_base_of<ComputeNode, T> >::type *enabler = 0 ) const;
+
 		void childAdded( GraphComponent *child );
 		void plugSet( Plug *plug );
 		void plugInputChanged( Plug *plug );
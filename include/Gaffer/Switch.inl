@@ -350,6 +350,32 @@ void Switch<BaseType>::computeInternal( ValuePlug *output, const Context *contex
 	// not a ComputeNode - no need for computation
 }
 
+template<typename BaseType>
+const ValuePlug *Switch<BaseType>::passThrough( const ValuePlug *output, const Context *context ) const
+{
+	return passThroughInternal<BaseType>( output, context );
+}
+
+template<typename BaseType>
+template<typename T>
+const ValuePlug *Switch<BaseType>::passThroughInternal( const ValuePlug *output, const Context *context, typename boost::enable_if<boost::is_base_of<ComputeNode, T> >::type *enabler ) const
+{
+	if( const ValuePlug *input = IECore::runTimeCast<const ValuePlug>( oppositePlug( output, inputIndex( context ) ) ) )
+	{
+		return input;
+	}
+
+	return BaseType::passThrough( output, context );
+}
+
+template<typename BaseType>
+template<typename T>
+const ValuePlug *Switch<BaseType>::passThroughInternal( const ValuePlug *output, const Context *context, typename boost::disable_if<boost::is_base_of<ComputeNode, T> >::type *enabler ) const
+{
+	// not a ComputeNode - no need for pass-throughs
+	return NULL;
+}
+
 template<typename BaseType>
 void Switch<BaseType>::plugSet( Plug *plug )
 {
@@ -38,6 +38,10 @@
 #ifndef GAFFER_VALUEPLUG_H
 #define GAFFER_VALUEPLUG_H
 
+#include <vector>
+
+#include "tbb/atomic.h"
+
 #include "IECore/Object.h"
 
 #include "Gaffer/Plug.h"
@@ -46,6 +50,8 @@ namespace Gaffer
 {
 
 IE_CORE_FORWARDDECLARE( DependencyNode )
+IE_CORE_FORWARDDECLARE( Context )
+IE_CORE_FORWARDDECLARE( ComputeClient )
 
 /// The Plug base class defines the concept of a connection
 /// point with direction. The ValuePlug class extends this concept
@@ -93,12 +99,42 @@ class ValuePlug : public Plug
 		/// for all subclasses except those where the number of child plugs
 		/// varies based on the value.
 		virtual bool isSetToDefault() const;
+		/// Returns the hash of the default value. This is memoised
+		/// when the plug is constructed, so it is cheap to call even
+		/// for plugs with large default values. It should be used in
+		/// preference to `defaultValue()->hash()`. For plugs without a
+		/// default value of their own, the hash is computed from the
+		/// default hashes of the children.
+		IECore::MurmurHash defaultHash() const;
 
 		/// Returns a hash to represent the value of this plug
 		/// in the current context.
 		virtual IECore::MurmurHash hash() const;
 		/// Convenience function to append the hash to h.
 		void hash( IECore::MurmurHash &h ) const;
+		/// Returns a number which changes every time the plug is dirtied.
+		/// This is useful for generating hashes which must be invalidated
+		/// by any upstream change, without the cost of hashing the upstream
+		/// graph itself. The number is unique within a session, but is not
+		/// stable between sessions.
+		uint64_t dirtyCount() const;
+
+		/// @name Batch evaluation
+		/// These functions evaluate many plugs at once, in parallel. They
+		/// are useful when many independent values are needed, which would
+		/// otherwise be evaluated one after another. If `contexts` is empty
+		/// then all plugs are evaluated in the current context, otherwise
+		/// it must provide a context for each plug.
+		////////////////////////////////////////////////////////////////////
+		//@{
+		/// Fills `hashes` with the hash of each plug.
+		static void hashes( const std::vector<const ValuePlug *> &plugs, const std::vector<const Context *> &contexts, std::vector<IECore::MurmurHash> &hashes );
+		/// Computes the value of each plug, so that subsequent calls to
+		/// getValue() can retrieve it from the cache. Values are not
+		/// guaranteed to remain cached, and values for plugs whose cache
+		/// policy is Uncached or ThreadLocal will be computed again.
+		static void prefetch( const std::vector<const ValuePlug *> &plugs, const std::vector<const Context *> &contexts );
+		//@}
 
 		/// @name Cache management
 		/// ValuePlug optimises repeated computation by storing a cache of
@@ -106,14 +142,82 @@ class ValuePlug : public Plug
 		/// of the cache.
 		////////////////////////////////////////////////////////////////////
 		//@{
+		/// Policies for caching the results of computations, as
+		/// returned by ComputeNode::computeCachePolicy(). Regardless
+		/// of policy, plugs without the Plug::Cacheable flag are never
+		/// cached.
+		enum CachePolicy
+		{
+			/// No caching is performed - the computation is repeated
+			/// every time the value is requested.
+			Uncached,
+			/// Results are stored in the global cache, and concurrent
+			/// requests for the same value share a single computation.
+			Standard,
+			/// Results are stored only in a small cache private to each
+			/// thread. Suitable for very cheap computations whose results
+			/// would otherwise evict more valuable entries from the global
+			/// cache.
+			ThreadLocal,
+			/// As for Standard, but the computation is performed in its
+			/// own task arena, so that any TBB tasks it spawns are isolated
+			/// from the tasks of the calling thread. Must be used by any
+			/// computation which uses TBB internally.
+			TaskIsolation,
+			/// As for Standard, but the result is only stored in the global
+			/// cache if the computation takes longer than a millisecond, so
+			/// that trivial results don't evict expensive ones.
+			CacheIfExpensive
+		};
+
 		/// Returns the maximum amount of memory in bytes to use for the cache.
 		static size_t getCacheMemoryLimit();
 		/// Sets the maximum amount of memory the cache may use in bytes.
 		static void setCacheMemoryLimit( size_t bytes );
 		/// Returns the current memory usage of the cache in bytes.
 		static size_t cacheMemoryUsage();
+		/// Returns the memory used by cached values computed for
+		/// graphComponent, which is typically a node, and all its
+		/// descendants. Values shared by several plugs are attributed
+		/// to the first plug to store them. Useful for identifying the
+		/// nodes responsible for high memory usage.
+		static size_t cacheMemoryUsage( const GraphComponent *graphComponent );
 		/// Clears the cache.
 		static void clearCache();
+		/// Returns the maximum number of hashes to be stored in the
+		/// hash cache. Hashes are cached per plug and per context,
+		/// and are shared between threads.
+		static size_t getHashCacheSizeLimit();
+		/// Sets the maximum number of entries in the hash cache.
+		static void setHashCacheSizeLimit( size_t maxEntries );
+		/// Clears the hash cache. This is never necessary for correctness,
+		/// since entries are invalidated automatically when plugs are dirtied.
+		static void clearHashCache();
+		/// Results which take a long time to compute may also be stored
+		/// in a cache on disk, so that they can be reused by other processes.
+		/// For instance, the batches launched by a dispatcher can share work,
+		/// even when running on different machines with a shared filesystem.
+		/// The disk cache is disabled by default, and can be enabled by
+		/// specifying a directory here, or via the GAFFER_DISK_CACHE_DIRECTORY
+		/// environment variable. Pass an empty string to disable it again.
+		///
+		/// Because results are identified by hash alone, processes sharing
+		/// a directory must use identical versions of Gaffer and any
+		/// extensions. The directory should only be changed when no
+		/// computations are being performed.
+		static void setDiskCacheDirectory( const std::string &directory );
+		static const std::string &getDiskCacheDirectory();
+		/// Sets the approximate maximum size of the disk cache in bytes.
+		/// Least recently used files are removed when this is exceeded.
+		static void setDiskCacheSizeLimit( size_t bytes );
+		static size_t getDiskCacheSizeLimit();
+		/// Offloads cache misses for plugs within nodes flagged with
+		/// "computeRemotely" metadata to a ComputeServer in another
+		/// process. See RemoteCompute.h for details. Pass NULL to
+		/// compute everything locally again. The client should only be
+		/// changed when no computations are being performed.
+		static void setComputeClient( ComputeClientPtr client );
+		static ComputeClient *getComputeClient();
 		//@}
 
 	protected :
@@ -161,19 +265,41 @@ class ValuePlug : public Plug
 
 	private :
 
+		friend class ComputeServer;
+
 		class HashProcess;
 		class ComputeProcess;
 		class SetValueAction;
+		struct CacheResidency;
+
+		class BatchTask;
+
+		// Computes the values of this plug, or of all its descendants
+		// if it has no value of its own, for use by prefetch().
+		void prefetchInternal() const;
 
-		void setValueInternal( IECore::ConstObjectPtr value, bool propagateDirtiness );
+		void setValueInternal( IECore::ConstObjectPtr value, const IECore::MurmurHash &valueHash, bool propagateDirtiness );
 		void childAddedOrRemoved();
 		// Emits the appropriate Node::plugSetSignal() for this plug and all its
 		// ancestors, then does the same for its output plugs.
 		void emitPlugSet();
 
 		IECore::ConstObjectPtr m_defaultValue;
+		// The hash of m_defaultValue, memoised for defaultHash().
+		IECore::MurmurHash m_defaultValueHash;
 		// For holding the value of input plugs with no input connections.
 		IECore::ConstObjectPtr m_staticValue;
+		// The hash of m_staticValue. Values are immutable once set, so
+		// we compute this once rather than rehashing potentially large
+		// data every time the plug is hashed.
+		IECore::MurmurHash m_staticValueHash;
+		// Updated from a global counter each time the plug is dirtied,
+		// and used to invalidate entries in the hash cache.
+		uint64_t m_dirtyCount;
+		// Tracks the memory used by cached results of our computes.
+		// Created on demand and reference counted, since cache entries
+		// may outlive the plug.
+		mutable tbb::atomic<CacheResidency *> m_cacheResidency;
 
 };
 
@@ -82,6 +82,9 @@ class ArnoldVDB : public GafferScene::ObjectSource
 		virtual void hashSource( const Gaffer::Context *context, IECore::MurmurHash &h ) const;
 		virtual IECore::ConstObjectPtr computeSource( const Gaffer::Context *context ) const;
 
+		/// Reimplemented to append the frame rate, which is used by computeSource().
+		virtual bool contextDependencies( const Gaffer::ValuePlug *output, const Gaffer::Context *context, std::vector<IECore::InternedString> &variables ) const;
+
 	private :
 
 		static size_t g_firstPlugIndex;
@@ -40,6 +40,8 @@
 
 #include "boost/python.hpp"
 
+#include "tbb/atomic.h"
+
 #include "IECorePython/ScopedGILLock.h"
 
 #include "Gaffer/ComputeNode.h"
@@ -62,18 +64,21 @@ class ComputeNodeWrapper : public DependencyNodeWrapper<WrappedType>
 		ComputeNodeWrapper( PyObject *self, const std::string &name )
 			:	DependencyNodeWrapper<WrappedType>( self, name )
 		{
+			initOverrides();
 		}
 
 		template<typename Arg1, typename Arg2>
 		ComputeNodeWrapper( PyObject *self, Arg1 arg1, Arg2 arg2 )
 			:	DependencyNodeWrapper<WrappedType>( self, arg1, arg2 )
 		{
+			initOverrides();
 		}
 
 		template<typename Arg1, typename Arg2, typename Arg3>
 		ComputeNodeWrapper( PyObject *self, Arg1 arg1, Arg2 arg2, Arg3 arg3 )
 			:	DependencyNodeWrapper<WrappedType>( self, arg1, arg2, arg3 )
 		{
+			initOverrides();
 		}
 
 		virtual void hash( const Gaffer::ValuePlug *output, const Gaffer::Context *context, IECore::MurmurHash &h ) const
@@ -83,7 +88,7 @@ class ComputeNodeWrapper : public DependencyNodeWrapper<WrappedType>
 			/// if required. Having a disparity between the python bindings and the
 			/// C++ form here does us no favours.
 			WrappedType::hash( output, context, h );
-			if( this->isSubclassed() )
+			if( this->isSubclassed() && m_mayOverrideHash )
 			{
 				IECorePython::ScopedGILLock gilLock;
 				try
@@ -99,6 +104,10 @@ class ComputeNodeWrapper : public DependencyNodeWrapper<WrappedType>
 						);
 						h = boost::python::extract<IECore::MurmurHash>( pythonHash );
 					}
+					else
+					{
+						m_mayOverrideHash = false;
+					}
 				}
 				catch( const boost::python::error_already_set &e )
 				{
@@ -109,7 +118,7 @@ class ComputeNodeWrapper : public DependencyNodeWrapper<WrappedType>
 
 		virtual void compute( Gaffer::ValuePlug *output, const Gaffer::Context *context ) const
 		{
-			if( this->isSubclassed() )
+			if( this->isSubclassed() && m_mayOverrideCompute )
 			{
 				IECorePython::ScopedGILLock gilLock;
 				try
@@ -120,6 +129,7 @@ class ComputeNodeWrapper : public DependencyNodeWrapper<WrappedType>
 						f( Gaffer::ValuePlugPtr( output ), Gaffer::ContextPtr( const_cast<Gaffer::Context *>( context ) ) );
 						return;
 					}
+					m_mayOverrideCompute = false;
 				}
 				catch( const boost::python::error_already_set &e )
 				{
@@ -129,6 +139,23 @@ class ComputeNodeWrapper : public DependencyNodeWrapper<WrappedType>
 			WrappedType::compute( output, context );
 		}
 
+	private :
+
+		void initOverrides()
+		{
+			m_mayOverrideHash = true;
+			m_mayOverrideCompute = true;
+		}
+
+		// hash() and compute() are called concurrently from many
+		// threads, and entering Python to discover that there is no
+		// override serialises them all on the GIL. We instead remember
+		// the first time a lookup fails, and skip Python entirely from
+		// then on. Methods are not expected to be added to a class after
+		// its instances have started computing.
+		mutable tbb::atomic<bool> m_mayOverrideHash;
+		mutable tbb::atomic<bool> m_mayOverrideCompute;
+
 };
 
 } // namespace GafferBindings
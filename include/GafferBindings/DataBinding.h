@@ -57,6 +57,16 @@ boost::python::object dataToPython( IECore::Data *data, boost::python::object nu
 /// an argument specifying whether or not to copy the data.
 boost::python::object dataToPython( const IECore::Data *data, bool copy, boost::python::object nullValue = boost::python::object() );
 
+/// Returns a read-only `memoryview` onto the contents of numeric vector data,
+/// without copying it. The view keeps the data alive for as long as it exists,
+/// and can be passed directly to `numpy.asarray()` and the like. Elements with
+/// several components are flattened, so a V3fVectorData of length N yields a
+/// view of 3N floats. Raises a Python exception for unsupported types.
+boost::python::object dataToBuffer( const IECore::Data *data );
+
+/// Binds `Gaffer.dataBuffer()`, which exposes dataToBuffer() to Python.
+void bindData();
+
 } // namespace GafferBindings
 
 #endif // GAFFERBINDINGS_DATABINDING_H
@@ -49,6 +49,7 @@
 #include "IECore/RunTimeTyped.h"
 
 #include "Gaffer/NumericPlug.h"
+#include "Gaffer/TypedPlug.h"
 
 #include "GafferDispatch/TaskNode.h"
 #include "GafferDispatchBindings/DispatcherBinding.h" // to enable friend declaration for TaskBatch.
@@ -169,6 +170,15 @@ class Dispatcher : public Gaffer::Node
 		const std::string jobDirectory() const;
 		//@}
 
+		/// Returns the plug which specifies whether or not tasks which are
+		/// already up to date should be skipped. A task is up to date if it was
+		/// previously dispatched with this option on, its hash hasn't changed
+		/// since, its output file hasn't been modified since, and all its preTasks
+		/// are also up to date. Only tasks with a "fileName" plug specifying their
+		/// output are candidates for skipping.
+		Gaffer::BoolPlug *skipUpToDateTasksPlug();
+		const Gaffer::BoolPlug *skipUpToDateTasksPlug() const;
+
 		/// A function which creates a Dispatcher.
 		typedef boost::function<DispatcherPtr ()> Creator;
 		/// SetupPlugsFn may be registered along with a Dispatcher Creator. It will be called by setupPlugs,
@@ -0,0 +1,77 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2017, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//      * Redistributions of source code must retain the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer.
+//
+//      * Redistributions in binary form must reproduce the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer in the documentation and/or other materials provided with
+//        the distribution.
+//
+//      * Neither the name of John Haddon nor the names of
+//        any other contributors to this software may be used to endorse or
+//        promote products derived from this software without specific prior
+//        written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#ifndef GAFFERDISPATCH_PRIVATE_TASKMANIFEST_H
+#define GAFFERDISPATCH_PRIVATE_TASKMANIFEST_H
+
+#include "GafferDispatch/TaskNode.h"
+
+namespace GafferDispatch
+{
+
+namespace Private
+{
+
+/// Utilities for skipping tasks which are already up to date. When a task
+/// with a "fileName" output plug is executed, the task hash is recorded in a
+/// manifest stored in a ".gafferManifest" directory alongside the output file.
+/// A subsequent dispatch may then skip the task if the hash is unchanged and
+/// the output file has not been modified in the meantime, in the manner of
+/// `make`. Tasks without a "fileName" plug are never considered to be up to
+/// date, because we have no way of knowing what they produce.
+namespace TaskManifest
+{
+
+/// Name of the context variable used to enable the recording
+/// and checking of manifests.
+extern const IECore::InternedString skipUpToDateTasksContextName;
+
+/// Returns true if the manifest says that `task` has already
+/// been executed with an identical hash, and that its output is
+/// unchanged since.
+bool upToDate( const TaskNode::Task &task );
+/// Records a manifest entry for the task, as defined by `plug`
+/// and the current context. Should be called after the task has
+/// been executed successfully.
+void record( const TaskNode::TaskPlug *plug );
+
+} // namespace TaskManifest
+
+} // namespace Private
+
+} // namespace GafferDispatch
+
+#endif // GAFFERDISPATCH_PRIVATE_TASKMANIFEST_H
@@ -55,6 +55,17 @@ class Blur : public ImageProcessor
 
 		IE_CORE_DECLARERUNTIMETYPEDEXTENSION( GafferImage::Blur, BlurTypeId, ImageProcessor );
 
+		enum Mode
+		{
+			/// A true gaussian, with a cost proportional to the radius.
+			Accurate = 0,
+			/// Approximates a gaussian using three iterated box filters,
+			/// with a cost that doesn't depend on the radius. The box
+			/// sizes are whole pixels, so fine changes in radius are
+			/// not represented exactly.
+			Fast = 1
+		};
+
 		Gaffer::V2fPlug *radiusPlug();
 		const Gaffer::V2fPlug *radiusPlug() const;
 
@@ -64,6 +75,9 @@ class Blur : public ImageProcessor
 		Gaffer::BoolPlug *expandDataWindowPlug();
 		const Gaffer::BoolPlug *expandDataWindowPlug() const;
 
+		Gaffer::IntPlug *modePlug();
+		const Gaffer::IntPlug *modePlug() const;
+
 		virtual void affects( const Gaffer::Plug *input, AffectedPlugsContainer &outputs ) const;
 
 	protected :
@@ -72,6 +72,8 @@ class ChannelDataProcessor : public ImageProcessor
 
 		/// Implemented to initialize the output tile and then call processChannelData()
 		/// All other ImagePlug children are passed through via direct connection to the input values.
+		/// The input tile is reused for the output when nothing else references it, avoiding
+		/// a copy.
 		virtual IECore::ConstFloatVectorDataPtr computeChannelData( const std::string &channelName, const Imath::V2i &tileOrigin, const Gaffer::Context *context, const ImagePlug *parent ) const;
 
 		/// Should be implemented by derived classes to processes each channel's data.
@@ -81,6 +83,11 @@ class ChannelDataProcessor : public ImageProcessor
 		///                     It is useful for querying Color4f plugs for the value that coresponds to the channel being processed.
 		/// @param outData The tile where the result of the operation should be written. It is initialized with the coresponding tile data from inPlug() which should be used as the input data.
 		virtual void processChannelData( const Gaffer::Context *context, const ImagePlug *parent, const std::string &channel, IECore::FloatVectorDataPtr outData ) const = 0;
+		/// May be implemented by derived classes to return true if processChannelData()
+		/// is guaranteed to leave a black tile black. In this case input tiles which are
+		/// ImagePlug::blackTile() are passed straight through without processing. The
+		/// default implementation returns false.
+		virtual bool preservesBlack( const Gaffer::Context *context, const std::string &channel ) const;
 
 	private :
 
@@ -70,6 +70,10 @@ class ColorProcessor : public ImageProcessor
 		/// Implemented to use the results of colorDataPlug() via processColorData()
 		virtual IECore::ConstFloatVectorDataPtr computeChannelData( const std::string &channelName, const Imath::V2i &tileOrigin, const Gaffer::Context *context, const ImagePlug *parent ) const;
 
+		/// The color data for a tile is computed once and shared by all of its channels,
+		/// so hashColorData() and processColorData() are called in a context which does not
+		/// contain the "image:channelName" variable.
+		///
 		/// May be implemented by derived classes to return true if the specified input is used in processColorData().
 		/// Must first call the base class implementation and return true if it does.
 		virtual bool affectsColorData( const Gaffer::Plug *input ) const;
@@ -88,7 +88,8 @@ class FormatPlug : public Gaffer::ValuePlug
 		/// \undoable
 		void setValue( const Format &value );
 		/// Implemented to substitute in the default format from the current
-		/// context if the current value is empty.
+		/// context if the current value is empty, and to scale the value
+		/// according to the proxy level of the current context.
 		/// \note Substitution is not performed automatically when accessing
 		/// individual components (display window and pixel aspect) from the
 		/// child plugs directly.
@@ -127,6 +128,32 @@ class FormatPlug : public Gaffer::ValuePlug
 		static FormatPlug *acquireDefaultFormatPlug( Gaffer::ScriptNode *scriptNode );
 		//@}
 
+		/// @name Proxy level
+		///
+		/// The proxy level allows an image to be computed at reduced
+		/// resolution, for instance when the viewer is zoomed out. At
+		/// level N, formats are scaled down by a factor of 2^N. This is
+		/// applied automatically to the values of input FormatPlugs and
+		/// to the default format, so nodes which take their format from
+		/// a FormatPlug honour the proxy level without further work. Nodes
+		/// which generate formats by other means (reading files, for
+		/// instance) must use the methods below to do the same.
+		////////////////////////////////////////////////////////////////////
+		//@{
+		static const IECore::InternedString proxyLevelContextName;
+		static const int maxProxyLevel = 3;
+		/// Returns the proxy level in effect for the specified context,
+		/// clamped to the range [0, maxProxyLevel].
+		static int getProxyLevel( const Gaffer::Context *context );
+		/// Sets the proxy level for the specified context.
+		static void setProxyLevel( Gaffer::Context *context, int proxyLevel );
+		/// Returns the format scaled down for the specified proxy level.
+		static Format proxyFormat( const Format &format, int proxyLevel );
+		/// Returns the smallest window which contains the specified
+		/// window once it is scaled down for the proxy level.
+		static Imath::Box2i proxyWindow( const Imath::Box2i &window, int proxyLevel );
+		//@}
+
 	private :
 
 		virtual void parentChanging( Gaffer::GraphComponent *newParent );
@@ -92,6 +92,7 @@ class Grade : public ChannelDataProcessor
 
 		virtual void hashChannelData( const GafferImage::ImagePlug *output, const Gaffer::Context *context, IECore::MurmurHash &h ) const;
 		virtual void processChannelData( const Gaffer::Context *context, const ImagePlug *parent, const std::string &channelIndex, IECore::FloatVectorDataPtr outData ) const;
+		virtual bool preservesBlack( const Gaffer::Context *context, const std::string &channel ) const;
 
 	private :
 
@@ -40,6 +40,8 @@
 #include <vector>
 #include "OpenEXR/ImathBox.h"
 
+#include "IECore/VectorTypedData.h"
+
 namespace GafferImage
 {
 
@@ -134,6 +136,30 @@ void parallelGatherTiles(
 	TileOrder tileOrder = Unordered
 );
 
+// Fetches the channel data for all the tiles overlapping the window in
+// parallel, using the current context. This is useful for nodes which need
+// several input tiles to compute each output tile, because the upstream
+// computes then run concurrently rather than one after another. The tiles
+// are stored in `tiles` in row order, starting with the tile containing
+// `window.min`. Entries which are already non-null are left untouched.
+inline void parallelFetchTiles(
+	const ImagePlug *image,
+	const std::string &channelName,
+	const Imath::Box2i &window,
+	std::vector<IECore::ConstFloatVectorDataPtr> &tiles
+);
+
+// Returns the data for a single channel within the window, as a contiguous
+// array of `window.size().x * window.size().y` floats. Rows are stored
+// from the top of the window to the bottom, matching the usual convention
+// for image buffers. Tiles are fetched in parallel using the current context,
+// and pixels outside the data window are set to 0.
+inline IECore::FloatVectorDataPtr channelData(
+	const ImagePlug *image,
+	const std::string &channelName,
+	const Imath::Box2i &window
+);
+
 } // namespace ImageAlgo
 
 /// \todo Remove this temporary backwards compatibility.
@@ -41,6 +41,7 @@
 #include "boost/tuple/tuple.hpp"
 
 #include "Gaffer/Context.h"
+#include "Gaffer/NUMA.h"
 #include "GafferImage/ImagePlug.h"
 #include "GafferImage/BufferAlgo.h"
 
@@ -82,8 +83,7 @@ class ProcessTiles
 
 		void operator()( const tbb::blocked_range2d<size_t>& r ) const
 		{
-			Gaffer::ContextPtr context = new Gaffer::Context( *m_parentContext, Gaffer::Context::Borrowed );
-			Gaffer::Context::Scope scope( context.get() );
+			Gaffer::Context::EditableScope context( m_parentContext );
 
 			Imath::V2i tileId;
 			Imath::V2i tileIdMax( r.rows().end(), r.cols().end() );
@@ -93,7 +93,7 @@ class ProcessTiles
 				for( tileId.y = r.cols().begin(); tileId.y < tileIdMax.y; ++tileId.y )
 				{
 					Imath::V2i tileOrigin = m_tilesOrigin + ( tileId * ImagePlug::tileSize() );
-					context->set( ImagePlug::tileOriginContextName, tileOrigin );
+					context.set( ImagePlug::tileOriginContextName, tileOrigin );
 
 					m_functor( m_imagePlug, tileOrigin );
 				}
@@ -102,8 +102,7 @@ class ProcessTiles
 
 		void operator()( const tbb::blocked_range3d<size_t>& r ) const
 		{
-			Gaffer::ContextPtr context = new Gaffer::Context( *m_parentContext, Gaffer::Context::Borrowed );
-			Gaffer::Context::Scope scope( context.get() );
+			Gaffer::Context::EditableScope context( m_parentContext );
 
 			Imath::V2i tileId;
 			Imath::V2i tileIdMax( r.rows().end(), r.cols().end() );
@@ -113,11 +112,11 @@ class ProcessTiles
 				for( tileId.y = r.cols().begin(); tileId.y < tileIdMax.y; ++tileId.y )
 				{
 					Imath::V2i tileOrigin = m_tilesOrigin + ( tileId * ImagePlug::tileSize() );
-					context->set( ImagePlug::tileOriginContextName, tileOrigin );
+					context.set( ImagePlug::tileOriginContextName, tileOrigin );
 
 					for( size_t channelIndex = r.pages().begin(); channelIndex < r.pages().end(); ++channelIndex )
 					{
-						context->set( ImagePlug::channelNameContextName, m_channelNames[channelIndex] );
+						context.set( ImagePlug::channelNameContextName, m_channelNames[channelIndex] );
 
 						m_functor( m_imagePlug, m_channelNames[channelIndex], tileOrigin );
 					}
@@ -133,6 +132,67 @@ class ProcessTiles
 		const Gaffer::Context *m_parentContext;
 };
 
+// Returns the portion of a tile range covering rows of tiles
+// from `begin` to `end`.
+inline tbb::blocked_range2d<size_t> tileBand( const tbb::blocked_range2d<size_t> &r, size_t begin, size_t end )
+{
+	return tbb::blocked_range2d<size_t>( r.rows().begin(), r.rows().end(), r.rows().grainsize(), begin, end, r.cols().grainsize() );
+}
+
+inline tbb::blocked_range3d<size_t> tileBand( const tbb::blocked_range3d<size_t> &r, size_t begin, size_t end )
+{
+	return tbb::blocked_range3d<size_t>(
+		r.pages().begin(), r.pages().end(), r.pages().grainsize(),
+		r.rows().begin(), r.rows().end(), r.rows().grainsize(),
+		begin, end, r.cols().grainsize()
+	);
+}
+
+// Processes a horizontal band of tiles for each NUMA node, so that
+// each socket works on a contiguous region of the image.
+template <class Range, class Body>
+class ProcessTileBands
+{
+	public:
+		ProcessTileBands( const Range &range, const Body &body ) :
+				m_range( range ),
+				m_body( body )
+		{}
+
+		void operator()( size_t node ) const
+		{
+			const size_t numNodes = Gaffer::NUMA::numNodes();
+			const size_t begin = m_range.cols().begin();
+			const size_t size = m_range.cols().end() - begin;
+			const size_t bandBegin = begin + ( size * node ) / numNodes;
+			const size_t bandEnd = begin + ( size * ( node + 1 ) ) / numNodes;
+			if( bandBegin != bandEnd )
+			{
+				parallel_for( tileBand( m_range, bandBegin, bandEnd ), m_body );
+			}
+		}
+
+	private:
+		const Range &m_range;
+		const Body &m_body;
+};
+
+// Equivalent to `parallel_for( range, body )`, but partitioning
+// the rows of tiles between NUMA nodes where appropriate.
+template <class Range, class Body>
+void parallelForTiles( const Range &range, const Body &body )
+{
+	if( Gaffer::NUMA::partitionWork() )
+	{
+		ProcessTileBands<Range, Body> processTileBands( range, body );
+		Gaffer::NUMA::parallelForNodes( processTileBands );
+	}
+	else
+	{
+		parallel_for( range, body );
+	}
+}
+
 class TileInputIterator
 {
 	public:
@@ -316,12 +376,11 @@ class TileFunctorFilter
 
 		boost::tuple<size_t, Imath::V2i, typename TileFunctor::Result> operator()( boost::tuple<size_t, Imath::V2i> &it ) const
 		{
-			Gaffer::ContextPtr context = new Gaffer::Context( *m_parentContext, Gaffer::Context::Borrowed );
-			Gaffer::Context::Scope scope( context.get() );
+			Gaffer::Context::EditableScope context( m_parentContext );
 
 			const Imath::V2i tileOrigin = m_tilesOrigin + ( boost::get<1>( it ) * ImagePlug::tileSize() );
-			context->set( ImagePlug::tileOriginContextName, tileOrigin );
-			context->set( ImagePlug::channelNameContextName, m_channelNames[boost::get<0>( it )] );
+			context.set( ImagePlug::tileOriginContextName, tileOrigin );
+			context.set( ImagePlug::channelNameContextName, m_channelNames[boost::get<0>( it )] );
 
 			typename TileFunctor::Result result = m_functor( m_imagePlug, m_channelNames[boost::get<0>( it )], tileOrigin );
 
@@ -330,11 +389,10 @@ class TileFunctorFilter
 
 		boost::tuple<Imath::V2i, typename TileFunctor::Result> operator()( boost::tuple<Imath::V2i> &it ) const
 		{
-			Gaffer::ContextPtr context = new Gaffer::Context( *m_parentContext, Gaffer::Context::Borrowed );
-			Gaffer::Context::Scope scope( context.get() );
+			Gaffer::Context::EditableScope context( m_parentContext );
 
 			const Imath::V2i tileOrigin = m_tilesOrigin + ( boost::get<0>( it ) * ImagePlug::tileSize() );
-			context->set( ImagePlug::tileOriginContextName, tileOrigin );
+			context.set( ImagePlug::tileOriginContextName, tileOrigin );
 
 			typename TileFunctor::Result result = m_functor( m_imagePlug, tileOrigin );
 
@@ -381,23 +439,21 @@ class GatherFunctorFilter
 
 		void operator()( boost::tuple<size_t, Imath::V2i, typename TileFunctor::Result> &it ) const
 		{
-			Gaffer::ContextPtr context = new Gaffer::Context( *m_parentContext, Gaffer::Context::Borrowed );
-			Gaffer::Context::Scope scope( context.get() );
+			Gaffer::Context::EditableScope context( m_parentContext );
 
 			const Imath::V2i tileOrigin = m_tilesOrigin + ( boost::get<1>( it ) * ImagePlug::tileSize() );
-			context->set( ImagePlug::tileOriginContextName, tileOrigin );
-			context->set( ImagePlug::channelNameContextName, m_channelNames[boost::get<0>( it )] );
+			context.set( ImagePlug::tileOriginContextName, tileOrigin );
+			context.set( ImagePlug::channelNameContextName, m_channelNames[boost::get<0>( it )] );
 
 			m_functor( m_imagePlug, m_channelNames[boost::get<0>( it )], tileOrigin, boost::get<2>( it ) );
 		}
 
 		void operator()( boost::tuple<Imath::V2i, typename TileFunctor::Result> &it ) const
 		{
-			Gaffer::ContextPtr context = new Gaffer::Context( *m_parentContext, Gaffer::Context::Borrowed );
-			Gaffer::Context::Scope scope( context.get() );
+			Gaffer::Context::EditableScope context( m_parentContext );
 
 			const Imath::V2i tileOrigin = m_tilesOrigin + ( boost::get<0>( it ) * ImagePlug::tileSize() );
-			context->set( ImagePlug::tileOriginContextName, tileOrigin );
+			context.set( ImagePlug::tileOriginContextName, tileOrigin );
 
 			m_functor( m_imagePlug, tileOrigin, boost::get<1>( it ) );
 		}
@@ -410,6 +466,56 @@ class GatherFunctorFilter
 		const Gaffer::Context *m_parentContext;
 };
 
+class FetchTiles
+{
+
+	public :
+
+		FetchTiles(
+				const ImagePlug *imagePlug,
+				const std::string &channelName,
+				const Imath::V2i &tilesOrigin,
+				int numTilesX,
+				std::vector<IECore::ConstFloatVectorDataPtr> &tiles,
+				const Gaffer::Context *context
+			) :
+				m_imagePlug( imagePlug ),
+				m_channelName( channelName ),
+				m_tilesOrigin( tilesOrigin ),
+				m_numTilesX( numTilesX ),
+				m_tiles( tiles ),
+				m_parentContext( context )
+		{}
+
+		void operator()( const tbb::blocked_range<size_t> &r ) const
+		{
+			Gaffer::Context::EditableScope context( m_parentContext );
+			context.set( ImagePlug::channelNameContextName, m_channelName );
+
+			for( size_t i = r.begin(); i != r.end(); ++i )
+			{
+				if( m_tiles[i] )
+				{
+					continue;
+				}
+
+				const Imath::V2i tileOrigin = m_tilesOrigin + Imath::V2i( i % m_numTilesX, i / m_numTilesX ) * ImagePlug::tileSize();
+				context.set( ImagePlug::tileOriginContextName, tileOrigin );
+				m_tiles[i] = m_imagePlug->channelDataPlug()->getValue();
+			}
+		}
+
+	private :
+
+		const ImagePlug *m_imagePlug;
+		const std::string &m_channelName;
+		const Imath::V2i m_tilesOrigin;
+		const int m_numTilesX;
+		std::vector<IECore::ConstFloatVectorDataPtr> &m_tiles;
+		const Gaffer::Context *m_parentContext;
+
+};
+
 };
 
 //////////////////////////////////////////////////////////////////////////
@@ -509,9 +615,9 @@ void parallelProcessTiles( const ImagePlug *imagePlug, ThreadableFunctor &functo
 	}
 
 	const Imath::V2i tilesOrigin = ImagePlug::tileOrigin( processWindow.min );
-	const Imath::V2i numTiles = ( ImagePlug::tileOrigin( processWindow.max - Imath::V2i( 1 ) ) - tilesOrigin ) / ImagePlug::tileSize();
+	const Imath::V2i numTiles = ( ( ImagePlug::tileOrigin( processWindow.max - Imath::V2i( 1 ) ) - tilesOrigin ) / ImagePlug::tileSize() ) + Imath::V2i( 1 );
 
-	parallel_for( tbb::blocked_range2d<size_t>( 0, numTiles.x, 1, 0, numTiles.y, 1 ),
+	GafferImage::Detail::parallelForTiles( tbb::blocked_range2d<size_t>( 0, numTiles.x, 1, 0, numTiles.y, 1 ),
 			  GafferImage::Detail::ProcessTiles<ThreadableFunctor>( functor, imagePlug, tilesOrigin, Gaffer::Context::current() ) );
 }
 
@@ -531,7 +637,7 @@ void parallelProcessTiles( const ImagePlug *imagePlug, const std::vector<std::st
 	const Imath::V2i tilesOrigin = ImagePlug::tileOrigin( processWindow.min );
 	Imath::V2i numTiles = ( ( ImagePlug::tileOrigin( processWindow.max - Imath::V2i( 1 ) ) - tilesOrigin ) / ImagePlug::tileSize() ) + Imath::V2i( 1 );
 
-	parallel_for( tbb::blocked_range3d<size_t>( 0, channelNames.size(), 1, 0, numTiles.x, 1, 0, numTiles.y, 1 ),
+	GafferImage::Detail::parallelForTiles( tbb::blocked_range3d<size_t>( 0, channelNames.size(), 1, 0, numTiles.x, 1, 0, numTiles.y, 1 ),
 			  GafferImage::Detail::ProcessTiles<ThreadableFunctor>( functor, imagePlug, channelNames, tilesOrigin, Gaffer::Context::current() ) );
 }
 
@@ -603,6 +709,69 @@ void parallelGatherTiles( const ImagePlug *imagePlug, const std::vector<std::str
 	);
 }
 
+inline void parallelFetchTiles( const ImagePlug *image, const std::string &channelName, const Imath::Box2i &window, std::vector<IECore::ConstFloatVectorDataPtr> &tiles )
+{
+	if( BufferAlgo::empty( window ) )
+	{
+		return;
+	}
+
+	const Imath::V2i tilesOrigin = ImagePlug::tileOrigin( window.min );
+	const Imath::V2i numTiles = ( ImagePlug::tileOrigin( window.max - Imath::V2i( 1 ) ) - tilesOrigin ) / ImagePlug::tileSize() + Imath::V2i( 1 );
+
+	tiles.resize( numTiles.x * numTiles.y );
+	tbb::parallel_for(
+		tbb::blocked_range<size_t>( 0, tiles.size(), 1 ),
+		GafferImage::Detail::FetchTiles( image, channelName, tilesOrigin, numTiles.x, tiles, Gaffer::Context::current() )
+	);
+}
+
+inline IECore::FloatVectorDataPtr channelData( const ImagePlug *image, const std::string &channelName, const Imath::Box2i &window )
+{
+	IECore::FloatVectorDataPtr resultData = new IECore::FloatVectorData;
+	std::vector<float> &result = resultData->writable();
+	if( BufferAlgo::empty( window ) )
+	{
+		return resultData;
+	}
+
+	const Imath::V2i size = window.size();
+	result.resize( size.x * size.y, 0.0f );
+
+	const Imath::Box2i validWindow = BufferAlgo::intersection( window, image->dataWindowPlug()->getValue() );
+	if( BufferAlgo::empty( validWindow ) )
+	{
+		return resultData;
+	}
+
+	std::vector<IECore::ConstFloatVectorDataPtr> tiles;
+	parallelFetchTiles( image, channelName, validWindow, tiles );
+
+	const Imath::V2i tilesOrigin = ImagePlug::tileOrigin( validWindow.min );
+	const int numTilesX = ( ImagePlug::tileOrigin( Imath::V2i( validWindow.max.x - 1, 0 ) ).x - tilesOrigin.x ) / ImagePlug::tileSize() + 1;
+
+	for( int y = validWindow.min.y; y < validWindow.max.y; ++y )
+	{
+		float *row = &result[( window.max.y - 1 - y ) * size.x];
+		for( int x = validWindow.min.x; x < validWindow.max.x; )
+		{
+			const Imath::V2i tileOrigin = ImagePlug::tileOrigin( Imath::V2i( x, y ) );
+			const Imath::V2i tileIndex = ( tileOrigin - tilesOrigin ) / ImagePlug::tileSize();
+			const float *tile = &(tiles[tileIndex.y * numTilesX + tileIndex.x]->readable()[0]);
+
+			const int spanEnd = std::min( validWindow.max.x, tileOrigin.x + ImagePlug::tileSize() );
+			std::copy(
+				tile + ( y - tileOrigin.y ) * ImagePlug::tileSize() + ( x - tileOrigin.x ),
+				tile + ( y - tileOrigin.y ) * ImagePlug::tileSize() + ( spanEnd - tileOrigin.x ),
+				row + ( x - window.min.x )
+			);
+			x = spanEnd;
+		}
+	}
+
+	return resultData;
+}
+
 } // namespace ImageAlgo
 
 } // namespace GafferImage
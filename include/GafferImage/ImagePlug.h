@@ -135,9 +135,28 @@ class ImagePlug : public Gaffer::ValuePlug
 		IECore::MurmurHash imageHash() const;
 		//@}
 
-		static int tileSize() { return 64; };
+		/// Returns the size of the tiles used by all images. This defaults
+		/// to 64, and may be changed by setting the GAFFERIMAGE_TILESIZE
+		/// environment variable to a power of two from 16 to 1024 before
+		/// the process starts. The tile size can not be changed once images
+		/// have been processed, because it is built into every hash and
+		/// cache entry.
+		static int tileSize()
+		{
+			static const int g_tileSize = tileSizeFromEnvironment();
+			return g_tileSize;
+		};
+		/// Shared tiles filled with 0 and 1 respectively. Nodes should return
+		/// these directly rather than a copy wherever their output is known to
+		/// be constant, because downstream nodes may detect them by pointer
+		/// comparison and skip processing entirely. For instance, merging or
+		/// premultiplying black tiles just returns blackTile() again.
 		static const IECore::FloatVectorData *blackTile();
 		static const IECore::FloatVectorData *whiteTile();
+		/// Memoised hashes for blackTile() and whiteTile(), for use by
+		/// nodes which output them.
+		static const IECore::MurmurHash &blackTileHash();
+		static const IECore::MurmurHash &whiteTileHash();
 
 		/// Returns the origin of the tile that contains the point.
 		inline static Imath::V2i tileOrigin( const Imath::V2i &point )
@@ -150,6 +169,8 @@ class ImagePlug : public Gaffer::ValuePlug
 
 	private :
 
+		static int tileSizeFromEnvironment();
+
 		static void compoundObjectToCompoundData( const IECore::CompoundObject *object, IECore::CompoundData *data );
 
 		static size_t g_firstPlugIndex;
@@ -91,6 +91,16 @@ class ImagePrimitiveSource : public BaseType
 		Gaffer::ObjectPlug *inputImagePrimitivePlug();
 		const Gaffer::ObjectPlug *inputImagePrimitivePlug() const;
 
+		// The image primitive rearranged into tiles, computed once
+		// so that computeChannelData() is just a lookup.
+		Gaffer::ObjectPlug *tiledImagePrimitivePlug();
+		const Gaffer::ObjectPlug *tiledImagePrimitivePlug() const;
+
+		Gaffer::ObjectPlug *inputTiledImagePrimitivePlug();
+		const Gaffer::ObjectPlug *inputTiledImagePrimitivePlug() const;
+
+		static IECore::ConstCompoundObjectPtr tileImagePrimitive( const IECore::ImagePrimitive *image );
+
 };
 
 typedef ImagePrimitiveSource<ImageNode> ImagePrimitiveNode;
@@ -35,17 +35,88 @@
 //
 //////////////////////////////////////////////////////////////////////////
 
+#include "tbb/parallel_for.h"
+#include "tbb/blocked_range.h"
+
 #include "IECore/BoxOps.h"
 #include "IECore/BoxAlgo.h"
 #include "IECore/NullObject.h"
+#include "IECore/ObjectVector.h"
+#include "IECore/SimpleTypedData.h"
 
 #include "Gaffer/Context.h"
 
 #include "GafferImage/ImagePrimitiveSource.h"
+#include "GafferImage/BufferAlgo.h"
 
 namespace GafferImage
 {
 
+namespace Detail
+{
+
+// Copies rows of tiles out of full frame channel data. Each
+// index in the range addresses one row of tiles in one channel,
+// and writes only to the tiles in that row.
+struct ImagePrimitiveTiler
+{
+
+	ImagePrimitiveTiler(
+		const std::vector<const std::vector<float> *> &channels,
+		const std::vector<IECore::ObjectVector *> &tiles,
+		const Format &format, const Imath::Box2i &exrDataWindow,
+		const Imath::V2i &tilesOrigin, const Imath::V2i &numTiles
+	)
+		:	m_channels( channels ), m_tiles( tiles ), m_format( format ), m_exrDataWindow( exrDataWindow ),
+			m_dataWindow( format.fromEXRSpace( exrDataWindow ) ), m_tilesOrigin( tilesOrigin ), m_numTiles( numTiles )
+	{
+	}
+
+	void operator()( const tbb::blocked_range<size_t> &r ) const
+	{
+		const int tileSize = ImagePlug::tileSize();
+		for( size_t i = r.begin(); i != r.end(); ++i )
+		{
+			const std::vector<float> &channel = *m_channels[i / m_numTiles.y];
+			std::vector<IECore::ObjectPtr> &tiles = m_tiles[i / m_numTiles.y]->members();
+			const int tileY = i % m_numTiles.y;
+
+			for( int tileX = 0; tileX < m_numTiles.x; ++tileX )
+			{
+				const Imath::V2i tileOrigin = m_tilesOrigin + Imath::V2i( tileX, tileY ) * tileSize;
+				const Imath::Box2i tileBound( tileOrigin, tileOrigin + Imath::V2i( tileSize ) );
+				const Imath::Box2i bound = IECore::boxIntersection( tileBound, m_dataWindow );
+
+				IECore::FloatVectorDataPtr tileData = new IECore::FloatVectorData;
+				std::vector<float> &tile = tileData->writable();
+				tile.resize( tileSize * tileSize, 0.0f );
+
+				for( int y = bound.min.y; y < bound.max.y; ++y )
+				{
+					const size_t srcIndex = ( m_format.toEXRSpace( y ) - m_exrDataWindow.min.y ) * m_dataWindow.size().x + bound.min.x - m_exrDataWindow.min.x;
+					const size_t dstIndex = ( y - tileBound.min.y ) * tileSize + bound.min.x - tileBound.min.x;
+					std::copy( channel.begin() + srcIndex, channel.begin() + srcIndex + bound.size().x, tile.begin() + dstIndex );
+				}
+
+				tiles[tileY * m_numTiles.x + tileX] = tileData;
+			}
+		}
+	}
+
+	private :
+
+		const std::vector<const std::vector<float> *> &m_channels;
+		const std::vector<IECore::ObjectVector *> &m_tiles;
+		const Format &m_format;
+		const Imath::Box2i m_exrDataWindow;
+		const Imath::Box2i m_dataWindow;
+		const Imath::V2i m_tilesOrigin;
+		const Imath::V2i m_numTiles;
+
+};
+
+} // namespace Detail
+
 template<typename BaseType>
 const IECore::RunTimeTyped::TypeDescription<ImagePrimitiveSource<BaseType> > ImagePrimitiveSource<BaseType>::g_typeDescription;
 
@@ -56,6 +127,9 @@ ImagePrimitiveSource<BaseType>::ImagePrimitiveSource( const std::string &name )
 	BaseType::addChild( new Gaffer::ObjectPlug( "__imagePrimitive", Gaffer::Plug::Out, IECore::NullObject::defaultNullObject() ) );
 	BaseType::addChild( new Gaffer::ObjectPlug( "__inputImagePrimitive", Gaffer::Plug::In, IECore::NullObject::defaultNullObject(), Gaffer::Plug::Default & ~Gaffer::Plug::Serialisable ) );
 	inputImagePrimitivePlug()->setInput( imagePrimitivePlug() );
+	BaseType::addChild( new Gaffer::ObjectPlug( "__tiledImagePrimitive", Gaffer::Plug::Out, IECore::NullObject::defaultNullObject() ) );
+	BaseType::addChild( new Gaffer::ObjectPlug( "__inputTiledImagePrimitive", Gaffer::Plug::In, IECore::NullObject::defaultNullObject(), Gaffer::Plug::Default & ~Gaffer::Plug::Serialisable ) );
+	inputTiledImagePrimitivePlug()->setInput( tiledImagePrimitivePlug() );
 
 	// disable caching on our outputs, as we're basically caching the entire
 	// image ourselves in __inputImagePrimitive.
@@ -81,6 +155,11 @@ void ImagePrimitiveSource<BaseType>::affects( const Gaffer::Plug *input, Gaffer:
 		{
 			outputs.push_back( it->get() );
 		}
+		outputs.push_back( tiledImagePrimitivePlug() );
+	}
+	else if( input == inputTiledImagePrimitivePlug() )
+	{
+		outputs.push_back( BaseType::outPlug()->channelDataPlug() );
 	}
 }
 
@@ -93,6 +172,10 @@ void ImagePrimitiveSource<BaseType>::hash( const Gaffer::ValuePlug *output, cons
 	{
 		hashImagePrimitive( context, h );
 	}
+	else if( output == tiledImagePrimitivePlug() )
+	{
+		inputImagePrimitivePlug()->hash( h );
+	}
 }
 
 template<typename BaseType>
@@ -112,6 +195,20 @@ void ImagePrimitiveSource<BaseType>::compute( Gaffer::ValuePlug *output, const G
 		}
 		return;
 	}
+	else if( output == tiledImagePrimitivePlug() )
+	{
+		IECore::ConstImagePrimitivePtr image = IECore::runTimeCast<const IECore::ImagePrimitive>( inputImagePrimitivePlug()->getValue() );
+		Gaffer::ObjectPlug *plug = static_cast<Gaffer::ObjectPlug *>( output );
+		if( image )
+		{
+			plug->setValue( tileImagePrimitive( image.get() ) );
+		}
+		else
+		{
+			plug->setValue( plug->defaultValue() );
+		}
+		return;
+	}
 
 	return BaseType::compute( output, context );
 }
@@ -214,42 +311,72 @@ void ImagePrimitiveSource<BaseType>::hashChannelData( const GafferImage::ImagePl
 template<typename BaseType>
 IECore::ConstFloatVectorDataPtr ImagePrimitiveSource<BaseType>::computeChannelData( const std::string &channelName, const Imath::V2i &tileOrigin, const Gaffer::Context *context, const ImagePlug *parent ) const
 {
-	IECore::ConstImagePrimitivePtr image = IECore::runTimeCast<const IECore::ImagePrimitive>( inputImagePrimitivePlug()->getValue() );
-	if( !image )
+	IECore::ConstCompoundObjectPtr tiled = IECore::runTimeCast<const IECore::CompoundObject>( inputTiledImagePrimitivePlug()->getValue() );
+	if( !tiled )
+	{
+		return ImagePlug::blackTile();
+	}
+
+	const IECore::ObjectVector *tiles = tiled->member<IECore::CompoundObject>( "channels" )->member<IECore::ObjectVector>( channelName );
+	if( !tiles )
 	{
 		return ImagePlug::blackTile();
 	}
 
-	IECore::ConstFloatVectorDataPtr channelData = image->getChannel<float>( channelName );
-	if( !channelData )
+	const Imath::V2i tilesOrigin = tiled->member<IECore::V2iData>( "tilesOrigin" )->readable();
+	const Imath::V2i numTiles = tiled->member<IECore::V2iData>( "numTiles" )->readable();
+	const Imath::V2i tileIndex = ( tileOrigin - tilesOrigin ) / ImagePlug::tileSize();
+	if( tileOrigin.x < tilesOrigin.x || tileOrigin.y < tilesOrigin.y || tileIndex.x >= numTiles.x || tileIndex.y >= numTiles.y )
 	{
 		return ImagePlug::blackTile();
 	}
-	const std::vector<float> &channel = channelData->readable();
 
-	IECore::FloatVectorDataPtr resultData = new IECore::FloatVectorData;
-	std::vector<float> &result = resultData->writable();
-	result.resize( ImagePlug::tileSize() * ImagePlug::tileSize(), 0.0f );
+	return static_cast<const IECore::FloatVectorData *>( tiles->members()[tileIndex.y * numTiles.x + tileIndex.x].get() );
+}
 
+template<typename BaseType>
+IECore::ConstCompoundObjectPtr ImagePrimitiveSource<BaseType>::tileImagePrimitive( const IECore::ImagePrimitive *image )
+{
 	const Format format( image->getDisplayWindow(), 1.0f, /* fromEXRSpace = */ true );
 	const Imath::Box2i exrDataWindow = image->getDataWindow();
 	const Imath::Box2i dataWindow = format.fromEXRSpace( exrDataWindow );
 
-	Imath::Box2i tileBound( tileOrigin, tileOrigin + Imath::V2i( GafferImage::ImagePlug::tileSize() ) );
-	Imath::Box2i bound = IECore::boxIntersection( tileBound, dataWindow );
+	Imath::V2i tilesOrigin( 0 );
+	Imath::V2i numTiles( 0 );
+	if( !BufferAlgo::empty( dataWindow ) )
+	{
+		tilesOrigin = ImagePlug::tileOrigin( dataWindow.min );
+		numTiles = ( ImagePlug::tileOrigin( dataWindow.max - Imath::V2i( 1 ) ) - tilesOrigin ) / ImagePlug::tileSize() + Imath::V2i( 1 );
+	}
 
-	for( int y = bound.min.y; y<bound.max.y; y++ )
+	IECore::CompoundObjectPtr result = new IECore::CompoundObject;
+	result->members()["tilesOrigin"] = new IECore::V2iData( tilesOrigin );
+	result->members()["numTiles"] = new IECore::V2iData( numTiles );
+	IECore::CompoundObjectPtr channels = new IECore::CompoundObject;
+	result->members()["channels"] = channels;
+
+	// Only float channels are supported, matching
+	// ImagePrimitive::getChannel<float>().
+	std::vector<const std::vector<float> *> channelData;
+	std::vector<IECore::ObjectVector *> channelTiles;
+	for( IECore::PrimitiveVariableMap::const_iterator it = image->variables.begin(), eIt = image->variables.end(); it != eIt; ++it )
 	{
-		size_t srcIndex = ( format.toEXRSpace( y ) - exrDataWindow.min.y ) * dataWindow.size().x + bound.min.x - exrDataWindow.min.x;
-		size_t dstIndex = ( y - tileBound.min.y ) * GafferImage::ImagePlug::tileSize() + bound.min.x - tileBound.min.x;
-		const size_t srcEndIndex = srcIndex + bound.size().x;
-		while( srcIndex < srcEndIndex )
+		const IECore::FloatVectorData *data = image->getChannel<float>( it->first );
+		if( !data )
 		{
-			result[dstIndex++] = channel[srcIndex++];
+			continue;
 		}
+		IECore::ObjectVectorPtr tiles = new IECore::ObjectVector;
+		tiles->members().resize( numTiles.x * numTiles.y );
+		channels->members()[it->first] = tiles;
+		channelData.push_back( &data->readable() );
+		channelTiles.push_back( tiles.get() );
 	}
 
-	return resultData;
+	Detail::ImagePrimitiveTiler tiler( channelData, channelTiles, format, exrDataWindow, tilesOrigin, numTiles );
+	tbb::parallel_for( tbb::blocked_range<size_t>( 0, channelData.size() * numTiles.y ), tiler );
+
+	return result;
 }
 
 template<typename BaseType>
@@ -276,6 +403,30 @@ const Gaffer::ObjectPlug *ImagePrimitiveSource<BaseType>::inputImagePrimitivePlu
 	return BaseType::template getChild<Gaffer::ObjectPlug>( "__inputImagePrimitive" );
 }
 
+template<typename BaseType>
+Gaffer::ObjectPlug *ImagePrimitiveSource<BaseType>::tiledImagePrimitivePlug()
+{
+	return BaseType::template getChild<Gaffer::ObjectPlug>( "__tiledImagePrimitive" );
+}
+
+template<typename BaseType>
+const Gaffer::ObjectPlug *ImagePrimitiveSource<BaseType>::tiledImagePrimitivePlug() const
+{
+	return BaseType::template getChild<Gaffer::ObjectPlug>( "__tiledImagePrimitive" );
+}
+
+template<typename BaseType>
+Gaffer::ObjectPlug *ImagePrimitiveSource<BaseType>::inputTiledImagePrimitivePlug()
+{
+	return BaseType::template getChild<Gaffer::ObjectPlug>( "__inputTiledImagePrimitive" );
+}
+
+template<typename BaseType>
+const Gaffer::ObjectPlug *ImagePrimitiveSource<BaseType>::inputTiledImagePrimitivePlug() const
+{
+	return BaseType::template getChild<Gaffer::ObjectPlug>( "__inputTiledImagePrimitive" );
+}
+
 // \todo This function may be useful on other situations. Add as Converter?
 template<typename BaseType>
 void ImagePrimitiveSource<BaseType>::compoundDataToCompoundObject( const IECore::CompoundData *data, IECore::CompoundObject *object )
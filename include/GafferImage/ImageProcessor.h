@@ -90,6 +90,9 @@ class ImageProcessor : public ImageNode
 		virtual void hash( const Gaffer::ValuePlug *output, const Gaffer::Context *context, IECore::MurmurHash &h ) const;
 		/// Reimplemented from ImageNode to pass through the inPlug() computations when the node is disabled.
 		virtual void compute( Gaffer::ValuePlug *output, const Gaffer::Context *context ) const;
+		/// Reimplemented from ImageNode to declare the inPlug() as a pass-through when the node
+		/// or channel is disabled.
+		virtual const Gaffer::ValuePlug *passThrough( const Gaffer::ValuePlug *output, const Gaffer::Context *context ) const;
 
 	private :
 
@@ -76,7 +76,7 @@ class ImageStats : public Gaffer::ComputeNode
 
 	protected :
 
-		/// Implemented to hash the area we are sampling along with the channel context and regionOfInterest.
+		/// Implemented to hash the area we are sampling along with the channels and regionOfInterest.
 		virtual void hash( const Gaffer::ValuePlug *output, const Gaffer::Context *context, IECore::MurmurHash &h ) const;
 
 		/// Computes the min, max and average plugs by analyzing the input ImagePlug.
@@ -84,14 +84,18 @@ class ImageStats : public Gaffer::ComputeNode
 
 	private :
 
-		/// Sets channelName to the channel which corresponds to the output plug. The channel name is
-		/// computed from the intersection of the "in" plug's channels and the "channels" plug's channels.
-		/// If multiple channels are found to have the same channel index, the first is used.
-		/// For more information on this, please see ChannelMaskPlug::removeDuplicateIndices().
-		void channelNameFromOutput( const Gaffer::ValuePlug *output, std::string &channelName ) const;
-
-		/// A convenience function to just set the plug to 0 or 1 depending on what it's index is.
-		void setOutputToDefault( Gaffer::FloatPlug *output ) const;
+		/// Returns the channels we compute statistics for, indexed by
+		/// colour index. Channels which are not needed are left empty.
+		/// See ChannelMaskPlug::removeDuplicateIndices() for details
+		/// of how duplicate indices are resolved.
+		void statsChannels( std::string channels[4] ) const;
+
+		/// Holds the min, max and average for all four channels, computed
+		/// in a single parallel pass over the input tiles. The individual
+		/// output plugs are computed from this, so that they don't each
+		/// need to traverse the image separately.
+		Gaffer::FloatVectorDataPlug *allStatsPlug();
+		const Gaffer::FloatVectorDataPlug *allStatsPlug() const;
 
 		/// Implemented to initialize the default format settings if they don't exist already.
 		void parentChanging( Gaffer::GraphComponent *newParent );
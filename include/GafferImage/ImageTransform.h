@@ -43,6 +43,7 @@ namespace Gaffer
 {
 
 IE_CORE_FORWARDDECLARE( StringPlug )
+IE_CORE_FORWARDDECLARE( BoolPlug )
 IE_CORE_FORWARDDECLARE( Transform2DPlug )
 
 } // namespace Gaffer
@@ -69,6 +70,13 @@ class ImageTransform : public ImageProcessor
 		Gaffer::StringPlug *filterPlug();
 		const Gaffer::StringPlug *filterPlug() const;
 
+		/// When on, and the input is connected directly to
+		/// another ImageTransform, the two transforms are
+		/// concatenated and the upstream input is resampled
+		/// just once, using the filter from this node.
+		Gaffer::BoolPlug *concatenatePlug();
+		const Gaffer::BoolPlug *concatenatePlug() const;
+
 	protected :
 
 		virtual void hash( const Gaffer::ValuePlug *output, const Gaffer::Context *context, IECore::MurmurHash &h ) const;
@@ -96,6 +104,31 @@ class ImageTransform : public ImageProcessor
 		Resample *resample();
 		const Resample *resample() const;
 
+		// Output plug providing the full matrix for this node
+		// and any upstream transforms it has been concatenated
+		// with. Downstream ImageTransforms connect to this to
+		// concatenate with us.
+		Gaffer::M33fPlug *concatenatedMatrixPlug();
+		const Gaffer::M33fPlug *concatenatedMatrixPlug() const;
+
+		// The image we actually sample from. This is connected to
+		// inPlug() when we're not concatenating, and to the
+		// upstream ImageTransform's concatenatedInPlug() when
+		// we are.
+		ImagePlug *concatenatedInPlug();
+		const ImagePlug *concatenatedInPlug() const;
+
+		// Receives the concatenated matrix from an upstream
+		// ImageTransform. Only has an input when we're
+		// concatenating.
+		Gaffer::M33fPlug *upstreamMatrixPlug();
+		const Gaffer::M33fPlug *upstreamMatrixPlug() const;
+
+		void plugInputChanged( Gaffer::Plug *plug );
+		void plugSet( Gaffer::Plug *plug );
+		void updateConcatenation();
+		bool concatenating() const;
+
 		enum Operation
 		{
 			Identity = 0,
@@ -84,6 +84,15 @@ class ImageWriter : public GafferDispatch::TaskNode
 		Gaffer::ValuePlug *fileFormatSettingsPlug( const std::string &fileFormat );
 		const Gaffer::ValuePlug *fileFormatSettingsPlug( const std::string &fileFormat ) const;
 
+		/// Parent for additional files to be written from the same
+		/// input. Each child should be a ValuePlug containing a "fileName"
+		/// StringPlug and a "channels" ChannelMaskPlug. The additional
+		/// files use the settings from fileFormatSettingsPlug() for their
+		/// own format, and are written from the same pass over the input
+		/// as the main file, so each tile is only computed once.
+		Gaffer::ValuePlug *additionalOutputsPlug();
+		const Gaffer::ValuePlug *additionalOutputsPlug() const;
+
 		virtual IECore::MurmurHash hash( const Gaffer::Context *context ) const;
 
 		virtual void execute() const;
@@ -53,6 +53,8 @@ namespace GafferImage
 ///   of all input windows, rather than the union.
 /// - For some operations (add for instance) we could entirely skip invalid input tiles, and tiles
 ///   where channelData == ImagePlug::blackTile().
+/// - We could extend the occlusion test used for Over and Under to skip partially covered tiles
+///   using a per-pixel coverage mask.
 /// - For some operations we do not need to track the intermediate alpha values at all.
 /// - We could improve our masking of invalid pixels with special cases for wholly valid tiles,
 ///   wholly invalid tiles, and by chunking the work on the valid sections.
@@ -103,9 +105,14 @@ class Merge : public ImageProcessor
 
 	private :
 
+		// Fills `inputs` with the connected inputs which contribute to the
+		// specified tile, omitting any that are completely occluded by an
+		// opaque layer when using the Over or Under operations.
+		void visibleInputs( int operation, const Imath::V2i &tileOrigin, std::vector<const ImagePlug *> &inputs ) const;
+
 		// Performs the merge operation using the functor 'F'.
 		template<typename F>
-		IECore::ConstFloatVectorDataPtr merge( F f, const std::string &channelName, const Imath::V2i &tileOrigin ) const;
+		IECore::ConstFloatVectorDataPtr merge( F f, const std::vector<const ImagePlug *> &inputs, const std::string &channelName, const Imath::V2i &tileOrigin ) const;
 
 		static size_t g_firstPlugIndex;
 
@@ -78,7 +78,10 @@ class OpenColorIOTransform : public ColorProcessor
 		virtual void hashColorData( const Gaffer::Context *context, IECore::MurmurHash &h ) const;
 		/// Implemented to fetch an OpenColorIO Processor from the
 		/// OpenColorIO Config and apply it to the output channels.
-		/// Derived classes should implement transform() instead.
+		/// Processors are cached using the config's cache ID and
+		/// hashTransform(), so transform() is only called when a new
+		/// processor is needed. Derived classes should implement
+		/// transform() instead.
 		virtual void processColorData( const Gaffer::Context *context, IECore::FloatVectorData *r, IECore::FloatVectorData *g, IECore::FloatVectorData *b ) const;
 
 		/// Derived classes must implement this to return true if the specified input
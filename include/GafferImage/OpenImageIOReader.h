@@ -39,6 +39,7 @@
 #define GAFFERIMAGE_OPENIMAGEIOREADER_H
 
 #include "Gaffer/NumericPlug.h"
+#include "Gaffer/TypedObjectPlug.h"
 
 #include "GafferImage/ImageNode.h"
 
@@ -95,6 +96,26 @@ class OpenImageIOReader : public ImageNode
 		/// Returns the current memory usage of OIIO's cache in bytes.
 		static size_t cacheMemoryUsage();
 
+		/// Returns true if direct reads are enabled. See
+		/// setDirectReadsEnabled().
+		static bool getDirectReadsEnabled();
+		/// When enabled, tiled files whose tiles match ImagePlug::tileSize()
+		/// are read directly from disk rather than via OIIO's cache, leaving
+		/// Gaffer's own cache as the only place the pixels are stored. Other
+		/// files continue to be read via the OIIO cache. Defaults to off.
+		static void setDirectReadsEnabled( bool enabled );
+
+		/// Returns the number of frames to read ahead. See
+		/// setReadAheadFrames().
+		static int getReadAheadFrames();
+		/// When frames of a sequence are read in order, as they are during
+		/// playback or when writing a frame range in a single batch, the next
+		/// `frames` frames are loaded in the background so that disk and network
+		/// latency is hidden. Frames are loaded into the OIIO cache within half
+		/// of its memory limit, and otherwise just into the operating system's
+		/// file cache. Defaults to 0, meaning no read ahead.
+		static void setReadAheadFrames( int frames );
+
 	protected :
 
 		virtual void hash( const Gaffer::ValuePlug *output, const Gaffer::Context *context, IECore::MurmurHash &h ) const;
@@ -116,6 +137,13 @@ class OpenImageIOReader : public ImageNode
 
 		void hashFileName( const Gaffer::Context *context, IECore::MurmurHash &h ) const;
 
+		// Output plug used to read all the channels of a tile in a single
+		// call to OIIO. It is computed in a context without the channel
+		// name, and computeChannelData() simply hands out the members.
+		Gaffer::ObjectPlug *tileBatchPlug();
+		const Gaffer::ObjectPlug *tileBatchPlug() const;
+		IECore::ConstObjectVectorPtr computeTileBatch( const Gaffer::Context *context ) const;
+
 		void plugSet( Gaffer::Plug *plug );
 
 		static size_t g_firstPlugIndex;
@@ -39,6 +39,7 @@
 
 #include "Gaffer/NumericPlug.h"
 #include "Gaffer/CompoundNumericPlug.h"
+#include "Gaffer/TypedObjectPlug.h"
 
 #include "GafferImage/ImageProcessor.h"
 
@@ -101,6 +102,9 @@ class Resample : public ImageProcessor
 
 	protected :
 
+		virtual void hash( const Gaffer::ValuePlug *output, const Gaffer::Context *context, IECore::MurmurHash &h ) const;
+		virtual void compute( Gaffer::ValuePlug *output, const Gaffer::Context *context ) const;
+
 		virtual void hashDataWindow( const GafferImage::ImagePlug *parent, const Gaffer::Context *context, IECore::MurmurHash &h ) const;
 		virtual void hashChannelData( const GafferImage::ImagePlug *parent, const Gaffer::Context *context, IECore::MurmurHash &h ) const;
 
@@ -112,6 +116,22 @@ class Resample : public ImageProcessor
 		ImagePlug *horizontalPassPlug();
 		const ImagePlug *horizontalPassPlug() const;
 
+		// Filter weights for the separable passes. These depend only on
+		// the tile column (or row) and not on the channel, so they are
+		// computed without the channel name in the context and shared
+		// via the cache by all channels and tiles in the column (or row).
+		Gaffer::FloatVectorDataPlug *horizontalWeightsPlug();
+		const Gaffer::FloatVectorDataPlug *horizontalWeightsPlug() const;
+
+		Gaffer::FloatVectorDataPlug *verticalWeightsPlug();
+		const Gaffer::FloatVectorDataPlug *verticalWeightsPlug() const;
+
+		IECore::ConstFloatVectorDataPtr cachedFilterWeights( const Gaffer::FloatVectorDataPlug *weightsPlug, const Gaffer::Context *context ) const;
+
+		// Fast path for integer downsizes with a box filter, where each output
+		// pixel is the mean of a `factor` sized block of input pixels.
+		IECore::ConstFloatVectorDataPtr boxDownsizeChannelData( const std::string &channelName, const Imath::V2i &tileOrigin, const Imath::V2i &factor, const Imath::V2i &blockOffset, const Gaffer::Context *context ) const;
+
 		static size_t g_firstPlugIndex;
 
 };
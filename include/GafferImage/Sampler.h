@@ -95,6 +95,21 @@ class Sampler
 		/// 0.5, 0.5.
 		inline float sample( float x, float y );
 
+		/// Fills `result` with the values of the `width` pixels
+		/// starting at `x, y` and running in the positive x direction.
+		/// This is equivalent to calling `sample( int x, int y )` for
+		/// each pixel, but the bounding mode and tile lookups are dealt
+		/// with once per span rather than once per pixel, making it much
+		/// cheaper for filtering operations which visit whole rows. It is
+		/// the caller's responsibility to ensure that the span is contained
+		/// within the sample window passed to the constructor.
+		void sampleRow( int x, int y, int width, float *result );
+
+		/// Fetches all the tiles needed to service the sample window in
+		/// parallel. Tiles are otherwise fetched one by one on demand, so
+		/// this is worth calling before sampling a large area.
+		void populate();
+
 		/// Appends a hash that represent all the pixel
 		/// values within the requested sample area.
 		void hash( IECore::MurmurHash &h ) const;
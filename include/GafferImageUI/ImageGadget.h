@@ -37,6 +37,8 @@
 #ifndef GAFFERIMAGEUI_IMAGEGADGET_H
 #define GAFFERIMAGEUI_IMAGEGADGET_H
 
+#include "boost/scoped_ptr.hpp"
+
 #include "tbb/concurrent_unordered_map.h"
 
 #include "IECore/MurmurHash.h"
@@ -99,8 +101,33 @@ class ImageGadget : public GafferUI::Gadget
 		void setSoloChannel( int index );
 		int getSoloChannel() const;
 
+		/// Chooses the proxy level at which the image is computed
+		/// (see GafferImage::FormatPlug). The image is drawn scaled
+		/// up accordingly, so that it occupies the same area regardless
+		/// of the proxy level.
+		void setProxyLevel( int proxyLevel );
+		int getProxyLevel() const;
+
 		Imath::V2f pixelAt( const IECore::LineSegment3f &lineInGadgetSpace ) const;
 
+		/// @name Frame cache
+		///
+		/// To allow realtime playback, the ImageGadget can keep the tiles
+		/// of recently viewed frames in memory, independent of the compute
+		/// cache. Tiles are stored at half precision, and are reused when
+		/// the frame in the context changes, provided that nothing else
+		/// has changed in the meantime. Frames within the cache range are
+		/// also computed ahead of time whenever the UI is idle.
+		////////////////////////////////////////////////////////////////////
+		//@{
+		/// A limit of 0 disables the cache, which is the default.
+		void setFrameCacheMemoryLimit( size_t bytes );
+		size_t getFrameCacheMemoryLimit() const;
+		size_t frameCacheMemoryUsage() const;
+		/// Specifies the range of frames to be filled in the background.
+		void setFrameCacheRange( int startFrame, int endFrame );
+		//@}
+
 	protected :
 
 		virtual void doRender( const GafferUI::Style *style ) const;
@@ -124,6 +151,12 @@ class ImageGadget : public GafferUI::Gadget
 
 		boost::array<IECore::InternedString, 4> m_rgbaChannels;
 		int m_soloChannel;
+		int m_proxyLevel;
+
+		// Scope used whenever we pull on m_image, adding
+		// the proxy level to m_context.
+		class ProxyScope;
+		float proxyScale() const;
 
 		// Image access.
 		//
@@ -182,13 +215,29 @@ class ImageGadget : public GafferUI::Gadget
 			IECore::MurmurHash channelDataHash;
 			// Updated in parallel when the hash has changed.
 			IECore::ConstFloatVectorDataPtr channelDataToConvert;
+			// Alternatively, set when restoring a frame from the frame cache.
+			IECore::ConstHalfVectorDataPtr halfChannelDataToConvert;
 			// Created from channelDataToConvert in a serial process,
 			// because we can only to OpenGL work on the main thread.
 			IECoreGL::TexturePtr texture;
 		};
 
+		// Updates are performed progressively, so that computing
+		// a heavy image doesn't freeze the UI. Each call to updateTiles()
+		// computes tiles in order of distance from the centre of the
+		// viewport, until a time budget is exceeded. Any remaining tiles
+		// are left in m_tilesToUpdate, and an idle callback schedules
+		// another render to continue the update. Tiles which haven't been
+		// updated yet continue to display their previous contents.
 		void updateTiles() const;
 		void removeOutOfBoundsTiles() const;
+		void uploadTextures() const;
+		Imath::V2f viewportCentre() const;
+		void updateTilesIdle();
+
+		mutable std::vector<Imath::V2i> m_tilesToUpdate;
+		mutable std::vector<std::string> m_channelsToUpdate;
+		mutable boost::signals::scoped_connection m_updateTilesIdleConnection;
 
 		typedef tbb::concurrent_unordered_map<TileIndex, Tile> Tiles;
 		mutable Tiles m_tiles;
@@ -197,6 +246,16 @@ class ImageGadget : public GafferUI::Gadget
 
 		struct TileFunctor;
 
+		// Frame cache.
+
+		class FrameCache;
+		boost::scoped_ptr<FrameCache> m_frameCache;
+		mutable boost::signals::scoped_connection m_frameCacheIdleConnection;
+
+		void clearFrameCache() const;
+		bool restoreCachedFrame() const;
+		void frameCacheIdle();
+
 		// Rendering.
 
 		void renderTiles() const;
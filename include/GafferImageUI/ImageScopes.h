@@ -0,0 +1,174 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2017, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//      * Redistributions of source code must retain the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer.
+//
+//      * Redistributions in binary form must reproduce the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer in the documentation and/or other materials provided with
+//        the distribution.
+//
+//      * Neither the name of John Haddon nor the names of
+//        any other contributors to this software may be used to endorse or
+//        promote products derived from this software without specific prior
+//        written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#ifndef GAFFERIMAGEUI_IMAGESCOPES_H
+#define GAFFERIMAGEUI_IMAGESCOPES_H
+
+#include "boost/shared_ptr.hpp"
+
+#include "tbb/mutex.h"
+#include "tbb/spin_mutex.h"
+
+#include "OpenEXR/ImathBox.h"
+#include "OpenEXR/ImathColor.h"
+
+#include "IECore/RefCounted.h"
+#include "IECore/VectorTypedData.h"
+
+namespace Gaffer
+{
+
+IE_CORE_FORWARDDECLARE( Context )
+
+} // namespace Gaffer
+
+namespace GafferImage
+{
+
+IE_CORE_FORWARDDECLARE( ImagePlug )
+
+} // namespace GafferImage
+
+namespace GafferImageUI
+{
+
+/// Computes the histograms, waveform and vectorscope of an image, along
+/// with summary colour statistics, for display in the ImageView. The
+/// contribution of each tile is stored separately, so that update() only
+/// needs to process the tiles whose channel data has changed since the
+/// previous update. Tiles that were computed for display are retrieved
+/// from the compute cache rather than being computed again.
+///
+/// Luminance and chroma use the Rec. 709 coefficients.
+class ImageScopes : public IECore::RefCounted
+{
+
+	public :
+
+		ImageScopes();
+		virtual ~ImageScopes();
+
+		IE_CORE_DECLAREMEMBERPTR( ImageScopes )
+
+		void setImage( GafferImage::ConstImagePlugPtr image );
+		GafferImage::ConstImagePlugPtr getImage() const;
+
+		void setContext( Gaffer::ConstContextPtr context );
+		Gaffer::ConstContextPtr getContext() const;
+
+		/// Brings the results up to date with the image, returning true
+		/// if they have changed. This may be called from a background
+		/// thread, and the results remain readable while it runs.
+		/// Concurrent calls are serialised.
+		bool update();
+
+		enum Channel
+		{
+			Red = 0,
+			Green = 1,
+			Blue = 2,
+			Luminance = 3
+		};
+
+		/// The number of bins in each histogram. The bins span the
+		/// range 0-1, and values outside it are counted in the
+		/// first or last bin.
+		static const size_t histogramBins = 256;
+		IECore::ConstUIntVectorDataPtr histogram( Channel channel ) const;
+
+		/// The waveform counts the pixels of each luminance (rows, from
+		/// 0 at the bottom to 1 at the top) in each vertical slice of the
+		/// data window (columns, from left to right). It is stored in
+		/// row-major order.
+		static const size_t waveformWidth = 256;
+		static const size_t waveformHeight = 128;
+		IECore::ConstUIntVectorDataPtr waveform() const;
+
+		/// The vectorscope counts the pixels of each chroma, with Cb along
+		/// the columns and Cr along the rows, both spanning -0.5 to 0.5. It
+		/// is stored in row-major order.
+		static const size_t vectorscopeSize = 128;
+		IECore::ConstUIntVectorDataPtr vectorscope() const;
+
+		/// Colour statistics for all pixels in the data window.
+		Imath::Color4f minimum() const;
+		Imath::Color4f maximum() const;
+		Imath::Color4f average() const;
+
+		/// The data window that the results were computed for.
+		Imath::Box2i dataWindow() const;
+
+	private :
+
+		// Settings, protected by a separate mutex so they can be
+		// changed without waiting for an update to finish.
+		mutable tbb::spin_mutex m_settingsMutex;
+		GafferImage::ConstImagePlugPtr m_image;
+		Gaffer::ConstContextPtr m_context;
+
+		// Update state, protected by m_updateMutex. We store the
+		// contribution from each tile of the data window, indexed
+		// in row order, and running totals of all of them.
+		tbb::mutex m_updateMutex;
+
+		struct Tile;
+		typedef boost::shared_ptr<const Tile> ConstTilePtr;
+		struct TileFunctor;
+
+		Imath::Box2i m_dataWindow;
+		std::vector<ConstTilePtr> m_tiles;
+		std::vector<unsigned> m_histogramTotals;
+		std::vector<unsigned> m_waveformTotals;
+		std::vector<unsigned> m_vectorscopeTotals;
+
+		void accumulate( const Tile *tile, bool add );
+		void publish();
+
+		// Results, copied from the totals at the end of each update.
+		mutable tbb::spin_mutex m_resultsMutex;
+		IECore::ConstUIntVectorDataPtr m_histograms[4];
+		IECore::ConstUIntVectorDataPtr m_waveform;
+		IECore::ConstUIntVectorDataPtr m_vectorscope;
+		Imath::Color4f m_minimum;
+		Imath::Color4f m_maximum;
+		Imath::Color4f m_average;
+		Imath::Box2i m_resultDataWindow;
+
+};
+
+} // namespace GafferImageUI
+
+#endif // GAFFERIMAGEUI_IMAGESCOPES_H
@@ -69,6 +69,7 @@ namespace GafferImageUI
 {
 
 IE_CORE_FORWARDDECLARE( ImageGadget )
+IE_CORE_FORWARDDECLARE( ImageScopes )
 
 /// \todo Refactor this into smaller components, along the lines of the SceneView class.
 /// Consider redesigning the View/Tool classes so that view functionality can be built up
@@ -96,6 +97,20 @@ class ImageView : public GafferUI::View
 		Gaffer::StringPlug *displayTransformPlug();
 		const Gaffer::StringPlug *displayTransformPlug() const;
 
+		/// The memory available for caching frames for
+		/// playback, in megabytes. 0 disables the cache.
+		Gaffer::IntPlug *playbackCacheMemoryLimitPlug();
+		const Gaffer::IntPlug *playbackCacheMemoryLimitPlug() const;
+
+		/// Turns on the display of scopes in the UI.
+		Gaffer::BoolPlug *scopesPlug();
+		const Gaffer::BoolPlug *scopesPlug() const;
+
+		/// Scopes for the image being viewed, measured before the
+		/// exposure, gamma and display transform are applied. It is
+		/// the responsibility of the UI to call update() on them.
+		ImageScopes *imageScopes();
+
 		virtual void setContext( Gaffer::ContextPtr context );
 
 		typedef boost::function<GafferImage::ImageProcessorPtr ()> DisplayTransformCreator;
@@ -129,6 +144,8 @@ class ImageView : public GafferUI::View
 		void plugSet( Gaffer::Plug *plug );
 		bool keyPress( const GafferUI::KeyEvent &event );
 		void preRender();
+		void updateProxyLevel();
+		void updateFrameCacheRange();
 
 		void insertDisplayTransform();
 
@@ -136,6 +153,7 @@ class ImageView : public GafferUI::View
 		DisplayTransformMap m_displayTransforms;
 
 		ImageGadgetPtr m_imageGadget;
+		ImageScopesPtr m_imageScopes;
 		bool m_framed;
 
 		class ChannelChooser;
@@ -38,6 +38,8 @@
 #ifndef GAFFEROSL_OSLIMAGE_H
 #define GAFFEROSL_OSLIMAGE_H
 
+#include "IECore/CompoundObject.h"
+
 #include "GafferImage/ImageProcessor.h"
 
 #include "GafferScene/ShaderPlug.h"
@@ -80,15 +82,17 @@ class OSLImage : public GafferImage::ImageProcessor
 
 		// computeChannelData() is called for individual channels at a time, but when we run a
 		// shader we get all the outputs at once. we therefore use this plug to compute (and
-		// automatically cache) the shading and then access it from computeChannelData(), which
-		// simply extracts the right part of the data.
-		/// \todo Investigate turning off caching for the channelData plug, since we're currently
-		/// caching once there and once in the shadingPlug.
+		// automatically cache) the shading and then access it from computeChannelData(). To
+		// reduce per-shade overhead, the shading is computed for a block of several tiles at
+		// once, with the tileOrigin context variable holding the origin of the block. The result
+		// is a CompoundObject holding an ObjectVector of per-tile FloatVectorData for each output
+		// channel, so computeChannelData() can return tiles without copying. The channelData
+		// plug is not cacheable, so this is the only cached copy of the data.
 		Gaffer::ObjectPlug *shadingPlug();
 		const Gaffer::ObjectPlug *shadingPlug() const;
 
 		void hashShading( const Gaffer::Context *context, IECore::MurmurHash &h ) const;
-		IECore::ConstCompoundDataPtr computeShading( const Gaffer::Context *context ) const;
+		IECore::ConstCompoundObjectPtr computeShading( const Gaffer::Context *context ) const;
 
 		static size_t g_firstPlugIndex;
 
@@ -0,0 +1,61 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2017, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//      * Redistributions of source code must retain the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer.
+//
+//      * Redistributions in binary form must reproduce the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer in the documentation and/or other materials provided with
+//        the distribution.
+//
+//      * Neither the name of John Haddon nor the names of
+//        any other contributors to this software may be used to endorse or
+//        promote products derived from this software without specific prior
+//        written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#ifndef GAFFEROSL_PRIVATE_SHADERGROUPOPTIMISER_H
+#define GAFFEROSL_PRIVATE_SHADERGROUPOPTIMISER_H
+
+#include "OSL/oslexec.h"
+
+namespace GafferOSL
+{
+
+namespace Private
+{
+
+/// Launches a background task to optimise and JIT compile the shader group,
+/// returning immediately. OSL would otherwise do this lazily within the first
+/// call to `execute()`, stalling whichever thread happened to get there first
+/// while all others wait on the group. Calling this as soon as a group has been
+/// declared allows the compilation to overlap with other work. It is safe to
+/// execute the group before the optimisation completes - OSL serialises the
+/// optimisation of each group itself.
+void optimiseShaderGroupAsync( OSL::ShadingSystem *shadingSystem, OSL::ShaderGroupRef shaderGroup );
+
+} // namespace Private
+
+} // namespace GafferOSL
+
+#endif // GAFFEROSL_PRIVATE_SHADERGROUPOPTIMISER_H
@@ -53,6 +53,13 @@ class ShadingEngine : public IECore::RefCounted
 		ShadingEngine( const IECore::ObjectVector *shaderNetwork );
 		~ShadingEngine();
 
+		/// Returns a ShadingEngine for the network, reusing a previously
+		/// constructed one where possible. Networks are considered equivalent
+		/// if they differ only in the names of their shader handles, so identical
+		/// networks generated from different nodes share a single engine and
+		/// need only be compiled once.
+		static ConstPtr get( const IECore::ObjectVector *shaderNetwork );
+
 		struct Transform
 		{
 
@@ -96,6 +96,9 @@ class AlembicSource : public SceneNode
 		virtual GafferScene::ConstPathMatcherDataPtr computeSet( const IECore::InternedString &setName, const Gaffer::Context *context, const ScenePlug *parent ) const;
 
 		IECoreAlembic::AlembicInputPtr inputForPath( const ScenePath &path ) const;
+		/// Appends the time to the hash, unless the input for the path is
+		/// unanimated, in which case the hash can be shared between frames.
+		void appendTime( const ScenePath &path, const Gaffer::Context *context, IECore::MurmurHash &h ) const;
 
 		static size_t g_firstPlugIndex;
 
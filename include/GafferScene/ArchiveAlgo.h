@@ -0,0 +1,96 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2017, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//      * Redistributions of source code must retain the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer.
+//
+//      * Redistributions in binary form must reproduce the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer in the documentation and/or other materials provided with
+//        the distribution.
+//
+//      * Neither the name of John Haddon nor the names of
+//        any other contributors to this software may be used to endorse or
+//        promote products derived from this software without specific prior
+//        written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#ifndef GAFFERSCENE_ARCHIVEALGO_H
+#define GAFFERSCENE_ARCHIVEALGO_H
+
+#include "boost/function.hpp"
+
+#include "OpenEXR/ImathBox.h"
+
+#include "IECore/CompoundData.h"
+#include "IECore/MurmurHash.h"
+
+namespace GafferScene
+{
+
+/// Provides cached access to summary information about the archives
+/// referenced by procedurals, so that scenes referencing the same
+/// archives from many locations don't need to reopen them every time
+/// a bound is needed. Results are cached by file name and modification
+/// time, so an archive is reread when it changes on disk.
+///
+/// Metadata is provided as CompoundData, with the following
+/// well known members :
+///
+/// - "bound" : Box3fData, the bound of the archive contents.
+/// - "nodeCount" : IntData, the number of nodes in the archive.
+///
+/// Readers may omit members they can't provide cheaply. Any file
+/// format supported by IECore::SceneInterface is read automatically,
+/// providing the union of all the bound samples.
+namespace ArchiveAlgo
+{
+
+/// Should return the metadata for the specified file, throwing
+/// if it can't be read. Readers may be called concurrently.
+typedef boost::function<IECore::CompoundDataPtr ( const std::string &fileName )> MetadataReader;
+/// Registers a reader for files with the specified extension,
+/// given without the leading ".".
+void registerMetadataReader( const std::string &extension, MetadataReader reader );
+
+/// Returns the metadata for the specified file, or NULL if there
+/// is no reader for it. Throws if the file doesn't exist or can't
+/// be read. The result must not be modified.
+IECore::ConstCompoundDataPtr metadata( const std::string &fileName );
+/// Convenience returning the "bound" member of the metadata, or an
+/// empty box if it isn't available.
+Imath::Box3f bound( const std::string &fileName );
+/// Appends the file name and modification time to h, for use by
+/// nodes whose results depend on the metadata.
+void hash( const std::string &fileName, IECore::MurmurHash &h );
+
+/// Cache management. The limit is the number of files for which
+/// metadata is held.
+size_t getMetadataCacheSizeLimit();
+void setMetadataCacheSizeLimit( size_t maxEntries );
+void clearMetadataCache();
+
+} // namespace ArchiveAlgo
+
+} // namespace GafferScene
+
+#endif // GAFFERSCENE_ARCHIVEALGO_H
@@ -0,0 +1,94 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2017, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//      * Redistributions of source code must retain the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer.
+//
+//      * Redistributions in binary form must reproduce the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer in the documentation and/or other materials provided with
+//        the distribution.
+//
+//      * Neither the name of John Haddon nor the names of
+//        any other contributors to this software may be used to endorse or
+//        promote products derived from this software without specific prior
+//        written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#ifndef GAFFERSCENE_CAPSULE_H
+#define GAFFERSCENE_CAPSULE_H
+
+#include "IECore/VisibleRenderable.h"
+
+#include "Gaffer/Context.h"
+
+#include "GafferScene/ScenePlug.h"
+#include "GafferScene/TypeIds.h"
+
+namespace GafferScene
+{
+
+/// An object which stands in for an entire subtree of a scene, as
+/// generated by the Encapsulate node. Rather than containing the
+/// subtree itself, the Capsule references the ScenePlug and Context
+/// used to generate it, so that the subtree can be expanded lazily
+/// at render time. Capsules are not serialisable, and are only valid
+/// for as long as the ScenePlug they reference exists.
+class Capsule : public IECore::VisibleRenderable
+{
+
+	public :
+
+		Capsule();
+		/// A copy of context is taken. The hash should uniquely identify
+		/// the subtree, and is typically the hash of the object plug that
+		/// the Capsule is the value of.
+		Capsule( const ScenePlug *scene, const ScenePlug::ScenePath &root, const Gaffer::Context &context, const IECore::MurmurHash &hash, const Imath::Box3f &bound );
+		virtual ~Capsule();
+
+		IE_CORE_DECLAREEXTENSIONOBJECT( GafferScene::Capsule, CapsuleTypeId, IECore::VisibleRenderable );
+
+		/// Renders the children of root() via SceneProcedurals.
+		virtual void render( IECore::Renderer *renderer ) const;
+		/// Returns the bound of root() in its own local space.
+		virtual Imath::Box3f bound() const;
+
+		const ScenePlug *scene() const;
+		const ScenePlug::ScenePath &root() const;
+		/// The context in which the subtree should be evaluated.
+		const Gaffer::Context *context() const;
+
+	private :
+
+		IECore::MurmurHash m_hash;
+		const ScenePlug *m_scene;
+		ScenePlug::ScenePath m_root;
+		Gaffer::ConstContextPtr m_context;
+		Imath::Box3f m_bound;
+
+};
+
+IE_CORE_DECLAREPTR( Capsule )
+
+} // namespace GafferScene
+
+#endif // GAFFERSCENE_CAPSULE_H
@@ -80,6 +80,9 @@ class Constraint : public SceneElementProcessor
 
 	protected :
 
+		virtual void hash( const Gaffer::ValuePlug *output, const Gaffer::Context *context, IECore::MurmurHash &h ) const;
+		virtual void compute( Gaffer::ValuePlug *output, const Gaffer::Context *context ) const;
+
 		/// Reimplemented from SceneElementProcessor to call the constraint functions below.
 		virtual bool processesTransform() const;
 		virtual void hashProcessedTransform( const ScenePath &path, const Gaffer::Context *context, IECore::MurmurHash &h ) const;
@@ -95,6 +98,14 @@ class Constraint : public SceneElementProcessor
 
 	private :
 
+		// Used to compute the full transform of the target, including
+		// the effects of the target mode and offset. This is evaluated
+		// without "scene:path" in the context, so that it is computed
+		// only once and cached, no matter how many locations are
+		// constrained to the target.
+		Gaffer::M44fPlug *fullTargetTransformPlug();
+		const Gaffer::M44fPlug *fullTargetTransformPlug() const;
+
 		void tokenizeTargetPath( ScenePath &path ) const;
 
 		static size_t g_firstPlugIndex;
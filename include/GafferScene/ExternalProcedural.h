@@ -63,6 +63,12 @@ class ExternalProcedural : public ObjectSource
 		Gaffer::CompoundDataPlug *parametersPlug();
 		const Gaffer::CompoundDataPlug *parametersPlug() const;
 
+		/// When on, the bound is read from the archive using
+		/// ArchiveAlgo::bound(), falling back to boundPlug()
+		/// if the archive doesn't provide one.
+		Gaffer::BoolPlug *useArchiveBoundPlug();
+		const Gaffer::BoolPlug *useArchiveBoundPlug() const;
+
 		virtual void affects( const Gaffer::Plug *input, AffectedPlugsContainer &outputs ) const;
 
 	protected :
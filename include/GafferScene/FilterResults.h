@@ -76,6 +76,15 @@ class FilterResults : public Gaffer::ComputeNode
 
 	private :
 
+		// Holds the results for the subtree below the location
+		// specified by the context, with paths relative to that
+		// location. Each location is computed from the results
+		// for its children, so after an edit only the affected
+		// branches need to be recomputed, with the rest coming
+		// from the cache.
+		PathMatcherDataPlug *internalOutPlug();
+		const PathMatcherDataPlug *internalOutPlug() const;
+
 		static size_t g_firstPlugIndex;
 
 };
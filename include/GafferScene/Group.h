@@ -100,6 +100,9 @@ class Group : public SceneProcessor
 		const Gaffer::ObjectPlug *mappingPlug() const;
 
 		ScenePath sourcePath( const ScenePath &outputPath, const ScenePlug **source ) const;
+		// Appends the hashes of the bounds of all inputs, evaluated
+		// in parallel in the current context.
+		void hashInputBounds( IECore::MurmurHash &h ) const;
 
 		static size_t g_firstPlugIndex;
 
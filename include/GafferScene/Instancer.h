@@ -38,6 +38,8 @@
 #ifndef GAFFERSCENE_INSTANCER_H
 #define GAFFERSCENE_INSTANCER_H
 
+#include "Gaffer/Context.h"
+
 #include "GafferScene/BranchCreator.h"
 
 namespace GafferScene
@@ -63,6 +65,9 @@ class Instancer : public BranchCreator
 
 	protected :
 
+		/// Reimplemented to isolate the bound computation, which uses TBB tasks internally.
+		virtual Gaffer::ValuePlug::CachePolicy computeCachePolicy( const Gaffer::ValuePlug *output ) const;
+
 		virtual void hashBranchBound( const ScenePath &parentPath, const ScenePath &branchPath, const Gaffer::Context *context, IECore::MurmurHash &h ) const;
 		virtual Imath::Box3f computeBranchBound( const ScenePath &parentPath, const ScenePath &branchPath, const Gaffer::Context *context ) const;
 
@@ -85,11 +90,11 @@ class Instancer : public BranchCreator
 
 		IECore::ConstV3fVectorDataPtr sourcePoints( const ScenePath &parentPath ) const;
 		int instanceIndex( const ScenePath &branchPath ) const;
-		// Makes a new context suitable for use when evaluating instancePlug()
-		Gaffer::ContextPtr instanceContext( const Gaffer::Context *parentContext, const ScenePath &branchPath ) const;
-		// Fills an existing context with the fields needed for evaluating instancePlug()
-		void fillInstanceContext( Gaffer::Context *instanceContext, const ScenePath &branchPath ) const;
-		void fillInstanceContext( Gaffer::Context *instanceContext, const ScenePath &branchPath, int instanceId ) const;
+		// Fills a scope with the fields needed for evaluating instancePlug().
+		// We use an EditableScope rather than a new Context to avoid
+		// allocating a Context for every instance we visit.
+		void fillInstanceContext( Gaffer::Context::EditableScope &scope, const ScenePath &branchPath ) const;
+		void fillInstanceContext( Gaffer::Context::EditableScope &scope, const ScenePath &branchPath, int instanceId ) const;
 		Imath::M44f instanceTransform( const IECore::V3fVectorData *p, int instanceId ) const;
 
 		static size_t g_firstPlugIndex;
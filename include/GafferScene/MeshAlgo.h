@@ -0,0 +1,72 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2017, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//      * Redistributions of source code must retain the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer.
+//
+//      * Redistributions in binary form must reproduce the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer in the documentation and/or other materials provided with
+//        the distribution.
+//
+//      * Neither the name of John Haddon nor the names of
+//        any other contributors to this software may be used to endorse or
+//        promote products derived from this software without specific prior
+//        written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#ifndef GAFFERSCENE_MESHALGO_H
+#define GAFFERSCENE_MESHALGO_H
+
+#include <utility>
+
+#include "IECore/MeshPrimitive.h"
+
+namespace GafferScene
+{
+
+namespace MeshAlgo
+{
+
+/// Calculates vertex normals for the mesh, returning them as a primitive
+/// variable with Vertex interpolation. Each face contributes to the normal
+/// at a vertex in proportion to the angle it subtends there. Faces and
+/// vertices are processed in parallel.
+IECore::PrimitiveVariable calculateNormals( const IECore::MeshPrimitive *mesh, const std::string &position = "P" );
+
+/// Calculates vertex tangents in the directions of increasing u and v, where
+/// u and v are float primitive variables with Vertex or FaceVarying interpolation.
+/// If orthoTangents is true, the tangents are made perpendicular to the vertex
+/// normals. Throws if the required primitive variables are not available.
+std::pair<IECore::PrimitiveVariable, IECore::PrimitiveVariable> calculateTangents(
+	const IECore::MeshPrimitive *mesh,
+	const std::string &uName = "s",
+	const std::string &vName = "t",
+	bool orthoTangents = true,
+	const std::string &position = "P"
+);
+
+} // namespace MeshAlgo
+
+} // namespace GafferScene
+
+#endif // GAFFERSCENE_MESHALGO_H
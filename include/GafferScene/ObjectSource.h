@@ -107,6 +107,18 @@ class ObjectSource : public SceneNode
 		virtual void hashStandardSetNames( const Gaffer::Context *context, IECore::MurmurHash &h ) const;
 		virtual IECore::ConstInternedStringVectorDataPtr computeStandardSetNames() const;
 
+		/// Implemented to declare that when none of our input plugs vary with context,
+		/// our outputs depend only on the scene path, set name and level of detail.
+		/// This allows hashes to be shared between frames. Derived classes which use
+		/// other context variables in hashSource() must reimplement this to append them.
+		virtual bool contextDependencies( const Gaffer::ValuePlug *output, const Gaffer::Context *context, std::vector<IECore::InternedString> &variables ) const;
+
+		/// Utility for sources which generate geometry with a number of divisions.
+		/// Returns `divisions` halved once for each level of detail specified
+		/// by the context variable named ScenePlug::levelOfDetailContextName,
+		/// but no lower than `minimum`.
+		static Imath::V2i levelOfDetailDivisions( const Imath::V2i &divisions, const Imath::V2i &minimum, const Gaffer::Context *context );
+
 	private :
 
 		bool setNameValid( const IECore::InternedString &setName ) const;
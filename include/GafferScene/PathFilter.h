@@ -85,6 +85,7 @@ class PathFilter : public Filter
 		void plugDirtied( const Gaffer::Plug *plug );
 
 		PathMatcherDataPtr m_pathMatcher;
+		IECore::MurmurHash m_pathMatcherHash;
 
 		static size_t g_firstPlugIndex;
 
@@ -38,6 +38,11 @@
 #ifndef GAFFER_PATHMATCHER_H
 #define GAFFER_PATHMATCHER_H
 
+#include "boost/container/flat_map.hpp"
+
+#include "tbb/atomic.h"
+
+#include "IECore/MurmurHash.h"
 #include "IECore/TypedData.h"
 
 #include "GafferScene/Filter.h"
@@ -76,7 +81,10 @@ class PathMatcher
 		/// Adds all paths from the other PathMatcher, returning true if
 		/// any were added, and false if they were all already present.
 		bool addPaths( const PathMatcher &paths );
-		/// As above, but prefixing the paths that are added.
+		/// As above, but prefixing the paths that are added. Where the
+		/// prefix location is empty, the source tree is shared by reference
+		/// rather than copied, so the cost is proportional to the length of
+		/// the prefix rather than the number of paths.
 		bool addPaths( const PathMatcher &paths, const std::vector<IECore::InternedString> &prefix );
 		/// Removes all specified paths, returning true if any paths
 		/// were removed, and false if none existed anyway.
@@ -88,7 +96,8 @@ class PathMatcher
 		bool prune( const std::vector<IECore::InternedString> &path );
 
 		/// Constructs a new PathMatcher by rerooting all the paths
-		/// below prefix to /.
+		/// below prefix to /. The result shares its tree with this
+		/// PathMatcher, so this is cheap regardless of the number of paths.
 		PathMatcher subTree( const std::string &root ) const;
 		PathMatcher subTree( const std::vector<IECore::InternedString> &root ) const;
 
@@ -109,6 +118,12 @@ class PathMatcher
 		bool operator == ( const PathMatcher &other ) const;
 		bool operator != ( const PathMatcher &other ) const;
 
+		/// Returns a hash of the paths held by the matcher. Hashes
+		/// are cached for every subtree, so this is cheap for matchers
+		/// which have not been edited since they were last hashed, and
+		/// only the edited part of the tree is rehashed otherwise.
+		IECore::MurmurHash hash() const;
+
 		class RawIterator;
 		class Iterator;
 
@@ -156,8 +171,10 @@ class PathMatcher
 			// performance.
 			bool operator < ( const Name &other ) const;
 
-			const IECore::InternedString name;
-			const unsigned char type;
+			// Not const, so that Names may be stored by value in the
+			// sorted vector used by ChildMap.
+			IECore::InternedString name;
+			unsigned char type;
 
 		};
 
@@ -172,8 +189,14 @@ class PathMatcher
 				// between names with wildcards and those without. This is
 				// achieved by using an ordered container, and having the
 				// less than operation for Names sort first on hasWildcards
-				// and second on the name.
-				typedef std::map<Name, NodePtr> ChildMap;
+				// and second on the name. We use a flat_map rather than a
+				// std::map because the vast majority of nodes have only a
+				// handful of children, and a contiguous sorted vector is
+				// both smaller and faster to search and iterate than a tree
+				// of individually allocated nodes. Insertions are more
+				// expensive, but the trees are built once and queried many
+				// times.
+				typedef boost::container::flat_map<Name, NodePtr> ChildMap;
 				typedef ChildMap::iterator ChildMapIterator;
 				typedef ChildMap::value_type ChildMapValue;
 				typedef ChildMap::const_iterator ConstChildMapIterator;
@@ -197,9 +220,18 @@ class PathMatcher
 				bool clearChildren();
 				bool isEmpty();
 
+				// Returns a hash of the subtree below this node,
+				// computing it on demand.
+				IECore::MurmurHash hash() const;
+
 				ChildMap children;
 				bool terminator;
 
+				// Cache for hash(). Must be invalidated whenever the
+				// node or any of its descendants is edited.
+				mutable IECore::MurmurHash hashCache;
+				mutable tbb::atomic<bool> hashCacheValid;
+
 				// For most Node trees, the number of leaf nodes
 				// exceeds the number of branch nodes. Since by
 				// definition all leaf nodes are terminators with
@@ -214,6 +246,8 @@ class PathMatcher
 
 		// Utility used in lazy-copy-on-write.
 		PathMatcher::Node *writable( Node *node, NodePtr &writableCopy, bool shared );
+		// Utility used to invalidate cached hashes after a walk has edited descendants.
+		void dirtyHash( Node *node, bool changed, bool shared );
 
 		// Recursive method used to add a path to a Node tree. Since nodes may be shared among multiple
 		// trees, we perform lazy-copy-on-write when needing to edit a shared node. When we do this,
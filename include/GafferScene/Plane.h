@@ -70,6 +70,9 @@ class Plane : public ObjectSource
 
 	private :
 
+		// The divisions to generate, accounting for the level of detail.
+		Imath::V2i divisions( const Gaffer::Context *context ) const;
+
 		static size_t g_firstPlugIndex;
 
 };
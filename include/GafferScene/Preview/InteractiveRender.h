@@ -93,6 +93,10 @@ class InteractiveRender : public Gaffer::Node
 		Gaffer::Context *getContext();
 		const Gaffer::Context *getContext() const;
 
+		/// Returns the statistics reported by the renderer, or NULL
+		/// if the render is stopped. See `IECoreScenePreview::Renderer::statistics()`.
+		IECore::CompoundDataPtr rendererStatistics() const;
+
 	protected :
 
 		// Constructor for derived classes which wish to hardcode the renderer type. Perhaps
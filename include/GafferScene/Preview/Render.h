@@ -39,6 +39,7 @@
 
 #include "Gaffer/StringPlug.h"
 #include "Gaffer/NumericPlug.h"
+#include "Gaffer/TypedObjectPlug.h"
 
 #include "GafferDispatch/TaskNode.h"
 #include "GafferScene/TypeIds.h"
@@ -82,8 +83,23 @@ class Render : public GafferDispatch::TaskNode
 		ScenePlug *outPlug();
 		const ScenePlug *outPlug() const;
 
+		/// The cameras to render. When empty, the render camera
+		/// specified by the globals is used. Otherwise the scene is
+		/// translated once and rendered from each camera in turn, with
+		/// the globals reevaluated in a context containing a
+		/// "render:camera" variable, so that outputs can be named
+		/// per camera. Scene descriptions can only describe a single
+		/// render, so in SceneDescriptionMode one file is written per
+		/// camera, with the fileName evaluated in the same way.
+		Gaffer::StringVectorDataPlug *camerasPlug();
+		const Gaffer::StringVectorDataPlug *camerasPlug() const;
+
 		virtual IECore::MurmurHash hash( const Gaffer::Context *context ) const;
 		virtual void execute() const;
+		/// Executes each frame in turn, but only flushes the caches
+		/// after the final frame, so that the static parts of the scene
+		/// can be output cheaply from the cache on subsequent frames.
+		virtual void executeSequence( const std::vector<float> &frames ) const;
 
 	protected :
 
@@ -96,6 +112,8 @@ class Render : public GafferDispatch::TaskNode
 	private :
 
 		void construct( const IECore::InternedString &rendererType = IECore::InternedString() );
+		void executeInternal( bool flushCaches ) const;
+		void executeCameras( const std::vector<std::string> &cameras, bool flushCaches ) const;
 
 		static size_t g_firstPlugIndex;
 
@@ -38,6 +38,7 @@
 #define GAFFERSCENE_PREVIEW_RENDERERALGO_H
 
 #include "boost/container/flat_map.hpp"
+#include "boost/shared_ptr.hpp"
 
 #include "IECore/VectorTypedData.h"
 
@@ -86,6 +87,10 @@ class RenderSets : boost::noncopyable
 		const PathMatcher &camerasSet() const;
 		const PathMatcher &lightsSet() const;
 
+		/// Returns the names of the render sets containing the path, with
+		/// the "render:" prefix removed. Locations with identical membership
+		/// share the same result. It is safe to call this concurrently from
+		/// multiple threads, but not concurrently with update().
 		IECore::ConstInternedStringVectorDataPtr setsAttribute( const std::vector<IECore::InternedString> &path ) const;
 
 	private :
@@ -100,11 +105,16 @@ class RenderSets : boost::noncopyable
 		typedef boost::container::flat_map<IECore::InternedString, Set> Sets;
 
 		struct Updater;
+		struct Membership;
 
 		// Stores all the "render:" sets.
 		Sets m_sets;
 		Set m_camerasSet;
 		Set m_lightsSet;
+		// Combines all of m_sets into a single tree, so that
+		// setsAttribute() can find every set containing a path
+		// with a single walk. Rebuilt whenever m_sets changes.
+		boost::shared_ptr<Membership> m_membership;
 
 };
 
@@ -38,6 +38,7 @@
 #define IECORESCENEPREVIEW_RENDERER_H
 
 #include "IECore/CompoundObject.h"
+#include "IECore/CompoundData.h"
 #include "IECore/Display.h"
 #include "IECore/Camera.h"
 
@@ -253,6 +254,13 @@ class Renderer : public IECore::RefCounted
 		/// coordinate systems have their own dedicated calls?
 		virtual ObjectInterfacePtr object( const std::string &name, const IECore::Object *object, const AttributesInterface *attributes ) = 0;
 		/// As above, but specifying a deforming object.
+		/// \todo Consider a batch variant taking a vector of (name, samples,
+		/// transform, attributes) records, so that backends could amortise
+		/// locking and allocate node storage in bulk. This is only worthwhile
+		/// once RendererAlgo outputs several locations per task - currently each
+		/// location is output independently by its own traversal task, and
+		/// buffering records across tasks would reintroduce the locking we'd be
+		/// trying to avoid, as well as delaying the flushing of Batch objects.
 		virtual ObjectInterfacePtr object( const std::string &name, const std::vector<const IECore::Object *> &samples, const std::vector<float> &times, const AttributesInterface *attributes ) = 0;
 
 		/// Performs the render - should be called after the
@@ -262,11 +270,45 @@ class Renderer : public IECore::RefCounted
 		/// renders will return immediately and perform the
 		/// rendering in the background, allowing pause() to be
 		/// used to make edits before calling render() again.
+		///
+		/// Batch renders may also call render() more than once,
+		/// changing the "camera" option and the outputs in between,
+		/// so that several cameras can be rendered sequentially from
+		/// a single translation of the scene. Other edits are not
+		/// supported between batch renders.
+		/// \todo Allow renderers which are capable of it to render
+		/// several cameras simultaneously.
 		virtual void render() = 0;
 		/// If an interactive render is running, pauses it so
 		/// that edits may be made.
 		virtual void pause() = 0;
 
+		/// Returns statistics describing the work the renderer has done
+		/// so far, for display to the user and for performance analysis.
+		/// Implementations may return anything they find useful, but
+		/// should use the following names where they apply :
+		///
+		/// Standard Statistics
+		/// -------------------
+		///
+		/// "cameras", "lights", "objects", UInt64Data
+		/// The number of locations of each type that have been output.
+		///
+		/// "instancesCreated", "instancesReused", UInt64Data
+		/// For renderers which instance identical geometry automatically,
+		/// the number of unique nodes created and the number of times an
+		/// existing node was shared instead.
+		///
+		/// "shadersCreated", "shadersReused", UInt64Data
+		/// As above, but for shader networks.
+		///
+		/// "translationTime", DoubleData
+		/// The time in seconds spent converting locations into the native
+		/// representation of the renderer, summed over all threads.
+		///
+		/// The default implementation returns an empty CompoundData.
+		virtual IECore::CompoundDataPtr statistics() const;
+
 	protected :
 
 		Renderer();
@@ -78,8 +78,41 @@ void matchingPaths( const Gaffer::IntPlug *filterPlug, const ScenePlug *scene, P
 /// As above, but specifying the filter as a PathMatcher.
 void matchingPaths( const PathMatcher &filter, const ScenePlug *scene, PathMatcher &paths );
 
+/// Invokes the Functor at every location in the scene,
+/// visiting parent locations before their children, but
+/// otherwise processing locations in parallel as much
+/// as possible. The traversal may be cancelled via the
+/// canceller of the current context.
+///
+/// Functor should be of the following form.
+///
+/// ```
+/// struct Functor
+/// {
+///
+///     /// Called to construct a new functor to be used at
+///     /// each child location. This allows state to be
+///     /// accumulated as the scene is traversed, with each
+///     /// parent passing its state to its children.
+///     Functor( const Functor &parent );
+///
+///     /// Called to process a specific location. May return
+///     /// false to prune the traversal, or true to continue
+///     /// to the children.
+///     bool operator()( const ScenePlug *scene, const ScenePlug::ScenePath &path );
+///
+/// };
+/// ```
+template <class Functor>
+void parallelProcessLocations( const ScenePlug *scene, Functor &f );
+/// As above, but starting the traversal at the specified root
+/// location rather than at the root of the scene.
+template <class Functor>
+void parallelProcessLocations( const ScenePlug *scene, Functor &f, const ScenePlug::ScenePath &root );
+
 /// Calls a functor on all paths in the scene
-/// The functor must take ( const ScenePlug*, const ScenePlug::ScenePath& ), and can return false to prune traversal
+/// The functor must take ( const ScenePlug*, const ScenePlug::ScenePath& ), and can return false to prune traversal.
+/// Unlike parallelProcessLocations(), a single functor is shared between all locations.
 template <class ThreadableFunctor>
 void parallelTraverse( const ScenePlug *scene, ThreadableFunctor &f );
 
@@ -124,6 +157,15 @@ IECore::ConstCompoundDataPtr sets( const ScenePlug *scene );
 /// As above, but returning only the requested sets.
 IECore::ConstCompoundDataPtr sets( const ScenePlug *scene, const std::vector<IECore::InternedString> &setNames );
 
+/// Returns the union of the bounds of the children of the specified location,
+/// transformed into the location's local space. Children are evaluated in
+/// parallel. If the child names are already available they may be passed to
+/// avoid computing them again.
+Imath::Box3f unionOfTransformedChildBounds( const ScenePlug *scene, const ScenePlug::ScenePath &path, const IECore::InternedStringVectorData *childNames = NULL );
+/// Returns a hash for the result of unionOfTransformedChildBounds(). Children
+/// are hashed in parallel, but the result does not depend on the scheduling.
+IECore::MurmurHash hashOfTransformedChildBounds( const ScenePlug *scene, const ScenePlug::ScenePath &path, const IECore::InternedStringVectorData *childNames = NULL );
+
 /// Returns a bounding box for the specified object. Typically
 /// this is provided by the VisibleRenderable::bound() method, but
 /// for other object types we must return a synthetic bound.
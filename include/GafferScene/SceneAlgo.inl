@@ -35,7 +35,9 @@
 //////////////////////////////////////////////////////////////////////////
 
 #include "tbb/task.h"
+#include "tbb/parallel_for.h"
 #include "Gaffer/Context.h"
+#include "Gaffer/NUMA.h"
 
 namespace GafferScene
 {
@@ -43,69 +45,185 @@ namespace GafferScene
 namespace Detail
 {
 
-template <class ThreadableFunctor>
-class TraverseTask : public tbb::task
+template<typename Functor>
+class LocationTask : public tbb::task
 {
 
 	public :
 
-		TraverseTask(
+		LocationTask(
 			const GafferScene::ScenePlug *scene,
 			const Gaffer::Context *context,
-			ThreadableFunctor &f
+			const ScenePlug::ScenePath &path,
+			Functor &f
 		)
-			:	m_scene( scene ), m_context( context ), m_f( f )
+			:	m_scene( scene ), m_context( context ), m_path( path ), m_f( f )
 		{
 		}
 
-		virtual ~TraverseTask()
+		virtual ~LocationTask()
 		{
 		}
 
 		virtual task *execute()
 		{
+			Gaffer::Canceller::check( m_context->canceller() );
+
+			Gaffer::Context::EditableScope context( m_context );
+			context.set( ScenePlug::scenePathContextName, m_path );
+
+			if( !m_f( m_scene, m_path ) )
+			{
+				return NULL;
+			}
 
-			Gaffer::ContextPtr context = new Gaffer::Context( *m_context, Gaffer::Context::Borrowed );
-			context->set( ScenePlug::scenePathContextName, m_path );
-			Gaffer::Context::Scope scopedContext( context.get() );
+			IECore::ConstInternedStringVectorDataPtr childNamesData = m_scene->childNamesPlug()->getValue();
+			const std::vector<IECore::InternedString> &childNames = childNamesData->readable();
+			if( childNames.empty() )
+			{
+				return NULL;
+			}
+
+			std::vector<Functor> childFunctors( childNames.size(), m_f );
 
-			if( m_f( m_scene, m_path ) )
+			set_ref_count( 1 + childNames.size() );
+
+			ScenePlug::ScenePath childPath = m_path;
+			childPath.push_back( IECore::InternedString() ); // space for the child name
+			for( size_t i = 0, e = childNames.size(); i < e; ++i )
 			{
-				IECore::ConstInternedStringVectorDataPtr childNamesData = m_scene->childNamesPlug()->getValue();
-				const std::vector<IECore::InternedString> &childNames = childNamesData->readable();
-
-				set_ref_count( 1 + childNames.size() );
-
-				ScenePlug::ScenePath childPath = m_path;
-				childPath.push_back( IECore::InternedString() ); // space for the child name
-				for( std::vector<IECore::InternedString>::const_iterator it = childNames.begin(), eIt = childNames.end(); it != eIt; it++ )
-				{
-					childPath[m_path.size()] = *it;
-					TraverseTask *t = new( allocate_child() ) TraverseTask( *this, childPath );
-					spawn( *t );
-				}
-				wait_for_all();
+				childPath.back() = childNames[i];
+				LocationTask *t = new( allocate_child() ) LocationTask( m_scene, m_context, childPath, childFunctors[i] );
+				spawn( *t );
 			}
+			wait_for_all();
 
 			return NULL;
 		}
 
-	protected :
+	private :
+
+		const GafferScene::ScenePlug *m_scene;
+		const Gaffer::Context *m_context;
+		const GafferScene::ScenePlug::ScenePath m_path;
+		Functor &m_f;
+
+};
+
+// Divides the children of a location between NUMA nodes, so that
+// each socket traverses its own portion of the hierarchy.
+template<typename Functor>
+class NodeLocations
+{
 
-		TraverseTask( const TraverseTask &other, const ScenePlug::ScenePath &path )
-			:	m_scene( other.m_scene ),
-				m_context( other.m_context ),
-				m_f( other.m_f ),
-				m_path( path )
+	public :
+
+		NodeLocations(
+			const GafferScene::ScenePlug *scene,
+			const Gaffer::Context *context,
+			const ScenePlug::ScenePath &parent,
+			const std::vector<IECore::InternedString> &childNames,
+			std::vector<Functor> &childFunctors
+		)
+			:	m_scene( scene ), m_context( context ), m_parent( parent ), m_childNames( childNames ), m_childFunctors( childFunctors )
+		{
+		}
+
+		void operator()( size_t node ) const
 		{
+			const size_t numNodes = Gaffer::NUMA::numNodes();
+			const size_t begin = ( m_childNames.size() * node ) / numNodes;
+			const size_t end = ( m_childNames.size() * ( node + 1 ) ) / numNodes;
+			if( begin != end )
+			{
+				tbb::parallel_for( tbb::blocked_range<size_t>( begin, end ), *this );
+			}
+		}
+
+		void operator()( const tbb::blocked_range<size_t> &r ) const
+		{
+			ScenePlug::ScenePath childPath = m_parent;
+			childPath.push_back( IECore::InternedString() ); // space for the child name
+			for( size_t i = r.begin(); i != r.end(); ++i )
+			{
+				childPath.back() = m_childNames[i];
+				LocationTask<Functor> *t = new( tbb::task::allocate_root() ) LocationTask<Functor>( m_scene, m_context, childPath, m_childFunctors[i] );
+				tbb::task::spawn_root_and_wait( *t );
+			}
 		}
 
 	private :
 
 		const GafferScene::ScenePlug *m_scene;
 		const Gaffer::Context *m_context;
+		const ScenePlug::ScenePath &m_parent;
+		const std::vector<IECore::InternedString> &m_childNames;
+		std::vector<Functor> &m_childFunctors;
+
+};
+
+// Processes `path` on the calling thread, and then divides its children
+// between the NUMA nodes. Locations with fewer children than there are
+// nodes are descended through until there is enough work to go round,
+// so that a single top-level group doesn't leave all but one node idle.
+template<typename Functor>
+void processLocationsAcrossNodes( const GafferScene::ScenePlug *scene, const Gaffer::Context *context, const ScenePlug::ScenePath &path, Functor &f )
+{
+	Gaffer::Canceller::check( context->canceller() );
+
+	IECore::ConstInternedStringVectorDataPtr childNamesData;
+	{
+		Gaffer::Context::EditableScope scope( context );
+		scope.set( ScenePlug::scenePathContextName, path );
+		if( !f( scene, path ) )
+		{
+			return;
+		}
+		childNamesData = scene->childNamesPlug()->getValue();
+	}
+
+	const std::vector<IECore::InternedString> &childNames = childNamesData->readable();
+	if( childNames.empty() )
+	{
+		return;
+	}
+
+	std::vector<Functor> childFunctors( childNames.size(), f );
+	if( childNames.size() < Gaffer::NUMA::numNodes() )
+	{
+		ScenePlug::ScenePath childPath = path;
+		childPath.push_back( IECore::InternedString() ); // space for the child name
+		for( size_t i = 0, e = childNames.size(); i < e; ++i )
+		{
+			childPath.back() = childNames[i];
+			processLocationsAcrossNodes( scene, context, childPath, childFunctors[i] );
+		}
+		return;
+	}
+
+	NodeLocations<Functor> nodeLocations( scene, context, path, childNames, childFunctors );
+	Gaffer::NUMA::parallelForNodes( nodeLocations );
+}
+
+// Adaptor used to implement parallelTraverse() using parallelProcessLocations(),
+// sharing a single functor between all locations rather than copying it.
+template <class ThreadableFunctor>
+struct SharedFunctor
+{
+
+	SharedFunctor( ThreadableFunctor &f )
+		:	m_f( f )
+	{
+	}
+
+	bool operator()( const GafferScene::ScenePlug *scene, const GafferScene::ScenePlug::ScenePath &path )
+	{
+		return m_f( scene, path );
+	}
+
+	private :
+
 		ThreadableFunctor &m_f;
-		GafferScene::ScenePlug::ScenePath m_path;
 
 };
 
@@ -168,15 +286,35 @@ struct PathMatcherFunctor
 namespace SceneAlgo
 {
 
-template <class ThreadableFunctor>
-void parallelTraverse( const GafferScene::ScenePlug *scene, ThreadableFunctor &f )
+template <class Functor>
+void parallelProcessLocations( const GafferScene::ScenePlug *scene, Functor &f )
+{
+	parallelProcessLocations( scene, f, ScenePlug::ScenePath() );
+}
+
+template <class Functor>
+void parallelProcessLocations( const GafferScene::ScenePlug *scene, Functor &f, const ScenePlug::ScenePath &root )
 {
 	Gaffer::ContextPtr c = new Gaffer::Context( *Gaffer::Context::current(), Gaffer::Context::Borrowed );
 	GafferScene::Filter::setInputScene( c.get(), scene );
-	Detail::TraverseTask<ThreadableFunctor> *task = new( tbb::task::allocate_root() ) Detail::TraverseTask<ThreadableFunctor>( scene, c.get(), f );
+
+	if( Gaffer::NUMA::partitionWork() )
+	{
+		Detail::processLocationsAcrossNodes( scene, c.get(), root, f );
+		return;
+	}
+
+	Detail::LocationTask<Functor> *task = new( tbb::task::allocate_root() ) Detail::LocationTask<Functor>( scene, c.get(), root, f );
 	tbb::task::spawn_root_and_wait( *task );
 }
 
+template <class ThreadableFunctor>
+void parallelTraverse( const GafferScene::ScenePlug *scene, ThreadableFunctor &f )
+{
+	Detail::SharedFunctor<ThreadableFunctor> sf( f );
+	parallelProcessLocations( scene, sf );
+}
+
 template <class ThreadableFunctor>
 void filteredParallelTraverse( const GafferScene::ScenePlug *scene, const GafferScene::Filter *filter, ThreadableFunctor &f )
 {
@@ -82,6 +82,10 @@ class SceneElementProcessor : public FilteredSceneProcessor
 		/// Implemented to call computeProcessedObject() where appropriate.
 		virtual IECore::ConstObjectPtr computeObject( const ScenePath &path, const Gaffer::Context *context, const ScenePlug *parent ) const;
 
+		/// Implemented to declare the input transform, attributes and object as pass-throughs
+		/// at locations which aren't processed.
+		virtual const Gaffer::ValuePlug *passThrough( const Gaffer::ValuePlug *output, const Gaffer::Context *context ) const;
+
 		/// @name Scene processing methods
 		/// These methods should be reimplemented by derived classes to process the input scene - they will be called as
 		/// appropriate based on the result of the filter applied to the node. To process a particular
@@ -107,6 +111,12 @@ class SceneElementProcessor : public FilteredSceneProcessor
 
 		/// Note that if you implement processesObject() in such a way as to deform the object, you /must/ also
 		/// implement processesBound() appropriately.
+		///
+		/// Implementations of computeProcessedObject() should return the input object directly
+		/// when they make no changes to it. When changes are necessary, it is sufficient to
+		/// copy() the input and edit the copy : IECore::TypedData shares its storage between
+		/// copies, so only the data which is subsequently modified via writable() is
+		/// actually duplicated.
 		virtual bool processesObject() const;
 		virtual void hashProcessedObject( const ScenePath &path, const Gaffer::Context *context, IECore::MurmurHash &h ) const;
 		virtual IECore::ConstObjectPtr computeProcessedObject( const ScenePath &path, const Gaffer::Context *context, IECore::ConstObjectPtr inputObject ) const;
@@ -123,7 +123,7 @@ class SceneNode : public Gaffer::ComputeNode
 		/// children. Using this from computeBound() should be a last resort, as it implies peeking inside children to determine
 		/// information about the parent - the last thing we want to be doing when defining large scenes procedurally. If
 		/// `out->childNames()` has been computed already for some reason, then it may be passed to avoid recomputing it
-		/// internally.
+		/// internally. Children are evaluated in parallel using SceneAlgo::unionOfTransformedChildBounds().
 		Imath::Box3f unionOfTransformedChildBounds( const ScenePath &path, const ScenePlug *out, const IECore::InternedStringVectorData *childNames = NULL ) const;
 		/// A hash for the result of the computation in unionOfTransformedChildBounds().
 		IECore::MurmurHash hashOfTransformedChildBounds( const ScenePath &path, const ScenePlug *out, const IECore::InternedStringVectorData *childNames = NULL ) const;
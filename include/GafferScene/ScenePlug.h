@@ -125,6 +125,12 @@ class ScenePlug : public Gaffer::ValuePlug
 		/// The name used to specify the name of the set to be
 		/// computed in a Context.
 		static const IECore::InternedString setNameContextName;
+		/// The name used to specify the level of detail required
+		/// of the scene, as an int. A value of 0, which is assumed
+		/// when the variable is absent, requests full detail, and
+		/// sources may reduce their detail for higher values. The
+		/// Viewer uses a higher value than final renders do.
+		static const IECore::InternedString levelOfDetailContextName;
 
 		/// @name Convenience accessors
 		/// These functions create temporary Contexts specifying the necessary
@@ -137,10 +143,13 @@ class ScenePlug : public Gaffer::ValuePlug
 		/// Returns the local transform at the specified scene path.
 		Imath::M44f transform( const ScenePath &scenePath ) const;
 		/// Returns the absolute (world) transform at the specified scene path.
+		/// Results for ancestor locations are cached and shared between calls,
+		/// so querying many locations with common ancestors is efficient.
 		Imath::M44f fullTransform( const ScenePath &scenePath ) const;
 		/// Returns just the attributes set at the specific scene path.
 		IECore::ConstCompoundObjectPtr attributes( const ScenePath &scenePath ) const;
 		/// Returns the full set of inherited attributes at the specified scene path.
+		/// Ancestor results are cached in the same way as for fullTransform().
 		IECore::CompoundObjectPtr fullAttributes( const ScenePath &scenePath ) const;
 		IECore::ConstObjectPtr object( const ScenePath &scenePath ) const;
 		IECore::ConstInternedStringVectorDataPtr childNames( const ScenePath &scenePath ) const;
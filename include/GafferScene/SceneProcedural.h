@@ -118,6 +118,8 @@ class SceneProcedural : public IECore::Renderer::Procedural
 
 	private :
 
+		void construct( bool computeBound );
+		void renderInternal( IECore::Renderer *renderer ) const;
 		void updateAttributes();
 		void initBound( bool compute );
 		void motionTimes( unsigned segments, std::set<float> &times ) const;
@@ -91,6 +91,8 @@ class SceneProcessor : public SceneNode
 		virtual void hash( const Gaffer::ValuePlug *output, const Gaffer::Context *context, IECore::MurmurHash &h ) const;
 		/// Reimplemented from SceneNode to pass through the inPlug() computations when the node is disabled.
 		virtual void compute( Gaffer::ValuePlug *output, const Gaffer::Context *context ) const;
+		/// Reimplemented from SceneNode to declare the inPlug() as a pass-through when the node is disabled.
+		virtual const Gaffer::ValuePlug *passThrough( const Gaffer::ValuePlug *output, const Gaffer::Context *context ) const;
 
 	private :
 
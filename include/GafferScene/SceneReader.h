@@ -75,11 +75,16 @@ class SceneReader : public SceneNode
 		const Gaffer::StringPlug *tagsPlug() const;
 
 		virtual void affects( const Gaffer::Plug *input, AffectedPlugsContainer &outputs ) const;
+		virtual void hash( const Gaffer::ValuePlug *output, const Gaffer::Context *context, IECore::MurmurHash &h ) const;
+		virtual void compute( Gaffer::ValuePlug *output, const Gaffer::Context *context ) const;
 
 		static size_t supportedExtensions( std::vector<std::string> &extensions );
 
 	protected :
 
+		/// Reimplemented to isolate the loading of sets, which uses TBB tasks internally.
+		virtual Gaffer::ValuePlug::CachePolicy computeCachePolicy( const Gaffer::ValuePlug *output ) const;
+
 		/// \todo These methods defer to SceneInterface::hash() to do most of the work, but we could go further.
 		/// Currently we still hash in fileNamePlug() and refreshCountPlug() because we don't trust the current
 		/// implementation of SceneCache::hash() - it should hash the filename and modification time, but instead
@@ -107,17 +112,24 @@ class SceneReader : public SceneNode
 
 		void plugSet( Gaffer::Plug *plug );
 
+		// All the sets in the file, loaded in a single traversal and stored
+		// in a CompoundObject of PathMatcherData, from which computeSet()
+		// serves the individual sets.
+		Gaffer::ObjectPlug *setsPlug();
+		const Gaffer::ObjectPlug *setsPlug() const;
+		IECore::ConstCompoundObjectPtr computeSets( const Gaffer::Context *context ) const;
+
 		// The typical access patterns for the SceneReader include accessing
 		// the same file repeatedly, and also the same path within the file
 		// repeatedly (to hash a value then compute it for instance, or to get
 		// the bound and then the object). We take advantage of that by storing
 		// the last accessed scene in thread local storage - we can then avoid
 		// the relatively expensive lookups necessary to find the appropriate
-		// SceneInterfacePtr for a query.
+		// SceneInterfacePtr for a query. Other lookups are made via per-thread
+		// file handles and location caches shared by all SceneReaders.
 		struct LastScene
 		{
 			std::string fileName;
-			IECore::ConstSceneInterfacePtr fileNameScene;
 			ScenePlug::ScenePath path;
 			IECore::ConstSceneInterfacePtr pathScene;
 		};
@@ -74,6 +74,9 @@ class SceneWriter : public GafferDispatch::TaskNode
 
 		/// Re-implemented to open the file for writing, then iterate through the
 		/// frames, modifying the current Context and calling writeLocation().
+		/// The children of each location are evaluated in parallel, and then
+		/// written serially, since SceneInterfaces may not be written to
+		/// concurrently.
 		virtual void executeSequence( const std::vector<float> &frames ) const;
 
 		/// Re-implemented to return true, since the entire file must be written at once.
@@ -82,7 +85,8 @@ class SceneWriter : public GafferDispatch::TaskNode
 	private :
 
 		void createDirectories( const std::string &fileName ) const;
-		void writeLocation( const GafferScene::ScenePlug *scene, const ScenePlug::ScenePath &scenePath, Gaffer::Context *context, IECore::SceneInterface *output, double time ) const;
+		struct LocationData;
+		void writeLocation( const GafferScene::ScenePlug *scene, const ScenePlug::ScenePath &scenePath, const LocationData &data, const Gaffer::Context *context, IECore::SceneInterface *output, double time ) const;
 
 		static size_t g_firstPlugIndex;
 
@@ -134,6 +134,8 @@ enum TypeId
 	CopyOptionsTypeId = 110589,
 	LightToCameraTypeId = 110590,
 	FilterResultsTypeId = 110591,
+	CapsuleTypeId = 110592,
+	EncapsulateTypeId = 110593,
 
 	PreviewInteractiveRenderTypeId = 110649,
 
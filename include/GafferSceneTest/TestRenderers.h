@@ -0,0 +1,66 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2017, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//      * Redistributions of source code must retain the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer.
+//
+//      * Redistributions in binary form must reproduce the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer in the documentation and/or other materials provided with
+//        the distribution.
+//
+//      * Neither the name of John Haddon nor the names of
+//        any other contributors to this software may be used to endorse or
+//        promote products derived from this software without specific prior
+//        written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#ifndef GAFFERSCENETEST_TESTRENDERERS_H
+#define GAFFERSCENETEST_TESTRENDERERS_H
+
+#include "IECore/CompoundData.h"
+
+#include "GafferScene/ScenePlug.h"
+
+namespace GafferSceneTest
+{
+
+/// Outputs the options, outputs, cameras, lights and objects from the scene
+/// using Preview::RendererAlgo, just as the Render node does, and then calls
+/// `render()`. This is useful for measuring the Gaffer side cost of render
+/// startup when used with the renderers registered by this library :
+///
+/// - "Null" discards everything it is given.
+/// - "Capturing" records every location it is given, and the records are
+///   returned as a CompoundData mapping from location name to a CompoundData
+///   containing "type", "attributesHash", "samples" and "transform" members.
+///
+/// Returns NULL for all other renderer types.
+IECore::CompoundDataPtr outputScene( const GafferScene::ScenePlug *scene, const std::string &rendererType );
+
+/// As above, but works with any registered renderer, returning the
+/// statistics it reports once rendering is complete.
+IECore::CompoundDataPtr outputSceneStatistics( const GafferScene::ScenePlug *scene, const std::string &rendererType );
+
+} // namespace GafferSceneTest
+
+#endif // GAFFERSCENETEST_TESTRENDERERS_H
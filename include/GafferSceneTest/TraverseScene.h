@@ -51,6 +51,15 @@ void traverseScene( const GafferScene::ScenePlug *scenePlug );
 /// \todo Remove.
 void traverseScene( GafferScene::ScenePlug *scenePlug );
 
+/// As for traverseScene(), but evaluating only the hashes of the transform,
+/// bound, attributes and object at each location. This is useful for measuring
+/// the cost of hashing independently of the cost of computing.
+void traverseSceneHashes( const GafferScene::ScenePlug *scenePlug );
+
+/// Traverses the scene, evaluating `fullTransform()` and `fullAttributes()`
+/// for every location, just as renderer output does.
+void traverseSceneFullTransformsAndAttributes( const GafferScene::ScenePlug *scenePlug );
+
 /// Arranges for traverseScene() to be called every time the scene is dirtied. This is useful
 /// for exposing bugs caused by things like InteractiveRender and SceneView, where threaded
 /// traversals will be triggered automatically by plugDirtiedSignal().
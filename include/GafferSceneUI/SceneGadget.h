@@ -37,6 +37,8 @@
 #ifndef GAFFERSCENEUI_SCENEGADGET_H
 #define GAFFERSCENEUI_SCENEGADGET_H
 
+#include "tbb/tick_count.h"
+
 #include "IECoreGL/State.h"
 
 #include "Gaffer/Context.h"
@@ -84,6 +86,42 @@ class SceneGadget : public GafferUI::Gadget
 		void setMinimumExpansionDepth( size_t depth );
 		size_t getMinimumExpansionDepth() const;
 
+		/// Locations outside the view are never drawn, and those whose
+		/// bounds cover fewer than this number of pixels on screen are
+		/// drawn as bounding boxes rather than in full. A threshold of 0
+		/// disables the bounding box proxies, and is the default.
+		void setProxyThreshold( float pixels );
+		float getProxyThreshold() const;
+
+		/// Limits the time in seconds spent each frame drawing objects
+		/// for the first time, which is when their data is uploaded to
+		/// the GPU. Objects which don't fit in the budget are drawn as
+		/// bounding boxes, and drawn in full in subsequent frames. A
+		/// budget of 0 disables the limit, and is the default.
+		void setUploadBudget( float seconds );
+		float getUploadBudget() const;
+
+		/// Limits the time in seconds spent updating the scene each time
+		/// the gadget is drawn, so that large scenes can be displayed without
+		/// freezing the UI. Locations which aren't updated in time are drawn
+		/// in their previous state, or as a bounding box if they are new,
+		/// and the update is continued in subsequent redraws. Queries made
+		/// via bound() and selectionBound() always complete the update first,
+		/// but the other queries only see the locations updated so far. A
+		/// budget of 0 disables the limit, and is the default.
+		void setUpdateBudget( float seconds );
+		float getUpdateBudget() const;
+		/// Returns true if there are parts of the scene which
+		/// have not yet been updated.
+		bool updatePending() const;
+
+		/// Specifies the level of detail at which the scene is evaluated, via
+		/// the context variable named by ScenePlug::levelOfDetailContextName.
+		/// Higher values allow sources to generate less detailed geometry.
+		/// The default of 0 requests full detail, as for a final render.
+		void setLevelOfDetail( int levelOfDetail );
+		int getLevelOfDetail() const;
+
 		/// Returns the IECoreGL::State object used as the base display
 		/// style for the Renderable. This may be modified freely to
 		/// change the display style.
@@ -120,8 +158,9 @@ class SceneGadget : public GafferUI::Gadget
 
 		void plugDirtied( const Gaffer::Plug *plug );
 		void contextChanged( const IECore::InternedString &name );
-		void updateSceneGraph() const;
-		void renderSceneGraph( const IECoreGL::State *stateToBind ) const;
+		void updateSceneGraph( bool complete = false ) const;
+		bool updateTimeExceeded() const;
+		void renderSceneGraph( const IECoreGL::State *stateToBind, bool testContainment = false ) const;
 
 		boost::signals::scoped_connection m_plugDirtiedConnection;
 		boost::signals::scoped_connection m_contextChangedConnection;
@@ -131,6 +170,13 @@ class SceneGadget : public GafferUI::Gadget
 		mutable unsigned m_dirtyFlags;
 		GafferScene::ConstPathMatcherDataPtr m_expandedPaths;
 		size_t m_minimumExpansionDepth;
+		float m_proxyThreshold;
+		float m_uploadBudget;
+		float m_updateBudget;
+		int m_levelOfDetail;
+		mutable float m_updateTimeLimit;
+		mutable tbb::tick_count m_updateStartTime;
+		mutable unsigned m_selectionPass;
 
 		class SceneGraph;
 		class UpdateTask;
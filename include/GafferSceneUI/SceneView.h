@@ -77,6 +77,13 @@ class SceneView : public GafferUI::View
 		Gaffer::IntPlug *minimumExpansionDepthPlug();
 		const Gaffer::IntPlug *minimumExpansionDepthPlug() const;
 
+		/// Controls the prefetching of upcoming frames in a
+		/// background thread, so that playback and scrubbing
+		/// can be served from the cache. Has "enabled" and
+		/// "frames" children.
+		Gaffer::ValuePlug *prefetchPlug();
+		const Gaffer::ValuePlug *prefetchPlug() const;
+
 		Gaffer::ValuePlug *lookThroughPlug();
 		const Gaffer::ValuePlug *lookThroughPlug() const;
 
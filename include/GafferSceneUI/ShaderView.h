@@ -88,6 +88,7 @@ class ShaderView : public GafferImageUI::ImageView
 
 		typedef std::pair<std::string, std::string> PrefixAndName;
 		typedef std::map<PrefixAndName, Gaffer::NodePtr> Scenes;
+		typedef std::map<std::string, Gaffer::NodePtr> Renderers;
 
 		void viewportVisibilityChanged();
 
@@ -107,6 +108,11 @@ class ShaderView : public GafferImageUI::ImageView
 
 		boost::signals::scoped_connection m_idleConnection;
 
+		// Renderers are kept alive for the lifetime of the view, and
+		// paused rather than destroyed when not in use, so that switching
+		// between shader types or hiding the viewport doesn't pay the cost
+		// of starting a new render each time.
+		Renderers m_renderers;
 		Gaffer::NodePtr m_renderer;
 		std::string m_rendererShaderPrefix;
 
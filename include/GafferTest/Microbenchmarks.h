@@ -0,0 +1,75 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2017, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//      * Redistributions of source code must retain the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer.
+//
+//      * Redistributions in binary form must reproduce the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer in the documentation and/or other materials provided with
+//        the distribution.
+//
+//      * Neither the name of John Haddon nor the names of
+//        any other contributors to this software may be used to endorse or
+//        promote products derived from this software without specific prior
+//        written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#ifndef GAFFERTEST_MICROBENCHMARKS_H
+#define GAFFERTEST_MICROBENCHMARKS_H
+
+namespace GafferTest
+{
+
+/// Microbenchmarks for the fixed overheads of the evaluation machinery.
+/// Each performs the operation `iterations` times, and returns the mean
+/// time taken per operation in nanoseconds. They are exposed to Python
+/// and run by GafferTest.MicrobenchmarksTest, so that changes to the core
+/// can be compared against a baseline.
+
+/// Construction and destruction of a Process.
+double benchmarkProcessConstruction( int iterations = 1000000 );
+/// `ValuePlug::hash()` for a computed plug, when the hash is already
+/// in the hash cache.
+double benchmarkHashCacheHits( int iterations = 1000000 );
+/// `ValuePlug::hash()` for a computed plug, in a context which hasn't been
+/// seen before, so that the hash must be computed.
+double benchmarkHashCacheMisses( int iterations = 100000 );
+/// `getValue()` for a computed plug, when the value is already in the
+/// compute cache.
+double benchmarkComputeCacheHits( int iterations = 1000000 );
+/// Creation of a Context borrowing from a parent, and setting of one variable.
+double benchmarkContextCreation( int iterations = 1000000 );
+/// `Context::set()` for an existing variable.
+double benchmarkContextSet( int iterations = 1000000 );
+/// `Context::hash()` following a `set()`, so the hash is not cached.
+double benchmarkContextHash( int iterations = 1000000 );
+/// `StringPlug::getValue()` for a value containing substitutions.
+double benchmarkStringPlugSubstitutions( int iterations = 100000 );
+/// Dirty propagation through a chain of 100 nodes, reported per node.
+double benchmarkDirtyPropagation( int iterations = 1000 );
+/// `GraphComponent::getChild()` by name, for a parent with 100 children.
+double benchmarkChildLookup( int iterations = 1000000 );
+
+} // namespace GafferTest
+
+#endif // GAFFERTEST_MICROBENCHMARKS_H
@@ -88,6 +88,10 @@ class GraphGadget : public ContainerGadget
 
 		/// Returns the NodeGadget representing the specified node or NULL
 		/// if none exists.
+		/// \note For large graphs, the creation of NodeGadgets for positioned
+		/// nodes is deferred until they are first visible. This method creates
+		/// the NodeGadget on demand if necessary, as do the other accessors
+		/// below, so the deferral is invisible to callers.
 		NodeGadget *nodeGadget( const Gaffer::Node *node );
 		const NodeGadget *nodeGadget( const Gaffer::Node *node ) const;
 
@@ -171,6 +175,10 @@ class GraphGadget : public ContainerGadget
 		/// Returns the connectionGadget under the specified line.
 		ConnectionGadget *connectionGadgetAt( const IECore::LineSegment3f &lineInGadgetSpace ) const;
 
+		/// Reimplemented to include the positions of nodes whose
+		/// NodeGadgets have not been created yet.
+		virtual Imath::Box3f bound() const;
+
 	protected :
 
 		void doRender( const Style *style ) const;
@@ -212,6 +220,17 @@ class GraphGadget : public ContainerGadget
 		NodeGadget *findNodeGadget( const Gaffer::Node *node ) const;
 		void updateNodeGadgetTransform( NodeGadget *nodeGadget );
 
+		// When the root contains many nodes, creating NodeGadgets for all of
+		// them up front makes entering the graph slow, even though most will
+		// be offscreen. Instead we just record the positions of such nodes,
+		// and create their gadgets as they come into view in doRender(), or
+		// when they are requested via the public accessors. Connections to
+		// a deferred node are made as soon as both ends have gadgets.
+		void deferNodeGadget( Gaffer::Node *node );
+		bool isDeferred( const Gaffer::Node *node ) const;
+		NodeGadget *materialiseNodeGadget( const Gaffer::Node *node );
+		void materialiseNodeGadgets( const Imath::Box2f &region );
+
 		Nodule *findNodule( const Gaffer::Plug *plug ) const;
 
 		void addConnectionGadgets( NodeGadget *nodeGadget );
@@ -228,6 +247,27 @@ class GraphGadget : public ContainerGadget
 
 		void connectedNodeGadgetsWalk( NodeGadget *gadget, std::set<NodeGadget *> &connectedGadgets, Gaffer::Plug::Direction direction, size_t degreesOfSeparation );
 
+		// Spatial index of our children, used to render only those within
+		// the visible region. Children can't notify us directly when their
+		// bounds change, but they always request a render when they do, so
+		// we simply mark the index as dirty whenever a render is requested,
+		// and rebuild it lazily. Crucially, panning and zooming the viewport
+		// don't request renders from us, so don't require a rebuild.
+		void renderRequested( Gadget *gadget );
+		void updateChildIndex() const;
+		// Fills `children` with the indices of all children which may be
+		// visible in `region`, sorted in the order of `children()`.
+		void visibleChildren( const Imath::Box2f &region, std::vector<size_t> &children ) const;
+
+		typedef std::pair<int, int> ChildIndexCell;
+		typedef std::map<ChildIndexCell, std::vector<size_t> > ChildIndexCells;
+		mutable bool m_childIndexDirty;
+		mutable ChildIndexCells m_childIndexCells;
+		// Children too large to be placed efficiently in cells, or
+		// without bounds, which are therefore considered always visible.
+		mutable std::vector<size_t> m_childIndexUnbounded;
+		mutable std::vector<Imath::Box2f> m_childBounds;
+
 		Gaffer::NodePtr m_root;
 		Gaffer::ScriptNodePtr m_scriptNode;
 		RootChangedSignal m_rootChangedSignal;
@@ -251,6 +291,15 @@ class GraphGadget : public ContainerGadget
 		typedef std::map<const Gaffer::Node *, NodeGadgetEntry> NodeGadgetMap;
 		NodeGadgetMap m_nodeGadgets;
 
+		struct DeferredNodeEntry
+		{
+			Gaffer::Node *node;
+			Imath::V2f position;
+			boost::signals::scoped_connection plugSetConnection;
+		};
+		typedef std::map<const Gaffer::Node *, DeferredNodeEntry> DeferredNodeMap;
+		DeferredNodeMap m_deferredNodes;
+
 		typedef std::map<const Nodule *, ConnectionGadget *> ConnectionGadgetMap;
 		ConnectionGadgetMap m_connectionGadgets;
 
@@ -104,12 +104,19 @@ class NoduleLayout : public Gadget
 
 		void updateNodules( std::vector<Nodule *> &nodules, std::vector<Nodule *> &added, std::vector<NodulePtr> &removed );
 		void updateNoduleLayout();
+		// Adds a nodule for a plug appended to the end of the parent
+		// without rebuilding the whole layout, returning false if the
+		// plug can't be placed that way and a full update is needed.
+		// This keeps ArrayPlug growth linear rather than quadratic.
+		bool appendNodule( Gaffer::Plug *plug );
 		void updateSpacing();
 		void updateDirection();
 		void updateOrientation();
 
 		Gaffer::GraphComponentPtr m_parent;
 		const IECore::InternedString m_section;
+		// Largest sort index amongst the current nodules.
+		int m_maxIndex;
 
 };
 
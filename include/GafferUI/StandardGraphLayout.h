@@ -81,6 +81,12 @@ class StandardGraphLayout : public GraphLayout
 		/// adjacent nodes.
 		void setNodeSeparationScale( float scale );
 		float getNodeSeparationScale() const;
+		/// When on, layoutNodes() first arranges the nodes into
+		/// layers according to their vertical connections, before
+		/// refining the result with the usual solver. This is much
+		/// faster for large numbers of nodes.
+		void setLayeredLayout( bool layered );
+		bool getLayeredLayout() const;
 		//@}
 
 	private :
@@ -94,6 +100,7 @@ class StandardGraphLayout : public GraphLayout
 
 		float m_connectionScale;
 		float m_nodeSeparationScale;
+		bool m_layeredLayout;
 
 };
 
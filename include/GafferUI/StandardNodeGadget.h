@@ -100,12 +100,14 @@ class StandardNodeGadget : public NodeGadget
 
 		virtual Imath::Box3f bound() const;
 
+		/// Returns the colour specified by the "nodeGadget:color"
+		/// metadata, or NULL if none has been specified.
+		const Imath::Color3f *userColor() const;
+
 	protected :
 
 		virtual void doRender( const Style *style ) const;
 
-		const Imath::Color3f *userColor() const;
-
 	private :
 
 		LinearContainer *noduleContainer( Edge edge );
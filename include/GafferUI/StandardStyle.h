@@ -41,6 +41,7 @@
 #include "boost/array.hpp"
 
 #include "OpenEXR/ImathColor.h"
+#include "OpenEXR/ImathMatrix.h"
 
 #include "GafferUI/Style.h"
 
@@ -76,6 +77,8 @@ class StandardStyle : public Style
 		virtual Imath::Box3f textBound( TextType type, const std::string &text ) const;
 		virtual void renderText( TextType type, const std::string &text, State state = NormalState ) const;
 		virtual void renderWrappedText( TextType textType, const std::string &text, const Imath::Box2f &bound, State state = NormalState ) const;
+		virtual void beginTextBatch() const;
+		virtual void endTextBatch() const;
 
 		virtual void renderFrame( const Imath::Box2f &frame, float borderWidth, State state = NormalState ) const;
 		virtual void renderSelectionBox( const Imath::Box2f &box ) const;
@@ -129,11 +132,24 @@ class StandardStyle : public Style
 		static int g_v3Parameter;
 
 		Imath::Color3f colorForState( Color c, State s, const Imath::Color3f *userColor = NULL ) const;
+
+		void bindText( TextType textType ) const;
+		void renderTextSprites( TextType textType, const std::string &text ) const;
 		boost::array<Imath::Color3f, LastColor> m_colors;
 
 		IECoreGL::FontPtr m_fonts[LastText];
 		float m_fontScales[LastText];
 
+		struct BatchedText
+		{
+			std::string text;
+			Imath::M44f projection;
+			Imath::M44f transform;
+		};
+
+		mutable int m_textBatchDepth;
+		mutable std::vector<BatchedText> m_textBatches[LastText];
+
 };
 
 IE_CORE_DECLAREPTR( Style );
@@ -108,6 +108,32 @@ class Style : public IECore::RunTimeTyped
 		virtual Imath::Box3f textBound( TextType textType, const std::string &text ) const = 0;
 		virtual void renderText( TextType textType, const std::string &text, State state = NormalState ) const = 0;
 		virtual void renderWrappedText( TextType textType, const std::string &text, const Imath::Box2f &bound, State state = NormalState ) const = 0;
+		/// Calls to renderText() made between beginTextBatch() and
+		/// endTextBatch() may be deferred until endTextBatch(), so that
+		/// many pieces of text can be drawn with a single setup of the
+		/// necessary state. Such text is therefore drawn on top of
+		/// everything else rendered within the batch. Batches may be
+		/// nested, with drawing deferred until the outermost batch is
+		/// ended. The default implementations do nothing.
+		virtual void beginTextBatch() const;
+		virtual void endTextBatch() const;
+
+		/// The TextBatchScope class can be used to begin a text
+		/// batch and ensure that it is ended when the scope exits,
+		/// even if an exception is thrown.
+		class TextBatchScope
+		{
+
+			public :
+
+				TextBatchScope( const Style *style );
+				~TextBatchScope();
+
+			private :
+
+				const Style *m_style;
+
+		};
 		//@}
 
 		/// @name Generic UI elements
@@ -0,0 +1,91 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2017, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//      * Redistributions of source code must retain the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer.
+//
+//      * Redistributions in binary form must reproduce the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer in the documentation and/or other materials provided with
+//        the distribution.
+//
+//      * Neither the name of John Haddon nor the names of
+//        any other contributors to this software may be used to endorse or
+//        promote products derived from this software without specific prior
+//        written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#ifndef GAFFERVTUNE_VTUNEMONITOR_H
+#define GAFFERVTUNE_VTUNEMONITOR_H
+
+#include <vector>
+
+#include "IECore/InternedString.h"
+
+#include "Gaffer/Monitor.h"
+
+namespace GafferVTune
+{
+
+/// A monitor which emits ITT task events for each process, so that
+/// Intel VTune Amplifier and other profilers supporting the ITT API
+/// can attribute time to the nodes being computed, rather than to
+/// anonymous TBB worker frames. Tasks are named by process type and
+/// node type, and are annotated with the full name of the plug and
+/// the values of the specified context variables.
+///
+/// When no profiler is collecting, events are skipped after a single
+/// flag check, so the monitor may be left active in production runs.
+class VTuneMonitor : public Gaffer::Monitor
+{
+
+	public :
+
+		/// If `computeOnly` is true, no events are emitted for hash
+		/// processes, which are far more numerous and individually
+		/// much cheaper than computes.
+		VTuneMonitor( bool computeOnly = false, const std::vector<IECore::InternedString> &variableNames = defaultVariableNames() );
+		virtual ~VTuneMonitor();
+
+		bool getComputeOnly() const;
+		const std::vector<IECore::InternedString> &variableNames() const;
+
+		/// "frame", "scene:path", "image:channelName" and "image:tileOrigin".
+		static const std::vector<IECore::InternedString> &defaultVariableNames();
+
+	protected :
+
+		virtual void processStarted( const Gaffer::Process *process );
+		virtual void processFinished( const Gaffer::Process *process );
+
+	private :
+
+		bool monitored( const Gaffer::Process *process ) const;
+
+		const bool m_computeOnly;
+		const std::vector<IECore::InternedString> m_variableNames;
+
+};
+
+} // namespace GafferVTune
+
+#endif // GAFFERVTUNE_VTUNEMONITOR_H
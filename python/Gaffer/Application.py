@@ -37,8 +37,10 @@
 
 import os
 import sys
+import time
 import inspect
 import cProfile
+import __builtin__
 
 import IECore
 
@@ -79,6 +81,15 @@ class Application( IECore.Parameterised ) :
 					allowEmptyString = True
 				),
 
+				IECore.BoolParameter(
+					name = "profileStartup",
+					description = "Prints the time taken to execute each startup "
+						"file, and to import each module imported during startup. "
+						"This is useful for tracking down the causes of slow "
+						"application launches.",
+					defaultValue = False,
+				),
+
 			]
 
 		)
@@ -138,7 +149,13 @@ class Application( IECore.Parameterised ) :
 			_Gaffer._tbb_task_scheduler_init.automatic if args["threads"].value == 0 else args["threads"].value
 		) :
 
-			self._executeStartupFiles( self.root().getName() )
+			if args["profileStartup"].value :
+				with _StartupProfiler() as profiler :
+					self._executeStartupFiles( self.root().getName() )
+				profiler.report( sys.stderr )
+			else :
+				self._executeStartupFiles( self.root().getName() )
+
 			return self._run( args )
 
 	def __formatHelp( self ) :
@@ -156,6 +173,70 @@ class Application( IECore.Parameterised ) :
 
 IECore.registerRunTimeTyped( Application, typeName = "Gaffer::Application" )
 
+# Records the time spent executing startup files and importing
+# modules, by temporarily wrapping the builtin `execfile()` and
+# `__import__()` functions. Import times are inclusive of any
+# nested imports, and are only recorded for the first import of
+# each module, since subsequent imports are just dictionary lookups.
+class _StartupProfiler( object ) :
+
+	def __init__( self ) :
+
+		self.startupFileTimes = {}
+		self.importTimes = {}
+		self.totalTime = 0
+
+	def __enter__( self ) :
+
+		self.__originalExecFile = __builtin__.execfile
+		self.__originalImport = __builtin__.__import__
+
+		__builtin__.execfile = self.__execFile
+		__builtin__.__import__ = self.__import
+
+		self.__startTime = time.time()
+
+		return self
+
+	def __exit__( self, type, value, traceBack ) :
+
+		self.totalTime = time.time() - self.__startTime
+
+		__builtin__.execfile = self.__originalExecFile
+		__builtin__.__import__ = self.__originalImport
+
+	def report( self, file ) :
+
+		file.write( "Startup files and imports took %.3fs :\n\n" % self.totalTime )
+		for title, times in (
+			( "Startup files", self.startupFileTimes ),
+			( "Imports", self.importTimes ),
+		) :
+			file.write( "%s :\n\n" % title )
+			for name, t in sorted( times.items(), key = lambda x : x[1], reverse = True ) :
+				file.write( "\t%.3fs : %s\n" % ( t, name ) )
+			file.write( "\n" )
+
+	def __execFile( self, fileName, *args ) :
+
+		t = time.time()
+		try :
+			return self.__originalExecFile( fileName, *args )
+		finally :
+			self.startupFileTimes[fileName] = self.startupFileTimes.get( fileName, 0 ) + time.time() - t
+
+	def __import( self, name, *args, **kw ) :
+
+		if name in sys.modules :
+			return self.__originalImport( name, *args, **kw )
+
+		t = time.time()
+		try :
+			return self.__originalImport( name, *args, **kw )
+		finally :
+			if name in sys.modules :
+				self.importTimes[name] = time.time() - t
+
 # Various parts of the UI try to store their state as attributes on
 # the root object, and therefore require it's identity in python to
 # be stable, even when acquiring it from separate calls to C++ methods
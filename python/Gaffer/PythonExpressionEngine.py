@@ -53,7 +53,9 @@ class PythonExpressionEngine( Gaffer.Expression.Engine ) :
 
 		parser = _Parser( expression )
 
-		self.__expression = expression
+		# Compile once up front, rather than having
+		# `exec` recompile for every execution.
+		self.__code = compile( expression, "<string>", "exec" )
 		self.__inPlugPaths = list( parser.plugReads )
 		self.__outPlugPaths = list( parser.plugWrites )
 
@@ -78,7 +80,7 @@ class PythonExpressionEngine( Gaffer.Expression.Engine ) :
 
 		executionDict = { "IECore" : IECore, "parent" : plugDict, "context" : context }
 
-		exec( self.__expression, executionDict, executionDict )
+		exec( self.__code, executionDict, executionDict )
 
 		result = IECore.ObjectVector()
 		for plugPath in self.__outPlugPaths :
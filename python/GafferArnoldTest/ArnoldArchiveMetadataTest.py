@@ -0,0 +1,74 @@
+##########################################################################
+#
+#  Copyright (c) 2017, Image Engine Design Inc. All rights reserved.
+#
+#  Redistribution and use in source and binary forms, with or without
+#  modification, are permitted provided that the following conditions are
+#  met:
+#
+#      * Redistributions of source code must retain the above
+#        copyright notice, this list of conditions and the following
+#        disclaimer.
+#
+#      * Redistributions in binary form must reproduce the above
+#        copyright notice, this list of conditions and the following
+#        disclaimer in the documentation and/or other materials provided with
+#        the distribution.
+#
+#      * Neither the name of John Haddon nor the names of
+#        any other contributors to this software may be used to endorse or
+#        promote products derived from this software without specific prior
+#        written permission.
+#
+#  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+#  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+#  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+#  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+#  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+#  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+#  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+#  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+#  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+#  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+#  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#
+##########################################################################
+
+import unittest
+
+import IECore
+
+import GafferScene
+import GafferSceneTest
+import GafferArnold
+
+class ArnoldArchiveMetadataTest( GafferSceneTest.SceneTestCase ) :
+
+	def test( self ) :
+
+		fileName = self.temporaryDirectory() + "/test.ass"
+		with open( fileName, "w" ) as f :
+			f.write(
+				"### exported: Thu Jan  1 00:00:00 2017\n"
+				"### bounds: -1 -2 -3 1 2 3\n"
+				"\n"
+				"options\n{\n AA_samples 3\n}\n\n"
+				"polymesh\n{\n name mesh { with braces }\n vlist 3 1 POINT\n 0 0 0 1 0 0 0 1 0\n}\n\n"
+				"sphere\n{\n name \"a { quoted } brace\"\n}\n"
+			)
+
+		m = GafferScene.ArchiveAlgo.metadata( fileName )
+		self.assertEqual( m["bound"].value, IECore.Box3f( IECore.V3f( -1, -2, -3 ), IECore.V3f( 1, 2, 3 ) ) )
+		self.assertEqual( m["nodeCount"].value, 3 )
+
+	def testNoBounds( self ) :
+
+		fileName = self.temporaryDirectory() + "/testNoBounds.ass"
+		with open( fileName, "w" ) as f :
+			f.write( "sphere\n{\n name s\n}\n" )
+
+		self.assertEqual( GafferScene.ArchiveAlgo.bound( fileName ), IECore.Box3f() )
+		self.assertEqual( GafferScene.ArchiveAlgo.metadata( fileName )["nodeCount"].value, 1 )
+
+if __name__ == "__main__":
+	unittest.main()
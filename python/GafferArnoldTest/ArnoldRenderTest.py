@@ -166,6 +166,21 @@ class ArnoldRenderTest( GafferTest.TestCase ) :
 		for i in range( 1, 4 ) :
 			self.failUnless( os.path.exists( self.temporaryDirectory() + "/test.%04d.tif" % i ) )
 
+	def testExecuteSequence( self ) :
+
+		s = Gaffer.ScriptNode()
+
+		s["plane"] = GafferScene.Plane()
+		s["render"] = GafferArnold.ArnoldRender()
+		s["render"]["mode"].setValue( s["render"].Mode.SceneDescriptionMode )
+		s["render"]["in"].setInput( s["plane"]["out"] )
+		s["render"]["fileName"].setValue( self.temporaryDirectory() + "/test.####.ass" )
+
+		s["render"]["task"].executeSequence( [ 1, 2, 3 ] )
+
+		for i in range( 1, 4 ) :
+			self.failUnless( os.path.exists( self.temporaryDirectory() + "/test.%04d.ass" % i ) )
+
 	def testTypeNamePrefixes( self ) :
 
 		self.assertTypeNamesArePrefixed( GafferArnold )
@@ -643,6 +658,59 @@ class ArnoldRenderTest( GafferTest.TestCase ) :
 
 		render["task"].execute()
 
+	def testMultipleCameras( self ) :
+
+		s = Gaffer.ScriptNode()
+
+		s["cameraA"] = GafferScene.Camera()
+		s["cameraA"]["name"].setValue( "cameraA" )
+
+		s["cameraB"] = GafferScene.Camera()
+		s["cameraB"]["name"].setValue( "cameraB" )
+
+		s["plane"] = GafferScene.Plane()
+
+		s["group"] = GafferScene.Group()
+		s["group"]["in"][0].setInput( s["plane"]["out"] )
+		s["group"]["in"][1].setInput( s["cameraA"]["out"] )
+		s["group"]["in"][2].setInput( s["cameraB"]["out"] )
+
+		s["outputs"] = GafferScene.Outputs()
+		s["outputs"].addOutput(
+			"beauty",
+			IECore.Display(
+				self.temporaryDirectory() + "/renders${render:camera}.tif",
+				"tiff",
+				"rgba",
+				{}
+			)
+		)
+		s["outputs"]["in"].setInput( s["group"]["out"] )
+
+		s["render"] = GafferArnold.ArnoldRender()
+		s["render"]["in"].setInput( s["outputs"]["out"] )
+		s["render"]["cameras"].setValue( IECore.StringVectorData( [ "/group/cameraA", "/group/cameraB" ] ) )
+
+		s["render"]["task"].execute()
+
+		self.assertTrue( os.path.exists( self.temporaryDirectory() + "/renders/group/cameraA.tif" ) )
+		self.assertTrue( os.path.exists( self.temporaryDirectory() + "/renders/group/cameraB.tif" ) )
+
+		# Scene descriptions can only describe a single render, so
+		# we expect one file per camera.
+
+		s["render"]["mode"].setValue( s["render"].Mode.SceneDescriptionMode )
+		s["render"]["fileName"].setValue( self.temporaryDirectory() + "/ass${render:camera}.ass" )
+		s["render"]["task"].execute()
+
+		self.assertTrue( os.path.exists( self.temporaryDirectory() + "/ass/group/cameraA.ass" ) )
+		self.assertTrue( os.path.exists( self.temporaryDirectory() + "/ass/group/cameraB.ass" ) )
+
+		# Cameras must exist.
+
+		s["render"]["cameras"].setValue( IECore.StringVectorData( [ "/group/cameraC" ] ) )
+		self.assertRaisesRegexp( RuntimeError, "/group/cameraC", s["render"]["task"].execute )
+
 	def testTwoRenders( self ) :
 
 		sphere = GafferScene.Sphere()
@@ -35,6 +35,7 @@
 ##########################################################################
 
 import os
+import shutil
 
 import IECore
 
@@ -92,5 +93,18 @@ class ArnoldVDBTest( GafferSceneTest.SceneTestCase ) :
 		v["stepSize"].setValue( 0.01 )
 		self.assertAlmostEqual( v["out"].object( "/volume" ).parameters()["step_size"].value, 0.04 )
 
+	def testMissingFileNotRemembered( self ) :
+
+		fileName = os.path.join( self.temporaryDirectory(), "sphere.vdb" )
+
+		v = GafferArnold.ArnoldVDB()
+		v["fileName"].setValue( fileName )
+		self.assertRaisesRegexp( RuntimeError, "No such file or directory", v["out"].bound, "/volume" )
+
+		# Once the file exists, we should pick it up, rather
+		# than remembering the previous failure.
+		shutil.copy( os.path.join( os.path.dirname( __file__ ), "volumes", "sphere.vdb" ), fileName )
+		self.assertEqual( v["out"].bound( "/volume" ), IECore.Box3f( IECore.V3f( -1.1, 1.1, -1.1 ), IECore.V3f( 1.1, 2.9, 1.1 ) ) )
+
 if __name__ == "__main__":
 	unittest.main()
@@ -44,6 +44,7 @@ from ArnoldMeshLightTest import ArnoldMeshLightTest
 from InteractiveArnoldRenderTest import InteractiveArnoldRenderTest
 from ArnoldDisplacementTest import ArnoldDisplacementTest
 from LightToCameraTest import LightToCameraTest
+from ArnoldArchiveMetadataTest import ArnoldArchiveMetadataTest
 from IECoreArnoldPreviewTest import *
 
 if __name__ == "__main__":
@@ -77,6 +77,32 @@ class OpHolderTest( GafferTest.TestCase ) :
 		self.failUnless( "P" not in m2 )
 		self.failUnless( "renamed" in m2 )
 
+	def testComputeCache( self ) :
+
+		m = IECore.MeshPrimitive.createPlane( IECore.Box2f( IECore.V2f( -1 ), IECore.V2f( 1 ) ) )
+
+		n = GafferCortex.OpHolder()
+		opSpec = GafferCortexTest.ParameterisedHolderTest.classSpecification( "primitive/renameVariables", "IECORE_OP_PATHS" )[:-1]
+		n.setOp( *opSpec )
+
+		n["parameters"]["input"].setValue( m )
+		n["parameters"]["names"].setValue( IECore.StringVectorData( [ "P renamed" ] ) )
+
+		m2 = n["result"].getValue()
+		self.failUnless( "renamed" in m2 )
+
+		# The Op shouldn't keep its own reference to the result.
+		self.assertEqual( n.getOp().resultParameter().getValue(), n.getOp().resultParameter().defaultValue )
+
+		# The Op doesn't depend on the context, so evaluating in
+		# another context should reuse the cached result.
+		with Gaffer.PerformanceMonitor() as pm :
+			with Gaffer.Context() as c :
+				c.setFrame( 10 )
+				self.assertEqual( n["result"].getValue(), m2 )
+
+		self.assertEqual( pm.plugStatistics( n["result"] ).computeCount, 0 )
+
 	def testAffects( self ) :
 
 		n = GafferCortex.OpHolder()
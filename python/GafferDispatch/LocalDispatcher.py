@@ -42,6 +42,9 @@ import subprocess32 as subprocess
 import threading
 import time
 import traceback
+import json
+import select
+import atexit
 
 import IECore
 
@@ -57,6 +60,10 @@ class LocalDispatcher( GafferDispatch.Dispatcher ) :
 		self["executeInBackground"] = Gaffer.BoolPlug( defaultValue = False )
 		self["ignoreScriptLoadErrors"] = Gaffer.BoolPlug( defaultValue = False )
 		self["environmentCommand"] = Gaffer.StringPlug()
+		self["persistentWorkers"] = Gaffer.BoolPlug( defaultValue = False )
+		self["maximumConcurrentBatches"] = Gaffer.IntPlug( defaultValue = 1, minValue = 1 )
+		self["minimumAvailableMemory"] = Gaffer.IntPlug( defaultValue = 0, minValue = 0 )
+		self["executeInThreads"] = Gaffer.BoolPlug( defaultValue = False )
 
 		self.__jobPool = jobPool if jobPool else LocalDispatcher.defaultJobPool()
 
@@ -91,6 +98,15 @@ class LocalDispatcher( GafferDispatch.Dispatcher ) :
 			self.__environmentCommand = Gaffer.Context.current().substitute(
 				dispatcher["environmentCommand"].getValue()
 			)
+			self.__persistentWorkers = dispatcher["persistentWorkers"].getValue()
+			self.__maximumConcurrentBatches = dispatcher["maximumConcurrentBatches"].getValue()
+			self.__minimumAvailableMemory = dispatcher["minimumAvailableMemory"].getValue()
+			self.__executeInThreads = dispatcher["executeInThreads"].getValue()
+			# Script used for executing batches in threads. For foreground
+			# dispatches this is the original script, but background dispatches
+			# load their own copy, so that they're unaffected by any edits the
+			# user makes in the meantime.
+			self.__threadedScript = None
 
 			self.__messageHandler = IECore.CapturingMessageHandler()
 			self.__messageTitle = "%s : Job %s %s" % ( self.__dispatcher.getName(), self.__name, self.__id )
@@ -156,6 +172,12 @@ class LocalDispatcher( GafferDispatch.Dispatcher ) :
 
 			if background :
 				threading.Thread( target = self.__backgroundDispatch ).start()
+			elif self.__executeInThreads :
+				# Use the background scheduler, but wait for it to
+				# complete, so that we can execute independent
+				# batches concurrently.
+				self.__threadedScript = self.__batch.preTasks()[0].plug().ancestor( Gaffer.ScriptNode )
+				self.__backgroundDispatch()
 			else :
 				with self.__messageHandler :
 					self.__foregroundDispatch( self.__batch )
@@ -227,16 +249,109 @@ class LocalDispatcher( GafferDispatch.Dispatcher ) :
 		def __backgroundDispatch( self ) :
 
 			with self.__messageHandler :
+				if self.__executeInThreads and self.__threadedScript is None :
+					try :
+						self.__threadedScript = Gaffer.ScriptNode()
+						self.__threadedScript["fileName"].setValue( self.__scriptFile )
+						self.__threadedScript.load( continueOnError = self.__ignoreScriptLoadErrors )
+					except :
+						traceback.print_exc()
+						self.__reportFailed( self.__batch )
+						return
 				self.__doBackgroundDispatch( self.__batch )
 
+		# Schedules the batches, launching each as soon as all its preTasks
+		# are complete, with up to `maximumConcurrentBatches` running at once.
 		def __doBackgroundDispatch( self, batch ) :
 
-			if self.__getStatus( batch ) == LocalDispatcher.Job.Status.Complete :
+			running = {}
+			while True :
+
+				for runningBatch, thread in running.items() :
+					if not thread.is_alive() :
+						del running[runningBatch]
+
+				readyBatches = []
+				if not self.__readyBatchesWalk( batch, set(), readyBatches ) :
+					# Something failed or was killed. Don't launch anything
+					# else, but let the batches in flight finish up.
+					if not running :
+						return False
+				elif batch not in readyBatches and self.__getStatus( batch ) == LocalDispatcher.Job.Status.Complete :
+					return True
+				else :
+					for readyBatch in readyBatches :
+						if readyBatch in running :
+							continue
+						if not readyBatch.plug() or len( readyBatch.frames() ) == 0 :
+							# Nothing to execute, so there's no need for a thread.
+							self.__doBackgroundDispatchBatch( readyBatch )
+							continue
+						if len( running ) >= self.__maximumConcurrentBatches :
+							break
+						if running and not self.__memoryAvailable() :
+							break
+						thread = threading.Thread( target = self.__backgroundDispatchBatch, args = ( readyBatch, ) )
+						running[readyBatch] = thread
+						thread.start()
+
+				time.sleep( 0.01 )
+
+		# Appends batches which are waiting and have all their preTasks
+		# complete to `result`. Returns False if any batch has failed
+		# or been killed.
+		def __readyBatchesWalk( self, batch, visited, result ) :
+
+			if batch in visited :
+				return True
+
+			visited.add( batch )
+
+			status = self.__getStatus( batch )
+			if status in ( LocalDispatcher.Job.Status.Failed, LocalDispatcher.Job.Status.Killed ) :
+				return False
+			elif status != LocalDispatcher.Job.Status.Waiting :
 				return True
 
+			preTasksComplete = True
 			for upstreamBatch in batch.preTasks() :
-				if not self.__doBackgroundDispatch( upstreamBatch ) :
+				if not self.__readyBatchesWalk( upstreamBatch, visited, result ) :
 					return False
+				if self.__getStatus( upstreamBatch ) != LocalDispatcher.Job.Status.Complete :
+					preTasksComplete = False
+
+			if preTasksComplete :
+				result.append( batch )
+
+			return True
+
+		def __memoryAvailable( self ) :
+
+			if not self.__minimumAvailableMemory :
+				return True
+
+			try :
+				with open( "/proc/meminfo" ) as f :
+					for line in f :
+						if line.startswith( "MemAvailable:" ) :
+							return int( line.split()[1] ) / 1024 >= self.__minimumAvailableMemory
+			except IOError :
+				pass
+
+			return True
+
+		def __backgroundDispatchBatch( self, batch ) :
+
+			# Message handlers are per-thread, so we must
+			# install ours again here.
+			with self.__messageHandler :
+				try :
+					self.__doBackgroundDispatchBatch( batch )
+				except :
+					traceback.print_exc()
+					self.__reportFailed( batch )
+
+		def __doBackgroundDispatchBatch( self, batch ) :
 
 			if batch.blindData().get( "killed" ) :
 				self.__reportKilled( batch )
@@ -259,6 +374,27 @@ class LocalDispatcher( GafferDispatch.Dispatcher ) :
 			taskContext = batch.context()
 			frames = str( IECore.frameListFromList( [ int(x) for x in batch.frames() ] ) )
 
+			contextArgs = []
+			for entry in [ k for k in taskContext.keys() if k != "frame" and not k.startswith( "ui:" ) ] :
+				if entry not in self.__context.keys() or taskContext[entry] != self.__context[entry] :
+					contextArgs.extend( [ "-" + entry, repr(taskContext[entry]) ] )
+
+			self.__setStatus( batch, LocalDispatcher.Job.Status.Running )
+
+			if self.__executeInThreads :
+				succeeded = self.__executeInThread( batch )
+			elif self.__persistentWorkers :
+				succeeded = self.__executeInWorker( batch, frames, contextArgs )
+			else :
+				succeeded = self.__executeInProcess( batch, frames, contextArgs )
+
+			if succeeded :
+				self.__setStatus( batch, LocalDispatcher.Job.Status.Complete )
+
+			return succeeded
+
+		def __executeInProcess( self, batch, frames, contextArgs ) :
+
 			args = [
 				"gaffer", "execute",
 				"-script", self.__scriptFile,
@@ -271,15 +407,9 @@ class LocalDispatcher( GafferDispatch.Dispatcher ) :
 			if self.__ignoreScriptLoadErrors :
 				args.append( "-ignoreScriptLoadErrors" )
 
-			contextArgs = []
-			for entry in [ k for k in taskContext.keys() if k != "frame" and not k.startswith( "ui:" ) ] :
-				if entry not in self.__context.keys() or taskContext[entry] != self.__context[entry] :
-					contextArgs.extend( [ "-" + entry, repr(taskContext[entry]) ] )
-
 			if contextArgs :
 				args.extend( [ "-context" ] + contextArgs )
 
-			self.__setStatus( batch, LocalDispatcher.Job.Status.Running )
 			IECore.msg( IECore.MessageHandler.Level.Info, self.__messageTitle, " ".join( args ) )
 			process = subprocess.Popen( args, start_new_session=True )
 			batch.blindData()["pid"] = IECore.IntData( process.pid )
@@ -297,7 +427,63 @@ class LocalDispatcher( GafferDispatch.Dispatcher ) :
 				self.__reportFailed( batch )
 				return False
 
-			self.__setStatus( batch, LocalDispatcher.Job.Status.Complete )
+			return True
+
+		def __executeInWorker( self, batch, frames, contextArgs ) :
+
+			worker = LocalDispatcher._WorkerPool.acquire( self.__environmentCommand, self.__scriptFile )
+			batch.blindData()["pid"] = IECore.IntData( worker.pid() )
+
+			request = {
+				"script" : self.__scriptFile,
+				"nodes" : [ batch.blindData()["nodeName"].value ],
+				"frames" : frames,
+				"context" : contextArgs,
+				"ignoreScriptLoadErrors" : self.__ignoreScriptLoadErrors,
+			}
+
+			IECore.msg( IECore.MessageHandler.Level.Info, self.__messageTitle, "Worker %d : executing %s on %s" % ( worker.pid(), request["nodes"][0], frames ) )
+
+			try :
+				worker.send( request )
+				while True :
+					if batch.blindData().get( "killed" ) :
+						worker.kill()
+						self.__reportKilled( batch )
+						return False
+					reply = worker.receive( timeout = 0.01 )
+					if reply is not None :
+						break
+			except Exception as e :
+				# The worker died, and will not be returned to the pool.
+				IECore.msg( IECore.MessageHandler.Level.Error, self.__messageTitle, "Worker %d : %s" % ( worker.pid(), str( e ) ) )
+				self.__reportFailed( batch )
+				return False
+
+			LocalDispatcher._WorkerPool.release( worker )
+
+			if reply["result"] :
+				self.__reportFailed( batch )
+				return False
+
+			return True
+
+		# Executes the batch directly in the current process, so that
+		# concurrent batches share the compute cache. Unlike the other
+		# methods, a batch which has started can't be killed, so we just
+		# wait for it to finish.
+		def __executeInThread( self, batch ) :
+
+			nodeName = batch.blindData()["nodeName"].value
+			IECore.msg( IECore.MessageHandler.Level.Info, self.__messageTitle, "executing %s on %s" % ( nodeName, str( batch.frames() ) ) )
+
+			try :
+				with Gaffer.Context( batch.context() ) :
+					self.__threadedScript.descendant( nodeName )["task"].executeSequence( batch.frames() )
+			except :
+				traceback.print_exc()
+				self.__reportFailed( batch )
+				return False
 
 			return True
 
@@ -426,6 +612,119 @@ class LocalDispatcher( GafferDispatch.Dispatcher ) :
 				self.jobFailedSignal()( job )
 				self._remove( job )
 
+	# A long-lived `gaffer execute -worker` process, which keeps
+	# the script loaded between batches, avoiding the startup cost
+	# of launching a new process for each one.
+	class _Worker( object ) :
+
+		def __init__( self, environmentCommand, scriptFile ) :
+
+			self.__environmentCommand = environmentCommand
+
+			args = shlex.split( environmentCommand ) + [
+				"gaffer", "execute",
+				# The script is loaded on demand for each request,
+				# but the app requires a valid one up front.
+				"-script", scriptFile,
+				"-worker",
+			]
+
+			self.__process = subprocess.Popen(
+				args,
+				stdin = subprocess.PIPE,
+				stdout = subprocess.PIPE,
+				start_new_session = True,
+			)
+
+		def environmentCommand( self ) :
+
+			return self.__environmentCommand
+
+		def pid( self ) :
+
+			return self.__process.pid
+
+		def alive( self ) :
+
+			return self.__process.poll() is None
+
+		def send( self, request ) :
+
+			self.__process.stdin.write( json.dumps( request ) + "\n" )
+			self.__process.stdin.flush()
+
+		# Returns the reply to the last request, or None if it
+		# is not available within the timeout.
+		def receive( self, timeout ) :
+
+			ready = select.select( [ self.__process.stdout ], [], [], timeout )[0]
+			if not ready :
+				return None
+
+			line = self.__process.stdout.readline()
+			if not line :
+				raise RuntimeError( "Worker exited unexpectedly" )
+
+			return json.loads( line )
+
+		def kill( self ) :
+
+			try :
+				os.killpg( self.__process.pid, signal.SIGTERM )
+			except OSError as e :
+				if e.errno != errno.ESRCH :
+					raise
+
+		# Asks the worker to exit once it has finished any
+		# work in progress.
+		def shutdown( self ) :
+
+			try :
+				self.__process.stdin.close()
+			except IOError :
+				pass
+
+	# The idle workers, shared by all LocalDispatchers. A worker is owned by a
+	# single job while it executes a batch, and returned here afterwards.
+	class _WorkerPool( object ) :
+
+		__mutex = threading.Lock()
+		__idleWorkers = []
+
+		@classmethod
+		def acquire( cls, environmentCommand, scriptFile ) :
+
+			with cls.__mutex :
+				for worker in list( cls.__idleWorkers ) :
+					if not worker.alive() :
+						cls.__idleWorkers.remove( worker )
+					elif worker.environmentCommand() == environmentCommand :
+						cls.__idleWorkers.remove( worker )
+						return worker
+
+			return LocalDispatcher._Worker( environmentCommand, scriptFile )
+
+		@classmethod
+		def release( cls, worker ) :
+
+			with cls.__mutex :
+				cls.__idleWorkers.append( worker )
+
+		@classmethod
+		def shutdown( cls ) :
+
+			with cls.__mutex :
+				for worker in cls.__idleWorkers :
+					worker.shutdown()
+				cls.__idleWorkers = []
+
+	## Shuts down all idle persistent workers. Workers are otherwise
+	# kept alive until the process exits.
+	@staticmethod
+	def shutdownWorkers() :
+
+		LocalDispatcher._WorkerPool.shutdown()
+
 	__jobPool = JobPool()
 
 	@staticmethod
@@ -451,6 +750,8 @@ class LocalDispatcher( GafferDispatch.Dispatcher ) :
 
 		job.execute( background = self["executeInBackground"].getValue() )
 
+atexit.register( LocalDispatcher.shutdownWorkers )
+
 IECore.registerRunTimeTyped( LocalDispatcher, typeName = "GafferDispatch::LocalDispatcher" )
 IECore.registerRunTimeTyped( LocalDispatcher.JobPool, typeName = "GafferDispatch::LocalDispatcher::JobPool" )
 
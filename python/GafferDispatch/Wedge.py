@@ -34,7 +34,9 @@
 #
 ##########################################################################
 
+import sys
 import math
+import threading
 
 import IECore
 
@@ -44,6 +46,7 @@ import GafferDispatch
 class Wedge( GafferDispatch.TaskContextProcessor ) :
 
 	Mode = IECore.Enum.create( "FloatRange", "IntRange", "ColorRange", "FloatList", "IntList", "StringList" )
+	SharedEvaluation = IECore.Enum.create( "Off", "Sequential", "Concurrent" )
 
 	def __init__( self, name = "Wedge" ) :
 
@@ -92,6 +95,14 @@ class Wedge( GafferDispatch.TaskContextProcessor ) :
 		self["ints"] = Gaffer.IntVectorDataPlug( defaultValue = IECore.IntVectorData() )
 		self["strings"] = Gaffer.StringVectorDataPlug( defaultValue = IECore.StringVectorData() )
 
+		# shared evaluation
+
+		self["sharedEvaluation"] = Gaffer.IntPlug(
+			defaultValue = int( self.SharedEvaluation.Off ),
+			minValue = int( self.SharedEvaluation.Off ),
+			maxValue = int( self.SharedEvaluation.Concurrent ),
+		)
+
 	def values( self ) :
 
 		mode = self.Mode( self["mode"].getValue() )
@@ -147,6 +158,119 @@ class Wedge( GafferDispatch.TaskContextProcessor ) :
 
 		return values
 
+	# When evaluation is shared, the Wedge executes its immediate
+	# upstream tasks itself, for all wedge values, within a single
+	# task. They then share the compute cache, rather than each
+	# evaluating the upstream graph from scratch in separate processes.
+	# Only the dependencies of those upstream tasks are dispatched as
+	# preTasks in the usual way.
+
+	def preTasks( self, context ) :
+
+		if self.__sharedEvaluation( context ) == self.SharedEvaluation.Off :
+			return GafferDispatch.TaskContextProcessor.preTasks( self, context )
+
+		result = []
+		for plug, wedgeContext in self.__wedgedTasks( context ) :
+			with wedgeContext :
+				result.extend( plug.preTasks() )
+
+		return result
+
+	def hash( self, context ) :
+
+		if self.__sharedEvaluation( context ) == self.SharedEvaluation.Off :
+			return GafferDispatch.TaskContextProcessor.hash( self, context )
+
+		h = GafferDispatch.TaskNode.hash( self, context )
+		for plug, wedgeContext in self.__wedgedTasks( context ) :
+			with wedgeContext :
+				h.append( plug.hash() )
+
+		return h
+
+	def requiresSequenceExecution( self ) :
+
+		context = Gaffer.Context.current()
+		if self.__sharedEvaluation( context ) == self.SharedEvaluation.Off :
+			return False
+
+		for plug, wedgeContext in self.__wedgedTasks( context ) :
+			with wedgeContext :
+				if plug.requiresSequenceExecution() :
+					return True
+
+		return False
+
+	def execute( self ) :
+
+		self.executeSequence( [ Gaffer.Context.current().getFrame() ] )
+
+	def executeSequence( self, frames ) :
+
+		context = Gaffer.Context.current()
+		sharedEvaluation = self.__sharedEvaluation( context )
+		if sharedEvaluation == self.SharedEvaluation.Off :
+			return
+
+		# As with regular dispatch, tasks with identical hashes need
+		# only be executed once, and no-ops need not be executed at all.
+		tasks = []
+		executed = set()
+		for plug, wedgeContext in self.__wedgedTasks( context ) :
+			with wedgeContext :
+				h = plug.hash()
+			key = ( plug.fullName(), str( h ) )
+			if h == IECore.MurmurHash() or key in executed :
+				continue
+			executed.add( key )
+			tasks.append( ( plug, wedgeContext ) )
+
+		if sharedEvaluation == self.SharedEvaluation.Sequential :
+			for plug, wedgeContext in tasks :
+				with wedgeContext :
+					plug.executeSequence( frames )
+			return
+
+		# Concurrent. TaskPlug.executeSequence() releases the GIL, so
+		# the tasks really do run in parallel, and any computes they
+		# have in common are shared between them via the cache.
+
+		errors = []
+		def executeTask( plug, wedgeContext ) :
+			try :
+				with wedgeContext :
+					plug.executeSequence( frames )
+			except :
+				errors.append( sys.exc_info() )
+
+		threads = [ threading.Thread( target = executeTask, args = task ) for task in tasks ]
+		for thread in threads :
+			thread.start()
+		for thread in threads :
+			thread.join()
+
+		if errors :
+			raise errors[0][0], errors[0][1], errors[0][2]
+
+	def __sharedEvaluation( self, context ) :
+
+		with context :
+			return self.SharedEvaluation( self["sharedEvaluation"].getValue() )
+
+	# Returns a list of ( TaskPlug, Context ) pairs for each
+	# upstream task in each wedge context.
+	def __wedgedTasks( self, context ) :
+
+		plugs = []
+		for plug in self["preTasks"] :
+			source = plug.source()
+			if source.isSame( plug ) or not isinstance( source.node(), GafferDispatch.TaskNode ) :
+				continue
+			plugs.append( source )
+
+		return [ ( p, c ) for c in self._processedContexts( context ) for p in plugs ]
+
 	def _processedContexts( self, context ) :
 
 		# make a context for each of the wedge values
@@ -1267,6 +1267,34 @@ class DispatcherTest( GafferTest.TestCase ) :
 		self.assertEqual( [ l.node for l in log ], [ s["t"], s["p"], ] * 4 )
 		self.assertEqual( [ l.context.getFrame() for l in log ], [ 1, 1, 2, 2, 3, 3, 4, 4 ] )
 
+	def testFrameOrderWithManyNodes( self ) :
+
+		# a   b
+		#  \ /
+		#   c
+
+		s = Gaffer.ScriptNode()
+
+		log = []
+		s["c"] = GafferDispatchTest.LoggingTaskNode( log = log )
+		s["c"]["f"] = Gaffer.StringPlug( defaultValue = "####" )
+
+		for name in ( "a", "b" ) :
+			s[name] = GafferDispatchTest.LoggingTaskNode( log = log )
+			s[name]["preTasks"][0].setInput( s["c"]["task"] )
+			s[name]["f"] = Gaffer.StringPlug( defaultValue = "####" )
+
+		dispatcher = GafferDispatch.Dispatcher.create( "testDispatcher" )
+		dispatcher["framesMode"].setValue( GafferDispatch.Dispatcher.FramesMode.CustomRange )
+		dispatcher["frameRange"].setValue( "1-200" )
+
+		# Tasks are prepared in parallel, but the order of
+		# execution must be the same as if they were not.
+		dispatcher.dispatch( [ s["a"], s["b"] ] )
+
+		self.assertEqual( [ l.node for l in log ], [ s["c"], s["a"], s["b"] ] * 200 )
+		self.assertEqual( [ l.context.getFrame() for l in log ], [ f for f in range( 1, 201 ) for i in range( 0, 3 ) ] )
+
 	def testFrameOrderWithStaticPostTask( self ) :
 
 		# t - p
@@ -1381,5 +1409,77 @@ class DispatcherTest( GafferTest.TestCase ) :
 		d.dispatch( [ lastTask ] )
 		self.assertLess( time.clock() - t, 4 )
 
+	def testSkipUpToDateTasks( self ) :
+
+		s = Gaffer.ScriptNode()
+
+		# Writers in append mode, so we can tell how many times
+		# each one has been executed for each frame.
+		s["a"] = GafferDispatchTest.TextWriter()
+		s["a"]["mode"].setValue( "a" )
+		s["a"]["fileName"].setValue( self.temporaryDirectory() + "/a.####.txt" )
+		s["a"]["text"].setValue( "a" )
+
+		s["b"] = GafferDispatchTest.TextWriter()
+		s["b"]["mode"].setValue( "a" )
+		s["b"]["fileName"].setValue( self.temporaryDirectory() + "/b.####.txt" )
+		s["b"]["text"].setValue( "b" )
+		s["b"]["preTasks"][0].setInput( s["a"]["task"] )
+
+		d = self.TestDispatcher()
+		d["jobsDirectory"].setValue( self.temporaryDirectory() + "/jobs" )
+		d["framesMode"].setValue( d.FramesMode.CustomRange )
+		d["frameRange"].setValue( "1-3" )
+		d["skipUpToDateTasks"].setValue( True )
+
+		def assertContents( name, expected ) :
+
+			for frame, text in zip( range( 1, 4 ), expected ) :
+				with open( self.temporaryDirectory() + "/%s.%04d.txt" % ( name, frame ) ) as f :
+					self.assertEqual( f.read(), text )
+
+		# Everything should execute first time round.
+
+		d.dispatch( [ s["b"] ] )
+		assertContents( "a", [ "a", "a", "a" ] )
+		assertContents( "b", [ "b", "b", "b" ] )
+
+		# And nothing second time round, because nothing changed.
+
+		d.dispatch( [ s["b"] ] )
+		assertContents( "a", [ "a", "a", "a" ] )
+		assertContents( "b", [ "b", "b", "b" ] )
+
+		# Changing the downstream task should only execute
+		# that task.
+
+		s["b"]["text"].setValue( "c" )
+		d.dispatch( [ s["b"] ] )
+		assertContents( "a", [ "a", "a", "a" ] )
+		assertContents( "b", [ "bc", "bc", "bc" ] )
+
+		# Modifying an upstream output should execute that
+		# frame, and everything downstream of it.
+
+		os.utime( self.temporaryDirectory() + "/a.0002.txt", ( 0, 0 ) )
+		d.dispatch( [ s["b"] ] )
+		assertContents( "a", [ "a", "aa", "a" ] )
+		assertContents( "b", [ "bc", "bcc", "bc" ] )
+
+		# As should deleting an output.
+
+		os.remove( self.temporaryDirectory() + "/b.0003.txt" )
+		d.dispatch( [ s["b"] ] )
+		assertContents( "a", [ "a", "aa", "a" ] )
+		assertContents( "b", [ "bc", "bcc", "c" ] )
+
+		# And everything should execute if we turn the
+		# option off.
+
+		d["skipUpToDateTasks"].setValue( False )
+		d.dispatch( [ s["b"] ] )
+		assertContents( "a", [ "aa", "aaa", "aa" ] )
+		assertContents( "b", [ "bcc", "bccc", "cc" ] )
+
 if __name__ == "__main__":
 	unittest.main()
@@ -744,6 +744,174 @@ class LocalDispatcherTest( GafferTest.TestCase ) :
 		with open( testFile ) as f :
 			self.assertEqual( f.readlines(), [ "HELLO WORLD\n" ] )
 
+	def testPersistentWorkers( self ) :
+
+		s = Gaffer.ScriptNode()
+		s["n"] = GafferDispatchTest.TextWriter()
+		s["n"]["fileName"].setValue( "/tmp/dispatcherTest/n_####.txt" )
+		s["n"]["text"].setValue( "n on ${frame} with ${foo}" )
+
+		dispatcher = GafferDispatch.LocalDispatcher( jobPool = GafferDispatch.LocalDispatcher.JobPool() )
+		dispatcher["jobsDirectory"].setValue( "/tmp/dispatcherTest" )
+		dispatcher["executeInBackground"].setValue( True )
+		dispatcher["persistentWorkers"].setValue( True )
+		dispatcher["framesMode"].setValue( dispatcher.FramesMode.CustomRange )
+		dispatcher["frameRange"].setValue( "1-3" )
+		self.addCleanup( GafferDispatch.LocalDispatcher.shutdownWorkers )
+
+		for i in range( 0, 3 ) :
+
+			c = Gaffer.Context( s.context() )
+			c["foo"] = "foo%d" % i
+			with c :
+				dispatcher.dispatch( [ s["n"] ] )
+			dispatcher.jobPool().waitForAll()
+			self.assertEqual( len( dispatcher.jobPool().failedJobs() ), 0 )
+
+			for frame in range( 1, 4 ) :
+				fileName = "/tmp/dispatcherTest/n_%04d.txt" % frame
+				with open( fileName ) as f :
+					self.assertEqual( f.read(), "n on %d with foo%d" % ( frame, i ) )
+
+	def testPersistentWorkerFailure( self ) :
+
+		s = Gaffer.ScriptNode()
+		s["n"] = GafferDispatch.PythonCommand()
+		s["n"]["command"].setValue( "raise Exception( 'Failing deliberately' )" )
+
+		dispatcher = GafferDispatch.LocalDispatcher( jobPool = GafferDispatch.LocalDispatcher.JobPool() )
+		dispatcher["jobsDirectory"].setValue( "/tmp/dispatcherTest" )
+		dispatcher["executeInBackground"].setValue( True )
+		dispatcher["persistentWorkers"].setValue( True )
+		self.addCleanup( GafferDispatch.LocalDispatcher.shutdownWorkers )
+
+		dispatcher.dispatch( [ s["n"] ] )
+		dispatcher.jobPool().waitForAll()
+		self.assertEqual( len( dispatcher.jobPool().failedJobs() ), 1 )
+
+		# The worker should survive the failure and be usable again.
+
+		s["n"]["command"].setValue( "pass" )
+		dispatcher.dispatch( [ s["n"] ] )
+		dispatcher.jobPool().waitForAll()
+		self.assertEqual( len( dispatcher.jobPool().failedJobs() ), 1 )
+
+	def __concurrencyScript( self ) :
+
+		s = Gaffer.ScriptNode()
+		s["l"] = GafferDispatch.TaskList()
+		for i in range( 0, 4 ) :
+			s["c%d" % i] = GafferDispatch.SystemCommand()
+			s["c%d" % i]["command"].setValue(
+				"touch /tmp/dispatcherTest/running_{i} && sleep 2 && "
+				"ls /tmp/dispatcherTest/running_* | wc -l > /tmp/dispatcherTest/count_{i} && "
+				"rm /tmp/dispatcherTest/running_{i}".format( i = i )
+			)
+			s["l"]["preTasks"][i].setInput( s["c%d" % i]["task"] )
+
+		return s
+
+	def __concurrencyCounts( self ) :
+
+		result = []
+		for i in range( 0, 4 ) :
+			with open( "/tmp/dispatcherTest/count_%d" % i ) as f :
+				result.append( int( f.read() ) )
+
+		return result
+
+	def testConcurrentBatches( self ) :
+
+		s = self.__concurrencyScript()
+
+		dispatcher = GafferDispatch.LocalDispatcher( jobPool = GafferDispatch.LocalDispatcher.JobPool() )
+		dispatcher["jobsDirectory"].setValue( "/tmp/dispatcherTest" )
+		dispatcher["executeInBackground"].setValue( True )
+		dispatcher["framesMode"].setValue( dispatcher.FramesMode.CurrentFrame )
+
+		# By default, batches are executed one at a time.
+
+		dispatcher.dispatch( [ s["l"] ] )
+		dispatcher.jobPool().waitForAll()
+		self.assertEqual( len( dispatcher.jobPool().failedJobs() ), 0 )
+		self.assertEqual( self.__concurrencyCounts(), [ 1, 1, 1, 1 ] )
+
+		# But independent batches may run concurrently
+		# if we allow it.
+
+		dispatcher["maximumConcurrentBatches"].setValue( 4 )
+		dispatcher.dispatch( [ s["l"] ] )
+		dispatcher.jobPool().waitForAll()
+		self.assertEqual( len( dispatcher.jobPool().failedJobs() ), 0 )
+		self.assertGreater( max( self.__concurrencyCounts() ), 1 )
+
+	def testConcurrentBatchesRespectDependencies( self ) :
+
+		s = Gaffer.ScriptNode()
+		s["n1"] = GafferDispatchTest.TextWriter()
+		s["n1"]["fileName"].setValue( "/tmp/dispatcherTest/n1.txt" )
+		s["n1"]["text"].setValue( "n1" )
+
+		s["n2"] = GafferDispatch.SystemCommand()
+		s["n2"]["command"].setValue( "cat /tmp/dispatcherTest/n1.txt > /tmp/dispatcherTest/n2.txt" )
+		s["n2"]["preTasks"][0].setInput( s["n1"]["task"] )
+
+		dispatcher = GafferDispatch.LocalDispatcher( jobPool = GafferDispatch.LocalDispatcher.JobPool() )
+		dispatcher["jobsDirectory"].setValue( "/tmp/dispatcherTest" )
+		dispatcher["executeInBackground"].setValue( True )
+		dispatcher["framesMode"].setValue( dispatcher.FramesMode.CurrentFrame )
+		dispatcher["maximumConcurrentBatches"].setValue( 4 )
+
+		dispatcher.dispatch( [ s["n2"] ] )
+		dispatcher.jobPool().waitForAll()
+		self.assertEqual( len( dispatcher.jobPool().failedJobs() ), 0 )
+
+		with open( "/tmp/dispatcherTest/n2.txt" ) as f :
+			self.assertEqual( f.read(), "n1" )
+
+	def testExecuteInThreads( self ) :
+
+		s = self.__concurrencyScript()
+
+		for background in ( False, True ) :
+
+			dispatcher = GafferDispatch.LocalDispatcher( jobPool = GafferDispatch.LocalDispatcher.JobPool() )
+			dispatcher["jobsDirectory"].setValue( "/tmp/dispatcherTest" )
+			dispatcher["executeInBackground"].setValue( background )
+			dispatcher["executeInThreads"].setValue( True )
+			dispatcher["maximumConcurrentBatches"].setValue( 4 )
+			dispatcher["framesMode"].setValue( dispatcher.FramesMode.CurrentFrame )
+
+			dispatcher.dispatch( [ s["l"] ] )
+			dispatcher.jobPool().waitForAll()
+			self.assertEqual( len( dispatcher.jobPool().failedJobs() ), 0 )
+			self.assertGreater( max( self.__concurrencyCounts() ), 1 )
+
+	def testExecuteInThreadsUsesCurrentProcess( self ) :
+
+		s = Gaffer.ScriptNode()
+		s["n"] = GafferDispatch.PythonCommand()
+		s["n"]["command"].setValue( "import os\nwith open( '/tmp/dispatcherTest/pid.txt', 'w' ) as f : f.write( str( os.getpid() ) )" )
+
+		dispatcher = GafferDispatch.LocalDispatcher( jobPool = GafferDispatch.LocalDispatcher.JobPool() )
+		dispatcher["jobsDirectory"].setValue( "/tmp/dispatcherTest" )
+		dispatcher["executeInBackground"].setValue( True )
+		dispatcher["executeInThreads"].setValue( True )
+
+		dispatcher.dispatch( [ s["n"] ] )
+		dispatcher.jobPool().waitForAll()
+		self.assertEqual( len( dispatcher.jobPool().failedJobs() ), 0 )
+
+		with open( "/tmp/dispatcherTest/pid.txt" ) as f :
+			self.assertEqual( int( f.read() ), os.getpid() )
+
+		# Failures should be reported as usual.
+
+		s["n"]["command"].setValue( "raise Exception( 'Failing deliberately' )" )
+		dispatcher.dispatch( [ s["n"] ] )
+		dispatcher.jobPool().waitForAll()
+		self.assertEqual( len( dispatcher.jobPool().failedJobs() ), 1 )
+
 	def testScaling( self ) :
 
 		# See DispatcherTest.testScaling for details.
@@ -365,5 +365,49 @@ class WedgeTest( GafferTest.TestCase ) :
 		# the wedge variable at all.
 		self.assertEqual( len( script["constant"].log ), 1 )
 
+	def testSharedEvaluation( self ) :
+
+		script = Gaffer.ScriptNode()
+
+		script["constant"] = GafferDispatchTest.LoggingTaskNode()
+
+		script["writer"] = GafferDispatchTest.TextWriter()
+		script["writer"]["preTasks"][0].setInput( script["constant"]["task"] )
+		script["writer"]["fileName"].setValue( self.temporaryDirectory() + "/${wedge:mode}/${name}.txt" )
+		script["writer"]["text"].setValue( "${name}" )
+
+		script["static"] = GafferDispatchTest.LoggingTaskNode()
+
+		script["wedge"] = GafferDispatch.Wedge()
+		script["wedge"]["preTasks"][0].setInput( script["writer"]["task"] )
+		script["wedge"]["preTasks"][1].setInput( script["static"]["task"] )
+		script["wedge"]["variable"].setValue( "name" )
+		script["wedge"]["mode"].setValue( int( GafferDispatch.Wedge.Mode.StringList ) )
+		script["wedge"]["strings"].setValue( IECore.StringVectorData( [ "tom", "dick", "harry" ] ) )
+
+		for mode in ( GafferDispatch.Wedge.SharedEvaluation.Sequential, GafferDispatch.Wedge.SharedEvaluation.Concurrent ) :
+
+			del script["constant"].log[:]
+			del script["static"].log[:]
+
+			script["wedge"]["sharedEvaluation"].setValue( int( mode ) )
+			self.assertTrue( script["wedge"]["task"].hash() != IECore.MurmurHash() )
+
+			context = Gaffer.Context( script.context() )
+			context["wedge:mode"] = str( mode )
+			with context :
+				self.__dispatcher().dispatch( [ script["wedge"] ] )
+
+			for name in [ "tom", "dick", "harry" ] :
+				with open( self.temporaryDirectory() + "/%s/%s.txt" % ( mode, name ) ) as f :
+					self.assertEqual( f.read(), name )
+
+			# The constant node is a preTask of the writer, so is dispatched
+			# in the usual way, once. The static node is executed by the wedge
+			# itself, and should also only be executed once, because its hash
+			# is the same for every wedge value.
+			self.assertEqual( len( script["constant"].log ), 1 )
+			self.assertEqual( len( script["static"].log ), 1 )
+
 if __name__ == "__main__":
 	unittest.main()
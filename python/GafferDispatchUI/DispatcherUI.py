@@ -114,6 +114,22 @@ Gaffer.Metadata.registerNode(
 
 		),
 
+		"skipUpToDateTasks" : (
+
+			"description",
+			"""
+			Skips tasks which are already up to date, in the manner
+			of `make`. When this is on, each task records its hash in
+			a ".gafferManifest" directory next to the file it outputs.
+			Subsequent dispatches will skip the task if its hash is
+			unchanged, its output file hasn't been modified since, and
+			all its upstream tasks are up to date too. Only tasks with
+			a "fileName" plug, such as ImageWriter, SceneWriter and
+			scene description renders, can be skipped.
+			""",
+
+		),
+
 	}
 
 )
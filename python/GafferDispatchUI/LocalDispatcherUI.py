@@ -97,6 +97,61 @@ Gaffer.Metadata.registerNode(
 
 		),
 
+		"persistentWorkers" : (
+
+			"description",
+			"""
+			Executes background tasks in long-lived worker processes
+			rather than launching a new `gaffer execute` process for
+			each batch. Workers keep the script loaded between batches,
+			which greatly reduces the overhead for jobs containing many
+			small tasks. Workers are shared between jobs with the same
+			environment command, and exit when Gaffer does.
+			""",
+
+		),
+
+		"maximumConcurrentBatches" : (
+
+			"description",
+			"""
+			The maximum number of batches to execute at the same
+			time when executing in the background. Batches are launched
+			as soon as all their preTasks have completed, so independent
+			batches may run concurrently.
+			""",
+
+		),
+
+		"minimumAvailableMemory" : (
+
+			"description",
+			"""
+			The amount of memory, in megabytes, that must be available
+			before an additional concurrent batch is launched. A value
+			of 0 disables the check. A batch is always launched if
+			nothing else is running, regardless of this setting.
+			""",
+
+		),
+
+		"executeInThreads" : (
+
+			"description",
+			"""
+			Executes tasks on threads within the current process,
+			rather than in separate `gaffer execute` processes. This
+			avoids the cost of loading the script for each batch, and
+			allows concurrent batches to benefit from each other's cached
+			results. It is intended for thread-safe nodes such as ImageWriter
+			and SceneWriter. Use maximumConcurrentBatches to control how many
+			batches run at once, in either the foreground or the background.
+			Background jobs execute a private copy of the script, so are
+			unaffected by subsequent edits.
+			""",
+
+		),
+
 	}
 
 )
@@ -279,6 +279,35 @@ Gaffer.Metadata.registerNode(
 
 		],
 
+		"sharedEvaluation" : [
+
+			"description",
+			"""
+			Executes the upstream tasks for all wedge values within
+			a single task, so that they share the results of any
+			computations they have in common. This is useful when the
+			wedge varies only a small part of the graph - a shader
+			parameter for instance - when the rest of the scene would
+			otherwise be loaded and processed again for every value.
+
+			  - Off executes each wedge value as a separate task.
+			  - Sequential executes the values one after another.
+			  - Concurrent executes the values in parallel. This
+			    requires the upstream tasks to be thread-safe.
+
+			Only the tasks immediately upstream of the Wedge are
+			executed this way - their own preTasks are dispatched
+			as normal.
+			""",
+
+			"plugValueWidget:type", "GafferUI.PresetsPlugValueWidget",
+
+			"preset:Off", int( GafferDispatch.Wedge.SharedEvaluation.Off ),
+			"preset:Sequential", int( GafferDispatch.Wedge.SharedEvaluation.Sequential ),
+			"preset:Concurrent", int( GafferDispatch.Wedge.SharedEvaluation.Concurrent ),
+
+		],
+
 	}
 
 )
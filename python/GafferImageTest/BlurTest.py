@@ -126,5 +126,46 @@ class BlurTest( GafferTest.TestCase ) :
 			blur["radius"].setValue( IECore.V2f( i * 0.5 ) )
 			self.assertAlmostEqual( stats["average"]["r"].getValue(), 1 / 100., delta = 0.0001 )
 
+	def testFastMode( self ) :
+
+		constant = GafferImage.Constant()
+		constant["color"].setValue( IECore.Color4f( 1 ) )
+
+		crop = GafferImage.Crop()
+		crop["in"].setInput( constant["out"] )
+		crop["area"].setValue( IECore.Box2i( IECore.V2i( 100 ), IECore.V2i( 101 ) ) )
+		crop["affectDisplayWindow"].setValue( False )
+
+		accurate = GafferImage.Blur()
+		accurate["in"].setInput( crop["out"] )
+		accurate["expandDataWindow"].setValue( True )
+
+		fast = GafferImage.Blur()
+		fast["in"].setInput( crop["out"] )
+		fast["expandDataWindow"].setValue( True )
+		fast["mode"].setValue( GafferImage.Blur.Mode.Fast )
+
+		stats = GafferImage.ImageStats()
+		stats["in"].setInput( fast["out"] )
+		stats["regionOfInterest"].setValue( IECore.Box2i( IECore.V2i( 0 ), IECore.V2i( 200 ) ) )
+
+		for radius in ( 2, 10, 40 ) :
+
+			accurate["radius"].setValue( IECore.V2f( radius ) )
+			fast["radius"].setValue( IECore.V2f( radius ) )
+			tileOrigin = GafferImage.ImagePlug.tileOrigin( IECore.V2i( 100 ) )
+			self.assertNotEqual( accurate["out"].channelDataHash( "R", tileOrigin ), fast["out"].channelDataHash( "R", tileOrigin ) )
+
+			# Energy is preserved
+			self.assertAlmostEqual( stats["average"]["r"].getValue(), 1 / 40000., delta = 0.000001 )
+
+			# And the result approximates the accurate blur
+			accurateSampler = GafferImage.Sampler( accurate["out"], "R", IECore.Box2i( IECore.V2i( 50 ), IECore.V2i( 150 ) ) )
+			fastSampler = GafferImage.Sampler( fast["out"], "R", IECore.Box2i( IECore.V2i( 50 ), IECore.V2i( 150 ) ) )
+			for x in range( 100 - radius, 100 + radius, max( 1, radius / 4 ) ) :
+				a = accurateSampler.sample( x, 100 )
+				f = fastSampler.sample( x, 100 )
+				self.assertAlmostEqual( a, f, delta = max( a, f ) * 0.25 + 0.0001 )
+
 if __name__ == "__main__":
 	unittest.main()
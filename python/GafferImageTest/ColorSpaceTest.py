@@ -151,5 +151,51 @@ class ColorSpaceTest( GafferImageTest.ImageTestCase ) :
 		self.assertEqual( i["out"]["dataWindow"].getValue(), o["out"]["dataWindow"].getValue() )
 		self.assertEqual( i["out"]["channelNames"].getValue(), o["out"]["channelNames"].getValue() )
 
+	def testColorDataSharedBetweenChannels( self ) :
+
+		i = GafferImage.ImageReader()
+		i["fileName"].setValue( self.fileName )
+
+		o = GafferImage.ColorSpace()
+		o["in"].setInput( i["out"] )
+		o["inputSpace"].setValue( "linear" )
+		o["outputSpace"].setValue( "sRGB" )
+
+		with Gaffer.PerformanceMonitor() as m :
+			for channel in ( "R", "G", "B" ) :
+				o["out"].channelData( channel, IECore.V2i( 0 ) )
+
+		self.assertEqual( m.plugStatistics( o["__colorData"] ).hashCount, 1 )
+		self.assertEqual( m.plugStatistics( o["__colorData"] ).computeCount, 1 )
+
+	def testSharedProcessors( self ) :
+
+		# Nodes with the same transform share a cached processor,
+		# but must still give correct results when the transform
+		# changes.
+
+		i = GafferImage.ImageReader()
+		i["fileName"].setValue( self.fileName )
+
+		o1 = GafferImage.ColorSpace()
+		o1["in"].setInput( i["out"] )
+		o1["inputSpace"].setValue( "linear" )
+		o1["outputSpace"].setValue( "sRGB" )
+
+		o2 = GafferImage.ColorSpace()
+		o2["in"].setInput( i["out"] )
+		o2["inputSpace"].setValue( "linear" )
+		o2["outputSpace"].setValue( "sRGB" )
+
+		self.assertEqual( o1["out"].image(), o2["out"].image() )
+
+		o2["inputSpace"].setValue( "sRGB" )
+		o2["outputSpace"].setValue( "linear" )
+		self.assertNotEqual( o1["out"].image(), o2["out"].image() )
+
+		o1["inputSpace"].setValue( "sRGB" )
+		o1["outputSpace"].setValue( "linear" )
+		self.assertEqual( o1["out"].image(), o2["out"].image() )
+
 if __name__ == "__main__":
 	unittest.main()
@@ -226,5 +226,36 @@ class FormatPlugTest( GafferImageTest.ImageTestCase ) :
 
 		self.assertEqual( len( allHashes ), 1 )
 
+	def testProxyLevel( self ) :
+
+		constant = GafferImage.Constant()
+		constant["format"].setValue( GafferImage.Format( IECore.Box2i( IECore.V2i( -11, 0 ), IECore.V2i( 101, 200 ) ), 2 ) )
+
+		grade = GafferImage.Grade()
+		grade["in"].setInput( constant["out"] )
+
+		with Gaffer.Context() as context :
+
+			h = constant["out"]["format"].hash()
+			self.assertEqual( GafferImage.FormatPlug.getProxyLevel( context ), 0 )
+
+			GafferImage.FormatPlug.setProxyLevel( context, 2 )
+			self.assertEqual( GafferImage.FormatPlug.getProxyLevel( context ), 2 )
+			self.assertNotEqual( constant["out"]["format"].hash(), h )
+
+			# Windows are scaled, rounding outwards, and the pixel
+			# aspect is preserved.
+			f = GafferImage.Format( IECore.Box2i( IECore.V2i( -3, 0 ), IECore.V2i( 26, 50 ) ), 2 )
+			self.assertEqual( constant["out"]["format"].getValue(), f )
+			# A format which comes from an upstream image must not be
+			# scaled a second time.
+			self.assertEqual( grade["out"]["format"].getValue(), f )
+
+			GafferImage.FormatPlug.setProxyLevel( context, 100 )
+			self.assertEqual( GafferImage.FormatPlug.getProxyLevel( context ), GafferImage.FormatPlug.maxProxyLevel )
+
+		# The plug value itself is unaffected.
+		self.assertEqual( constant["format"].getValue(), GafferImage.Format( IECore.Box2i( IECore.V2i( -11, 0 ), IECore.V2i( 101, 200 ) ), 2 ) )
+
 if __name__ == "__main__":
 	unittest.main()
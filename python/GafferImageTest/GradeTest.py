@@ -165,3 +165,72 @@ class GradeTest( GafferImageTest.ImageTestCase ) :
 						s["c"]["out"]["channelData"].getValue( _copy=False )
 					)
 				)
+
+	def testGammaAndClamping( self ) :
+
+		c = GafferImage.Constant()
+		c["color"].setValue( IECore.Color4f( -0.5, 0.25, 2, 1 ) )
+
+		grade = GafferImage.Grade()
+		grade["in"].setInput( c["out"] )
+		grade["gamma"].setValue( IECore.Color3f( 2 ) )
+
+		def assertValues( r, g, b ) :
+			for channel, value in zip( "RGB", ( r, g, b ) ) :
+				data = grade["out"].channelData( channel, IECore.V2i( 0 ) )
+				self.assertEqual( len( data ), GafferImage.ImagePlug.tileSize() ** 2 )
+				for v in ( data[0], data[-1] ) :
+					self.assertAlmostEqual( v, value, places = 5 )
+
+		grade["blackClamp"].setValue( False )
+		grade["whiteClamp"].setValue( False )
+		assertValues( -0.5, 0.5, 2 ** 0.5 )
+
+		grade["blackClamp"].setValue( True )
+		assertValues( 0, 0.5, 2 ** 0.5 )
+
+		grade["whiteClamp"].setValue( True )
+		assertValues( 0, 0.5, 1 )
+
+		grade["gamma"].setValue( IECore.Color3f( 1 ) )
+		grade["gain"].setValue( IECore.Color3f( 0.5 ) )
+		assertValues( 0, 0.125, 1 )
+
+	def testBlackInput( self ) :
+
+		c = GafferImage.Constant()
+		c["color"].setValue( IECore.Color4f( 0 ) )
+
+		grade = GafferImage.Grade()
+		grade["in"].setInput( c["out"] )
+		grade["gain"].setValue( IECore.Color3f( 2 ) )
+
+		# Black maps to black, so the shared black tile is passed through.
+		self.assertTrue(
+			grade["out"].channelData( "R", IECore.V2i( 0 ), _copy = False ).isSame(
+				c["out"].channelData( "R", IECore.V2i( 0 ), _copy = False )
+			)
+		)
+
+		# Black no longer maps to black, so the tile must be processed.
+		grade["offset"].setValue( IECore.Color3f( 0.25 ) )
+		self.assertAlmostEqual( grade["out"].channelData( "R", IECore.V2i( 0 ) )[0], 0.25 )
+
+	def testUncacheableInput( self ) :
+
+		c = GafferImage.Constant()
+		c["color"].setValue( IECore.Color4f( 0.25 ) )
+
+		grade = GafferImage.Grade()
+		grade["in"].setInput( c["out"] )
+		grade["gain"].setValue( IECore.Color3f( 2 ) )
+
+		# The input is cached, so the grade must not modify it.
+		self.assertAlmostEqual( grade["out"].channelData( "R", IECore.V2i( 0 ) )[0], 0.5 )
+		self.assertAlmostEqual( c["out"].channelData( "R", IECore.V2i( 0 ), _copy = False )[0], 0.25 )
+
+		# The input isn't cached, so the grade can process the tile in place.
+		c["out"]["channelData"].setFlags( Gaffer.Plug.Flags.Cacheable, False )
+		grade["gain"].setValue( IECore.Color3f( 3 ) )
+		self.assertAlmostEqual( grade["out"].channelData( "R", IECore.V2i( 0 ) )[0], 0.75 )
+		self.assertAlmostEqual( c["out"].channelData( "R", IECore.V2i( 0 ), _copy = False )[0], 0.25 )
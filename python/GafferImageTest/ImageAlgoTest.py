@@ -34,6 +34,7 @@
 #
 ##########################################################################
 
+import os
 import unittest
 
 import IECore
@@ -135,5 +136,28 @@ class ImageAlgoTest( GafferImageTest.ImageTestCase ) :
 		d["out"].image()
 		d["out"].imageHash()
 
+	def testChannelData( self ) :
+
+		r = GafferImage.ImageReader()
+		r["fileName"].setValue( os.path.expandvars( "$GAFFER_ROOT/python/GafferImageTest/images/checkerWithNegativeDataWindow.200x150.exr" ) )
+
+		dataWindow = r["out"]["dataWindow"].getValue()
+		image = r["out"].image()
+		for channelName in [ "R", "G", "B", "A" ] :
+			self.assertEqual(
+				GafferImage.ImageAlgo.channelData( r["out"], channelName, dataWindow ),
+				image[channelName].data
+			)
+
+		# Pixels outside the data window are black.
+
+		window = IECore.Box2i( dataWindow.min - IECore.V2i( 1 ), dataWindow.max + IECore.V2i( 1 ) )
+		data = GafferImage.ImageAlgo.channelData( r["out"], "R", window )
+		self.assertEqual( len( data ), window.size().x * window.size().y )
+		self.assertEqual( data[0], 0 )
+		self.assertEqual( data[-1], 0 )
+
+		self.assertEqual( GafferImage.ImageAlgo.channelData( r["out"], "R", IECore.Box2i() ), IECore.FloatVectorData() )
+
 if __name__ == "__main__":
 	unittest.main()
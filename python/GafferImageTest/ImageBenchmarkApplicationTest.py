@@ -0,0 +1,86 @@
+##########################################################################
+#
+#  Copyright (c) 2017, Image Engine Design Inc. All rights reserved.
+#
+#  Redistribution and use in source and binary forms, with or without
+#  modification, are permitted provided that the following conditions are
+#  met:
+#
+#      * Redistributions of source code must retain the above
+#        copyright notice, this list of conditions and the following
+#        disclaimer.
+#
+#      * Redistributions in binary form must reproduce the above
+#        copyright notice, this list of conditions and the following
+#        disclaimer in the documentation and/or other materials provided with
+#        the distribution.
+#
+#      * Neither the name of John Haddon nor the names of
+#        any other contributors to this software may be used to endorse or
+#        promote products derived from this software without specific prior
+#        written permission.
+#
+#  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+#  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+#  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+#  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+#  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+#  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+#  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+#  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+#  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+#  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+#  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#
+##########################################################################
+
+import os
+import json
+import unittest
+import subprocess32 as subprocess
+
+import GafferImageTest
+
+class ImageBenchmarkApplicationTest( GafferImageTest.ImageTestCase ) :
+
+	def testList( self ) :
+
+		o = subprocess.check_output( [ "gaffer", "imageBenchmark", "-list" ] ).split()
+
+		self.assertTrue( "Grade" in o )
+		self.assertTrue( "Blur/10" in o )
+		self.assertTrue( "ImageWriter/exr" in o )
+
+		o = subprocess.check_output( [ "gaffer", "imageBenchmark", "-list", "-benchmarks", "Merge/*" ] ).split()
+		self.assertTrue( len( o ) )
+		for name in o :
+			self.assertTrue( name.startswith( "Merge/" ) )
+
+	def testJSON( self ) :
+
+		fileName = os.path.join( self.temporaryDirectory(), "results.json" )
+		subprocess.check_output( [
+			"gaffer", "imageBenchmark",
+			"-benchmarks", "Grade", "ImageWriter/exr",
+			"-resolution", "128", "64",
+			"-repeats", "1",
+			"-threadCounts", "1", "2",
+			"-json", fileName
+		] )
+
+		with open( fileName ) as f :
+			results = json.load( f )
+
+		self.assertEqual( results["resolution"], [ 128, 64 ] )
+		self.assertEqual(
+			[ ( r["name"], r["threads"] ) for r in results["results"] ],
+			[ ( "Grade", 1 ), ( "ImageWriter/exr", 1 ), ( "Grade", 2 ), ( "ImageWriter/exr", 2 ) ]
+		)
+
+		for r in results["results"] :
+			self.assertAlmostEqual( r["megapixels"], 128 * 64 / 1000000.0 )
+			self.assertGreater( r["coldMegapixelsPerSecond"], 0 )
+			self.assertGreater( r["warmMegapixelsPerSecond"], 0 )
+
+if __name__ == "__main__":
+	unittest.main()
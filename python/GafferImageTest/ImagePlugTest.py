@@ -37,6 +37,7 @@
 
 import os
 import unittest
+import subprocess32 as subprocess
 
 import IECore
 import Gaffer
@@ -67,6 +68,16 @@ class ImagePlugTest( GafferImageTest.ImageTestCase ) :
 				expectedResult
 			)
 
+	def testTileSizeFromEnvironment( self ) :
+
+		script = "import GafferImage; print GafferImage.ImagePlug.tileSize()"
+		for value, expectedTileSize in ( ( "128", 128 ), ( "256", 256 ), ( "100", 64 ) ) :
+
+			env = os.environ.copy()
+			env["GAFFERIMAGE_TILESIZE"] = value
+			output = subprocess.check_output( [ "gaffer", "env", "python", "-c", script ], env = env, stderr = subprocess.STDOUT )
+			self.assertEqual( int( output.strip().split( "\n" )[-1] ), expectedTileSize )
+
 	def testDefaultChannelNamesMethod( self ) :
 
 		channelNames = GafferImage.ImagePlug()['channelNames'].defaultValue()
@@ -149,5 +160,29 @@ class ImagePlugTest( GafferImageTest.ImageTestCase ) :
 			GafferImage.FormatPlug.setDefaultFormat( c, GafferImage.Format( 200, 300 ) )
 			self.assertEqual( constant["out"].image().displayWindow, IECore.Box2i( IECore.V2i( 0 ), IECore.V2i( 199, 299 ) ) )
 
+	def testHashAndGIL( self ) :
+
+		script = Gaffer.ScriptNode()
+
+		script["constant"] = GafferImage.Constant()
+		script["constant"]["format"].setValue( GafferImage.Format( 512, 512 ) )
+
+		script["expression"] = Gaffer.Expression()
+		script["expression"].setExpression( "parent['constant']['color']['r'] = context.getFrame()" )
+
+		# Hashing the image visits tiles in parallel, and each one
+		# needs to enter Python to evaluate the expression. If the
+		# bindings don't release the GIL we'll end up with a deadlock.
+		# We increment the frame between each call to ensure the
+		# expression result isn't cached.
+		with Gaffer.Context() as c :
+
+			c.setFrame( 1 )
+			script["constant"]["out"].imageHash()
+			c.setFrame( 2 )
+			script["constant"]["out"].channelDataHash( "R", IECore.V2i( 0 ) )
+			c.setFrame( 3 )
+			script["constant"]["color"].hash()
+
 if __name__ == "__main__":
 	unittest.main()
@@ -39,6 +39,7 @@ import unittest
 
 import IECore
 
+import Gaffer
 import GafferTest
 import GafferImage
 import GafferImageTest
@@ -168,6 +169,49 @@ class ImageStatsTest( GafferImageTest.ImageTestCase ) :
 
 		self.assertEqual( s["max"]["r"].getValue(), 0 )
 
+	def testRegionOutsideDataWindow( self ) :
+
+		c = GafferImage.Constant()
+		c["color"].setValue( IECore.Color4f( -1, 2, 0.5, 1 ) )
+
+		crop = GafferImage.Crop()
+		crop["in"].setInput( c["out"] )
+		crop["area"].setValue( IECore.Box2i( IECore.V2i( 10 ), IECore.V2i( 110 ) ) )
+		crop["affectDisplayWindow"].setValue( False )
+
+		s = GafferImage.ImageStats()
+		s["in"].setInput( crop["out"] )
+		s["channels"].setValue( IECore.StringVectorData( [ "R", "G", "B", "A" ] ) )
+
+		# Entirely inside the data window, spanning several tiles.
+		s["regionOfInterest"].setValue( IECore.Box2i( IECore.V2i( 10 ), IECore.V2i( 110 ) ) )
+		self.__assertColour( s["min"].getValue(), IECore.Color4f( -1, 2, 0.5, 1 ) )
+		self.__assertColour( s["max"].getValue(), IECore.Color4f( -1, 2, 0.5, 1 ) )
+		self.__assertColour( s["average"].getValue(), IECore.Color4f( -1, 2, 0.5, 1 ) )
+
+		# Half outside the data window, where pixels are black.
+		s["regionOfInterest"].setValue( IECore.Box2i( IECore.V2i( 10, -90 ), IECore.V2i( 110 ) ) )
+		self.__assertColour( s["min"].getValue(), IECore.Color4f( -1, 0, 0, 0 ) )
+		self.__assertColour( s["max"].getValue(), IECore.Color4f( 0, 2, 0.5, 1 ) )
+		self.__assertColour( s["average"].getValue(), IECore.Color4f( -0.5, 1, 0.25, 0.5 ) )
+
+	def testAllChannelsComputedTogether( self ) :
+
+		r = GafferImage.ImageReader()
+		r["fileName"].setValue( self.__rgbFilePath )
+
+		s = GafferImage.ImageStats()
+		s["in"].setInput( r["out"] )
+		s["channels"].setValue( IECore.StringVectorData( [ "R", "G", "B", "A" ] ) )
+		s["regionOfInterest"].setValue( r["out"]["format"].getValue().getDisplayWindow() )
+
+		with Gaffer.PerformanceMonitor() as m :
+			s["min"].getValue()
+			s["max"].getValue()
+			s["average"].getValue()
+
+		self.assertEqual( m.plugStatistics( s["__allStats"] ).computeCount, 1 )
+
 	def __assertColour( self, colour1, colour2 ) :
 		for i in range( 0, 4 ):
 			self.assertEqual( "%.4f" % colour2[i], "%.4f" % colour1[i] )
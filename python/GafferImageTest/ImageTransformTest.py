@@ -312,5 +312,61 @@ class ImageTransformTest( GafferImageTest.ImageTestCase ) :
 		self.assertEqual( sampler.sample( 0, 1 ), 1 )
 		self.assertEqual( sampler.sample( 1, 1 ), 0 )
 
+	def testConcatenation( self ) :
+
+		r = GafferImage.ImageReader()
+		r["fileName"].setValue( self.fileName )
+
+		t1 = GafferImage.ImageTransform()
+		t1["in"].setInput( r["out"] )
+		t1["transform"]["scale"].setValue( IECore.V2f( 0.5 ) )
+
+		t2 = GafferImage.ImageTransform()
+		t2["in"].setInput( t1["out"] )
+		t2["transform"]["scale"].setValue( IECore.V2f( 2 ) )
+
+		# A scale down followed by a scale up would lose detail
+		# if filtered twice, but when concatenated the two cancel
+		# out to give us back the original image.
+
+		self.assertImagesEqual( t2["out"], r["out"], maxDifference = 0.0001, ignoreDataWindow = True )
+
+		t2["concatenate"].setValue( False )
+		with self.assertRaises( AssertionError ) :
+			self.assertImagesEqual( t2["out"], r["out"], maxDifference = 0.0001, ignoreDataWindow = True )
+
+		# Concatenated rotations should match a single rotation.
+
+		t2["concatenate"].setValue( True )
+		t1["transform"]["scale"].setValue( IECore.V2f( 1 ) )
+		t1["transform"]["rotate"].setValue( 20 )
+		t2["transform"]["scale"].setValue( IECore.V2f( 1 ) )
+		t2["transform"]["rotate"].setValue( 25 )
+
+		t3 = GafferImage.ImageTransform()
+		t3["in"].setInput( r["out"] )
+		t3["transform"]["rotate"].setValue( 45 )
+
+		self.assertImagesEqual( t2["out"], t3["out"], maxDifference = 0.0001 )
+
+		# Disabling the upstream transform should remove its
+		# contribution.
+
+		t1["enabled"].setValue( False )
+		t3["transform"]["rotate"].setValue( 25 )
+		self.assertImagesEqual( t2["out"], t3["out"], maxDifference = 0.0001 )
+
+		# And we mustn't concatenate through other nodes.
+
+		t1["enabled"].setValue( True )
+		g = GafferImage.Grade()
+		g["in"].setInput( t1["out"] )
+		g["multiply"].setValue( IECore.Color4f( 0.5 ) )
+		t2["in"].setInput( g["out"] )
+		t3["in"].setInput( g["out"] )
+		t3["transform"]["rotate"].setValue( 25 )
+		t3["concatenate"].setValue( False )
+		self.assertImagesEqual( t2["out"], t3["out"] )
+
 if __name__ == "__main__":
 	unittest.main()
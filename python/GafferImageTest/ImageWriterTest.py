@@ -987,6 +987,76 @@ class ImageWriterTest( GafferImageTest.ImageTestCase ) :
 
 		self.assertEqual( r["out"]["metadata"].getValue()["test"], m["out"]["metadata"].getValue()["test"] )
 
+	def testLargeImageRoundTrip( self ) :
+
+		# Large enough to need several blocks of scanlines
+		# and several rows of tiles to be written, with a data
+		# window that doesn't align with the tiles.
+
+		r = GafferImage.ImageReader()
+		r["fileName"].setValue( self.__rgbFilePath + ".exr" )
+
+		resize = GafferImage.Resize()
+		resize["in"].setInput( r["out"] )
+		resize["format"].setValue( GafferImage.Format( 317, 701 ) )
+
+		for mode in ( GafferImage.ImageWriter.Mode.Scanline, GafferImage.ImageWriter.Mode.Tile ) :
+
+			w = GafferImage.ImageWriter()
+			w["in"].setInput( resize["out"] )
+			w["fileName"].setValue( self.__testFile( "large%d" % mode, "RGBA", "exr" ) )
+			w["openexr"]["mode"].setValue( mode )
+			w["openexr"]["compression"].setValue( "zip" )
+			w["openexr"]["dataType"].setValue( "float" )
+			w["task"].execute()
+
+			written = GafferImage.ImageReader()
+			written["fileName"].setValue( w["fileName"].getValue() )
+
+			self.assertImagesEqual( written["out"], resize["out"], ignoreMetadata = True )
+
+	def testAdditionalOutputs( self ) :
+
+		r = GafferImage.ImageReader()
+		r["fileName"].setValue( self.__rgbFilePath + ".exr" )
+
+		w = GafferImage.ImageWriter()
+		w["in"].setInput( r["out"] )
+		w["fileName"].setValue( self.__testFile( "main", "RGBA", "exr" ) )
+		w["openexr"]["dataType"].setValue( "float" )
+
+		o = Gaffer.ValuePlug( "proxy", flags = Gaffer.Plug.Flags.Default | Gaffer.Plug.Flags.Dynamic )
+		o["fileName"] = Gaffer.StringPlug( flags = Gaffer.Plug.Flags.Default | Gaffer.Plug.Flags.Dynamic )
+		o["channels"] = GafferImage.ChannelMaskPlug( flags = Gaffer.Plug.Flags.Default | Gaffer.Plug.Flags.Dynamic, defaultValue = IECore.StringVectorData( [ "R" ] ) )
+		w["additionalOutputs"]["proxy"] = o
+		o["fileName"].setValue( self.__testFile( "proxy", "R", "exr" ) )
+
+		h = w.hash( Gaffer.Context() )
+		o["channels"].setValue( IECore.StringVectorData( [ "G" ] ) )
+		self.assertNotEqual( w.hash( Gaffer.Context() ), h )
+
+		w["task"].execute()
+
+		self.assertTrue( os.path.isfile( w["fileName"].getValue() ) )
+		self.assertTrue( os.path.isfile( o["fileName"].getValue() ) )
+
+		main = GafferImage.ImageReader()
+		main["fileName"].setValue( w["fileName"].getValue() )
+		self.assertImagesEqual( main["out"], r["out"], ignoreMetadata = True )
+
+		proxy = GafferImage.ImageReader()
+		proxy["fileName"].setValue( o["fileName"].getValue() )
+		self.assertEqual( proxy["out"]["channelNames"].getValue(), IECore.StringVectorData( [ "G" ] ) )
+
+		# Copy/paste should preserve the additional output.
+
+		s = Gaffer.ScriptNode()
+		s["w"] = w
+		s2 = Gaffer.ScriptNode()
+		s2.execute( s.serialise() )
+		self.assertEqual( s2["w"]["additionalOutputs"]["proxy"]["fileName"].getValue(), o["fileName"].getValue() )
+		self.assertEqual( s2["w"]["additionalOutputs"]["proxy"]["channels"].getValue(), IECore.StringVectorData( [ "G" ] ) )
+
 	def __testFile( self, mode, channels, ext ) :
 
 		return self.temporaryDirectory() + "/test." + channels + "." + str( mode ) + "." + str( ext )
@@ -181,5 +181,37 @@ class LUTTest( GafferImageTest.ImageTestCase ) :
 		self.assertEqual( i["out"]["metadata"].getValue(), o["out"]["metadata"].getValue() )
 		self.assertEqual( i["out"]["channelNames"].getValue(), o["out"]["channelNames"].getValue() )
 
+	def testFileModification( self ) :
+
+		def writeLUT( fileName, values, modificationTime ) :
+
+			with open( fileName, "w" ) as f :
+				f.write( "Version 1\nFrom 0 1\nLength %d\nComponents 1\n{\n" % len( values ) )
+				for v in values :
+					f.write( "%f\n" % v )
+				f.write( "}\n" )
+
+			os.utime( fileName, ( modificationTime, modificationTime ) )
+
+		fileName = self.temporaryDirectory() + "/test.spi1d"
+		writeLUT( fileName, [ 0, 1 ], 1000 )
+
+		c = GafferImage.Constant()
+		c["color"].setValue( IECore.Color4f( 0.25, 0.25, 0.25, 1 ) )
+
+		o = GafferImage.LUT()
+		o["in"].setInput( c["out"] )
+		o["fileName"].setValue( fileName )
+		o["interpolation"].setValue( GafferImage.LUT.Interpolation.Linear )
+
+		self.assertAlmostEqual( o["out"].channelData( "R", IECore.V2i( 0 ) )[0], 0.25, places = 5 )
+
+		# Modifying the file should be enough to get new results,
+		# without needing to change any plugs. We must clear the
+		# hash cache though, since it doesn't know about files.
+		writeLUT( fileName, [ 0.5, 0.5 ], 2000 )
+		Gaffer.ValuePlug.clearHashCache()
+		self.assertAlmostEqual( o["out"].channelData( "R", IECore.V2i( 0 ) )[0], 0.5, places = 5 )
+
 if __name__ == "__main__":
 	unittest.main()
@@ -446,5 +446,72 @@ class MergeTest( GafferImageTest.ImageTestCase ) :
 
 		self.assertEqual( m["out"]["dataWindow"].getValue(), a["out"]["dataWindow"].getValue() )
 
+	def testBlackInputs( self ) :
+
+		a = GafferImage.Constant()
+		a["color"].setValue( IECore.Color4f( 0 ) )
+
+		b = GafferImage.Constant()
+		b["color"].setValue( IECore.Color4f( 0 ) )
+
+		m = GafferImage.Merge()
+		m["in"][0].setInput( a["out"] )
+		m["in"][1].setInput( b["out"] )
+
+		# The shared black tile should be passed straight through.
+		for operation in ( GafferImage.Merge.Operation.Over, GafferImage.Merge.Operation.Add, GafferImage.Merge.Operation.Multiply ) :
+			m["operation"].setValue( operation )
+			self.assertTrue(
+				m["out"].channelData( "R", IECore.V2i( 0 ), _copy = False ).isSame(
+					a["out"].channelData( "R", IECore.V2i( 0 ), _copy = False )
+				)
+			)
+
+		# Only the alpha is black, so compositing must still take place.
+		b["color"].setValue( IECore.Color4f( 0.5, 0, 0, 0 ) )
+		m["operation"].setValue( GafferImage.Merge.Operation.Add )
+		self.assertEqual( m["out"].channelData( "R", IECore.V2i( 0 ) )[0], 0.5 )
+
+	def testOpaqueLayersOccludeOthers( self ) :
+
+		a = GafferImage.Constant()
+		a["color"].setValue( IECore.Color4f( 0.1, 0.2, 0.3, 0.5 ) )
+
+		b = GafferImage.Constant()
+		b["color"].setValue( IECore.Color4f( 0.4, 0.5, 0.6, 1 ) )
+
+		m = GafferImage.Merge()
+		m["in"][0].setInput( a["out"] )
+		m["in"][1].setInput( b["out"] )
+
+		# With Over, the opaque upper layer hides the lower one, so
+		# changes to the lower layer need not affect the result.
+
+		m["operation"].setValue( GafferImage.Merge.Operation.Over )
+		h = m["out"].channelDataHash( "R", IECore.V2i( 0 ) )
+		self.assertAlmostEqual( m["out"].channelData( "R", IECore.V2i( 0 ) )[0], 0.4, places = 6 )
+
+		a["color"]["r"].setValue( 0.9 )
+		self.assertEqual( m["out"].channelDataHash( "R", IECore.V2i( 0 ) ), h )
+		self.assertAlmostEqual( m["out"].channelData( "R", IECore.V2i( 0 ) )[0], 0.4, places = 6 )
+
+		# With Under, it is the lower layer that must be opaque to
+		# hide the upper one.
+
+		m["operation"].setValue( GafferImage.Merge.Operation.Under )
+		self.assertAlmostEqual( m["out"].channelData( "R", IECore.V2i( 0 ) )[0], 0.9 + 0.4 * 0.5, places = 6 )
+
+		m["in"][0].setInput( b["out"] )
+		m["in"][1].setInput( a["out"] )
+		h = m["out"].channelDataHash( "R", IECore.V2i( 0 ) )
+		a["color"]["r"].setValue( 0.1 )
+		self.assertEqual( m["out"].channelDataHash( "R", IECore.V2i( 0 ) ), h )
+		self.assertAlmostEqual( m["out"].channelData( "R", IECore.V2i( 0 ) )[0], 0.4, places = 6 )
+
+		# Partially transparent layers must still be composited.
+
+		b["color"]["a"].setValue( 0.5 )
+		self.assertAlmostEqual( m["out"].channelData( "R", IECore.V2i( 0 ) )[0], 0.4 + 0.1 * 0.5, places = 6 )
+
 if __name__ == "__main__":
 	unittest.main()
@@ -81,5 +81,21 @@ class ObjectToImageTest( GafferImageTest.ImageTestCase ) :
 			n["out"].channelDataHash( "R", IECore.V2i( GafferImage.ImagePlug.tileSize() ) )
 		)
 
+	def testTilesOutsideDataWindow( self ) :
+
+		n = GafferImage.ObjectToImage()
+		n["object"].setValue( IECore.Reader.create( self.negFileName ).read() )
+
+		dataWindow = n["out"]["dataWindow"].getValue()
+		tileSize = GafferImage.ImagePlug.tileSize()
+
+		for tileOrigin in (
+			GafferImage.ImagePlug.tileOrigin( dataWindow.min ) - IECore.V2i( tileSize ),
+			GafferImage.ImagePlug.tileOrigin( dataWindow.max ) + IECore.V2i( tileSize ),
+		) :
+			self.assertEqual( n["out"].channelData( "R", tileOrigin ), GafferImage.ImagePlug.blackTile() )
+
+		self.assertEqual( n["out"].channelData( "Z", GafferImage.ImagePlug.tileOrigin( dataWindow.min ) ), GafferImage.ImagePlug.blackTile() )
+
 if __name__ == "__main__":
 	unittest.main()
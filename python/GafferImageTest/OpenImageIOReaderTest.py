@@ -168,10 +168,22 @@ class OpenImageIOReaderTest( GafferImageTest.ImageTestCase ) :
 			t1 = n["out"]["channelData"].getValue( _copy=False )
 			t2 = n["out"]["channelData"].getValue( _copy=False )
 
-		# we don't want the separate computations to result in the
-		# same value, because the ImageReader has its own cache in
-		# OIIO, so doing any caching on top of that would be wasteful.
-		self.failIf( t1.isSame( t2 ) )
+		# The channel data itself isn't cached, but is handed out
+		# directly from the batch of channels read for the tile, so
+		# we get the same value back without any copying.
+		self.assertFalse( n["out"]["channelData"].getFlags( Gaffer.Plug.Flags.Cacheable ) )
+		self.assertTrue( t1.isSame( t2 ) )
+
+	def testChannelsReadTogether( self ) :
+
+		n = GafferImage.OpenImageIOReader()
+		n["fileName"].setValue( self.circlesExrFileName )
+
+		with Gaffer.PerformanceMonitor() as m :
+			for channelName in n["out"]["channelNames"].getValue() :
+				n["out"].channelData( channelName, IECore.V2i( 0 ) )
+
+		self.assertEqual( m.plugStatistics( n["__tileBatch"] ).computeCount, 1 )
 
 	def testUnspecifiedFilename( self ) :
 
@@ -511,5 +523,101 @@ class OpenImageIOReaderTest( GafferImageTest.ImageTestCase ) :
 		GafferImage.OpenImageIOReader.setCacheMemoryLimit( 100 * 1024 * 1024 ) # 100 megs
 		self.assertEqual( GafferImage.OpenImageIOReader.getCacheMemoryLimit(), 100 * 1024 * 1024 )
 
+	def testDirectReads( self ) :
+
+		self.addCleanup( GafferImage.OpenImageIOReader.setDirectReadsEnabled, GafferImage.OpenImageIOReader.getDirectReadsEnabled() )
+
+		# Write a tiled file with tiles matching our own, so
+		# that it qualifies for direct reads.
+
+		r = GafferImage.OpenImageIOReader()
+		r["fileName"].setValue( self.fileName )
+
+		resize = GafferImage.Resize()
+		resize["in"].setInput( r["out"] )
+		resize["format"].setValue( GafferImage.Format( 128, 128 ) )
+
+		w = GafferImage.ImageWriter()
+		w["in"].setInput( resize["out"] )
+		w["fileName"].setValue( self.temporaryDirectory() + "/tiled.exr" )
+		w["openexr"]["mode"].setValue( GafferImage.ImageWriter.Mode.Tile )
+		w["task"].execute()
+
+		# Reading directly should give identical results to
+		# reading via the OIIO cache.
+
+		cached = GafferImage.OpenImageIOReader()
+		cached["fileName"].setValue( w["fileName"].getValue() )
+		GafferImage.OpenImageIOReader.setDirectReadsEnabled( False )
+		expected = cached["out"].image()
+
+		direct = GafferImage.OpenImageIOReader()
+		direct["fileName"].setValue( w["fileName"].getValue() )
+		GafferImage.OpenImageIOReader.setDirectReadsEnabled( True )
+		self.assertTrue( GafferImage.OpenImageIOReader.getDirectReadsEnabled() )
+		self.assertEqual( direct["out"].image(), expected )
+
+		# Files which don't qualify should fall back to the cache.
+
+		untiled = GafferImage.OpenImageIOReader()
+		untiled["fileName"].setValue( self.fileName )
+		self.assertImagesEqual( untiled["out"], r["out"] )
+
+	def testReadAhead( self ) :
+
+		self.addCleanup( GafferImage.OpenImageIOReader.setReadAheadFrames, GafferImage.OpenImageIOReader.getReadAheadFrames() )
+
+		for i in range( 1, 6 ) :
+			shutil.copyfile( self.fileName, self.temporaryDirectory() + "/readAhead.%d.exr" % i )
+
+		reader = GafferImage.OpenImageIOReader()
+		reader["fileName"].setValue( self.temporaryDirectory() + "/readAhead.#.exr" )
+
+		GafferImage.OpenImageIOReader.setReadAheadFrames( 2 )
+		self.assertEqual( GafferImage.OpenImageIOReader.getReadAheadFrames(), 2 )
+
+		# Reading in order, and out of order, should give the
+		# same results as reading the frames directly.
+
+		for frame in [ 1, 2, 3, 4, 5, 3, 1 ] :
+			with Gaffer.Context() as c :
+				c.setFrame( frame )
+				image = reader["out"].image()
+			r = GafferImage.OpenImageIOReader()
+			r["fileName"].setValue( self.temporaryDirectory() + "/readAhead.%d.exr" % frame )
+			self.assertEqual( image, r["out"].image() )
+
+		GafferImage.OpenImageIOReader.setReadAheadFrames( -1 )
+		self.assertEqual( GafferImage.OpenImageIOReader.getReadAheadFrames(), 0 )
+
+	def testProxyLevel( self ) :
+
+		reader = GafferImage.OpenImageIOReader()
+		reader["fileName"].setValue( self.fileName )
+
+		format = reader["out"]["format"].getValue()
+		dataWindow = reader["out"]["dataWindow"].getValue()
+		image = reader["out"].image()
+		tileHash = reader["out"].channelDataHash( "R", IECore.V2i( 0 ) )
+
+		with Gaffer.Context() as c :
+
+			GafferImage.FormatPlug.setProxyLevel( c, 1 )
+
+			self.assertEqual( reader["out"]["format"].getValue(), GafferImage.FormatPlug.proxyFormat( format, 1 ) )
+			self.assertEqual( reader["out"]["dataWindow"].getValue(), GafferImage.FormatPlug.proxyWindow( dataWindow, 1 ) )
+			self.assertNotEqual( reader["out"].channelDataHash( "R", IECore.V2i( 0 ) ), tileHash )
+
+			proxyImage = reader["out"].image()
+
+		# Each proxy pixel is the average of the four pixels it covers,
+		# so the total of each channel is preserved.
+		for channelName in image.keys() :
+			self.assertAlmostEqual(
+				sum( proxyImage[channelName].data ) * 4,
+				sum( image[channelName].data ),
+				delta = 0.01 * sum( image[channelName].data )
+			)
+
 if __name__ == "__main__":
 	unittest.main()
@@ -179,6 +179,56 @@ class ResampleTest( GafferImageTest.ImageTestCase ) :
 		r["filterWidth"].setValue( IECore.V2f( 10 ) )
 		self.assertEqual( r["out"]["dataWindow"].getValue(), IECore.Box2i( d.min - IECore.V2i( 5 ), d.max + IECore.V2i( 5 ) ) )
 
+	def testFilterWeightsSharedBetweenTiles( self ) :
+
+		c = GafferImage.Constant()
+		c["format"].setValue( GafferImage.Format( 100, 100 ) )
+
+		r = GafferImage.Resample()
+		r["matrix"].setValue( IECore.M33f().scale( IECore.V2f( 2 ) ) )
+		r["filter"].setValue( "lanczos3" )
+		r["in"].setInput( c["out"] )
+
+		with Gaffer.PerformanceMonitor() as m :
+			for channelName in [ "R", "G", "B", "A" ] :
+				for y in range( 0, 4 ) :
+					for x in range( 0, 4 ) :
+						r["out"].channelData( channelName, IECore.V2i( x, y ) * GafferImage.ImagePlug.tileSize() )
+
+		# One computation per tile column and per tile row, regardless
+		# of the number of channels.
+		self.assertEqual( m.plugStatistics( r["__horizontalWeights"] ).computeCount, 4 )
+		self.assertEqual( m.plugStatistics( r["__verticalWeights"] ).computeCount, 4 )
+
+	def testBoxDownsize( self ) :
+
+		reader = GafferImage.ImageReader()
+		reader["fileName"].setValue( os.path.dirname( __file__ ) + "/images/resamplePatterns.exr" )
+
+		r = GafferImage.Resample()
+		r["in"].setInput( reader["out"] )
+		r["filter"].setValue( "box" )
+
+		reference = GafferImage.Resample()
+		reference["in"].setInput( reader["out"] )
+		reference["filter"].setValue( "box" )
+		reference["matrix"].setInput( r["matrix"] )
+		reference["boundingMode"].setInput( r["boundingMode"] )
+		# Forces the general purpose code path.
+		reference["debug"].setValue( GafferImage.Resample.Debug.SinglePass )
+
+		for scale, translate in [
+			( 0.5, 0 ),
+			( 0.25, 0 ),
+			( 1 / 3.0, 0 ),
+			( 0.5, 5 ),
+			( 0.25, -3 ),
+		] :
+			for boundingMode in ( GafferImage.Sampler.BoundingMode.Black, GafferImage.Sampler.BoundingMode.Clamp ) :
+				r["matrix"].setValue( IECore.M33f().translate( IECore.V2f( translate ) ).scale( IECore.V2f( scale ) ) )
+				r["boundingMode"].setValue( boundingMode )
+				self.assertImagesEqual( r["out"], reference["out"], maxDifference = 1e-5 )
+
 	def __matrix( self, inputDataWindow, outputDataWindow ) :
 
 		return IECore.M33f()
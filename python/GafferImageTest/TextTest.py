@@ -167,5 +167,25 @@ class TextTest( GafferImageTest.ImageTestCase ) :
 		self.assertImageHashesEqual( t1["out"], t2["out"] )
 		self.assertImagesEqual( t1["out"], t2["out"] )
 
+	def testWholePixelTranslation( self ) :
+
+		# Glyphs are cached independently of any whole pixel
+		# translation, so translating should give exactly the
+		# same result as offsetting the untranslated text.
+
+		text = GafferImage.Text()
+		text["text"].setValue( "abc abc" )
+		text["transform"]["translate"].setValue( IECore.V2f( 0.25, 0.5 ) )
+
+		offset = GafferImage.Offset()
+		offset["in"].setInput( text["out"] )
+		offset["offset"].setValue( IECore.V2i( 70, -33 ) )
+
+		translatedText = GafferImage.Text()
+		translatedText["text"].setValue( "abc abc" )
+		translatedText["transform"]["translate"].setValue( IECore.V2f( 70.25, -32.5 ) )
+
+		self.assertImagesEqual( offset["out"], translatedText["out"] )
+
 if __name__ == "__main__":
 	unittest.main()
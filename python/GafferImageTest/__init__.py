@@ -84,6 +84,7 @@ from TextTest import TextTest
 from OpenColorIOTransformTest import OpenColorIOTransformTest
 from UVWarpTest import UVWarpTest
 from MirrorTest import MirrorTest
+from ImageBenchmarkApplicationTest import ImageBenchmarkApplicationTest
 
 if __name__ == "__main__":
 	import unittest
@@ -91,7 +91,25 @@ Gaffer.Metadata.registerNode(
 			which the blur will bleed onto.
 			"""
 
-		]
+		],
+
+		"mode" : [
+
+			"description",
+			"""
+			The method used to compute the blur. Accurate uses a true
+			gaussian filter, and takes longer as the radius increases.
+			Fast approximates the gaussian with a sequence of box filters,
+			taking the same time regardless of the radius, which makes it
+			preferable for very large blurs.
+			""",
+
+			"preset:Accurate", GafferImage.Blur.Mode.Accurate,
+			"preset:Fast", GafferImage.Blur.Mode.Fast,
+
+			"plugValueWidget:type", "GafferUI.PresetsPlugValueWidget",
+
+		],
 
 	}
 
@@ -87,6 +87,20 @@ Gaffer.Metadata.registerNode(
 
 		) ),
 
+		"concatenate" : [
+
+			"description",
+			"""
+			Combines the transform with that of an upstream
+			ImageTransform connected directly to the input, so
+			that the image is only filtered once. This gives a
+			sharper result and is quicker to compute. Turn this
+			off to filter the result of the upstream transform
+			independently.
+			""",
+
+		],
+
 	}
 
 )
@@ -35,6 +35,9 @@
 ##########################################################################
 
 import functools
+import math
+import threading
+import weakref
 
 import IECore
 
@@ -42,6 +45,9 @@ import Gaffer
 import GafferUI
 import GafferImageUI
 
+QtCore = GafferUI._qtImport( "QtCore" )
+QtGui = GafferUI._qtImport( "QtGui" )
+
 ##########################################################################
 # Metadata registration.
 ##########################################################################
@@ -110,6 +116,37 @@ Gaffer.Metadata.registerNode(
 
 		],
 
+		"playbackCacheMemoryLimit" : [
+
+			"description",
+			"""
+			The amount of memory (in megabytes) used to cache
+			frames for realtime playback. Frames within the
+			script's frame range are computed in the background
+			whenever the UI is idle. A value of 0 disables the
+			cache.
+			""",
+
+			"label", "Cache (MB)",
+
+		],
+
+		"scopes" : [
+
+			"description",
+			"""
+			Shows a window containing histograms, a waveform and a
+			vectorscope for the image, along with its minimum, maximum
+			and average colour. These are measured before the exposure,
+			gamma and display transform are applied, and are updated
+			in the background as the image changes.
+			""",
+
+			"plugValueWidget:type", "GafferImageUI.ImageViewUI._ScopesPlugValueWidget",
+			"label", "",
+
+		],
+
 		"colorInspector" : [
 
 			"plugValueWidget:type", "GafferImageUI.ImageViewUI._ColorInspectorPlugValueWidget",
@@ -327,3 +364,277 @@ class _SoloChannelPlugValueWidget( GafferUI.PlugValueWidget ) :
 	def __setValue( self, value, *unused ) :
 
 		self.getPlug().setValue( value )
+
+##########################################################################
+# _ScopesPlugValueWidget
+##########################################################################
+
+class _ScopesPlugValueWidget( GafferUI.PlugValueWidget ) :
+
+	def __init__( self, plug, **kw ) :
+
+		self.__button = GafferUI.Button( "Scopes", hasFrame = False )
+
+		GafferUI.PlugValueWidget.__init__( self, self.__button, plug, **kw )
+
+		self.__clickedConnection = self.__button.clickedSignal().connect( Gaffer.WeakMethod( self.__clicked ) )
+		self.__parentChangedConnection = self.parentChangedSignal().connect( Gaffer.WeakMethod( self.__parentChanged ) )
+		self.__window = None
+
+		self._updateFromPlug()
+
+	def _updateFromPlug( self ) :
+
+		with self.getContext() :
+			enabled = self.getPlug().getValue()
+
+		if enabled and self.__window is None :
+			parentWindow = self.ancestor( GafferUI.Window )
+			if parentWindow is None :
+				# We'll be called again when we're parented.
+				return
+			self.__window = _ScopesWindow( self.getPlug().node() )
+			self.__windowClosedConnection = self.__window.closedSignal().connect( Gaffer.WeakMethod( self.__windowClosed ) )
+			parentWindow.addChildWindow( self.__window, removeOnClose = True )
+			self.__window.setVisible( True )
+		elif not enabled and self.__window is not None :
+			self.__window.close()
+
+	def __parentChanged( self, widget ) :
+
+		self._updateFromPlug()
+
+	def __clicked( self, button ) :
+
+		self.getPlug().setValue( not self.getPlug().getValue() )
+
+	def __windowClosed( self, window ) :
+
+		self.__window = None
+		self.__windowClosedConnection = None
+		self.getPlug().setValue( False )
+
+class _ScopesWindow( GafferUI.Window ) :
+
+	def __init__( self, view, **kw ) :
+
+		GafferUI.Window.__init__( self, "Scopes", borderWidth = 8, **kw )
+
+		self.__scopes = view.imageScopes()
+
+		with self :
+			with GafferUI.ListContainer( GafferUI.ListContainer.Orientation.Vertical, spacing = 8 ) :
+				with GafferUI.ListContainer( GafferUI.ListContainer.Orientation.Horizontal, spacing = 8 ) :
+					self.__histogram = _HistogramWidget()
+					self.__waveform = _WaveformWidget()
+					self.__vectorscope = _VectorscopeWidget()
+				self.__statsLabel = GafferUI.Label()
+
+		self.__updater = _ScopesUpdater( view, Gaffer.WeakMethod( self.__scopesChanged ) )
+		self.__scopesChanged()
+
+	def __scopesChanged( self ) :
+
+		for widget in ( self.__histogram, self.__waveform, self.__vectorscope ) :
+			widget.setScopes( self.__scopes )
+
+		self.__statsLabel.setText(
+			"<b>Min : %s&nbsp;&nbsp;&nbsp;Max : %s&nbsp;&nbsp;&nbsp;Average : %s</b>" % tuple(
+				"%.3f %.3f %.3f %.3f" % ( c.r, c.g, c.b, c.a )
+				for c in ( self.__scopes.minimum(), self.__scopes.maximum(), self.__scopes.average() )
+			)
+		)
+
+## Runs ImageScopes.update() on a background thread whenever the
+# view requests a render, calling `changedCallback` on the UI thread
+# when the results have changed. Requests that arrive while an update
+# is running are coalesced into a single follow-up update.
+class _ScopesUpdater( object ) :
+
+	def __init__( self, view, changedCallback ) :
+
+		self.__scopes = view.imageScopes()
+		self.__changedCallback = changedCallback
+		self.__running = False
+		self.__pending = False
+
+		self.__renderRequestConnection = view.viewportGadget().renderRequestSignal().connect( Gaffer.WeakMethod( self.__renderRequest ) )
+		self.__update()
+
+	def __renderRequest( self, gadget ) :
+
+		if self.__running :
+			self.__pending = True
+		else :
+			self.__update()
+
+	def __update( self ) :
+
+		self.__running = True
+		self.__pending = False
+
+		thread = threading.Thread(
+			target = IECore.curry( _ScopesUpdater.__backgroundUpdate, weakref.ref( self ), self.__scopes )
+		)
+		thread.daemon = True
+		thread.start()
+
+	@staticmethod
+	def __backgroundUpdate( selfWeakRef, scopes ) :
+
+		try :
+			changed = scopes.update()
+		except :
+			# Errors will be reported by the viewer itself.
+			changed = False
+
+		GafferUI.EventLoop.executeOnUIThread( IECore.curry( _ScopesUpdater.__updateFinished, selfWeakRef, changed ) )
+
+	@staticmethod
+	def __updateFinished( selfWeakRef, changed ) :
+
+		self = selfWeakRef()
+		if self is None :
+			return
+
+		self.__running = False
+		if changed :
+			self.__changedCallback()
+		if self.__pending :
+			self.__update()
+
+class _ScopeWidget( GafferUI.Widget ) :
+
+	def __init__( self, size, **kw ) :
+
+		GafferUI.Widget.__init__( self, _QtScopeWidget( size ), **kw )
+
+	def setScopes( self, scopes ) :
+
+		raise NotImplementedError
+
+	def _draw( self, painter ) :
+
+		raise NotImplementedError
+
+	# Converts a 2d array of counts into an image, using a logarithmic
+	# scale so that sparsely populated bins remain visible.
+	@staticmethod
+	def _countsToImage( counts, width, height, color ) :
+
+		image = QtGui.QImage( width, height, QtGui.QImage.Format_RGB32 )
+		maxCount = max( counts )
+		scale = 1.0 / math.log( 1 + maxCount ) if maxCount else 0
+		for y in range( 0, height ) :
+			row = ( height - 1 - y ) * width
+			for x in range( 0, width ) :
+				v = math.log( 1 + counts[row + x] ) * scale
+				image.setPixel( x, y, QtGui.qRgb( int( color[0] * v ), int( color[1] * v ), int( color[2] * v ) ) )
+
+		return image
+
+class _HistogramWidget( _ScopeWidget ) :
+
+	__colors = (
+		( GafferImageUI.ImageScopes.Channel.Red, QtGui.QColor( 240, 60, 60 ) ),
+		( GafferImageUI.ImageScopes.Channel.Green, QtGui.QColor( 60, 240, 60 ) ),
+		( GafferImageUI.ImageScopes.Channel.Blue, QtGui.QColor( 60, 60, 240 ) ),
+		( GafferImageUI.ImageScopes.Channel.Luminance, QtGui.QColor( 220, 220, 220 ) ),
+	)
+
+	def __init__( self, **kw ) :
+
+		_ScopeWidget.__init__( self, IECore.V2i( 256, 128 ), **kw )
+
+		self.__histograms = []
+
+	def setScopes( self, scopes ) :
+
+		self.__histograms = [ ( color, scopes.histogram( channel ) ) for channel, color in self.__colors ]
+		self._qtWidget().update()
+
+	def _draw( self, painter ) :
+
+		if not self.__histograms :
+			return
+
+		width, height = float( self._qtWidget().width() ), float( self._qtWidget().height() )
+		maxCount = max( max( h ) for c, h in self.__histograms )
+		if not maxCount :
+			return
+
+		for color, histogram in self.__histograms :
+			painter.setPen( color )
+			binWidth = width / len( histogram )
+			points = [
+				QtCore.QPointF( ( i + 0.5 ) * binWidth, height - height * count / maxCount )
+				for i, count in enumerate( histogram )
+			]
+			painter.drawPolyline( QtGui.QPolygonF( points ) )
+
+class _WaveformWidget( _ScopeWidget ) :
+
+	def __init__( self, **kw ) :
+
+		_ScopeWidget.__init__( self, IECore.V2i( 256, 128 ), **kw )
+
+		self.__image = None
+
+	def setScopes( self, scopes ) :
+
+		self.__image = self._countsToImage(
+			scopes.waveform(),
+			GafferImageUI.ImageScopes.waveformWidth,
+			GafferImageUI.ImageScopes.waveformHeight,
+			( 120, 255, 120 )
+		)
+		self._qtWidget().update()
+
+	def _draw( self, painter ) :
+
+		if self.__image is not None :
+			painter.drawImage( self._qtWidget().rect(), self.__image )
+
+class _VectorscopeWidget( _ScopeWidget ) :
+
+	def __init__( self, **kw ) :
+
+		_ScopeWidget.__init__( self, IECore.V2i( 128, 128 ), **kw )
+
+		self.__image = None
+
+	def setScopes( self, scopes ) :
+
+		size = GafferImageUI.ImageScopes.vectorscopeSize
+		self.__image = self._countsToImage( scopes.vectorscope(), size, size, ( 255, 255, 255 ) )
+		self._qtWidget().update()
+
+	def _draw( self, painter ) :
+
+		if self.__image is None :
+			return
+
+		rect = self._qtWidget().rect()
+		painter.drawImage( rect, self.__image )
+
+		# Draw a graticule through the neutral axis.
+		painter.setPen( QtGui.QColor( 80, 80, 80 ) )
+		painter.drawLine( rect.center().x(), rect.top(), rect.center().x(), rect.bottom() )
+		painter.drawLine( rect.left(), rect.center().y(), rect.right(), rect.center().y() )
+
+# qt implementation class
+class _QtScopeWidget( QtGui.QWidget ) :
+
+	def __init__( self, size, parent = None ) :
+
+		QtGui.QWidget.__init__( self, parent )
+
+		self.setFixedSize( size.x, size.y )
+
+	def paintEvent( self, event ) :
+
+		painter = QtGui.QPainter( self )
+		painter.fillRect( self.rect(), QtGui.QColor( 0, 0, 0 ) )
+
+		owner = GafferUI.Widget._owner( self )
+		owner._draw( painter )
@@ -93,6 +93,23 @@ Gaffer.Metadata.registerNode(
 
 		],
 
+		"additionalOutputs" : [
+
+			"description",
+			"""
+			Additional files to be written from the same input. Each
+			child has its own "fileName" and "channels" plugs, and is
+			written using the format settings for its file type. All
+			the files are written from a single pass over the input,
+			so each tile is only computed once. This is useful for
+			writing review proxies alongside the main output.
+			""",
+
+			"plugValueWidget:type", "GafferUI.LayoutPlugValueWidget",
+			"layout:section", "Additional Outputs",
+
+		],
+
 		"out" : [
 
 			"description",
@@ -77,6 +77,19 @@ class ImageGadgetTest( GafferUITest.TestCase ) :
 		g.setImage( c["out"] )
 		self.assertTrue( g.getImage().isSame( c["out"] ) )
 
+	def testFrameCacheMemoryLimit( self ) :
+
+		g = GafferImageUI.ImageGadget()
+		self.assertEqual( g.getFrameCacheMemoryLimit(), 0 )
+		self.assertEqual( g.frameCacheMemoryUsage(), 0 )
+
+		g.setFrameCacheMemoryLimit( 1024 * 1024 )
+		self.assertEqual( g.getFrameCacheMemoryLimit(), 1024 * 1024 )
+		self.assertEqual( g.frameCacheMemoryUsage(), 0 )
+
+		g.setFrameCacheMemoryLimit( 0 )
+		self.assertEqual( g.getFrameCacheMemoryLimit(), 0 )
+
 if __name__ == "__main__":
 	unittest.main()
 
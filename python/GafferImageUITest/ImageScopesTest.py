@@ -0,0 +1,123 @@
+##########################################################################
+#
+#  Copyright (c) 2017, Image Engine Design Inc. All rights reserved.
+#
+#  Redistribution and use in source and binary forms, with or without
+#  modification, are permitted provided that the following conditions are
+#  met:
+#
+#      * Redistributions of source code must retain the above
+#        copyright notice, this list of conditions and the following
+#        disclaimer.
+#
+#      * Redistributions in binary form must reproduce the above
+#        copyright notice, this list of conditions and the following
+#        disclaimer in the documentation and/or other materials provided with
+#        the distribution.
+#
+#      * Neither the name of John Haddon nor the names of
+#        any other contributors to this software may be used to endorse or
+#        promote products derived from this software without specific prior
+#        written permission.
+#
+#  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+#  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+#  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+#  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+#  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+#  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+#  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+#  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+#  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+#  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+#  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#
+##########################################################################
+
+import unittest
+
+import IECore
+
+import Gaffer
+import GafferUITest
+import GafferImage
+import GafferImageUI
+
+class ImageScopesTest( GafferUITest.TestCase ) :
+
+	def testConstant( self ) :
+
+		c = GafferImage.Constant()
+		c["format"].setValue( GafferImage.Format( 100, 50 ) )
+		c["color"].setValue( IECore.Color4f( 0.5, 0.25, 0.1, 1 ) )
+
+		s = GafferImageUI.ImageScopes()
+		s.setImage( c["out"] )
+		s.setContext( Gaffer.Context() )
+		self.assertTrue( s.getImage().isSame( c["out"] ) )
+
+		self.assertTrue( s.update() )
+		self.assertEqual( s.dataWindow(), IECore.Box2i( IECore.V2i( 0 ), IECore.V2i( 100, 50 ) ) )
+
+		numPixels = 100 * 50
+		red = s.histogram( GafferImageUI.ImageScopes.Channel.Red )
+		self.assertEqual( len( red ), GafferImageUI.ImageScopes.histogramBins )
+		self.assertEqual( red[128], numPixels )
+		self.assertEqual( sum( red ), numPixels )
+
+		self.assertEqual( sum( s.histogram( GafferImageUI.ImageScopes.Channel.Luminance ) ), numPixels )
+		self.assertEqual( sum( s.waveform() ), numPixels )
+		self.assertEqual( sum( s.vectorscope() ), numPixels )
+
+		self.assertEqual( s.minimum(), IECore.Color4f( 0.5, 0.25, 0.1, 1 ) )
+		self.assertEqual( s.maximum(), IECore.Color4f( 0.5, 0.25, 0.1, 1 ) )
+		self.assertTrue( s.average().equalWithAbsError( IECore.Color4f( 0.5, 0.25, 0.1, 1 ), 0.00001 ) )
+
+		# Nothing has changed, so nothing needs updating.
+		self.assertFalse( s.update() )
+
+		c["color"].setValue( IECore.Color4f( 1, 0, 0, 1 ) )
+		self.assertTrue( s.update() )
+
+		red = s.histogram( GafferImageUI.ImageScopes.Channel.Red )
+		self.assertEqual( red[-1], numPixels )
+		self.assertEqual( sum( red ), numPixels )
+		self.assertEqual( s.maximum(), IECore.Color4f( 1, 0, 0, 1 ) )
+
+	def testDataWindowChanges( self ) :
+
+		c = GafferImage.Constant()
+		c["format"].setValue( GafferImage.Format( 100, 50 ) )
+
+		s = GafferImageUI.ImageScopes()
+		s.setImage( c["out"] )
+		s.setContext( Gaffer.Context() )
+		s.update()
+
+		c["format"].setValue( GafferImage.Format( 200, 300 ) )
+		self.assertTrue( s.update() )
+		self.assertEqual( sum( s.histogram( GafferImageUI.ImageScopes.Channel.Green ) ), 200 * 300 )
+		self.assertEqual( sum( s.waveform() ), 200 * 300 )
+
+	def testNoImage( self ) :
+
+		s = GafferImageUI.ImageScopes()
+		s.update()
+		self.assertEqual( sum( s.histogram( GafferImageUI.ImageScopes.Channel.Red ) ), 0 )
+		self.assertEqual( len( s.waveform() ), GafferImageUI.ImageScopes.waveformWidth * GafferImageUI.ImageScopes.waveformHeight )
+
+	def testImageView( self ) :
+
+		v = GafferImageUI.ImageView()
+		self.assertTrue( isinstance( v.imageScopes(), GafferImageUI.ImageScopes ) )
+		self.assertTrue( v.imageScopes().getContext().isSame( v.getContext() ) )
+
+		c = GafferImage.Constant()
+		c["format"].setValue( GafferImage.Format( 10, 10 ) )
+		v["in"].setInput( c["out"] )
+
+		v.imageScopes().update()
+		self.assertEqual( sum( v.imageScopes().histogram( GafferImageUI.ImageScopes.Channel.Blue ) ), 100 )
+
+if __name__ == "__main__":
+	unittest.main()
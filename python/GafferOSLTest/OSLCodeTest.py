@@ -342,6 +342,56 @@ class OSLCodeTest( GafferOSLTest.OSLTestCase ) :
 
 		self.assertTrue( self.__osoFileName( s2["o"] ).startswith( os.environ["GAFFEROSL_CODE_DIRECTORY"] ) )
 
+	def testSharedCodeDirectory( self ) :
+
+		oslCodeDir = os.environ.get( "GAFFEROSL_CODE_DIRECTORY" )
+		if oslCodeDir :
+			self.addCleanup( os.environ.__setitem__, "GAFFEROSL_CODE_DIRECTORY", oslCodeDir )
+		else :
+			self.addCleanup( os.environ.__delitem__, "GAFFEROSL_CODE_DIRECTORY" )
+
+		os.environ["GAFFEROSL_CODE_DIRECTORY"] = os.path.join( self.temporaryDirectory(), "sharedCodeDirectory" )
+
+		def makeNode() :
+
+			o = GafferOSL.OSLCode()
+			o["parameters"]["i"] = Gaffer.Color3fPlug( flags = Gaffer.Plug.Flags.Default | Gaffer.Plug.Flags.Dynamic )
+			o["out"]["o"] = Gaffer.Color3fPlug( direction = Gaffer.Plug.Direction.Out, flags = Gaffer.Plug.Flags.Default | Gaffer.Plug.Flags.Dynamic )
+			o["code"].setValue( "o = i * color( u, v, 0.5 );" )
+			return o
+
+		# The first node has to compile the shader.
+
+		t = IECore.Timer()
+		o1 = makeNode()
+		#print "FIRST COMPILE", t.stop()
+
+		fileName = self.__osoFileName( o1 ) + ".oso"
+		self.assertTrue( fileName.startswith( os.environ["GAFFEROSL_CODE_DIRECTORY"] ) )
+		self.assertTrue( os.path.exists( fileName ) )
+		modificationTime = os.path.getmtime( fileName )
+
+		# But any subsequent node, as if in another process on
+		# the farm, should use the existing file without recompiling.
+
+		t = IECore.Timer()
+		o2 = makeNode()
+		#print "CACHED COMPILE", t.stop()
+
+		self.assertEqual( self.__osoFileName( o2 ) + ".oso", fileName )
+		self.assertEqual( os.path.getmtime( fileName ), modificationTime )
+
+		# If the shared directory can't be written to, we should still
+		# be able to compile new code, into the default location instead.
+
+		os.chmod( os.environ["GAFFEROSL_CODE_DIRECTORY"], 0555 )
+		self.addCleanup( os.chmod, os.environ["GAFFEROSL_CODE_DIRECTORY"], 0755 )
+
+		o3 = makeNode()
+		with IECore.CapturingMessageHandler() :
+			o3["code"].setValue( "o = i * color( u, v, 0.25 );" )
+		self.assertTrue( os.path.exists( self.__osoFileName( o3 ) + ".oso" ) )
+
 	def __osoFileName( self, oslCode ) :
 
 		# Right now we could get this information by
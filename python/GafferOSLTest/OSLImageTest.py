@@ -249,6 +249,48 @@ class OSLImageTest( GafferOSLTest.OSLTestCase ) :
 
 		c["color"]["r"].setValue( 1 )
 		self.assertTrue( o["out"]["channelData"] in set( x[0] for x in cs ) )
+	def testNegativeDataWindow( self ) :
+
+		# The shading is computed in blocks of several tiles, and a negative
+		# data window spans several blocks.
+
+		getRed = GafferOSL.OSLShader()
+		getRed.loadShader( "ImageProcessing/InChannel" )
+		getRed["parameters"]["channelName"].setValue( "R" )
+
+		outB = GafferOSL.OSLShader()
+		outB.loadShader( "ImageProcessing/OutChannel" )
+		outB["parameters"]["channelName"].setValue( "B" )
+		outB["parameters"]["channelValue"].setInput( getRed["out"]["channelValue"] )
+
+		imageShader = GafferOSL.OSLShader()
+		imageShader.loadShader( "ImageProcessing/OutImage" )
+		imageShader["parameters"]["in0"].setInput( outB["out"]["channel"] )
+
+		reader = GafferImage.ImageReader()
+		reader["fileName"].setValue( os.path.expandvars( "$GAFFER_ROOT/python/GafferImageTest/images/checkerWithNegativeDataWindow.200x150.exr" ) )
+
+		image = GafferOSL.OSLImage()
+		image["in"].setInput( reader["out"] )
+		image["shader"].setInput( imageShader["out"] )
+
+		inputImage = reader["out"].image()
+		outputImage = image["out"].image()
+
+		self.assertEqual( outputImage.dataWindow, inputImage.dataWindow )
+		self.assertEqual( outputImage["R"].data, inputImage["R"].data )
+		self.assertEqual( outputImage["G"].data, inputImage["G"].data )
+		self.assertEqual( outputImage["B"].data, inputImage["R"].data )
+
+		# Tiles within the same block must still have distinct hashes.
+
+		dataWindow = reader["out"]["dataWindow"].getValue()
+		tileSize = GafferImage.ImagePlug.tileSize()
+		tileOrigin = GafferImage.ImagePlug.tileOrigin( dataWindow.min )
+		self.assertNotEqual(
+			image["out"].channelDataHash( "B", tileOrigin ),
+			image["out"].channelDataHash( "B", tileOrigin + IECore.V2i( tileSize, 0 ) ),
+		)
 
 if __name__ == "__main__":
 	unittest.main()
@@ -374,6 +374,67 @@ class ShadingEngineTest( GafferOSLTest.OSLTestCase ) :
 		# Transform from world to object
 		self.assertEqual( p["Ci"], IECore.Color3fVectorData( [ IECore.Color3f( i + IECore.V3f( -2, 0, 0 ) ) for i in self.rectanglePoints()["P"] ] ) )
 
+	def testManyPoints( self ) :
+
+		# Enough points to be shaded in several parallel chunks.
+
+		shader = self.compileShader( os.path.dirname( __file__ ) + "/shaders/multipleDebugClosures.osl" )
+
+		e = GafferOSL.ShadingEngine( IECore.ObjectVector( [
+			IECore.Shader( shader, "surface", {} ),
+		] ) )
+
+		points = self.rectanglePoints( divisions = IECore.V2i( 200 ) )
+		shading = e.shade( points )
+
+		for n in ( "u", "v", "P" ) :
+			self.assertEqual( len( shading[n] ), len( points["P"] ) )
+			for i in range( 0, len( shading[n] ) ) :
+				self.assertEqual( shading[n][i], IECore.Color3f( points[n][i] ) )
+
+		self.assertEqual( e.shade( points ), shading )
+
+	def testManyPointsUserData( self ) :
+
+		shader = self.compileShader( os.path.dirname( __file__ ) + "/shaders/attribute.osl" )
+
+		e = GafferOSL.ShadingEngine( IECore.ObjectVector( [
+			IECore.Shader( shader, "surface", { "name" : "colorUserData" } ),
+		] ) )
+
+		points = self.rectanglePoints( divisions = IECore.V2i( 200 ) )
+		shading = e.shade( points )
+
+		self.assertEqual( shading["Ci"], points["colorUserData"] )
+
+	def testGet( self ) :
+
+		constant = self.compileShader( os.path.dirname( __file__ ) +  "/shaders/constant.osl" )
+		input = self.compileShader( os.path.dirname( __file__ ) +  "/shaders/outputTypes.osl" )
+
+		def network( handle, value ) :
+
+			return IECore.ObjectVector( [
+				IECore.Shader( input, "shader", { "input" : value, "__handle" : handle } ),
+				IECore.Shader( constant, "surface", { "Cs" : "link:" + handle + ".c" } ),
+			] )
+
+		e1 = GafferOSL.ShadingEngine.get( network( "a", 0.5 ) )
+		e2 = GafferOSL.ShadingEngine.get( network( "a", 0.5 ) )
+		self.assertTrue( e1.isSame( e2 ) )
+
+		# Networks differing only in their handles should share an engine.
+
+		e3 = GafferOSL.ShadingEngine.get( network( "b", 0.5 ) )
+		self.assertTrue( e3.isSame( e1 ) )
+
+		# But networks with different values must not.
+
+		e4 = GafferOSL.ShadingEngine.get( network( "a", 0.25 ) )
+		self.assertFalse( e4.isSame( e1 ) )
+
+		self.assertEqual( e3.shade( self.rectanglePoints() )["Ci"], IECore.Color3fVectorData( [ IECore.Color3f( 0.5 ) ] * 100 ) )
+		self.assertEqual( e4.shade( self.rectanglePoints() )["Ci"], IECore.Color3fVectorData( [ IECore.Color3f( 0.25 ) ] * 100 ) )
 
 if __name__ == "__main__":
 	unittest.main()
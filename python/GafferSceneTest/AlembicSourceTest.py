@@ -151,5 +151,30 @@ class AlembicSourceTest( GafferSceneTest.SceneTestCase ) :
 
 		self.assertRaises( RuntimeError, a["out"].childNames, "/" )
 
+	def testStaticHashesIndependentOfTime( self ) :
+
+		a = GafferScene.AlembicSource()
+		a["fileName"].setValue( os.path.dirname( __file__ ) + "/alembicFiles/cube.abc" )
+
+		c1 = Gaffer.Context()
+		c1.setFrame( 1 )
+		c2 = Gaffer.Context()
+		c2.setFrame( 10 )
+
+		for path in ( "/group1", "/group1/pCube1", "/group1/pCube1/pCubeShape1" ) :
+			with c1 :
+				h1 = ( a["out"].objectHash( path ), a["out"].transformHash( path ) )
+			with c2 :
+				h2 = ( a["out"].objectHash( path ), a["out"].transformHash( path ) )
+			self.assertEqual( h1, h2 )
+
+		a["fileName"].setValue( os.path.dirname( __file__ ) + "/alembicFiles/animatedCube.abc" )
+
+		with c1 :
+			h1 = a["out"].objectHash( "/pCube1/pCubeShape1" )
+		with c2 :
+			h2 = a["out"].objectHash( "/pCube1/pCubeShape1" )
+		self.assertNotEqual( h1, h2 )
+
 if __name__ == "__main__":
 	unittest.main()
@@ -0,0 +1,115 @@
+##########################################################################
+#
+#  Copyright (c) 2017, Image Engine Design Inc. All rights reserved.
+#
+#  Redistribution and use in source and binary forms, with or without
+#  modification, are permitted provided that the following conditions are
+#  met:
+#
+#      * Redistributions of source code must retain the above
+#        copyright notice, this list of conditions and the following
+#        disclaimer.
+#
+#      * Redistributions in binary form must reproduce the above
+#        copyright notice, this list of conditions and the following
+#        disclaimer in the documentation and/or other materials provided with
+#        the distribution.
+#
+#      * Neither the name of John Haddon nor the names of
+#        any other contributors to this software may be used to endorse or
+#        promote products derived from this software without specific prior
+#        written permission.
+#
+#  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+#  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+#  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+#  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+#  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+#  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+#  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+#  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+#  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+#  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+#  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#
+##########################################################################
+
+import os
+import unittest
+
+import IECore
+
+import GafferScene
+import GafferSceneTest
+
+class ArchiveAlgoTest( GafferSceneTest.SceneTestCase ) :
+
+	def setUp( self ) :
+
+		GafferSceneTest.SceneTestCase.setUp( self )
+
+		GafferScene.ArchiveAlgo.clearMetadataCache()
+
+	def __writeArchive( self, fileName, bound ) :
+
+		sc = IECore.SceneCache( fileName, IECore.IndexedIO.OpenMode.Write )
+		c = sc.createChild( "box" )
+		c.writeObject( IECore.MeshPrimitive.createBox( bound ), 0.0 )
+		del sc, c
+
+	def testSceneInterfaceBound( self ) :
+
+		fileName = self.temporaryDirectory() + "/test.scc"
+		bound = IECore.Box3f( IECore.V3f( -1, -2, -3 ), IECore.V3f( 1, 2, 3 ) )
+		self.__writeArchive( fileName, bound )
+
+		self.assertEqual( GafferScene.ArchiveAlgo.bound( fileName ), bound )
+		self.assertEqual( GafferScene.ArchiveAlgo.metadata( fileName )["bound"].value, bound )
+
+		# Results are cached.
+
+		self.assertTrue(
+			GafferScene.ArchiveAlgo.metadata( fileName, _copy = False ).isSame(
+				GafferScene.ArchiveAlgo.metadata( fileName, _copy = False )
+			)
+		)
+
+	def testModifiedFilesAreReread( self ) :
+
+		fileName = self.temporaryDirectory() + "/test.scc"
+		bound1 = IECore.Box3f( IECore.V3f( -1 ), IECore.V3f( 1 ) )
+		self.__writeArchive( fileName, bound1 )
+
+		self.assertEqual( GafferScene.ArchiveAlgo.bound( fileName ), bound1 )
+		h1 = GafferScene.ArchiveAlgo.hash( fileName )
+
+		bound2 = IECore.Box3f( IECore.V3f( -2 ), IECore.V3f( 2 ) )
+		self.__writeArchive( fileName, bound2 )
+		# Make sure the modification time differs, regardless
+		# of the resolution of the filesystem timestamps.
+		mtime = os.stat( fileName ).st_mtime
+		os.utime( fileName, ( mtime + 10, mtime + 10 ) )
+
+		self.assertEqual( GafferScene.ArchiveAlgo.bound( fileName ), bound2 )
+		self.assertNotEqual( GafferScene.ArchiveAlgo.hash( fileName ), h1 )
+
+	def testUnsupportedFiles( self ) :
+
+		self.assertEqual( GafferScene.ArchiveAlgo.metadata( "test.so" ), None )
+		self.assertEqual( GafferScene.ArchiveAlgo.bound( "test.so" ), IECore.Box3f() )
+
+	def testMissingFiles( self ) :
+
+		self.assertRaises( RuntimeError, GafferScene.ArchiveAlgo.bound, self.temporaryDirectory() + "/missing.scc" )
+
+	def testCacheSizeLimit( self ) :
+
+		l = GafferScene.ArchiveAlgo.getMetadataCacheSizeLimit()
+		try :
+			GafferScene.ArchiveAlgo.setMetadataCacheSizeLimit( 10 )
+			self.assertEqual( GafferScene.ArchiveAlgo.getMetadataCacheSizeLimit(), 10 )
+		finally :
+			GafferScene.ArchiveAlgo.setMetadataCacheSizeLimit( l )
+
+if __name__ == "__main__":
+	unittest.main()
@@ -327,5 +327,23 @@ class CustomAttributesTest( GafferSceneTest.SceneTestCase ) :
 
 		self.assertEqual( set( s["a"].affects( p["value"] ) ), set( [ s["a"]["out"]["attributes"], s["a"]["out"]["globals"] ] ) )
 
+	def testRedundantAttributesShareInput( self ) :
+
+		p = GafferScene.Plane()
+
+		a1 = GafferScene.CustomAttributes()
+		a1["in"].setInput( p["out"] )
+		a1["attributes"].addMember( "test", IECore.IntData( 1 ) )
+
+		a2 = GafferScene.CustomAttributes()
+		a2["in"].setInput( a1["out"] )
+		a2["attributes"].addMember( "test", IECore.IntData( 1 ) )
+
+		self.assertTrue( a2["out"].attributes( "/plane", _copy = False ).isSame( a1["out"].attributes( "/plane", _copy = False ) ) )
+
+		a2["attributes"][0]["value"].setValue( 2 )
+		self.assertFalse( a2["out"].attributes( "/plane", _copy = False ).isSame( a1["out"].attributes( "/plane", _copy = False ) ) )
+		self.assertEqual( a2["out"].attributes( "/plane" )["test"], IECore.IntData( 2 ) )
+
 if __name__ == "__main__":
 	unittest.main()
@@ -96,5 +96,22 @@ class DeleteAttributesTest( GafferSceneTest.SceneTestCase ) :
 		d["names"].setValue( "b2 a*" )
 		self.assertEqual( set( d["out"].attributes( "/plane" ).keys() ), set( [ "b1" ] ) )
 
+	def testUnmatchedNamesShareInput( self ) :
+
+		p = GafferScene.Plane()
+		a = GafferScene.CustomAttributes()
+		a["in"].setInput( p["out"] )
+		a["attributes"].addMember( "a1", 1 )
+
+		d = GafferScene.DeleteAttributes()
+		d["in"].setInput( a["out"] )
+		d["names"].setValue( "b*" )
+
+		self.assertTrue( d["out"].attributes( "/plane", _copy = False ).isSame( a["out"].attributes( "/plane", _copy = False ) ) )
+
+		d["names"].setValue( "a*" )
+		self.assertFalse( d["out"].attributes( "/plane", _copy = False ).isSame( a["out"].attributes( "/plane", _copy = False ) ) )
+		self.assertEqual( d["out"].attributes( "/plane" ), IECore.CompoundObject() )
+
 if __name__ == "__main__":
 	unittest.main()
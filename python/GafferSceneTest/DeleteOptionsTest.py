@@ -100,5 +100,38 @@ class DeleteOptionsTest( GafferSceneTest.SceneTestCase ) :
 		deleteOptions["invertNames"].setValue( True )
 		self.assertTrue( deleteOptions["out"]["globals"] in set( e[0] for e in cs ) )
 
+	def testUnchangedGlobalsAreShared( self ) :
+
+		plane = GafferScene.Plane()
+
+		options = GafferScene.CustomOptions()
+		options["in"].setInput( plane["out"] )
+		options["options"].addOptionalMember( "test1", 1, "test1", enabled = True )
+		options["options"].addOptionalMember( "test2", 2, "test2", enabled = False )
+
+		deleteOptions = GafferScene.DeleteOptions()
+		deleteOptions["in"].setInput( options["out"] )
+		deleteOptions["names"].setValue( "test2" )
+
+		copyOptions = GafferScene.CopyOptions()
+		copyOptions["in"].setInput( deleteOptions["out"] )
+		copyOptions["source"].setInput( plane["out"] )
+		copyOptions["names"].setValue( "*" )
+
+		# None of these make any changes, so they should all
+		# pass through the same globals object rather than make
+		# copies.
+
+		g = options["out"]["globals"].getValue( _copy = False )
+		self.assertTrue( deleteOptions["out"]["globals"].getValue( _copy = False ).isSame( g ) )
+		self.assertTrue( copyOptions["out"]["globals"].getValue( _copy = False ).isSame( g ) )
+
+		options["options"]["test1"]["enabled"].setValue( False )
+		self.assertTrue(
+			options["out"]["globals"].getValue( _copy = False ).isSame(
+				plane["out"]["globals"].getValue( _copy = False )
+			)
+		)
+
 if __name__ == "__main__":
 	unittest.main()
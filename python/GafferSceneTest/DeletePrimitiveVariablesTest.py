@@ -94,5 +94,21 @@ class DeletePrimitiveVariablesTest( GafferSceneTest.SceneTestCase ) :
 		d["names"].setValue( "*" )
 		self.assertEqual( d["out"].object( "/plane" ).keys(), [] )
 
+	def testPassThroughWhenNothingMatches( self ) :
+
+		p = GafferScene.Plane()
+		d = GafferScene.DeletePrimitiveVariables()
+		d["in"].setInput( p["out"] )
+
+		d["names"].setValue( "notAVariable" )
+		self.assertTrue(
+			d["out"].object( "/plane", _copy = False ).isSame( p["out"].object( "/plane", _copy = False ) )
+		)
+
+		d["names"].setValue( "s" )
+		self.assertFalse(
+			d["out"].object( "/plane", _copy = False ).isSame( p["out"].object( "/plane", _copy = False ) )
+		)
+
 if __name__ == "__main__":
 	unittest.main()
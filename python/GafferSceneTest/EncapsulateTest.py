@@ -0,0 +1,124 @@
+##########################################################################
+#
+#  Copyright (c) 2017, Image Engine Design Inc. All rights reserved.
+#
+#  Redistribution and use in source and binary forms, with or without
+#  modification, are permitted provided that the following conditions are
+#  met:
+#
+#      * Redistributions of source code must retain the above
+#        copyright notice, this list of conditions and the following
+#        disclaimer.
+#
+#      * Redistributions in binary form must reproduce the above
+#        copyright notice, this list of conditions and the following
+#        disclaimer in the documentation and/or other materials provided with
+#        the distribution.
+#
+#      * Neither the name of John Haddon nor the names of
+#        any other contributors to this software may be used to endorse or
+#        promote products derived from this software without specific prior
+#        written permission.
+#
+#  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+#  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+#  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+#  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+#  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+#  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+#  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+#  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+#  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+#  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+#  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#
+##########################################################################
+
+import unittest
+
+import IECore
+
+import Gaffer
+import GafferScene
+import GafferSceneTest
+
+class EncapsulateTest( GafferSceneTest.SceneTestCase ) :
+
+	def __scene( self ) :
+
+		sphere = GafferScene.Sphere()
+
+		group = GafferScene.Group()
+		group["in"][0].setInput( sphere["out"] )
+
+		set = GafferScene.Set()
+		set["in"].setInput( group["out"] )
+		set["paths"].setValue( IECore.StringVectorData( [ "/group", "/group/sphere" ] ) )
+
+		filter = GafferScene.PathFilter()
+		filter["paths"].setValue( IECore.StringVectorData( [ "/group" ] ) )
+
+		encapsulate = GafferScene.Encapsulate()
+		encapsulate["in"].setInput( set["out"] )
+		encapsulate["filter"].setInput( filter["out"] )
+
+		return sphere, group, set, filter, encapsulate
+
+	def testPassThrough( self ) :
+
+		sphere, group, set, filter, encapsulate = self.__scene()
+		filter["paths"].setValue( IECore.StringVectorData() )
+
+		self.assertSceneValid( encapsulate["out"] )
+		self.assertScenesEqual( encapsulate["out"], set["out"] )
+		self.assertSceneHashesEqual( encapsulate["out"], set["out"] )
+
+	def testCapsule( self ) :
+
+		sphere, group, set, filter, encapsulate = self.__scene()
+
+		self.assertSceneValid( encapsulate["out"] )
+
+		self.assertEqual( encapsulate["out"].childNames( "/" ), IECore.InternedStringVectorData( [ "group" ] ) )
+		self.assertEqual( encapsulate["out"].childNames( "/group" ), IECore.InternedStringVectorData() )
+		self.assertEqual( encapsulate["out"].bound( "/group" ), set["out"].bound( "/group" ) )
+		self.assertEqual( encapsulate["out"].transform( "/group" ), set["out"].transform( "/group" ) )
+		self.assertEqual( encapsulate["out"].attributes( "/group" ), set["out"].attributes( "/group" ) )
+
+		capsule = encapsulate["out"].object( "/group" )
+		self.assertTrue( isinstance( capsule, GafferScene.Capsule ) )
+		self.assertTrue( capsule.scene().isSame( encapsulate["in"] ) )
+		self.assertEqual( capsule.root(), "/group" )
+		self.assertEqual( capsule.bound(), set["out"].bound( "/group" ) )
+
+		self.assertEqual( encapsulate["out"].set( "set" ).value.paths(), [ "/group" ] )
+
+	def testHashChangesWithUpstream( self ) :
+
+		sphere, group, set, filter, encapsulate = self.__scene()
+
+		h1 = encapsulate["out"].objectHash( "/group" )
+		sphere["radius"].setValue( 2 )
+		h2 = encapsulate["out"].objectHash( "/group" )
+		self.assertNotEqual( h1, h2 )
+
+		c = Gaffer.Context()
+		c.setFrame( 10 )
+		with c :
+			h3 = encapsulate["out"].objectHash( "/group" )
+		self.assertNotEqual( h2, h3 )
+
+	def testRender( self ) :
+
+		sphere, group, set, filter, encapsulate = self.__scene()
+
+		outerGroup = GafferScene.Group()
+		outerGroup["name"].setValue( "outer" )
+		outerGroup["in"][0].setInput( encapsulate["out"] )
+
+		captured = GafferSceneTest.outputScene( outerGroup["out"], "Capturing" )
+		self.assertEqual( captured["/outer/group/sphere"]["type"], IECore.StringData( "object" ) )
+		self.assertFalse( "/outer/group" in captured )
+
+if __name__ == "__main__":
+	unittest.main()
@@ -62,5 +62,29 @@ class ExternalProceduralTest( GafferSceneTest.SceneTestCase ) :
 		self.assertEqual( p.parameters().keys(), [ "testFloat" ] )
 		self.assertEqual( p.parameters()["testFloat"], IECore.FloatData( 1.0 ) )
 
+	def testUseArchiveBound( self ) :
+
+		fileName = self.temporaryDirectory() + "/test.scc"
+		archiveBound = IECore.Box3f( IECore.V3f( -1, -2, -3 ), IECore.V3f( 1, 2, 3 ) )
+		sc = IECore.SceneCache( fileName, IECore.IndexedIO.OpenMode.Write )
+		c = sc.createChild( "box" )
+		c.writeObject( IECore.MeshPrimitive.createBox( archiveBound ), 0.0 )
+		del sc, c
+
+		n = GafferScene.ExternalProcedural()
+		n["fileName"].setValue( fileName )
+		n["bound"].setValue( IECore.Box3f( IECore.V3f( 0 ), IECore.V3f( 1 ) ) )
+		self.assertEqual( n["out"].object( "/procedural" ).getBound(), IECore.Box3f( IECore.V3f( 0 ), IECore.V3f( 1 ) ) )
+
+		n["useArchiveBound"].setValue( True )
+		self.assertEqual( n["out"].object( "/procedural" ).getBound(), archiveBound )
+		self.assertEqual( n["out"].bound( "/procedural" ), archiveBound )
+
+		# Falls back to the bound plug for files
+		# we can't read a bound from.
+
+		n["fileName"].setValue( "test.so" )
+		self.assertEqual( n["out"].object( "/procedural" ).getBound(), IECore.Box3f( IECore.V3f( 0 ), IECore.V3f( 1 ) ) )
+
 if __name__ == "__main__":
 	unittest.main()
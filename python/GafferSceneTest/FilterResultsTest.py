@@ -158,5 +158,64 @@ class FilterResultsTest( GafferSceneTest.SceneTestCase ) :
 			] )
 		)
 
+	def testEditUnderOneBranch( self ) :
+
+		script = Gaffer.ScriptNode()
+
+		script["sphere"] = GafferScene.Sphere()
+		script["sphere"]["sets"].setValue( "A" )
+
+		script["plane"] = GafferScene.Plane()
+		script["plane"]["sets"].setValue( "A" )
+
+		script["groupA"] = GafferScene.Group()
+		script["groupA"]["name"].setValue( "groupA" )
+		script["groupA"]["in"][0].setInput( script["sphere"]["out"] )
+
+		script["groupB"] = GafferScene.Group()
+		script["groupB"]["name"].setValue( "groupB" )
+		script["groupB"]["in"][0].setInput( script["plane"]["out"] )
+
+		script["parent"] = GafferScene.Group()
+		script["parent"]["in"][0].setInput( script["groupA"]["out"] )
+		script["parent"]["in"][1].setInput( script["groupB"]["out"] )
+
+		script["filter"] = GafferScene.PathFilter()
+		script["filter"]["paths"].setValue( IECore.StringVectorData( [ "/group/.../sphere", "/group/.../plane" ] ) )
+
+		script["filterResults"] = GafferScene.FilterResults()
+		script["filterResults"]["scene"].setInput( script["parent"]["out"] )
+		script["filterResults"]["filter"].setInput( script["filter"]["out"] )
+
+		self.assertEqual(
+			script["filterResults"]["out"].getValue().value,
+			GafferScene.PathMatcher( [
+				"/group/groupA/sphere",
+				"/group/groupB/plane",
+			] )
+		)
+
+		h = script["filterResults"]["out"].hash()
+
+		script["plane"]["name"].setValue( "notAPlane" )
+		self.assertNotEqual( script["filterResults"]["out"].hash(), h )
+		self.assertEqual(
+			script["filterResults"]["out"].getValue().value,
+			GafferScene.PathMatcher( [
+				"/group/groupA/sphere",
+			] )
+		)
+
+		script["plane"]["name"].setValue( "plane" )
+		self.assertEqual( script["filterResults"]["out"].hash(), h )
+
+		script["filter"]["paths"].setValue( IECore.StringVectorData( [ "/group/groupB" ] ) )
+		self.assertEqual(
+			script["filterResults"]["out"].getValue().value,
+			GafferScene.PathMatcher( [
+				"/group/groupB",
+			] )
+		)
+
 if __name__ == "__main__":
 	unittest.main()
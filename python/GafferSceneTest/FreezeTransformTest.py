@@ -101,6 +101,45 @@ class FreezeTransformTest( GafferSceneTest.SceneTestCase ) :
 		self.assertEqual( t["out"].bound( "/group/plane" ), IECore.Box3f( IECore.V3f( 1.5, 1.5, 3 ), IECore.V3f( 2.5, 2.5, 3 ) ) )
 		self.assertEqual( t["out"].bound( "/group/plane1" ), IECore.Box3f( IECore.V3f( 0.5, -0.5, 0 ), IECore.V3f( 1.5, 0.5, 0 ) ) )
 
+	def testPrimitiveVariableInterpretations( self ) :
+
+		mesh = IECore.MeshPrimitive.createPlane( IECore.Box2f( IECore.V2f( -1 ), IECore.V2f( 1 ) ) )
+		for name, interpretation in [
+			( "v", IECore.GeometricData.Interpretation.Vector ),
+			( "N", IECore.GeometricData.Interpretation.Normal ),
+			( "c", IECore.GeometricData.Interpretation.Numeric ),
+		] :
+			mesh[name] = IECore.PrimitiveVariable(
+				IECore.PrimitiveVariable.Interpolation.Vertex,
+				IECore.V3fVectorData( [ IECore.V3f( 1, 1, 0 ) ] * 4, interpretation )
+			)
+
+		o = GafferScene.ObjectToScene()
+		o["object"].setValue( mesh )
+
+		t = GafferScene.Transform()
+		t["in"].setInput( o["out"] )
+		t["transform"]["translate"].setValue( IECore.V3f( 1, 2, 3 ) )
+		t["transform"]["scale"].setValue( IECore.V3f( 2, 1, 1 ) )
+
+		f = GafferScene.PathFilter()
+		f["paths"].setValue( IECore.StringVectorData( [ "/object" ] ) )
+		t["filter"].setInput( f["out"] )
+
+		freeze = GafferScene.FreezeTransform()
+		freeze["in"].setInput( t["out"] )
+		freeze["filter"].setInput( f["out"] )
+
+		frozen = freeze["out"].object( "/object" )
+
+		self.assertEqual( frozen.bound(), IECore.Box3f( IECore.V3f( -1, 1, 3 ), IECore.V3f( 3, 3, 3 ) ) )
+		self.assertEqual( frozen["v"].data[0], IECore.V3f( 2, 1, 0 ) )
+		self.assertEqual( frozen["N"].data[0], IECore.V3f( 0.5, 1, 0 ) )
+		self.assertEqual( frozen["c"].data[0], IECore.V3f( 1, 1, 0 ) )
+
+		# The input should have been left untouched.
+		self.assertEqual( o["out"].object( "/object" ), mesh )
+
 	def testAffects( self ) :
 
 		t = GafferScene.FreezeTransform()
@@ -585,6 +585,28 @@ class GroupTest( GafferSceneTest.SceneTestCase ) :
 			] )
 		)
 
+	def testSetsWithManyInputs( self ) :
+
+		g = GafferScene.Group()
+
+		lights = []
+		for i in range( 0, 100 ) :
+			lights.append( GafferSceneTest.TestLight() )
+			g["in"][i].setInput( lights[-1]["out"] )
+
+		lightSet = g["out"].set( "__lights" )
+		self.assertEqual(
+			set( lightSet.value.paths() ),
+			set( [ "/group/light" ] + [ "/group/light%d" % i for i in range( 1, 100 ) ] )
+		)
+
+		h = g["out"].setHash( "__lights" )
+		lights[50]["name"].setValue( "renamed" )
+		self.assertNotEqual( g["out"].setHash( "__lights" ), h )
+		self.assertTrue( "/group/renamed" in g["out"].set( "__lights" ).value.paths() )
+
+		self.assertSceneValid( g["out"] )
+
 	def testDisabled( self ) :
 
 		p1 = GafferScene.Plane()
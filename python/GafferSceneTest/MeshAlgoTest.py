@@ -0,0 +1,84 @@
+##########################################################################
+#
+#  Copyright (c) 2017, Image Engine Design Inc. All rights reserved.
+#
+#  Redistribution and use in source and binary forms, with or without
+#  modification, are permitted provided that the following conditions are
+#  met:
+#
+#      * Redistributions of source code must retain the above
+#        copyright notice, this list of conditions and the following
+#        disclaimer.
+#
+#      * Redistributions in binary form must reproduce the above
+#        copyright notice, this list of conditions and the following
+#        disclaimer in the documentation and/or other materials provided with
+#        the distribution.
+#
+#      * Neither the name of John Haddon nor the names of
+#        any other contributors to this software may be used to endorse or
+#        promote products derived from this software without specific prior
+#        written permission.
+#
+#  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+#  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+#  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+#  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+#  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+#  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+#  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+#  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+#  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+#  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+#  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#
+##########################################################################
+
+import unittest
+
+import IECore
+
+import GafferScene
+import GafferSceneTest
+
+class MeshAlgoTest( GafferSceneTest.SceneTestCase ) :
+
+	def testPlaneNormals( self ) :
+
+		m = IECore.MeshPrimitive.createPlane( IECore.Box2f( IECore.V2f( -1 ), IECore.V2f( 1 ) ), IECore.V2i( 10 ) )
+		n = GafferScene.MeshAlgo.calculateNormals( m )
+
+		self.assertEqual( n.interpolation, IECore.PrimitiveVariable.Interpolation.Vertex )
+		self.assertEqual( len( n.data ), len( m["P"].data ) )
+		for v in n.data :
+			self.assertTrue( v.equalWithAbsError( IECore.V3f( 0, 0, 1 ), 0.000001 ) )
+
+	def testMatchesMeshNormalsOp( self ) :
+
+		m = IECore.MeshPrimitive.createBox( IECore.Box3f( IECore.V3f( -1 ), IECore.V3f( 1 ) ) )
+		n = GafferScene.MeshAlgo.calculateNormals( m )
+
+		expected = IECore.MeshNormalsOp()( input = m )["N"].data
+		self.assertEqual( len( n.data ), len( expected ) )
+		for v, e in zip( n.data, expected ) :
+			self.assertTrue( v.equalWithAbsError( e, 0.000001 ) )
+
+	def testTangents( self ) :
+
+		m = IECore.MeshPrimitive.createPlane( IECore.Box2f( IECore.V2f( -1 ), IECore.V2f( 1 ) ), IECore.V2i( 4 ) )
+		uTangent, vTangent = GafferScene.MeshAlgo.calculateTangents( m )
+
+		self.assertEqual( len( uTangent.data ), len( m["P"].data ) )
+		self.assertEqual( len( vTangent.data ), len( m["P"].data ) )
+		for u, v in zip( uTangent.data, vTangent.data ) :
+			self.assertAlmostEqual( abs( u.dot( IECore.V3f( 1, 0, 0 ) ) ), 1, 5 )
+			self.assertAlmostEqual( abs( v.dot( IECore.V3f( 0, 1, 0 ) ) ), 1, 5 )
+
+	def testMissingVariables( self ) :
+
+		m = IECore.MeshPrimitive.createPlane( IECore.Box2f( IECore.V2f( -1 ), IECore.V2f( 1 ) ) )
+		self.assertRaises( RuntimeError, GafferScene.MeshAlgo.calculateNormals, m, "notP" )
+		self.assertRaises( RuntimeError, GafferScene.MeshAlgo.calculateTangents, m, "notS", "notT" )
+
+if __name__ == "__main__":
+	unittest.main()
@@ -217,5 +217,26 @@ class PathFilterTest( GafferSceneTest.SceneTestCase ) :
 			c["scene:path"] = IECore.InternedStringVectorData( [ "a" ] )
 			self.assertEqual( f["out"].getValue(), GafferScene.Filter.Result.NoMatch )
 
+	def testPathMatcherSharedBetweenLocations( self ) :
+
+		s = Gaffer.ScriptNode()
+
+		s["f"] = GafferScene.PathFilter()
+
+		s["e"] = Gaffer.Expression()
+		s["e"].setExpression( "import IECore; parent['f']['paths'] = IECore.StringVectorData( [ '/a', '/b' ] )" )
+
+		with Gaffer.PerformanceMonitor() as m :
+			with Gaffer.Context() as c :
+				for name in ( "a", "b", "c" ) :
+					c["scene:path"] = IECore.InternedStringVectorData( [ name ] )
+					self.assertEqual(
+						s["f"]["out"].getValue(),
+						GafferScene.Filter.Result.NoMatch if name == "c" else GafferScene.Filter.Result.ExactMatch
+					)
+
+		self.assertEqual( m.plugStatistics( s["f"]["__pathMatcher"] ).computeCount, 1 )
+		self.assertEqual( m.plugStatistics( s["f"]["__pathMatcher"] ).hashCount, 1 )
+
 if __name__ == "__main__":
 	unittest.main()
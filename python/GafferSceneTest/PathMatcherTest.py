@@ -1001,5 +1001,101 @@ class PathMatcherTest( GafferSceneTest.SceneTestCase ) :
 		self.assertEqual( m1, m1c )
 		self.assertEqual( m2, m2c )
 
+	def testMixedPlainAndWildcardedChildren( self ) :
+
+		# Add in an order that doesn't match the sorted order,
+		# so that insertion into the middle of the child list is
+		# exercised.
+		paths = [ "/a/z", "/a/*x", "/a/b", "/a/m", "/a/b*", "/a/c" ]
+		m = GafferScene.PathMatcher()
+		for p in paths :
+			m.addPath( p )
+
+		self.assertEqual( set( m.paths() ), set( paths ) )
+		for p in paths + [ "/a/yx", "/a/bb" ] :
+			self.assertEqual( m.match( p ), GafferScene.Filter.Result.ExactMatch )
+		self.assertEqual( m.match( "/a/y" ), GafferScene.Filter.Result.NoMatch )
+
+		m2 = GafferScene.PathMatcher( list( reversed( paths ) ) )
+		self.assertEqual( m, m2 )
+
+		m2.removePath( "/a/m" )
+		self.assertNotEqual( m, m2 )
+		self.assertEqual( m2.match( "/a/m" ), GafferScene.Filter.Result.NoMatch )
+
+		m2.addPath( "/a/n" )
+		self.assertNotEqual( m, m2 )
+
+	def testAddPathsWithPrefixIsIndependentOfSource( self ) :
+
+		source = GafferScene.PathMatcher( [ "/a", "/a/b", "/c/d/e" ] )
+
+		m = GafferScene.PathMatcher()
+		self.assertTrue( m.addPaths( source, "/p/q" ) )
+		self.assertEqual( set( m.paths() ), set( [ "/p/q/a", "/p/q/a/b", "/p/q/c/d/e" ] ) )
+
+		# Editing the result must not affect the source, and vice versa.
+
+		m.addPath( "/p/q/a/x" )
+		m.removePath( "/p/q/c/d/e" )
+		self.assertEqual( set( source.paths() ), set( [ "/a", "/a/b", "/c/d/e" ] ) )
+
+		source.addPath( "/a/y" )
+		self.assertEqual( set( m.paths() ), set( [ "/p/q/a", "/p/q/a/b", "/p/q/a/x" ] ) )
+
+		# Adding to an existing location merges as before.
+
+		self.assertTrue( m.addPaths( source, "/p/q" ) )
+		self.assertEqual( set( m.paths() ), set( [ "/p/q/a", "/p/q/a/b", "/p/q/a/x", "/p/q/a/y", "/p/q/c/d/e" ] ) )
+		self.assertFalse( m.addPaths( source, "/p/q" ) )
+
+		# And adding into an empty matcher without a prefix shares too.
+
+		m2 = GafferScene.PathMatcher()
+		self.assertTrue( m2.addPaths( source ) )
+		self.assertEqual( m2, source )
+		m2.addPath( "/z" )
+		self.assertNotEqual( m2, source )
+		self.assertFalse( GafferScene.PathMatcher().addPaths( GafferScene.PathMatcher() ) )
+
+		# Subtrees are independent of their parent too.
+
+		s = source.subTree( "/a" )
+		s.removePath( "/b" )
+		self.assertTrue( source.match( "/a/b" ) & GafferScene.Filter.Result.ExactMatch )
+
+	def testHash( self ) :
+
+		m1 = GafferScene.PathMatcher( [ "/a/b", "/a/c", "/d", "/e/*" ] )
+		m2 = GafferScene.PathMatcher( [ "/e/*", "/d", "/a/c", "/a/b" ] )
+		self.assertEqual( m1.hash(), m2.hash() )
+		self.assertNotEqual( m1.hash(), GafferScene.PathMatcher().hash() )
+
+		# Hashes must be updated in response to edits deep in
+		# the tree, including on copies which share nodes with
+		# the original.
+
+		h = m1.hash()
+		m3 = GafferScene.PathMatcher( m1 )
+		m3.addPath( "/a/b/c" )
+		self.assertNotEqual( m3.hash(), h )
+		self.assertEqual( m1.hash(), h )
+
+		m1.addPath( "/a/b/c" )
+		self.assertEqual( m1.hash(), m3.hash() )
+		m1.removePath( "/a/b/c" )
+		self.assertEqual( m1.hash(), h )
+
+		m1.prune( "/a" )
+		self.assertNotEqual( m1.hash(), h )
+		m1.addPaths( GafferScene.PathMatcher( [ "/b", "/c" ] ), "/a" )
+		self.assertEqual( m1.hash(), GafferScene.PathMatcher( [ "/a/b", "/a/c", "/d", "/e/*" ] ).hash() )
+
+		m1.removePaths( GafferScene.PathMatcher( [ "/a/b" ] ) )
+		self.assertEqual( m1.hash(), GafferScene.PathMatcher( [ "/a/c", "/d", "/e/*" ] ).hash() )
+
+		m1.addPaths( GafferScene.PathMatcher( [ "/a/b/x" ] ) )
+		self.assertEqual( m1.hash(), GafferScene.PathMatcher( [ "/a/b/x", "/a/c", "/d", "/e/*" ] ).hash() )
+
 if __name__ == "__main__":
 	unittest.main()
@@ -109,5 +109,38 @@ class PointConstraintTest( GafferSceneTest.SceneTestCase ) :
 		self.assertEqual( constraint["out"].fullTransform( "/group/constrained" ).translation().y, constrainedTranslate.y )
 		self.assertEqual( constraint["out"].fullTransform( "/group/constrained" ).translation().z, constrainedTranslate.z )
 
+	def testTargetComputedOnce( self ) :
+
+		target = GafferScene.Sphere()
+		target["name"].setValue( "target" )
+		target["transform"]["translate"].setValue( IECore.V3f( 1, 2, 3 ) )
+
+		plane = GafferScene.Plane()
+		duplicate = GafferScene.Duplicate()
+		duplicate["in"].setInput( plane["out"] )
+		duplicate["target"].setValue( "/plane" )
+		duplicate["copies"].setValue( 10 )
+
+		group = GafferScene.Group()
+		group["in"][0].setInput( target["out"] )
+		group["in"][1].setInput( duplicate["out"] )
+
+		constraint = GafferScene.PointConstraint()
+		constraint["target"].setValue( "/group/target" )
+		constraint["in"].setInput( group["out"] )
+
+		filter = GafferScene.PathFilter()
+		filter["paths"].setValue( IECore.StringVectorData( [ "/group/plane*" ] ) )
+		constraint["filter"].setInput( filter["out"] )
+
+		with Gaffer.PerformanceMonitor() as m :
+			for i in range( 1, 11 ) :
+				self.assertEqual(
+					constraint["out"].fullTransform( "/group/plane%d" % i ).translation(),
+					IECore.V3f( 1, 2, 3 )
+				)
+
+		self.assertEqual( m.plugStatistics( constraint["__fullTargetTransform"] ).computeCount, 1 )
+
 if __name__ == "__main__":
 	unittest.main()
@@ -102,6 +102,15 @@ class PointsTypeTest( GafferSceneTest.SceneTestCase ) :
 		pointsType["type"].setValue( "sphere" )
 		assertExpectedOutput( type = "sphere", unchanged = False )
 
+		# Test that the other variables are shared with the input
+		# rather than copied.
+
+		self.assertTrue(
+			pointsType["out"].object( "/group/object", _copy = False )["P"].data.isSame(
+				group["out"].object( "/group/object", _copy = False )["P"].data
+			)
+		)
+
 		# Test converting particles to patches. The bound should change at this point.
 
 		pointsType["type"].setValue( "patch" )
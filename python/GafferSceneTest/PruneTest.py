@@ -200,6 +200,26 @@ class PruneTest( GafferSceneTest.SceneTestCase ) :
 		self.assertEqual( prune["out"].bound( "/group" ), sphere1.bound() )
 		self.assertEqual( prune["out"].bound( "/group/sphere1" ), sphere1.bound() )
 
+	def testAdjustBoundsWithManyChildren( self ) :
+
+		sphere = GafferScene.Sphere()
+
+		duplicate = GafferScene.Duplicate()
+		duplicate["in"].setInput( sphere["out"] )
+		duplicate["target"].setValue( "/sphere" )
+		duplicate["copies"].setValue( 100 )
+		duplicate["transform"]["translate"].setValue( IECore.V3f( 1, 0, 0 ) )
+
+		filter = GafferScene.PathFilter()
+		filter["paths"].setValue( IECore.StringVectorData( [ "/sphere100", "/sphere99" ] ) )
+
+		prune = GafferScene.Prune()
+		prune["in"].setInput( duplicate["out"] )
+		prune["filter"].setInput( filter["out"] )
+		prune["adjustBounds"].setValue( True )
+
+		self.assertEqual( prune["out"].bound( "/" ), IECore.Box3f( IECore.V3f( -1 ), IECore.V3f( 99, 1, 1 ) ) )
+
 	def testLightSets( self ) :
 
 		light1 = GafferSceneTest.TestLight()
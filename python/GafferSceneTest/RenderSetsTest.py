@@ -0,0 +1,105 @@
+##########################################################################
+#
+#  Copyright (c) 2017, Image Engine Design Inc. All rights reserved.
+#
+#  Redistribution and use in source and binary forms, with or without
+#  modification, are permitted provided that the following conditions are
+#  met:
+#
+#      * Redistributions of source code must retain the above
+#        copyright notice, this list of conditions and the following
+#        disclaimer.
+#
+#      * Redistributions in binary form must reproduce the above
+#        copyright notice, this list of conditions and the following
+#        disclaimer in the documentation and/or other materials provided with
+#        the distribution.
+#
+#      * Neither the name of John Haddon nor the names of
+#        any other contributors to this software may be used to endorse or
+#        promote products derived from this software without specific prior
+#        written permission.
+#
+#  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+#  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+#  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+#  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+#  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+#  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+#  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+#  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+#  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+#  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+#  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#
+##########################################################################
+
+import unittest
+
+import IECore
+
+import Gaffer
+import GafferScene
+import GafferSceneTest
+
+class RenderSetsTest( GafferSceneTest.SceneTestCase ) :
+
+	def testSetsAttribute( self ) :
+
+		plane1 = GafferScene.Plane()
+		plane2 = GafferScene.Plane()
+		sphere = GafferScene.Sphere()
+
+		group = GafferScene.Group()
+		group["in"][0].setInput( plane1["out"] )
+		group["in"][1].setInput( plane2["out"] )
+		group["in"][2].setInput( sphere["out"] )
+
+		setA = GafferScene.Set()
+		setA["in"].setInput( group["out"] )
+		setA["name"].setValue( "render:A" )
+		setA["paths"].setValue( IECore.StringVectorData( [ "/group/plane", "/group/plane1" ] ) )
+
+		setB = GafferScene.Set()
+		setB["in"].setInput( setA["out"] )
+		setB["name"].setValue( "render:B" )
+		setB["paths"].setValue( IECore.StringVectorData( [ "/group" ] ) )
+
+		setC = GafferScene.Set()
+		setC["in"].setInput( setB["out"] )
+		setC["name"].setValue( "render:C" )
+		setC["paths"].setValue( IECore.StringVectorData( [ "/group/s*" ] ) )
+
+		setD = GafferScene.Set()
+		setD["in"].setInput( setC["out"] )
+		setD["name"].setValue( "notARenderSet" )
+		setD["paths"].setValue( IECore.StringVectorData( [ "/group" ] ) )
+
+		paths = [ "/", "/group", "/group/plane", "/group/plane1", "/group/sphere" ]
+		a = GafferSceneTest.renderSetsAttributes( setD["out"], IECore.StringVectorData( paths ) )
+
+		self.assertEqual( sorted( a["/"] ), [] )
+		self.assertEqual( sorted( a["/group"] ), [ "B" ] )
+		self.assertEqual( sorted( a["/group/plane"] ), [ "A", "B" ] )
+		self.assertEqual( sorted( a["/group/plane1"] ), [ "A", "B" ] )
+		self.assertEqual( sorted( a["/group/sphere"] ), [ "B", "C" ] )
+
+		# Locations with the same membership should share the same attribute.
+		self.assertTrue( a["/group/plane"].isSame( a["/group/plane1"] ) )
+		self.assertFalse( a["/group/plane"].isSame( a["/group/sphere"] ) )
+
+	def testRootInSet( self ) :
+
+		plane = GafferScene.Plane()
+
+		s = GafferScene.Set()
+		s["in"].setInput( plane["out"] )
+		s["name"].setValue( "render:everything" )
+		s["paths"].setValue( IECore.StringVectorData( [ "/" ] ) )
+
+		a = GafferSceneTest.renderSetsAttributes( s["out"], IECore.StringVectorData( [ "/", "/plane" ] ) )
+		self.assertEqual( list( a["/"] ), [ "everything" ] )
+		self.assertEqual( list( a["/plane"] ), [ "everything" ] )
+
+if __name__ == "__main__":
+	unittest.main()
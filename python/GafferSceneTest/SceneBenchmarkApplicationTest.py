@@ -0,0 +1,83 @@
+##########################################################################
+#
+#  Copyright (c) 2017, Image Engine Design Inc. All rights reserved.
+#
+#  Redistribution and use in source and binary forms, with or without
+#  modification, are permitted provided that the following conditions are
+#  met:
+#
+#      * Redistributions of source code must retain the above
+#        copyright notice, this list of conditions and the following
+#        disclaimer.
+#
+#      * Redistributions in binary form must reproduce the above
+#        copyright notice, this list of conditions and the following
+#        disclaimer in the documentation and/or other materials provided with
+#        the distribution.
+#
+#      * Neither the name of John Haddon nor the names of
+#        any other contributors to this software may be used to endorse or
+#        promote products derived from this software without specific prior
+#        written permission.
+#
+#  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+#  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+#  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+#  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+#  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+#  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+#  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+#  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+#  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+#  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+#  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#
+##########################################################################
+
+import os
+import json
+import unittest
+import subprocess32 as subprocess
+
+import GafferSceneTest
+
+class SceneBenchmarkApplicationTest( GafferSceneTest.SceneTestCase ) :
+
+	def testList( self ) :
+
+		o = subprocess.check_output( [ "gaffer", "sceneBenchmark", "-list" ] ).split()
+
+		self.assertTrue( "instancer/compute" in o )
+		self.assertTrue( "deepHierarchy/hash" in o )
+		self.assertTrue( "sets/sets" in o )
+
+		o = subprocess.check_output( [ "gaffer", "sceneBenchmark", "-list", "-benchmarks", "*/render" ] ).split()
+		self.assertEqual( len( o ), 5 )
+		for name in o :
+			self.assertTrue( name.endswith( "/render" ) )
+
+	def testJSON( self ) :
+
+		fileName = os.path.join( self.temporaryDirectory(), "results.json" )
+		subprocess.check_output( [
+			"gaffer", "sceneBenchmark",
+			"-benchmarks", "wideGroup/*",
+			"-width", "10",
+			"-repeats", "1",
+			"-threadCounts", "1", "2",
+			"-json", fileName
+		] )
+
+		with open( fileName ) as f :
+			results = json.load( f )
+
+		self.assertEqual( results["width"], 10 )
+		self.assertEqual( len( results["results"] ), 12 )
+		self.assertEqual( [ r["threads"] for r in results["results"] ], [ 1 ] * 6 + [ 2 ] * 6 )
+
+		for r in results["results"] :
+			# The root, the group and its ten children.
+			self.assertEqual( r["locations"], 12 )
+
+if __name__ == "__main__":
+	unittest.main()
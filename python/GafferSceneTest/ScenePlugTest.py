@@ -137,6 +137,42 @@ class ScenePlugTest( GafferSceneTest.SceneTestCase ) :
 			} )
 		)
 
+	def testFullTransformAndAttributesReflectAncestorEdits( self ) :
+
+		sphere = GafferScene.Sphere()
+		group = GafferScene.Group()
+		group["in"][0].setInput( sphere["out"] )
+
+		attributes = GafferScene.CustomAttributes()
+		attributes["in"].setInput( group["out"] )
+		attributes["attributes"].addMember( "a", IECore.IntData( 1 ) )
+		groupFilter = GafferScene.PathFilter()
+		groupFilter["paths"].setValue( IECore.StringVectorData( [ "/group" ] ) )
+		attributes["filter"].setInput( groupFilter["out"] )
+
+		# Query the child first, then the parent, then the child
+		# again, so that results from both directions are reused.
+
+		self.assertEqual( attributes["out"].fullAttributes( "/group/sphere" ), IECore.CompoundObject( { "a" : IECore.IntData( 1 ) } ) )
+		self.assertEqual( attributes["out"].fullAttributes( "/group" ), IECore.CompoundObject( { "a" : IECore.IntData( 1 ) } ) )
+		self.assertEqual( attributes["out"].fullTransform( "/group/sphere" ), IECore.M44f() )
+
+		group["transform"]["translate"].setValue( IECore.V3f( 1, 2, 3 ) )
+		attributes["attributes"]["member1"]["value"].setValue( 2 )
+
+		self.assertEqual( attributes["out"].fullAttributes( "/group/sphere" ), IECore.CompoundObject( { "a" : IECore.IntData( 2 ) } ) )
+		self.assertEqual( attributes["out"].fullTransform( "/group/sphere" ), IECore.M44f.createTranslated( IECore.V3f( 1, 2, 3 ) ) )
+
+		sphere["transform"]["translate"].setValue( IECore.V3f( 1, 0, 0 ) )
+		self.assertEqual( attributes["out"].fullTransform( "/group" ), IECore.M44f.createTranslated( IECore.V3f( 1, 2, 3 ) ) )
+		self.assertEqual( attributes["out"].fullTransform( "/group/sphere" ), IECore.M44f.createTranslated( IECore.V3f( 2, 2, 3 ) ) )
+
+		# The result must be independent of the cached value.
+
+		a = attributes["out"].fullAttributes( "/group/sphere" )
+		a["b"] = IECore.IntData( 10 )
+		self.assertEqual( attributes["out"].fullAttributes( "/group/sphere" ), IECore.CompoundObject( { "a" : IECore.IntData( 2 ) } ) )
+
 	def testCreateCounterpart( self ) :
 
 		s1 = GafferScene.ScenePlug( "a", Gaffer.Plug.Direction.Out )
@@ -451,6 +451,28 @@ class SceneReaderTest( GafferSceneTest.SceneTestCase ) :
 		self.assertEqual( s["out"].set( "ObjectType:SpherePrimitive" ).value.paths(), [ "/sphereGroup/sphere" ] )
 		self.assertEqual( s["out"].set( "ObjectType:MeshPrimitive" ).value.paths(), [ "/planeGroup/plane" ] )
 
+	def testSetsLoadedInSingleTraversal( self ) :
+
+		s = IECore.SceneCache( "/tmp/test.scc", IECore.IndexedIO.OpenMode.Write )
+		for i in range( 0, 10 ) :
+			c = s.createChild( "child%d" % i )
+			c.writeTags( [ "set%d" % i, "all" ] )
+			del c
+
+		del s
+
+		s = GafferScene.SceneReader()
+		s["fileName"].setValue( "/tmp/test.scc" )
+		s["refreshCount"].setValue( self.uniqueInt( "/tmp/test.scc" ) ) # account for our changing of file contents between tests
+
+		with Gaffer.PerformanceMonitor() as m :
+			for i in range( 0, 10 ) :
+				self.assertEqual( s["out"].set( "set%d" % i ).value.paths(), [ "/child%d" % i ] )
+			self.assertEqual( len( s["out"].set( "all" ).value.paths() ), 10 )
+			self.assertEqual( s["out"].set( "notASet" ).value.paths(), [] )
+
+		self.assertEqual( m.plugStatistics( s["__sets"] ).computeCount, 1 )
+
 	def testInvalidFiles( self ) :
 
 		reader = GafferScene.SceneReader()
@@ -492,5 +514,77 @@ class SceneReaderTest( GafferSceneTest.SceneTestCase ) :
 		r1 = GafferScene.SceneReader()
 		self.assertEqual( r1["out"].set( "blahblah" ).value.paths(), [] )
 
+	def testTagsAsSetsWithManyChildren( self ) :
+
+		s = IECore.SceneCache( "/tmp/test.scc", IECore.IndexedIO.OpenMode.Write )
+
+		expectedRed = []
+		expectedBlue = []
+		for i in range( 0, 100 ) :
+			group = s.createChild( "group%d" % i )
+			if i % 3 == 0 :
+				group.writeTags( [ "red" ] )
+				expectedRed.append( "/group%d" % i )
+			for j in range( 0, 10 ) :
+				child = group.createChild( "child%d" % j )
+				child.writeObject( IECore.SpherePrimitive(), 0 )
+				if ( i + j ) % 7 == 0 :
+					child.writeTags( [ "blue" ] )
+					expectedBlue.append( "/group%d/child%d" % ( i, j ) )
+				del child
+			del group
+
+		del s
+
+		s = GafferScene.SceneReader()
+		s["fileName"].setValue( "/tmp/test.scc" )
+		s["refreshCount"].setValue( self.uniqueInt( "/tmp/test.scc" ) ) # account for our changing of file contents between tests
+
+		self.assertEqual( set( s["out"].set( "red" ).value.paths() ), set( expectedRed ) )
+		self.assertEqual( set( s["out"].set( "blue" ).value.paths() ), set( expectedBlue ) )
+
+		s["tags"].setValue( "blue" )
+		self.assertEqual(
+			set( [ str( c ) for c in s["out"].childNames( "/" ) ] ),
+			set( [ p.split( "/" )[1] for p in expectedBlue ] )
+		)
+
+	def testParallelReads( self ) :
+
+		s = IECore.SceneCache( "/tmp/test.scc", IECore.IndexedIO.OpenMode.Write )
+		for i in range( 0, 50 ) :
+			group = s.createChild( "group%d" % i )
+			for j in range( 0, 20 ) :
+				child = group.createChild( "child%d" % j )
+				child.writeTransform( IECore.M44dData( IECore.M44d.createTranslated( IECore.V3d( i, j, 0 ) ) ), 0.0 )
+				child.writeObject( IECore.SpherePrimitive(), 0.0 )
+				del child
+			del group
+
+		del s
+
+		reader = GafferScene.SceneReader()
+		reader["fileName"].setValue( "/tmp/test.scc" )
+		reader["refreshCount"].setValue( self.uniqueInt( "/tmp/test.scc" ) ) # account for our changing of file contents between tests
+
+		GafferSceneTest.traverseScene( reader["out"] )
+
+		for i in range( 0, 50, 7 ) :
+			for j in range( 0, 20, 3 ) :
+				path = "/group%d/child%d" % ( i, j )
+				self.assertEqual( reader["out"].transform( path ), IECore.M44f.createTranslated( IECore.V3f( i, j, 0 ) ) )
+				self.assertTrue( isinstance( reader["out"].object( path ), IECore.SpherePrimitive ) )
+
+		# Refreshing should pick up changes to the file, even
+		# though each thread holds its own handle to it.
+
+		s = IECore.SceneCache( "/tmp/test.scc", IECore.IndexedIO.OpenMode.Write )
+		s.createChild( "newGroup" )
+		del s
+
+		reader["refreshCount"].setValue( self.uniqueInt( "/tmp/test.scc" ) )
+		GafferSceneTest.traverseScene( reader["out"] )
+		self.assertEqual( reader["out"].childNames( "/" ), IECore.InternedStringVectorData( [ "newGroup" ] ) )
+
 if __name__ == "__main__":
 	unittest.main()
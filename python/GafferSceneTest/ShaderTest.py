@@ -250,5 +250,49 @@ class ShaderTest( GafferSceneTest.SceneTestCase ) :
 				self.assertEqual( network[0].parameters["i"].value, effectiveIndex + 1 )
 				self.assertEqual( network[1].parameters["c"].value, "link:" + network[0].parameters["__handle"].value )
 
+	def testNetworksShared( self ) :
+
+		s = Gaffer.ScriptNode()
+
+		s["texture"] = GafferSceneTest.TestShader()
+		s["texture"]["type"].setValue( "test:shader" )
+		s["texture"]["parameters"]["i"].setValue( 1 )
+
+		s["surface"] = GafferSceneTest.TestShader()
+		s["surface"]["type"].setValue( "test:surface" )
+		s["surface"]["parameters"]["c"].setInput( s["texture"]["out"] )
+
+		s["plane"] = GafferScene.Plane()
+		s["sphere"] = GafferScene.Sphere()
+		s["group"] = GafferScene.Group()
+		s["group"]["in"][0].setInput( s["plane"]["out"] )
+		s["group"]["in"][1].setInput( s["sphere"]["out"] )
+
+		s["assignment1"] = GafferScene.ShaderAssignment()
+		s["assignment1"]["in"].setInput( s["group"]["out"] )
+		s["assignment1"]["shader"].setInput( s["surface"]["out"] )
+
+		s["assignment2"] = GafferScene.ShaderAssignment()
+		s["assignment2"]["in"].setInput( s["assignment1"]["out"] )
+		s["assignment2"]["shader"].setInput( s["surface"]["out"] )
+
+		# The same network should be shared by every location
+		# and every assignment, rather than being rebuilt for each.
+
+		a1 = s["assignment1"]["out"].attributes( "/group/plane" )["test:surface"]
+		a2 = s["assignment1"]["out"].attributes( "/group/sphere" )["test:surface"]
+		a3 = s["assignment2"]["out"].attributes( "/group/plane" )["test:surface"]
+		self.assertTrue( a1.isSame( a2 ) )
+		self.assertTrue( a1.isSame( a3 ) )
+		self.assertTrue( a1.isSame( s["surface"].attributes()["test:surface"] ) )
+
+		# But changes must still be reflected.
+
+		s["texture"]["parameters"]["i"].setValue( 2 )
+		a4 = s["assignment2"]["out"].attributes( "/group/plane" )["test:surface"]
+		self.assertFalse( a4.isSame( a1 ) )
+		self.assertEqual( a4[0].parameters["i"].value, 2 )
+		self.assertEqual( a1[0].parameters["i"].value, 1 )
+
 if __name__ == "__main__":
 	unittest.main()
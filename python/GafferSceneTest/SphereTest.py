@@ -209,5 +209,68 @@ class SphereTest( GafferSceneTest.SceneTestCase ) :
 		self.assertNotEqual( s1["out"].childNames( "/" ), s2["out"].childNames( "/" ) )
 		self.assertTrue( s1["out"].childNames( "/sphere1", _copy=False ).isSame( s2["out"].childNames( "sphere2", _copy=False ) ) )
 
+	def testLevelOfDetail( self ) :
+
+		s = GafferScene.Sphere()
+		s["type"].setValue( GafferScene.Sphere.Type.Mesh )
+		s["divisions"].setValue( IECore.V2i( 20, 40 ) )
+
+		fullDetail = s["out"].object( "/sphere" )
+		fullDetailHash = s["out"].objectHash( "/sphere" )
+
+		c = Gaffer.Context()
+		c["scene:lod"] = 1
+		with c :
+			self.assertNotEqual( s["out"].objectHash( "/sphere" ), fullDetailHash )
+			reducedDetail = s["out"].object( "/sphere" )
+
+		self.assertEqual(
+			reducedDetail,
+			IECore.MeshPrimitive.createSphere( 1, -1, 1, 360, IECore.V2i( 10, 20 ) )
+		)
+		self.assertLess( reducedDetail.numFaces(), fullDetail.numFaces() )
+
+		# Divisions are never reduced below the minimum.
+
+		c["scene:lod"] = 10
+		with c :
+			self.assertEqual(
+				s["out"].object( "/sphere" ),
+				IECore.MeshPrimitive.createSphere( 1, -1, 1, 360, IECore.V2i( 3, 6 ) )
+			)
+
+	def testHashesSharedBetweenFrames( self ) :
+
+		s = GafferScene.Sphere()
+
+		m = Gaffer.PerformanceMonitor()
+		with m :
+			hashes = set()
+			for frame in range( 1, 4 ) :
+				with Gaffer.Context() as c :
+					c.setFrame( frame )
+					c["myVariable"] = frame
+					hashes.add( str( s["out"].objectHash( "/sphere" ) ) )
+
+		# None of our inputs vary with context, so the frame and
+		# other variables are ignored by the hash cache.
+		self.assertEqual( len( hashes ), 1 )
+		self.assertEqual( m.plugStatistics( s["out"]["object"] ).hashCount, 1 )
+
+		# But if they do vary, each frame must be hashed separately.
+
+		add = GafferTest.AddNode()
+		s["user"]["i"] = Gaffer.IntPlug( flags = Gaffer.Plug.Flags.Default | Gaffer.Plug.Flags.Dynamic )
+		s["user"]["i"].setInput( add["sum"] )
+
+		m = Gaffer.PerformanceMonitor()
+		with m :
+			for frame in range( 1, 4 ) :
+				with Gaffer.Context() as c :
+					c.setFrame( frame )
+					s["out"].objectHash( "/sphere" )
+
+		self.assertEqual( m.plugStatistics( s["out"]["object"] ).hashCount, 3 )
+
 if __name__ == "__main__":
 	unittest.main()
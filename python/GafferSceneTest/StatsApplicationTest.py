@@ -0,0 +1,151 @@
+##########################################################################
+#
+#  Copyright (c) 2017, Image Engine Design Inc. All rights reserved.
+#
+#  Redistribution and use in source and binary forms, with or without
+#  modification, are permitted provided that the following conditions are
+#  met:
+#
+#      * Redistributions of source code must retain the above
+#        copyright notice, this list of conditions and the following
+#        disclaimer.
+#
+#      * Redistributions in binary form must reproduce the above
+#        copyright notice, this list of conditions and the following
+#        disclaimer in the documentation and/or other materials provided with
+#        the distribution.
+#
+#      * Neither the name of John Haddon nor the names of
+#        any other contributors to this software may be used to endorse or
+#        promote products derived from this software without specific prior
+#        written permission.
+#
+#  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+#  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+#  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+#  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+#  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+#  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+#  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+#  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+#  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+#  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+#  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#
+##########################################################################
+import os
+import json
+import unittest
+import subprocess32 as subprocess
+
+import Gaffer
+import GafferScene
+import GafferSceneTest
+
+class StatsApplicationTest( GafferSceneTest.SceneTestCase ) :
+
+	def __writeScript( self ) :
+
+		script = Gaffer.ScriptNode()
+
+		script["sphere"] = GafferScene.Sphere()
+		script["instancer"] = GafferScene.Instancer()
+		script["instancer"]["in"].setInput( script["sphere"]["out"] )
+		script["instancer"]["instance"].setInput( script["sphere"]["out"] )
+		script["instancer"]["parent"].setValue( "/sphere" )
+
+		script["fileName"].setValue( os.path.join( self.temporaryDirectory(), "script.gfr" ) )
+		script.save()
+
+		return script
+
+	def testIterations( self ) :
+
+		script = self.__writeScript()
+		fileName = os.path.join( self.temporaryDirectory(), "stats.json" )
+
+		o = subprocess.check_output( [
+			"gaffer", "stats", script["fileName"].getValue(),
+			"-scene", "instancer",
+			"-iterations", "3",
+			"-memorySampleInterval", "0.01",
+			"-json", fileName,
+		] )
+
+		self.assertTrue( "Scene generation (2 warm)" in o )
+		self.assertTrue( "Scene generation (peak RSS)" in o )
+
+		with open( fileName ) as f :
+			stats = json.load( f )
+
+		self.assertTrue( "Scene generation" in stats["timers"] )
+		iterations = stats["iterations"]["Scene generation"]
+		self.assertEqual( iterations["cache"], "warm" )
+		self.assertEqual( len( iterations["wallTimes"] ), 2 )
+		self.assertLessEqual( iterations["min"], iterations["median"] )
+		self.assertLessEqual( iterations["median"], iterations["max"] )
+		self.assertGreater( len( stats["memorySamples"]["Scene generation"] ), 0 )
+
+	def testClearCaches( self ) :
+
+		script = self.__writeScript()
+		fileName = os.path.join( self.temporaryDirectory(), "stats.json" )
+
+		subprocess.check_output( [
+			"gaffer", "stats", script["fileName"].getValue(),
+			"-scene", "instancer",
+			"-iterations", "2",
+			"-clearCaches",
+			"-json", fileName,
+		] )
+
+		with open( fileName ) as f :
+			stats = json.load( f )
+
+		iterations = stats["iterations"]["Scene generation"]
+		self.assertEqual( iterations["cache"], "cold" )
+		self.assertEqual( len( iterations["wallTimes"] ), 2 )
+
+	def testThreadCounts( self ) :
+
+		script = self.__writeScript()
+		fileName = os.path.join( self.temporaryDirectory(), "stats.json" )
+
+		o = subprocess.check_output( [
+			"gaffer", "stats", script["fileName"].getValue(),
+			"-scene", "instancer",
+			"-threadCounts", "1", "2",
+			"-json", fileName,
+		] )
+
+		self.assertTrue( "Scene generation (1 threads)" in o )
+		self.assertTrue( "Scene generation (2 threads)" in o )
+
+		with open( fileName ) as f :
+			stats = json.load( f )
+
+		self.assertEqual( [ s["threads"] for s in stats["threadCounts"] ], [ 1, 2 ] )
+
+	def testHotspotMonitor( self ) :
+
+		script = self.__writeScript()
+		fileName = os.path.join( self.temporaryDirectory(), "stats.json" )
+
+		o = subprocess.check_output( [
+			"gaffer", "stats", script["fileName"].getValue(),
+			"-scene", "instancer",
+			"-hotspotMonitor",
+			"-json", fileName,
+		] )
+
+		self.assertTrue( "Most expensive locations" in o )
+
+		with open( fileName ) as f :
+			stats = json.load( f )
+
+		self.assertGreater( len( stats["hotspots"] ), 0 )
+		for h in stats["hotspots"] :
+			self.assertTrue( "scene:path" in h["variables"] )
+
+if __name__ == "__main__":
+	unittest.main()
@@ -0,0 +1,155 @@
+##########################################################################
+#
+#  Copyright (c) 2017, Image Engine Design Inc. All rights reserved.
+#
+#  Redistribution and use in source and binary forms, with or without
+#  modification, are permitted provided that the following conditions are
+#  met:
+#
+#      * Redistributions of source code must retain the above
+#        copyright notice, this list of conditions and the following
+#        disclaimer.
+#
+#      * Redistributions in binary form must reproduce the above
+#        copyright notice, this list of conditions and the following
+#        disclaimer in the documentation and/or other materials provided with
+#        the distribution.
+#
+#      * Neither the name of John Haddon nor the names of
+#        any other contributors to this software may be used to endorse or
+#        promote products derived from this software without specific prior
+#        written permission.
+#
+#  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+#  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+#  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+#  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+#  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+#  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+#  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+#  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+#  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+#  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+#  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#
+##########################################################################
+
+import unittest
+
+import IECore
+
+import Gaffer
+import GafferScene
+import GafferSceneTest
+
+class TestRenderersTest( GafferSceneTest.SceneTestCase ) :
+
+	def testCapturing( self ) :
+
+		sphere = GafferScene.Sphere()
+		light = GafferSceneTest.TestLight()
+
+		group = GafferScene.Group()
+		group["in"][0].setInput( sphere["out"] )
+		group["in"][1].setInput( light["out"] )
+
+		attributes = GafferScene.CustomAttributes()
+		attributes["in"].setInput( group["out"] )
+		attributes["attributes"].addMember( "user:test", IECore.IntData( 10 ) )
+
+		filter = GafferScene.PathFilter()
+		filter["paths"].setValue( IECore.StringVectorData( [ "/group/sphere" ] ) )
+		attributes["filter"].setInput( filter["out"] )
+
+		captured = GafferSceneTest.outputScene( attributes["out"], "Capturing" )
+
+		self.assertEqual( captured["/group/sphere"]["type"], IECore.StringData( "object" ) )
+		self.assertEqual( captured["/group/sphere"]["samples"], IECore.IntData( 1 ) )
+		self.assertEqual( captured["/group/light"]["type"], IECore.StringData( "light" ) )
+		self.assertTrue( "gaffer:defaultCamera" in captured )
+
+		attributes["attributes"][0]["value"].setValue( 20 )
+		captured2 = GafferSceneTest.outputScene( attributes["out"], "Capturing" )
+
+		self.assertNotEqual( captured["/group/sphere"]["attributesHash"], captured2["/group/sphere"]["attributesHash"] )
+		self.assertEqual( captured["/group/light"]["attributesHash"], captured2["/group/light"]["attributesHash"] )
+
+	def testStatistics( self ) :
+
+		sphere = GafferScene.Sphere()
+		light = GafferSceneTest.TestLight()
+
+		group = GafferScene.Group()
+		group["in"][0].setInput( sphere["out"] )
+		group["in"][1].setInput( light["out"] )
+		group["in"][2].setInput( sphere["out"] )
+
+		statistics = GafferSceneTest.outputSceneStatistics( group["out"], "Capturing" )
+		self.assertEqual( statistics["objects"], IECore.UInt64Data( 2 ) )
+		self.assertEqual( statistics["lights"], IECore.UInt64Data( 1 ) )
+		# The default camera
+		self.assertEqual( statistics["cameras"], IECore.UInt64Data( 1 ) )
+
+		# Renderers that don't report anything use the default implementation.
+		self.assertEqual( GafferSceneTest.outputSceneStatistics( group["out"], "Null" ), IECore.CompoundData() )
+
+	def testNull( self ) :
+
+		sphere = GafferScene.Sphere()
+		self.assertEqual( GafferSceneTest.outputScene( sphere["out"], "Null" ), None )
+
+	def testUnknownRenderer( self ) :
+
+		sphere = GafferScene.Sphere()
+		self.assertRaises( RuntimeError, GafferSceneTest.outputScene, sphere["out"], "NonExistentRenderer" )
+
+	def testDeepHierarchyPerformance( self ) :
+
+		sphere = GafferScene.Sphere()
+		lastPlug = sphere["out"]
+
+		groups = []
+		for i in range( 0, 12 ) :
+			group = GafferScene.Group()
+			group["in"][0].setInput( lastPlug )
+			group["in"][1].setInput( lastPlug )
+			groups.append( group )
+			lastPlug = group["out"]
+
+		GafferSceneTest.outputScene( lastPlug, "Null" )
+
+	def testWideInstancerPerformance( self ) :
+
+		plane = GafferScene.Plane()
+		plane["divisions"].setValue( IECore.V2i( 100 ) )
+
+		sphere = GafferScene.Sphere()
+
+		instancer = GafferScene.Instancer()
+		instancer["in"].setInput( plane["out"] )
+		instancer["instance"].setInput( sphere["out"] )
+		instancer["parent"].setValue( "/plane" )
+
+		GafferSceneTest.outputScene( instancer["out"], "Null" )
+
+	def testHeavyAttributesPerformance( self ) :
+
+		sphere = GafferScene.Sphere()
+
+		group = GafferScene.Group()
+		for i in range( 0, 100 ) :
+			group["in"][i].setInput( sphere["out"] )
+
+		attributes = GafferScene.CustomAttributes()
+		attributes["in"].setInput( group["out"] )
+		for i in range( 0, 100 ) :
+			attributes["attributes"].addMember( "user:test%d" % i, IECore.StringData( "x" * 100 ) )
+
+		filter = GafferScene.PathFilter()
+		filter["paths"].setValue( IECore.StringVectorData( [ "/group/*" ] ) )
+		attributes["filter"].setInput( filter["out"] )
+
+		GafferSceneTest.outputScene( attributes["out"], "Null" )
+
+if __name__ == "__main__":
+	unittest.main()
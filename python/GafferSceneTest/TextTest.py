@@ -98,5 +98,34 @@ class TextTest( GafferSceneTest.SceneTestCase ) :
 		self.assertFalse( "out.childNames" in [ x[0].relativeName( x[0].node() ) for x in s ] )
 		self.assertFalse( "out.transform" in [ x[0].relativeName( x[0].node() ) for x in s ] )
 
+	def testFrameSubstitutions( self ) :
+
+		t = GafferScene.Text()
+		t["text"].setValue( "${frame}" )
+
+		hashes = set()
+		for frame in range( 1, 4 ) :
+			with Gaffer.Context() as c :
+				c.setFrame( frame )
+				hashes.add( str( t["out"].objectHash( "/text" ) ) )
+
+		self.assertEqual( len( hashes ), 3 )
+
+	def testRepeatedCharacters( self ) :
+
+		t = GafferScene.Text()
+
+		t["text"].setValue( "o" )
+		m1 = t["out"].object( "/text" )
+
+		t["text"].setValue( "ooo" )
+		m3 = t["out"].object( "/text" )
+
+		self.assertTrue( m3.arePrimitiveVariablesValid() )
+		self.assertEqual( m3.numFaces(), m1.numFaces() * 3 )
+		self.assertEqual( m3["P"].data.size(), m1["P"].data.size() * 3 )
+		self.assertGreater( m3.bound().size().x, m1.bound().size().x * 2.5 )
+		self.assertAlmostEqual( m3.bound().size().y, m1.bound().size().y, delta = 0.0001 )
+
 if __name__ == "__main__":
 	unittest.main()
@@ -100,6 +100,7 @@ from FreezeTransformTest import FreezeTransformTest
 from SetFilterTest import SetFilterTest
 from FilterTest import FilterTest
 from SceneAlgoTest import SceneAlgoTest
+from ArchiveAlgoTest import ArchiveAlgoTest
 from CoordinateSystemTest import CoordinateSystemTest
 from DeleteOutputsTest import DeleteOutputsTest
 from ExternalProceduralTest import ExternalProceduralTest
@@ -117,6 +118,12 @@ from FilteredSceneProcessorTest import FilteredSceneProcessorTest
 from ShaderBallTest import ShaderBallTest
 from LightTweaksTest import LightTweaksTest
 from FilterResultsTest import FilterResultsTest
+from TestRenderersTest import TestRenderersTest
+from SceneBenchmarkApplicationTest import SceneBenchmarkApplicationTest
+from StatsApplicationTest import StatsApplicationTest
+from RenderSetsTest import RenderSetsTest
+from EncapsulateTest import EncapsulateTest
+from MeshAlgoTest import MeshAlgoTest
 
 if __name__ == "__main__":
 	import unittest
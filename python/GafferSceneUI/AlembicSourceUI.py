@@ -65,6 +65,9 @@ Gaffer.Metadata.registerNode(
 			"""
 			The path to the .abc file to load. Both
 			older HDF5 and newer Ogawa caches are supported.
+			The path may reference the ${scene:lod} context
+			variable to load a lower resolution file in the
+			Viewer than in a final render.
 			""",
 
 			"plugValueWidget:type", "GafferUI.FileSystemPathPlugValueWidget",
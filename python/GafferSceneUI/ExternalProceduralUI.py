@@ -78,6 +78,19 @@ Gaffer.Metadata.registerNode(
 
 		],
 
+		"useArchiveBound" : [
+
+			"description",
+			"""
+			Reads the bounding box from the archive itself, rather
+			than using the bound specified above. Archive bounds are
+			cached, so each file is only read once unless it changes
+			on disk. The bound above is used if the archive doesn't
+			provide one.
+			""",
+
+		],
+
 
 		"parameters" : [
 
@@ -34,6 +34,8 @@
 #
 ##########################################################################
 
+import weakref
+
 import Gaffer
 import GafferScene
 import GafferUI
@@ -56,6 +58,14 @@ class _StatePlugValueWidget( GafferUI.PlugValueWidget ) :
 			self.__startPauseClickedConnection = self.__startPauseButton.clickedSignal().connect( Gaffer.WeakMethod( self.__startPauseClicked ) )
 			self.__pauseClickedConnection = self.__stopButton.clickedSignal().connect( Gaffer.WeakMethod( self.__stopClicked ) )
 
+			self.__statisticsButton = None
+			if isinstance( plug.node(), GafferScene.Preview.InteractiveRender ) :
+				self.__statisticsButton = GafferUI.Button( "Statistics" )
+				self.__statisticsButton.setToolTip( "Shows the statistics reported by the renderer" )
+				self.__statisticsClickedConnection = self.__statisticsButton.clickedSignal().connect( Gaffer.WeakMethod( self.__statisticsClicked ) )
+
+		self.__statisticsWindow = None
+
 		self._updateFromPlug()
 
 	def _updateFromPlug( self ) :
@@ -88,6 +98,32 @@ class _StatePlugValueWidget( GafferUI.PlugValueWidget ) :
 	def __stopClicked( self, button ) :
 		self.getPlug().setValue( GafferScene.InteractiveRender.State.Stopped )
 
+	def __statisticsClicked( self, button ) :
+
+		if self.__statisticsWindow is None or self.__statisticsWindow() is None :
+			window = GafferUI.Window(
+				title = self.getPlug().node().relativeName( self.getPlug().ancestor( Gaffer.ScriptNode ) ) + " Statistics",
+				borderWidth = 8,
+			)
+			window.setChild( GafferUI.MultiLineTextWidget( editable = False, role = GafferUI.MultiLineTextWidget.Role.Code ) )
+			self.ancestor( GafferUI.Window ).addChildWindow( window )
+			self.__statisticsWindow = weakref.ref( window )
+
+		statistics = self.getPlug().node().rendererStatistics()
+		if statistics is None :
+			text = "The render is not running."
+		elif not len( statistics ) :
+			text = "The renderer does not report any statistics."
+		else :
+			width = max( len( k ) for k in statistics.keys() ) + 4
+			text = "\n".join(
+				"{name:<{width}}{value}".format( name = k, width = width, value = statistics[k].value )
+				for k in sorted( statistics.keys() )
+			)
+
+		self.__statisticsWindow().getChild().setText( text )
+		self.__statisticsWindow().setVisible( True )
+
 ##########################################################################
 # Metadata for GafferScene.Preview.InteractiveRender node. We intend
 # for this to entirely replace the GafferScene.InteractiveRender node
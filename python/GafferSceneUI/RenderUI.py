@@ -97,6 +97,23 @@ Gaffer.Metadata.registerNode(
 
 		],
 
+		"cameras" : [
+
+			"description",
+			"""
+			The cameras to render. When empty, the render camera
+			specified by the StandardOptions is used. Otherwise the
+			scene is translated only once, and then rendered from each
+			camera in turn. The globals are reevaluated for each camera
+			with a "render:camera" context variable containing the
+			camera's path, so outputs can be given a unique filename
+			using "${render:camera}". In scene description mode, a file
+			is written for each camera, so the fileName should also
+			contain "${render:camera}".
+			""",
+
+		],
+
 		"out" : [
 
 			"description",
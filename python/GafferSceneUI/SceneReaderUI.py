@@ -69,6 +69,10 @@ Gaffer.Metadata.registerNode(
 			"""
 			The name of the file to be loaded. The file can be
 			in any of the formats supported by Cortex's SceneInterfaces.
+			The name may reference the ${scene:lod} context variable
+			to load a lower resolution file in the Viewer, where it
+			has a value of 1, than in a final render, where it is
+			0.
 			""",
 
 			"plugValueWidget:type", "GafferUI.FileSystemPathPlugValueWidget",
@@ -36,6 +36,8 @@
 ##########################################################################
 
 import functools
+import threading
+import weakref
 
 import IECore
 
@@ -78,6 +80,40 @@ Gaffer.Metadata.registerNode(
 
 		],
 
+		"prefetch" : [
+
+			"description",
+			"""
+			Computes upcoming frames in a background thread, so that
+			playback and timeline scrubbing are served from the cache.
+			Frames which have been prefetched are marked on the Timeline.
+			""",
+			"plugValueWidget:type", "GafferSceneUI.SceneViewUI._PrefetchPlugValueWidget",
+			"toolbarLayout:label", "",
+
+		],
+
+		"prefetch.enabled" : [
+
+			"description",
+			"""
+			Turns prefetching on and off.
+			""",
+
+		],
+
+		"prefetch.frames" : [
+
+			"description",
+			"""
+			The number of frames following the current frame to prefetch.
+			Prefetching also stops early if the cache memory usage
+			reaches half of the cache memory limit, so that the current
+			frame isn't evicted to make space for later ones.
+			""",
+
+		],
+
 		"lookThrough" : [
 
 			"plugValueWidget:type", "GafferSceneUI.SceneViewUI._LookThroughPlugValueWidget",
@@ -256,6 +292,207 @@ class _ExpansionPlugValueWidget( GafferUI.PlugValueWidget ) :
 
 		self.getPlug().setValue( 0 if self.getPlug().getValue() else 999 )
 
+##########################################################################
+# _PrefetchPlugValueWidget
+##########################################################################
+
+class _PrefetchPlugValueWidget( GafferUI.PlugValueWidget ) :
+
+	def __init__( self, plug, **kw ) :
+
+		menu = GafferUI.Menu( Gaffer.WeakMethod( self.__menuDefinition ) )
+		menuButton = GafferUI.MenuButton( menu=menu, image = "timeline3.png", hasFrame=False )
+
+		GafferUI.PlugValueWidget.__init__( self, menuButton, plug, **kw )
+
+		self.__prefetcher = _Prefetcher( plug.node() )
+
+	def hasLabel( self ) :
+
+		return True
+
+	def _updateFromPlug( self ) :
+
+		pass
+
+	def __menuDefinition( self ) :
+
+		enabled = self.getPlug()["enabled"].getValue()
+		numFrames = self.getPlug()["frames"].getValue()
+
+		m = IECore.MenuDefinition()
+		m.append( "/Prefetch Frames", { "checkBox" : enabled, "command" : self.getPlug()["enabled"].setValue } )
+		m.append( "/Frames Divider", { "divider" : True } )
+		for n in ( 5, 10, 25, 50, 100 ) :
+			m.append(
+				"/%d Frames" % n,
+				{
+					"checkBox" : n == numFrames,
+					"active" : enabled,
+					"command" : functools.partial( Gaffer.WeakMethod( self.__setFrames ), n ),
+				}
+			)
+
+		return m
+
+	def __setFrames( self, numFrames, *unused ) :
+
+		self.getPlug()["frames"].setValue( numFrames )
+
+## Computes the transforms, bounds, attributes and objects for the
+# visible part of the scene on upcoming frames, using a background
+# thread. Finished frames are reported to the Playback for the view's
+# context so they can be displayed by the Timeline.
+#
+# > Note : We only populate the compute cache. Conversion to OpenGL
+# > must happen on the UI thread where the GL context is current, and
+# > is already budgeted by the SceneGadget.
+class _Prefetcher( object ) :
+
+	# The fraction of the cache memory limit we are willing to
+	# fill with prefetched frames.
+	__memoryBudget = 0.5
+
+	def __init__( self, view ) :
+
+		self.__view = view
+		self.__generation = 0
+		self.__cachedFrames = set()
+
+		self.__plugSetConnection = view.plugSetSignal().connect( Gaffer.WeakMethod( self.__plugSet ) )
+		self.__plugDirtiedConnection = view.plugDirtiedSignal().connect( Gaffer.WeakMethod( self.__plugDirtied ) )
+		self.__viewContextChangedConnection = view.contextChangedSignal().connect( Gaffer.WeakMethod( self.__viewContextChanged ) )
+
+		self.__viewContextChanged( view )
+
+	def __viewContextChanged( self, view ) :
+
+		self.__contextChangedConnection = view.getContext().changedSignal().connect( Gaffer.WeakMethod( self.__contextChanged ) )
+		self.__invalidate()
+
+	def __contextChanged( self, context, name ) :
+
+		if name == "frame" :
+			self.__update()
+		elif not name.startswith( "ui:" ) or name == "ui:scene:expandedPaths" :
+			self.__invalidate()
+
+	def __plugSet( self, plug ) :
+
+		prefetchPlug = self.__view["prefetch"]
+		if plug.isSame( prefetchPlug ) or prefetchPlug.isAncestorOf( plug ) or plug.isSame( self.__view["minimumExpansionDepth"] ) :
+			self.__invalidate()
+
+	def __plugDirtied( self, plug ) :
+
+		if plug.isSame( self.__view["in"] ) :
+			self.__invalidate()
+
+	def __invalidate( self ) :
+
+		self.__cachedFrames = set()
+		self.__update()
+
+	def __update( self ) :
+
+		# Cancel any prefetch already in progress.
+		self.__generation += 1
+
+		context = self.__view.getContext()
+		frame = context.getFrame()
+
+		frames = []
+		if self.__view["prefetch"]["enabled"].getValue() :
+			numFrames = self.__view["prefetch"]["frames"].getValue()
+			frames = [ frame + i for i in range( 1, numFrames + 1 ) ]
+
+		# Frames we have moved past are likely to have been evicted by
+		# the time we return to them, so we only report those ahead.
+		self.__cachedFrames = set( f for f in self.__cachedFrames if f in frames )
+		self.__updatePlayback()
+
+		frames = [ f for f in frames if f not in self.__cachedFrames ]
+		if not frames :
+			return
+
+		thread = threading.Thread(
+			target = IECore.curry(
+				_Prefetcher.__prefetch,
+				weakref.ref( self ),
+				self.__generation,
+				self.__view["in"],
+				Gaffer.Context( context ),
+				context.get( "ui:scene:expandedPaths", GafferScene.PathMatcherData() ),
+				self.__view["minimumExpansionDepth"].getValue(),
+				frames
+			)
+		)
+		thread.daemon = True
+		thread.start()
+
+	def __updatePlayback( self ) :
+
+		GafferUI.Playback.acquire( self.__view.getContext() ).setCachedFrames( self.__cachedFrames )
+
+	@staticmethod
+	def __prefetch( selfWeakRef, generation, scene, context, expandedPaths, minimumExpansionDepth, frames ) :
+
+		memoryLimit = Gaffer.ValuePlug.getCacheMemoryLimit() * _Prefetcher.__memoryBudget
+
+		for frame in frames :
+
+			self = selfWeakRef()
+			if self is None or self.__generation != generation :
+				return
+			del self
+
+			if Gaffer.ValuePlug.cacheMemoryUsage() > memoryLimit :
+				return
+
+			frameContext = Gaffer.Context( context )
+			frameContext.setFrame( frame )
+			try :
+				_prefetchFrame( scene, frameContext, expandedPaths.value, minimumExpansionDepth )
+			except :
+				# Errors will be reported by the viewer itself if
+				# and when the user moves to this frame.
+				return
+
+			GafferUI.EventLoop.executeOnUIThread( IECore.curry( _Prefetcher.__frameCached, selfWeakRef, generation, frame ) )
+
+	@staticmethod
+	def __frameCached( selfWeakRef, generation, frame ) :
+
+		self = selfWeakRef()
+		if self is None or self.__generation != generation :
+			return
+
+		self.__cachedFrames.add( frame )
+		self.__updatePlayback()
+
+def _prefetchFrame( scene, context, expandedPaths, minimumExpansionDepth ) :
+
+	paths = []
+	with context :
+		toVisit = [ ( "/", 0 ) ]
+		while toVisit :
+			path, depth = toVisit.pop()
+			paths.append( path )
+			if depth < minimumExpansionDepth or expandedPaths.match( path ) & GafferScene.Filter.Result.ExactMatch :
+				for childName in scene.childNames( path ) :
+					toVisit.append( ( path.rstrip( "/" ) + "/" + str( childName ), depth + 1 ) )
+
+	plugs = []
+	contexts = []
+	for path in paths :
+		pathContext = Gaffer.Context( context )
+		pathContext["scene:path"] = GafferScene.ScenePlug.stringToPath( path )
+		for plug in ( scene["transform"], scene["bound"], scene["attributes"], scene["object"] ) :
+			plugs.append( plug )
+			contexts.append( pathContext )
+
+	Gaffer.ValuePlug.prefetch( plugs, contexts )
+
 ##########################################################################
 # _LookThroughPlugValueWidget
 ##########################################################################
@@ -336,7 +336,10 @@ Gaffer.Metadata.registerNode(
 			"description",
 			"""
 			Enables a performance monitor and uses it to output
-			statistics about scene generation performance.
+			statistics about scene generation performance. The
+			statistics reported by the renderer are output too,
+			along with the time taken to generate the scene and
+			to render it.
 			""",
 
 			"layout:section", "Statistics",
@@ -153,6 +153,189 @@ class SceneGadgetTest( GafferUITest.TestCase ) :
 		self.assertObjectAt( sg, IECore.V2f( 0.5 ), None )
 		self.assertObjectsAt( sg, IECore.Box2f( IECore.V2f( 0 ), IECore.V2f( 1 ) ), [ "/group" ] )
 
+	def testUpdateBudget( self ) :
+
+		s = Gaffer.ScriptNode()
+		s["s"] = GafferScene.Sphere()
+		s["g1"] = GafferScene.Group()
+		s["g1"]["in"][0].setInput( s["s"]["out"] )
+		s["g2"] = GafferScene.Group()
+		s["g2"]["in"][0].setInput( s["g1"]["out"] )
+		s["g3"] = GafferScene.Group()
+		s["g3"]["in"][0].setInput( s["g2"]["out"] )
+
+		sg = GafferSceneUI.SceneGadget()
+		self.assertEqual( sg.getUpdateBudget(), 0 )
+		sg.setUpdateBudget( 0.000001 )
+		self.assertAlmostEqual( sg.getUpdateBudget(), 0.000001 )
+
+		sg.setMinimumExpansionDepth( 4 )
+		sg.setScene( s["g3"]["out"] )
+		self.assertTrue( sg.updatePending() )
+
+		# Bound queries always complete the update.
+
+		self.assertEqual( sg.bound(), s["g3"]["out"].bound( "/" ) )
+		self.assertFalse( sg.updatePending() )
+
+		# Drawing only updates as much as the budget allows, but
+		# keeps requesting redraws until the update is complete.
+
+		with GafferUI.Window() as w :
+			gw = GafferUI.GadgetWidget( sg )
+
+		w.setVisible( True )
+		self.waitForIdle( 1000 )
+
+		gw.getViewportGadget().frame( sg.bound() )
+
+		s["s"]["radius"].setValue( 2 )
+		self.assertTrue( sg.updatePending() )
+
+		for i in range( 0, 100 ) :
+			if not sg.updatePending() :
+				break
+			self.waitForIdle( 100 )
+
+		self.assertFalse( sg.updatePending() )
+		self.assertObjectAt( sg, IECore.V2f( 0.5 ), IECore.InternedStringVectorData( [ "group", "group", "group", "sphere" ] ) )
+
+	def testProxyThreshold( self ) :
+
+		s = Gaffer.ScriptNode()
+		s["s"] = GafferScene.Sphere()
+		s["g"] = GafferScene.Group()
+		s["g"]["in"][0].setInput( s["s"]["out"] )
+
+		sg = GafferSceneUI.SceneGadget()
+		sg.setMinimumExpansionDepth( 1 )
+		sg.setScene( s["g"]["out"] )
+
+		self.assertEqual( sg.getProxyThreshold(), 0 )
+		sg.setProxyThreshold( 1000000 )
+		self.assertEqual( sg.getProxyThreshold(), 1000000 )
+
+		with GafferUI.Window() as w :
+			gw = GafferUI.GadgetWidget( sg )
+
+		w.setVisible( True )
+		self.waitForIdle( 1000 )
+
+		gw.getViewportGadget().frame( sg.bound() )
+
+		# Proxies are only used for display, so selection
+		# must still see the full geometry.
+
+		self.assertObjectAt( sg, IECore.V2f( 0.5 ), IECore.InternedStringVectorData( [ "group", "sphere" ] ) )
+
+		# And locations outside the view must not be selectable.
+
+		s["g"]["transform"]["translate"]["x"].setValue( 1000 )
+		self.assertObjectAt( sg, IECore.V2f( 0.5 ), None )
+
+	def testSelectionOfRepeatedObjects( self ) :
+
+		s = Gaffer.ScriptNode()
+		s["s"] = GafferScene.Sphere()
+		s["d"] = GafferScene.Duplicate()
+		s["d"]["in"].setInput( s["s"]["out"] )
+		s["d"]["target"].setValue( "/sphere" )
+		s["d"]["transform"]["translate"].setValue( IECore.V3f( 3, 0, 0 ) )
+		s["d"]["copies"].setValue( 4 )
+
+		sg = GafferSceneUI.SceneGadget()
+		sg.setMinimumExpansionDepth( 1 )
+		sg.setScene( s["d"]["out"] )
+
+		with GafferUI.Window() as w :
+			gw = GafferUI.GadgetWidget( sg )
+
+		w.setVisible( True )
+		self.waitForIdle( 1000 )
+
+		gw.getViewportGadget().frame( sg.bound() )
+
+		# The copies are drawn together, but must
+		# still be selectable individually.
+
+		self.assertObjectsAt(
+			sg, IECore.Box2f( IECore.V2f( 0 ), IECore.V2f( 1 ) ),
+			[ "/sphere" ] + [ "/sphere%d" % i for i in range( 1, 5 ) ]
+		)
+
+	def testDragSelectionOfContainedObjects( self ) :
+
+		s = Gaffer.ScriptNode()
+		s["s"] = GafferScene.Sphere()
+		s["d"] = GafferScene.Duplicate()
+		s["d"]["in"].setInput( s["s"]["out"] )
+		s["d"]["target"].setValue( "/sphere" )
+		s["d"]["transform"]["translate"].setValue( IECore.V3f( 3, 0, 0 ) )
+		s["d"]["copies"].setValue( 4 )
+
+		sg = GafferSceneUI.SceneGadget()
+		sg.setMinimumExpansionDepth( 1 )
+		sg.setScene( s["d"]["out"] )
+
+		with GafferUI.Window() as w :
+			gw = GafferUI.GadgetWidget( sg )
+
+		w.setVisible( True )
+		self.waitForIdle( 1000 )
+
+		gw.getViewportGadget().frame( sg.bound() )
+
+		# Objects entirely inside the region are accepted
+		# without being drawn, and those straddling it are
+		# tested by drawing them.
+
+		self.assertObjectsAt(
+			sg, IECore.Box2f( IECore.V2f( 0 ), IECore.V2f( 1 ) ),
+			[ "/sphere" ] + [ "/sphere%d" % i for i in range( 1, 5 ) ]
+		)
+
+		self.assertObjectsAt(
+			sg, IECore.Box2f( IECore.V2f( 0.4, 0 ), IECore.V2f( 0.6, 1 ) ),
+			[ "/sphere2" ]
+		)
+
+		# Picking a single object must not be confused by
+		# the ids assigned during the previous selection.
+
+		self.assertObjectAt( sg, IECore.V2f( 0.5 ), IECore.InternedStringVectorData( [ "sphere2" ] ) )
+
+	def testUploadBudget( self ) :
+
+		s = Gaffer.ScriptNode()
+		s["s"] = GafferScene.Sphere()
+		s["d"] = GafferScene.Duplicate()
+		s["d"]["in"].setInput( s["s"]["out"] )
+		s["d"]["target"].setValue( "/sphere" )
+		s["d"]["copies"].setValue( 10 )
+
+		sg = GafferSceneUI.SceneGadget()
+		self.assertEqual( sg.getUploadBudget(), 0 )
+		sg.setUploadBudget( 0.000001 )
+		self.assertAlmostEqual( sg.getUploadBudget(), 0.000001 )
+
+		sg.setMinimumExpansionDepth( 1 )
+		sg.setScene( s["d"]["out"] )
+
+		with GafferUI.Window() as w :
+			gw = GafferUI.GadgetWidget( sg )
+
+		w.setVisible( True )
+		self.waitForIdle( 1000 )
+
+		# Selection isn't subject to the budget, so sees
+		# everything even if drawing hasn't caught up yet.
+
+		gw.getViewportGadget().frame( sg.bound() )
+		self.assertObjectsAt(
+			sg, IECore.Box2f( IECore.V2f( 0 ), IECore.V2f( 1 ) ),
+			[ "/sphere" ] + [ "/sphere%d" % i for i in range( 1, 11 ) ]
+		)
+
 	def testExpressions( self ) :
 
 		s = Gaffer.ScriptNode()
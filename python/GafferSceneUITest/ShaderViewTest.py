@@ -194,5 +194,44 @@ class ShaderViewTest( GafferUITest.TestCase ) :
 		GafferSceneUI.ShaderView.registerScene( "test", "HiRes", functools.partial( shaderBallCreator, 4096 ) )
 		self.assertEqual( view.scene()["resolution"].getValue(), 4096 )
 
+	def testRenderersAreReused( self ) :
+
+		renderers = []
+		def rendererCreator() :
+
+			result = Gaffer.Node()
+			result["in"] = GafferScene.ScenePlug()
+			result["state"] = Gaffer.IntPlug()
+			renderers.append( result )
+
+			return result
+
+		GafferSceneUI.ShaderView.registerRenderer( "rendererTestA", rendererCreator )
+		GafferSceneUI.ShaderView.registerRenderer( "rendererTestB", rendererCreator )
+
+		shaderA = GafferSceneTest.TestShader()
+		shaderA["type"].setValue( "rendererTestA:surface" )
+		shaderA["name"].setValue( "test" )
+
+		shaderB = GafferSceneTest.TestShader()
+		shaderB["type"].setValue( "rendererTestB:surface" )
+		shaderB["name"].setValue( "test" )
+
+		view = GafferUI.View.create( shaderA["out"] )
+		self.waitForIdle( 1000 )
+		self.assertEqual( len( renderers ), 1 )
+
+		view["in"].setInput( shaderB["out"] )
+		self.waitForIdle( 1000 )
+		self.assertEqual( len( renderers ), 2 )
+		self.assertEqual( renderers[0]["state"].getValue(), GafferScene.InteractiveRender.State.Paused )
+
+		# Switching back should resume the original
+		# renderer rather than make a new one.
+		view["in"].setInput( shaderA["out"] )
+		self.waitForIdle( 1000 )
+		self.assertEqual( len( renderers ), 2 )
+		self.assertEqual( renderers[1]["state"].getValue(), GafferScene.InteractiveRender.State.Paused )
+
 if __name__ == "__main__":
 	unittest.main()
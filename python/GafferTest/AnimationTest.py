@@ -249,6 +249,28 @@ class AnimationTest( GafferTest.TestCase ) :
 			c.setTime( 2 )
 			self.assertEqual( s["n"]["user"]["f"].getValue(), 2 )
 
+	def testBatchEvaluate( self ) :
+
+		curve = Gaffer.Animation.CurvePlug()
+		self.assertEqual( curve.evaluate( IECore.FloatVectorData( [ 0, 1 ] ) ), IECore.FloatVectorData( [ 0, 0 ] ) )
+
+		curve.addKey( Gaffer.Animation.Key( 0, 0 ) )
+		curve.addKey( Gaffer.Animation.Key( 1, 1, Gaffer.Animation.Type.Linear ) )
+		curve.addKey( Gaffer.Animation.Key( 2, 2, Gaffer.Animation.Type.Step ) )
+		curve.addKey( Gaffer.Animation.Key( 3, 0, Gaffer.Animation.Type.Linear ) )
+
+		# Sorted times, as for motion blur, then unsorted
+		# times which defeat the segment hint.
+		for times in (
+			[ -1 + i * 0.1 for i in range( 0, 50 ) ],
+			[ 3.5, 0.5, 2, 1.5, -1, 2.75, 0, 3 ],
+			[],
+		) :
+			self.assertEqual(
+				curve.evaluate( IECore.FloatVectorData( times ) ),
+				IECore.FloatVectorData( [ curve.evaluate( t ) for t in times ] )
+			)
+
 	def testAffects( self ) :
 
 		s = Gaffer.ScriptNode()
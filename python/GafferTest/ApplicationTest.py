@@ -63,5 +63,18 @@ class ApplicationTest( GafferTest.TestCase ) :
 		self.assertEqual( externalEnv["GAFFER_STARTUP_PATHS"], os.environ["GAFFER_STARTUP_PATHS"] )
 		self.assertEqual( externalEnv["GAFFER_APP_PATHS"], os.environ["GAFFER_APP_PATHS"] )
 
+	def testProfileStartup( self ) :
+
+		p = subprocess.Popen(
+			[ "gaffer", "env", "-profileStartup", "1" ],
+			stdout = subprocess.PIPE,
+			stderr = subprocess.PIPE,
+		)
+		stdout, stderr = p.communicate()
+		self.assertEqual( p.returncode, 0 )
+
+		self.assertIn( "Startup files :", stderr )
+		self.assertIn( "Imports :", stderr )
+
 if __name__ == "__main__":
 	unittest.main()
@@ -422,5 +422,61 @@ class CompoundDataPlugTest( GafferTest.TestCase ) :
 		m2["name"].setValue( "test4" )
 		self.assertEqual( h5, p.hash() )
 
+	def testCompoundData( self ) :
+
+		n = Gaffer.Node()
+		n["p"] = Gaffer.CompoundDataPlug()
+		p = n["p"]
+
+		m1 = p.addMember( "a", IECore.IntData( 1 ) )
+		m2 = p.addOptionalMember( "b", IECore.StringData( "x" ), enabled = True )
+		self.assertEqual( p.compoundData(), IECore.CompoundData( { "a" : 1, "b" : "x" } ) )
+
+		# Results are reused while nothing changes.
+		self.assertTrue( p.compoundData( _copy = False ).isSame( p.compoundData( _copy = False ) ) )
+		h = p.hash()
+		self.assertEqual( p.hash(), h )
+
+		m1["value"].setValue( 2 )
+		self.assertEqual( p.compoundData(), IECore.CompoundData( { "a" : 2, "b" : "x" } ) )
+		self.assertNotEqual( p.hash(), h )
+
+		h = p.hash()
+		m2["enabled"].setValue( False )
+		self.assertEqual( p.compoundData(), IECore.CompoundData( { "a" : 2 } ) )
+		self.assertNotEqual( p.hash(), h )
+
+		h = p.hash()
+		p.removeChild( m1 )
+		self.assertEqual( p.compoundData(), IECore.CompoundData() )
+		self.assertNotEqual( p.hash(), h )
+
+		h = p.hash()
+		p.addMember( "c", IECore.FloatData( 1 ) )
+		self.assertEqual( p.compoundData(), IECore.CompoundData( { "c" : 1.0 } ) )
+		self.assertNotEqual( p.hash(), h )
+
+	def testCompoundDataVaryingWithContext( self ) :
+
+		n = Gaffer.Node()
+		n["p"] = Gaffer.CompoundDataPlug()
+		m = n["p"].addMember( "a", IECore.StringData( "${x}" ) )
+
+		with Gaffer.Context() as c :
+
+			c["x"] = "one"
+			h1 = n["p"].hash()
+
+			c["x"] = "two"
+			self.assertNotEqual( n["p"].hash(), h1 )
+
+		n["i"] = Gaffer.StringPlug()
+		m["value"].setInput( n["i"] )
+		n["i"].setValue( "three" )
+		self.assertEqual( n["p"].compoundData(), IECore.CompoundData( { "a" : "three" } ) )
+
+		n["i"].setValue( "four" )
+		self.assertEqual( n["p"].compoundData(), IECore.CompoundData( { "a" : "four" } ) )
+
 if __name__ == "__main__":
 	unittest.main()
@@ -484,5 +484,57 @@ class ComputeNodeTest( GafferTest.TestCase ) :
 
 		GafferTest.testComputeNodeThreading()
 
+	def testConcurrentComputesAreShared( self ) :
+
+		class SlowNode( Gaffer.ComputeNode ) :
+
+			def __init__( self, name="SlowNode" ) :
+
+				Gaffer.ComputeNode.__init__( self, name )
+
+				self["in"] = Gaffer.IntPlug()
+				self["out"] = Gaffer.IntPlug( direction = Gaffer.Plug.Direction.Out )
+
+				self.numComputeCalls = 0
+
+			def affects( self, input ) :
+
+				outputs = Gaffer.ComputeNode.affects( self, input )
+				if input.isSame( self["in"] ) :
+					outputs.append( self["out"] )
+
+				return outputs
+
+			def hash( self, output, context, h ) :
+
+				self["in"].hash( h )
+
+			def compute( self, plug, context ) :
+
+				self.numComputeCalls += 1
+				time.sleep( 0.5 )
+				plug.setValue( self["in"].getValue() * 2 )
+
+		IECore.registerRunTimeTyped( SlowNode )
+
+		n = SlowNode()
+		n["in"].setValue( 10 )
+
+		results = []
+		def f() :
+			results.append( n["out"].getValue() )
+
+		threads = []
+		for i in range( 0, 10 ) :
+			t = threading.Thread( target = f )
+			t.start()
+			threads.append( t )
+
+		for t in threads :
+			t.join()
+
+		self.assertEqual( results, [ 20 ] * 10 )
+		self.assertEqual( n.numComputeCalls, 1 )
+
 if __name__ == "__main__":
 	unittest.main()
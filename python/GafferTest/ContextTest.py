@@ -357,6 +357,35 @@ class ContextTest( GafferTest.TestCase ) :
 
 		GafferTest.testManyContexts()
 
+	def testCanceller( self ) :
+
+		c = Gaffer.Context()
+		self.assertEqual( c.canceller(), None )
+		Gaffer.Canceller.check( c.canceller() )
+
+		canceller = Gaffer.Canceller()
+		c2 = Gaffer.Context( c, canceller )
+		self.assertTrue( c2.canceller() is not None )
+		self.assertFalse( c2.canceller().cancelled() )
+		self.assertEqual( c2.hash(), c.hash() )
+
+		# Copies inherit the canceller.
+		c3 = Gaffer.Context( c2 )
+		c3["test"] = 10
+		Gaffer.Canceller.check( c3.canceller() )
+
+		canceller.cancel()
+		self.assertTrue( canceller.cancelled() )
+		self.assertTrue( c3.canceller().cancelled() )
+		self.assertRaisesRegexp( RuntimeError, "Cancelled", Gaffer.Canceller.check, c3.canceller() )
+
+		# But the original context is unaffected.
+		Gaffer.Canceller.check( c.canceller() )
+
+	def testEditableScope( self ) :
+
+		GafferTest.testEditableScope()
+
 	def testGetWithAndWithoutCopying( self ) :
 
 		c = Gaffer.Context()
@@ -538,6 +567,46 @@ class ContextTest( GafferTest.TestCase ) :
 		self.assertEqual( cs[0], ( c, "test" ) )
 		self.assertNotEqual( c.hash(), h )
 
+	def testHashIsIndependentOfHistory( self ) :
+
+		c1 = Gaffer.Context()
+		c1["a"] = 1
+		c1["b"] = "b"
+		h = c1.hash()
+
+		# Same entries set in a different order,
+		# and via additional intermediate values.
+
+		c2 = Gaffer.Context()
+		c2["b"] = "x"
+		c2.hash()
+		c2["a"] = 2
+		c2.hash()
+		c2["c"] = 3
+		c2.hash()
+		c2["a"] = 1
+		c2["b"] = "b"
+		c2.remove( "c" )
+		self.assertEqual( c2.hash(), h )
+
+		# Copies should update their hash incrementally
+		# from the original.
+
+		c3 = Gaffer.Context( c1 )
+		self.assertEqual( c3.hash(), h )
+		c3["a"] = 10
+		self.assertNotEqual( c3.hash(), h )
+		c3["a"] = 1
+		self.assertEqual( c3.hash(), h )
+
+		# Swapping values between names must
+		# change the hash.
+
+		c4 = Gaffer.Context()
+		c4["a"] = "b"
+		c4["b"] = 1
+		self.assertNotEqual( c4.hash(), h )
+
 	def testHashIgnoresUIEntries( self ) :
 
 		c = Gaffer.Context()
@@ -546,6 +615,30 @@ class ContextTest( GafferTest.TestCase ) :
 		c["ui:test"] = 1
 		self.assertEqual( h, c.hash() )
 
+	def testInternedStringVectorDataHash( self ) :
+
+		c1 = Gaffer.Context()
+		c1["path"] = IECore.InternedStringVectorData( [ "a", "b", "c" ] )
+
+		c2 = Gaffer.Context()
+		c2["path"] = IECore.InternedStringVectorData( [ "a", "b", "c" ] )
+		self.assertEqual( c1.hash(), c2.hash() )
+
+		c2["path"] = IECore.InternedStringVectorData( [ "a", "b" ] )
+		self.assertNotEqual( c1.hash(), c2.hash() )
+
+		c2["path"] = IECore.InternedStringVectorData( [ "a", "c", "b" ] )
+		self.assertNotEqual( c1.hash(), c2.hash() )
+
+		c2["path"] = IECore.InternedStringVectorData( [ "ab", "c" ] )
+		self.assertNotEqual( c1.hash(), c2.hash() )
+
+		c2["path"] = IECore.StringVectorData( [ "a", "b", "c" ] )
+		self.assertNotEqual( c1.hash(), c2.hash() )
+
+		c2["path"] = IECore.InternedStringVectorData( [ "a", "b", "c" ] )
+		self.assertEqual( c1.hash(), c2.hash() )
+
 	def testManySubstitutions( self ) :
 
 		GafferTest.testManySubstitutions()
@@ -0,0 +1,97 @@
+##########################################################################
+#
+#  Copyright (c) 2017, Image Engine Design Inc. All rights reserved.
+#
+#  Redistribution and use in source and binary forms, with or without
+#  modification, are permitted provided that the following conditions are
+#  met:
+#
+#      * Redistributions of source code must retain the above
+#        copyright notice, this list of conditions and the following
+#        disclaimer.
+#
+#      * Redistributions in binary form must reproduce the above
+#        copyright notice, this list of conditions and the following
+#        disclaimer in the documentation and/or other materials provided with
+#        the distribution.
+#
+#      * Neither the name of John Haddon nor the names of
+#        any other contributors to this software may be used to endorse or
+#        promote products derived from this software without specific prior
+#        written permission.
+#
+#  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+#  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+#  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+#  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+#  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+#  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+#  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+#  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+#  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+#  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+#  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#
+##########################################################################
+
+import gc
+import struct
+import unittest
+
+import IECore
+
+import Gaffer
+import GafferTest
+
+class DataBufferTest( GafferTest.TestCase ) :
+
+	def testFloatVectorData( self ) :
+
+		d = IECore.FloatVectorData( [ 0.5, 1.5, 2.5, 3.5 ] )
+		b = Gaffer.dataBuffer( d )
+
+		self.assertTrue( b.readonly )
+		self.assertEqual( b.format, "f" )
+		self.assertEqual( b.itemsize, 4 )
+		self.assertEqual( b.shape, ( 4, ) )
+		self.assertEqual( list( struct.unpack( "4f", b.tobytes() ) ), list( d ) )
+
+	def testCompoundElements( self ) :
+
+		d = IECore.V3fVectorData( [ IECore.V3f( 1, 2, 3 ), IECore.V3f( 4, 5, 6 ) ] )
+		b = Gaffer.dataBuffer( d )
+
+		self.assertEqual( b.format, "f" )
+		self.assertEqual( b.shape, ( 6, ) )
+		self.assertEqual( struct.unpack( "6f", b.tobytes() ), ( 1, 2, 3, 4, 5, 6 ) )
+
+	def testIntVectorData( self ) :
+
+		d = IECore.IntVectorData( [ 1, -2, 3 ] )
+		b = Gaffer.dataBuffer( d )
+
+		self.assertEqual( b.format, "i" )
+		self.assertEqual( struct.unpack( "3i", b.tobytes() ), ( 1, -2, 3 ) )
+
+	def testLifetime( self ) :
+
+		b = Gaffer.dataBuffer( IECore.FloatVectorData( [ 1, 2, 3 ] ) )
+		gc.collect()
+
+		self.assertEqual( struct.unpack( "3f", b.tobytes() ), ( 1, 2, 3 ) )
+
+	def testNoCopy( self ) :
+
+		d = IECore.FloatVectorData( [ 1, 2, 3 ] )
+		b = Gaffer.dataBuffer( d )
+		d[0] = 10
+
+		self.assertEqual( struct.unpack( "3f", b.tobytes() ), ( 10, 2, 3 ) )
+
+	def testUnsupportedTypes( self ) :
+
+		self.assertRaises( TypeError, Gaffer.dataBuffer, IECore.StringVectorData( [ "a" ] ) )
+		self.assertRaises( TypeError, Gaffer.dataBuffer, IECore.FloatData( 1 ) )
+
+if __name__ == "__main__":
+	unittest.main()
@@ -449,6 +449,39 @@ class DependencyNodeTest( GafferTest.TestCase ) :
 		self.assertTrue( cs[1][0].isSame( s["n"]["op2"] ) )
 		self.assertTrue( cs[2][0].isSame( s["n"]["sum"] ) )
 
+	def testLargeFanOutDirtyPropagation( self ) :
+
+		# A single source feeding many downstream nodes, each
+		# via two converging paths. Changing several source inputs
+		# within one scope must signal each dirty plug only once.
+
+		s = Gaffer.ScriptNode()
+		s["source"] = GafferTest.AddNode()
+
+		numNodes = 1000
+		for i in range( 0, numNodes ) :
+			n = GafferTest.AddNode()
+			n["op1"].setInput( s["source"]["sum"] )
+			n["op2"].setInput( s["source"]["sum"] )
+			s.addChild( n )
+
+		dirtied = collections.defaultdict( int )
+		def plugDirtied( plug ) :
+			dirtied[plug.fullName()] += 1
+
+		connections = [
+			n.plugDirtiedSignal().connect( plugDirtied )
+			for n in s.children( Gaffer.Node )
+		]
+
+		with Gaffer.UndoContext( s ) :
+			s["source"]["op1"].setValue( 1 )
+			s["source"]["op2"].setValue( 2 )
+			s["source"]["op1"].setValue( 3 )
+
+		self.assertEqual( len( dirtied ), 3 + numNodes * 3 )
+		self.assertEqual( set( dirtied.values() ), set( [ 1 ] ) )
+
 	def testDirtyPropagationScopingForCompoundPlugInputChange( self ) :
 
 		n1 = GafferTest.CompoundPlugNode()
@@ -1247,5 +1247,53 @@ class ExpressionTest( GafferTest.TestCase ) :
 		for language in ( "", "latin" ) :
 			self.assertRaisesRegexp( RuntimeError, "Failed to create engine", s["e"].setExpression, "parent.n.user.p = 10", language )
 
+	def testContextOnlyExpressionResultsAreCached( self ) :
+
+		s = Gaffer.ScriptNode()
+		s["n"] = GafferTest.AddNode()
+
+		s["e"] = Gaffer.Expression()
+		s["e"].setExpression( inspect.cleandoc(
+			"""
+			import GafferTest
+			GafferTest.ExpressionTest.executions += 1
+			parent["n"]["op1"] = int( context.getFrame() )
+			"""
+		) )
+
+		ExpressionTest.executions = 0
+		for i in range( 0, 2 ) :
+			for frame in range( 0, 10 ) :
+				c = Gaffer.Context()
+				c.setFrame( frame )
+				# Irrelevant variables must not defeat the cache.
+				c["irrelevant"] = i
+				with c :
+					self.assertEqual( s["n"]["sum"].getValue(), frame )
+			# Clear the compute cache so that the second iteration
+			# must go as far as the engine.
+			Gaffer.ValuePlug.clearCache()
+
+		self.assertEqual( ExpressionTest.executions, 10 )
+
+		# Expressions reading plugs can't be cached in the same way,
+		# because the plug values aren't part of the key.
+
+		s["e"].setExpression( inspect.cleandoc(
+			"""
+			import GafferTest
+			GafferTest.ExpressionTest.executions += 1
+			parent["n"]["op1"] = parent["n"]["op2"] + int( context.getFrame() )
+			"""
+		) )
+
+		ExpressionTest.executions = 0
+		for op2 in range( 0, 3 ) :
+			s["n"]["op2"].setValue( op2 )
+			Gaffer.ValuePlug.clearCache()
+			self.assertEqual( s["n"]["sum"].getValue(), 2 * op2 + 1 )
+
+		self.assertEqual( ExpressionTest.executions, 3 )
+
 if __name__ == "__main__":
 	unittest.main()
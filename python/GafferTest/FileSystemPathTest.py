@@ -311,6 +311,52 @@ class FileSystemPathTest( GafferTest.TestCase ) :
 		c = p.children()
 		self.assertEqual( len( c ), 8 )
 
+	def testIsSequentialFile( self ) :
+
+		for n in [ "singleFile.txt", "a.001.txt", "a.002.txt" ] :
+			with open( self.temporaryDirectory() + "/" + n, "w" ) as f :
+				f.write( "AAAA" )
+
+		# Without the directory having been listed
+
+		self.assertFalse( Gaffer.FileSystemPath( self.temporaryDirectory() + "/singleFile.txt" ).isSequentialFile() )
+		self.assertTrue( Gaffer.FileSystemPath( self.temporaryDirectory() + "/a.001.txt" ).isSequentialFile() )
+
+		# And with the listing cached
+
+		p = Gaffer.FileSystemPath( self.temporaryDirectory() )
+		c = { str( x ) : x for x in p.children() }
+		self.assertFalse( c[self.temporaryDirectory() + "/singleFile.txt"].isSequentialFile() )
+		self.assertTrue( c[self.temporaryDirectory() + "/a.001.txt"].isSequentialFile() )
+		self.assertTrue( c[self.temporaryDirectory() + "/a.002.txt"].isSequentialFile() )
+
+	def testChildrenReflectDirectoryChanges( self ) :
+
+		p = Gaffer.FileSystemPath( self.temporaryDirectory() )
+		self.assertEqual( p.children(), [] )
+
+		with open( self.temporaryDirectory() + "/a", "w" ) as f :
+			f.write( "AAAA" )
+
+		# Make sure the modification time of the directory differs,
+		# even on filesystems with coarse timestamps.
+		t = os.stat( self.temporaryDirectory() ).st_mtime + 10
+		os.utime( self.temporaryDirectory(), ( t, t ) )
+
+		c = p.children()
+		self.assertEqual( [ str( x ) for x in c ], [ self.temporaryDirectory() + "/a" ] )
+		self.assertTrue( c[0].isValid() )
+		self.assertTrue( c[0].isLeaf() )
+		self.assertEqual( c[0].property( "fileSystem:size" ), 4 )
+
+		# Files not in the cached listing are still found.
+		with open( self.temporaryDirectory() + "/b", "w" ) as f :
+			f.write( "BB" )
+
+		b = Gaffer.FileSystemPath( self.temporaryDirectory() + "/b" )
+		self.assertTrue( b.isValid() )
+		self.assertEqual( b.property( "fileSystem:size" ), 2 )
+
 	def setUp( self ) :
 
 		GafferTest.TestCase.setUp( self )
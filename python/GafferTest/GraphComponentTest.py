@@ -760,5 +760,49 @@ class GraphComponentTest( GafferTest.TestCase ) :
 		self.assertRaisesRegexp( KeyError, "'a' is not a child of 'GraphComponent'", g.__getitem__, "a" )
 		self.assertRaisesRegexp( KeyError, "'a' is not a child of 'GraphComponent'", g.__delitem__, "a" )
 
+	def testManyChildren( self ) :
+
+		# Enough children to exercise the name index
+		# used by large parents.
+
+		p = Gaffer.GraphComponent()
+		children = []
+		for i in range( 0, 100 ) :
+			c = Gaffer.GraphComponent( "c" )
+			p.addChild( c )
+			children.append( c )
+
+		self.assertEqual( children[0].getName(), "c" )
+		for i in range( 1, 100 ) :
+			self.assertEqual( children[i].getName(), "c%d" % i )
+
+		for c in children :
+			self.assertTrue( p[c.getName()].isSame( c ) )
+			self.assertTrue( p.descendant( c.getName() ).isSame( c ) )
+
+		# Renaming must update lookups and suffix allocation.
+
+		children[99].setName( "d" )
+		self.assertTrue( p["d"].isSame( children[99] ) )
+		self.assertFalse( "c99" in p )
+		self.assertEqual( children[98].setName( "c98" ), "c98" )
+		self.assertEqual( children[50].setName( "c" ), "c99" )
+		self.assertTrue( p["c99"].isSame( children[50] ) )
+		self.assertFalse( "c50" in p )
+
+		# As must removal.
+
+		p.removeChild( children[50] )
+		self.assertFalse( "c99" in p )
+		c = Gaffer.GraphComponent( "c" )
+		p.addChild( c )
+		self.assertEqual( c.getName(), "c99" )
+
+		p.removeChild( c )
+		p.removeChild( children[98] )
+		c = Gaffer.GraphComponent( "c" )
+		p.addChild( c )
+		self.assertEqual( c.getName(), "c98" )
+
 if __name__ == "__main__":
 	unittest.main()
@@ -0,0 +1,96 @@
+##########################################################################
+#
+#  Copyright (c) 2017, Image Engine Design Inc. All rights reserved.
+#
+#  Redistribution and use in source and binary forms, with or without
+#  modification, are permitted provided that the following conditions are
+#  met:
+#
+#      * Redistributions of source code must retain the above
+#        copyright notice, this list of conditions and the following
+#        disclaimer.
+#
+#      * Redistributions in binary form must reproduce the above
+#        copyright notice, this list of conditions and the following
+#        disclaimer in the documentation and/or other materials provided with
+#        the distribution.
+#
+#      * Neither the name of John Haddon nor the names of
+#        any other contributors to this software may be used to endorse or
+#        promote products derived from this software without specific prior
+#        written permission.
+#
+#  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+#  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+#  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+#  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+#  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+#  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+#  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+#  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+#  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+#  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+#  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#
+##########################################################################
+
+import unittest
+
+import IECore
+
+import Gaffer
+import GafferTest
+
+class HotspotMonitorTest( GafferTest.TestCase ) :
+
+	def test( self ) :
+
+		a1 = GafferTest.AddNode()
+		a2 = GafferTest.AddNode()
+
+		m = Gaffer.HotspotMonitor( [ "test" ] )
+		self.assertEqual( m.variableNames(), [ "test" ] )
+		self.assertEqual( m.maxHotspots(), 1000 )
+
+		with Gaffer.Context() as c :
+
+			# No "test" variable, so nothing should be monitored.
+			with m :
+				a1["sum"].getValue()
+
+			self.assertEqual( m.hotspots(), [] )
+
+			with m :
+				for i in range( 0, 10 ) :
+					c["test"] = i
+					a1["sum"].getValue()
+					a2["sum"].getValue()
+
+		hotspots = m.hotspots()
+		self.assertEqual( len( hotspots ), 20 )
+		self.assertEqual(
+			set( ( h.plug, h.variables["test"].value ) for h in hotspots ),
+			set( ( p, i ) for p in ( a1["sum"], a2["sum"] ) for i in range( 0, 10 ) )
+		)
+
+		for h in hotspots :
+			self.assertGreater( h.count, 0 )
+			self.assertEqual( h.variables.keys(), [ "test" ] )
+
+		durations = [ h.duration for h in hotspots ]
+		self.assertEqual( durations, sorted( durations, reverse = True ) )
+
+	def testMaxHotspots( self ) :
+
+		a = GafferTest.AddNode()
+
+		m = Gaffer.HotspotMonitor( [ "test" ], maxHotspots = 5 )
+		with Gaffer.Context() as c, m :
+			for i in range( 0, 100 ) :
+				c["test"] = i
+				a["sum"].getValue()
+
+		self.assertEqual( len( m.hotspots() ), 5 )
+
+if __name__ == "__main__":
+	unittest.main()
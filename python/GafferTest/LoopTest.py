@@ -178,5 +178,28 @@ class LoopTest( GafferTest.TestCase ) :
 
 		self.assertTrue( n.correspondingInput( n["out"] ).isSame( n["in"] ) )
 
+	def testManyIterations( self ) :
+
+		n = self.intLoop()
+		a = GafferTest.AddNode()
+
+		n["in"].setValue( 0 )
+		n["next"].setInput( a["sum"] )
+
+		a["op1"].setInput( n["previous"] )
+		a["op2"].setValue( 1 )
+
+		n["iterations"].setValue( 10000 )
+
+		Gaffer.ValuePlug.clearHashCache()
+		Gaffer.ValuePlug.clearCache()
+
+		with Gaffer.PerformanceMonitor() as m :
+			self.assertEqual( n["out"].getValue(), 10000 )
+
+		# Each iteration should be hashed and computed exactly once.
+		self.assertEqual( m.plugStatistics( a["sum"] ).hashCount, 10000 )
+		self.assertEqual( m.plugStatistics( a["sum"] ).computeCount, 10000 )
+
 if __name__ == "__main__":
 	unittest.main()
@@ -0,0 +1,138 @@
+##########################################################################
+#
+#  Copyright (c) 2017, Image Engine Design Inc. All rights reserved.
+#
+#  Redistribution and use in source and binary forms, with or without
+#  modification, are permitted provided that the following conditions are
+#  met:
+#
+#      * Redistributions of source code must retain the above
+#        copyright notice, this list of conditions and the following
+#        disclaimer.
+#
+#      * Redistributions in binary form must reproduce the above
+#        copyright notice, this list of conditions and the following
+#        disclaimer in the documentation and/or other materials provided with
+#        the distribution.
+#
+#      * Neither the name of John Haddon nor the names of
+#        any other contributors to this software may be used to endorse or
+#        promote products derived from this software without specific prior
+#        written permission.
+#
+#  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+#  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+#  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+#  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+#  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+#  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+#  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+#  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+#  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+#  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+#  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#
+##########################################################################
+
+import sys
+import unittest
+
+import IECore
+
+import Gaffer
+import GafferTest
+
+class MemoryGovernorTest( GafferTest.TestCase ) :
+
+	def setUp( self ) :
+
+		GafferTest.TestCase.setUp( self )
+
+		self.__originalCacheMemoryLimit = Gaffer.ValuePlug.getCacheMemoryLimit()
+		self.__originalPriorities = {
+			c : Gaffer.MemoryGovernor.getPriority( c )
+			for c in Gaffer.MemoryGovernor.registeredCaches()
+		}
+
+	def tearDown( self ) :
+
+		GafferTest.TestCase.tearDown( self )
+
+		Gaffer.MemoryGovernor.setMemoryLimit( 0 )
+		for c in Gaffer.MemoryGovernor.registeredCaches() :
+			if c in self.__originalPriorities :
+				Gaffer.MemoryGovernor.setPriority( c, self.__originalPriorities[c] )
+			else :
+				Gaffer.MemoryGovernor.deregisterCache( c )
+
+		Gaffer.ValuePlug.setCacheMemoryLimit( self.__originalCacheMemoryLimit )
+
+	def testComputeCacheRegistered( self ) :
+
+		self.assertTrue( "computeCache" in Gaffer.MemoryGovernor.registeredCaches() )
+		self.assertEqual( Gaffer.MemoryGovernor.cacheMemoryUsage( "computeCache" ), Gaffer.ValuePlug.cacheMemoryUsage() )
+
+	def testDisabledByDefault( self ) :
+
+		self.assertEqual( Gaffer.MemoryGovernor.getMemoryLimit(), 0 )
+
+		limits = []
+		Gaffer.MemoryGovernor.registerCache( "test", lambda : 0, limits.append )
+		Gaffer.MemoryGovernor.update()
+		self.assertEqual( limits, [] )
+
+	@unittest.skipIf( sys.platform == "darwin", "Resident set size not read from /proc on OS X" )
+	def testProcessMemoryUsage( self ) :
+
+		self.assertGreater( Gaffer.MemoryGovernor.processMemoryUsage(), 0 )
+
+	def testPriorities( self ) :
+
+		for c in Gaffer.MemoryGovernor.registeredCaches() :
+			Gaffer.MemoryGovernor.setPriority( c, 0 )
+
+		limits = { "a" : [], "b" : [] }
+		Gaffer.MemoryGovernor.registerCache( "a", lambda : 0, limits["a"].append, priority = 1 )
+		Gaffer.MemoryGovernor.registerCache( "b", lambda : 0, limits["b"].append, priority = 3 )
+		self.assertEqual( Gaffer.MemoryGovernor.getPriority( "a" ), 1 )
+		self.assertEqual( Gaffer.MemoryGovernor.getPriority( "b" ), 3 )
+
+		# Ensure the budget exceeds what the process is already using.
+		Gaffer.MemoryGovernor.setMemoryLimit( Gaffer.MemoryGovernor.processMemoryUsage() + 1024 * 1024 * 1024 )
+		Gaffer.MemoryGovernor.update()
+
+		self.assertEqual( len( limits["a"] ), 1 )
+		self.assertEqual( len( limits["b"] ), 1 )
+		self.assertGreater( limits["a"][0], 0 )
+		self.assertAlmostEqual( limits["b"][0] / float( limits["a"][0] ), 3, delta = 0.01 )
+
+		self.assertEqual( Gaffer.MemoryGovernor.cacheMemoryLimit( "a" ), limits["a"][0] )
+		self.assertEqual( Gaffer.MemoryGovernor.cacheMemoryLimit( "b" ), limits["b"][0] )
+		self.assertEqual( Gaffer.ValuePlug.getCacheMemoryLimit(), 0 )
+
+	def testPressure( self ) :
+
+		for c in Gaffer.MemoryGovernor.registeredCaches() :
+			Gaffer.MemoryGovernor.setPriority( c, 0 )
+
+		limits = []
+		Gaffer.MemoryGovernor.registerCache( "test", lambda : 0, limits.append )
+
+		# A budget smaller than the memory already in use leaves
+		# nothing for the caches.
+		Gaffer.MemoryGovernor.setMemoryLimit( 1 )
+		Gaffer.MemoryGovernor.update()
+		self.assertEqual( limits, [ 0 ] )
+
+	def testUnregisteredCache( self ) :
+
+		self.assertRaises( RuntimeError, Gaffer.MemoryGovernor.getPriority, "notACache" )
+		self.assertRaises( RuntimeError, Gaffer.MemoryGovernor.setPriority, "notACache", 1 )
+
+		Gaffer.MemoryGovernor.registerCache( "test", lambda : 0, lambda x : None )
+		self.assertTrue( "test" in Gaffer.MemoryGovernor.registeredCaches() )
+		Gaffer.MemoryGovernor.deregisterCache( "test" )
+		self.assertFalse( "test" in Gaffer.MemoryGovernor.registeredCaches() )
+
+if __name__ == "__main__":
+	unittest.main()
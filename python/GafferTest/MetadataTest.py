@@ -1014,5 +1014,45 @@ class MetadataTest( GafferTest.TestCase ) :
 		self.assertEqual( Gaffer.Metadata.registeredValues( n, instanceOnly = True ), [] )
 		self.assertEqual( Gaffer.Metadata.registeredValues( n["op1"], instanceOnly = True ), [] )
 
+	def testTypeRegistrationChangesInvalidateLookups( self ) :
+
+		n = GafferTest.AddNode()
+
+		# Prime any caching with misses.
+		self.assertEqual( Gaffer.Metadata.value( n, "testInvalidation" ), None )
+		self.assertEqual( Gaffer.Metadata.value( n["op1"], "testInvalidation" ), None )
+
+		try :
+
+			# Registrations on a base class must be seen.
+
+			Gaffer.Metadata.registerValue( Gaffer.DependencyNode, "testInvalidation", 1 )
+			Gaffer.Metadata.registerValue( Gaffer.DependencyNode, "op*", "testInvalidation", 2 )
+			self.assertEqual( Gaffer.Metadata.value( n, "testInvalidation" ), 1 )
+			self.assertEqual( Gaffer.Metadata.value( n["op1"], "testInvalidation" ), 2 )
+
+			# As must more specific ones which override them.
+
+			Gaffer.Metadata.registerValue( GafferTest.AddNode, "testInvalidation", 3 )
+			Gaffer.Metadata.registerValue( GafferTest.AddNode, "op1", "testInvalidation", 4 )
+			self.assertEqual( Gaffer.Metadata.value( n, "testInvalidation" ), 3 )
+			self.assertEqual( Gaffer.Metadata.value( n["op1"], "testInvalidation" ), 4 )
+			self.assertEqual( Gaffer.Metadata.value( n["op2"], "testInvalidation" ), 2 )
+
+			# And deregistrations.
+
+			Gaffer.Metadata.deregisterValue( GafferTest.AddNode, "testInvalidation" )
+			Gaffer.Metadata.deregisterValue( GafferTest.AddNode, "op1", "testInvalidation" )
+			self.assertEqual( Gaffer.Metadata.value( n, "testInvalidation" ), 1 )
+			self.assertEqual( Gaffer.Metadata.value( n["op1"], "testInvalidation" ), 2 )
+
+		finally :
+
+			Gaffer.Metadata.deregisterValue( Gaffer.DependencyNode, "testInvalidation" )
+			Gaffer.Metadata.deregisterValue( Gaffer.DependencyNode, "op*", "testInvalidation" )
+
+		self.assertEqual( Gaffer.Metadata.value( n, "testInvalidation" ), None )
+		self.assertEqual( Gaffer.Metadata.value( n["op1"], "testInvalidation" ), None )
+
 if __name__ == "__main__":
 	unittest.main()
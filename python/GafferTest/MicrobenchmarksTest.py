@@ -0,0 +1,73 @@
+##########################################################################
+#
+#  Copyright (c) 2017, Image Engine Design Inc. All rights reserved.
+#
+#  Redistribution and use in source and binary forms, with or without
+#  modification, are permitted provided that the following conditions are
+#  met:
+#
+#      * Redistributions of source code must retain the above
+#        copyright notice, this list of conditions and the following
+#        disclaimer.
+#
+#      * Redistributions in binary form must reproduce the above
+#        copyright notice, this list of conditions and the following
+#        disclaimer in the documentation and/or other materials provided with
+#        the distribution.
+#
+#      * Neither the name of John Haddon nor the names of
+#        any other contributors to this software may be used to endorse or
+#        promote products derived from this software without specific prior
+#        written permission.
+#
+#  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+#  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+#  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+#  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+#  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+#  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+#  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+#  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+#  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+#  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+#  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#
+##########################################################################
+
+
+import sys
+import unittest
+
+import Gaffer
+import GafferTest
+
+## Runs the core microbenchmarks with a reduced number of
+# iterations, to check they work and to give a rough idea of
+# the overhead of the fundamental operations. For more
+# representative numbers, call the `GafferTest.benchmark*()`
+# functions directly with their default iteration counts.
+class MicrobenchmarksTest( GafferTest.TestCase ) :
+
+	__benchmarks = [
+		"ProcessConstruction",
+		"HashCacheHits",
+		"HashCacheMisses",
+		"ComputeCacheHits",
+		"ContextCreation",
+		"ContextSet",
+		"ContextHash",
+		"StringPlugSubstitutions",
+		"DirtyPropagation",
+		"ChildLookup",
+	]
+
+	def test( self ) :
+
+		for name in self.__benchmarks :
+			benchmark = getattr( GafferTest, "benchmark" + name )
+			nanoseconds = benchmark( iterations = 100 )
+			self.assertGreater( nanoseconds, 0 )
+			sys.stderr.write( "{0:<30}{1:>12.1f} ns/op\n".format( name, nanoseconds ) )
+
+if __name__ == "__main__":
+	unittest.main()
@@ -35,6 +35,7 @@
 ##########################################################################
 
 import os
+import json
 import time
 import unittest
 
@@ -232,5 +233,104 @@ class PerformanceMonitorTest( GafferTest.TestCase ) :
 		self.assertAlmostEqual( seconds( m.plugStatistics( n2["out"] ).hashDuration ), 0.2, delta = delta )
 		self.assertAlmostEqual( seconds( m.plugStatistics( n2["out"] ).computeDuration ), 0.2, delta = delta )
 
+	def testCacheStatistics( self ) :
+
+		a = GafferTest.AddNode()
+		a["op1"].setValue( 2001 )
+		a["op2"].setValue( -7 )
+
+		Gaffer.ValuePlug.clearCache()
+		Gaffer.ValuePlug.clearHashCache()
+
+		with Gaffer.PerformanceMonitor() as m :
+			self.assertEqual( a["sum"].getValue(), 1994 )
+			self.assertEqual( a["sum"].getValue(), 1994 )
+
+		s = m.plugStatistics( a["sum"] )
+		self.assertEqual( s.hashCount, 1 )
+		self.assertEqual( s.computeCount, 1 )
+		self.assertEqual( s.hashCacheHits, 1 )
+		self.assertEqual( s.computeCacheMisses, 1 )
+		self.assertEqual( s.computeCacheHits, 1 )
+		self.assertGreater( s.cacheBytesStored, 0 )
+
+	def testBytesAllocated( self ) :
+
+		s = Gaffer.PerformanceMonitor.Statistics( bytesAllocated = 100 )
+		self.assertEqual( s.bytesAllocated, 100 )
+		s += Gaffer.PerformanceMonitor.Statistics( bytesAllocated = 20 )
+		self.assertEqual( s.bytesAllocated, 120 )
+		self.assertNotEqual( s, Gaffer.PerformanceMonitor.Statistics() )
+
+		a = GafferTest.AddNode()
+		with Gaffer.PerformanceMonitor() as m :
+			a["sum"].getValue()
+
+		# The count is only available when running with jemalloc,
+		# but node statistics must be consistent either way.
+		self.assertGreaterEqual( m.plugStatistics( a["sum"] ).bytesAllocated, 0 )
+		self.assertEqual( m.nodeStatistics( a ).bytesAllocated, m.plugStatistics( a["sum"] ).bytesAllocated )
+
+	def testNodeStatistics( self ) :
+
+		s = Gaffer.ScriptNode()
+		s["b"] = Gaffer.Box()
+		s["b"]["a1"] = GafferTest.AddNode()
+		s["b"]["a2"] = GafferTest.AddNode()
+		s["b"]["a2"]["op1"].setInput( s["b"]["a1"]["sum"] )
+		s["b"]["a1"]["op1"].setValue( 3001 )
+
+		with Gaffer.PerformanceMonitor() as m :
+			s["b"]["a2"]["sum"].getValue()
+
+		a1 = m.plugStatistics( s["b"]["a1"]["sum"] )
+		a2 = m.plugStatistics( s["b"]["a2"]["sum"] )
+
+		self.assertEqual( m.nodeStatistics( s["b"]["a1"] ), a1 )
+		self.assertEqual( m.nodeStatistics( s["b"]["a2"] ), a2 )
+
+		total = Gaffer.PerformanceMonitor.Statistics()
+		total += a1
+		total += a2
+		self.assertEqual( m.nodeStatistics( s["b"] ), total )
+		self.assertEqual( m.nodeStatistics( s ), total )
+
+		self.assertEqual( len( m.allNodeStatistics() ), 4 )
+		self.assertEqual( m.allNodeStatistics()[s["b"]], total )
+
+	def testTimeline( self ) :
+
+		a1 = GafferTest.AddNode()
+		a2 = GafferTest.AddNode()
+		a2["op1"].setInput( a1["sum"] )
+		a1["op1"].setValue( 4001 )
+
+		m = Gaffer.PerformanceMonitor()
+		self.assertEqual( m.getTimelineEnabled(), False )
+		m.setTimelineEnabled( True )
+		self.assertEqual( m.getTimelineEnabled(), True )
+
+		with m :
+			a2["sum"].getValue()
+
+		fileName = os.path.join( self.temporaryDirectory(), "timeline.json" )
+		m.writeTimeline( fileName )
+
+		with open( fileName ) as f :
+			events = json.load( f )["traceEvents"]
+
+		numHashes = sum( s.hashCount for s in m.allStatistics().values() )
+		numComputes = sum( s.computeCount for s in m.allStatistics().values() )
+
+		self.assertEqual( len( [ e for e in events if e["cat"] == "hash" ] ), numHashes )
+		self.assertEqual( len( [ e for e in events if e["cat"] == "compute" ] ), numComputes )
+
+		for e in events :
+			self.assertEqual( e["ph"], "X" )
+			self.assertGreaterEqual( e["dur"], 0 )
+			self.assertTrue( isinstance( e["tid"], int ) )
+
+		self.assertTrue( a2["sum"].fullName() in [ e["name"] for e in events ] )
+
 if __name__ == "__main__":
 	unittest.main()
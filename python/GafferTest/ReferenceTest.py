@@ -74,6 +74,31 @@ class ReferenceTest( GafferTest.TestCase ) :
 		self.assertTrue( "n1" in s["r"] )
 		self.assertTrue( s["r"]["sum"].getInput().isSame( s["r"]["n1"]["sum"] ) )
 
+	def testManyReferencesToSameFile( self ) :
+
+		s = Gaffer.ScriptNode()
+
+		s["b"] = Gaffer.Box()
+		s["b"]["n"] = GafferTest.AddNode()
+		s["b"]["n"]["op1"].setValue( 1 )
+		s["b"].exportForReference( self.temporaryDirectory() + "/test.grf" )
+
+		for i in range( 0, 20 ) :
+			r = Gaffer.Reference()
+			s.addChild( r )
+			r.load( self.temporaryDirectory() + "/test.grf" )
+			self.assertEqual( r["n"]["op1"].getValue(), 1 )
+
+		# Edits to the file must be picked up, even though
+		# we've loaded the previous version many times.
+
+		s["b"]["n"]["op1"].setValue( 2 )
+		s["b"].exportForReference( self.temporaryDirectory() + "/test.grf" )
+
+		for r in s.children( Gaffer.Reference ) :
+			r.load( self.temporaryDirectory() + "/test.grf" )
+			self.assertEqual( r["n"]["op1"].getValue(), 2 )
+
 	def testSerialisation( self ) :
 
 		s = Gaffer.ScriptNode()
@@ -0,0 +1,159 @@
+##########################################################################
+#
+#  Copyright (c) 2017, Image Engine Design Inc. All rights reserved.
+#
+#  Redistribution and use in source and binary forms, with or without
+#  modification, are permitted provided that the following conditions are
+#  met:
+#
+#      * Redistributions of source code must retain the above
+#        copyright notice, this list of conditions and the following
+#        disclaimer.
+#
+#      * Redistributions in binary form must reproduce the above
+#        copyright notice, this list of conditions and the following
+#        disclaimer in the documentation and/or other materials provided with
+#        the distribution.
+#
+#      * Neither the name of John Haddon nor the names of
+#        any other contributors to this software may be used to endorse or
+#        promote products derived from this software without specific prior
+#        written permission.
+#
+#  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+#  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+#  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+#  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+#  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+#  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+#  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+#  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+#  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+#  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+#  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#
+##########################################################################
+
+import unittest
+import subprocess32 as subprocess
+
+import IECore
+
+import Gaffer
+import GafferTest
+
+class RemoteComputeTest( GafferTest.TestCase ) :
+
+	def setUp( self ) :
+
+		GafferTest.TestCase.setUp( self )
+
+		self.__server = None
+		Gaffer.ValuePlug.clearCache()
+
+	def tearDown( self ) :
+
+		Gaffer.ValuePlug.setComputeClient( None )
+
+		if self.__server is not None :
+			self.__server.terminate()
+			self.__server.wait()
+
+		GafferTest.TestCase.tearDown( self )
+
+	def __startServer( self, fileName ) :
+
+		self.__server = subprocess.Popen(
+			[ "gaffer", "computeServer", "-script", fileName ],
+			stdout = subprocess.PIPE,
+		)
+
+		line = self.__server.stdout.readline()
+		self.assertTrue( line.startswith( "Serving on port " ), line )
+		return int( line.split()[-1] )
+
+	def __script( self ) :
+
+		s = Gaffer.ScriptNode()
+		s["b"] = Gaffer.Box()
+		s["b"]["n"] = GafferTest.AddNode()
+		s["b"]["n"]["op1"].setValue( 1 )
+		s["b"]["n"]["op2"].setValue( 2 )
+		s["b"].promotePlug( s["b"]["n"]["sum"] )
+
+		Gaffer.Metadata.registerValue( s["b"], "computeRemotely", True )
+
+		s["fileName"].setValue( self.temporaryDirectory() + "/remoteCompute.gfr" )
+		s.save()
+
+		return s
+
+	def testComputeRemotely( self ) :
+
+		s = Gaffer.ScriptNode()
+		s["b"] = Gaffer.Box()
+		s["b"]["n"] = GafferTest.AddNode()
+		s["n"] = GafferTest.AddNode()
+
+		self.assertFalse( Gaffer.ComputeClient.computeRemotely( s["b"]["n"]["sum"] ) )
+		self.assertFalse( Gaffer.ComputeClient.computeRemotely( s["n"]["sum"] ) )
+
+		Gaffer.Metadata.registerValue( s["b"], "computeRemotely", True )
+		self.assertTrue( Gaffer.ComputeClient.computeRemotely( s["b"]["n"]["sum"] ) )
+		self.assertFalse( Gaffer.ComputeClient.computeRemotely( s["n"]["sum"] ) )
+
+		# Metadata on descendants overrides their ancestors.
+		Gaffer.Metadata.registerValue( s["b"]["n"], "computeRemotely", False )
+		self.assertFalse( Gaffer.ComputeClient.computeRemotely( s["b"]["n"]["sum"] ) )
+
+	def testRemoteCompute( self ) :
+
+		s = self.__script()
+		port = self.__startServer( s["fileName"].getValue() )
+
+		client = Gaffer.ComputeClient( "localhost", port )
+		self.assertEqual( client.host(), "localhost" )
+		self.assertEqual( client.port(), port )
+		Gaffer.ValuePlug.setComputeClient( client )
+		self.assertTrue( Gaffer.ValuePlug.getComputeClient().isSame( client ) )
+
+		with Gaffer.Context() :
+			self.assertEqual( s["b"]["sum"].getValue(), 3 )
+		self.assertEqual( s["b"]["n"].numComputeCalls, 0 )
+
+		# The result is stored in the local cache.
+
+		with Gaffer.Context() :
+			self.assertEqual( s["b"]["sum"].getValue(), 3 )
+		self.assertEqual( s["b"]["n"].numComputeCalls, 0 )
+
+		# After a local edit the server can't provide the
+		# right value, so we compute it ourselves.
+
+		s["b"]["n"]["op1"].setValue( 10 )
+		with IECore.CapturingMessageHandler() as mh :
+			with Gaffer.Context() :
+				self.assertEqual( s["b"]["sum"].getValue(), 12 )
+
+		self.assertEqual( s["b"]["n"].numComputeCalls, 1 )
+		self.assertEqual( len( mh.messages ), 1 )
+		self.assertEqual( mh.messages[0].level, IECore.Msg.Level.Warning )
+
+	def testUnreachableServer( self ) :
+
+		s = self.__script()
+		port = self.__startServer( s["fileName"].getValue() )
+		self.__server.terminate()
+		self.__server.wait()
+		self.__server = None
+
+		Gaffer.ValuePlug.setComputeClient( Gaffer.ComputeClient( "localhost", port ) )
+		with IECore.CapturingMessageHandler() as mh :
+			with Gaffer.Context() :
+				self.assertEqual( s["b"]["sum"].getValue(), 3 )
+
+		self.assertEqual( s["b"]["n"].numComputeCalls, 1 )
+		self.assertEqual( len( mh.messages ), 1 )
+
+if __name__ == "__main__":
+	unittest.main()
@@ -195,6 +195,83 @@ class ScriptNodeTest( GafferTest.TestCase ) :
 		s["fileName"].setValue( "/this/directory/doesnt/exist" )
 		self.assertRaises( Exception, s.save )
 
+	def testSaveIsAtomic( self ) :
+
+		s = Gaffer.ScriptNode()
+		s["a1"] = GafferTest.AddNode()
+		s["fileName"].setValue( os.path.join( self.temporaryDirectory(), "test.gfr" ) )
+		s.save()
+
+		# Saves are written to a temporary file and renamed into
+		# place, and no temporary files should be left behind.
+		self.assertEqual( os.listdir( self.temporaryDirectory() ), [ "test.gfr" ] )
+
+		s2 = Gaffer.ScriptNode()
+		s2["fileName"].setValue( s["fileName"].getValue() )
+		s2.load()
+		self.assertTrue( "a1" in s2 )
+
+		# Saving again must replace the file in place.
+		s["a2"] = GafferTest.AddNode()
+		s.save()
+		self.assertEqual( os.listdir( self.temporaryDirectory() ), [ "test.gfr" ] )
+		s2.load()
+		self.assertTrue( "a2" in s2 )
+
+	def testUndoMemoryLimit( self ) :
+
+		s = Gaffer.ScriptNode()
+		s["n"] = Gaffer.Node()
+		s["n"]["user"]["p"] = Gaffer.StringVectorDataPlug( defaultValue = IECore.StringVectorData(), flags = Gaffer.Plug.Flags.Default | Gaffer.Plug.Flags.Dynamic )
+
+		self.assertEqual( s.getUndoMemoryLimit(), 0 )
+
+		values = []
+		for i in range( 0, 10 ) :
+			values.append( IECore.StringVectorData( [ str( i ) * 100 ] * 1000 ) )
+			with Gaffer.UndoContext( s ) :
+				s["n"]["user"]["p"].setValue( values[-1] )
+
+		# Without a limit, everything can be undone.
+
+		for i in range( 0, 10 ) :
+			self.assertTrue( s.undoAvailable() )
+			s.undo()
+		self.assertFalse( s.undoAvailable() )
+
+		for i in range( 0, 10 ) :
+			s.redo()
+		self.assertEqual( s["n"]["user"]["p"].getValue(), values[-1] )
+
+		# With a limit, the oldest undos are discarded
+		# to keep within it.
+
+		s.setUndoMemoryLimit( values[0].memoryUsage() * 3 )
+		self.assertEqual( s.getUndoMemoryLimit(), values[0].memoryUsage() * 3 )
+
+		numUndos = 0
+		while s.undoAvailable() :
+			s.undo()
+			numUndos += 1
+
+		self.assertLess( numUndos, 10 )
+		self.assertGreater( numUndos, 0 )
+		self.assertEqual( s["n"]["user"]["p"].getValue(), values[9-numUndos] )
+
+		# But the most recent undo is always kept.
+
+		while s.redoAvailable() :
+			s.redo()
+
+		s.setUndoMemoryLimit( 1 )
+		with Gaffer.UndoContext( s ) :
+			s["n"]["user"]["p"].setValue( IECore.StringVectorData( [ "x" ] ) )
+
+		self.assertTrue( s.undoAvailable() )
+		s.undo()
+		self.assertEqual( s["n"]["user"]["p"].getValue(), values[-1] )
+		self.assertFalse( s.undoAvailable() )
+
 	def testLoadFailureHandling( self ) :
 
 		s = Gaffer.ScriptNode()
@@ -1262,6 +1339,52 @@ class ScriptNodeTest( GafferTest.TestCase ) :
 		self.assertRaises( RuntimeError, s.execute, ss + "\nsyntaxError" )
 		self.assertFalse( s.isExecuting() )
 
+	def testSerialisationCache( self ) :
+
+		s = Gaffer.ScriptNode()
+		s["n"] = GafferTest.AddNode()
+		s["n"]["op1"].setValue( 10 )
+
+		# Only large serialisations are cached, so we pad
+		# this one out with a comment.
+		serialisation = s.serialise() + "\n#" + ( "x" * 1024 * 1024 ) + "\n"
+
+		cacheDirectory = self.temporaryDirectory() + "/serialisationCache"
+		os.makedirs( cacheDirectory )
+
+		self.assertEqual( Gaffer.ScriptNode.getSerialisationCacheDirectory(), os.environ.get( "GAFFER_SERIALISATION_CACHE_DIRECTORY", "" ) )
+		originalDirectory = Gaffer.ScriptNode.getSerialisationCacheDirectory()
+		Gaffer.ScriptNode.setSerialisationCacheDirectory( cacheDirectory )
+		try :
+
+			s2 = Gaffer.ScriptNode()
+			s2.execute( serialisation )
+			self.assertEqual( s2["n"]["op1"].getValue(), 10 )
+
+			cacheFiles = os.listdir( cacheDirectory )
+			self.assertEqual( len( cacheFiles ), 1 )
+			self.assertTrue( cacheFiles[0].endswith( ".gfc" ) )
+
+			# Executing again should use the cached code.
+
+			s3 = Gaffer.ScriptNode()
+			s3.execute( serialisation )
+			self.assertEqual( s3["n"]["op1"].getValue(), 10 )
+			self.assertEqual( os.listdir( cacheDirectory ), cacheFiles )
+
+			# And a corrupt cache should be ignored.
+
+			with open( os.path.join( cacheDirectory, cacheFiles[0] ), "w" ) as f :
+				f.write( "notCompiledCode" )
+
+			s4 = Gaffer.ScriptNode()
+			s4.execute( serialisation )
+			self.assertEqual( s4["n"]["op1"].getValue(), 10 )
+
+		finally :
+
+			Gaffer.ScriptNode.setSerialisationCacheDirectory( originalDirectory )
+
 	def testReconnectionOfChildPlug( self ) :
 
 		class NestedPlugsNode( Gaffer.DependencyNode ) :
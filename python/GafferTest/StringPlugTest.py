@@ -343,5 +343,37 @@ class StringPlugTest( GafferTest.TestCase ) :
 			self.assertEqual( s["substitionsOnIndirectly"]["out"].getValue( _precomputedHash = substitionsOnIndirectlyHash2 ), "test.#.exr" )
 			self.assertEqual( substitionsOnIndirectlyHash2, substitionsOnIndirectlyHash1 )
 
+	def testSubstitutionsMatchContext( self ) :
+
+		s = Gaffer.ScriptNode()
+		s["n"] = GafferTest.StringInOutNode()
+
+		c = Gaffer.Context()
+		c.setFrame( 12 )
+		c["a"] = "apple"
+		c["b"] = "${a}s"
+		c["i"] = 10
+
+		for value in [
+			"",
+			"plain",
+			"~/$a/${b}.####.exr",
+			"in ~1900",
+			"\\$a\\#\\",
+			"$i${i}$dontExist#",
+			"${a",
+		] :
+
+			with Gaffer.UndoContext( s ) :
+				s["n"]["in"].setValue( value )
+
+			with c :
+				self.assertEqual( s["n"]["out"].getValue(), c.substitute( value ) )
+
+		# Undo must restore the previous substitutions too.
+		s.undo()
+		with c :
+			self.assertEqual( s["n"]["out"].getValue(), c.substitute( "$i${i}$dontExist#" ) )
+
 if __name__ == "__main__":
 	unittest.main()
@@ -435,6 +435,39 @@ class SwitchTest( GafferTest.TestCase ) :
 		self.assertTrue( s2["n2"]["op1"].getInput().isSame( s2["switch"]["out"] ) )
 		self.assertTrue( s2["switch"]["in"][0].getInput().isSame( s2["n1"]["sum"] ) )
 
+	def testPassThroughBypassesProcesses( self ) :
+
+		n1 = GafferTest.AddNode()
+		n1["op1"].setValue( 1 )
+		n2 = GafferTest.AddNode()
+		n2["op1"].setValue( 2 )
+
+		# Computed index, so the switch can't use an internal
+		# connection and must evaluate the index on demand.
+		index = GafferTest.AddNode()
+		index["op1"].setValue( 1 )
+
+		switch = self.intSwitch()
+		switch["in"][0].setInput( n1["sum"] )
+		switch["in"][1].setInput( n2["sum"] )
+		switch["index"].setInput( index["sum"] )
+		self.assertEqual( switch["out"].getInput(), None )
+
+		m = Gaffer.PerformanceMonitor()
+		with m :
+			self.assertEqual( switch["out"].getValue(), 2 )
+			self.assertEqual( switch["out"].hash(), n2["sum"].hash() )
+
+		# The switch declares its input as a pass-through, so no
+		# processes are needed for the output itself.
+		self.assertEqual( m.plugStatistics( switch["out"] ).hashCount, 0 )
+		self.assertEqual( m.plugStatistics( switch["out"] ).computeCount, 0 )
+		self.assertEqual( m.plugStatistics( n2["sum"] ).computeCount, 1 )
+		self.assertEqual( m.plugStatistics( n1["sum"] ).hashCount, 0 )
+
+		index["op1"].setValue( 0 )
+		self.assertEqual( switch["out"].getValue(), 1 )
+
 	def setUp( self ) :
 
 		GafferTest.TestCase.setUp( self )
@@ -35,7 +35,10 @@
 #
 ##########################################################################
 
+import os
 import gc
+import time
+import threading
 
 import IECore
 
@@ -626,6 +629,246 @@ class ValuePlugTest( GafferTest.TestCase ) :
 
 		self.failUnless( n["p"] is p )
 
+	def testHashCacheSharedBetweenThreads( self ) :
+
+		n = GafferTest.CachingTestNode()
+		n["in"].setValue( "a" )
+
+		h = n["out"].hash()
+		self.assertEqual( n.numHashCalls, 1 )
+
+		hashes = []
+		def f() :
+			hashes.append( n["out"].hash() )
+
+		threads = []
+		for i in range( 0, 10 ) :
+			t = threading.Thread( target = f )
+			t.start()
+			threads.append( t )
+
+		for t in threads :
+			t.join()
+
+		self.assertEqual( hashes, [ h ] * 10 )
+		self.assertEqual( n.numHashCalls, 1 )
+
+	def testHashCacheInvalidation( self ) :
+
+		n1 = GafferTest.CachingTestNode()
+		n1["in"].setValue( "a" )
+
+		n2 = GafferTest.CachingTestNode()
+		n2["in"].setValue( "b" )
+
+		h1 = n1["out"].hash()
+		h2 = n2["out"].hash()
+		self.assertEqual( n1.numHashCalls, 1 )
+		self.assertEqual( n2.numHashCalls, 1 )
+
+		# Editing n1 must invalidate its hash, but
+		# must not affect the unrelated n2.
+
+		n1["in"].setValue( "c" )
+		self.assertNotEqual( n1["out"].hash(), h1 )
+		self.assertEqual( n2["out"].hash(), h2 )
+		self.assertEqual( n1.numHashCalls, 2 )
+		self.assertEqual( n2.numHashCalls, 1 )
+
+		# Clearing the cache is never necessary, but
+		# should lead to the hashes being recomputed.
+
+		Gaffer.ValuePlug.clearHashCache()
+		self.assertEqual( n2["out"].hash(), h2 )
+		self.assertEqual( n2.numHashCalls, 2 )
+
+	def testHashCacheSizeLimit( self ) :
+
+		l = Gaffer.ValuePlug.getHashCacheSizeLimit()
+		try :
+			Gaffer.ValuePlug.setHashCacheSizeLimit( 10 )
+			self.assertEqual( Gaffer.ValuePlug.getHashCacheSizeLimit(), 10 )
+		finally :
+			Gaffer.ValuePlug.setHashCacheSizeLimit( l )
+
+	def testDiskCache( self ) :
+
+		class SlowNode( Gaffer.ComputeNode ) :
+
+			def __init__( self, name="SlowNode" ) :
+
+				Gaffer.ComputeNode.__init__( self, name )
+
+				self["in"] = Gaffer.StringPlug()
+				self["out"] = Gaffer.ObjectPlug( direction = Gaffer.Plug.Direction.Out, defaultValue = IECore.NullObject() )
+
+				self.numComputeCalls = 0
+
+			def affects( self, input ) :
+
+				outputs = Gaffer.ComputeNode.affects( self, input )
+				if input.isSame( self["in"] ) :
+					outputs.append( self["out"] )
+
+				return outputs
+
+			def hash( self, output, context, h ) :
+
+				self["in"].hash( h )
+
+			def compute( self, plug, context ) :
+
+				self.numComputeCalls += 1
+				time.sleep( 0.2 )
+				plug.setValue( IECore.StringData( self["in"].getValue() ) )
+
+		IECore.registerRunTimeTyped( SlowNode )
+
+		self.assertEqual( Gaffer.ValuePlug.getDiskCacheDirectory(), "" )
+
+		Gaffer.ValuePlug.setDiskCacheDirectory( self.temporaryDirectory() )
+		try :
+
+			n = SlowNode()
+			n["in"].setValue( "test" )
+
+			self.assertEqual( n["out"].getValue(), IECore.StringData( "test" ) )
+			self.assertEqual( n.numComputeCalls, 1 )
+
+			# Clearing the memory cache should leave us able
+			# to retrieve the value from disk.
+
+			Gaffer.ValuePlug.clearCache()
+			self.assertEqual( n["out"].getValue(), IECore.StringData( "test" ) )
+			self.assertEqual( n.numComputeCalls, 1 )
+
+			files = []
+			for root, dirs, fileNames in os.walk( self.temporaryDirectory() ) :
+				files.extend( [ f for f in fileNames if f.endswith( ".fio" ) ] )
+			self.assertEqual( len( files ), 1 )
+
+		finally :
+
+			Gaffer.ValuePlug.setDiskCacheDirectory( "" )
+
+		# With the disk cache disabled, we must compute again.
+
+		Gaffer.ValuePlug.clearCache()
+		self.assertEqual( n["out"].getValue(), IECore.StringData( "test" ) )
+		self.assertEqual( n.numComputeCalls, 2 )
+
+	def testBatchHashes( self ) :
+
+		nodes = []
+		for i in range( 0, 10 ) :
+			n = GafferTest.AddNode()
+			n["op1"].setValue( i )
+			nodes.append( n )
+
+		plugs = [ n["sum"] for n in nodes ]
+		self.assertEqual( Gaffer.ValuePlug.hashes( plugs ), [ p.hash() for p in plugs ] )
+
+		f = GafferTest.FrameNode()
+		contexts = []
+		for i in range( 0, 10 ) :
+			c = Gaffer.Context()
+			c.setFrame( i )
+			contexts.append( c )
+
+		hashes = Gaffer.ValuePlug.hashes( [ f["output"] ] * len( contexts ), contexts )
+		for c, h in zip( contexts, hashes ) :
+			with c :
+				self.assertEqual( f["output"].hash(), h )
+
+		self.assertRaises( Exception, Gaffer.ValuePlug.hashes, plugs, contexts[:2] )
+
+	def testPrefetch( self ) :
+
+		nodes = []
+		for i in range( 0, 10 ) :
+			n = GafferTest.AddNode()
+			n["op1"].setValue( i )
+			nodes.append( n )
+
+		Gaffer.ValuePlug.prefetch( [ n["sum"] for n in nodes ] )
+
+		with Gaffer.PerformanceMonitor() as m :
+			for i, n in enumerate( nodes ) :
+				self.assertEqual( n["sum"].getValue(), i )
+
+		for n in nodes :
+			self.assertEqual( m.plugStatistics( n["sum"] ).computeCount, 0 )
+
+	def testStaticValueHash( self ) :
+
+		s = Gaffer.ScriptNode()
+		s["n"] = Gaffer.Node()
+		s["n"]["p"] = Gaffer.StringVectorDataPlug( defaultValue = IECore.StringVectorData(), flags = Gaffer.Plug.Flags.Default | Gaffer.Plug.Flags.Dynamic )
+
+		self.assertEqual( s["n"]["p"].hash(), IECore.StringVectorData().hash() )
+
+		v = IECore.StringVectorData( [ str( i ) for i in range( 0, 1000 ) ] )
+		with Gaffer.UndoContext( s ) :
+			s["n"]["p"].setValue( v )
+
+		self.assertEqual( s["n"]["p"].hash(), v.hash() )
+
+		s.undo()
+		self.assertEqual( s["n"]["p"].hash(), IECore.StringVectorData().hash() )
+
+		s.redo()
+		self.assertEqual( s["n"]["p"].hash(), v.hash() )
+
+	def testDefaultHash( self ) :
+
+		p = Gaffer.IntPlug( defaultValue = 10 )
+		self.assertEqual( p.defaultHash(), IECore.IntData( 10 ).hash() )
+		self.assertEqual( p.defaultHash(), p.hash() )
+
+		p.setValue( 20 )
+		self.assertEqual( p.defaultHash(), IECore.IntData( 10 ).hash() )
+		self.assertNotEqual( p.defaultHash(), p.hash() )
+		self.assertFalse( p.isSetToDefault() )
+
+		p.setValue( 10 )
+		self.assertTrue( p.isSetToDefault() )
+
+		c = Gaffer.V3fPlug( defaultValue = IECore.V3f( 1, 2, 3 ) )
+		self.assertEqual( c.defaultHash(), c.defaultHash() )
+		c["x"].setValue( 10 )
+		self.assertEqual( c.defaultHash(), Gaffer.V3fPlug( defaultValue = IECore.V3f( 1, 2, 3 ) ).defaultHash() )
+		self.assertNotEqual( c.defaultHash(), Gaffer.V3fPlug( defaultValue = IECore.V3f( 0 ) ).defaultHash() )
+
+	def testNodeCacheMemoryUsage( self ) :
+
+		b = Gaffer.Box()
+		b["n1"] = GafferTest.CachingTestNode()
+		b["n2"] = GafferTest.CachingTestNode()
+		b["n1"]["in"].setValue( "a" )
+		b["n2"]["in"].setValue( "b" * 1000 )
+
+		Gaffer.ValuePlug.clearCache()
+		self.assertEqual( Gaffer.ValuePlug.cacheMemoryUsage( b ), 0 )
+
+		b["n1"]["out"].getValue()
+		b["n2"]["out"].getValue()
+
+		u1 = Gaffer.ValuePlug.cacheMemoryUsage( b["n1"] )
+		u2 = Gaffer.ValuePlug.cacheMemoryUsage( b["n2"] )
+		self.assertGreater( u1, 0 )
+		self.assertGreater( u2, u1 )
+		self.assertEqual( Gaffer.ValuePlug.cacheMemoryUsage( b["n1"]["out"] ), u1 )
+		self.assertEqual( Gaffer.ValuePlug.cacheMemoryUsage( b ), u1 + u2 )
+		self.assertEqual( Gaffer.ValuePlug.cacheMemoryUsage(), u1 + u2 )
+
+		# Cached values may outlive the node that computed them.
+		del b["n1"]
+		self.assertEqual( Gaffer.ValuePlug.cacheMemoryUsage( b ), u2 )
+		self.assertEqual( Gaffer.ValuePlug.cacheMemoryUsage(), u1 + u2 )
+
+		Gaffer.ValuePlug.clearCache()
+		self.assertEqual( Gaffer.ValuePlug.cacheMemoryUsage( b ), 0 )
+
 	def setUp( self ) :
 
 		GafferTest.TestCase.setUp( self )
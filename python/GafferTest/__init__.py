@@ -131,6 +131,12 @@ from DownstreamIteratorTest import DownstreamIteratorTest
 from PerformanceMonitorTest import PerformanceMonitorTest
 from MetadataAlgoTest import MetadataAlgoTest
 from ContextMonitorTest import ContextMonitorTest
+from HotspotMonitorTest import HotspotMonitorTest
+from MemoryGovernorTest import MemoryGovernorTest
+from NUMATest import NUMATest
+from RemoteComputeTest import RemoteComputeTest
+from DataBufferTest import DataBufferTest
+from MicrobenchmarksTest import MicrobenchmarksTest
 
 if __name__ == "__main__":
 	import unittest
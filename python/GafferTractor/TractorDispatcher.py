@@ -35,6 +35,8 @@
 ##########################################################################
 
 import os
+import json
+import math
 
 import tractor.api.author as author
 
@@ -51,6 +53,7 @@ class TractorDispatcher( GafferDispatch.Dispatcher ) :
 
 		self["service"] = Gaffer.StringPlug( defaultValue = '"*"' )
 		self["envKey"] = Gaffer.StringPlug()
+		self["targetTaskDuration"] = Gaffer.FloatPlug( defaultValue = 0, minValue = 0 )
 
 	## Emitted prior to spooling the Tractor job, to allow
 	# custom modifications to be applied.
@@ -77,6 +80,17 @@ class TractorDispatcher( GafferDispatch.Dispatcher ) :
 		dispatchData["scriptNode"] = rootBatch.preTasks()[0].node().scriptNode()
 		dispatchData["scriptFile"] = os.path.join( self.jobDirectory(), os.path.basename( dispatchData["scriptNode"]["fileName"].getValue() ) or "untitled.gfr" )
 		dispatchData["batchesToTasks"] = {}
+		dispatchData["batchesToChunkTasks"] = {}
+
+		# Per-frame timings are recorded by `gaffer execute` in a file shared
+		# by all dispatches of the same job name, so that each dispatch can use
+		# the timings from the previous ones to choose chunk sizes.
+		dispatchData["targetTaskDuration"] = self["targetTaskDuration"].getValue()
+		dispatchData["timingsFile"] = ""
+		dispatchData["timings"] = {}
+		if dispatchData["targetTaskDuration"] :
+			dispatchData["timingsFile"] = os.path.join( os.path.dirname( self.jobDirectory() ), "timings.json" )
+			dispatchData["timings"] = self.__readTimings( dispatchData["timingsFile"] )
 
 		dispatchData["scriptNode"].serialiseToFile( dispatchData["scriptFile"] )
 
@@ -126,8 +140,12 @@ class TractorDispatcher( GafferDispatch.Dispatcher ) :
 		if batch.blindData().get( "tractorDispatcher:visited" ) :
 			return
 
-		for upstreamBatch in batch.preTasks() :
-			self.__buildJobWalk( task, upstreamBatch, dispatchData )
+		# When a batch is split into chunks, each chunk must
+		# wait for all the upstream tasks, so we parent them
+		# under every chunk.
+		for chunkTask in dispatchData["batchesToChunkTasks"][batch] :
+			for upstreamBatch in batch.preTasks() :
+				self.__buildJobWalk( chunkTask, upstreamBatch, dispatchData )
 
 		batch.blindData()["tractorDispatcher:visited"] = IECore.BoolData( True )
 
@@ -142,10 +160,32 @@ class TractorDispatcher( GafferDispatch.Dispatcher ) :
 		if task is not None :
 			return task
 
-		# Make a task.
+		# Make a task, splitting it into chunks if necessary.
+
+		chunks = self.__frameChunks( batch, dispatchData )
+		if len( chunks ) == 1 :
+			task = self.__chunkTask( batch, chunks[0], dispatchData )
+			chunkTasks = [ task ]
+		else :
+			nodeName = batch.node().relativeName( dispatchData["scriptNode"] )
+			frames = str( IECore.frameListFromList( [ int( x ) for x in batch.frames() ] ) )
+			task = author.Task( title = nodeName + " " + frames )
+			chunkTasks = [ self.__chunkTask( batch, c, dispatchData ) for c in chunks ]
+			for chunkTask in chunkTasks :
+				task.addChild( chunkTask )
+
+		# Remember the task for next time, and return it.
+
+		dispatchData["batchesToTasks"][batch] = task
+		dispatchData["batchesToChunkTasks"][batch] = chunkTasks
+		return task
+
+	# Returns a task with a command to execute the specified
+	# frames of the batch.
+	def __chunkTask( self, batch, frames, dispatchData ) :
 
 		nodeName = batch.node().relativeName( dispatchData["scriptNode"] )
-		frames = str( IECore.frameListFromList( [ int( x ) for x in batch.frames() ] ) )
+		frames = str( IECore.frameListFromList( [ int( x ) for x in frames ] ) )
 		task = author.Task( title = nodeName + " " + frames )
 
 		# Generate a `gaffer execute` command line suitable for
@@ -164,6 +204,9 @@ class TractorDispatcher( GafferDispatch.Dispatcher ) :
 			if entry not in scriptContext.keys() or batch.context()[entry] != scriptContext[entry] :
 				contextArgs.extend( [ "-" + entry, repr( batch.context()[entry] ) ] )
 
+		if dispatchData["timingsFile"] :
+			args.extend( [ "-timingsFile", dispatchData["timingsFile"] ] )
+
 		if contextArgs :
 			args.extend( [ "-context" ] + contextArgs )
 
@@ -183,11 +226,49 @@ class TractorDispatcher( GafferDispatch.Dispatcher ) :
 			command.service = batch.context().substitute( tractorPlug["service"].getValue() )
 			command.tags = batch.context().substitute( tractorPlug["tags"].getValue() ).split()
 
-		# Remember the task for next time, and return it.
-
-		dispatchData["batchesToTasks"][batch] = task
 		return task
 
+	# Splits the frames of the batch into chunks which are expected
+	# to take roughly `targetTaskDuration` seconds each, based on the
+	# timings recorded by previous dispatches. Batches without timings
+	# are left whole, as are batches which require sequence execution.
+	def __frameChunks( self, batch, dispatchData ) :
+
+		frames = batch.frames()
+		targetTaskDuration = dispatchData["targetTaskDuration"]
+		if not targetTaskDuration or len( frames ) < 2 :
+			return [ frames ]
+
+		frameDuration = dispatchData["timings"].get( batch.node().relativeName( dispatchData["scriptNode"] ) )
+		if not frameDuration :
+			return [ frames ]
+
+		with batch.context() :
+			if batch.plug().requiresSequenceExecution() :
+				return [ frames ]
+
+		# Distribute the frames evenly between the chunks, so we don't
+		# end up with a single tiny chunk at the end.
+		chunkSize = max( 1, int( round( targetTaskDuration / frameDuration ) ) )
+		numChunks = int( math.ceil( len( frames ) / float( chunkSize ) ) )
+
+		return [
+			frames[i * len( frames ) // numChunks : (i + 1) * len( frames ) // numChunks]
+			for i in range( 0, numChunks )
+		]
+
+	@staticmethod
+	def __readTimings( fileName ) :
+
+		try :
+			with open( fileName ) as f :
+				return json.load( f )
+		except ( IOError, ValueError ) :
+			# No previous dispatches, or the file is being
+			# written as we speak. Either way we just
+			# don't chunk.
+			return {}
+
 	@staticmethod
 	def _setupPlugs( parentPlug ) :
 
@@ -197,6 +197,64 @@ class TractorDispatcherTest( GafferTest.TestCase ) :
 
 		self.assertTrue( isinstance( job.subtasks[0].subtasks[1].subtasks[0], author.Instance ) )
 
+	def testChunking( self ) :
+
+		#   n1
+		#   |
+		#   n2
+
+		s = Gaffer.ScriptNode()
+		s["n1"] = GafferDispatchTest.LoggingTaskNode()
+		s["n1"]["p"] = Gaffer.StringPlug( defaultValue = "static" )
+		s["n2"] = GafferDispatchTest.LoggingTaskNode()
+		s["n2"]["frame"] = Gaffer.StringPlug( defaultValue = "${frame}", flags = Gaffer.Plug.Flags.Default | Gaffer.Plug.Flags.Dynamic )
+		s["n2"]["dispatcher"]["batchSize"].setValue( 20 )
+		s["n2"]["preTasks"][0].setInput( s["n1"]["task"] )
+
+		dispatcher = self.__dispatcher()
+		dispatcher["framesMode"].setValue( dispatcher.FramesMode.CustomRange )
+		dispatcher["frameRange"].setValue( "1-20" )
+		dispatcher["targetTaskDuration"].setValue( 10 )
+
+		# Without timings, we can't chunk, but the command
+		# should record timings for next time.
+
+		job = self.__job( [ s["n2"] ], dispatcher )
+		self.assertEqual( len( job.subtasks ), 1 )
+		task = job.subtasks[0]
+		self.assertEqual( task.title, "n2 1-20" )
+		self.assertEqual( len( task.cmds ), 1 )
+		timingsFile = self.temporaryDirectory() + "/testJobDirectory/timings.json"
+		self.assertIn( "-timingsFile", task.cmds[0].argv )
+		self.assertEqual( task.cmds[0].argv[task.cmds[0].argv.index( "-timingsFile" )+1], timingsFile )
+
+		# With timings, we should get evenly sized chunks, all
+		# depending on the upstream task. Frames with identical
+		# hashes should still be merged into a single task.
+
+		with open( timingsFile, "w" ) as f :
+			f.write( '{ "n2" : 3.0, "n1" : 1.0 }' )
+
+		job = self.__job( [ s["n2"] ], dispatcher )
+		self.assertEqual( len( job.subtasks ), 1 )
+		task = job.subtasks[0]
+		self.assertEqual( task.title, "n2 1-20" )
+		self.assertEqual( len( task.cmds ), 0 )
+		self.assertEqual(
+			[ t.title for t in task.subtasks ],
+			[ "n2 1-2", "n2 3-5", "n2 6-8", "n2 9-11", "n2 12-14", "n2 15-17", "n2 18-20" ]
+		)
+		for chunkTask in task.subtasks :
+			self.assertEqual( len( chunkTask.cmds ), 1 )
+			self.assertEqual( [ t.title for t in chunkTask.subtasks ], [ "n1 1" ] )
+
+		# Turning off chunking should restore the original behaviour.
+
+		dispatcher["targetTaskDuration"].setValue( 0 )
+		job = self.__job( [ s["n2"] ], dispatcher )
+		self.assertEqual( len( job.subtasks[0].cmds ), 1 )
+		self.assertNotIn( "-timingsFile", job.subtasks[0].cmds[0].argv )
+
 	def testTypeNamePrefixes( self ) :
 
 		self.assertTypeNamesArePrefixed( GafferTractor )
@@ -82,6 +82,22 @@ Gaffer.Metadata.registerNode(
 
 		],
 
+		"targetTaskDuration" : [
+
+			"description",
+			"""
+			The desired duration for each Tractor task, in seconds.
+			When non-zero, the time taken to execute each frame is
+			recorded on the farm, and subsequent dispatches split large
+			batches into evenly sized chunks expected to take roughly
+			this long. This balances the startup cost of each task against
+			the ability to spread the work across the farm. The batchSize
+			on each node still determines the largest possible task, and
+			nodes which require sequence execution are never split.
+			""",
+
+		],
+
 	}
 
 )
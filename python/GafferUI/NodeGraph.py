@@ -422,7 +422,10 @@ class NodeGraph( GafferUI.EditorWidget ) :
 				IECore.Box3f( IECore.V3f( frame.min.x, frame.min.y, 0 ), IECore.V3f( frame.max.x, frame.max.y, 0 ) )
 			)
 		else :
-			self.__frame( self.graphGadget().getRoot().children( Gaffer.Node ) )
+			# Framing the bound of the whole graph rather than the individual
+			# nodes avoids creating NodeGadgets for offscreen nodes in large
+			# graphs, where creation is deferred until they are visible.
+			self.__frame( [] )
 
 		# do what we need to do to keep our title up to date.
 
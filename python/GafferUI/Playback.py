@@ -58,12 +58,14 @@ class Playback( object ) :
 		self.__context = __context
 		self.__state = self.State.Stopped
 		self.__frameRange = ( 1, 100 )
+		self.__cachedFrames = frozenset()
 
 		self.__playTimer = QtCore.QTimer()
 		self.__playTimer.timeout.connect( Gaffer.WeakMethod( self.__timerCallback ) )
 
 		self.__stateChangedSignal = Gaffer.Signal1()
 		self.__frameRangeChangedSignal = Gaffer.Signal1()
+		self.__cachedFramesChangedSignal = Gaffer.Signal1()
 
 	__instances = []
 	## Acquires the Playback instance for the specified
@@ -132,6 +134,28 @@ class Playback( object ) :
 
 		return self.__frameRangeChangedSignal
 
+	## May be called by anything that computes frames ahead of
+	# time (for instance the SceneView prefetching), to report which
+	# frames are expected to be served from the cache. UI elements
+	# such as the Timeline use this to display the cached ranges.
+	def setCachedFrames( self, frames ) :
+
+		frames = frozenset( frames )
+		if frames == self.__cachedFrames :
+			return
+
+		self.__cachedFrames = frames
+
+		self.cachedFramesChangedSignal()( self )
+
+	def getCachedFrames( self ) :
+
+		return self.__cachedFrames
+
+	def cachedFramesChangedSignal( self ) :
+
+		return self.__cachedFramesChangedSignal
+
 	## Increments the current frame, wrapping around
 	# if the new frame would be outside the frame range.
 	# Also sets the current state to Stopped in the event
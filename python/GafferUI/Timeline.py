@@ -67,7 +67,7 @@ class Timeline( GafferUI.EditorWidget ) :
 			self.__sliderRangeStart.setToolTip( "Slider minimum" )
 			self.__sliderRangeStartChangedConnection = self.__sliderRangeStart.editingFinishedSignal().connect( Gaffer.WeakMethod( self.__sliderRangeChanged ) )
 
-			self.__slider = GafferUI.NumericSlider(
+			self.__slider = _TimelineSlider(
 				value = self.getContext().getFrame(),
 				min = float( scriptNode["frameRange"]["start"].getValue() ),
 				max = float( scriptNode["frameRange"]["end"].getValue() ),
@@ -117,6 +117,8 @@ class Timeline( GafferUI.EditorWidget ) :
 			self.__playback.setFrameRange( self.__sliderRangeStart.getValue(), self.__sliderRangeEnd.getValue() )
 			self.__playbackStateChangedConnection = self.__playback.stateChangedSignal().connect( Gaffer.WeakMethod( self.__playbackStateChanged ) )
 			self.__playbackFrameRangeChangedConnection = self.__playback.frameRangeChangedSignal().connect( Gaffer.WeakMethod( self.__playbackFrameRangeChanged ) )
+			self.__playbackCachedFramesChangedConnection = self.__playback.cachedFramesChangedSignal().connect( Gaffer.WeakMethod( self.__playbackCachedFramesChanged ) )
+			self.__slider.setCachedFrames( self.__playback.getCachedFrames() )
 
 		if "frame" not in modifiedItems :
 			return
@@ -239,6 +241,10 @@ class Timeline( GafferUI.EditorWidget ) :
 			self.__sliderRangeStart.setValue( minValue )
 			self.__sliderRangeEnd.setValue( maxValue )
 
+	def __playbackCachedFramesChanged( self, playback ) :
+
+		self.__slider.setCachedFrames( playback.getCachedFrames() )
+
 	def __incrementFrame( self, increment = 1 ) :
 
 		self.__playback.incrementFrame( increment )
@@ -248,3 +254,46 @@ class Timeline( GafferUI.EditorWidget ) :
 		return "GafferUI.Timeline( scriptNode )"
 
 GafferUI.EditorWidget.registerType( "Timeline", Timeline )
+
+# A slider which additionally draws a bar beneath the frames
+# which Playback reports as being cached.
+class _TimelineSlider( GafferUI.NumericSlider ) :
+
+	def __init__( self, **kw ) :
+
+		GafferUI.NumericSlider.__init__( self, **kw )
+
+		self.__cachedFrames = frozenset()
+
+	def setCachedFrames( self, frames ) :
+
+		frames = frozenset( frames )
+		if frames == self.__cachedFrames :
+			return
+
+		self.__cachedFrames = frames
+		self._qtWidget().update()
+
+	def _drawBackground( self, painter ) :
+
+		GafferUI.NumericSlider._drawBackground( self, painter )
+
+		if not self.__cachedFrames :
+			return
+
+		size = self.size()
+		minValue, maxValue = self.getRange()[:2]
+		valueRange = maxValue - minValue
+		if valueRange == 0 :
+			return
+
+		## \todo Colours should come from some unified style somewhere
+		painter.setPen( QtCore.Qt.NoPen )
+		painter.setBrush( QtGui.QColor( 119, 156, 189 ) )
+
+		frameWidth = size.x / float( valueRange )
+		for frame in self.__cachedFrames :
+			if frame < minValue or frame > maxValue :
+				continue
+			x = size.x * ( frame - minValue ) / float( valueRange )
+			painter.drawRect( QtCore.QRectF( x - frameWidth / 2.0, size.y - 3, frameWidth, 3 ) )
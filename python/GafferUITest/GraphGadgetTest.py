@@ -1318,5 +1318,49 @@ class GraphGadgetTest( GafferUITest.TestCase ) :
 			self.assertTrue( connection.srcNodule().isSame( g.nodeGadget( s["n1"] ).nodule( s["n1"]["sum"] ) ) )
 			self.assertTrue( connection.dstNodule().isSame( g.nodeGadget( s["n2"] ).nodule( s["n2"]["in"][0] ) ) )
 
+	def testDeferredNodeGadgets( self ) :
+
+		s = Gaffer.ScriptNode()
+		g = GafferUI.GraphGadget( s )
+
+		for i in range( 0, 300 ) :
+			s["n%d" % i] = GafferTest.AddNode()
+			g.setNodePosition( s["n%d" % i], IECore.V2f( i * 20, 0 ) )
+			if i :
+				s["n%d" % i]["op1"].setInput( s["n%d" % ( i - 1 )]["sum"] )
+
+		s["unpositioned"] = GafferTest.AddNode()
+
+		# The gadgets for positioned nodes in a large graph
+		# are created lazily, but accessing them must still
+		# work transparently.
+
+		g = GafferUI.GraphGadget( s )
+		self.assertEqual( len( g.children( GafferUI.NodeGadget ) ), 1 )
+		self.assertTrue( g.nodeGadget( s["unpositioned"] ) is not None )
+
+		self.assertTrue( g.bound().intersects( IECore.V3f( 299 * 20, 0, 0 ) ) )
+
+		connection = g.connectionGadget( s["n150"]["op1"] )
+		self.assertTrue( connection is not None )
+		self.assertTrue( connection.srcNodule().isSame( g.nodeGadget( s["n149"] ).nodule( s["n149"]["sum"] ) ) )
+		self.assertTrue( connection.dstNodule().isSame( g.nodeGadget( s["n150"] ).nodule( s["n150"]["op1"] ) ) )
+
+		u = [ x.node().relativeName( s ) for x in g.upstreamNodeGadgets( s["n10"] ) ]
+		self.assertEqual( set( u ), set( [ "n%d" % i for i in range( 0, 10 ) ] ) )
+
+		# Moving a node before its gadget exists should be
+		# reflected once it is created.
+
+		g.setNodePosition( s["n200"], IECore.V2f( 5, 500 ) )
+		self.assertEqual( g.getNodePosition( s["n200"] ), IECore.V2f( 5, 500 ) )
+		self.assertEqual( g.nodeGadget( s["n200"] ).getTransform().translation(), IECore.V3f( 5, 500, 0 ) )
+
+		# As should deletion.
+
+		n = s["n250"]
+		del s["n250"]
+		self.assertTrue( g.nodeGadget( n ) is None )
+
 if __name__ == "__main__":
 	unittest.main()
@@ -36,6 +36,8 @@
 
 import unittest
 
+import IECore
+
 import Gaffer
 import GafferTest
 import GafferUI
@@ -118,5 +120,60 @@ class NoduleLayoutTest( GafferUITest.TestCase ) :
 		self.assertTrue( top.nodule( n["op1"] ) is not None )
 		self.assertTrue( top.nodule( n["op2"] ) is not None )
 
+	class AppendedPlugsNode( Gaffer.Node ) :
+
+		def __init__( self, name = "AppendedPlugsNode" ) :
+
+			Gaffer.Node.__init__( self, name )
+
+	IECore.registerRunTimeTyped( AppendedPlugsNode )
+
+	Gaffer.Metadata.registerValue( AppendedPlugsNode, "first", "noduleLayout:index", -1 )
+
+	def testAppendedPlugs( self ) :
+
+		n = self.AppendedPlugsNode()
+		n["a"] = Gaffer.IntPlug( flags = Gaffer.Plug.Flags.Default | Gaffer.Plug.Flags.Dynamic )
+
+		top = GafferUI.NoduleLayout( n, "top" )
+
+		for i in range( 0, 20 ) :
+			n["p%d" % i] = Gaffer.IntPlug( flags = Gaffer.Plug.Flags.Default | Gaffer.Plug.Flags.Dynamic )
+			self.assertTrue( top.nodule( n["p%d" % i] ) is not None )
+
+		for i in range( 1, 20 ) :
+			self.assertGreater(
+				top.nodule( n["p%d" % i] ).transformedBound( None ).center().x,
+				top.nodule( n["p%d" % ( i - 1 )] ).transformedBound( None ).center().x
+			)
+
+		# A plug appended with an explicit index must still
+		# be sorted into the right place.
+
+		n["first"] = Gaffer.IntPlug( flags = Gaffer.Plug.Flags.Default | Gaffer.Plug.Flags.Dynamic )
+		self.assertLess(
+			top.nodule( n["first"] ).transformedBound( None ).center().x,
+			top.nodule( n["a"] ).transformedBound( None ).center().x
+		)
+
+	def testArrayPlugGrowth( self ) :
+
+		s = Gaffer.ScriptNode()
+		s["n"] = Gaffer.Node()
+		s["n"]["in"] = Gaffer.ArrayPlug(
+			element = Gaffer.IntPlug(),
+			flags = Gaffer.Plug.Flags.Default | Gaffer.Plug.Flags.Dynamic
+		)
+
+		layout = GafferUI.NoduleLayout( s["n"]["in"] )
+
+		for i in range( 0, 50 ) :
+			s["a%d" % i] = GafferTest.AddNode()
+			s["n"]["in"][i].setInput( s["a%d" % i]["sum"] )
+
+		self.assertEqual( len( s["n"]["in"] ), 51 )
+		for p in s["n"]["in"] :
+			self.assertTrue( layout.nodule( p ) is not None )
+
 if __name__ == "__main__":
 	unittest.main()
@@ -35,6 +35,7 @@
 #
 ##########################################################################
 
+import time
 import unittest
 
 import Gaffer
@@ -267,5 +268,28 @@ class PathListingWidgetTest( GafferUITest.TestCase ) :
 		self.assertEqual( len( s ), 1 )
 		self.assertEqual( str( s[0] ), "/a" )
 
+	def testChildrenComputedInBackground( self ) :
+
+		d = { str( i ) : i for i in range( 0, 1000 ) }
+		p = Gaffer.DictPath( d, "/" )
+
+		w = GafferUI.PathListingWidget( p )
+		model = w._qtWidget().model()
+
+		# The children arrive asynchronously, so we must
+		# run the event loop until they are delivered.
+		t = time.time()
+		while model.rowCount() == 0 and time.time() - t < 10 :
+			self.waitForIdle( 100 )
+
+		self.assertEqual( model.rowCount(), 1000 )
+
+		# Paths can still be found immediately, even if
+		# the children haven't been computed yet.
+		w.setPath( Gaffer.DictPath( d, "/" ) )
+		w.setSelectedPaths( [ p.copy().setFromString( "/10" ) ] )
+		self.assertEqual( [ str( x ) for x in w.getSelectedPaths() ], [ "/10" ] )
+		self.assertEqual( model.rowCount(), 1000 )
+
 if __name__ == "__main__":
 	unittest.main()
@@ -34,7 +34,10 @@
 #
 ##########################################################################
 
+import unittest
+
 import Gaffer
+import GafferTest
 import GafferUI
 import GafferUITest
 
@@ -62,5 +65,24 @@ class PlaybackTest( GafferUITest.TestCase ) :
 
 		self.assertTrue( p3a is p3b )
 
+	def testCachedFrames( self ) :
+
+		p = GafferUI.Playback.acquire( Gaffer.Context() )
+		self.assertEqual( p.getCachedFrames(), set() )
+
+		cs = GafferTest.CapturingSlot( p.cachedFramesChangedSignal() )
+
+		p.setCachedFrames( [ 2, 3, 4 ] )
+		self.assertEqual( p.getCachedFrames(), set( [ 2, 3, 4 ] ) )
+		self.assertEqual( len( cs ), 1 )
+		self.assertTrue( cs[0][0] is p )
+
+		p.setCachedFrames( [ 4, 3, 2 ] )
+		self.assertEqual( len( cs ), 1 )
+
+		p.setCachedFrames( [] )
+		self.assertEqual( p.getCachedFrames(), set() )
+		self.assertEqual( len( cs ), 2 )
+
 if __name__ == "__main__":
 	unittest.main()
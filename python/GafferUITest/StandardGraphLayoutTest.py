@@ -741,5 +741,41 @@ class StandardGraphLayoutTest( GafferUITest.TestCase ) :
 		self.assertTrue( isinstance( s["s"]["in"][0], Gaffer.IntPlug ) )
 		self.assertTrue( s["s"]["in"][0].getInput().isSame( s["n"]["sum"] ) )
 
+	def testLayeredLayout( self ) :
+
+		s = Gaffer.ScriptNode()
+
+		# Build a scrambled tree, with three layers of
+		# nodes feeding a single output.
+
+		s["out"] = LayoutNode()
+		for i in range( 0, 3 ) :
+			s["mid%d" % i] = LayoutNode()
+			s["out"]["top%d" % i].setInput( s["mid%d" % i]["bottom0"] )
+			for j in range( 0, 3 ) :
+				s["top%d%d" % ( i, j )] = LayoutNode()
+				s["mid%d" % i]["top%d" % j].setInput( s["top%d%d" % ( i, j )]["bottom0"] )
+
+		g = GafferUI.GraphGadget( s )
+		for i, node in enumerate( reversed( s.children( Gaffer.Node ) ) ) :
+			g.setNodePosition( node, IECore.V2f( ( i * 7 ) % 11, ( i * 5 ) % 13 ) )
+
+		l = g.getLayout()
+		self.assertEqual( l.getLayeredLayout(), False )
+		l.setLayeredLayout( True )
+		self.assertEqual( l.getLayeredLayout(), True )
+
+		l.layoutNodes( g )
+
+		for i in range( 0, 3 ) :
+			self.assertTrue( g.getNodePosition( s["mid%d" % i] ).y < g.getNodePosition( s["top%d0" % i] ).y )
+			self.assertTrue( g.getNodePosition( s["out"] ).y < g.getNodePosition( s["mid%d" % i] ).y )
+			for j in range( 0, 2 ) :
+				self.assertTrue( g.getNodePosition( s["top%d%d" % ( i, j )] ).x < g.getNodePosition( s["top%d%d" % ( i, j + 1 )] ).x )
+			if i < 2 :
+				self.assertTrue( g.getNodePosition( s["mid%d" % i] ).x < g.getNodePosition( s["mid%d" % ( i + 1 )] ).x )
+
+		self.assertNoOverlaps( g )
+
 if __name__ == "__main__":
 	unittest.main()
@@ -0,0 +1,70 @@
+##########################################################################
+#
+#  Copyright (c) 2017, Image Engine Design Inc. All rights reserved.
+#
+#  Redistribution and use in source and binary forms, with or without
+#  modification, are permitted provided that the following conditions are
+#  met:
+#
+#      * Redistributions of source code must retain the above
+#        copyright notice, this list of conditions and the following
+#        disclaimer.
+#
+#      * Redistributions in binary form must reproduce the above
+#        copyright notice, this list of conditions and the following
+#        disclaimer in the documentation and/or other materials provided with
+#        the distribution.
+#
+#      * Neither the name of John Haddon nor the names of
+#        any other contributors to this software may be used to endorse or
+#        promote products derived from this software without specific prior
+#        written permission.
+#
+#  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+#  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+#  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+#  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+#  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+#  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+#  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+#  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+#  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+#  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+#  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#
+##########################################################################
+
+import unittest
+
+import Gaffer
+import GafferTest
+import GafferVTune
+
+class VTuneMonitorTest( GafferTest.TestCase ) :
+
+	def testConstruction( self ) :
+
+		m = GafferVTune.VTuneMonitor()
+		self.assertEqual( m.getComputeOnly(), False )
+		self.assertEqual( m.variableNames(), [ "frame", "scene:path", "image:channelName", "image:tileOrigin" ] )
+
+		m = GafferVTune.VTuneMonitor( computeOnly = True, variableNames = [ "a", "b" ] )
+		self.assertEqual( m.getComputeOnly(), True )
+		self.assertEqual( m.variableNames(), [ "a", "b" ] )
+
+	def testMonitoring( self ) :
+
+		# We can't check the events without a collector, but
+		# computes must work as usual while the monitor is active.
+
+		n = GafferTest.AddNode()
+		n["op1"].setValue( 1 )
+		n["op2"].setValue( 2 )
+
+		with GafferVTune.VTuneMonitor() :
+			with Gaffer.Context() as c :
+				c["scene:path"] = "/a/b"
+				self.assertEqual( n["sum"].getValue(), 3 )
+
+if __name__ == "__main__":
+	unittest.main()
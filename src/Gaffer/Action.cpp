@@ -104,6 +104,11 @@ void Action::merge( const Action *other )
 {
 }
 
+size_t Action::memoryUsage() const
+{
+	return sizeof( Action );
+}
+
 //////////////////////////////////////////////////////////////////////////
 // SimpleAction implementation and Action::enact() convenience overload.
 //////////////////////////////////////////////////////////////////////////
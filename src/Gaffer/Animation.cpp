@@ -34,6 +34,8 @@
 //
 //////////////////////////////////////////////////////////////////////////
 
+#include <algorithm>
+
 #include "boost/bind.hpp"
 
 #include "OpenEXR/ImathFun.h"
@@ -110,13 +112,14 @@ void Animation::CurvePlug::addKey( const Key &key )
 
 bool Animation::CurvePlug::hasKey( float time ) const
 {
-	return m_keys.find( time ) != m_keys.end();
+	Keys::const_iterator it = std::lower_bound( m_keys.begin(), m_keys.end(), Key( time ) );
+	return it != m_keys.end() && it->time == time;
 }
 
 Animation::Key Animation::CurvePlug::getKey( float time ) const
 {
-	Keys::const_iterator it = m_keys.find( time );
-	if( it == m_keys.end() )
+	Keys::const_iterator it = std::lower_bound( m_keys.begin(), m_keys.end(), Key( time ) );
+	if( it == m_keys.end() || it->time != time )
 	{
 		return Key( time, 0.0f, Animation::Invalid );
 	}
@@ -130,7 +133,7 @@ Animation::Key Animation::CurvePlug::closestKey( float time ) const
 		return Key();
 	}
 
-	Keys::const_iterator rightIt = m_keys.lower_bound( time );
+	Keys::const_iterator rightIt = std::lower_bound( m_keys.begin(), m_keys.end(), Key( time ) );
 	if( rightIt == m_keys.end() )
 	{
 		return *m_keys.rbegin();
@@ -148,7 +151,7 @@ Animation::Key Animation::CurvePlug::closestKey( float time ) const
 
 Animation::Key Animation::CurvePlug::previousKey( float time ) const
 {
-	Keys::const_iterator rightIt = m_keys.lower_bound( time );
+	Keys::const_iterator rightIt = std::lower_bound( m_keys.begin(), m_keys.end(), Key( time ) );
 	if( rightIt == m_keys.begin() )
 	{
 		return Key();
@@ -158,7 +161,7 @@ Animation::Key Animation::CurvePlug::previousKey( float time ) const
 
 Animation::Key Animation::CurvePlug::nextKey( float time ) const
 {
-	Keys::const_iterator rightIt = m_keys.upper_bound( time );
+	Keys::const_iterator rightIt = std::upper_bound( m_keys.begin(), m_keys.end(), Key( time ) );
 	if( rightIt == m_keys.end() )
 	{
 		return Key();
@@ -193,7 +196,46 @@ float Animation::CurvePlug::evaluate( float time ) const
 		return 0;
 	}
 
-	Keys::const_iterator right = m_keys.lower_bound( time );
+	return evaluate( time, std::lower_bound( m_keys.begin(), m_keys.end(), Key( time ) ) );
+}
+
+void Animation::CurvePlug::evaluate( const float *times, float *results, size_t n ) const
+{
+	if( m_keys.empty() )
+	{
+		std::fill( results, results + n, 0.0f );
+		return;
+	}
+
+	Keys::const_iterator right = m_keys.begin();
+	for( size_t i = 0; i < n; ++i )
+	{
+		right = lowerBound( times[i], right );
+		results[i] = evaluate( times[i], right );
+	}
+}
+
+Animation::CurvePlug::Keys::const_iterator Animation::CurvePlug::lowerBound( float time, Keys::const_iterator hint ) const
+{
+	// Check if the hint is still correct, or if the next
+	// key along is, before resorting to a binary search.
+	for( int i = 0; i < 2 && hint != m_keys.end(); ++i, ++hint )
+	{
+		if( hint->time >= time )
+		{
+			if( hint == m_keys.begin() || (hint-1)->time < time )
+			{
+				return hint;
+			}
+			break;
+		}
+	}
+
+	return std::lower_bound( m_keys.begin(), m_keys.end(), Key( time ) );
+}
+
+float Animation::CurvePlug::evaluate( float time, Keys::const_iterator right ) const
+{
 	if( right == m_keys.end() )
 	{
 		return m_keys.rbegin()->value;
@@ -231,14 +273,22 @@ const FloatPlug *Animation::CurvePlug::outPlug() const
 
 void Animation::CurvePlug::addOrRemoveKeyInternal( const Key &key )
 {
+	Keys::iterator it = std::lower_bound( m_keys.begin(), m_keys.end(), key );
+	const bool exists = it != m_keys.end() && it->time == key.time;
 	if( !key )
 	{
-		m_keys.erase( key );
+		if( exists )
+		{
+			m_keys.erase( it );
+		}
+	}
+	else if( exists )
+	{
+		*it = key;
 	}
 	else
 	{
-		m_keys.erase( key );
-		m_keys.insert( key );
+		m_keys.insert( it, key );
 	}
 	propagateDirtiness( outPlug() );
 }
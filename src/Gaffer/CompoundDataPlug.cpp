@@ -35,6 +35,8 @@
 //
 //////////////////////////////////////////////////////////////////////////
 
+#include "boost/bind.hpp"
+
 #include "IECore/SplineData.h"
 
 #include "Gaffer/TypedPlug.h"
@@ -51,6 +53,43 @@ using namespace Imath;
 using namespace IECore;
 using namespace Gaffer;
 
+//////////////////////////////////////////////////////////////////////////
+// Utilities
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+// Returns true if the value of the plug might be different
+// in different contexts.
+bool variesWithContext( const Plug *plug )
+{
+	if( plug->direction() != Plug::In || plug->getInput<Plug>() )
+	{
+		return true;
+	}
+
+	if( const StringPlug *stringPlug = runTimeCast<const StringPlug>( plug ) )
+	{
+		if( stringPlug->hasSubstitutions() )
+		{
+			return true;
+		}
+	}
+
+	for( PlugIterator it( plug ); !it.done(); ++it )
+	{
+		if( variesWithContext( it->get() ) )
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+} // namespace
+
 //////////////////////////////////////////////////////////////////////////
 // CompoundData::MemberPlug implementation.
 //////////////////////////////////////////////////////////////////////////
@@ -133,9 +172,18 @@ PlugPtr CompoundDataPlug::MemberPlug::createCounterpart( const std::string &name
 
 IE_CORE_DEFINERUNTIMETYPED( CompoundDataPlug )
 
+CompoundDataPlug::MemberCache::MemberCache()
+	:	variesWithContextDirtyCount( 0 ), variesWithContext( true ), hashDirtyCount( 0 ), dataDirtyCount( 0 )
+{
+}
+
 CompoundDataPlug::CompoundDataPlug( const std::string &name, Direction direction, unsigned flags )
 	:	ValuePlug( name, direction, flags )
 {
+	// Removing a member doesn't dirty us, so we must
+	// invalidate the cache explicitly.
+	childAddedSignal().connect( boost::bind( &CompoundDataPlug::membersChanged, this ) );
+	childRemovedSignal().connect( boost::bind( &CompoundDataPlug::membersChanged, this ) );
 }
 
 CompoundDataPlug::~CompoundDataPlug()
@@ -223,7 +271,57 @@ void CompoundDataPlug::fillCompoundData( IECore::CompoundDataMap &compoundDataMa
 	}
 }
 
+IECore::ConstCompoundDataPtr CompoundDataPlug::compoundData() const
+{
+	const uint64_t dirtyCount = this->dirtyCount();
+	const bool cacheable = !membersVaryWithContext( dirtyCount );
+	if( cacheable )
+	{
+		tbb::spin_mutex::scoped_lock lock( m_memberCacheMutex );
+		if( m_memberCache.dataDirtyCount == dirtyCount )
+		{
+			return m_memberCache.data;
+		}
+	}
+
+	IECore::CompoundDataPtr result = new IECore::CompoundData;
+	fillCompoundData( result->writable() );
+
+	if( cacheable )
+	{
+		tbb::spin_mutex::scoped_lock lock( m_memberCacheMutex );
+		m_memberCache.data = result;
+		m_memberCache.dataDirtyCount = dirtyCount;
+	}
+
+	return result;
+}
+
 IECore::MurmurHash CompoundDataPlug::hash() const
+{
+	const uint64_t dirtyCount = this->dirtyCount();
+	if( membersVaryWithContext( dirtyCount ) )
+	{
+		return hashMembers();
+	}
+
+	{
+		tbb::spin_mutex::scoped_lock lock( m_memberCacheMutex );
+		if( m_memberCache.hashDirtyCount == dirtyCount )
+		{
+			return m_memberCache.hash;
+		}
+	}
+
+	const IECore::MurmurHash result = hashMembers();
+
+	tbb::spin_mutex::scoped_lock lock( m_memberCacheMutex );
+	m_memberCache.hash = result;
+	m_memberCache.hashDirtyCount = dirtyCount;
+	return result;
+}
+
+IECore::MurmurHash CompoundDataPlug::hashMembers() const
 {
 	IECore::MurmurHash h;
 	for( MemberPlugIterator it( this ); !it.done(); ++it )
@@ -248,6 +346,33 @@ void CompoundDataPlug::hash( IECore::MurmurHash &h ) const
 	h.append( hash() );
 }
 
+bool CompoundDataPlug::membersVaryWithContext( uint64_t dirtyCount ) const
+{
+	{
+		tbb::spin_mutex::scoped_lock lock( m_memberCacheMutex );
+		if( m_memberCache.variesWithContextDirtyCount == dirtyCount )
+		{
+			return m_memberCache.variesWithContext;
+		}
+	}
+
+	// Computed outside the lock, since it visits every member.
+	// If another thread races us here it will compute the same
+	// result.
+	const bool result = variesWithContext( this );
+
+	tbb::spin_mutex::scoped_lock lock( m_memberCacheMutex );
+	m_memberCache.variesWithContext = result;
+	m_memberCache.variesWithContextDirtyCount = dirtyCount;
+	return result;
+}
+
+void CompoundDataPlug::membersChanged()
+{
+	tbb::spin_mutex::scoped_lock lock( m_memberCacheMutex );
+	m_memberCache = MemberCache();
+}
+
 void CompoundDataPlug::fillCompoundObject( IECore::CompoundObject::ObjectMap &compoundObjectMap ) const
 {
 	std::string name;
@@ -76,3 +76,18 @@ void ComputeNode::hash( const ValuePlug *output, const Context *context, IECore:
 void ComputeNode::compute( ValuePlug *output, const Context *context ) const
 {
 }
+
+ValuePlug::CachePolicy ComputeNode::computeCachePolicy( const ValuePlug *output ) const
+{
+	return ValuePlug::Standard;
+}
+
+const ValuePlug *ComputeNode::passThrough( const ValuePlug *output, const Context *context ) const
+{
+	return NULL;
+}
+
+bool ComputeNode::contextDependencies( const ValuePlug *output, const Context *context, std::vector<IECore::InternedString> &variables ) const
+{
+	return false;
+}
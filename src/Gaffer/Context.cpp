@@ -44,13 +44,16 @@ static char **environ = *_NSGetEnviron();
 #include <unistd.h>
 #endif
 
+#include <algorithm>
 #include <stack>
+#include <vector>
 
 #include "tbb/enumerable_thread_specific.h"
 
 #include "boost/lexical_cast.hpp"
 
 #include "IECore/SimpleTypedData.h"
+#include "IECore/VectorTypedData.h"
 
 #include "Gaffer/Context.h"
 
@@ -119,16 +122,27 @@ static InternedString g_frame( "frame" );
 static InternedString g_framesPerSecond( "framesPerSecond" );
 
 Context::Context()
-	:	m_changedSignal( NULL ), m_hashValid( false )
+	:	m_changedSignal( NULL ), m_canceller( NULL ), m_hashValid( false )
 {
 	set( g_frame, 1.0f );
 	set( g_framesPerSecond, 24.0f );
 }
 
 Context::Context( const Context &other, Ownership ownership )
-	:	m_map( other.m_map ), m_changedSignal( NULL ), m_hash( other.m_hash ), m_hashValid( other.m_hashValid )
+	:	m_map( other.m_map ), m_changedSignal( NULL ), m_canceller( other.m_canceller ), m_hash( other.m_hash ), m_hashValid( other.m_hashValid )
 {
-	// We used the (shallow) Map copy constructor in our initialiser above
+	initOwnership( ownership );
+}
+
+Context::Context( const Context &other, const Canceller &canceller, Ownership ownership )
+	:	m_map( other.m_map ), m_changedSignal( NULL ), m_canceller( &canceller ), m_hash( other.m_hash ), m_hashValid( other.m_hashValid )
+{
+	initOwnership( ownership );
+}
+
+void Context::initOwnership( Ownership ownership )
+{
+	// The constructors use the (shallow) Map copy constructor in their initialisers
 	// because it offers a big performance win over iterating and inserting copies
 	// ourselves. Now we need to go in and tweak our copies based on the ownership.
 
@@ -172,8 +186,12 @@ void Context::remove( const IECore::InternedString &name )
 	Map::iterator it = m_map.find( name );
 	if( it != m_map.end() )
 	{
+		if( m_hashValid )
+		{
+			const MurmurHash &h = it->second.hash;
+			m_hash = MurmurHash( m_hash.h1() - h.h1(), m_hash.h2() - h.h2() );
+		}
 		m_map.erase( it );
-		m_hashValid = false;
 		if( m_changedSignal )
 		{
 			(*m_changedSignal)( this, name );
@@ -183,13 +201,90 @@ void Context::remove( const IECore::InternedString &name )
 
 void Context::changed( const IECore::InternedString &name )
 {
-	m_hashValid = false;
+	Map::iterator it = m_map.find( name );
+	if( it != m_map.end() )
+	{
+		entryChanged( name, it->second );
+	}
+	else
+	{
+		m_hashValid = false;
+	}
+
 	if( m_changedSignal )
 	{
 		(*m_changedSignal)( this, name );
 	}
 }
 
+void Context::entryChanged( const IECore::InternedString &name, Storage &storage )
+{
+	if( !m_hashValid )
+	{
+		// The hash will be computed from scratch when
+		// it is next needed, so we can defer the work of
+		// hashing this entry until then.
+		storage.hashValid = false;
+		return;
+	}
+
+	// Update the total incrementally, by subtracting the
+	// old entry hash and adding the new one. The entry hash
+	// will be invalid if this is a brand new entry.
+	uint64_t h1 = m_hash.h1();
+	uint64_t h2 = m_hash.h2();
+	if( storage.hashValid )
+	{
+		h1 -= storage.hash.h1();
+		h2 -= storage.hash.h2();
+	}
+
+	updateEntryHash( name, storage );
+
+	m_hash = MurmurHash( h1 + storage.hash.h1(), h2 + storage.hash.h2() );
+}
+
+void Context::updateEntryHash( const IECore::InternedString &name, const Storage &storage )
+{
+	storage.hash = IECore::MurmurHash();
+	storage.hashValid = true;
+
+	/// \todo Perhaps at some point the UI should use a different container for
+	/// these "not computationally important" values, so we wouldn't have to skip
+	/// them here.
+	// Using a hardcoded comparison of the first three characters because
+	// it's quicker than `string::compare( 0, 3, "ui:" )`.
+	const std::string &s = name.string();
+	if(	s.size() > 2 && s[0] == 'u' && s[1] == 'i' && s[2] == ':' )
+	{
+		// A null hash contributes nothing to the sum.
+		return;
+	}
+
+	storage.hash.append( (uint64_t)&s );
+
+	if( const InternedStringVectorData *v = runTimeCast<const InternedStringVectorData>( storage.data ) )
+	{
+		// Fast path for "scene:path" and other InternedString vectors,
+		// which are set for practically every compute. Context hashes
+		// are only ever used within a single process, so we can hash
+		// the addresses of the unique strings rather than their contents,
+		// in the same way as for the entry name above. This makes the
+		// cost proportional to the depth of the path rather than the
+		// total length of its names.
+		const std::vector<InternedString> &names = v->readable();
+		storage.hash.append( (uint64_t)InternedStringVectorDataTypeId );
+		storage.hash.append( (uint64_t)names.size() );
+		for( std::vector<InternedString>::const_iterator it = names.begin(), eIt = names.end(); it != eIt; ++it )
+		{
+			storage.hash.append( (uint64_t)it->c_str() );
+		}
+		return;
+	}
+
+	storage.data->hash( storage.hash );
+}
+
 void Context::names( std::vector<IECore::InternedString> &names ) const
 {
 	for( Map::const_iterator it = m_map.begin(), eIt = m_map.end(); it != eIt; it++ )
@@ -228,6 +323,11 @@ void Context::setTime( float timeInSeconds )
 	setFrame( timeInSeconds * getFramesPerSecond() );
 }
 
+const Canceller *Context::canceller() const
+{
+	return m_canceller;
+}
+
 Context::ChangedSignal &Context::changedSignal()
 {
 	if( !m_changedSignal )
@@ -250,26 +350,48 @@ IECore::MurmurHash Context::hash() const
 		return m_hash;
 	}
 
-	m_hash = IECore::MurmurHash();
+	// We sum the entry hashes rather than appending them
+	// in sequence, so that entryChanged() can update the
+	// total incrementally.
+	uint64_t h1 = 0;
+	uint64_t h2 = 0;
 	for( Map::const_iterator it = m_map.begin(), eIt = m_map.end(); it != eIt; ++it )
 	{
-		/// \todo Perhaps at some point the UI should use a different container for
-		/// these "not computationally important" values, so we wouldn't have to skip
-		/// them here.
-		// Using a hardcoded comparison of the first three characters because
-		// it's quicker than `string::compare( 0, 3, "ui:" )`.
-		const std::string &name = it->first.string();
-		if(	name.size() > 2 && name[0] == 'u' && name[1] == 'i' && name[2] == ':' )
+		if( !it->second.hashValid )
 		{
-			continue;
+			updateEntryHash( it->first, it->second );
 		}
-		m_hash.append( (uint64_t)&name );
-		it->second.data->hash( m_hash );
+		h1 += it->second.hash.h1();
+		h2 += it->second.hash.h2();
 	}
+	m_hash = IECore::MurmurHash( h1, h2 );
 	m_hashValid = true;
 	return m_hash;
 }
 
+IECore::MurmurHash Context::variablesHash( const std::vector<IECore::InternedString> &names ) const
+{
+	// As for hash(), the result is a sum of entry hashes, so that
+	// it is independent of the order of the names.
+	uint64_t h1 = 0;
+	uint64_t h2 = 0;
+	for( std::vector<IECore::InternedString>::const_iterator it = names.begin(), eIt = names.end(); it != eIt; ++it )
+	{
+		Map::const_iterator mIt = m_map.find( *it );
+		if( mIt == m_map.end() )
+		{
+			continue;
+		}
+		if( !mIt->second.hashValid )
+		{
+			updateEntryHash( mIt->first, mIt->second );
+		}
+		h1 += mIt->second.hash.h1();
+		h2 += mIt->second.hash.h2();
+	}
+	return IECore::MurmurHash( h1, h2 );
+}
+
 bool Context::operator == ( const Context &other ) const
 {
 	if( m_map.size() != other.m_map.size() )
@@ -418,33 +540,7 @@ void Context::substituteInternal( const char *s, std::string &result, const int
 					}
 
 					InternedString variableName( variableNameStart, variableNameEnd - variableNameStart );
-					const IECore::Data *d = get<IECore::Data>( variableName, NULL );
-					if( d )
-					{
-						switch( d->typeId() )
-						{
-							case IECore::StringDataTypeId :
-								substituteInternal( static_cast<const IECore::StringData *>( d )->readable().c_str(), result, recursionDepth + 1, substitutions );
-								break;
-							case IECore::FloatDataTypeId :
-								result += boost::lexical_cast<std::string>(
-									static_cast<const IECore::FloatData *>( d )->readable()
-								);
-								break;
-							case IECore::IntDataTypeId :
-								result += boost::lexical_cast<std::string>(
-									static_cast<const IECore::IntData *>( d )->readable()
-								);
-								break;
-							default :
-								break;
-						}
-					}
-					else if( const char *v = g_environment.get( variableName ) )
-					{
-						// variable not in context - try environment
-						result += v;
-					}
+					substituteVariable( variableName, result, recursionDepth, substitutions );
 				}
 				else
 				{
@@ -463,10 +559,7 @@ void Context::substituteInternal( const char *s, std::string &result, const int
 						padding++;
 						s++;
 					}
-					int frame = (int)round( getFrame() );
-					std::ostringstream padder;
-					padder << std::setw( padding ) << std::setfill( '0' ) << frame;
-					result += padder.str();
+					substituteFrame( padding, result );
 				}
 				else
 				{
@@ -477,12 +570,9 @@ void Context::substituteInternal( const char *s, std::string &result, const int
 			}
 			case '~' :
 			{
-				if( substitutions & TildeSubstitutions && result.size() == 0 )
+				if( substitutions & TildeSubstitutions )
 				{
-					if( const char *v = getenv( "HOME" ) )
-					{
-						result += v;
-					}
+					substituteTilde( result );
 					++s;
 					break;
 				}
@@ -500,6 +590,219 @@ void Context::substituteInternal( const char *s, std::string &result, const int
 	}
 }
 
+void Context::substituteVariable( const IECore::InternedString &name, std::string &result, const int recursionDepth, unsigned substitutions ) const
+{
+	const IECore::Data *d = get<IECore::Data>( name, NULL );
+	if( d )
+	{
+		switch( d->typeId() )
+		{
+			case IECore::StringDataTypeId :
+				substituteInternal( static_cast<const IECore::StringData *>( d )->readable().c_str(), result, recursionDepth + 1, substitutions );
+				break;
+			case IECore::FloatDataTypeId :
+				result += boost::lexical_cast<std::string>(
+					static_cast<const IECore::FloatData *>( d )->readable()
+				);
+				break;
+			case IECore::IntDataTypeId :
+				result += boost::lexical_cast<std::string>(
+					static_cast<const IECore::IntData *>( d )->readable()
+				);
+				break;
+			default :
+				break;
+		}
+	}
+	else if( const char *v = g_environment.get( name ) )
+	{
+		// variable not in context - try environment
+		result += v;
+	}
+}
+
+void Context::substituteFrame( int padding, std::string &result ) const
+{
+	int frame = (int)round( getFrame() );
+	std::ostringstream padder;
+	padder << std::setw( padding ) << std::setfill( '0' ) << frame;
+	result += padder.str();
+}
+
+void Context::substituteTilde( std::string &result )
+{
+	// Tildes are only expanded at the start of a string.
+	if( result.size() )
+	{
+		result.push_back( '~' );
+	}
+	else if( const char *v = getenv( "HOME" ) )
+	{
+		result += v;
+	}
+}
+
+std::string Context::substitute( const SubstitutionTemplate &substitutionTemplate ) const
+{
+	std::string result;
+	result.reserve( substitutionTemplate.m_inputSize );
+	for( SubstitutionTemplate::Tokens::const_iterator it = substitutionTemplate.m_tokens.begin(), eIt = substitutionTemplate.m_tokens.end(); it != eIt; ++it )
+	{
+		switch( it->type )
+		{
+			case SubstitutionTemplate::Literal :
+				result += it->text;
+				break;
+			case SubstitutionTemplate::Variable :
+				substituteVariable( it->variable, result, 0, substitutionTemplate.m_substitutions );
+				break;
+			case SubstitutionTemplate::Frame :
+				substituteFrame( it->padding, result );
+				break;
+			case SubstitutionTemplate::Tilde :
+				substituteTilde( result );
+				break;
+		}
+	}
+	return result;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// SubstitutionTemplate implementation
+//////////////////////////////////////////////////////////////////////////
+
+Context::SubstitutionTemplate::SubstitutionTemplate( const std::string &input, unsigned substitutions )
+	:	m_substitutions( substitutions ), m_inputSize( input.size() ), m_hasSubstitutions( false )
+{
+	// This mirrors the parsing in Context::substituteInternal(), but
+	// records tokens rather than performing the substitutions.
+
+	std::string literal;
+	const char *s = input.c_str();
+	while( *s )
+	{
+		Token token;
+		token.padding = 0;
+		switch( *s )
+		{
+			case '\\' :
+				s++;
+				if( !( substitutions & EscapeSubstitutions ) )
+				{
+					literal.push_back( '\\' );
+				}
+				else
+				{
+					m_hasSubstitutions = true;
+					if( *s )
+					{
+						literal.push_back( *s++ );
+					}
+				}
+				continue;
+			case '$' :
+				if( !( substitutions & VariableSubstitutions ) )
+				{
+					literal.push_back( *s++ );
+					continue;
+				}
+				else
+				{
+					s++; // skip $
+					const char *variableNameStart = NULL;
+					const char *variableNameEnd = NULL;
+					if( *s == '{' )
+					{
+						s++; // skip initial bracket
+						variableNameStart = s;
+						while( *s && *s != '}' )
+						{
+							s++;
+						}
+						variableNameEnd = s;
+						if( *s )
+						{
+							s++; // skip final bracket
+						}
+					}
+					else
+					{
+						variableNameStart = s;
+						while( isalnum( *s ) )
+						{
+							s++;
+						}
+						variableNameEnd = s;
+					}
+					token.type = Variable;
+					token.variable = InternedString( variableNameStart, variableNameEnd - variableNameStart );
+					if( std::find( m_variables.begin(), m_variables.end(), token.variable ) == m_variables.end() )
+					{
+						m_variables.push_back( token.variable );
+					}
+				}
+				break;
+			case '#' :
+				if( !( substitutions & FrameSubstitutions ) )
+				{
+					literal.push_back( *s++ );
+					continue;
+				}
+				token.type = Frame;
+				while( *s == '#' )
+				{
+					token.padding++;
+					s++;
+				}
+				break;
+			case '~' :
+				if( !( substitutions & TildeSubstitutions ) )
+				{
+					literal.push_back( *s++ );
+					continue;
+				}
+				token.type = Tilde;
+				s++;
+				break;
+			default :
+				literal.push_back( *s++ );
+				continue;
+		}
+
+		// We have a substitution token. Flush any literal
+		// which preceded it, and then store it.
+		m_hasSubstitutions = true;
+		if( literal.size() )
+		{
+			Token literalToken;
+			literalToken.type = Literal;
+			literalToken.text.swap( literal );
+			literalToken.padding = 0;
+			m_tokens.push_back( literalToken );
+		}
+		m_tokens.push_back( token );
+	}
+
+	if( literal.size() )
+	{
+		Token literalToken;
+		literalToken.type = Literal;
+		literalToken.text.swap( literal );
+		literalToken.padding = 0;
+		m_tokens.push_back( literalToken );
+	}
+}
+
+bool Context::SubstitutionTemplate::hasSubstitutions() const
+{
+	return m_hasSubstitutions;
+}
+
+const std::vector<IECore::InternedString> &Context::SubstitutionTemplate::variables() const
+{
+	return m_variables;
+}
+
 //////////////////////////////////////////////////////////////////////////
 // Scope and current context implementation
 //////////////////////////////////////////////////////////////////////////
@@ -528,6 +831,170 @@ Context::Scope::~Scope()
 	}
 }
 
+//////////////////////////////////////////////////////////////////////////
+// EditableScope implementation
+//////////////////////////////////////////////////////////////////////////
+
+// A Context and associated scratch storage, reused
+// by successive EditableScopes on the same thread.
+struct Context::EditableScope::Pooled
+{
+
+	Pooled()
+		:	context( new Context )
+	{
+	}
+
+	ContextPtr context;
+
+	typedef boost::container::flat_map<IECore::InternedString, IECore::DataPtr> ScratchMap;
+	ScratchMap scratch;
+
+	static Pooled *acquire()
+	{
+		Pool &pool = threadPool();
+		if( pool.empty() )
+		{
+			return new Pooled;
+		}
+		Pooled *result = pool.back();
+		pool.pop_back();
+		return result;
+	}
+
+	static void release( Pooled *pooled )
+	{
+		threadPool().push_back( pooled );
+	}
+
+	private :
+
+		typedef std::vector<Pooled *> Pool;
+
+		struct ThreadPool
+		{
+			~ThreadPool()
+			{
+				for( Pool::const_iterator it = pool.begin(), eIt = pool.end(); it != eIt; ++it )
+				{
+					delete *it;
+				}
+			}
+
+			Pool pool;
+		};
+
+		static Pool &threadPool()
+		{
+			static tbb::enumerable_thread_specific<ThreadPool, tbb::cache_aligned_allocator<ThreadPool>, tbb::ets_key_per_instance> g_threadPools;
+			return g_threadPools.local().pool;
+		}
+
+};
+
+Context::EditableScope::EditableScope( const Context *context )
+	:	m_pooled( Pooled::acquire() ), m_context( m_pooled->context.get() )
+{
+	// Release anything owned from previous use
+	// of the pooled context.
+	for( Map::const_iterator it = m_context->m_map.begin(), eIt = m_context->m_map.end(); it != eIt; ++it )
+	{
+		if( it->second.ownership != Borrowed )
+		{
+			it->second.data->removeRef();
+		}
+	}
+
+	// Borrow everything from the source context. Assigning
+	// the map reuses the storage from previous use of the
+	// pooled context, so no allocation is needed unless the
+	// source has more entries than we've seen before.
+	m_context->m_map = context->m_map;
+	for( Map::iterator it = m_context->m_map.begin(), eIt = m_context->m_map.end(); it != eIt; ++it )
+	{
+		it->second.ownership = Borrowed;
+	}
+	m_context->m_hash = context->m_hash;
+	m_context->m_hashValid = context->m_hashValid;
+	m_context->m_canceller = context->m_canceller;
+
+	g_threadContexts.local().push( m_context );
+}
+
+Context::EditableScope::~EditableScope()
+{
+	g_threadContexts.local().pop();
+
+	if( m_context->refCount() > 1 )
+	{
+		// Someone has taken a reference to our context, so we
+		// can't reuse it. Transfer ownership of any scratch data
+		// to the context itself, and abandon it to its fate.
+		for( Map::iterator it = m_context->m_map.begin(), eIt = m_context->m_map.end(); it != eIt; ++it )
+		{
+			Pooled::ScratchMap::const_iterator sIt = m_pooled->scratch.find( it->first );
+			if( sIt != m_pooled->scratch.end() && sIt->second.get() == it->second.data )
+			{
+				it->second.data->addRef();
+				it->second.ownership = Shared;
+			}
+		}
+		delete m_pooled;
+		return;
+	}
+
+	Pooled::release( m_pooled );
+}
+
+void Context::EditableScope::setFrame( float frame )
+{
+	set( g_frame, frame );
+}
+
+void Context::EditableScope::setTime( float timeInSeconds )
+{
+	setFrame( timeInSeconds * m_context->getFramesPerSecond() );
+}
+
+void Context::EditableScope::remove( const IECore::InternedString &name )
+{
+	m_context->remove( name );
+}
+
+const Context *Context::EditableScope::context() const
+{
+	return m_context;
+}
+
+IECore::Data *Context::EditableScope::scratchData( const IECore::InternedString &name, IECore::TypeId typeId )
+{
+	IECore::DataPtr &d = m_pooled->scratch[name];
+	if( !d || d->typeId() != typeId || d->refCount() > 1 )
+	{
+		// We don't have suitable data, or someone else has taken a reference
+		// to it and therefore we can't modify it. Make fresh data.
+		d = IECore::runTimeCast<IECore::Data>( IECore::Object::create( typeId ) );
+	}
+	return d.get();
+}
+
+void Context::borrow( const IECore::InternedString &name, const IECore::Data *data )
+{
+	Storage &s = m_map[name];
+	if( s.data != data && s.data && s.ownership != Borrowed )
+	{
+		s.data->removeRef();
+	}
+	s.data = data;
+	s.ownership = Borrowed;
+
+	entryChanged( name, s );
+	if( m_changedSignal )
+	{
+		(*m_changedSignal)( this, name );
+	}
+}
+
 const Context *Context::current()
 {
 	ContextStack &stack = g_threadContexts.local();
@@ -95,7 +95,7 @@ bool FileSequencePathFilter::remove( PathPtr path ) const
 		return false;
 	}
 
-	if( m_mode == All || boost::filesystem::is_directory( fileSystemPath->string() ) )
+	if( m_mode == All || ( fileSystemPath->isValid() && !fileSystemPath->isLeaf() ) )
 	{
 		// always keep directories (and All)
 		return false;
@@ -107,10 +107,10 @@ bool FileSequencePathFilter::remove( PathPtr path ) const
 		return false;
 	}
 
-	std::vector<std::string> names( 1, fileSystemPath->string() );
-	std::vector<FileSequencePtr> sequences;
-	IECore::findSequences( names, sequences, /* minSequenceSize = */ 1 );
-	bool isSequentialFile = !sequences.empty();
+	// FileSystemPath answers these queries from its cache
+	// of the parent directory listing where possible, which
+	// is much quicker than querying the filesystem.
+	const bool isSequentialFile = fileSystemPath->isSequentialFile();
 
 	if( ( m_mode & SequentialFiles ) && isSequentialFile )
 	{
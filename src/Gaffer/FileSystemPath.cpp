@@ -43,6 +43,11 @@
 #include "boost/filesystem/operations.hpp"
 #include "boost/algorithm/string.hpp"
 #include "boost/date_time/posix_time/conversion.hpp"
+#include "boost/unordered_map.hpp"
+
+#include "tbb/parallel_for.h"
+#include "tbb/blocked_range.h"
+#include "tbb/tick_count.h"
 
 #include "IECore/SimpleTypedData.h"
 #include "IECore/DateTimeData.h"
@@ -53,6 +58,7 @@
 #include "Gaffer/FileSequencePathFilter.h"
 #include "Gaffer/CompoundPathFilter.h"
 #include "Gaffer/MatchPatternPathFilter.h"
+#include "Gaffer/Private/IECorePreview/LRUCache.h"
 
 using namespace std;
 using namespace boost::filesystem;
@@ -69,6 +75,299 @@ static InternedString g_modificationTimePropertyName( "fileSystem:modificationTi
 static InternedString g_sizePropertyName( "fileSystem:size" );
 static InternedString g_frameRangePropertyName( "fileSystem:frameRange" );
 
+//////////////////////////////////////////////////////////////////////////
+// Directory listing cache
+//
+// Listing a directory and querying each child individually is very slow
+// on network filesystems, where every stat() is a round trip to the
+// server. So when listing a directory we stat all the entries in parallel,
+// find the sequences among them in a single pass, and keep the results
+// briefly in a cache shared by all FileSystemPaths. Queries on the children
+// are then answered from the cache rather than the filesystem. Anything
+// not found in the cache falls back to querying the filesystem directly.
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+struct FileStatus
+{
+	bool isDirectory;
+	bool isRegularFile;
+	std::time_t modificationTime;
+	uintmax_t size;
+	uid_t uid;
+	gid_t gid;
+};
+
+bool statFile( const std::string &fileName, FileStatus &status )
+{
+	struct stat s;
+	if( stat( fileName.c_str(), &s ) != 0 )
+	{
+		return false;
+	}
+
+	status.isDirectory = S_ISDIR( s.st_mode );
+	status.isRegularFile = S_ISREG( s.st_mode );
+	status.modificationTime = s.st_mtime;
+	status.size = s.st_size;
+	status.uid = s.st_uid;
+	status.gid = s.st_gid;
+	return true;
+}
+
+class DirectoryListing : public IECore::RefCounted
+{
+
+	public :
+
+		struct Entry
+		{
+			std::string name;
+			// False if stat() failed, as it does
+			// for broken symlinks.
+			bool statValid;
+			FileStatus status;
+			// True if the file could form part of
+			// a FileSequence.
+			bool sequential;
+		};
+
+		typedef std::vector<Entry> Entries;
+
+		DirectoryListing( const std::string &directory, std::time_t modificationTime )
+			:	m_modificationTime( modificationTime ), m_creationTime( tbb::tick_count::now() )
+		{
+			const path p( directory );
+			for( directory_iterator it( p ), eIt; it != eIt; ++it )
+			{
+				Entry entry;
+				entry.name = it->path().filename().string();
+				entry.statValid = false;
+				entry.sequential = false;
+				m_entries.push_back( entry );
+			}
+
+			tbb::parallel_for( tbb::blocked_range<size_t>( 0, m_entries.size() ), StatTask( p, m_entries ) );
+
+			std::vector<std::string> fileNames;
+			for( size_t i = 0, e = m_entries.size(); i < e; ++i )
+			{
+				m_indices[m_entries[i].name] = i;
+				if( !m_entries[i].statValid || !m_entries[i].status.isDirectory )
+				{
+					fileNames.push_back( m_entries[i].name );
+				}
+			}
+
+			IECore::findSequences( fileNames, m_sequences, /* minSequenceSize = */ 1 );
+			std::vector<std::string> sequenceFileNames;
+			for( std::vector<FileSequencePtr>::const_iterator it = m_sequences.begin(), eIt = m_sequences.end(); it != eIt; ++it )
+			{
+				sequenceFileNames.clear();
+				(*it)->fileNames( sequenceFileNames );
+				for( std::vector<std::string>::const_iterator nIt = sequenceFileNames.begin(), nEIt = sequenceFileNames.end(); nIt != nEIt; ++nIt )
+				{
+					Indices::const_iterator iIt = m_indices.find( *nIt );
+					if( iIt != m_indices.end() )
+					{
+						m_entries[iIt->second].sequential = true;
+					}
+				}
+			}
+		}
+
+		const Entries &entries() const
+		{
+			return m_entries;
+		}
+
+		const Entry *entry( const std::string &name ) const
+		{
+			Indices::const_iterator it = m_indices.find( name );
+			return it != m_indices.end() ? &m_entries[it->second] : NULL;
+		}
+
+		const std::vector<FileSequencePtr> &sequences() const
+		{
+			return m_sequences;
+		}
+
+		FileSequence *sequence( const std::string &fileName ) const
+		{
+			for( std::vector<FileSequencePtr>::const_iterator it = m_sequences.begin(), eIt = m_sequences.end(); it != eIt; ++it )
+			{
+				if( (*it)->getFileName() == fileName )
+				{
+					return it->get();
+				}
+			}
+			return NULL;
+		}
+
+		std::time_t modificationTime() const
+		{
+			return m_modificationTime;
+		}
+
+		bool expired() const
+		{
+			return ( tbb::tick_count::now() - m_creationTime ).seconds() > g_lifetime;
+		}
+
+	private :
+
+		struct StatTask
+		{
+
+			StatTask( const path &directory, Entries &entries )
+				:	m_directory( directory ), m_entries( entries )
+			{
+			}
+
+			void operator()( const tbb::blocked_range<size_t> &r ) const
+			{
+				for( size_t i = r.begin(); i != r.end(); ++i )
+				{
+					Entry &entry = m_entries[i];
+					entry.statValid = statFile( ( m_directory / entry.name ).string(), entry.status );
+				}
+			}
+
+			private :
+
+				const path &m_directory;
+				Entries &m_entries;
+
+		};
+
+		typedef boost::unordered_map<std::string, size_t> Indices;
+
+		Entries m_entries;
+		Indices m_indices;
+		std::vector<FileSequencePtr> m_sequences;
+		const std::time_t m_modificationTime;
+		const tbb::tick_count m_creationTime;
+
+		// Listings are only used for this many seconds
+		// after their creation, so that changes to the
+		// filesystem are picked up promptly.
+		static const double g_lifetime;
+
+};
+
+const double DirectoryListing::g_lifetime = 5.0;
+
+IE_CORE_DECLAREPTR( DirectoryListing )
+
+ConstDirectoryListingPtr nullGetter( const std::string &directory, size_t &cost )
+{
+	cost = 0;
+	return NULL;
+}
+
+// Cost is measured in entries.
+typedef IECorePreview::LRUCache<std::string, ConstDirectoryListingPtr> DirectoryListingCache;
+DirectoryListingCache g_directoryListingCache( nullGetter, 1000000 );
+
+std::string cacheKey( const std::string &directory )
+{
+	// Made absolute so that relative paths remain
+	// valid if the working directory is changed.
+	return absolute( path( directory ) ).string();
+}
+
+// Returns a new listing for the directory, or one from the cache if it
+// is still current. Returns NULL if the directory can't be listed.
+ConstDirectoryListingPtr directoryListing( const std::string &directory )
+{
+	FileStatus status;
+	if( !statFile( directory, status ) || !status.isDirectory )
+	{
+		return NULL;
+	}
+
+	const std::string key = cacheKey( directory );
+	if( boost::optional<ConstDirectoryListingPtr> listing = g_directoryListingCache.getIfCached( key ) )
+	{
+		if( !(*listing)->expired() && (*listing)->modificationTime() == status.modificationTime )
+		{
+			return *listing;
+		}
+	}
+
+	ConstDirectoryListingPtr result;
+	try
+	{
+		result = new DirectoryListing( directory, status.modificationTime );
+	}
+	catch( const filesystem_error & )
+	{
+		return NULL;
+	}
+
+	g_directoryListingCache.set( key, result, result->entries().size() + 1 );
+	return result;
+}
+
+// Returns the cached listing for the directory containing fileName,
+// without ever listing the directory itself. The file's name within
+// the directory is returned in `name`.
+ConstDirectoryListingPtr cachedDirectoryListing( const std::string &fileName, std::string &name )
+{
+	const path p = absolute( path( fileName ) );
+	boost::optional<ConstDirectoryListingPtr> listing = g_directoryListingCache.getIfCached( p.parent_path().string() );
+	if( !listing || (*listing)->expired() )
+	{
+		return NULL;
+	}
+
+	name = p.filename().string();
+	return *listing;
+}
+
+// Equivalent to symlink_status( fileName ).type() != file_not_found
+// (and not an error), but using the cache where possible.
+bool fileExists( const std::string &fileName )
+{
+	std::string name;
+	if( ConstDirectoryListingPtr listing = cachedDirectoryListing( fileName, name ) )
+	{
+		if( listing->entry( name ) )
+		{
+			return true;
+		}
+	}
+
+	const file_type t = symlink_status( path( fileName ) ).type();
+	return t != status_error && t != file_not_found;
+}
+
+// Equivalent to stat(), but using the cache where possible.
+bool fileStatus( const std::string &fileName, FileStatus &status )
+{
+	std::string name;
+	if( ConstDirectoryListingPtr listing = cachedDirectoryListing( fileName, name ) )
+	{
+		if( const DirectoryListing::Entry *entry = listing->entry( name ) )
+		{
+			status = entry->status;
+			return entry->statValid;
+		}
+	}
+
+	return statFile( fileName, status );
+}
+
+bool isDirectory( const std::string &fileName )
+{
+	FileStatus status;
+	return fileStatus( fileName, status ) && status.isDirectory;
+}
+
+} // namespace
+
 FileSystemPath::FileSystemPath( PathFilterPtr filter, bool includeSequences )
 	:	Path( filter ), m_includeSequences( includeSequences )
 {
@@ -100,13 +399,12 @@ bool FileSystemPath::isValid() const
 		return true;
 	}
 
-	const file_type t = symlink_status( path( this->string() ) ).type();
-	return t != status_error && t != file_not_found;
+	return fileExists( this->string() );
 }
 
 bool FileSystemPath::isLeaf() const
 {
-	return isValid() && !is_directory( path( this->string() ) );
+	return isValid() && !isDirectory( this->string() );
 }
 
 bool FileSystemPath::getIncludeSequences() const
@@ -121,7 +419,7 @@ void FileSystemPath::setIncludeSequences( bool includeSequences )
 
 bool FileSystemPath::isFileSequence() const
 {
-	if( !m_includeSequences || is_directory( path( this->string() ) ) )
+	if( !m_includeSequences || isDirectory( this->string() ) )
 	{
 		return false;
 	}
@@ -137,13 +435,42 @@ bool FileSystemPath::isFileSequence() const
 	return false;
 }
 
+bool FileSystemPath::isSequentialFile() const
+{
+	const std::string fileName = this->string();
+
+	std::string name;
+	if( ConstDirectoryListingPtr listing = cachedDirectoryListing( fileName, name ) )
+	{
+		if( const DirectoryListing::Entry *entry = listing->entry( name ) )
+		{
+			return entry->sequential;
+		}
+	}
+
+	std::vector<std::string> names( 1, fileName );
+	std::vector<FileSequencePtr> sequences;
+	IECore::findSequences( names, sequences, /* minSequenceSize = */ 1 );
+	return !sequences.empty();
+}
+
 FileSequencePtr FileSystemPath::fileSequence() const
 {
-	if( !m_includeSequences || is_directory( path( this->string() ) ) )
+	const std::string fileName = this->string();
+	if( !m_includeSequences || isDirectory( fileName ) )
 	{
 		return NULL;
 	}
 
+	std::string name;
+	if( ConstDirectoryListingPtr listing = cachedDirectoryListing( fileName, name ) )
+	{
+		if( FileSequence *sequence = listing->sequence( name ) )
+		{
+			return new FileSequence( fileName, sequence->getFrameList()->copy() );
+		}
+	}
+
 	FileSequencePtr sequence = NULL;
 	IECore::ls( this->string(), sequence, /* minSequenceSize = */ 1 );
 	return sequence;
@@ -181,9 +508,8 @@ IECore::ConstRunTimeTypedPtr FileSystemPath::property( const IECore::InternedStr
 				std::map<std::string,size_t> ownerCounter;
 				for( std::vector<std::string>::iterator it = files.begin(); it != files.end(); ++it )
 				{
-					struct stat s;
-					stat( it->c_str(), &s );
-					struct passwd *pw = getpwuid( s.st_uid );
+					FileStatus s;
+					struct passwd *pw = fileStatus( *it, s ) ? getpwuid( s.uid ) : NULL;
 					std::string value = pw ? pw->pw_name : "";
 					std::pair<std::map<std::string,size_t>::iterator,bool> oIt = ownerCounter.insert( std::pair<std::string,size_t>( value, 0 ) );
 					oIt.first->second++;
@@ -197,10 +523,8 @@ IECore::ConstRunTimeTypedPtr FileSystemPath::property( const IECore::InternedStr
 			}
 		}
 
-		std::string n = this->string();
-		struct stat s;
-		stat( n.c_str(), &s );
-		struct passwd *pw = getpwuid( s.st_uid );
+		FileStatus s;
+		struct passwd *pw = fileStatus( this->string(), s ) ? getpwuid( s.uid ) : NULL;
 		return new StringData( pw ? pw->pw_name : "" );
 	}
 	else if( name == g_groupPropertyName )
@@ -218,9 +542,8 @@ IECore::ConstRunTimeTypedPtr FileSystemPath::property( const IECore::InternedStr
 				std::map<std::string,size_t> ownerCounter;
 				for( std::vector<std::string>::iterator it = files.begin(); it != files.end(); ++it )
 				{
-					struct stat s;
-					stat( it->c_str(), &s );
-					struct group *gr = getgrgid( s.st_gid );
+					FileStatus s;
+					struct group *gr = fileStatus( *it, s ) ? getgrgid( s.gid ) : NULL;
 					std::string value = gr ? gr->gr_name : "";
 					std::pair<std::map<std::string,size_t>::iterator,bool> oIt = ownerCounter.insert( std::pair<std::string,size_t>( value, 0 ) );
 					oIt.first->second++;
@@ -234,15 +557,13 @@ IECore::ConstRunTimeTypedPtr FileSystemPath::property( const IECore::InternedStr
 			}
 		}
 
-		std::string n = this->string();
-		struct stat s;
-		stat( n.c_str(), &s );
-		struct group *gr = getgrgid( s.st_gid );
+		FileStatus s;
+		struct group *gr = fileStatus( this->string(), s ) ? getgrgid( s.gid ) : NULL;
 		return new StringData( gr ? gr->gr_name : "" );
 	}
 	else if( name == g_modificationTimePropertyName )
 	{
-		boost::system::error_code e;
+		FileStatus s;
 
 		if( m_includeSequences )
 		{
@@ -255,7 +576,7 @@ IECore::ConstRunTimeTypedPtr FileSystemPath::property( const IECore::InternedStr
 				std::time_t newest = 0;
 				for( std::vector<std::string>::iterator it = files.begin(); it != files.end(); ++it )
 				{
-					std::time_t t = last_write_time( path( *it ), e );
+					const std::time_t t = fileStatus( *it, s ) ? s.modificationTime : -1;
 					if( t > newest )
 					{
 						newest = t;
@@ -266,12 +587,12 @@ IECore::ConstRunTimeTypedPtr FileSystemPath::property( const IECore::InternedStr
 			}
 		}
 
-		std::time_t t = last_write_time( path( this->string() ), e );
+		const std::time_t t = fileStatus( this->string(), s ) ? s.modificationTime : -1;
 		return new DateTimeData( from_time_t( t ) );
 	}
 	else if( name == g_sizePropertyName )
 	{
-		boost::system::error_code e;
+		FileStatus s;
 
 		if( m_includeSequences )
 		{
@@ -284,10 +605,9 @@ IECore::ConstRunTimeTypedPtr FileSystemPath::property( const IECore::InternedStr
 				uintmax_t total = 0;
 				for( std::vector<std::string>::iterator it = files.begin(); it != files.end(); ++it )
 				{
-					uintmax_t s = file_size( path( *it ), e );
-					if( !e )
+					if( fileStatus( *it, s ) && s.isRegularFile )
 					{
-						total += s;
+						total += s.size;
 					}
 				}
 
@@ -295,8 +615,8 @@ IECore::ConstRunTimeTypedPtr FileSystemPath::property( const IECore::InternedStr
 			}
 		}
 
-		uintmax_t s = file_size( path( this->string() ), e );
-		return new UInt64Data( !e ? s : 0 );
+		const bool valid = fileStatus( this->string(), s ) && s.isRegularFile;
+		return new UInt64Data( valid ? s.size : 0 );
 	}
 	else if( name == g_frameRangePropertyName )
 	{
@@ -321,28 +641,26 @@ void FileSystemPath::doChildren( std::vector<PathPtr> &children ) const
 {
 	path p( this->string() );
 
-	if( !is_directory( p ) )
+	ConstDirectoryListingPtr listing = directoryListing( p.string() );
+	if( !listing )
 	{
 		return;
 	}
 
-	for( directory_iterator it( p ), eIt; it != eIt; ++it )
+	const DirectoryListing::Entries &entries = listing->entries();
+	for( DirectoryListing::Entries::const_iterator it = entries.begin(), eIt = entries.end(); it != eIt; ++it )
 	{
-		children.push_back( new FileSystemPath( it->path().string(), const_cast<PathFilter *>( getFilter() ), m_includeSequences ) );
+		children.push_back( new FileSystemPath( ( p / it->name ).string(), const_cast<PathFilter *>( getFilter() ), m_includeSequences ) );
 	}
 
 	if( m_includeSequences )
 	{
-		std::vector<FileSequencePtr> sequences;
-		IECore::ls( p.string(), sequences, /* minSequenceSize */ 1 );
-		for( std::vector<FileSequencePtr>::iterator it = sequences.begin(); it != sequences.end(); ++it )
+		// Directories are excluded from the listing's
+		// sequences already.
+		const std::vector<FileSequencePtr> &sequences = listing->sequences();
+		for( std::vector<FileSequencePtr>::const_iterator it = sequences.begin(); it != sequences.end(); ++it )
 		{
-			std::vector<FrameList::Frame> frames;
-			(*it)->getFrameList()->asList( frames );
-			if ( !is_directory( path( (*it)->fileNameForFrame( frames[0] ) ) ) )
-			{
-				children.push_back( new FileSystemPath( path( p / (*it)->getFileName() ).string(), const_cast<PathFilter *>( getFilter() ), m_includeSequences ) );
-			}
+			children.push_back( new FileSystemPath( path( p / (*it)->getFileName() ).string(), const_cast<PathFilter *>( getFilter() ), m_includeSequences ) );
 		}
 	}
 }
@@ -36,11 +36,14 @@
 //////////////////////////////////////////////////////////////////////////
 
 #include <set>
+#include <cctype>
+#include <cstdlib>
 
 #include "boost/format.hpp"
 #include "boost/bind.hpp"
 #include "boost/regex.hpp"
 #include "boost/lexical_cast.hpp"
+#include "boost/unordered_map.hpp"
 
 #include "IECore/Exception.h"
 
@@ -55,8 +58,135 @@ using namespace std;
 
 IE_CORE_DEFINERUNTIMETYPED( GraphComponent );
 
+//////////////////////////////////////////////////////////////////////////
+// NameIndex
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+// The number of children at which we start maintaining a NameIndex.
+const size_t g_nameIndexThreshold = 16;
+
+// Splits a name into a stem and a numeric suffix, returning
+// 0 for the suffix if there is none. Matches the treatment
+// of sibling names in the unique name allocation in setName().
+std::string stem( const std::string &name, long &suffix )
+{
+	size_t stemSize = name.size();
+	while( stemSize && isdigit( name[stemSize-1] ) )
+	{
+		stemSize--;
+	}
+	suffix = strtol( name.c_str() + stemSize, NULL, 10 );
+	return name.substr( 0, stemSize );
+}
+
+struct InternedStringHash
+{
+	size_t operator()( const IECore::InternedString &s ) const
+	{
+		// InternedStrings with equal values share storage,
+		// so we can hash the address rather than the string.
+		return boost::hash<const char *>()( s.c_str() );
+	}
+};
+
+} // namespace
+
+struct GraphComponent::NameIndex
+{
+
+	typedef boost::unordered_map<IECore::InternedString, GraphComponent *, InternedStringHash> Children;
+	typedef std::multiset<long> Suffixes;
+	typedef boost::unordered_map<std::string, Suffixes> Stems;
+
+	Children children;
+	Stems stems;
+
+	bool contains( const GraphComponent *child ) const
+	{
+		Children::const_iterator it = children.find( child->m_name );
+		return it != children.end() && it->second == child;
+	}
+
+	void insert( GraphComponent *child )
+	{
+		Children::const_iterator it = children.find( child->m_name );
+		if( it != children.end() )
+		{
+			if( it->second == child )
+			{
+				return;
+			}
+			// Names should be unique, but we can't rule out
+			// a transient clash while actions are replayed, in
+			// which case the most recent child wins.
+			erase( it->second );
+		}
+
+		children[child->m_name] = child;
+		long suffix;
+		const std::string s = stem( child->m_name.string(), suffix );
+		stems[s].insert( suffix );
+	}
+
+	void erase( const GraphComponent *child )
+	{
+		if( !contains( child ) )
+		{
+			return;
+		}
+
+		children.erase( child->m_name );
+		long suffix;
+		const std::string s = stem( child->m_name.string(), suffix );
+		Stems::iterator it = stems.find( s );
+		it->second.erase( it->second.find( suffix ) );
+		if( it->second.empty() )
+		{
+			stems.erase( it );
+		}
+	}
+
+	// Returns the maximum suffix used by any child named with `prefix`
+	// followed by digits, ignoring `exclude`. Returns -1 if there is
+	// no such child.
+	long maxSuffix( const std::string &prefix, const GraphComponent *exclude ) const
+	{
+		Stems::const_iterator it = stems.find( prefix );
+		if( it == stems.end() )
+		{
+			return -1;
+		}
+
+		long excludeSuffix = -1;
+		if( contains( exclude ) && stem( exclude->m_name.string(), excludeSuffix ) != prefix )
+		{
+			excludeSuffix = -1;
+		}
+
+		for( Suffixes::const_reverse_iterator sIt = it->second.rbegin(), eIt = it->second.rend(); sIt != eIt; ++sIt )
+		{
+			if( *sIt == excludeSuffix )
+			{
+				// Skip exactly one occurrence.
+				excludeSuffix = -1;
+				continue;
+			}
+			return *sIt;
+		}
+		return -1;
+	}
+
+};
+
+//////////////////////////////////////////////////////////////////////////
+// GraphComponent
+//////////////////////////////////////////////////////////////////////////
+
 GraphComponent::GraphComponent( const std::string &name )
-	: m_name( name ), m_parent( 0 )
+	: m_name( name ), m_parent( 0 ), m_nameIndex( NULL )
 {
 }
 
@@ -73,6 +203,8 @@ GraphComponent::~GraphComponent()
 		(*it)->parentChanging( 0 );
 		(*it)->parentChangedSignal()( (*it).get(), 0 );
 	}
+
+	delete m_nameIndex;
 }
 
 const IECore::InternedString &GraphComponent::setName( const IECore::InternedString &name )
@@ -90,12 +222,20 @@ const IECore::InternedString &GraphComponent::setName( const IECore::InternedStr
 	if( m_parent )
 	{
 		bool uniqueAlready = true;
-		for( ChildContainer::const_iterator it=m_parent->m_children.begin(), eIt=m_parent->m_children.end(); it != eIt; it++ )
+		if( m_parent->m_nameIndex )
 		{
-			if( *it != this && (*it)->m_name == newName )
+			NameIndex::Children::const_iterator it = m_parent->m_nameIndex->children.find( newName );
+			uniqueAlready = it == m_parent->m_nameIndex->children.end() || it->second == this;
+		}
+		else
+		{
+			for( ChildContainer::const_iterator it=m_parent->m_children.begin(), eIt=m_parent->m_children.end(); it != eIt; it++ )
 			{
-				uniqueAlready = false;
-				break;
+				if( *it != this && (*it)->m_name == newName )
+				{
+					uniqueAlready = false;
+					break;
+				}
 			}
 		}
 
@@ -106,21 +246,28 @@ const IECore::InternedString &GraphComponent::setName( const IECore::InternedStr
 			std::string prefix;
 			int suffix = StringAlgo::numericSuffix( newName.value(), 1, &prefix );
 
-			// iterate over all the siblings to find the minimum value for the suffix which
-			// will be greater than any existing suffix.
-			for( ChildContainer::const_iterator it=m_parent->m_children.begin(), eIt=m_parent->m_children.end(); it != eIt; it++ )
+			// find the minimum value for the suffix which will be greater than any
+			// existing suffix amongst the siblings.
+			if( m_parent->m_nameIndex )
 			{
-				if( *it == this )
-				{
-					continue;
-				}
-				if( (*it)->m_name.value().compare( 0, prefix.size(), prefix ) == 0 )
+				suffix = max( suffix, (int)m_parent->m_nameIndex->maxSuffix( prefix, this ) + 1 );
+			}
+			else
+			{
+				for( ChildContainer::const_iterator it=m_parent->m_children.begin(), eIt=m_parent->m_children.end(); it != eIt; it++ )
 				{
-					char *endPtr = 0;
-					long siblingSuffix = strtol( (*it)->m_name.value().c_str() + prefix.size(), &endPtr, 10 );
-					if( *endPtr == '\0' )
+					if( *it == this )
+					{
+						continue;
+					}
+					if( (*it)->m_name.value().compare( 0, prefix.size(), prefix ) == 0 )
 					{
-						suffix = max( suffix, (int)siblingSuffix + 1 );
+						char *endPtr = 0;
+						long siblingSuffix = strtol( (*it)->m_name.value().c_str() + prefix.size(), &endPtr, 10 );
+						if( *endPtr == '\0' )
+						{
+							suffix = max( suffix, (int)siblingSuffix + 1 );
+						}
 					}
 				}
 			}
@@ -148,7 +295,17 @@ const IECore::InternedString &GraphComponent::setName( const IECore::InternedStr
 
 void GraphComponent::setNameInternal( const IECore::InternedString &name )
 {
+	NameIndex *index = m_parent ? m_parent->m_nameIndex : NULL;
+	const bool indexed = index && index->contains( this );
+	if( indexed )
+	{
+		index->erase( this );
+	}
 	m_name = name;
+	if( indexed )
+	{
+		index->insert( this );
+	}
 	nameChangedSignal()( this );
 }
 
@@ -305,6 +462,18 @@ void GraphComponent::addChildInternal( GraphComponentPtr child )
 	m_children.push_back( child );
 	child->m_parent = this;
 	child->setName( child->m_name.value() ); // to force uniqueness
+	if( m_nameIndex )
+	{
+		m_nameIndex->insert( child.get() );
+	}
+	else if( m_children.size() >= g_nameIndexThreshold )
+	{
+		m_nameIndex = new NameIndex;
+		for( ChildContainer::const_iterator it = m_children.begin(), eIt = m_children.end(); it != eIt; ++it )
+		{
+			m_nameIndex->insert( it->get() );
+		}
+	}
 	childAddedSignal()( this, child.get() );
 	child->parentChangedSignal()( child.get(), previousParent );
 }
@@ -365,6 +534,10 @@ void GraphComponent::removeChildInternal( GraphComponentPtr child, bool emitPare
 		// recorded and replayed automatically.
 		throw Exception( boost::str( boost::format( "GraphComponent::removeChildInternal : \"%s\" is not a child of \"%s\"." ) % child->fullName() % fullName() ) );
 	}
+	if( m_nameIndex )
+	{
+		m_nameIndex->erase( child.get() );
+	}
 	m_children.erase( it );
 	child->m_parent = 0;
 	childRemovedSignal()( this, child.get() );
@@ -379,6 +552,24 @@ const GraphComponent::ChildContainer &GraphComponent::children() const
 	return m_children;
 }
 
+const GraphComponent *GraphComponent::childInternal( const IECore::InternedString &name ) const
+{
+	if( m_nameIndex )
+	{
+		NameIndex::Children::const_iterator it = m_nameIndex->children.find( name );
+		return it != m_nameIndex->children.end() ? it->second : NULL;
+	}
+
+	for( ChildContainer::const_iterator it=m_children.begin(), eIt=m_children.end(); it!=eIt; it++ )
+	{
+		if( (*it)->m_name==name )
+		{
+			return it->get();
+		}
+	}
+	return NULL;
+}
+
 GraphComponent *GraphComponent::ancestor( IECore::TypeId type )
 {
 	GraphComponent *a = m_parent;
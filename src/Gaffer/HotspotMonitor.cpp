@@ -0,0 +1,262 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2017, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//      * Redistributions of source code must retain the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer.
+//
+//      * Redistributions in binary form must reproduce the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer in the documentation and/or other materials provided with
+//        the distribution.
+//
+//      * Neither the name of John Haddon nor the names of
+//        any other contributors to this software may be used to endorse or
+//        promote products derived from this software without specific prior
+//        written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+
+#include "Gaffer/HotspotMonitor.h"
+#include "Gaffer/Process.h"
+#include "Gaffer/Plug.h"
+#include "Gaffer/Context.h"
+
+using namespace std;
+using namespace IECore;
+using namespace Gaffer;
+
+/// \todo If we expose ValuePlug::HashProcess and ValuePlug::ComputeProcess
+/// then we can use the types defined there directly.
+static InternedString g_hashType( "computeNode:hash" );
+static InternedString g_computeType( "computeNode:compute" );
+
+namespace
+{
+
+struct MoreExpensive
+{
+
+	bool operator() ( const HotspotMonitor::Hotspot &a, const HotspotMonitor::Hotspot &b ) const
+	{
+		return a.duration > b.duration;
+	}
+
+};
+
+} // namespace
+
+//////////////////////////////////////////////////////////////////////////
+// HotspotMonitor::Hotspot
+//////////////////////////////////////////////////////////////////////////
+
+HotspotMonitor::Hotspot::Hotspot()
+	:	count( 0 ), duration( 0 )
+{
+}
+
+//////////////////////////////////////////////////////////////////////////
+// HotspotMonitor
+//////////////////////////////////////////////////////////////////////////
+
+HotspotMonitor::HotspotMonitor( const std::vector<IECore::InternedString> &variableNames, size_t maxHotspots )
+	:	m_variableNames( variableNames ), m_maxHotspots( std::max( maxHotspots, (size_t)1 ) )
+{
+}
+
+HotspotMonitor::~HotspotMonitor()
+{
+}
+
+const std::vector<IECore::InternedString> &HotspotMonitor::variableNames() const
+{
+	return m_variableNames;
+}
+
+size_t HotspotMonitor::maxHotspots() const
+{
+	return m_maxHotspots;
+}
+
+const HotspotMonitor::Hotspots &HotspotMonitor::hotspots() const
+{
+	collate();
+	return m_hotspots;
+}
+
+void HotspotMonitor::processStarted( const Process *process )
+{
+	const InternedString type = process->type();
+	if( type != g_hashType && type != g_computeType )
+	{
+		return;
+	}
+
+	ThreadData &threadData = m_threadData.local();
+
+	boost::chrono::high_resolution_clock::time_point now = boost::chrono::high_resolution_clock::now();
+	if( !threadData.frames.empty() )
+	{
+		threadData.frames.top().duration += now - threadData.then;
+	}
+	threadData.then = now;
+
+	Frame frame;
+	frame.key.first = process->plug();
+	frame.monitored = false;
+	frame.duration = boost::chrono::nanoseconds( 0 );
+
+	const Context *context = Context::current();
+	for( size_t i = 0, e = m_variableNames.size(); i < e; ++i )
+	{
+		if( const Data *d = context->get<Data>( m_variableNames[i], NULL ) )
+		{
+			frame.key.second.append( (int)i );
+			d->hash( frame.key.second );
+			frame.monitored = true;
+		}
+	}
+
+	threadData.frames.push( frame );
+}
+
+void HotspotMonitor::processFinished( const Process *process )
+{
+	const InternedString type = process->type();
+	if( type != g_hashType && type != g_computeType )
+	{
+		return;
+	}
+
+	ThreadData &threadData = m_threadData.local();
+	boost::chrono::high_resolution_clock::time_point now = boost::chrono::high_resolution_clock::now();
+	Frame &frame = threadData.frames.top();
+	frame.duration += now - threadData.then;
+	threadData.then = now;
+
+	if( frame.monitored )
+	{
+		Hotspot &hotspot = threadData.hotspots[frame.key];
+		if( !hotspot.plug )
+		{
+			// First time we've seen this hotspot, so record the
+			// variable values. The process is still running in the
+			// context it was started in, so we can get them from the
+			// current context. We must copy them, because contexts
+			// may borrow their values from elsewhere.
+			hotspot.plug = process->plug();
+			CompoundDataPtr variables = new CompoundData;
+			const Context *context = Context::current();
+			for( vector<InternedString>::const_iterator it = m_variableNames.begin(), eIt = m_variableNames.end(); it != eIt; ++it )
+			{
+				if( const Data *d = context->get<Data>( *it, NULL ) )
+				{
+					variables->writable()[*it] = d->copy();
+				}
+			}
+			hotspot.variables = variables;
+		}
+		hotspot.count++;
+		hotspot.duration += frame.duration;
+
+		if( threadData.hotspots.size() >= 2 * m_maxHotspots )
+		{
+			prune( threadData.hotspots );
+		}
+	}
+
+	threadData.frames.pop();
+}
+
+void HotspotMonitor::prune( HotspotMap &hotspots ) const
+{
+	if( hotspots.size() <= m_maxHotspots )
+	{
+		return;
+	}
+
+	Hotspots values;
+	values.reserve( hotspots.size() );
+	for( HotspotMap::const_iterator it = hotspots.begin(), eIt = hotspots.end(); it != eIt; ++it )
+	{
+		values.push_back( it->second );
+	}
+
+	nth_element( values.begin(), values.begin() + m_maxHotspots - 1, values.end(), MoreExpensive() );
+	const boost::chrono::nanoseconds threshold = values[m_maxHotspots-1].duration;
+
+	// Erase everything cheaper than the threshold, and then any
+	// ties until we're down to size.
+	for( HotspotMap::iterator it = hotspots.begin(); it != hotspots.end(); )
+	{
+		if( it->second.duration < threshold )
+		{
+			it = hotspots.erase( it );
+		}
+		else
+		{
+			++it;
+		}
+	}
+
+	for( HotspotMap::iterator it = hotspots.begin(); it != hotspots.end() && hotspots.size() > m_maxHotspots; )
+	{
+		if( it->second.duration == threshold )
+		{
+			it = hotspots.erase( it );
+		}
+		else
+		{
+			++it;
+		}
+	}
+}
+
+void HotspotMonitor::collate() const
+{
+	tbb::enumerable_thread_specific<ThreadData, tbb::cache_aligned_allocator<ThreadData>, tbb::ets_key_per_instance>::iterator it, eIt;
+	for( it = m_threadData.begin(), eIt = m_threadData.end(); it != eIt; ++it )
+	{
+		HotspotMap &m = it->hotspots;
+		for( HotspotMap::const_iterator mIt = m.begin(), meIt = m.end(); mIt != meIt; ++mIt )
+		{
+			Hotspot &hotspot = m_hotspotMap[mIt->first];
+			if( !hotspot.plug )
+			{
+				hotspot.plug = mIt->second.plug;
+				hotspot.variables = mIt->second.variables;
+			}
+			hotspot.count += mIt->second.count;
+			hotspot.duration += mIt->second.duration;
+		}
+		m.clear();
+	}
+
+	prune( m_hotspotMap );
+
+	m_hotspots.clear();
+	for( HotspotMap::const_iterator mIt = m_hotspotMap.begin(), meIt = m_hotspotMap.end(); mIt != meIt; ++mIt )
+	{
+		m_hotspots.push_back( mIt->second );
+	}
+	sort( m_hotspots.begin(), m_hotspots.end(), MoreExpensive() );
+}
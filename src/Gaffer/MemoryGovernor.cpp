@@ -0,0 +1,293 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2017, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//      * Redistributions of source code must retain the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer.
+//
+//      * Redistributions in binary form must reproduce the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer in the documentation and/or other materials provided with
+//        the distribution.
+//
+//      * Neither the name of John Haddon nor the names of
+//        any other contributors to this software may be used to endorse or
+//        promote products derived from this software without specific prior
+//        written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#ifdef __APPLE__
+#include <mach/mach.h>
+#else
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <fstream>
+
+#include "tbb/mutex.h"
+
+#include "IECore/Exception.h"
+
+#include "Gaffer/MemoryGovernor.h"
+#include "Gaffer/ValuePlug.h"
+
+using namespace Gaffer;
+
+//////////////////////////////////////////////////////////////////////////
+// Internal implementation
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+struct Cache
+{
+	std::string name;
+	MemoryGovernor::UsageFunction usage;
+	MemoryGovernor::SetLimitFunction setLimit;
+	float priority;
+	size_t limit;
+};
+
+typedef std::vector<Cache> Caches;
+
+struct Registry
+{
+	Registry()
+		:	memoryLimit( 0 )
+	{
+	}
+
+	Caches::iterator find( const std::string &name )
+	{
+		for( Caches::iterator it = caches.begin(), eIt = caches.end(); it != eIt; ++it )
+		{
+			if( it->name == name )
+			{
+				return it;
+			}
+		}
+		return caches.end();
+	}
+
+	Cache &get( const std::string &name )
+	{
+		Caches::iterator it = find( name );
+		if( it == caches.end() )
+		{
+			throw IECore::Exception( "Cache \"" + name + "\" is not registered" );
+		}
+		return *it;
+	}
+
+	Caches caches;
+	size_t memoryLimit;
+	tbb::mutex mutex;
+};
+
+Registry &registry()
+{
+	static Registry r;
+	return r;
+}
+
+// The ValuePlug cache is part of this library, so we
+// register it here rather than leaving it to the client.
+struct ComputeCacheRegistration
+{
+	ComputeCacheRegistration()
+	{
+		MemoryGovernor::registerCache( "computeCache", (size_t (*)())&ValuePlug::cacheMemoryUsage, &ValuePlug::setCacheMemoryLimit, 2.0f );
+	}
+};
+
+ComputeCacheRegistration g_computeCacheRegistration;
+
+} // namespace
+
+//////////////////////////////////////////////////////////////////////////
+// MemoryGovernor
+//////////////////////////////////////////////////////////////////////////
+
+void MemoryGovernor::registerCache( const std::string &name, UsageFunction usage, SetLimitFunction setLimit, float priority )
+{
+	Cache cache;
+	cache.name = name;
+	cache.usage = usage;
+	cache.setLimit = setLimit;
+	cache.priority = std::max( priority, 0.0f );
+	cache.limit = 0;
+
+	Registry &r = registry();
+	tbb::mutex::scoped_lock lock( r.mutex );
+	Caches::iterator it = r.find( name );
+	if( it != r.caches.end() )
+	{
+		*it = cache;
+	}
+	else
+	{
+		r.caches.push_back( cache );
+	}
+}
+
+void MemoryGovernor::deregisterCache( const std::string &name )
+{
+	Registry &r = registry();
+	tbb::mutex::scoped_lock lock( r.mutex );
+	Caches::iterator it = r.find( name );
+	if( it != r.caches.end() )
+	{
+		r.caches.erase( it );
+	}
+}
+
+std::vector<std::string> MemoryGovernor::registeredCaches()
+{
+	Registry &r = registry();
+	tbb::mutex::scoped_lock lock( r.mutex );
+	std::vector<std::string> result;
+	for( Caches::const_iterator it = r.caches.begin(), eIt = r.caches.end(); it != eIt; ++it )
+	{
+		result.push_back( it->name );
+	}
+	return result;
+}
+
+void MemoryGovernor::setPriority( const std::string &name, float priority )
+{
+	Registry &r = registry();
+	tbb::mutex::scoped_lock lock( r.mutex );
+	r.get( name ).priority = std::max( priority, 0.0f );
+}
+
+float MemoryGovernor::getPriority( const std::string &name )
+{
+	Registry &r = registry();
+	tbb::mutex::scoped_lock lock( r.mutex );
+	return r.get( name ).priority;
+}
+
+void MemoryGovernor::setMemoryLimit( size_t bytes )
+{
+	Registry &r = registry();
+	tbb::mutex::scoped_lock lock( r.mutex );
+	r.memoryLimit = bytes;
+}
+
+size_t MemoryGovernor::getMemoryLimit()
+{
+	Registry &r = registry();
+	tbb::mutex::scoped_lock lock( r.mutex );
+	return r.memoryLimit;
+}
+
+void MemoryGovernor::update()
+{
+	// We take a copy of the registry so that we don't hold the lock
+	// while calling the cache functions, which may call into Python
+	// or take locks of their own.
+
+	Registry &r = registry();
+	Caches caches;
+	size_t memoryLimit;
+	{
+		tbb::mutex::scoped_lock lock( r.mutex );
+		caches = r.caches;
+		memoryLimit = r.memoryLimit;
+	}
+
+	if( !memoryLimit || caches.empty() )
+	{
+		return;
+	}
+
+	// Everything the caches aren't using is considered to be required
+	// by the rest of the process, so the caches must share what remains.
+
+	size_t cachesUsage = 0;
+	float totalPriority = 0.0f;
+	for( Caches::const_iterator it = caches.begin(), eIt = caches.end(); it != eIt; ++it )
+	{
+		cachesUsage += it->usage();
+		totalPriority += it->priority;
+	}
+
+	const size_t processUsage = processMemoryUsage();
+	const size_t otherUsage = processUsage > cachesUsage ? processUsage - cachesUsage : 0;
+	const size_t available = memoryLimit > otherUsage ? memoryLimit - otherUsage : 0;
+
+	for( Caches::iterator it = caches.begin(), eIt = caches.end(); it != eIt; ++it )
+	{
+		it->limit = totalPriority > 0.0f ? (size_t)( (double)available * it->priority / totalPriority ) : 0;
+		it->setLimit( it->limit );
+	}
+
+	tbb::mutex::scoped_lock lock( r.mutex );
+	for( Caches::const_iterator it = caches.begin(), eIt = caches.end(); it != eIt; ++it )
+	{
+		Caches::iterator rIt = r.find( it->name );
+		if( rIt != r.caches.end() )
+		{
+			rIt->limit = it->limit;
+		}
+	}
+}
+
+size_t MemoryGovernor::cacheMemoryUsage( const std::string &name )
+{
+	UsageFunction usage;
+	{
+		Registry &r = registry();
+		tbb::mutex::scoped_lock lock( r.mutex );
+		usage = r.get( name ).usage;
+	}
+	return usage();
+}
+
+size_t MemoryGovernor::cacheMemoryLimit( const std::string &name )
+{
+	Registry &r = registry();
+	tbb::mutex::scoped_lock lock( r.mutex );
+	return r.get( name ).limit;
+}
+
+size_t MemoryGovernor::processMemoryUsage()
+{
+#ifdef __APPLE__
+	mach_task_basic_info info;
+	mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+	if( task_info( mach_task_self(), MACH_TASK_BASIC_INFO, (task_info_t)&info, &count ) != KERN_SUCCESS )
+	{
+		return 0;
+	}
+	return info.resident_size;
+#else
+	std::ifstream f( "/proc/self/statm" );
+	size_t size = 0, resident = 0;
+	if( !( f >> size >> resident ) )
+	{
+		return 0;
+	}
+	return resident * sysconf( _SC_PAGESIZE );
+#endif
+}
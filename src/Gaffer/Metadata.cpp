@@ -43,6 +43,7 @@
 #include "boost/multi_index/ordered_index.hpp"
 #include "boost/multi_index/member.hpp"
 #include "boost/optional.hpp"
+#include "boost/functional/hash.hpp"
 
 #include "IECore/CompoundData.h"
 #include "IECore/SimpleTypedData.h"
@@ -123,6 +124,101 @@ NodeMetadataMap &nodeMetadataMap()
 	return m;
 }
 
+// Resolving a node or plug value requires walking the type hierarchy,
+// and for plugs, matching the plug path against every registered
+// pattern. Since the registrations rarely change but the queries are
+// incessant, we cache the function resolved for each query here, and
+// simply clear the caches whenever the registrations change. The
+// functions themselves must still be called for each query, because
+// they may return different values for different nodes and plugs.
+// Note that the pointers stored are to functions held within the
+// NodeMetadataMap, which remain valid until the next registration
+// change.
+
+struct NodeValueCacheKey
+{
+	NodeValueCacheKey( IECore::TypeId typeId, InternedString key, bool inherit )
+		:	typeId( typeId ), key( key ), inherit( inherit )
+	{
+	}
+
+	IECore::TypeId typeId;
+	InternedString key;
+	bool inherit;
+
+	bool operator == ( const NodeValueCacheKey &rhs ) const
+	{
+		return typeId == rhs.typeId && key == rhs.key && inherit == rhs.inherit;
+	}
+};
+
+struct PlugValueCacheKey
+{
+	PlugValueCacheKey( IECore::TypeId typeId, const std::string &plugPath, InternedString key, bool inherit )
+		:	typeId( typeId ), plugPath( plugPath ), key( key ), inherit( inherit )
+	{
+	}
+
+	IECore::TypeId typeId;
+	std::string plugPath;
+	InternedString key;
+	bool inherit;
+
+	bool operator == ( const PlugValueCacheKey &rhs ) const
+	{
+		return typeId == rhs.typeId && key == rhs.key && inherit == rhs.inherit && plugPath == rhs.plugPath;
+	}
+};
+
+struct ValueCacheHashCompare
+{
+	size_t hash( const NodeValueCacheKey &k ) const
+	{
+		size_t result = 0;
+		boost::hash_combine( result, k.typeId );
+		boost::hash_combine( result, k.key.c_str() );
+		boost::hash_combine( result, k.inherit );
+		return result;
+	}
+
+	size_t hash( const PlugValueCacheKey &k ) const
+	{
+		size_t result = 0;
+		boost::hash_combine( result, k.typeId );
+		boost::hash_combine( result, k.plugPath );
+		boost::hash_combine( result, k.key.c_str() );
+		boost::hash_combine( result, k.inherit );
+		return result;
+	}
+
+	template<typename T>
+	bool equal( const T &a, const T &b ) const
+	{
+		return a == b;
+	}
+};
+
+typedef concurrent_hash_map<NodeValueCacheKey, const Metadata::NodeValueFunction *, ValueCacheHashCompare> NodeValueCache;
+typedef concurrent_hash_map<PlugValueCacheKey, const Metadata::PlugValueFunction *, ValueCacheHashCompare> PlugValueCache;
+
+NodeValueCache &nodeValueCache()
+{
+	static NodeValueCache c;
+	return c;
+}
+
+PlugValueCache &plugValueCache()
+{
+	static PlugValueCache c;
+	return c;
+}
+
+void clearValueCaches()
+{
+	nodeValueCache().clear();
+	plugValueCache().clear();
+}
+
 struct NamedInstanceValue
 {
 	NamedInstanceValue( InternedString n, ConstDataPtr v, bool p )
@@ -357,6 +453,7 @@ void Metadata::registerNodeValue( IECore::TypeId nodeTypeId, IECore::InternedStr
 		m.replace( it, namedValue );
 	}
 
+	clearValueCaches();
 	nodeValueChangedSignal()( nodeTypeId, key, NULL );
 }
 
@@ -401,21 +498,39 @@ IECore::ConstDataPtr Metadata::nodeValueInternal( const Node *node, IECore::Inte
 		return NULL;
 	}
 
-	IECore::TypeId typeId = node->typeId();
-	while( typeId != InvalidTypeId )
+	const NodeValueCacheKey cacheKey( node->typeId(), key, inherit );
+
+	const Metadata::NodeValueFunction *function = NULL;
+	NodeValueCache::const_accessor readAccessor;
+	if( nodeValueCache().find( readAccessor, cacheKey ) )
 	{
-		NodeMetadataMap::const_iterator nIt = nodeMetadataMap().find( typeId );
-		if( nIt != nodeMetadataMap().end() )
+		function = readAccessor->second;
+		readAccessor.release();
+	}
+	else
+	{
+		readAccessor.release();
+		IECore::TypeId typeId = cacheKey.typeId;
+		while( typeId != InvalidTypeId && !function )
 		{
-			NodeMetadata::NodeValues::const_iterator vIt = nIt->second.nodeValues.find( key );
-			if( vIt != nIt->second.nodeValues.end() )
+			NodeMetadataMap::const_iterator nIt = nodeMetadataMap().find( typeId );
+			if( nIt != nodeMetadataMap().end() )
 			{
-				return vIt->second( node );
+				NodeMetadata::NodeValues::const_iterator vIt = nIt->second.nodeValues.find( key );
+				if( vIt != nIt->second.nodeValues.end() )
+				{
+					function = &vIt->second;
+				}
 			}
+			typeId = inherit ? RunTimeTyped::baseTypeId( typeId ) : InvalidTypeId;
 		}
-		typeId = inherit ? RunTimeTyped::baseTypeId( typeId ) : InvalidTypeId;
+
+		NodeValueCache::accessor writeAccessor;
+		nodeValueCache().insert( writeAccessor, cacheKey );
+		writeAccessor->second = function;
 	}
-	return NULL;
+
+	return function ? (*function)( node ) : NULL;
 }
 
 void Metadata::deregisterValue( IECore::TypeId nodeTypeId, IECore::InternedString key )
@@ -444,6 +559,7 @@ void Metadata::deregisterNodeValue( IECore::TypeId nodeTypeId, IECore::InternedS
 	}
 
 	m.erase( it );
+	clearValueCaches();
 	nodeValueChangedSignal()( nodeTypeId, key, NULL );
 }
 
@@ -529,6 +645,7 @@ void Metadata::registerPlugValue( IECore::TypeId nodeTypeId, const StringAlgo::M
 		plugValues.replace( it, namedValue );
 	}
 
+	clearValueCaches();
 	plugValueChangedSignal()( nodeTypeId, plugPath, key, NULL );
 }
 
@@ -589,10 +706,22 @@ IECore::ConstDataPtr Metadata::plugValueInternal( const Plug *plug, IECore::Inte
 		return NULL;
 	}
 
-	const string plugPath = plug->relativeName( node );
+	const PlugValueCacheKey cacheKey( node->typeId(), plug->relativeName( node ), key, inherit );
 
-	IECore::TypeId typeId = node->typeId();
-	while( typeId != InvalidTypeId )
+	PlugValueCache::const_accessor readAccessor;
+	if( plugValueCache().find( readAccessor, cacheKey ) )
+	{
+		const Metadata::PlugValueFunction *function = readAccessor->second;
+		readAccessor.release();
+		return function ? (*function)( plug ) : NULL;
+	}
+	readAccessor.release();
+
+	const string &plugPath = cacheKey.plugPath;
+	const Metadata::PlugValueFunction *function = NULL;
+
+	IECore::TypeId typeId = cacheKey.typeId;
+	while( typeId != InvalidTypeId && !function )
 	{
 		NodeMetadataMap::const_iterator nIt = nodeMetadataMap().find( typeId );
 		if( nIt != nodeMetadataMap().end() )
@@ -605,26 +734,34 @@ IECore::ConstDataPtr Metadata::plugValueInternal( const Plug *plug, IECore::Inte
 				NodeMetadata::PlugValues::const_iterator vIt = it->second.find( key );
 				if( vIt != it->second.end() )
 				{
-					return vIt->second( plug );
+					function = &vIt->second;
 				}
 			}
 			// And only if the direct lookups fails, do a full search using
 			// wildcard matches.
-			for( it = nIt->second.plugPathsToValues.begin(); it != eIt; ++it )
+			for( it = nIt->second.plugPathsToValues.begin(); it != eIt && !function; ++it )
 			{
 				if( StringAlgo::match( plugPath, it->first ) )
 				{
 					NodeMetadata::PlugValues::const_iterator vIt = it->second.find( key );
 					if( vIt != it->second.end() )
 					{
-						return vIt->second( plug );
+						function = &vIt->second;
 					}
 				}
 			}
 		}
 		typeId = inherit ? RunTimeTyped::baseTypeId( typeId ) : InvalidTypeId;
 	}
-	return NULL;
+
+	PlugValueCache::accessor writeAccessor;
+	plugValueCache().insert( writeAccessor, cacheKey );
+	writeAccessor->second = function;
+	// Release before calling the function, which may
+	// itself query metadata.
+	writeAccessor.release();
+
+	return function ? (*function)( plug ) : NULL;
 }
 
 void Metadata::deregisterPlugValue( IECore::TypeId nodeTypeId, const StringAlgo::MatchPattern &plugPath, IECore::InternedString key )
@@ -639,6 +776,7 @@ void Metadata::deregisterPlugValue( IECore::TypeId nodeTypeId, const StringAlgo:
 	}
 
 	plugValues.erase( it );
+	clearValueCaches();
 	plugValueChangedSignal()( nodeTypeId, plugPath, key, NULL );
 }
 
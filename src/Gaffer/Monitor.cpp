@@ -65,6 +65,10 @@ bool Monitor::getActive() const
 	return Process::monitorRegistered( this );
 }
 
+void Monitor::cacheEvent( CacheEvent event, const Plug *plug, size_t bytes )
+{
+}
+
 Monitor::Scope::Scope( Monitor *monitor )
 	:	m_monitor( monitor )
 {
@@ -39,6 +39,7 @@
 #include "Gaffer/PerformanceMonitor.h"
 #include "Gaffer/MonitorAlgo.h"
 #include "Gaffer/Plug.h"
+#include "Gaffer/Node.h"
 
 using namespace Gaffer;
 
@@ -203,6 +204,74 @@ struct HashesPerComputeMetric
 
 };
 
+struct HashCacheHitRateMetric
+{
+
+	typedef double ResultType;
+
+	ResultType operator() ( const PerformanceMonitor::Statistics &s ) const
+	{
+		return static_cast<double>( s.hashCacheHits ) / std::max( 1.0, static_cast<double>( s.hashCacheHits + s.hashCount ) );
+	}
+
+	const char *description() const
+	{
+		return "fraction of hashes retrieved from the cache";
+	}
+
+};
+
+struct ComputeCacheHitRateMetric
+{
+
+	typedef double ResultType;
+
+	ResultType operator() ( const PerformanceMonitor::Statistics &s ) const
+	{
+		return static_cast<double>( s.computeCacheHits ) / std::max( 1.0, static_cast<double>( s.computeCacheHits + s.computeCacheMisses ) );
+	}
+
+	const char *description() const
+	{
+		return "fraction of values retrieved from the cache";
+	}
+
+};
+
+struct CacheBytesStoredMetric
+{
+
+	typedef size_t ResultType;
+
+	ResultType operator() ( const PerformanceMonitor::Statistics &s ) const
+	{
+		return s.cacheBytesStored;
+	}
+
+	const char *description() const
+	{
+		return "bytes stored in the cache";
+	}
+
+};
+
+struct BytesAllocatedMetric
+{
+
+	typedef size_t ResultType;
+
+	ResultType operator() ( const PerformanceMonitor::Statistics &s ) const
+	{
+		return s.bytesAllocated;
+	}
+
+	const char *description() const
+	{
+		return "bytes allocated";
+	}
+
+};
+
 // Utility for invoking a templated functor with a particular metric.
 template<typename F>
 typename F::ResultType dispatchMetric( const F &f, MonitorAlgo::PerformanceMetric performanceMetric )
@@ -225,6 +294,14 @@ typename F::ResultType dispatchMetric( const F &f, MonitorAlgo::PerformanceMetri
 			return f( PerComputeDurationMetric() );
 		case MonitorAlgo::HashesPerCompute :
 			return f( HashesPerComputeMetric() );
+		case MonitorAlgo::HashCacheHitRate :
+			return f( HashCacheHitRateMetric() );
+		case MonitorAlgo::ComputeCacheHitRate :
+			return f( ComputeCacheHitRateMetric() );
+		case MonitorAlgo::CacheBytesStored :
+			return f( CacheBytesStoredMetric() );
+		case MonitorAlgo::BytesAllocated :
+			return f( BytesAllocatedMetric() );
 		default :
 			return f( InvalidMetric() );
 	}
@@ -239,15 +316,16 @@ typename F::ResultType dispatchMetric( const F &f, MonitorAlgo::PerformanceMetri
 namespace
 {
 
-struct PlugAndStatistics
+struct GraphComponentAndStatistics
 {
 
-	PlugAndStatistics( const PerformanceMonitor::StatisticsMap::value_type &v )
-		:	plug( v.first.get() ), statistics( v.second )
+	template<typename Value>
+	GraphComponentAndStatistics( const Value &v )
+		:	graphComponent( v.first.get() ), statistics( v.second )
 	{
 	}
 
-	const Plug *plug;
+	const GraphComponent *graphComponent;
 	PerformanceMonitor::Statistics statistics;
 
 };
@@ -256,7 +334,7 @@ template<typename Metric>
 struct MetricGreater
 {
 
-	bool operator() ( const PlugAndStatistics &lhs, const PlugAndStatistics &rhs ) const
+	bool operator() ( const GraphComponentAndStatistics &lhs, const GraphComponentAndStatistics &rhs ) const
 	{
 		return metric( lhs.statistics ) > metric( rhs.statistics );
 	}
@@ -281,11 +359,12 @@ void outputItems( const std::vector<std::string> &names, const std::vector<Item>
 	}
 }
 
+template<typename StatisticsMap>
 struct FormatStatistics
 {
 
-	FormatStatistics( const PerformanceMonitor::StatisticsMap &statistics, size_t maxLines )
-		:	statistics( statistics ), maxLines( maxLines )
+	FormatStatistics( const StatisticsMap &statistics, const char *graphComponentDescription, size_t maxLines )
+		:	statistics( statistics ), graphComponentDescription( graphComponentDescription ), maxLines( maxLines )
 	{
 	}
 
@@ -294,10 +373,10 @@ struct FormatStatistics
 	template<typename Metric>
 	std::string operator() ( const Metric &metric ) const
 	{
-		std::vector<PlugAndStatistics> v( statistics.begin(), statistics.end() );
+		std::vector<GraphComponentAndStatistics> v( statistics.begin(), statistics.end() );
 		std::sort( v.begin(), v.end(), MetricGreater<Metric>() );
 
-		std::vector<std::string> plugNames; plugNames.reserve( maxLines );
+		std::vector<std::string> names; names.reserve( maxLines );
 		std::vector<typename Metric::ResultType> metrics; metrics.reserve( maxLines );
 
 		ResultType result;
@@ -308,24 +387,25 @@ struct FormatStatistics
 			{
 				break;
 			}
-			plugNames.push_back( v[i].plug->relativeName( v[i].plug->ancestor( (IECore::TypeId)ScriptNodeTypeId ) ) );
+			names.push_back( v[i].graphComponent->relativeName( v[i].graphComponent->ancestor( (IECore::TypeId)ScriptNodeTypeId ) ) );
 			metrics.push_back( m );
 		}
 
-		if( plugNames.empty() )
+		if( names.empty() )
 		{
 			return "";
 		}
 
 		std::stringstream s;
-		s << "Top " << plugNames.size() << " plugs by " << metric.description() << " :\n\n";
+		s << "Top " << names.size() << " " << graphComponentDescription << " by " << metric.description() << " :\n\n";
 
-		outputItems( plugNames, metrics, s );
+		outputItems( names, metrics, s );
 
 		return s.str();
 	}
 
-	const PerformanceMonitor::StatisticsMap &statistics;
+	const StatisticsMap &statistics;
+	const char *graphComponentDescription;
 	const size_t maxLines;
 
 };
@@ -358,7 +438,28 @@ std::string formatStatistics( const PerformanceMonitor &monitor, size_t maxLines
 
 std::string formatStatistics( const PerformanceMonitor &monitor, PerformanceMetric metric, size_t maxLines )
 {
-	return dispatchMetric<FormatStatistics>( FormatStatistics( monitor.allStatistics(), maxLines ), metric );
+	typedef FormatStatistics<PerformanceMonitor::StatisticsMap> Formatter;
+	return dispatchMetric<Formatter>( Formatter( monitor.allStatistics(), "plugs", maxLines ), metric );
+}
+
+std::string formatNodeStatistics( const PerformanceMonitor &monitor, size_t maxLinesPerMetric )
+{
+	std::string s;
+	for( int m = First; m <= Last; ++m )
+	{
+		s += formatNodeStatistics( monitor, static_cast<PerformanceMetric>( m ), maxLinesPerMetric );
+		if( m != Last )
+		{
+			s += "\n";
+		}
+	}
+	return s;
+}
+
+std::string formatNodeStatistics( const PerformanceMonitor &monitor, PerformanceMetric metric, size_t maxLines )
+{
+	typedef FormatStatistics<PerformanceMonitor::NodeStatisticsMap> Formatter;
+	return dispatchMetric<Formatter>( Formatter( monitor.allNodeStatistics(), "nodes", maxLines ), metric );
 }
 
 } // namespace MonitorAlgo
@@ -0,0 +1,286 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2017, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//      * Redistributions of source code must retain the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer.
+//
+//      * Redistributions in binary form must reproduce the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer in the documentation and/or other materials provided with
+//        the distribution.
+//
+//      * Neither the name of John Haddon nor the names of
+//        any other contributors to this software may be used to endorse or
+//        promote products derived from this software without specific prior
+//        written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+// Local observers are needed to pin only the threads working in
+// each of our arenas, and must be enabled before including TBB.
+#define TBB_PREVIEW_LOCAL_OBSERVER 1
+
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <vector>
+
+#include "boost/lexical_cast.hpp"
+
+#include "tbb/enumerable_thread_specific.h"
+#include "tbb/task_scheduler_init.h"
+#include "tbb/task_scheduler_observer.h"
+
+#include "IECore/Exception.h"
+
+#include "Gaffer/NUMA.h"
+
+using namespace Gaffer;
+
+//////////////////////////////////////////////////////////////////////////
+// Internal implementation
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+typedef tbb::enumerable_thread_specific<int> CurrentNode;
+CurrentNode g_currentNode( -1 );
+
+#ifdef __linux__
+
+// Parses a processor list of the form "0-15,32-47", as found in
+// /sys/devices/system/node/node*/cpulist.
+std::vector<int> parseCPUList( const std::string &cpuList )
+{
+	std::vector<int> result;
+	std::stringstream ss( cpuList );
+	std::string range;
+	while( std::getline( ss, range, ',' ) )
+	{
+		if( range.empty() || range == "\n" )
+		{
+			continue;
+		}
+		const size_t dash = range.find( '-' );
+		const int first = boost::lexical_cast<int>( range.substr( 0, dash ) );
+		const int last = dash == std::string::npos ? first : boost::lexical_cast<int>( range.substr( dash + 1 ) );
+		for( int cpu = first; cpu <= last; ++cpu )
+		{
+			result.push_back( cpu );
+		}
+	}
+	return result;
+}
+
+// Pins the threads working in an arena to the processors of a node,
+// restoring their original affinity when they leave. The original
+// affinity matters for master threads, which join the arena only
+// temporarily.
+class PinningObserver : public tbb::task_scheduler_observer
+{
+
+	public :
+
+		PinningObserver( tbb::task_arena &arena, int node, const cpu_set_t &cpus )
+			:	tbb::task_scheduler_observer( arena ), m_node( node ), m_cpus( cpus )
+		{
+			observe( true );
+		}
+
+		virtual void on_scheduler_entry( bool isWorker )
+		{
+			ThreadState &s = m_threadStates.local();
+			s.previousNode = g_currentNode.local();
+			s.restoreAffinity = sched_getaffinity( 0, sizeof( cpu_set_t ), &s.previousAffinity ) == 0;
+			sched_setaffinity( 0, sizeof( cpu_set_t ), &m_cpus );
+			g_currentNode.local() = m_node;
+		}
+
+		virtual void on_scheduler_exit( bool isWorker )
+		{
+			ThreadState &s = m_threadStates.local();
+			if( s.restoreAffinity )
+			{
+				sched_setaffinity( 0, sizeof( cpu_set_t ), &s.previousAffinity );
+			}
+			g_currentNode.local() = s.previousNode;
+		}
+
+	private :
+
+		struct ThreadState
+		{
+			int previousNode;
+			bool restoreAffinity;
+			cpu_set_t previousAffinity;
+		};
+
+		const int m_node;
+		const cpu_set_t m_cpus;
+		tbb::enumerable_thread_specific<ThreadState> m_threadStates;
+
+};
+
+#endif // __linux__
+
+struct Node
+{
+	size_t concurrency;
+	tbb::task_arena *arena;
+};
+
+std::vector<Node> createNodes()
+{
+	std::vector<Node> result;
+
+#ifdef __linux__
+
+	const char *e = getenv( "GAFFER_NUMA" );
+	if( !e || std::string( e ) != "1" )
+	{
+		return result;
+	}
+
+	cpu_set_t processCPUs;
+	if( sched_getaffinity( 0, sizeof( cpu_set_t ), &processCPUs ) != 0 )
+	{
+		return result;
+	}
+
+	// Find the processors of each node that are available to
+	// this process. Nodes may be memory-only, and processors may
+	// have been taken away from us by the farm scheduler, so we
+	// ignore nodes that are left with none.
+	std::vector<cpu_set_t> nodeCPUs;
+	for( int node = 0; ; ++node )
+	{
+		std::ifstream f( ( "/sys/devices/system/node/node" + boost::lexical_cast<std::string>( node ) + "/cpulist" ).c_str() );
+		if( !f )
+		{
+			break;
+		}
+
+		std::string cpuList;
+		std::getline( f, cpuList );
+
+		cpu_set_t cpus;
+		CPU_ZERO( &cpus );
+		const std::vector<int> cpuIndices = parseCPUList( cpuList );
+		for( std::vector<int>::const_iterator it = cpuIndices.begin(), eIt = cpuIndices.end(); it != eIt; ++it )
+		{
+			if( *it < CPU_SETSIZE && CPU_ISSET( *it, &processCPUs ) )
+			{
+				CPU_SET( *it, &cpus );
+			}
+		}
+
+		if( CPU_COUNT( &cpus ) )
+		{
+			nodeCPUs.push_back( cpus );
+		}
+	}
+
+	if( nodeCPUs.size() < 2 )
+	{
+		return result;
+	}
+
+	for( size_t i = 0; i < nodeCPUs.size(); ++i )
+	{
+		Node node;
+		node.concurrency = CPU_COUNT( &nodeCPUs[i] );
+		// Arenas and observers are deliberately leaked, since
+		// destroying them during static destruction isn't safe.
+		node.arena = new tbb::task_arena( node.concurrency );
+		node.arena->initialize();
+		new PinningObserver( *node.arena, i, nodeCPUs[i] );
+		result.push_back( node );
+	}
+
+#endif // __linux__
+
+	return result;
+}
+
+const std::vector<Node> &nodes()
+{
+	static std::vector<Node> g_nodes = createNodes();
+	return g_nodes;
+}
+
+} // namespace
+
+//////////////////////////////////////////////////////////////////////////
+// NUMA
+//////////////////////////////////////////////////////////////////////////
+
+size_t NUMA::numNodes()
+{
+	return std::max<size_t>( nodes().size(), 1 );
+}
+
+size_t NUMA::nodeConcurrency( size_t node )
+{
+	const std::vector<Node> &n = nodes();
+	if( n.empty() && node == 0 )
+	{
+		return tbb::task_scheduler_init::default_num_threads();
+	}
+	if( node >= n.size() )
+	{
+		throw IECore::Exception( "Invalid node index" );
+	}
+	return n[node].concurrency;
+}
+
+int NUMA::currentNode()
+{
+	return g_currentNode.local();
+}
+
+bool NUMA::partitionWork()
+{
+	return nodes().size() > 1 && g_currentNode.local() < 0;
+}
+
+tbb::task_arena *NUMA::arena( size_t node )
+{
+	const std::vector<Node> &n = nodes();
+	return node < n.size() ? n[node].arena : NULL;
+}
+
+NUMA::ScopedCurrentNode::ScopedCurrentNode( int node )
+{
+	int &currentNode = g_currentNode.local();
+	m_previousNode = currentNode;
+	currentNode = node;
+}
+
+NUMA::ScopedCurrentNode::~ScopedCurrentNode()
+{
+	g_currentNode.local() = m_previousNode;
+}
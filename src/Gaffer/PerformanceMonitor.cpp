@@ -34,9 +34,19 @@
 //
 //////////////////////////////////////////////////////////////////////////
 
+#include <fstream>
+
+#include <dlfcn.h>
+
+#include "tbb/atomic.h"
+
+#include "IECore/Exception.h"
+
 #include "Gaffer/PerformanceMonitor.h"
 #include "Gaffer/Process.h"
 #include "Gaffer/Plug.h"
+#include "Gaffer/Node.h"
+#include "Gaffer/ScriptNode.h"
 
 using namespace Gaffer;
 
@@ -45,13 +55,49 @@ using namespace Gaffer;
 static IECore::InternedString g_hashType( "computeNode:hash" );
 static IECore::InternedString g_computeType( "computeNode:compute" );
 static PerformanceMonitor::Statistics g_emptyStatistics;
+static tbb::atomic<int> g_threadIndex;
+
+//////////////////////////////////////////////////////////////////////////
+// Allocation counting
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+// When jemalloc has been preloaded by the launcher, it maintains a running
+// count of the bytes allocated by each thread, which we can read for the cost
+// of a pointer dereference. We look it up dynamically so that we don't need to
+// link to jemalloc, and so that counting is simply disabled when a different
+// allocator is in use.
+typedef int (*MallctlFunction)( const char *name, void *oldp, size_t *oldlenp, void *newp, size_t newlen );
+const MallctlFunction g_mallctl = (MallctlFunction)dlsym( RTLD_DEFAULT, "mallctl" );
+
+const boost::uint64_t *threadAllocatedCounter()
+{
+	if( !g_mallctl )
+	{
+		return NULL;
+	}
+
+	boost::uint64_t *counter = NULL;
+	size_t size = sizeof( counter );
+	if( g_mallctl( "thread.allocatedp", &counter, &size, NULL, 0 ) != 0 )
+	{
+		return NULL;
+	}
+	return counter;
+}
+
+} // namespace
 
 //////////////////////////////////////////////////////////////////////////
 // PerformanceMonitor::Statistics
 //////////////////////////////////////////////////////////////////////////
 
-PerformanceMonitor::Statistics::Statistics( size_t hashCount, size_t computeCount, boost::chrono::nanoseconds hashDuration, boost::chrono::nanoseconds computeDuration )
-	:	hashCount( hashCount ), computeCount( computeCount ), hashDuration( hashDuration ), computeDuration( computeDuration )
+PerformanceMonitor::Statistics::Statistics( size_t hashCount, size_t computeCount, boost::chrono::nanoseconds hashDuration, boost::chrono::nanoseconds computeDuration, size_t hashCacheHits, size_t computeCacheHits, size_t computeCacheMisses, size_t cacheBytesStored, size_t bytesAllocated )
+	:	hashCount( hashCount ), computeCount( computeCount ), hashDuration( hashDuration ), computeDuration( computeDuration ),
+		hashCacheHits( hashCacheHits ), computeCacheHits( computeCacheHits ), computeCacheMisses( computeCacheMisses ), cacheBytesStored( cacheBytesStored ),
+		bytesAllocated( bytesAllocated )
 {
 }
 
@@ -61,6 +107,11 @@ PerformanceMonitor::Statistics & PerformanceMonitor::Statistics::operator += ( c
 	computeCount += rhs.computeCount;
 	hashDuration += rhs.hashDuration;
 	computeDuration += rhs.computeDuration;
+	hashCacheHits += rhs.hashCacheHits;
+	computeCacheHits += rhs.computeCacheHits;
+	computeCacheMisses += rhs.computeCacheMisses;
+	cacheBytesStored += rhs.cacheBytesStored;
+	bytesAllocated += rhs.bytesAllocated;
 	return *this;
 }
 
@@ -70,7 +121,12 @@ bool PerformanceMonitor::Statistics::operator == ( const Statistics &rhs )
 		hashCount == rhs.hashCount &&
 		computeCount == rhs.computeCount &&
 		hashDuration == rhs.hashDuration &&
-		computeDuration == rhs.computeDuration
+		computeDuration == rhs.computeDuration &&
+		hashCacheHits == rhs.hashCacheHits &&
+		computeCacheHits == rhs.computeCacheHits &&
+		computeCacheMisses == rhs.computeCacheMisses &&
+		cacheBytesStored == rhs.cacheBytesStored &&
+		bytesAllocated == rhs.bytesAllocated
 	;
 }
 
@@ -83,7 +139,13 @@ bool PerformanceMonitor::Statistics::operator != ( const Statistics &rhs )
 // PerformanceMonitor
 //////////////////////////////////////////////////////////////////////////
 
+PerformanceMonitor::ThreadData::ThreadData()
+	:	threadIndex( g_threadIndex.fetch_and_increment() ), allocatedCounter( threadAllocatedCounter() ), allocatedThen( 0 )
+{
+}
+
 PerformanceMonitor::PerformanceMonitor()
+	:	m_nodeStatisticsDirty( false ), m_timelineEnabled( false ), m_startTime( boost::chrono::high_resolution_clock::now() )
 {
 }
 
@@ -108,6 +170,85 @@ const PerformanceMonitor::Statistics &PerformanceMonitor::plugStatistics( const
 	return it->second;
 }
 
+const PerformanceMonitor::NodeStatisticsMap &PerformanceMonitor::allNodeStatistics() const
+{
+	collate();
+	if( m_nodeStatisticsDirty )
+	{
+		m_nodeStatistics.clear();
+		for( StatisticsMap::const_iterator it = m_statistics.begin(), eIt = m_statistics.end(); it != eIt; ++it )
+		{
+			for( const Node *node = it->first->node(); node; node = node->parent<Node>() )
+			{
+				m_nodeStatistics[node] += it->second;
+			}
+		}
+		m_nodeStatisticsDirty = false;
+	}
+	return m_nodeStatistics;
+}
+
+const PerformanceMonitor::Statistics &PerformanceMonitor::nodeStatistics( const Node *node ) const
+{
+	const NodeStatisticsMap &nodeStatistics = allNodeStatistics();
+	NodeStatisticsMap::const_iterator it = nodeStatistics.find( node );
+	if( it == nodeStatistics.end() )
+	{
+		return g_emptyStatistics;
+	}
+	return it->second;
+}
+
+void PerformanceMonitor::setTimelineEnabled( bool enabled )
+{
+	m_timelineEnabled = enabled;
+}
+
+bool PerformanceMonitor::getTimelineEnabled() const
+{
+	return m_timelineEnabled;
+}
+
+void PerformanceMonitor::writeTimeline( const std::string &fileName ) const
+{
+	std::ofstream f( fileName.c_str() );
+	if( !f.is_open() )
+	{
+		throw IECore::IOException( "Unable to open file \"" + fileName + "\"" );
+	}
+
+	f << "{\"traceEvents\":[\n";
+
+	bool first = true;
+	tbb::enumerable_thread_specific<ThreadData, tbb::cache_aligned_allocator<ThreadData>, tbb::ets_key_per_instance>::const_iterator it, eIt;
+	for( it = m_threadData.begin(), eIt = m_threadData.end(); it != eIt; ++it )
+	{
+		for( ThreadData::Timeline::const_iterator eventIt = it->timeline.begin(), eventEIt = it->timeline.end(); eventIt != eventEIt; ++eventIt )
+		{
+			typedef boost::chrono::duration<double, boost::micro> Microseconds;
+			const Microseconds start = eventIt->start - m_startTime;
+			const Microseconds duration = eventIt->end - eventIt->start;
+
+			// Plug names consist only of characters that are valid
+			// in JSON strings, so no escaping is necessary.
+			const Plug *plug = eventIt->plug.get();
+			const std::string name = plug->relativeName( plug->ancestor<ScriptNode>() );
+
+			f << ( first ? "" : ",\n" );
+			f << "{\"name\":\"" << name << "\",";
+			f << "\"cat\":\"" << ( eventIt->compute ? "compute" : "hash" ) << "\",";
+			f << "\"ph\":\"X\",";
+			f << "\"ts\":" << start.count() << ",";
+			f << "\"dur\":" << duration.count() << ",";
+			f << "\"pid\":0,";
+			f << "\"tid\":" << it->threadIndex << "}";
+			first = false;
+		}
+	}
+
+	f << "\n]}\n";
+}
+
 void PerformanceMonitor::processStarted( const Process *process )
 {
 	const IECore::InternedString type = process->type();
@@ -125,6 +266,16 @@ void PerformanceMonitor::processStarted( const Process *process )
 	}
 	threadData.then = now;
 
+	if( threadData.allocatedCounter )
+	{
+		const boost::uint64_t allocatedNow = *threadData.allocatedCounter;
+		if( !threadData.allocationStack.empty() )
+		{
+			*(threadData.allocationStack.top()) += allocatedNow - threadData.allocatedThen;
+		}
+		threadData.allocatedThen = allocatedNow;
+	}
+
 	Statistics &s = threadData.statistics[process->plug()];
 	if( type == g_hashType )
 	{
@@ -136,6 +287,17 @@ void PerformanceMonitor::processStarted( const Process *process )
 		s.computeCount++;
 		threadData.durationStack.push( &s.computeDuration );
 	}
+	threadData.allocationStack.push( &s.bytesAllocated );
+
+	if( m_timelineEnabled )
+	{
+		threadData.timelineStack.push( threadData.timeline.size() );
+		threadData.timeline.push_back( TimelineEvent() );
+		TimelineEvent &event = threadData.timeline.back();
+		event.plug = process->plug();
+		event.compute = type == g_computeType;
+		event.start = now;
+	}
 }
 
 void PerformanceMonitor::processFinished( const Process *process )
@@ -151,6 +313,40 @@ void PerformanceMonitor::processFinished( const Process *process )
 	*(threadData.durationStack.top()) += now - threadData.then;
 	threadData.durationStack.pop();
 	threadData.then = now;
+
+	if( threadData.allocatedCounter )
+	{
+		const boost::uint64_t allocatedNow = *threadData.allocatedCounter;
+		*(threadData.allocationStack.top()) += allocatedNow - threadData.allocatedThen;
+		threadData.allocatedThen = allocatedNow;
+	}
+	threadData.allocationStack.pop();
+
+	if( !threadData.timelineStack.empty() )
+	{
+		threadData.timeline[threadData.timelineStack.top()].end = now;
+		threadData.timelineStack.pop();
+	}
+}
+
+void PerformanceMonitor::cacheEvent( CacheEvent event, const Plug *plug, size_t bytes )
+{
+	Statistics &s = m_threadData.local().statistics[plug];
+	switch( event )
+	{
+		case HashCacheHit :
+			s.hashCacheHits++;
+			break;
+		case ComputeCacheHit :
+			s.computeCacheHits++;
+			break;
+		case ComputeCacheMiss :
+			s.computeCacheMisses++;
+			break;
+		case ComputeCacheStore :
+			s.cacheBytesStored += bytes;
+			break;
+	}
 }
 
 void PerformanceMonitor::collate() const
@@ -162,6 +358,7 @@ void PerformanceMonitor::collate() const
 		for( StatisticsMap::const_iterator mIt = m.begin(), meIt = m.end(); mIt != meIt; ++mIt )
 		{
 			m_statistics[mIt->first] += mIt->second;
+			m_nodeStatisticsDirty = true;
 		}
 		m.clear();
 	}
@@ -791,7 +791,10 @@ class Plug::DirtyPlugs
 		typedef boost::adjacency_list<vecS, vecS, directedS, PlugPtr> Graph;
 		typedef Graph::vertex_descriptor VertexDescriptor;
 
-		typedef std::map<const Plug *, VertexDescriptor> PlugMap;
+		// We look up every plug visited during traversal, including
+		// those we prune at, so use a hash map rather than a sorted
+		// one to keep large propagations linear.
+		typedef boost::unordered_map<const Plug *, VertexDescriptor> PlugMap;
 
 		// Equivalent to the return type for map::insert - the first
 		// field is the vertex descriptor, and the second field is
@@ -809,15 +812,15 @@ class Plug::DirtyPlugs
 			// would make for an ideal use.
 			assert( plug->refCount() );
 
-			PlugMap::const_iterator it = m_plugs.find( plug );
-			if( it != m_plugs.end() )
+			std::pair<PlugMap::iterator, bool> inserted = m_plugs.insert( PlugMap::value_type( plug, 0 ) );
+			if( !inserted.second )
 			{
-				return InsertedVertex( it->second, false );
+				return InsertedVertex( inserted.first->second, false );
 			}
 
 			VertexDescriptor result = add_vertex( m_graph );
 			m_graph[result] = const_cast<Plug *>( plug );
-			m_plugs[plug] = result;
+			inserted.first->second = result;
 
 			// Insert parent plug.
 			if( const Plug *parent = plug->parent<Plug>() )
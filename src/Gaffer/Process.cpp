@@ -34,7 +34,7 @@
 //
 //////////////////////////////////////////////////////////////////////////
 
-#include <stack>
+#include "tbb/atomic.h"
 
 #include "boost/container/flat_set.hpp"
 
@@ -42,6 +42,7 @@
 #include "Gaffer/Plug.h"
 #include "Gaffer/Node.h"
 #include "Gaffer/Monitor.h"
+#include "Gaffer/Canceller.h"
 
 using namespace Gaffer;
 
@@ -50,14 +51,25 @@ namespace
 
 typedef boost::container::flat_set<Monitor *> Monitors;
 Monitors g_activeMonitors;
+// Mirrors g_activeMonitors.size(), allowing processes to skip
+// all monitor bookkeeping cheaply in the common case that no
+// monitors are active.
+tbb::atomic<size_t> g_numActiveMonitors;
 
 } // namespace
 
 struct Process::ThreadData
 {
 
-	typedef std::stack<const Process *> Stack;
-	Stack stack;
+	ThreadData()
+		:	current( NULL ), errorSource( NULL )
+	{
+	}
+
+	// The innermost process on this thread. Outer
+	// processes are reachable via Process::parent(),
+	// so this is all we need to maintain the stack.
+	const Process *current;
 
 	const Plug *errorSource;
 
@@ -68,25 +80,30 @@ tbb::enumerable_thread_specific<Process::ThreadData, tbb::cache_aligned_allocato
 Process::Process( const IECore::InternedString &type, const Plug *plug, const Plug *downstream )
 	:	m_type( type ), m_plug( plug ), m_downstream( downstream ? downstream : plug ), m_threadData( &g_threadData.local() )
 {
-	ThreadData::Stack &stack = m_threadData->stack;
-	m_parent = stack.size() ? stack.top() : NULL;
-	m_threadData->stack.push( this );
+	m_parent = m_threadData->current;
+	m_threadData->current = this;
 
-	for( Monitors::const_iterator it = g_activeMonitors.begin(), eIt = g_activeMonitors.end(); it != eIt; ++it )
+	if( g_numActiveMonitors )
 	{
-		(*it)->processStarted( this );
+		for( Monitors::const_iterator it = g_activeMonitors.begin(), eIt = g_activeMonitors.end(); it != eIt; ++it )
+		{
+			(*it)->processStarted( this );
+		}
 	}
 }
 
 Process::~Process()
 {
-	for( Monitors::const_iterator it = g_activeMonitors.begin(), eIt = g_activeMonitors.end(); it != eIt; ++it )
+	if( g_numActiveMonitors )
 	{
-		(*it)->processFinished( this );
+		for( Monitors::const_iterator it = g_activeMonitors.begin(), eIt = g_activeMonitors.end(); it != eIt; ++it )
+		{
+			(*it)->processFinished( this );
+		}
 	}
 
-	m_threadData->stack.pop();
-	if( m_threadData->stack.empty() )
+	m_threadData->current = m_parent;
+	if( !m_parent )
 	{
 		m_threadData->errorSource = NULL;
 	}
@@ -94,8 +111,7 @@ Process::~Process()
 
 const Process *Process::current()
 {
-	const ThreadData::Stack &stack = g_threadData.local().stack;
-	return stack.size() ? stack.top() : NULL;
+	return g_threadData.local().current;
 }
 
 void Process::handleException()
@@ -106,6 +122,12 @@ void Process::handleException()
 		// so we can examine it.
 		throw;
 	}
+	catch( const Cancelled &e )
+	{
+		// Cancellation isn't an error, so we
+		// just propagate it without reporting.
+		throw;
+	}
 	catch( const std::exception &e )
 	{
 		if( !m_threadData->errorSource )
@@ -126,6 +148,19 @@ void Process::handleException()
 	}
 }
 
+void Process::cacheEvent( Monitor::CacheEvent event, const Plug *plug, size_t bytes )
+{
+	if( !g_numActiveMonitors )
+	{
+		return;
+	}
+
+	for( Monitors::const_iterator it = g_activeMonitors.begin(), eIt = g_activeMonitors.end(); it != eIt; ++it )
+	{
+		(*it)->cacheEvent( event, plug, bytes );
+	}
+}
+
 void Process::emitError( const std::string &error ) const
 {
 	const Plug *plug = m_downstream;
@@ -145,11 +180,13 @@ void Process::emitError( const std::string &error ) const
 void Process::registerMonitor( Monitor *monitor )
 {
 	g_activeMonitors.insert( monitor );
+	g_numActiveMonitors = g_activeMonitors.size();
 }
 
 void Process::deregisterMonitor( Monitor *monitor )
 {
 	g_activeMonitors.erase( monitor );
+	g_numActiveMonitors = g_activeMonitors.size();
 }
 
 bool Process::monitorRegistered( const Monitor *monitor )
@@ -0,0 +1,522 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2017, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//      * Redistributions of source code must retain the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer.
+//
+//      * Redistributions in binary form must reproduce the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer in the documentation and/or other materials provided with
+//        the distribution.
+//
+//      * Neither the name of John Haddon nor the names of
+//        any other contributors to this software may be used to endorse or
+//        promote products derived from this software without specific prior
+//        written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#include "boost/algorithm/string/predicate.hpp"
+#include "boost/array.hpp"
+#include "boost/asio.hpp"
+#include "boost/bind.hpp"
+#include "boost/format.hpp"
+#include "boost/lexical_cast.hpp"
+#include "boost/thread.hpp"
+
+#include "tbb/atomic.h"
+#include "tbb/enumerable_thread_specific.h"
+#include "tbb/mutex.h"
+
+#include "IECore/CompoundData.h"
+#include "IECore/CompoundObject.h"
+#include "IECore/MemoryIndexedIO.h"
+#include "IECore/MessageHandler.h"
+#include "IECore/SimpleTypedData.h"
+#include "IECore/VectorTypedData.h"
+
+#include "Gaffer/RemoteCompute.h"
+#include "Gaffer/Context.h"
+#include "Gaffer/Metadata.h"
+#include "Gaffer/ScriptNode.h"
+#include "Gaffer/ValuePlug.h"
+
+using namespace Gaffer;
+
+//////////////////////////////////////////////////////////////////////////
+// Internal utilities
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+typedef boost::asio::ip::tcp Tcp;
+typedef boost::shared_ptr<Tcp::socket> SocketPtr;
+
+// Messages are CompoundObjects serialised with Cortex, and sent
+// preceded by their size as an 8 byte little-endian integer.
+
+IECore::ConstCharVectorDataPtr serialise( const IECore::CompoundObject *message )
+{
+	IECore::MemoryIndexedIOPtr io = new IECore::MemoryIndexedIO( IECore::ConstCharVectorDataPtr(), IECore::IndexedIO::rootPath, IECore::IndexedIO::Exclusive | IECore::IndexedIO::Write );
+	message->save( io, "message" );
+	return io->buffer();
+}
+
+void writeMessage( Tcp::socket &socket, const IECore::CharVectorData *message )
+{
+	const std::vector<char> &data = message->readable();
+	const boost::uint64_t size = data.size();
+
+	unsigned char header[8];
+	for( int i = 0; i < 8; ++i )
+	{
+		header[i] = ( size >> ( i * 8 ) ) & 0xff;
+	}
+
+	boost::array<boost::asio::const_buffer, 2> buffers = {{
+		boost::asio::buffer( header ),
+		boost::asio::buffer( data )
+	}};
+	boost::asio::write( socket, buffers );
+}
+
+IECore::ConstCompoundObjectPtr readMessage( Tcp::socket &socket )
+{
+	unsigned char header[8];
+	boost::asio::read( socket, boost::asio::buffer( header ) );
+
+	boost::uint64_t size = 0;
+	for( int i = 0; i < 8; ++i )
+	{
+		size |= boost::uint64_t( header[i] ) << ( i * 8 );
+	}
+
+	IECore::CharVectorDataPtr data = new IECore::CharVectorData;
+	data->writable().resize( size );
+	boost::asio::read( socket, boost::asio::buffer( data->writable() ) );
+
+	IECore::ConstIndexedIOPtr io = new IECore::MemoryIndexedIO( data, IECore::IndexedIO::rootPath, IECore::IndexedIO::Read );
+	IECore::ConstCompoundObjectPtr result = IECore::runTimeCast<const IECore::CompoundObject>( IECore::Object::load( io, "message" ) );
+	if( !result )
+	{
+		throw IECore::Exception( "Invalid message" );
+	}
+	return result;
+}
+
+IECore::InternedString g_computeRemotelyName( "computeRemotely" );
+
+} // namespace
+
+//////////////////////////////////////////////////////////////////////////
+// ComputeServer::Implementation
+//////////////////////////////////////////////////////////////////////////
+
+class ComputeServer::Implementation : boost::noncopyable
+{
+
+	public :
+
+		Implementation( ScriptNodePtr script, int port )
+			:	m_script( script ),
+				// See ShaderView.cpp for why we pass a concurrency hint.
+				m_service( /* concurrency_hint = */ 1 ),
+				m_acceptor( m_service, Tcp::endpoint( Tcp::v4(), port ) ),
+				m_stopped( false )
+		{
+			startAccept();
+			m_serviceThread = boost::thread( boost::bind( &Implementation::runService, this ) );
+		}
+
+		~Implementation()
+		{
+			stop();
+		}
+
+		ScriptNode *script()
+		{
+			return m_script.get();
+		}
+
+		int port() const
+		{
+			return m_acceptor.local_endpoint().port();
+		}
+
+		void stop()
+		{
+			{
+				tbb::mutex::scoped_lock lock( m_mutex );
+				if( m_stopped )
+				{
+					return;
+				}
+				m_stopped = true;
+				// Shutting down the sockets wakes the connection
+				// threads from their blocking reads. Threads that
+				// are busy computing will exit when they finish.
+				boost::system::error_code ec;
+				for( std::vector<SocketPtr>::const_iterator it = m_sockets.begin(), eIt = m_sockets.end(); it != eIt; ++it )
+				{
+					(*it)->shutdown( Tcp::socket::shutdown_both, ec );
+				}
+			}
+
+			m_service.stop();
+			m_serviceThread.join();
+			m_connectionThreads.join_all();
+		}
+
+	private :
+
+		void runService()
+		{
+			m_service.run();
+		}
+
+		void startAccept()
+		{
+			SocketPtr socket( new Tcp::socket( m_service ) );
+			m_acceptor.async_accept( *socket, boost::bind( &Implementation::accepted, this, socket, boost::asio::placeholders::error ) );
+		}
+
+		void accepted( SocketPtr socket, const boost::system::error_code &error )
+		{
+			if( error )
+			{
+				return;
+			}
+
+			{
+				tbb::mutex::scoped_lock lock( m_mutex );
+				if( m_stopped )
+				{
+					return;
+				}
+				boost::system::error_code ec;
+				socket->set_option( Tcp::no_delay( true ), ec );
+				m_sockets.push_back( socket );
+				m_connectionThreads.create_thread( boost::bind( &Implementation::serve, this, socket ) );
+			}
+
+			startAccept();
+		}
+
+		void serve( SocketPtr socket )
+		{
+			try
+			{
+				while( true )
+				{
+					IECore::ConstCompoundObjectPtr request = readMessage( *socket );
+					writeMessage( *socket, respond( request.get() ).get() );
+				}
+			}
+			catch( const std::exception &e )
+			{
+				// The client has disconnected, or we are stopping.
+			}
+		}
+
+		IECore::ConstCharVectorDataPtr respond( const IECore::CompoundObject *request )
+		{
+			IECore::CompoundObjectPtr response = new IECore::CompoundObject;
+			try
+			{
+				const std::string &plugName = request->member<IECore::StringData>( "plug", /* throwExceptions = */ true )->readable();
+				const ValuePlug *plug = m_script->descendant<ValuePlug>( plugName );
+				if( !plug )
+				{
+					throw IECore::Exception( boost::str( boost::format( "Plug \"%s\" does not exist" ) % plugName ) );
+				}
+
+				ContextPtr context = new Context;
+				const IECore::CompoundData *variables = request->member<IECore::CompoundData>( "context", /* throwExceptions = */ true );
+				for( IECore::CompoundDataMap::const_iterator it = variables->readable().begin(), eIt = variables->readable().end(); it != eIt; ++it )
+				{
+					context->set<const IECore::Data *>( it->first, it->second.get() );
+				}
+				Context::Scope scope( context.get() );
+
+				if( plug->hash().toString() != request->member<IECore::StringData>( "hash", /* throwExceptions = */ true )->readable() )
+				{
+					// Our script differs from the client's, so we can't
+					// provide the value it is expecting.
+					response->members()["hashMismatch"] = new IECore::BoolData( true );
+					return serialise( response.get() );
+				}
+
+				response->members()["value"] = boost::const_pointer_cast<IECore::Object>( ComputeServer::objectValue( plug ) );
+			}
+			catch( const std::exception &e )
+			{
+				response->members().clear();
+				response->members()["error"] = new IECore::StringData( e.what() );
+			}
+
+			try
+			{
+				return serialise( response.get() );
+			}
+			catch( const std::exception &e )
+			{
+				// The value can't be serialised, so the client
+				// will have to compute it itself.
+				response->members().clear();
+				response->members()["unsupported"] = new IECore::BoolData( true );
+				return serialise( response.get() );
+			}
+		}
+
+		ScriptNodePtr m_script;
+
+		boost::asio::io_service m_service;
+		Tcp::acceptor m_acceptor;
+		boost::thread m_serviceThread;
+
+		tbb::mutex m_mutex;
+		bool m_stopped;
+		std::vector<SocketPtr> m_sockets;
+		boost::thread_group m_connectionThreads;
+
+};
+
+//////////////////////////////////////////////////////////////////////////
+// ComputeServer
+//////////////////////////////////////////////////////////////////////////
+
+ComputeServer::ComputeServer( ScriptNodePtr script, int port )
+	:	m_implementation( new Implementation( script, port ) )
+{
+}
+
+ComputeServer::~ComputeServer()
+{
+	stop();
+}
+
+ScriptNode *ComputeServer::script()
+{
+	return m_implementation->script();
+}
+
+const ScriptNode *ComputeServer::script() const
+{
+	return m_implementation->script();
+}
+
+int ComputeServer::port() const
+{
+	return m_implementation->port();
+}
+
+void ComputeServer::stop()
+{
+	m_implementation->stop();
+}
+
+IECore::ConstObjectPtr ComputeServer::objectValue( const ValuePlug *plug )
+{
+	return plug->getObjectValue();
+}
+
+//////////////////////////////////////////////////////////////////////////
+// ComputeClient::Implementation
+//////////////////////////////////////////////////////////////////////////
+
+class ComputeClient::Implementation : boost::noncopyable
+{
+
+	public :
+
+		Implementation( const std::string &host, int port )
+			:	host( host ), port( port )
+		{
+			m_failed = false;
+			m_warnedMismatch = false;
+		}
+
+		const std::string host;
+		const int port;
+
+		// Sends a request on the calling thread's connection, returning
+		// NULL if communication with the server fails.
+		IECore::ConstCompoundObjectPtr request( const IECore::CompoundObject *message )
+		{
+			if( m_failed )
+			{
+				return NULL;
+			}
+
+			ConnectionPtr &connection = m_connections.local();
+			try
+			{
+				if( !connection )
+				{
+					connection.reset( new Connection );
+					Tcp::resolver resolver( connection->service );
+					boost::asio::connect(
+						connection->socket,
+						resolver.resolve( Tcp::resolver::query( host, boost::lexical_cast<std::string>( port ) ) )
+					);
+					connection->socket.set_option( Tcp::no_delay( true ) );
+				}
+
+				writeMessage( connection->socket, serialise( message ).get() );
+				return readMessage( connection->socket );
+			}
+			catch( const std::exception &e )
+			{
+				connection.reset();
+				// Rather than have every subsequent compute wait
+				// on a server which isn't responding, we give up
+				// on it entirely.
+				if( !m_failed.fetch_and_store( true ) )
+				{
+					IECore::msg(
+						IECore::Msg::Warning, "ComputeClient",
+						boost::format( "Unable to communicate with server \"%s:%d\" (%s). Computing locally instead." ) % host % port % e.what()
+					);
+				}
+				return NULL;
+			}
+		}
+
+		void warnMismatch()
+		{
+			if( !m_warnedMismatch.fetch_and_store( true ) )
+			{
+				IECore::msg(
+					IECore::Msg::Warning, "ComputeClient",
+					boost::format( "Script on server \"%s:%d\" differs from the local script. Computing locally instead." ) % host % port
+				);
+			}
+		}
+
+	private :
+
+		struct Connection
+		{
+			Connection()
+				:	service( /* concurrency_hint = */ 1 ), socket( service )
+			{
+			}
+
+			boost::asio::io_service service;
+			Tcp::socket socket;
+		};
+
+		typedef boost::shared_ptr<Connection> ConnectionPtr;
+		typedef tbb::enumerable_thread_specific<ConnectionPtr> Connections;
+		Connections m_connections;
+
+		tbb::atomic<bool> m_failed;
+		tbb::atomic<bool> m_warnedMismatch;
+
+};
+
+//////////////////////////////////////////////////////////////////////////
+// ComputeClient
+//////////////////////////////////////////////////////////////////////////
+
+ComputeClient::ComputeClient( const std::string &host, int port )
+	:	m_implementation( new Implementation( host, port ) )
+{
+}
+
+ComputeClient::~ComputeClient()
+{
+}
+
+const std::string &ComputeClient::host() const
+{
+	return m_implementation->host;
+}
+
+int ComputeClient::port() const
+{
+	return m_implementation->port;
+}
+
+bool ComputeClient::computeRemotely( const ValuePlug *plug )
+{
+	for( const GraphComponent *g = plug->node(); g; g = g->parent<GraphComponent>() )
+	{
+		if( IECore::ConstBoolDataPtr d = Metadata::value<IECore::BoolData>( g, g_computeRemotelyName ) )
+		{
+			return d->readable();
+		}
+		if( g->isInstanceOf( ScriptNode::staticTypeId() ) )
+		{
+			break;
+		}
+	}
+	return false;
+}
+
+IECore::ConstObjectPtr ComputeClient::compute( const ValuePlug *plug, const IECore::MurmurHash &expectedHash ) const
+{
+	const ScriptNode *script = plug->ancestor<ScriptNode>();
+	if( !script )
+	{
+		return NULL;
+	}
+
+	IECore::CompoundObjectPtr request = new IECore::CompoundObject;
+	request->members()["plug"] = new IECore::StringData( plug->relativeName( script ) );
+	request->members()["hash"] = new IECore::StringData( expectedHash.toString() );
+
+	// The "ui:" variables never affect computation, so
+	// there's no need to send them.
+	IECore::CompoundDataPtr variables = new IECore::CompoundData;
+	const Context *context = Context::current();
+	std::vector<IECore::InternedString> names;
+	context->names( names );
+	for( std::vector<IECore::InternedString>::const_iterator it = names.begin(), eIt = names.end(); it != eIt; ++it )
+	{
+		if( boost::starts_with( it->string(), "ui:" ) )
+		{
+			continue;
+		}
+		variables->writable()[*it] = const_cast<IECore::Data *>( context->get<IECore::Data>( *it ) );
+	}
+	request->members()["context"] = variables;
+
+	IECore::ConstCompoundObjectPtr response = m_implementation->request( request.get() );
+	if( !response )
+	{
+		return NULL;
+	}
+
+	if( const IECore::StringData *error = response->member<IECore::StringData>( "error" ) )
+	{
+		throw IECore::Exception( error->readable() );
+	}
+
+	if( response->member<IECore::BoolData>( "hashMismatch" ) )
+	{
+		m_implementation->warnMismatch();
+		return NULL;
+	}
+
+	return response->member<IECore::Object>( "value" );
+}
@@ -41,6 +41,7 @@
 #include "boost/bind/placeholders.hpp"
 #include "boost/filesystem/path.hpp"
 #include "boost/filesystem/convenience.hpp"
+#include "boost/filesystem/operations.hpp"
 
 #include "IECore/Exception.h"
 #include "IECore/SimpleTypedData.h"
@@ -82,7 +83,7 @@ class ScriptNode::CompoundAction : public Gaffer::Action
 		IE_CORE_DECLARERUNTIMETYPEDEXTENSION( Gaffer::ScriptNode::CompoundAction, CompoundActionTypeId, Gaffer::Action );
 
 		CompoundAction( ScriptNode *subject, const std::string &mergeGroup )
-			:	m_subject( subject ), m_mergeGroup( mergeGroup )
+			:	m_subject( subject ), m_mergeGroup( mergeGroup ), m_memoryUsage( 0 )
 		{
 		}
 
@@ -180,6 +181,16 @@ class ScriptNode::CompoundAction : public Gaffer::Action
 			}
 		}
 
+		virtual size_t memoryUsage() const
+		{
+			size_t result = Action::memoryUsage();
+			for( std::vector<ActionPtr>::const_iterator it = m_actions.begin(), eIt = m_actions.end(); it != eIt; ++it )
+			{
+				result += (*it)->memoryUsage();
+			}
+			return result;
+		}
+
 	private :
 
 		// this can't be a smart pointer because then we'd get
@@ -187,6 +198,9 @@ class ScriptNode::CompoundAction : public Gaffer::Action
 		ScriptNode *m_subject;
 		std::string m_mergeGroup;
 		std::vector<ActionPtr> m_actions;
+		// Computing the memory usage can be expensive, so the
+		// ScriptNode caches it here when storing the action.
+		size_t m_memoryUsage;
 
 };
 
@@ -242,6 +256,7 @@ ScriptNode::ScriptNode( const std::string &name )
 	m_selectionOrphanRemover( m_selection ),
 	m_undoIterator( m_undoList.end() ),
 	m_currentActionStage( Action::Invalid ),
+	m_undoMemoryLimit( 0 ),
 	m_executing( false ),
 	m_context( new Context )
 {
@@ -422,6 +437,13 @@ void ScriptNode::popUndoState()
 
 			m_undoIterator = m_undoList.end();
 
+			if( m_undoMemoryLimit )
+			{
+				CompoundAction *lastAction = m_undoList.rbegin()->get();
+				lastAction->m_memoryUsage = lastAction->memoryUsage();
+				limitUndoMemory();
+			}
+
 			if( !merged )
 			{
 				undoAddedSignal()( this );
@@ -506,6 +528,55 @@ void ScriptNode::redo()
 	unsavedChangesPlug()->setValue( true );
 }
 
+void ScriptNode::setUndoMemoryLimit( size_t bytes )
+{
+	if( bytes && !m_undoMemoryLimit )
+	{
+		// We haven't been keeping track of memory usage,
+		// so must catch up now.
+		for( UndoList::iterator it = m_undoList.begin(), eIt = m_undoList.end(); it != eIt; ++it )
+		{
+			(*it)->m_memoryUsage = (*it)->memoryUsage();
+		}
+	}
+	m_undoMemoryLimit = bytes;
+	limitUndoMemory();
+}
+
+size_t ScriptNode::getUndoMemoryLimit() const
+{
+	return m_undoMemoryLimit;
+}
+
+void ScriptNode::limitUndoMemory()
+{
+	if( !m_undoMemoryLimit )
+	{
+		return;
+	}
+
+	size_t memoryUsage = 0;
+	for( UndoList::const_iterator it = m_undoList.begin(), eIt = m_undoList.end(); it != eIt; ++it )
+	{
+		memoryUsage += (*it)->m_memoryUsage;
+	}
+
+	// Discard the oldest undo entries until we're within the limit. We
+	// never discard entries available for redo, and always keep the most
+	// recent undo, so that the last edit can be undone whatever its size.
+	while( memoryUsage > m_undoMemoryLimit && m_undoList.begin() != m_undoIterator )
+	{
+		UndoIterator next = m_undoList.begin();
+		++next;
+		if( next == m_undoIterator )
+		{
+			break;
+		}
+		memoryUsage -= m_undoList.front()->m_memoryUsage;
+		m_undoList.pop_front();
+	}
+}
+
 Action::Stage ScriptNode::currentActionStage() const
 {
 	return m_currentActionStage;
@@ -638,18 +709,49 @@ std::string ScriptNode::serialise( const Node *parent, const Set *filter ) const
 
 void ScriptNode::serialiseToFile( const std::string &fileName, const Node *parent, const Set *filter ) const
 {
-	std::string s = serialiseInternal( parent, filter );
+	const std::string s = serialiseInternal( parent, filter );
 
-	std::ofstream f( fileName.c_str() );
-	if( !f.good() )
+	// We write to a temporary file alongside the destination, and only
+	// rename it into place once the write is complete. This means that
+	// a failed or interrupted save can never leave a truncated script
+	// behind in place of the previous one.
+
+	boost::filesystem::path path( fileName );
+	boost::system::error_code ec;
+	if( boost::filesystem::exists( path, ec ) )
 	{
-		throw IECore::IOException( "Unable to open file \"" + fileName + "\"" );
+		// Resolve symlinks so that we replace the file they point
+		// to, rather than the links themselves.
+		path = boost::filesystem::canonical( path, ec );
+		if( ec )
+		{
+			path = fileName;
+		}
 	}
 
-	f << s;
+	const boost::filesystem::path tmpPath = boost::filesystem::unique_path( path.string() + ".%%%%-%%%%-%%%%.tmp" );
 
-	if( !f.good() )
 	{
+		std::ofstream f( tmpPath.c_str() );
+		if( !f.good() )
+		{
+			throw IECore::IOException( "Unable to open file \"" + fileName + "\"" );
+		}
+
+		f << s;
+		f.close();
+
+		if( !f.good() )
+		{
+			boost::filesystem::remove( tmpPath, ec );
+			throw IECore::IOException( "Failed to write to \"" + fileName + "\"" );
+		}
+	}
+
+	boost::filesystem::rename( tmpPath, path, ec );
+	if( ec )
+	{
+		boost::filesystem::remove( tmpPath, ec );
 		throw IECore::IOException( "Failed to write to \"" + fileName + "\"" );
 	}
 }
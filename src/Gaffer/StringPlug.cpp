@@ -53,6 +53,7 @@ StringPlug::StringPlug(
 )
 	:	ValuePlug( name, direction, new StringData( defaultValue ), flags ), m_substitutions( substitutions )
 {
+	updateSubstitutionTemplate();
 }
 
 StringPlug::~StringPlug()
@@ -105,11 +106,10 @@ std::string StringPlug::getValue( const IECore::MurmurHash *precomputedHash ) co
 		m_substitutions &&
 		direction() == In &&
 		getFlags( PerformsSubstitutions ) &&
-		Process::current() &&
-		Context::hasSubstitutions( s->readable() )
+		Process::current()
 	;
 
-	return performSubstitutions ? Context::current()->substitute( s->readable(), m_substitutions ) : s->readable();
+	return performSubstitutions ? substitute( s ) : s->readable();
 }
 
 void StringPlug::setFrom( const ValuePlug *other )
@@ -142,10 +142,11 @@ IECore::MurmurHash StringPlug::hash() const
 			throw IECore::Exception( "StringPlug::getObjectValue() didn't return StringData - is the hash being computed correctly?" );
 		}
 
-		if( Context::hasSubstitutions( s->readable() ) )
+		const bool hasSubstitutions = s == m_substitutionTemplateValue.get() ? m_substitutionTemplate->hasSubstitutions() : Context::hasSubstitutions( s->readable() );
+		if( hasSubstitutions )
 		{
 			IECore::MurmurHash result;
-			result.append( Context::current()->substitute( s->readable(), m_substitutions ) );
+			result.append( substitute( s ) );
 			return result;
 		}
 	}
@@ -153,3 +154,67 @@ IECore::MurmurHash StringPlug::hash() const
 	// no substitutions
 	return ValuePlug::hash();
 }
+
+bool StringPlug::hasSubstitutions() const
+{
+	if( !m_substitutions || direction() != In || !getFlags( PerformsSubstitutions ) )
+	{
+		return false;
+	}
+
+	IECore::ConstObjectPtr o = getObjectValue();
+	const IECore::StringData *s = IECore::runTimeCast<const IECore::StringData>( o.get() );
+	if( !s )
+	{
+		return false;
+	}
+
+	if( s == m_substitutionTemplateValue.get() )
+	{
+		return m_substitutionTemplate->hasSubstitutions();
+	}
+
+	return Context::substitutions( s->readable() ) & m_substitutions;
+}
+
+void StringPlug::dirty()
+{
+	ValuePlug::dirty();
+	updateSubstitutionTemplate();
+}
+
+void StringPlug::updateSubstitutionTemplate()
+{
+	m_substitutionTemplateValue = NULL;
+	m_substitutionTemplate.reset();
+
+	if( !m_substitutions || direction() != In || getInput<Plug>() )
+	{
+		// We'll never substitute our static value.
+		return;
+	}
+
+	m_substitutionTemplateValue = IECore::runTimeCast<const IECore::StringData>( getObjectValue() );
+	if( m_substitutionTemplateValue )
+	{
+		m_substitutionTemplate.reset( new Context::SubstitutionTemplate( m_substitutionTemplateValue->readable(), m_substitutions ) );
+	}
+}
+
+std::string StringPlug::substitute( const IECore::StringData *value ) const
+{
+	if( value == m_substitutionTemplateValue.get() )
+	{
+		if( !m_substitutionTemplate->hasSubstitutions() )
+		{
+			return value->readable();
+		}
+		return Context::current()->substitute( *m_substitutionTemplate );
+	}
+
+	if( !Context::hasSubstitutions( value->readable() ) )
+	{
+		return value->readable();
+	}
+	return Context::current()->substitute( value->readable(), m_substitutions );
+}
@@ -35,11 +35,26 @@
 //
 //////////////////////////////////////////////////////////////////////////
 
+#include <algorithm>
+#include <ctime>
+
 #include "tbb/enumerable_thread_specific.h"
+#include "tbb/concurrent_hash_map.h"
+#include "tbb/mutex.h"
+#include "tbb/parallel_for.h"
+#include "tbb/blocked_range.h"
+#include "tbb/task_arena.h"
+#include "tbb/tick_count.h"
+#include "tbb/spin_mutex.h"
 
 #include "boost/bind.hpp"
 #include "boost/format.hpp"
+#include "boost/functional/hash.hpp"
 #include "boost/unordered_map.hpp"
+#include "boost/filesystem.hpp"
+
+#include "IECore/FileIndexedIO.h"
+#include "IECore/CompoundObject.h"
 
 #include "Gaffer/Private/IECorePreview/LRUCache.h"
 
@@ -48,6 +63,7 @@
 #include "Gaffer/Context.h"
 #include "Gaffer/Action.h"
 #include "Gaffer/Process.h"
+#include "Gaffer/RemoteCompute.h"
 
 using namespace Gaffer;
 
@@ -77,6 +93,233 @@ inline const ValuePlug *sourcePlug( const ValuePlug *p )
 	return p;
 }
 
+// Key used to store hashes in the HashProcess cache.
+struct HashCacheKey
+{
+
+	HashCacheKey()
+		:	plug( NULL ), dirtyCount( 0 )
+	{
+	}
+
+	HashCacheKey( const ValuePlug *plug, const IECore::MurmurHash &contextHash, uint64_t dirtyCount )
+		:	plug( plug ), contextHash( contextHash ), dirtyCount( dirtyCount )
+	{
+	}
+
+	bool operator == ( const HashCacheKey &other ) const
+	{
+		return other.plug == plug && other.dirtyCount == dirtyCount && other.contextHash == contextHash;
+	}
+
+	const ValuePlug *plug;
+	IECore::MurmurHash contextHash;
+	uint64_t dirtyCount;
+
+};
+
+size_t hash_value( const HashCacheKey &key )
+{
+	size_t result = boost::hash<IECore::MurmurHash>()( key.contextHash );
+	boost::hash_combine( result, key.plug );
+	boost::hash_combine( result, key.dirtyCount );
+	return result;
+}
+
+// A second level cache for computed values, storing them as files on
+// disk so that they can be reused by other processes. Files are written
+// atomically by renaming temporary files, so it is safe for many processes
+// to share a directory, including via a network filesystem. File modification
+// times are updated on each read, and used to evict the least recently used
+// files when the size limit is exceeded.
+class DiskCache : boost::noncopyable
+{
+
+	public :
+
+		DiskCache()
+			:	m_sizeLimit( size_t( 10 ) * 1024 * 1024 * 1024 ) // 10 gigs
+		{
+			m_bytesWritten = 0;
+			if( const char *d = getenv( "GAFFER_DISK_CACHE_DIRECTORY" ) )
+			{
+				m_directory = d;
+			}
+		}
+
+		void setDirectory( const std::string &directory )
+		{
+			m_directory = directory;
+		}
+
+		const std::string &getDirectory() const
+		{
+			return m_directory;
+		}
+
+		void setSizeLimit( size_t bytes )
+		{
+			m_sizeLimit = bytes;
+			m_bytesWritten = 0;
+			limitSize();
+		}
+
+		size_t getSizeLimit() const
+		{
+			return m_sizeLimit;
+		}
+
+		bool enabled() const
+		{
+			return !m_directory.empty();
+		}
+
+		// Returns NULL if the value isn't cached.
+		IECore::ConstObjectPtr get( const IECore::MurmurHash &hash ) const
+		{
+			const boost::filesystem::path path = fileName( hash );
+			boost::system::error_code ec;
+			if( !boost::filesystem::exists( path, ec ) )
+			{
+				return NULL;
+			}
+
+			try
+			{
+				IECore::ConstIndexedIOPtr io = new IECore::FileIndexedIO( path.string(), IECore::IndexedIO::rootPath, IECore::IndexedIO::Read );
+				IECore::ConstObjectPtr result = IECore::Object::load( io, "value" );
+				boost::filesystem::last_write_time( path, time( NULL ), ec );
+				return result;
+			}
+			catch( const std::exception &e )
+			{
+				// The file may have been evicted by another process
+				// while we were reading it. Either way, we simply treat
+				// it as a miss.
+				return NULL;
+			}
+		}
+
+		void set( const IECore::MurmurHash &hash, const IECore::Object *value )
+		{
+			const boost::filesystem::path path = fileName( hash );
+			boost::filesystem::path tempPath;
+			boost::system::error_code ec;
+			try
+			{
+				boost::filesystem::create_directories( path.parent_path() );
+				tempPath = path.parent_path() / boost::filesystem::unique_path( "%%%%-%%%%-%%%%-%%%%.tmp" );
+				{
+					IECore::IndexedIOPtr io = new IECore::FileIndexedIO( tempPath.string(), IECore::IndexedIO::rootPath, IECore::IndexedIO::Write );
+					value->save( io, "value" );
+				}
+				boost::filesystem::rename( tempPath, path );
+				m_bytesWritten += boost::filesystem::file_size( path );
+			}
+			catch( const std::exception &e )
+			{
+				// The disk cache is only an optimisation, so failure to
+				// write (perhaps because the object type isn't serialisable,
+				// or the disk is full) isn't an error.
+				if( !tempPath.empty() )
+				{
+					boost::filesystem::remove( tempPath, ec );
+				}
+				return;
+			}
+
+			limitSize();
+		}
+
+	private :
+
+		boost::filesystem::path fileName( const IECore::MurmurHash &hash ) const
+		{
+			// We use the first two characters of the hash as a
+			// subdirectory, to avoid huge numbers of files in a
+			// single directory.
+			const std::string h = hash.toString();
+			return boost::filesystem::path( m_directory ) / h.substr( 0, 2 ) / ( h.substr( 2 ) + ".fio" );
+		}
+
+		struct File
+		{
+			File( std::time_t time, size_t size, const boost::filesystem::path &path )
+				:	time( time ), size( size ), path( path )
+			{
+			}
+
+			bool operator < ( const File &other ) const
+			{
+				return time < other.time;
+			}
+
+			std::time_t time;
+			size_t size;
+			boost::filesystem::path path;
+		};
+
+		void limitSize()
+		{
+			// Scanning the directory is expensive, so we only do it
+			// when we've written a significant amount since last time.
+			// Other processes do the same, so the limit is not strict.
+			if( m_bytesWritten < m_sizeLimit / 10 )
+			{
+				return;
+			}
+
+			tbb::spin_mutex::scoped_lock lock;
+			if( !lock.try_acquire( m_limitSizeMutex ) )
+			{
+				// Another thread is doing the work for us.
+				return;
+			}
+
+			m_bytesWritten = 0;
+
+			std::vector<File> files;
+			size_t totalSize = 0;
+			boost::system::error_code ec;
+			for( boost::filesystem::recursive_directory_iterator it( m_directory, ec ), eIt; it != eIt; it.increment( ec ) )
+			{
+				if( ec || it->path().extension() != ".fio" )
+				{
+					continue;
+				}
+				const size_t size = boost::filesystem::file_size( it->path(), ec );
+				if( ec )
+				{
+					continue;
+				}
+				files.push_back( File( boost::filesystem::last_write_time( it->path(), ec ), size, it->path() ) );
+				totalSize += size;
+			}
+
+			if( totalSize <= m_sizeLimit )
+			{
+				return;
+			}
+
+			std::sort( files.begin(), files.end() );
+			for( std::vector<File>::const_iterator it = files.begin(), eIt = files.end(); it != eIt && totalSize > m_sizeLimit; ++it )
+			{
+				boost::filesystem::remove( it->path, ec );
+				totalSize -= it->size;
+			}
+		}
+
+		std::string m_directory;
+		size_t m_sizeLimit;
+		tbb::atomic<size_t> m_bytesWritten;
+		tbb::spin_mutex m_limitSizeMutex;
+
+};
+
+DiskCache g_diskCache;
+
+ComputeClientPtr g_computeClient;
+
 } // namespace
 
 //////////////////////////////////////////////////////////////////////////
@@ -110,69 +353,93 @@ class ValuePlug::HashProcess : public Process
 				// No input connection, and no means of computing
 				// a value. There can only ever be a single value,
 				// which is stored directly on the plug - so we return
-				// the hash of that.
-				return p->m_staticValue->hash();
+				// the hash of that, which we memoised when the value
+				// was set.
+				return p->m_staticValueHash;
 			}
 
 			// A plug with an input connection or an output plug on a ComputeNode. There can be many values -
 			// one per context, computed by ComputeNode::hash(). First we see if we can retrieve the hash
 			// from our cache, and if we can't we'll compute it using a HashProcess instance.
 
-			ThreadData &threadData = g_threadData.local();
-			if( !Process::current() )
-			{
-				// Starting a new root computation.
-				if( ++(threadData.cacheClearCount) == 3200 )
-				{
-					// Prevent unbounded growth in the hash cache
-					// if many computations are being performed
-					// without any plugs being dirtied in between,
-					// by clearing it after every Nth computation.
-					// N == 3200 was observed to be 6x faster than
-					// N == 100 for a procedural instancing scene at
-					// a memory cost of about 100 mb.
-					threadData.clearCache = 1;
-				}
-			}
-
-			if( threadData.clearCache )
+			const HashCacheKey key( p, contextHash( p ), p->m_dirtyCount );
+			if( boost::optional<IECore::MurmurHash> cachedHash = g_cache.getIfCached( key ) )
 			{
-				threadData.cache.clear();
-				threadData.cacheClearCount = 0;
-				threadData.clearCache = 0;
+				cacheEvent( Monitor::HashCacheHit, p );
+				return *cachedHash;
 			}
 
-			const CacheKey key( p, Context::current()->hash() );
-			Cache::iterator it = threadData.cache.find( key );
-			if( it != threadData.cache.end() )
+			if( const ValuePlug *input = passThrough( p ) )
 			{
-				return it->second;
+				// The node has told us that the input and output are one and
+				// the same, so we can skip the process and the cache entry.
+				return input->hash();
 			}
 
 			HashProcess process( p, plug );
-			threadData.cache[key] = process.m_result;
+			g_cache.set( key, process.m_result, 1 );
 			return process.m_result;
 		}
 
+		static size_t getCacheSizeLimit()
+		{
+			return g_cache.getMaxCost();
+		}
+
+		static void setCacheSizeLimit( size_t maxEntries )
+		{
+			g_cache.setMaxCost( maxEntries );
+		}
+
 		static void clearCache()
 		{
-			// The docs for enumerable_thread_specific aren't particularly clear
-			// on whether or not it's ok to iterate an e_t_s while concurrently using
-			// local(), which is what we do here. So far in practice it seems to be
-			// OK.
-			tbb::enumerable_thread_specific<ThreadData>::iterator it, eIt;
-			for( it = g_threadData.begin(), eIt = g_threadData.end(); it != eIt; ++it )
+			g_cache.clear();
+		}
+
+		static uint64_t newDirtyCount()
+		{
+			return ++g_dirtyCount;
+		}
+
+		// Returns the hash of the parts of the current context which
+		// the node declares may affect p.
+		static IECore::MurmurHash contextHash( const ValuePlug *p )
+		{
+			const Context *context = Context::current();
+			std::vector<IECore::InternedString> variables;
+			if( p->ancestor<ComputeNode>()->contextDependencies( p, context, variables ) )
 			{
-				// We can't clear the cache now, because it is most likely
-				// in use by the owning thread. Instead we set this flag to
-				// politely request that the thread clears the cache itself
-				// at its earliest convenience - in the HashProcess constructor.
-				// This delay in clearing is OK, because it is illegal to modify
-				// a graph while a computation is being performed with it, and
-				// we know that the plug requesting the clear will be removed
-				// from the cache before the next computation starts.
-				it->clearCache = 1;
+				IECore::MurmurHash result = context->variablesHash( variables );
+				// Distinguish from the full hash of a context which
+				// happens to contain only these variables.
+				result.append( (uint64_t)variables.size() );
+				return result;
 			}
+			return context->hash();
+		}
+
+		// Returns the input plug that the node declares will
+		// be passed through to p in the current context, or NULL.
+		static const ValuePlug *passThrough( const ValuePlug *p )
+		{
+			if( p->getInput<Plug>() )
+			{
+				return NULL;
+			}
+
+			const ComputeNode *n = p->ancestor<ComputeNode>();
+			if( !n )
+			{
+				return NULL;
+			}
+
+			const ValuePlug *input = n->passThrough( p, Context::current() );
+			if( !input || input == p || input->typeId() != p->typeId() )
+			{
+				return NULL;
+			}
+
+			return input;
 		}
 
 		static const IECore::InternedString staticType;
@@ -203,6 +470,12 @@ class ValuePlug::HashProcess : public Process
 			}
 		}
 
+		static IECore::MurmurHash nullGetter( const HashCacheKey &key, size_t &cost )
+		{
+			cost = 1;
+			return IECore::MurmurHash();
+		}
+
 		// During a single graph evaluation, we actually call ValuePlug::hash()
 		// many times for the same plugs. First hash() is called for the terminating plug,
 		// which will call hash() for all the upstream plugs, and then compute() is called
@@ -212,33 +485,44 @@ class ValuePlug::HashProcess : public Process
 		// in the length of the chain of nodes - not good. Thanks is due to David Minor for
 		// being the first to point this out.
 		//
-		// We address this problem by keeping a per-thread cache of hashes, indexed
-		// by the plug the hash is for and the context the hash was performed in. The
-		// typedefs below describe that data structure. We use Plug::dirty() to empty
-		// the caches, because they are invalidated whenever an upstream value or
-		// connection is changed. We also clear the cache unconditionally every N
-		// computations, to prevent unbounded growth.
-		typedef std::pair<const ValuePlug *, IECore::MurmurHash> CacheKey;
-		typedef boost::unordered_map<CacheKey, IECore::MurmurHash> Cache;
-
-		// To support multithreading, each thread has it's own state.
-		struct ThreadData
-		{
-			ThreadData() : cacheClearCount( 0 ) {}
-			int cacheClearCount;
-			Cache cache;
-			// Flag to request that hashCache be cleared.
-			tbb::atomic<int> clearCache;
-		};
+		// We address this problem by keeping a cache of hashes, indexed by the plug the
+		// hash is for, the context the hash was performed in, and the dirty count of the
+		// plug at the time. The cache is shared between all threads, so a hash computed on
+		// one thread can be reused by all others. Because any edit that could change a hash
+		// dirties the plug and gives it a new dirty count, stale entries are simply never
+		// looked up again, and edits elsewhere in the graph don't invalidate anything.
+		// Dirty counts are allocated from a single global counter, so a new plug that
+		// reuses the address of a deleted one can't match the deleted plug's entries.
+		// Unused entries are discarded by the LRU mechanism, with each entry having a
+		// cost of 1.
+		typedef IECorePreview::LRUCache<HashCacheKey, IECore::MurmurHash> Cache;
+		static Cache g_cache;
 
-		static tbb::enumerable_thread_specific<ThreadData, tbb::cache_aligned_allocator<ThreadData>, tbb::ets_key_per_instance > g_threadData;
+		static tbb::atomic<uint64_t> g_dirtyCount;
 
 		IECore::MurmurHash m_result;
 
 };
 
 const IECore::InternedString ValuePlug::HashProcess::staticType( "computeNode:hash" );
-tbb::enumerable_thread_specific<ValuePlug::HashProcess::ThreadData, tbb::cache_aligned_allocator<ValuePlug::HashProcess::ThreadData>, tbb::ets_key_per_instance > ValuePlug::HashProcess::g_threadData;
+ValuePlug::HashProcess::Cache ValuePlug::HashProcess::g_cache( nullGetter, 1000000 );
+tbb::atomic<uint64_t> ValuePlug::HashProcess::g_dirtyCount;
+
+//////////////////////////////////////////////////////////////////////////
+// CacheResidency
+//////////////////////////////////////////////////////////////////////////
+
+struct ValuePlug::CacheResidency : public IECore::RefCounted
+{
+
+	CacheResidency()
+	{
+		memoryUsage = 0;
+	}
+
+	tbb::atomic<size_t> memoryUsage;
+
+};
 
 //////////////////////////////////////////////////////////////////////////
 // The ComputeProcess manages the task of calling ComputeNode::compute()
@@ -265,9 +549,34 @@ class ValuePlug::ComputeProcess : public Process
 			return g_cache.currentCost();
 		}
 
+		static size_t cacheMemoryUsage( const GraphComponent *graphComponent )
+		{
+			size_t result = 0;
+			if( const ValuePlug *plug = IECore::runTimeCast<const ValuePlug>( graphComponent ) )
+			{
+				if( const CacheResidency *residency = plug->m_cacheResidency )
+				{
+					result += residency->memoryUsage;
+				}
+			}
+
+			for( GraphComponent::ChildIterator it = graphComponent->children().begin(), eIt = graphComponent->children().end(); it != eIt; ++it )
+			{
+				result += cacheMemoryUsage( it->get() );
+			}
+			return result;
+		}
+
 		static void clearCache()
 		{
 			g_cache.clear();
+			// As for the HashProcess previously, we can't clear the thread local
+			// caches directly, because they may be in use by their owning threads.
+			// Instead we ask each thread to clear its own cache when it next uses it.
+			for( ThreadLocalCaches::iterator it = g_threadLocalCaches.begin(), eIt = g_threadLocalCaches.end(); it != eIt; ++it )
+			{
+				it->clearRequested = 1;
+			}
 		}
 
 		static IECore::ConstObjectPtr value( const ValuePlug *plug, const IECore::MurmurHash *precomputedHash )
@@ -288,42 +597,44 @@ class ValuePlug::ComputeProcess : public Process
 			// A plug with an input connection or an output plug on a ComputeNode. There can be many values -
 			// one per context, computed via ComputeNode::compute().
 
-			if( p->getFlags( Plug::Cacheable ) )
+			const CachePolicy cachePolicy = computeCachePolicy( p );
+			if( cachePolicy == Uncached )
 			{
-				// First see if we've done this computation already, and reuse the
-				// result if we have.
-				IECore::MurmurHash hash = precomputedHash ? *precomputedHash : p->hash();
-				IECore::ConstObjectPtr result = g_cache.get( hash );
-				if( result )
+				if( const ValuePlug *input = HashProcess::passThrough( p ) )
 				{
-					return result;
+					return value( input, NULL );
 				}
+				// Plug has requested no caching, so we compute from scratch every
+				// time.
+				return compute( p, plug, cachePolicy );
+			}
 
-				// Otherwise, use a ComputeProcess instance to do the work.
-				ComputeProcess process( p, plug );
-				// Store the value in the cache, after first checking that this hasn't
-				// been done already. The check is useful because it's common for an
-				// upstream compute triggered by to have already
-				// done the work, and calling memoryUsage() can be very expensive for some
-				// datatypes. A prime example of this is the attribute state passed around
-				// in GafferScene - it's common for a selective filter to mean that the
-				// attribute compute is implemented as a pass-through (thus an upstream node
-				// will already have computed the same result) and the attribute data itself
-				// consists of many small objects for which computing memory usage is slow.
-				/// \todo Accessing the LRUCache multiple times like this does have an
-				/// overhead, and at some point we'll need to address that.
-				if( !g_cache.get( hash ) )
-				{
-					g_cache.set( hash, process.m_result, process.m_result->memoryUsage() );
-				}
-				return process.m_result;
+			const IECore::MurmurHash hash = precomputedHash ? *precomputedHash : p->hash();
+			if( cachePolicy == ThreadLocal )
+			{
+				return threadLocalCompute( p, plug, hash );
 			}
-			else
+
+			// First see if we've done this computation already, and reuse the
+			// result if we have.
+			if( boost::optional<CacheValue> result = g_cache.getIfCached( hash ) )
 			{
-				// Plug has requested no caching, so we compute from scratch every
-				// time.
-				return ComputeProcess( p, plug ).m_result;
+				cacheEvent( Monitor::ComputeCacheHit, p );
+				return result->object;
 			}
+
+			// If the node passes through an input in this context, then
+			// the input has the same hash as us, and we can evaluate it
+			// directly, without a process of our own.
+			if( const ValuePlug *input = HashProcess::passThrough( p ) )
+			{
+				return value( input, &hash );
+			}
+
+			// Otherwise, we need to compute the result ourselves, or share
+			// the computation being performed by another thread.
+			cacheEvent( Monitor::ComputeCacheMiss, p );
+			return cachedCompute( p, plug, hash, cachePolicy );
 		}
 
 		static void receiveResult( const ValuePlug *plug, IECore::ConstObjectPtr result )
@@ -383,23 +694,501 @@ class ValuePlug::ComputeProcess : public Process
 			}
 		}
 
-		static IECore::ObjectPtr nullGetter( const IECore::MurmurHash &h, size_t &cost )
+		// When many threads request the same value at once, we want them to
+		// share a single computation rather than each performing their own.
+		// We achieve this by registering each cacheable computation in a map
+		// of "in flight" computations, keyed by hash. Threads arriving later
+		// find the registration and wait for the original thread to finish
+		// before taking its result.
+		//
+		// A waiting thread can't do anything else, so we must take care that
+		// no cycle of waiting threads can form. We guarantee this by only
+		// waiting if the current thread isn't itself responsible for another
+		// in-flight computation - otherwise we simply perform the computation
+		// again, as we would have done without the registry.
+		struct InFlightCompute : public IECore::RefCounted
+		{
+			// Locked by the computing thread for the duration
+			// of the computation, so that waiting threads block
+			// until the result is available.
+			tbb::mutex mutex;
+			// Remains NULL if the computation fails.
+			IECore::ConstObjectPtr result;
+		};
+
+		typedef boost::intrusive_ptr<InFlightCompute> InFlightComputePtr;
+
+		struct HashCompare
+		{
+			static size_t hash( const IECore::MurmurHash &h )
+			{
+				return boost::hash<IECore::MurmurHash>()( h );
+			}
+
+			static bool equal( const IECore::MurmurHash &h1, const IECore::MurmurHash &h2 )
+			{
+				return h1 == h2;
+			}
+		};
+
+		typedef tbb::concurrent_hash_map<IECore::MurmurHash, InFlightComputePtr, HashCompare> InFlightComputes;
+		static InFlightComputes g_inFlightComputes;
+
+		// The number of in-flight computations each thread is responsible for.
+		typedef tbb::enumerable_thread_specific<int, tbb::cache_aligned_allocator<int>, tbb::ets_key_per_instance> InFlightCounts;
+		static InFlightCounts g_inFlightCounts;
+
+		// Scope used by the thread performing an in-flight computation. Deregisters
+		// the computation and releases any waiting threads on destruction,
+		// whether or not the computation succeeded.
+		class InFlightScope : boost::noncopyable
+		{
+
+			public :
+
+				InFlightScope( const IECore::MurmurHash &hash, InFlightCompute *inFlightCompute )
+					:	m_hash( hash ), m_inFlightCompute( inFlightCompute ), m_count( g_inFlightCounts.local() )
+				{
+					m_count++;
+				}
+
+				~InFlightScope()
+				{
+					m_count--;
+					g_inFlightComputes.erase( m_hash );
+					m_inFlightCompute->mutex.unlock();
+				}
+
+			private :
+
+				const IECore::MurmurHash m_hash;
+				InFlightCompute *m_inFlightCompute;
+				int &m_count;
+
+		};
+
+		static CachePolicy computeCachePolicy( const ValuePlug *p )
+		{
+			if( !p->getFlags( Plug::Cacheable ) )
+			{
+				return Uncached;
+			}
+
+			if( p->getInput<Plug>() )
+			{
+				// Value will be computed by setFrom( input ).
+				return Standard;
+			}
+
+			// An output plug on a ComputeNode - value() has
+			// checked this for us.
+			return p->ancestor<ComputeNode>()->computeCachePolicy( p );
+		}
+
+		// Functor used to perform a computation within a task arena.
+		struct IsolatedCompute
+		{
+
+			IsolatedCompute( const ValuePlug *plug, const ValuePlug *downstream, IECore::ConstObjectPtr &result )
+				:	m_plug( plug ), m_downstream( downstream ), m_result( result )
+			{
+			}
+
+			void operator()() const
+			{
+				m_result = ComputeProcess( m_plug, m_downstream ).m_result;
+			}
+
+			private :
+
+				const ValuePlug *m_plug;
+				const ValuePlug *m_downstream;
+				IECore::ConstObjectPtr &m_result;
+
+		};
+
+		// Performs the computation, without consulting any
+		// caches, but taking care of task isolation.
+		static IECore::ConstObjectPtr compute( const ValuePlug *p, const ValuePlug *plug, CachePolicy cachePolicy )
+		{
+			if( cachePolicy == TaskIsolation )
+			{
+				// Computing in a separate arena means that while waiting
+				// for the tasks spawned by the computation, this thread
+				// can't steal unrelated outer tasks, which could otherwise
+				// block on the result of the very computation we're
+				// performing.
+				IECore::ConstObjectPtr result;
+				tbb::task_arena arena;
+				arena.execute( IsolatedCompute( p, plug, result ) );
+				return result;
+			}
+
+			return ComputeProcess( p, plug ).m_result;
+		}
+
+		// Performs the computation and stores the result in the global
+		// cache if the policy requires it.
+		static IECore::ConstObjectPtr computeAndStore( const ValuePlug *p, const ValuePlug *plug, const IECore::MurmurHash &hash, CachePolicy cachePolicy )
+		{
+			if( g_diskCache.enabled() )
+			{
+				if( IECore::ConstObjectPtr result = g_diskCache.get( hash ) )
+				{
+					// Recomputing would just mean reading from disk again,
+					// so we don't ask for any extra retention.
+					storeInCache( p, hash, result, 0.0 );
+					return result;
+				}
+			}
+
+			const tbb::tick_count startTime = tbb::tick_count::now();
+			IECore::ConstObjectPtr result;
+			if( g_computeClient && ComputeClient::computeRemotely( p ) )
+			{
+				// Returns NULL if the server can't provide the value,
+				// in which case we fall back to computing it ourselves.
+				result = g_computeClient->compute( p, hash );
+			}
+			if( !result )
+			{
+				result = compute( p, plug, cachePolicy );
+			}
+			const double duration = ( tbb::tick_count::now() - startTime ).seconds();
+
+			if( cachePolicy != CacheIfExpensive || duration > g_expensiveComputeThreshold )
+			{
+				storeInCache( p, hash, result, duration );
+			}
+
+			if( duration > g_diskCacheThreshold && g_diskCache.enabled() )
+			{
+				g_diskCache.set( hash, result.get() );
+			}
+
+			return result;
+		}
+
+		static IECore::ConstObjectPtr cachedCompute( const ValuePlug *p, const ValuePlug *plug, const IECore::MurmurHash &hash, CachePolicy cachePolicy )
+		{
+			InFlightComputePtr inFlightCompute;
+			bool responsible = false;
+			{
+				InFlightComputes::accessor accessor;
+				if( g_inFlightComputes.insert( accessor, hash ) )
+				{
+					accessor->second = new InFlightCompute;
+					// We lock while still holding the accessor, so that no
+					// other thread can find the registration before the
+					// lock is held.
+					accessor->second->mutex.lock();
+					responsible = true;
+				}
+				inFlightCompute = accessor->second;
+			}
+
+			if( responsible )
+			{
+				InFlightScope inFlightScope( hash, inFlightCompute.get() );
+				inFlightCompute->result = computeAndStore( p, plug, hash, cachePolicy );
+				return inFlightCompute->result;
+			}
+
+			if( !g_inFlightCounts.local() )
+			{
+				// Wait for the other thread to finish.
+				tbb::mutex::scoped_lock lock( inFlightCompute->mutex );
+				if( inFlightCompute->result )
+				{
+					return inFlightCompute->result;
+				}
+				// The computation failed on the other thread. Fall through
+				// and repeat it, so that the error is reported to our caller
+				// too.
+			}
+
+			return computeAndStore( p, plug, hash, cachePolicy );
+		}
+
+		// Computes a value using a cache private to the current thread,
+		// for use with the ThreadLocal policy.
+		static IECore::ConstObjectPtr threadLocalCompute( const ValuePlug *p, const ValuePlug *plug, const IECore::MurmurHash &hash )
+		{
+			ThreadLocalCache &cache = g_threadLocalCaches.local();
+			if( cache.clearRequested )
+			{
+				cache.map.clear();
+				cache.clearRequested = 0;
+			}
+
+			ThreadLocalCache::Map::const_iterator it = cache.map.find( hash );
+			if( it != cache.map.end() )
+			{
+				cacheEvent( Monitor::ComputeCacheHit, p );
+				return it->second;
+			}
+
+			cacheEvent( Monitor::ComputeCacheMiss, p );
+			IECore::ConstObjectPtr result = compute( p, plug, ThreadLocal );
+			if( cache.map.size() >= g_threadLocalCacheSize )
+			{
+				// Prevent unbounded growth. The entries are cheap
+				// to recompute by definition, so there's no need for
+				// anything more sophisticated than clearing the lot.
+				cache.map.clear();
+			}
+			cache.map[hash] = result;
+			return result;
+		}
+
+		typedef boost::intrusive_ptr<CacheResidency> CacheResidencyPtr;
+
+		// The values stored in g_cache. As well as the result itself, we
+		// reference the residency of the plug that computed it, so that
+		// the plug's memory usage can be updated on removal.
+		struct CacheValue
+		{
+
+			CacheValue()
+			{
+			}
+
+			CacheValue( const IECore::ConstObjectPtr &object, CacheResidency *residency )
+				:	object( object ), residency( residency )
+			{
+			}
+
+			IECore::ConstObjectPtr object;
+			CacheResidencyPtr residency;
+
+		};
+
+		typedef IECorePreview::LRUCache<IECore::MurmurHash, CacheValue> Cache;
+
+		static void storeInCache( const ValuePlug *plug, const IECore::MurmurHash &hash, const IECore::ConstObjectPtr &result, double duration )
+		{
+			// Store the value in the cache, unless this has been done already.
+			// It's common for an upstream compute triggered by us to have already
+			// done the work, and calling memoryUsage() can be very expensive for some
+			// datatypes, so setIfUncached() only calls it when necessary. A prime
+			// example of this is the attribute state passed around in GafferScene -
+			// it's common for a selective filter to mean that the attribute compute
+			// is implemented as a pass-through (thus an upstream node will already
+			// have computed the same result) and the attribute data itself consists
+			// of many small objects for which computing memory usage is slow.
+			//
+			// When the value is computed, we also remember it in g_objectCosts for
+			// as long as the object is in the cache, so that storing the same object
+			// again under a different hash doesn't require memoryUsage() to be called
+			// again.
+			//
+			// The entry is also given a retention based on how long the compute
+			// took relative to the memory it occupies, so that results which are
+			// expensive to recompute are preferred when the cache is full.
+			size_t cost = 0;
+			bool costed = false;
+			const CacheValue value( result, cacheResidency( plug ) );
+			if( g_cache.setIfUncached(
+				hash, value,
+				boost::bind( &cacheCost, ::_1, boost::ref( cost ), boost::ref( costed ) ),
+				boost::bind( &cacheRetention, duration, ::_1 )
+			) )
+			{
+				cacheEvent( Monitor::ComputeCacheStore, plug, cost );
+			}
+			else if( costed )
+			{
+				// We registered the cost in anticipation of storing
+				// the object, but it wasn't stored after all.
+				value.residency->memoryUsage -= cost;
+				releaseObjectCost( result.get() );
+			}
+		}
+
+		// Computes the cost of a value, recording it in `cost` so it can
+		// be reported to monitors. The cost is registered in g_objectCosts
+		// and the plug's residency before the value is stored, because the
+		// value may be removed from the cache again before setIfUncached()
+		// returns.
+		static size_t cacheCost( const CacheValue &value, size_t &cost, bool &costed )
+		{
+			cost = objectCost( value.object.get() );
+			costed = true;
+
+			ObjectCosts::accessor accessor;
+			if( g_objectCosts.insert( accessor, value.object.get() ) )
+			{
+				accessor->second.cost = cost;
+				accessor->second.count = 0;
+			}
+			accessor->second.count++;
+
+			value.residency->memoryUsage += cost;
+
+			return cost;
+		}
+
+		// Returns the number of additional eviction sweeps a value will
+		// survive, doubling the compute time per megabyte required for
+		// each one. Cheap values get no special treatment, so the cache
+		// behaves as a plain LRU cache unless there is a mix of costs.
+		static Cache::Retention cacheRetention( double duration, size_t cost )
+		{
+			double secondsPerMegabyte = duration * 1024.0 * 1024.0 / std::max( cost, (size_t)1 );
+			Cache::Retention result = 0;
+			while( secondsPerMegabyte >= g_retentionThreshold && result < g_maxRetention )
+			{
+				result++;
+				secondsPerMegabyte *= 0.5;
+			}
+			return result;
+		}
+
+		// Returns the residency for the plug, creating it if necessary.
+		static CacheResidency *cacheResidency( const ValuePlug *plug )
+		{
+			if( CacheResidency *residency = plug->m_cacheResidency )
+			{
+				return residency;
+			}
+
+			CacheResidency *residency = new CacheResidency;
+			residency->addRef();
+			if( CacheResidency *existing = plug->m_cacheResidency.compare_and_swap( residency, NULL ) )
+			{
+				// Another thread beat us to it.
+				residency->removeRef();
+				return existing;
+			}
+			return residency;
+		}
+
+		// Returns the cost of an object, reusing known costs where possible.
+		static size_t objectCost( const IECore::Object *object )
+		{
+			{
+				ObjectCosts::const_accessor accessor;
+				if( g_objectCosts.find( accessor, object ) )
+				{
+					return accessor->second.cost;
+				}
+			}
+
+			if( object->typeId() == IECore::CompoundObjectTypeId )
+			{
+				// The members of a CompoundObject are frequently the results
+				// of other computes, and therefore already have known costs.
+				// A prime example is the attribute state in GafferScene, where
+				// the members are shaders computed by upstream nodes. We sum
+				// the costs of the members rather than calling memoryUsage()
+				// so that we don't need to traverse those members again.
+				const IECore::CompoundObject::ObjectMap &members = static_cast<const IECore::CompoundObject *>( object )->members();
+				size_t result = sizeof( IECore::CompoundObject );
+				for( IECore::CompoundObject::ObjectMap::const_iterator it = members.begin(), eIt = members.end(); it != eIt; ++it )
+				{
+					result += sizeof( IECore::CompoundObject::ObjectMap::value_type ) + objectCost( it->second.get() );
+				}
+				return result;
+			}
+
+			return object->memoryUsage();
+		}
+
+		// Returns the cost that was released, or 0 if the cost was unknown.
+		static size_t releaseObjectCost( const IECore::Object *object )
+		{
+			ObjectCosts::accessor accessor;
+			if( g_objectCosts.find( accessor, object ) )
+			{
+				const size_t cost = accessor->second.cost;
+				if( --accessor->second.count == 0 )
+				{
+					g_objectCosts.erase( accessor );
+				}
+				return cost;
+			}
+			return 0;
+		}
+
+		static void removalCallback( const IECore::MurmurHash &h, const CacheValue &value )
+		{
+			value.residency->memoryUsage -= releaseObjectCost( value.object.get() );
+		}
+
+		static CacheValue nullGetter( const IECore::MurmurHash &h, size_t &cost )
 		{
 			cost = 0;
-			return NULL;
+			return CacheValue();
 		}
 
 		// A cache mapping from ValuePlug::hash() to the result of the previous computation
 		// for that hash. This allows us to cache results for faster repeat evaluation
-		typedef IECorePreview::LRUCache<IECore::MurmurHash, IECore::ConstObjectPtr> Cache;
 		static Cache g_cache;
 
+		// The costs of the objects currently held in g_cache. The same object is
+		// often stored under many hashes, so we count the number of entries
+		// referring to it, and forget the cost only when the last is removed.
+		// Because the cache holds a reference to each object, there is no danger
+		// of the cost being reused for a different object allocated at the same
+		// address.
+		struct ObjectCost
+		{
+			size_t cost;
+			size_t count;
+		};
+
+		typedef tbb::concurrent_hash_map<const IECore::Object *, ObjectCost> ObjectCosts;
+		static ObjectCosts g_objectCosts;
+
+		// Computes taking less time than this (in seconds) are not
+		// stored in the global cache when using the CacheIfExpensive
+		// policy.
+		static const double g_expensiveComputeThreshold;
+		// Only computes taking longer than this are stored
+		// in the disk cache, since reading and writing files
+		// has significant overhead of its own.
+		static const double g_diskCacheThreshold;
+		// Values computed at a rate of at least this many seconds
+		// per megabyte are given a retention in g_cache, and the
+		// retention grows each time the rate doubles, up to
+		// g_maxRetention.
+		static const double g_retentionThreshold;
+		static const Cache::Retention g_maxRetention;
+
+		// Small per-thread caches used by the ThreadLocal policy.
+		struct ThreadLocalCache
+		{
+			ThreadLocalCache()
+			{
+				clearRequested = 0;
+			}
+
+			typedef boost::unordered_map<IECore::MurmurHash, IECore::ConstObjectPtr> Map;
+			Map map;
+			// Flag to request that the map be cleared.
+			tbb::atomic<int> clearRequested;
+		};
+
+		typedef tbb::enumerable_thread_specific<ThreadLocalCache, tbb::cache_aligned_allocator<ThreadLocalCache>, tbb::ets_key_per_instance> ThreadLocalCaches;
+		static ThreadLocalCaches g_threadLocalCaches;
+		static const size_t g_threadLocalCacheSize;
+
 		IECore::ConstObjectPtr m_result;
 
 };
 
 const IECore::InternedString ValuePlug::ComputeProcess::staticType( "computeNode:compute" );
-ValuePlug::ComputeProcess::Cache ValuePlug::ComputeProcess::g_cache( nullGetter, 1024 * 1024 * 1024 * 1 ); // 1 gig
+// Defined before g_cache, so that it outlives it.
+ValuePlug::ComputeProcess::ObjectCosts ValuePlug::ComputeProcess::g_objectCosts;
+ValuePlug::ComputeProcess::Cache ValuePlug::ComputeProcess::g_cache( nullGetter, removalCallback, 1024 * 1024 * 1024 * 1 ); // 1 gig
+ValuePlug::ComputeProcess::InFlightComputes ValuePlug::ComputeProcess::g_inFlightComputes;
+ValuePlug::ComputeProcess::InFlightCounts ValuePlug::ComputeProcess::g_inFlightCounts( 0 );
+const double ValuePlug::ComputeProcess::g_expensiveComputeThreshold = 0.001;
+const double ValuePlug::ComputeProcess::g_diskCacheThreshold = 0.1;
+const double ValuePlug::ComputeProcess::g_retentionThreshold = 0.01;
+const ValuePlug::ComputeProcess::Cache::Retention ValuePlug::ComputeProcess::g_maxRetention = 8;
+ValuePlug::ComputeProcess::ThreadLocalCaches ValuePlug::ComputeProcess::g_threadLocalCaches;
+const size_t ValuePlug::ComputeProcess::g_threadLocalCacheSize = 1000;
 
 //////////////////////////////////////////////////////////////////////////
 // SetValueAction implementation
@@ -412,8 +1201,8 @@ class ValuePlug::SetValueAction : public Gaffer::Action
 
 		IE_CORE_DECLARERUNTIMETYPEDEXTENSION( Gaffer::ValuePlug::SetValueAction, SetValueActionTypeId, Gaffer::Action );
 
-		SetValueAction( ValuePlugPtr plug, IECore::ConstObjectPtr value )
-			:	m_plug( plug ), m_doValue( value ), m_undoValue( plug->m_staticValue )
+		SetValueAction( ValuePlugPtr plug, IECore::ConstObjectPtr value, const IECore::MurmurHash &valueHash )
+			:	m_plug( plug ), m_doValue( value ), m_doHash( valueHash ), m_undoValue( plug->m_staticValue ), m_undoHash( plug->m_staticValueHash )
 		{
 		}
 
@@ -426,12 +1215,12 @@ class ValuePlug::SetValueAction : public Gaffer::Action
 
 		virtual void doAction()
 		{
-			m_plug->setValueInternal( m_doValue, true );
+			m_plug->setValueInternal( m_doValue, m_doHash, true );
 		}
 
 		virtual void undoAction()
 		{
-			m_plug->setValueInternal( m_undoValue, true );
+			m_plug->setValueInternal( m_undoValue, m_undoHash, true );
 		}
 
 		virtual bool canMerge( const Action *other ) const
@@ -448,13 +1237,27 @@ class ValuePlug::SetValueAction : public Gaffer::Action
 		{
 			const SetValueAction *setValueAction = static_cast<const SetValueAction *>( other );
 			m_doValue = setValueAction->m_doValue;
+			m_doHash = setValueAction->m_doHash;
+		}
+
+		virtual size_t memoryUsage() const
+		{
+			// Consecutive actions share values, with the do value of one
+			// being the undo value of the next, and the final do value
+			// being the current value of the plug. So we only count the
+			// undo value, to avoid counting everything twice.
+			return Action::memoryUsage() + ( m_undoValue ? m_undoValue->memoryUsage() : 0 );
 		}
 
 	private :
 
 		ValuePlugPtr m_plug;
 		IECore::ConstObjectPtr m_doValue;
+		// We store the hashes alongside the values, so that
+		// undo and redo don't need to rehash them.
+		IECore::MurmurHash m_doHash;
 		IECore::ConstObjectPtr m_undoValue;
+		IECore::MurmurHash m_undoHash;
 
 };
 
@@ -472,15 +1275,18 @@ IE_CORE_DEFINERUNTIMETYPED( ValuePlug );
 /// even creating the values before figuring out if we've already got them somewhere).
 ValuePlug::ValuePlug( const std::string &name, Direction direction,
 	IECore::ConstObjectPtr defaultValue, unsigned flags )
-	:	Plug( name, direction, flags ), m_defaultValue( defaultValue ), m_staticValue( defaultValue )
+	:	Plug( name, direction, flags ), m_defaultValue( defaultValue ), m_staticValue( defaultValue ), m_dirtyCount( HashProcess::newDirtyCount() )
 {
 	assert( m_defaultValue );
 	assert( m_staticValue );
+	m_defaultValueHash = m_staticValueHash = m_defaultValue->hash();
+	m_cacheResidency = NULL;
 }
 
 ValuePlug::ValuePlug( const std::string &name, Direction direction, unsigned flags )
-	:	Plug( name, direction, flags ), m_defaultValue( NULL ), m_staticValue( NULL )
+	:	Plug( name, direction, flags ), m_defaultValue( NULL ), m_staticValue( NULL ), m_dirtyCount( HashProcess::newDirtyCount() )
 {
+	m_cacheResidency = NULL;
 	// We expect to have children added/removed, so arrange to deal with that
 	// appropriately. The other constructor above is for leaf plugs (this is
 	// enforced in acceptsChild()) so we don't need to connect there.
@@ -490,10 +1296,10 @@ ValuePlug::ValuePlug( const std::string &name, Direction direction, unsigned fla
 
 ValuePlug::~ValuePlug()
 {
-	// Clear hash cache, so that a newly created plug that just
-	// happens to reuse our address won't end up inadvertently also
-	// reusing our cache entries.
-	HashProcess::clearCache();
+	if( m_cacheResidency )
+	{
+		m_cacheResidency->removeRef();
+	}
 }
 
 bool ValuePlug::acceptsChild( const GraphComponent *potentialChild ) const
@@ -554,7 +1360,7 @@ void ValuePlug::setInput( PlugPtr input )
 	// is emitting for us in Plug::setInput().
 	if( !input )
 	{
-		setValueInternal( m_staticValue, false );
+		setValueInternal( m_staticValue, m_staticValueHash, false );
 	}
 
 	Plug::setInput( input );
@@ -644,6 +1450,12 @@ bool ValuePlug::isSetToDefault() const
 {
 	if( m_defaultValue != NULL )
 	{
+		if( direction() == In && !getInput<Plug>() )
+		{
+			// Static value, so we can simply compare the
+			// memoised hashes.
+			return m_staticValueHash == m_defaultValueHash;
+		}
 		return getObjectValue()->isEqualTo( m_defaultValue.get() );
 	}
 	else
@@ -659,6 +1471,21 @@ bool ValuePlug::isSetToDefault() const
 	}
 }
 
+IECore::MurmurHash ValuePlug::defaultHash() const
+{
+	if( m_defaultValue != NULL )
+	{
+		return m_defaultValueHash;
+	}
+
+	IECore::MurmurHash h;
+	for( ValuePlugIterator it( this ); !it.done(); ++it )
+	{
+		h.append( (*it)->defaultHash() );
+	}
+	return h;
+}
+
 IECore::MurmurHash ValuePlug::hash() const
 {
 	if( !m_staticValue )
@@ -682,6 +1509,83 @@ void ValuePlug::hash( IECore::MurmurHash &h ) const
 	h.append( hash() );
 }
 
+uint64_t ValuePlug::dirtyCount() const
+{
+	return m_dirtyCount;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Batch evaluation
+//////////////////////////////////////////////////////////////////////////
+
+class ValuePlug::BatchTask
+{
+
+	public :
+
+		BatchTask( const std::vector<const ValuePlug *> &plugs, const std::vector<const Context *> &contexts, std::vector<IECore::MurmurHash> *hashes )
+			:	m_plugs( plugs ), m_contexts( contexts ), m_context( Context::current() ), m_hashes( hashes )
+		{
+			if( !m_contexts.empty() && m_contexts.size() != m_plugs.size() )
+			{
+				throw IECore::Exception( boost::str( boost::format( "Number of contexts (%d) does not match number of plugs (%d)" ) % m_contexts.size() % m_plugs.size() ) );
+			}
+		}
+
+		void operator()( const tbb::blocked_range<size_t> &r ) const
+		{
+			for( size_t i = r.begin(); i != r.end(); ++i )
+			{
+				Context::Scope scope( m_contexts.empty() ? m_context : m_contexts[i] );
+				if( m_hashes )
+				{
+					(*m_hashes)[i] = m_plugs[i]->hash();
+				}
+				else
+				{
+					m_plugs[i]->prefetchInternal();
+				}
+			}
+		}
+
+	private :
+
+		const std::vector<const ValuePlug *> &m_plugs;
+		const std::vector<const Context *> &m_contexts;
+		// The context of the calling thread, used when
+		// `m_contexts` is empty.
+		const Context *m_context;
+		std::vector<IECore::MurmurHash> *m_hashes;
+
+};
+
+void ValuePlug::hashes( const std::vector<const ValuePlug *> &plugs, const std::vector<const Context *> &contexts, std::vector<IECore::MurmurHash> &hashes )
+{
+	BatchTask task( plugs, contexts, &hashes );
+	hashes.resize( plugs.size() );
+	tbb::parallel_for( tbb::blocked_range<size_t>( 0, plugs.size() ), task );
+}
+
+void ValuePlug::prefetch( const std::vector<const ValuePlug *> &plugs, const std::vector<const Context *> &contexts )
+{
+	BatchTask task( plugs, contexts, NULL );
+	tbb::parallel_for( tbb::blocked_range<size_t>( 0, plugs.size() ), task );
+}
+
+void ValuePlug::prefetchInternal() const
+{
+	if( !m_staticValue )
+	{
+		for( ValuePlugIterator it( this ); !it.done(); ++it )
+		{
+			(*it)->prefetchInternal();
+		}
+		return;
+	}
+
+	getObjectValue();
+}
+
 const IECore::Object *ValuePlug::defaultObjectValue() const
 {
 	return m_defaultValue.get();
@@ -713,9 +1617,14 @@ void ValuePlug::setObjectValue( IECore::ConstObjectPtr value )
 			throw IECore::Exception( boost::str( boost::format( "Cannot set value for read only plug \"%s\"" ) % fullName() ) );
 		}
 
-		if( value->isNotEqualTo( m_staticValue.get() ) )
+		// Comparing hashes is a single pass over the value, where
+		// comparing the values themselves would need another to hash
+		// the new value afterwards. Hash equality is what identifies
+		// values everywhere else in Gaffer, so this is sufficient.
+		const IECore::MurmurHash valueHash = value->hash();
+		if( valueHash != m_staticValueHash )
 		{
-			Action::enact( new SetValueAction( this, value ) );
+			Action::enact( new SetValueAction( this, value, valueHash ) );
 		}
 
 		return;
@@ -727,9 +1636,10 @@ void ValuePlug::setObjectValue( IECore::ConstObjectPtr value )
 	ComputeProcess::receiveResult( this, value );
 }
 
-void ValuePlug::setValueInternal( IECore::ConstObjectPtr value, bool propagateDirtiness )
+void ValuePlug::setValueInternal( IECore::ConstObjectPtr value, const IECore::MurmurHash &valueHash, bool propagateDirtiness )
 {
 	m_staticValue = value;
+	m_staticValueHash = valueHash;
 
 	// it is important that we emit the plug set signal before
 	// we emit dirty signals. this is because the node may wish to
@@ -779,10 +1689,9 @@ void ValuePlug::emitPlugSet()
 
 void ValuePlug::dirty()
 {
-	/// \todo We might want to investigate methods of doing a
-	/// more fine grained clearing of only the dirtied plugs,
-	/// rather than clearing the whole cache.
-	HashProcess::clearCache();
+	// Taking a new dirty count means that all previously
+	// cached hashes for this plug will be ignored.
+	m_dirtyCount = HashProcess::newDirtyCount();
 }
 
 size_t ValuePlug::getCacheMemoryLimit()
@@ -800,7 +1709,57 @@ size_t ValuePlug::cacheMemoryUsage()
 	return ComputeProcess::cacheMemoryUsage();
 }
 
+size_t ValuePlug::cacheMemoryUsage( const GraphComponent *graphComponent )
+{
+	return ComputeProcess::cacheMemoryUsage( graphComponent );
+}
+
 void ValuePlug::clearCache()
 {
 	ComputeProcess::clearCache();
 }
+
+size_t ValuePlug::getHashCacheSizeLimit()
+{
+	return HashProcess::getCacheSizeLimit();
+}
+
+void ValuePlug::setHashCacheSizeLimit( size_t maxEntries )
+{
+	HashProcess::setCacheSizeLimit( maxEntries );
+}
+
+void ValuePlug::clearHashCache()
+{
+	HashProcess::clearCache();
+}
+
+void ValuePlug::setDiskCacheDirectory( const std::string &directory )
+{
+	g_diskCache.setDirectory( directory );
+}
+
+const std::string &ValuePlug::getDiskCacheDirectory()
+{
+	return g_diskCache.getDirectory();
+}
+
+void ValuePlug::setDiskCacheSizeLimit( size_t bytes )
+{
+	g_diskCache.setSizeLimit( bytes );
+}
+
+size_t ValuePlug::getDiskCacheSizeLimit()
+{
+	return g_diskCache.getSizeLimit();
+}
+
+void ValuePlug::setComputeClient( ComputeClientPtr client )
+{
+	g_computeClient = client;
+}
+
+ComputeClient *ValuePlug::getComputeClient()
+{
+	return g_computeClient.get();
+}
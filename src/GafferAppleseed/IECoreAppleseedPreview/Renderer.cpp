@@ -35,6 +35,7 @@
 //////////////////////////////////////////////////////////////////////////
 
 #include "tbb/atomic.h"
+#include "tbb/concurrent_hash_map.h"
 #include "tbb/concurrent_unordered_map.h"
 
 #include "boost/algorithm/string.hpp"
@@ -1093,6 +1094,7 @@ class AppleseedPrimitive : public AppleseedEntity
 			{
 				removeAssemblyInstance( m_objectAssemblyInstance );
 				removeAssembly( m_objectAssembly );
+				removeMainAssemblyTextures();
 				clearMaterial();
 				return;
 			}
@@ -1164,62 +1166,63 @@ class AppleseedPrimitive : public AppleseedEntity
 
 		virtual bool attributes( const IECoreScenePreview::Renderer::AttributesInterface *attributes )
 		{
-			if( isInteractiveRender() )
-			{
-				// Remove any previous material.
-				clearMaterial();
-			}
-
 			const AppleseedAttributes *appleseedAttributes = static_cast<const AppleseedAttributes*>( attributes );
 
 			if( appleseedAttributes->m_shaderGroup )
 			{
-				// Save a reference to the OSL shader group.
-				m_shaderGroup = appleseedAttributes->m_shaderGroup;
-
-				// Create a surface shader.
-				string surfaceShaderName = name() + "_surface_shader";
-				asr::ParamArray params;
-				params.insert( "front_lighting_samples", appleseedAttributes->m_shadingSamples );
-				params.insert( "back_lighting_samples", appleseedAttributes->m_shadingSamples );
-
-				asf::auto_release_ptr<asr::SurfaceShader> surfaceShader;
-				surfaceShader = asr::PhysicalSurfaceShaderFactory().create( surfaceShaderName.c_str(), params );
-				m_surfaceShader = surfaceShader.get();
-				insertSurfaceShader( surfaceShader );
-
-				// Create a material.
-				string materialName = name() + "_material";
-				params.clear();
-				params.insert( "surface_shader", surfaceShaderName.c_str() );
-				params.insert( "osl_surface", appleseedAttributes->m_shaderGroup->shaderGroupName() );
-
-				asf::auto_release_ptr<asr::Material> material;
-				material = asr::OSLMaterialFactory().create( materialName.c_str(), params );
-				m_material = material.get();
-				insertMaterial( material );
-
-				// Assign the material to the object instance.
-				m_objectInstance->assign_material( "default", asr::ObjectInstance::FrontSide, materialName.c_str() );
-				m_objectInstance->assign_material( "default", asr::ObjectInstance::BackSide, materialName.c_str() );
+				if( m_material )
+				{
+					// We already have a material, so we edit it in place rather
+					// than recreating it. This way only the entities which have
+					// actually changed need to be updated by the renderer.
+					updateMaterial( appleseedAttributes );
+				}
+				else
+				{
+					createMaterial( appleseedAttributes );
+				}
 			}
 			else
 			{
+				if( isInteractiveRender() )
+				{
+					// Remove any previous material.
+					clearMaterial();
+				}
+
 				// No shader assigned. Assign the default material to the object instance.
 				m_objectInstance->assign_material( "default", asr::ObjectInstance::FrontSide, g_defaultMaterialName );
 				m_objectInstance->assign_material( "default", asr::ObjectInstance::BackSide, g_defaultMaterialName );
 			}
 
-			if( !appleseedAttributes->m_alphaMap.empty() )
+			if( appleseedAttributes->m_alphaMap != m_alphaMap )
 			{
-				string alphaMapTexture = createMainAssemblyTexture( name() + "_alpha_map", appleseedAttributes->m_alphaMap, true );
-				m_object->get_parameters().insert( "alpha_map", alphaMapTexture.c_str() );
+				// Only recreate the texture entities when the alpha map
+				// has really changed.
+				removeMainAssemblyTextures();
+				if( !appleseedAttributes->m_alphaMap.empty() )
+				{
+					string alphaMapTexture = createMainAssemblyTexture( name() + "_alpha_map", appleseedAttributes->m_alphaMap, true );
+					m_object->get_parameters().insert( "alpha_map", alphaMapTexture.c_str() );
+				}
+				else
+				{
+					m_object->get_parameters().remove_path( "alpha_map" );
+				}
+				m_object->bump_version_id();
+				m_alphaMap = appleseedAttributes->m_alphaMap;
 			}
 
 			// Set the object instance params.
 			m_objectInstance->get_parameters().insert( "medium_priority", appleseedAttributes->m_mediumPriority );
 			m_objectInstance->get_parameters().insert( "visibility", appleseedAttributes->m_visibilityDictionary );
 
+			if( isInteractiveRender() )
+			{
+				m_objectInstance->bump_version_id();
+				bumpMainAssemblyVersionId();
+			}
+
 			// todo: support edits of smooth normals and tangents attribute.
 			return true;
 		}
@@ -1234,12 +1237,72 @@ class AppleseedPrimitive : public AppleseedEntity
 			m_objectInstance = NULL;
 			m_surfaceShader = NULL;
 			m_material = NULL;
+			m_shadingSamples = 0;
 		}
 
-		void clearMaterial()
+		void createMaterial( const AppleseedAttributes *appleseedAttributes )
+		{
+			// Save a reference to the OSL shader group.
+			m_shaderGroup = appleseedAttributes->m_shaderGroup;
+			m_shadingSamples = appleseedAttributes->m_shadingSamples;
+
+			// Create a surface shader.
+			string surfaceShaderName = name() + "_surface_shader";
+			asr::ParamArray params;
+			params.insert( "front_lighting_samples", appleseedAttributes->m_shadingSamples );
+			params.insert( "back_lighting_samples", appleseedAttributes->m_shadingSamples );
+
+			asf::auto_release_ptr<asr::SurfaceShader> surfaceShader;
+			surfaceShader = asr::PhysicalSurfaceShaderFactory().create( surfaceShaderName.c_str(), params );
+			m_surfaceShader = surfaceShader.get();
+			insertSurfaceShader( surfaceShader );
+
+			// Create a material.
+			string materialName = name() + "_material";
+			params.clear();
+			params.insert( "surface_shader", surfaceShaderName.c_str() );
+			params.insert( "osl_surface", appleseedAttributes->m_shaderGroup->shaderGroupName() );
+
+			asf::auto_release_ptr<asr::Material> material;
+			material = asr::OSLMaterialFactory().create( materialName.c_str(), params );
+			m_material = material.get();
+			insertMaterial( material );
+
+			// Assign the material to the object instance.
+			m_objectInstance->assign_material( "default", asr::ObjectInstance::FrontSide, materialName.c_str() );
+			m_objectInstance->assign_material( "default", asr::ObjectInstance::BackSide, materialName.c_str() );
+		}
+
+		void updateMaterial( const AppleseedAttributes *appleseedAttributes )
 		{
-			removeMainAssemblyTextures();
+			assert( m_material && m_surfaceShader );
 
+			if( appleseedAttributes->m_shadingSamples != m_shadingSamples )
+			{
+				m_surfaceShader->get_parameters().insert( "front_lighting_samples", appleseedAttributes->m_shadingSamples );
+				m_surfaceShader->get_parameters().insert( "back_lighting_samples", appleseedAttributes->m_shadingSamples );
+				m_surfaceShader->bump_version_id();
+				m_shadingSamples = appleseedAttributes->m_shadingSamples;
+			}
+
+			if( appleseedAttributes->m_shaderGroup != m_shaderGroup )
+			{
+				// The shader groups are shared via the ShaderCache, so
+				// switching to a new one is just a parameter edit.
+				m_material->get_parameters().insert( "osl_surface", appleseedAttributes->m_shaderGroup->shaderGroupName() );
+				m_material->bump_version_id();
+				m_shaderGroup = appleseedAttributes->m_shaderGroup;
+			}
+
+			// The default material may have been assigned since
+			// the material was created.
+			const string materialName = name() + "_material";
+			m_objectInstance->assign_material( "default", asr::ObjectInstance::FrontSide, materialName.c_str() );
+			m_objectInstance->assign_material( "default", asr::ObjectInstance::BackSide, materialName.c_str() );
+		}
+
+		void clearMaterial()
+		{
 			if( m_surfaceShader )
 			{
 				removeSurfaceShader( m_surfaceShader );
@@ -1335,15 +1398,18 @@ class AppleseedPrimitive : public AppleseedEntity
 				string fileName = string( "_geometry/" ) + hash.toString() + filenameExtensionForObject( &object );
 				boost::filesystem::path p = projectPath / fileName;
 
-				// todo: can we do something better than locking here?
+				// Write a geom file for the object if needed. We lock only the
+				// entry for this particular file, so that different files can
+				// be converted and written concurrently, while threads sharing
+				// the same object wait for the first to write it.
 				{
-					boost::lock_guard<boost::mutex> lock( g_geomFilesMutex );
-
-					// Write a geom file for the object if needed.
+					GeomFiles::accessor a;
+					g_geomFiles.insert( a, p.string() );
 					if( !boost::filesystem::exists( p ) )
 					{
 						writeGeomFile( &object, p );
 					}
+					g_geomFiles.erase( a );
 				}
 
 				// Store the filename into the object params.
@@ -1385,8 +1451,10 @@ class AppleseedPrimitive : public AppleseedEntity
 			AppleseedPrimitive::attributes( attributes );
 		}
 
-		// Used to protect mesh file writting for scene description renders.
-		static boost::mutex g_geomFilesMutex;
+		// Used to protect mesh file writing for scene description renders.
+		// Holds an entry for each file currently being written.
+		typedef tbb::concurrent_hash_map<std::string, bool> GeomFiles;
+		static GeomFiles g_geomFiles;
 
 		asr::TransformSequence m_transformSequence;
 
@@ -1399,10 +1467,12 @@ class AppleseedPrimitive : public AppleseedEntity
 		AppleseedShaderPtr m_shaderGroup;
 		asr::SurfaceShader *m_surfaceShader;
 		asr::Material *m_material;
+		int m_shadingSamples;
+		string m_alphaMap;
 
 };
 
-boost::mutex AppleseedPrimitive::g_geomFilesMutex;
+AppleseedPrimitive::GeomFiles AppleseedPrimitive::g_geomFiles;
 
 } // namespace
 
@@ -35,6 +35,9 @@
 //////////////////////////////////////////////////////////////////////////
 
 #include <set>
+#include <map>
+
+#include "boost/format.hpp"
 
 #include "openvdb/openvdb.h"
 
@@ -43,6 +46,7 @@
 
 #include "Gaffer/StringPlug.h"
 #include "Gaffer/StringAlgo.h"
+#include "Gaffer/Private/IECorePreview/LRUCache.h"
 
 #include "GafferArnold/ArnoldVDB.h"
 
@@ -59,7 +63,27 @@ using namespace GafferArnold;
 namespace
 {
 
-Box3f boundAndAutoStepSize( const std::string &fileName, const std::set<std::string> &sets, float &autoStepSize )
+// Bounds and voxel sizes for all the grids in a file, read
+// from the file metadata without loading any voxel data.
+struct FileMetadata : public IECore::RefCounted
+{
+
+	struct Grid
+	{
+		Grid() : hasBound( false ), voxelSize( 0.0f ) {}
+		bool hasBound;
+		openvdb::BBoxd bound;
+		float voxelSize;
+	};
+
+	typedef std::map<std::string, Grid> GridMap;
+	GridMap grids;
+
+};
+
+IE_CORE_DECLAREPTR( FileMetadata )
+
+ConstFileMetadataPtr fileMetadataGetter( const std::string &fileName, size_t &cost )
 {
 	openvdb::initialize();
 	openvdb::io::File file( fileName );
@@ -70,18 +94,74 @@ Box3f boundAndAutoStepSize( const std::string &fileName, const std::set<std::str
 	file.setCopyMaxBytes( 0 );
 	file.open();
 
+	FileMetadataPtr result = new FileMetadata;
+	openvdb::GridPtrVecPtr grids = file.readAllGridMetadata();
+	for( openvdb::GridPtrVec::const_iterator it = grids->begin(), eIt = grids->end(); it != eIt; ++it )
+	{
+		const openvdb::GridBase &grid = **it;
+		FileMetadata::Grid &g = result->grids[grid.getName()];
+
+		const openvdb::Vec3d voxelSize = grid.voxelSize();
+		g.voxelSize = std::min( voxelSize.x(), std::min( voxelSize.y(), voxelSize.z() ) );
+
+		openvdb::Vec3IMetadata::ConstPtr min = grid.getMetadata<openvdb::Vec3IMetadata>( openvdb::GridBase::META_FILE_BBOX_MIN );
+		openvdb::Vec3IMetadata::ConstPtr max = grid.getMetadata<openvdb::Vec3IMetadata>( openvdb::GridBase::META_FILE_BBOX_MAX );
+		if( min && max )
+		{
+			g.hasBound = true;
+			g.bound = grid.transform().indexToWorld( openvdb::BBoxd( min->value() - 0.5, max->value() + 0.5 ) );
+		}
+	}
+
+	cost = 1;
+	return result;
+}
+
+typedef IECorePreview::LRUCache<std::string, ConstFileMetadataPtr> FileMetadataCache;
+
+FileMetadataCache &fileMetadataCache()
+{
+	static FileMetadataCache *g_cache = new FileMetadataCache( fileMetadataGetter, 1000 );
+	return *g_cache;
+}
+
+ConstFileMetadataPtr fileMetadata( const std::string &fileName )
+{
+	FileMetadataCache &cache = fileMetadataCache();
+	try
+	{
+		return cache.get( fileName );
+	}
+	catch( ... )
+	{
+		// Don't remember the failure, so that we can
+		// try again if the file is subsequently created.
+		cache.erase( fileName );
+		throw;
+	}
+}
+
+Box3f boundAndAutoStepSize( const std::string &fileName, const std::set<std::string> &grids, float &autoStepSize )
+{
+	ConstFileMetadataPtr metadata = fileMetadata( fileName );
+
 	autoStepSize = Imath::limits<float>::max();
 
 	openvdb::BBoxd result;
-	for( std::set<std::string>::const_iterator it = sets.begin(), eIt = sets.end(); it != eIt; ++it )
+	for( std::set<std::string>::const_iterator it = grids.begin(), eIt = grids.end(); it != eIt; ++it )
 	{
-		openvdb::GridBase::Ptr grid = file.readGridMetadata( *it );
-		const openvdb::Vec3i &min = grid->metaValue<openvdb::Vec3i>( openvdb::GridBase::META_FILE_BBOX_MIN );
-		const openvdb::Vec3i &max = grid->metaValue<openvdb::Vec3i>( openvdb::GridBase::META_FILE_BBOX_MAX );
-		result.expand( grid->transform().indexToWorld( openvdb::BBoxd( min - 0.5, max + 0.5 ) ) );
-
-		const openvdb::Vec3d voxelSize = grid->voxelSize();
-		autoStepSize = std::min( std::min( (double)autoStepSize, voxelSize.x() ), std::min( voxelSize.y(), voxelSize.z() ) );
+		FileMetadata::GridMap::const_iterator gIt = metadata->grids.find( *it );
+		if( gIt == metadata->grids.end() )
+		{
+			throw IECore::Exception( boost::str( boost::format( "File \"%s\" has no grid named \"%s\"" ) % fileName % *it ) );
+		}
+		if( !gIt->second.hasBound )
+		{
+			throw IECore::Exception( boost::str( boost::format( "Grid \"%s\" in file \"%s\" has no bounding box metadata" ) % *it % fileName ) );
+		}
+
+		result.expand( gIt->second.bound );
+		autoStepSize = std::min( autoStepSize, gIt->second.voxelSize );
 	}
 
 	return Box3f(
@@ -217,6 +297,18 @@ void ArnoldVDB::hashSource( const Gaffer::Context *context, IECore::MurmurHash &
 	h.append( context->getFramesPerSecond() );
 }
 
+bool ArnoldVDB::contextDependencies( const Gaffer::ValuePlug *output, const Gaffer::Context *context, std::vector<IECore::InternedString> &variables ) const
+{
+	if( !ObjectSource::contextDependencies( output, context, variables ) )
+	{
+		return false;
+	}
+
+	static IECore::InternedString g_framesPerSecond( "framesPerSecond" );
+	variables.push_back( g_framesPerSecond );
+	return true;
+}
+
 IECore::ConstObjectPtr ArnoldVDB::computeSource( const Context *context ) const
 {
 	IECore::ExternalProceduralPtr result = new ExternalProcedural( dsoPlug()->getValue() );
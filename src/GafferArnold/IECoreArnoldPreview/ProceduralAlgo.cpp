@@ -32,11 +32,17 @@
 //
 //////////////////////////////////////////////////////////////////////////
 
+#include <fstream>
+
 #include "IECore/SimpleTypedData.h"
 #include "IECore/Renderer.h"
+#include "IECore/Exception.h"
 
 #include "IECoreArnold/NodeAlgo.h"
 #include "IECoreArnold/ParameterAlgo.h"
+
+#include "GafferScene/ArchiveAlgo.h"
+
 #include "GafferArnold/Private/IECoreArnoldPreview/ProceduralAlgo.h"
 
 using namespace std;
@@ -54,6 +60,74 @@ namespace
 
 NodeAlgo::ConverterDescription<ExternalProcedural> g_description( ProceduralAlgo::convert );
 
+// Reads the metadata for an .ass file. The bound is taken from the
+// "### bounds:" header comment that exporters such as MtoA write, and
+// the node count from a scan of the top level blocks, which is much
+// cheaper than loading the file into Arnold.
+CompoundDataPtr readASSMetadata( const std::string &fileName )
+{
+	std::ifstream f( fileName.c_str() );
+	if( !f.good() )
+	{
+		throw IECore::IOException( "Unable to open \"" + fileName + "\"" );
+	}
+
+	CompoundDataPtr result = new CompoundData;
+
+	int nodeCount = 0;
+	int depth = 0;
+	bool quoted = false;
+	std::string line;
+	while( std::getline( f, line ) )
+	{
+		if( !quoted && line.size() && line[0] == '#' )
+		{
+			Box3f b;
+			if( sscanf( line.c_str(), "### bounds: %f %f %f %f %f %f", &b.min.x, &b.min.y, &b.min.z, &b.max.x, &b.max.y, &b.max.z ) == 6 )
+			{
+				result->writable()["bound"] = new Box3fData( b );
+			}
+			continue;
+		}
+
+		for( std::string::const_iterator it = line.begin(), eIt = line.end(); it != eIt; ++it )
+		{
+			if( *it == '"' )
+			{
+				quoted = !quoted;
+			}
+			else if( quoted )
+			{
+				continue;
+			}
+			else if( *it == '{' )
+			{
+				if( depth++ == 0 )
+				{
+					nodeCount++;
+				}
+			}
+			else if( *it == '}' )
+			{
+				depth = std::max( depth - 1, 0 );
+			}
+		}
+	}
+
+	result->writable()["nodeCount"] = new IntData( nodeCount );
+	return result;
+}
+
+struct ASSMetadataReaderRegistration
+{
+	ASSMetadataReaderRegistration()
+	{
+		GafferScene::ArchiveAlgo::registerMetadataReader( "ass", readASSMetadata );
+	}
+};
+
+ASSMetadataReaderRegistration g_assMetadataReaderRegistration;
+
 } // namespace
 
 //////////////////////////////////////////////////////////////////////////
@@ -80,10 +154,34 @@ AtNode *convert( const IECore::ExternalProcedural *procedural )
 	}
 	AtNode *node = AiNode( nodeType.c_str() );
 
+	/// \todo This is the natural place to support deferred expansion of
+	/// Gaffer subtrees, by emitting a procedural node whose DSO calls back
+	/// into a SceneProcedural lazily when Arnold first hits its bound. We
+	/// don't yet ship an Arnold DSO capable of hosting Gaffer though, so for
+	/// now ScriptProcedurals are only supported via this generic path.
+
 	AiNodeSetStr( node, "dso", procedural->getFileName().c_str() );
 	ParameterAlgo::setParameters( node, parameters );
 
-	const Box3f bound = procedural->bound();
+	Box3f bound = procedural->bound();
+	if( bound == Renderer::Procedural::noBound )
+	{
+		// Use the bound from the archive if we can get
+		// one cheaply, so that expansion can be deferred.
+		try
+		{
+			const Box3f archiveBound = GafferScene::ArchiveAlgo::bound( procedural->getFileName() );
+			if( !archiveBound.isEmpty() )
+			{
+				bound = archiveBound;
+			}
+		}
+		catch( ... )
+		{
+			// Arnold will report missing files itself.
+		}
+	}
+
 	if( bound != Renderer::Procedural::noBound )
 	{
 		AiNodeSetPnt( node, "min", bound.min.x, bound.min.y, bound.min.z );
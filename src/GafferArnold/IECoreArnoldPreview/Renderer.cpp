@@ -42,10 +42,14 @@
 #include <thread>
 #endif
 
+#include "tbb/atomic.h"
 #include "tbb/concurrent_vector.h"
+#include "tbb/concurrent_queue.h"
 #include "tbb/concurrent_unordered_map.h"
 
 #include "boost/make_shared.hpp"
+#include "boost/noncopyable.hpp"
+#include "boost/chrono.hpp"
 #include "boost/format.hpp"
 #include "boost/algorithm/string/predicate.hpp"
 #include "boost/algorithm/string/join.hpp"
@@ -69,6 +73,7 @@
 #include "IECoreArnold/UniverseBlock.h"
 
 #include "Gaffer/StringAlgo.h"
+#include "Gaffer/Private/IECorePreview/LRUCache.h"
 
 #include "GafferScene/Private/IECoreScenePreview/Renderer.h"
 
@@ -394,36 +399,68 @@ class ShaderCache : public IECore::RefCounted
 
 	public :
 
+		ShaderCache()
+		{
+			m_created = 0;
+			m_reused = 0;
+		}
+
 		// Can be called concurrently with other get() calls.
-		ArnoldShaderPtr get( const IECore::ObjectVector *shader )
+		ArnoldShaderPtr get( const IECore::ObjectVector *shader, IECore::MurmurHash &hash )
 		{
+			hash = shader->Object::hash();
 			Cache::accessor a;
-			m_cache.insert( a, shader->Object::hash() );
+			m_cache.insert( a, hash );
 			if( !a->second )
 			{
-				a->second = new ArnoldShader( shader, "shader:" + shader->Object::hash().toString() + ":" );
+				a->second = new ArnoldShader( shader, "shader:" + hash.toString() + ":" );
+				++m_created;
+			}
+			else
+			{
+				++m_reused;
 			}
 			return a->second;
 		}
 
-		// Must not be called concurrently with anything.
+		size_t numCreated() const
+		{
+			return m_created;
+		}
+
+		size_t numReused() const
+		{
+			return m_reused;
+		}
+
+		// Must be called when a client releases a shader
+		// obtained from get(), passing the hash that get()
+		// provided. Can be called concurrently with anything
+		// other than clearUnused().
+		void retire( const IECore::MurmurHash &hash )
+		{
+			m_retired.push( hash );
+		}
+
+		// Removes any retired shaders which are no longer in
+		// use. Only the retired shaders are visited, so the
+		// cost is proportional to the number of edits rather
+		// than to the size of the cache. Must not be called
+		// concurrently with anything.
 		void clearUnused()
 		{
-			vector<IECore::MurmurHash> toErase;
-			for( Cache::iterator it = m_cache.begin(), eIt = m_cache.end(); it != eIt; ++it )
+			IECore::MurmurHash hash;
+			while( m_retired.try_pop( hash ) )
 			{
-				if( it->second->refCount() == 1 )
+				Cache::accessor a;
+				if( m_cache.find( a, hash ) && a->second->refCount() == 1 )
 				{
 					// Only one reference - this is ours, so
 					// nothing outside of the cache is using the
 					// shader.
-					toErase.push_back( it->first );
+					m_cache.erase( a );
 				}
 			}
-			for( vector<IECore::MurmurHash>::const_iterator it = toErase.begin(), eIt = toErase.end(); it != eIt; ++it )
-			{
-				m_cache.erase( *it );
-			}
 		}
 
 	private :
@@ -431,6 +468,12 @@ class ShaderCache : public IECore::RefCounted
 		typedef tbb::concurrent_hash_map<IECore::MurmurHash, ArnoldShaderPtr> Cache;
 		Cache m_cache;
 
+		typedef tbb::concurrent_queue<IECore::MurmurHash> RetiredQueue;
+		RetiredQueue m_retired;
+
+		tbb::atomic<size_t> m_created;
+		tbb::atomic<size_t> m_reused;
+
 };
 
 IE_CORE_DECLAREPTR( ShaderCache )
@@ -491,7 +534,7 @@ class ArnoldAttributes : public IECoreScenePreview::Renderer::AttributesInterfac
 	public :
 
 		ArnoldAttributes( const IECore::CompoundObject *attributes, ShaderCache *shaderCache )
-			:	m_visibility( AI_RAY_ALL ), m_sidedness( AI_RAY_ALL ), m_shadingFlags( Default ), m_stepSize( 0.0f ), m_polyMesh( attributes ), m_displacement( attributes, shaderCache ), m_curves( attributes )
+			:	m_visibility( AI_RAY_ALL ), m_sidedness( AI_RAY_ALL ), m_shadingFlags( Default ), m_stepSize( 0.0f ), m_polyMesh( attributes ), m_displacement( attributes, shaderCache ), m_curves( attributes ), m_shaderCache( shaderCache )
 		{
 			updateVisibility( g_cameraVisibilityAttributeName, AI_RAY_CAMERA, attributes );
 			updateVisibility( g_shadowVisibilityAttributeName, AI_RAY_SHADOW, attributes );
@@ -516,7 +559,7 @@ class ArnoldAttributes : public IECoreScenePreview::Renderer::AttributesInterfac
 			surfaceShaderAttribute = surfaceShaderAttribute ? surfaceShaderAttribute : attribute<IECore::ObjectVector>( g_surfaceShaderAttributeName, attributes );
 			if( surfaceShaderAttribute )
 			{
-				m_surfaceShader = shaderCache->get( surfaceShaderAttribute );
+				m_surfaceShader = shaderCache->get( surfaceShaderAttribute, m_surfaceShaderHash );
 			}
 
 			m_lightShader = attribute<IECore::ObjectVector>( g_arnoldLightShaderAttributeName, attributes );
@@ -538,6 +581,18 @@ class ArnoldAttributes : public IECoreScenePreview::Renderer::AttributesInterfac
 			}
 		}
 
+		virtual ~ArnoldAttributes()
+		{
+			if( m_surfaceShader )
+			{
+				m_shaderCache->retire( m_surfaceShaderHash );
+			}
+			if( m_displacement.map )
+			{
+				m_shaderCache->retire( m_displacement.mapHash );
+			}
+		}
+
 		// Some attributes affect the geometric properties of a node, which means they
 		// go on the shape rather than the ginstance. These are problematic because they
 		// must be taken into account when determining the hash for instancing, and
@@ -834,7 +889,7 @@ class ArnoldAttributes : public IECoreScenePreview::Renderer::AttributesInterfac
 			{
 				if( const IECore::ObjectVector *mapAttribute = attribute<IECore::ObjectVector>( g_dispMapAttributeName, attributes ) )
 				{
-					map = shaderCache->get( mapAttribute );
+					map = shaderCache->get( mapAttribute, mapHash );
 				}
 				height = attributeValue<float>( g_dispHeightAttributeName, attributes, 1.0f );
 				padding = attributeValue<float>( g_dispPaddingAttributeName, attributes, 0.0f );
@@ -843,6 +898,7 @@ class ArnoldAttributes : public IECoreScenePreview::Renderer::AttributesInterfac
 			}
 
 			ArnoldShaderPtr map;
+			IECore::MurmurHash mapHash;
 			float height;
 			float padding;
 			float zeroValue;
@@ -1011,6 +1067,7 @@ class ArnoldAttributes : public IECoreScenePreview::Renderer::AttributesInterfac
 		unsigned char m_sidedness;
 		unsigned char m_shadingFlags;
 		ArnoldShaderPtr m_surfaceShader;
+		IECore::MurmurHash m_surfaceShaderHash;
 		IECore::ConstObjectVectorPtr m_lightShader;
 		IECore::ConstInternedStringVectorDataPtr m_traceSets;
 		float m_stepSize;
@@ -1018,6 +1075,10 @@ class ArnoldAttributes : public IECoreScenePreview::Renderer::AttributesInterfac
 		Displacement m_displacement;
 		Curves m_curves;
 
+		// Used to tell the cache when we no longer
+		// need our shaders.
+		ShaderCachePtr m_shaderCache;
+
 		typedef boost::container::flat_map<IECore::InternedString, IECore::ConstDataPtr> UserAttributes;
 		UserAttributes m_user;
 
@@ -1064,6 +1125,14 @@ class InstanceCache : public IECore::RefCounted
 
 	public :
 
+		InstanceCache()
+			:	m_objectHashCache( objectHashGetter, 1000 )
+		{
+			m_created = 0;
+			m_reused = 0;
+			m_uninstanced = 0;
+		}
+
 		// Can be called concurrently with other get() calls.
 		Instance get( const IECore::Object *object, const IECoreScenePreview::Renderer::AttributesInterface *attributes )
 		{
@@ -1071,10 +1140,11 @@ class InstanceCache : public IECore::RefCounted
 
 			if( !arnoldAttributes->canInstanceGeometry( object ) )
 			{
+				++m_uninstanced;
 				return Instance( convert( object, arnoldAttributes ), /* instanced = */ false );
 			}
 
-			IECore::MurmurHash h = object->hash();
+			IECore::MurmurHash h = objectHash( object );
 			arnoldAttributes->hashGeometry( object, h );
 
 			Cache::accessor a;
@@ -1087,9 +1157,14 @@ class InstanceCache : public IECore::RefCounted
 					std::string name = "instance:" + h.toString();
 					AiNodeSetStr( a->second.get(), "name", name.c_str() );
 				}
+				++m_created;
+			}
+			else
+			{
+				++m_reused;
 			}
 
-			return Instance( a->second, /* instanced = */ true );
+			return Instance( handout( a->second, h ), /* instanced = */ true );
 		}
 
 		Instance get( const std::vector<const IECore::Object *> &samples, const std::vector<float> &times, const IECoreScenePreview::Renderer::AttributesInterface *attributes )
@@ -1098,13 +1173,14 @@ class InstanceCache : public IECore::RefCounted
 
 			if( !arnoldAttributes->canInstanceGeometry( samples.front() ) )
 			{
+				++m_uninstanced;
 				return Instance( convert( samples, times, arnoldAttributes ), /* instanced = */ false );
 			}
 
 			IECore::MurmurHash h;
 			for( std::vector<const IECore::Object *>::const_iterator it = samples.begin(), eIt = samples.end(); it != eIt; ++it )
 			{
-				(*it)->hash( h );
+				h.append( objectHash( *it ) );
 			}
 			for( std::vector<float>::const_iterator it = times.begin(), eIt = times.end(); it != eIt; ++it )
 			{
@@ -1122,32 +1198,108 @@ class InstanceCache : public IECore::RefCounted
 					std::string name = "instance:" + h.toString();
 					AiNodeSetStr( a->second.get(), "name", name.c_str() );
 				}
+				++m_created;
+			}
+			else
+			{
+				++m_reused;
 			}
 
-			return Instance( a->second, /* instanced = */ true );
+			return Instance( handout( a->second, h ), /* instanced = */ true );
 		}
 
-		// Must not be called concurrently with anything.
+		// The number of instanceable nodes converted, and the number
+		// of times an existing one was shared instead.
+		size_t numCreated() const
+		{
+			return m_created;
+		}
+
+		size_t numReused() const
+		{
+			return m_reused;
+		}
+
+		// The number of nodes converted without instancing.
+		size_t numUninstanced() const
+		{
+			return m_uninstanced;
+		}
+
+		// Removes any retired nodes which are no longer in use.
+		// Only the retired nodes are visited, so the cost is
+		// proportional to the number of edits rather than to
+		// the size of the cache. Must not be called concurrently
+		// with anything.
 		void clearUnused()
 		{
-			vector<IECore::MurmurHash> toErase;
-			for( Cache::iterator it = m_cache.begin(), eIt = m_cache.end(); it != eIt; ++it )
+			IECore::MurmurHash hash;
+			while( m_retired.try_pop( hash ) )
 			{
-				if( it->second.unique() )
+				Cache::accessor a;
+				if( m_cache.find( a, hash ) && a->second.unique() )
 				{
 					// Only one reference - this is ours, so
 					// nothing outside of the cache is using the
 					// node.
-					toErase.push_back( it->first );
+					m_cache.erase( a );
 				}
 			}
-			for( vector<IECore::MurmurHash>::const_iterator it = toErase.begin(), eIt = toErase.end(); it != eIt; ++it )
+		}
+
+	private :
+
+		// Deleter used for the nodes we hand out. Rather than
+		// destroy anything, it keeps the cached node alive until
+		// the last client reference is released, and then marks
+		// the node as a candidate for removal in clearUnused().
+		struct Retirer
+		{
+
+			Retirer( InstanceCache *cache, const IECore::MurmurHash &hash, const boost::shared_ptr<AtNode> &node )
+				:	cache( cache ), hash( hash ), node( node )
+			{
+			}
+
+			void operator()( AtNode * )
+			{
+				cache->m_retired.push( hash );
+			}
+
+			boost::intrusive_ptr<InstanceCache> cache;
+			IECore::MurmurHash hash;
+			boost::shared_ptr<AtNode> node;
+
+		};
+
+		boost::shared_ptr<AtNode> handout( const boost::shared_ptr<AtNode> &node, const IECore::MurmurHash &hash )
+		{
+			if( !node )
 			{
-				m_cache.erase( *it );
+				return node;
 			}
+			return boost::shared_ptr<AtNode>( node.get(), Retirer( this, hash, node ) );
 		}
 
-	private :
+		// Duplicate, and any other node which generates copies of
+		// a location, provides us with the very same object for each
+		// copy, because the object is shared via Gaffer's compute cache.
+		// Hashing a large object is expensive, so we remember the hashes
+		// of recently seen objects by address. Each entry holds a reference
+		// to its object so that the address can't be reused while the
+		// entry exists.
+		IECore::MurmurHash objectHash( const IECore::Object *object )
+		{
+			return m_objectHashCache.get( object ).second;
+		}
+
+		typedef std::pair<IECore::ConstObjectPtr, IECore::MurmurHash> ObjectHash;
+
+		static ObjectHash objectHashGetter( const IECore::Object *object, size_t &cost )
+		{
+			cost = 1;
+			return ObjectHash( object, object->hash() );
+		}
 
 		boost::shared_ptr<AtNode> convert( const IECore::Object *object, const ArnoldAttributes *attributes )
 		{
@@ -1202,6 +1354,16 @@ class InstanceCache : public IECore::RefCounted
 		typedef tbb::concurrent_hash_map<IECore::MurmurHash, boost::shared_ptr<AtNode> > Cache;
 		Cache m_cache;
 
+		typedef IECorePreview::LRUCache<const IECore::Object *, ObjectHash> ObjectHashCache;
+		ObjectHashCache m_objectHashCache;
+
+		tbb::atomic<size_t> m_created;
+		tbb::atomic<size_t> m_reused;
+		tbb::atomic<size_t> m_uninstanced;
+
+		typedef tbb::concurrent_queue<IECore::MurmurHash> RetiredQueue;
+		RetiredQueue m_retired;
+
 };
 
 IE_CORE_DECLAREPTR( InstanceCache )
@@ -1272,14 +1434,11 @@ class ArnoldObject : public IECoreScenePreview::Renderer::ObjectInterface
 
 		void applyTransform( AtNode *node, const std::vector<Imath::M44f> &samples, const std::vector<float> &times )
 		{
+			// M44f has the same memory layout as AtMatrix, so we can
+			// convert the samples in bulk rather than element by element.
 			const size_t numSamples = samples.size();
-			AtArray *timesArray = AiArrayAllocate( samples.size(), 1, AI_TYPE_FLOAT );
-			AtArray *matricesArray = AiArrayAllocate( 1, numSamples, AI_TYPE_MATRIX );
-			for( size_t i = 0; i < numSamples; ++i )
-			{
-				AiArraySetFlt( timesArray, i, times[i] );
-				AiArraySetMtx( matricesArray, i, const_cast<float (*)[4]>( samples[i].x ) );
-			}
+			AtArray *timesArray = AiArrayConvert( numSamples, 1, AI_TYPE_FLOAT, &times[0] );
+			AtArray *matricesArray = AiArrayConvert( 1, numSamples, AI_TYPE_MATRIX, samples[0].getValue() );
 			AiNodeSetArray( node, "matrix", matricesArray );
 			if( AiNodeEntryLookUpParameter( AiNodeGetNodeEntry( node ), "transform_time_samples" ) )
 			{
@@ -1439,6 +1598,32 @@ std::string g_consoleFlagsOptionPrefix( "ai:console:" );
 const int g_logFlagsDefault = AI_LOG_ALL;
 const int g_consoleFlagsDefault = AI_LOG_WARNINGS | AI_LOG_ERRORS | AI_LOG_TIMESTAMP | AI_LOG_BACKTRACE | AI_LOG_MEMORY | AI_LOG_COLOR;
 
+// Adds the time spent in its scope to a nanosecond counter
+// shared between threads.
+class TranslationTimer : boost::noncopyable
+{
+
+	public :
+
+		TranslationTimer( tbb::atomic<boost::uint64_t> &nanoseconds )
+			:	m_nanoseconds( nanoseconds ), m_start( boost::chrono::high_resolution_clock::now() )
+		{
+		}
+
+		~TranslationTimer()
+		{
+			m_nanoseconds += boost::chrono::duration_cast<boost::chrono::nanoseconds>(
+				boost::chrono::high_resolution_clock::now() - m_start
+			).count();
+		}
+
+	private :
+
+		tbb::atomic<boost::uint64_t> &m_nanoseconds;
+		boost::chrono::high_resolution_clock::time_point m_start;
+
+};
+
 class ArnoldRenderer : public IECoreScenePreview::Renderer
 {
 
@@ -1453,6 +1638,11 @@ class ArnoldRenderer : public IECoreScenePreview::Renderer
 				m_consoleFlags( g_consoleFlagsDefault ),
 				m_assFileName( fileName )
 		{
+			m_numCameras = 0;
+			m_numLights = 0;
+			m_numObjects = 0;
+			m_translationTime = 0;
+
 			AiMsgSetLogFileFlags( m_logFileFlags );
 			AiMsgSetConsoleFlags( m_consoleFlags );
 			// Get OSL shaders onto the shader searchpath.
@@ -1673,6 +1863,9 @@ class ArnoldRenderer : public IECoreScenePreview::Renderer
 
 		virtual ObjectInterfacePtr camera( const std::string &name, const IECore::Camera *camera, const AttributesInterface *attributes )
 		{
+			TranslationTimer timer( m_translationTime );
+			++m_numCameras;
+
 			IECore::CameraPtr cameraCopy = camera->copy();
 			cameraCopy->addStandardParameters();
 			m_cameras[name] = cameraCopy;
@@ -1690,6 +1883,9 @@ class ArnoldRenderer : public IECoreScenePreview::Renderer
 
 		virtual ObjectInterfacePtr light( const std::string &name, const IECore::Object *object, const AttributesInterface *attributes )
 		{
+			TranslationTimer timer( m_translationTime );
+			++m_numLights;
+
 			Instance instance = m_instanceCache->get( object, attributes );
 			if( AtNode *node = instance.node() )
 			{
@@ -1703,6 +1899,9 @@ class ArnoldRenderer : public IECoreScenePreview::Renderer
 
 		virtual Renderer::ObjectInterfacePtr object( const std::string &name, const IECore::Object *object, const AttributesInterface *attributes )
 		{
+			TranslationTimer timer( m_translationTime );
+			++m_numObjects;
+
 			Instance instance = m_instanceCache->get( object, attributes );
 			if( AtNode *node = instance.node() )
 			{
@@ -1716,6 +1915,9 @@ class ArnoldRenderer : public IECoreScenePreview::Renderer
 
 		virtual ObjectInterfacePtr object( const std::string &name, const std::vector<const IECore::Object *> &samples, const std::vector<float> &times, const AttributesInterface *attributes )
 		{
+			TranslationTimer timer( m_translationTime );
+			++m_numObjects;
+
 			Instance instance = m_instanceCache->get( samples, times, attributes );
 			if( AtNode *node = instance.node() )
 			{
@@ -1746,6 +1948,13 @@ class ArnoldRenderer : public IECoreScenePreview::Renderer
 					AiRender( AI_RENDER_MODE_CAMERA );
 					break;
 				case SceneDescription :
+					/// \todo AiASSWrite() serialises the whole universe in one
+					/// go, on a single thread, after everything has been built.
+					/// Arnold provides no incremental writing API, so streaming
+					/// export would require us to generate the .ass text ourselves,
+					/// writing nodes as they are created and compressing on worker
+					/// threads. Until then, a ".ass.gz" filename at least gets
+					/// compressed output from Arnold directly.
 					AiASSWrite( m_assFileName.c_str(), AI_NODE_ALL );
 					break;
 				case Interactive :
@@ -1755,6 +1964,22 @@ class ArnoldRenderer : public IECoreScenePreview::Renderer
 			}
 		}
 
+		virtual IECore::CompoundDataPtr statistics() const
+		{
+			IECore::CompoundDataPtr result = new IECore::CompoundData;
+			IECore::CompoundDataMap &m = result->writable();
+			m["cameras"] = new IECore::UInt64Data( m_numCameras );
+			m["lights"] = new IECore::UInt64Data( m_numLights );
+			m["objects"] = new IECore::UInt64Data( m_numObjects );
+			m["instancesCreated"] = new IECore::UInt64Data( m_instanceCache->numCreated() );
+			m["instancesReused"] = new IECore::UInt64Data( m_instanceCache->numReused() );
+			m["uninstancedObjects"] = new IECore::UInt64Data( m_instanceCache->numUninstanced() );
+			m["shadersCreated"] = new IECore::UInt64Data( m_shaderCache->numCreated() );
+			m["shadersReused"] = new IECore::UInt64Data( m_shaderCache->numReused() );
+			m["translationTime"] = new IECore::DoubleData( m_translationTime / 1e9 );
+			return result;
+		}
+
 		virtual void pause()
 		{
 			if( AiRendering() )
@@ -2009,6 +2234,11 @@ class ArnoldRenderer : public IECoreScenePreview::Renderer
 		ShaderCachePtr m_shaderCache;
 		InstanceCachePtr m_instanceCache;
 
+		tbb::atomic<size_t> m_numCameras;
+		tbb::atomic<size_t> m_numLights;
+		tbb::atomic<size_t> m_numObjects;
+		tbb::atomic<boost::uint64_t> m_translationTime; // Nanoseconds, summed over all threads
+
 		int m_logFileFlags;
 		int m_consoleFlags;
 		boost::optional<int> m_frame;
@@ -37,6 +37,8 @@
 #include "boost/python.hpp"
 #include "boost/lexical_cast.hpp"
 
+#include "IECore/VectorTypedData.h"
+
 #include "Gaffer/Animation.h"
 
 #include "GafferBindings/DependencyNodeBinding.h"
@@ -75,6 +77,17 @@ std::string keyRepr( const Animation::Key &k )
 	);
 };
 
+IECore::FloatVectorDataPtr evaluate( const Animation::CurvePlug &curve, const IECore::FloatVectorData *times )
+{
+	IECore::FloatVectorDataPtr result = new IECore::FloatVectorData;
+	result->writable().resize( times->readable().size() );
+	if( !result->readable().empty() )
+	{
+		curve.evaluate( &times->readable()[0], &result->writable()[0], times->readable().size() );
+	}
+	return result;
+}
+
 class CurvePlugSerialiser : public ValuePlugSerialiser
 {
 
@@ -85,7 +98,7 @@ class CurvePlugSerialiser : public ValuePlugSerialiser
 			std::string result = ValuePlugSerialiser::postConstructor( graphComponent, identifier, serialisation );
 			const Animation::CurvePlug *curve = static_cast<const Animation::CurvePlug *>( graphComponent );
 
-			for( std::set<Animation::Key>::const_iterator it = curve->keys().begin(), eIt = curve->keys().end(); it != eIt; ++it )
+			for( Animation::CurvePlug::Keys::const_iterator it = curve->keys().begin(), eIt = curve->keys().end(); it != eIt; ++it )
 			{
 				result += identifier + ".addKey( " + keyRepr( *it ) + " )\n";
 			}
@@ -150,7 +163,8 @@ void GafferBindings::bindAnimation()
 		.def( "closestKey", &Animation::CurvePlug::closestKey )
 		.def( "previousKey", &Animation::CurvePlug::previousKey )
 		.def( "nextKey", &Animation::CurvePlug::nextKey )
-		.def( "evaluate", &Animation::CurvePlug::evaluate )
+		.def( "evaluate", (float (Animation::CurvePlug::*)( float ) const)&Animation::CurvePlug::evaluate )
+		.def( "evaluate", &evaluate )
 		// Adjusting the name so that it correctly reflects
 		// the nesting, and can be used by the PlugSerialiser.
 		.attr( "__name__" ) = "Animation.CurvePlug"
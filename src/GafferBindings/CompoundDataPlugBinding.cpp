@@ -138,6 +138,19 @@ void fillCompoundObject( const CompoundDataPlug &p, IECore::CompoundObject *o )
 	p.fillCompoundObject( o->members() );
 }
 
+// We copy by default for the same reasons as TypedObjectPlug::getValue(),
+// since the result may be shared with subsequent calls.
+IECore::CompoundDataPtr compoundData( const CompoundDataPlug &p, bool copy )
+{
+	IECorePython::ScopedGILRelease gilRelease;
+	IECore::ConstCompoundDataPtr d = p.compoundData();
+	if( copy )
+	{
+		return d->copy();
+	}
+	return boost::const_pointer_cast<IECore::CompoundData>( d );
+}
+
 class MemberPlugSerialiser : public ValuePlugSerialiser
 {
 
@@ -180,6 +193,7 @@ void GafferBindings::bindCompoundDataPlug()
 		.def( "memberDataAndName", &memberDataAndNameWrapper )
 		.def( "fillCompoundData", &fillCompoundData )
 		.def( "fillCompoundObject", &fillCompoundObject )
+		.def( "compoundData", &compoundData, ( arg_( "_copy" ) = true ) )
 	;
 
 	PlugClass<CompoundDataPlug::MemberPlug>()
@@ -150,6 +150,13 @@ ContextPtr current()
 
 void GafferBindings::bindContext()
 {
+	class_<Canceller, boost::noncopyable>( "Canceller" )
+		.def( "cancel", &Canceller::cancel )
+		.def( "cancelled", &Canceller::cancelled )
+		.def( "check", &Canceller::check )
+		.staticmethod( "check" )
+	;
+
 	IECorePython::RefCountedClass<Context, IECore::RefCounted> contextClass( "Context" );
 	scope s = contextClass;
 
@@ -171,6 +178,12 @@ void GafferBindings::bindContext()
 	contextClass
 		.def( init<>() )
 		.def( init<const Context &, Context::Ownership>( ( arg( "other" ), arg( "ownership" ) = Context::Copied ) ) )
+		.def(
+			init<const Context &, const Canceller &, Context::Ownership>(
+				( arg( "other" ), arg( "canceller" ), arg( "ownership" ) = Context::Copied )
+			)[ with_custodian_and_ward<1, 3>() ]
+		)
+		.def( "canceller", &Context::canceller, return_value_policy<reference_existing_object>() )
 		.def( "setFrame", &setFrame )
 		.def( "getFrame", &Context::getFrame )
 		.def( "setFramesPerSecond", &setFramesPerSecond )
@@ -208,7 +221,7 @@ void GafferBindings::bindContext()
 		.def( "hash", &Context::hash )
 		.def( self == self )
 		.def( self != self )
-		.def( "substitute", &Context::substitute, ( arg( "input" ), arg( "substitutions" ) = Context::AllSubstitutions ) )
+		.def( "substitute", (std::string (Context::*)( const std::string &, unsigned ) const)&Context::substitute, ( arg( "input" ), arg( "substitutions" ) = Context::AllSubstitutions ) )
 		.def( "substitutions", &Context::substitutions ).staticmethod( "substitutions" )
 		.def( "hasSubstitutions", &Context::hasSubstitutions ).staticmethod( "hasSubstitutions" )
 		.def( "current", &current ).staticmethod( "current" )
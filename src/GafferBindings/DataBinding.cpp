@@ -37,6 +37,7 @@
 #include "boost/python.hpp"
 
 #include "IECore/DespatchTypedData.h"
+#include "IECore/TypeTraits.h"
 
 #include "GafferBindings/DataBinding.h"
 
@@ -83,6 +84,65 @@ boost::python::object dataToPythonInternal( IECore::Data *data, bool copy, boost
 	}
 }
 
+// Format characters as used by the `struct` module and PEP 3118.
+template<typename T>
+const char *bufferFormat();
+
+template<> const char *bufferFormat<char>() { return "b"; }
+template<> const char *bufferFormat<unsigned char>() { return "B"; }
+template<> const char *bufferFormat<short>() { return "h"; }
+template<> const char *bufferFormat<unsigned short>() { return "H"; }
+template<> const char *bufferFormat<int>() { return "i"; }
+template<> const char *bufferFormat<unsigned int>() { return "I"; }
+template<> const char *bufferFormat<int64_t>() { return "q"; }
+template<> const char *bufferFormat<uint64_t>() { return "Q"; }
+template<> const char *bufferFormat<half>() { return "e"; }
+template<> const char *bufferFormat<float>() { return "f"; }
+template<> const char *bufferFormat<double>() { return "d"; }
+
+struct BufferGetter
+{
+	typedef object ReturnType;
+
+	template<typename T>
+	object operator()( const T *data )
+	{
+		typedef typename T::BaseType BaseType;
+
+		// The Python wrapper owns a reference to the data,
+		// and the buffer owns a reference to the wrapper.
+		object owner( DataPtr( const_cast<T *>( data ) ) );
+
+		Py_buffer buffer;
+		if( PyBuffer_FillInfo(
+			&buffer, owner.ptr(),
+			const_cast<BaseType *>( data->baseReadable() ), data->baseSize() * sizeof( BaseType ),
+			/* readonly = */ 1, PyBUF_FULL_RO
+		) == -1 )
+		{
+			throw_error_already_set();
+		}
+
+		buffer.format = const_cast<char *>( bufferFormat<BaseType>() );
+		buffer.itemsize = sizeof( BaseType );
+		buffer.ndim = 1;
+		buffer.smalltable[0] = data->baseSize();
+		buffer.smalltable[1] = sizeof( BaseType );
+		buffer.shape = &buffer.smalltable[0];
+		buffer.strides = &buffer.smalltable[1];
+
+		// The memoryview copies the shape and strides for
+		// one dimensional buffers, and takes over the reference
+		// to the owner made by PyBuffer_FillInfo().
+		return object( handle<>( PyMemoryView_FromBuffer( &buffer ) ) );
+	}
+};
+
+object dataBuffer( const IECore::Data *data )
+{
+	return GafferBindings::dataToBuffer( data );
+}
+
 } // namespace
 
 namespace GafferBindings
@@ -98,4 +158,30 @@ boost::python::object dataToPython( const IECore::Data *data, bool copy, boost::
 	return dataToPythonInternal( const_cast<Data *>( data ), copy, nullValue );
 }
 
+boost::python::object dataToBuffer( const IECore::Data *data )
+{
+	if( !data )
+	{
+		PyErr_SetString( PyExc_ValueError, "Data must not be None" );
+		throw_error_already_set();
+	}
+
+	try
+	{
+		return despatchTypedData<BufferGetter, TypeTraits::IsNumericBasedVectorTypedData>( const_cast<Data *>( data ) );
+	}
+	catch( const InvalidArgumentException &e )
+	{
+		PyErr_SetString( PyExc_TypeError, ( std::string( "Unsupported data type \"" ) + data->typeName() + "\"" ).c_str() );
+		throw_error_already_set();
+	}
+
+	return object(); // Unreachable
+}
+
+void bindData()
+{
+	def( "dataBuffer", &dataBuffer );
+}
+
 } // namespace GafferBindings
@@ -42,6 +42,8 @@
 
 #include "Gaffer/Expression.h"
 #include "Gaffer/StringPlug.h"
+#include "Gaffer/Context.h"
+#include "Gaffer/Private/IECorePreview/LRUCache.h"
 
 #include "GafferBindings/DependencyNodeBinding.h"
 #include "GafferBindings/ExpressionBinding.h"
@@ -104,12 +106,29 @@ struct ExpressionChangedSlotCaller
 	}
 };
 
+// Cache of results for expressions which depend only on
+// context variables, keyed by the hash of those variables.
+typedef IECorePreview::LRUCache<IECore::MurmurHash, IECore::ConstObjectVectorPtr> ResultCache;
+
+IECore::ConstObjectVectorPtr resultCacheGetter( const IECore::MurmurHash &h, size_t &cost )
+{
+	// We only ever use getIfCached() and setIfUncached(), because
+	// the python execution must not happen while the cache holds
+	// a lock.
+	throw IECore::Exception( "Unexpected call to resultCacheGetter" );
+}
+
+size_t resultCacheCost( const IECore::ConstObjectVectorPtr &value )
+{
+	return 1;
+}
+
 class EngineWrapper : public IECorePython::RefCountedWrapper<Expression::Engine>
 {
 	public :
 
 		EngineWrapper( PyObject *self )
-				:	IECorePython::RefCountedWrapper<Expression::Engine>( self )
+				:	IECorePython::RefCountedWrapper<Expression::Engine>( self ), m_contextOnly( false ), m_resultCache( resultCacheGetter, 10000 )
 		{
 		}
 
@@ -129,6 +148,10 @@ class EngineWrapper : public IECorePython::RefCountedWrapper<Expression::Engine>
 						container_utils::extend_container( inputs, pythonInputs );
 						container_utils::extend_container( outputs, pythonOutputs );
 						container_utils::extend_container( contextVariables, pythonContextVariables );
+
+						m_contextOnly = inputs.empty();
+						m_contextVariables = contextVariables;
+						m_resultCache.clear();
 						return;
 					}
 				}
@@ -142,6 +165,43 @@ class EngineWrapper : public IECorePython::RefCountedWrapper<Expression::Engine>
 		}
 
 		virtual IECore::ConstObjectVectorPtr execute( const Context *context, const std::vector<const ValuePlug *> &proxyInputs ) const
+		{
+			// Expressions which read no plugs produce results which depend only
+			// on the context variables they read. These are typically evaluated
+			// over and over in many contexts (per location, per tile) that share
+			// the relevant variables, so we cache them here, where a hit doesn't
+			// need to acquire the GIL at all.
+			IECore::MurmurHash contextHash;
+			if( m_contextOnly )
+			{
+				for( std::vector<IECore::InternedString>::const_iterator it = m_contextVariables.begin(), eIt = m_contextVariables.end(); it != eIt; ++it )
+				{
+					const IECore::Data *d = context->get<IECore::Data>( *it, NULL );
+					if( d )
+					{
+						d->hash( contextHash );
+					}
+					else
+					{
+						contextHash.append( 0 );
+					}
+				}
+
+				if( boost::optional<IECore::ConstObjectVectorPtr> cached = m_resultCache.getIfCached( contextHash ) )
+				{
+					return *cached;
+				}
+			}
+
+			IECore::ConstObjectVectorPtr result = executeInternal( context, proxyInputs );
+			if( m_contextOnly )
+			{
+				m_resultCache.setIfUncached( contextHash, result, resultCacheCost );
+			}
+			return result;
+		}
+
+		IECore::ConstObjectVectorPtr executeInternal( const Context *context, const std::vector<const ValuePlug *> &proxyInputs ) const
 		{
 			if( isSubclassed() )
 			{
@@ -290,6 +350,12 @@ class EngineWrapper : public IECorePython::RefCountedWrapper<Expression::Engine>
 			return boost::python::tuple( l );
 		}
 
+	private :
+
+		bool m_contextOnly;
+		std::vector<IECore::InternedString> m_contextVariables;
+		mutable ResultCache m_resultCache;
+
 };
 
 static tuple languages()
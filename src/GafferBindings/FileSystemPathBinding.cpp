@@ -79,6 +79,7 @@ void GafferBindings::bindFileSystemPath()
 		.def( "getIncludeSequences", &FileSystemPath::getIncludeSequences )
 		.def( "setIncludeSequences", &FileSystemPath::setIncludeSequences )
 		.def( "isFileSequence", &FileSystemPath::isFileSequence )
+		.def( "isSequentialFile", &FileSystemPath::isSequentialFile )
 		.def( "fileSequence", &FileSystemPath::fileSequence )
 		.def( "createStandardFilter", &createStandardFilter, (
 				arg( "extensions" ) = list(),
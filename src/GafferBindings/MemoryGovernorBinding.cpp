@@ -0,0 +1,134 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2017, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//      * Redistributions of source code must retain the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer.
+//
+//      * Redistributions in binary form must reproduce the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer in the documentation and/or other materials provided with
+//        the distribution.
+//
+//      * Neither the name of John Haddon nor the names of
+//        any other contributors to this software may be used to endorse or
+//        promote products derived from this software without specific prior
+//        written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#include "boost/python.hpp"
+
+#include "IECorePython/ScopedGILLock.h"
+
+#include "Gaffer/MemoryGovernor.h"
+
+#include "GafferBindings/MemoryGovernorBinding.h"
+
+using namespace boost::python;
+using namespace Gaffer;
+using namespace GafferBindings;
+
+namespace
+{
+
+struct PythonUsageFunction
+{
+	PythonUsageFunction( object fn )
+		:	m_fn( fn )
+	{
+	}
+
+	size_t operator()()
+	{
+		IECorePython::ScopedGILLock gilLock;
+		return extract<size_t>( m_fn() );
+	}
+
+	private :
+
+		object m_fn;
+
+};
+
+struct PythonSetLimitFunction
+{
+	PythonSetLimitFunction( object fn )
+		:	m_fn( fn )
+	{
+	}
+
+	void operator()( size_t bytes )
+	{
+		IECorePython::ScopedGILLock gilLock;
+		m_fn( bytes );
+	}
+
+	private :
+
+		object m_fn;
+
+};
+
+void registerCache( const std::string &name, object usage, object setLimit, float priority )
+{
+	MemoryGovernor::registerCache( name, PythonUsageFunction( usage ), PythonSetLimitFunction( setLimit ), priority );
+}
+
+list registeredCaches()
+{
+	const std::vector<std::string> names = MemoryGovernor::registeredCaches();
+	list result;
+	for( std::vector<std::string>::const_iterator it = names.begin(), eIt = names.end(); it != eIt; ++it )
+	{
+		result.append( *it );
+	}
+	return result;
+}
+
+} // namespace
+
+void GafferBindings::bindMemoryGovernor()
+{
+	class_<MemoryGovernor>( "MemoryGovernor", no_init )
+		.def( "registerCache", &registerCache, ( arg( "name" ), arg( "usage" ), arg( "setLimit" ), arg( "priority" ) = 1.0f ) )
+		.staticmethod( "registerCache" )
+		.def( "deregisterCache", &MemoryGovernor::deregisterCache )
+		.staticmethod( "deregisterCache" )
+		.def( "registeredCaches", &registeredCaches )
+		.staticmethod( "registeredCaches" )
+		.def( "setPriority", &MemoryGovernor::setPriority )
+		.staticmethod( "setPriority" )
+		.def( "getPriority", &MemoryGovernor::getPriority )
+		.staticmethod( "getPriority" )
+		.def( "setMemoryLimit", &MemoryGovernor::setMemoryLimit )
+		.staticmethod( "setMemoryLimit" )
+		.def( "getMemoryLimit", &MemoryGovernor::getMemoryLimit )
+		.staticmethod( "getMemoryLimit" )
+		.def( "update", &MemoryGovernor::update )
+		.staticmethod( "update" )
+		.def( "cacheMemoryUsage", &MemoryGovernor::cacheMemoryUsage )
+		.staticmethod( "cacheMemoryUsage" )
+		.def( "cacheMemoryLimit", &MemoryGovernor::cacheMemoryLimit )
+		.staticmethod( "cacheMemoryLimit" )
+		.def( "processMemoryUsage", &MemoryGovernor::processMemoryUsage )
+		.staticmethod( "processMemoryUsage" )
+	;
+}
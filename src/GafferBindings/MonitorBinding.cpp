@@ -35,13 +35,16 @@
 //////////////////////////////////////////////////////////////////////////
 
 #include "boost/python.hpp"
+#include "boost/python/suite/indexing/container_utils.hpp"
 #include "boost/format.hpp"
 
 #include "Gaffer/Monitor.h"
 #include "Gaffer/PerformanceMonitor.h"
 #include "Gaffer/ContextMonitor.h"
+#include "Gaffer/HotspotMonitor.h"
 #include "Gaffer/MonitorAlgo.h"
 #include "Gaffer/Plug.h"
+#include "Gaffer/Node.h"
 
 #include "GafferBindings/MonitorBinding.h"
 
@@ -66,11 +69,16 @@ void exitScope( Monitor &m, object type, object value, object traceBack )
 std::string repr( PerformanceMonitor::Statistics &s )
 {
 	return boost::str(
-		boost::format( "Gaffer.PerformanceMonitor.Statistics( hashCount = %d, computeCount = %d, hashDuration = %d, computeDuration = %d )" )
+		boost::format( "Gaffer.PerformanceMonitor.Statistics( hashCount = %d, computeCount = %d, hashDuration = %d, computeDuration = %d, hashCacheHits = %d, computeCacheHits = %d, computeCacheMisses = %d, cacheBytesStored = %d, bytesAllocated = %d )" )
 			% s.hashCount
 			% s.computeCount
 			% s.hashDuration.count()
 			% s.computeDuration.count()
+			% s.hashCacheHits
+			% s.computeCacheHits
+			% s.computeCacheMisses
+			% s.cacheBytesStored
+			% s.bytesAllocated
 	);
 }
 
@@ -78,10 +86,19 @@ PerformanceMonitor::Statistics *statisticsConstructor(
 	size_t hashCount,
 	size_t computeCount,
 	boost::chrono::nanoseconds::rep hashDuration,
-	boost::chrono::nanoseconds::rep computeDuration
+	boost::chrono::nanoseconds::rep computeDuration,
+	size_t hashCacheHits,
+	size_t computeCacheHits,
+	size_t computeCacheMisses,
+	size_t cacheBytesStored,
+	size_t bytesAllocated
 )
 {
-	return new PerformanceMonitor::Statistics( hashCount, computeCount, boost::chrono::nanoseconds( hashDuration ), boost::chrono::nanoseconds( computeDuration ) );
+	return new PerformanceMonitor::Statistics(
+		hashCount, computeCount, boost::chrono::nanoseconds( hashDuration ), boost::chrono::nanoseconds( computeDuration ),
+		hashCacheHits, computeCacheHits, computeCacheMisses, cacheBytesStored,
+		bytesAllocated
+	);
 }
 
 boost::chrono::nanoseconds::rep getHashDuration( PerformanceMonitor::Statistics &s )
@@ -116,6 +133,17 @@ dict allStatistics( T &m )
 	return result;
 }
 
+dict allNodeStatistics( PerformanceMonitor &m )
+{
+	dict result;
+	const PerformanceMonitor::NodeStatisticsMap &s = m.allNodeStatistics();
+	for( PerformanceMonitor::NodeStatisticsMap::const_iterator it = s.begin(), eIt = s.end(); it != eIt; ++it )
+	{
+		result[boost::const_pointer_cast<Node>( it->first)] = it->second;
+	}
+	return result;
+}
+
 list contextMonitorVariableNames( const ContextMonitor::Statistics &s )
 {
 	std::vector<IECore::InternedString> names = s.variableNames();
@@ -127,6 +155,50 @@ list contextMonitorVariableNames( const ContextMonitor::Statistics &s )
 	return result;
 }
 
+HotspotMonitor *hotspotMonitorConstructor( object pythonVariableNames, size_t maxHotspots )
+{
+	std::vector<std::string> names;
+	boost::python::container_utils::extend_container( names, pythonVariableNames );
+	std::vector<IECore::InternedString> variableNames( names.begin(), names.end() );
+	return new HotspotMonitor( variableNames, maxHotspots );
+}
+
+list hotspotMonitorVariableNames( const HotspotMonitor &m )
+{
+	list result;
+	for( std::vector<IECore::InternedString>::const_iterator it = m.variableNames().begin(), eIt = m.variableNames().end(); it != eIt; ++it )
+	{
+		result.append( it->c_str() );
+	}
+	return result;
+}
+
+list hotspots( const HotspotMonitor &m )
+{
+	const HotspotMonitor::Hotspots &h = m.hotspots();
+	list result;
+	for( HotspotMonitor::Hotspots::const_iterator it = h.begin(), eIt = h.end(); it != eIt; ++it )
+	{
+		result.append( *it );
+	}
+	return result;
+}
+
+PlugPtr hotspotPlug( const HotspotMonitor::Hotspot &h )
+{
+	return boost::const_pointer_cast<Plug>( h.plug );
+}
+
+IECore::CompoundDataPtr hotspotVariables( const HotspotMonitor::Hotspot &h )
+{
+	return h.variables ? h.variables->copy() : IECore::CompoundDataPtr();
+}
+
+boost::chrono::nanoseconds::rep hotspotDuration( const HotspotMonitor::Hotspot &h )
+{
+	return h.duration.count();
+}
+
 } // namespace
 
 void GafferBindings::bindMonitor()
@@ -147,6 +219,10 @@ void GafferBindings::bindMonitor()
 			.value( "HashCount", HashCount )
 			.value( "ComputeCount", ComputeCount )
 			.value( "HashesPerCompute", HashesPerCompute )
+			.value( "HashCacheHitRate", HashCacheHitRate )
+			.value( "ComputeCacheHitRate", ComputeCacheHitRate )
+			.value( "CacheBytesStored", CacheBytesStored )
+			.value( "BytesAllocated", BytesAllocated )
 		;
 
 		def(
@@ -167,6 +243,25 @@ void GafferBindings::bindMonitor()
 				arg( "maxLines" ) = 50
 			)
 		);
+
+		def(
+			"formatNodeStatistics",
+			( std::string (*)( const PerformanceMonitor &, size_t ) )&formatNodeStatistics,
+			(
+				arg( "monitor" ),
+				arg( "maxLinesPerMetric" ) = 50
+			)
+		);
+
+		def(
+			"formatNodeStatistics",
+			( std::string (*)( const PerformanceMonitor &, PerformanceMetric, size_t ) )&formatNodeStatistics,
+			(
+				arg( "monitor" ),
+				arg( "metric" ),
+				arg( "maxLines" ) = 50
+			)
+		);
 	}
 
 	class_<Monitor, boost::noncopyable>( "Monitor", no_init )
@@ -180,6 +275,11 @@ void GafferBindings::bindMonitor()
 		scope s = class_<PerformanceMonitor, bases<Monitor>, boost::noncopyable >( "PerformanceMonitor" )
 			.def( "allStatistics", &allStatistics<PerformanceMonitor> )
 			.def( "plugStatistics", &PerformanceMonitor::plugStatistics, return_value_policy<copy_const_reference>() )
+			.def( "allNodeStatistics", &allNodeStatistics )
+			.def( "nodeStatistics", &PerformanceMonitor::nodeStatistics, return_value_policy<copy_const_reference>() )
+			.def( "setTimelineEnabled", &PerformanceMonitor::setTimelineEnabled )
+			.def( "getTimelineEnabled", &PerformanceMonitor::getTimelineEnabled )
+			.def( "writeTimeline", &PerformanceMonitor::writeTimeline )
 		;
 
 		class_<PerformanceMonitor::Statistics>( "Statistics" )
@@ -188,7 +288,12 @@ void GafferBindings::bindMonitor()
 						arg( "hashCount" ) = 0,
 						arg( "computeCount" ) = 0,
 						arg( "hashDuration" ) = 0,
-						arg( "computeDuration" ) = 0
+						arg( "computeDuration" ) = 0,
+						arg( "hashCacheHits" ) = 0,
+						arg( "computeCacheHits" ) = 0,
+						arg( "computeCacheMisses" ) = 0,
+						arg( "cacheBytesStored" ) = 0,
+						arg( "bytesAllocated" ) = 0
 					)
 				)
 			)
@@ -196,6 +301,12 @@ void GafferBindings::bindMonitor()
 			.def_readwrite( "computeCount", &PerformanceMonitor::Statistics::computeCount )
 			.add_property( "hashDuration", &getHashDuration, &setHashDuration )
 			.add_property( "computeDuration", &getComputeDuration, &setComputeDuration )
+			.def_readwrite( "hashCacheHits", &PerformanceMonitor::Statistics::hashCacheHits )
+			.def_readwrite( "computeCacheHits", &PerformanceMonitor::Statistics::computeCacheHits )
+			.def_readwrite( "computeCacheMisses", &PerformanceMonitor::Statistics::computeCacheMisses )
+			.def_readwrite( "cacheBytesStored", &PerformanceMonitor::Statistics::cacheBytesStored )
+			.def_readwrite( "bytesAllocated", &PerformanceMonitor::Statistics::bytesAllocated )
+			.def( self += self )
 			.def( self == self )
 			.def( self != self )
 			.def( "__repr__", &repr )
@@ -219,4 +330,26 @@ void GafferBindings::bindMonitor()
 		;
 	}
 
+	{
+		scope s = class_<HotspotMonitor, bases<Monitor>, boost::noncopyable>( "HotspotMonitor", no_init )
+			.def( "__init__", make_constructor( hotspotMonitorConstructor, default_call_policies(),
+					(
+						arg( "variableNames" ),
+						arg( "maxHotspots" ) = 1000
+					)
+				)
+			)
+			.def( "variableNames", &hotspotMonitorVariableNames )
+			.def( "maxHotspots", &HotspotMonitor::maxHotspots )
+			.def( "hotspots", &hotspots )
+		;
+
+		class_<HotspotMonitor::Hotspot>( "Hotspot", no_init )
+			.add_property( "plug", &hotspotPlug )
+			.add_property( "variables", &hotspotVariables )
+			.def_readonly( "count", &HotspotMonitor::Hotspot::count )
+			.add_property( "duration", &hotspotDuration )
+		;
+	}
+
 }
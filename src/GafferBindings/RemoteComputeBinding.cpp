@@ -0,0 +1,86 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2017, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//      * Redistributions of source code must retain the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer.
+//
+//      * Redistributions in binary form must reproduce the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer in the documentation and/or other materials provided with
+//        the distribution.
+//
+//      * Neither the name of John Haddon nor the names of
+//        any other contributors to this software may be used to endorse or
+//        promote products derived from this software without specific prior
+//        written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#include "boost/python.hpp"
+
+#include "IECorePython/RefCountedBinding.h"
+#include "IECorePython/ScopedGILRelease.h"
+
+#include "Gaffer/RemoteCompute.h"
+#include "Gaffer/ScriptNode.h"
+
+#include "GafferBindings/RemoteComputeBinding.h"
+
+using namespace boost::python;
+using namespace IECorePython;
+using namespace Gaffer;
+using namespace GafferBindings;
+
+namespace
+{
+
+ScriptNodePtr script( ComputeServer &s )
+{
+	return s.script();
+}
+
+void stop( ComputeServer &s )
+{
+	// The computations being waited on may
+	// need the GIL themselves.
+	IECorePython::ScopedGILRelease gilRelease;
+	s.stop();
+}
+
+} // namespace
+
+void GafferBindings::bindRemoteCompute()
+{
+	RefCountedClass<ComputeServer, IECore::RefCounted>( "ComputeServer" )
+		.def( init<ScriptNodePtr, int>( ( arg( "script" ), arg( "port" ) = 0 ) ) )
+		.def( "script", &script )
+		.def( "port", &ComputeServer::port )
+		.def( "stop", &stop )
+	;
+
+	RefCountedClass<ComputeClient, IECore::RefCounted>( "ComputeClient" )
+		.def( init<const std::string &, int>( ( arg( "host" ), arg( "port" ) ) ) )
+		.def( "host", &ComputeClient::host, return_value_policy<copy_const_reference>() )
+		.def( "port", &ComputeClient::port )
+		.def( "computeRemotely", &ComputeClient::computeRemotely )
+		.staticmethod( "computeRemotely" )
+	;
+}
@@ -37,7 +37,16 @@
 
 #include "boost/python.hpp" // must be the first include
 
+#include <fstream>
+#include <list>
+#include <cstdio>
+#include <cstdlib>
+#include <unistd.h>
+
+#include "boost/lexical_cast.hpp"
+
 #include "IECore/MessageHandler.h"
+#include "IECore/MurmurHash.h"
 
 #include "IECorePython/ScopedGILLock.h"
 #include "IECorePython/ScopedGILRelease.h"
@@ -66,6 +75,7 @@ extern "C"
 // essential to include this last, since it defines macros which
 // clash with other headers.
 #include "Python-ast.h"
+#include "marshal.h"
 };
 
 namespace boost {
@@ -98,11 +108,198 @@ const std::string formattedErrorContext( int lineNumber, const std::string &cont
 	);
 }
 
-// Execute the script one top level statement at a time,
-// reporting errors that occur, but otherwise continuing
-// with execution.
-bool tolerantExec( const char *pythonScript, boost::python::object globals, boost::python::object locals, const std::string &context )
+// Compiled serialisations
+// =======================
+//
+// Parsing and compiling a serialisation accounts for a large part of the
+// time taken to load big scripts. We compile each top level statement
+// separately, so that we can report errors and continue execution, and
+// can optionally cache the resulting code objects on disk, keyed by the
+// hash of the serialisation. Loading the same script again then skips
+// straight to execution.
+
+std::string initialCompiledCacheDirectory()
+{
+	const char *d = getenv( "GAFFER_SERIALISATION_CACHE_DIRECTORY" );
+	return d ? d : "";
+}
+
+std::string g_compiledCacheDirectory = initialCompiledCacheDirectory();
+
+// Small serialisations, such as those from copy and paste, are quick
+// to compile and not worth the trip to disk.
+const size_t g_compiledCacheMinSize = 1024 * 1024;
+
+void setCompiledCacheDirectory( const std::string &directory )
+{
+	g_compiledCacheDirectory = directory;
+}
+
+const std::string &getCompiledCacheDirectory()
+{
+	return g_compiledCacheDirectory;
+}
+
+IECore::MurmurHash serialisationHash( const std::string &serialisation )
+{
+	IECore::MurmurHash h;
+	h.append( serialisation );
+	// Marshalled code is only valid for the python version that wrote it.
+	h.append( (int64_t)PyImport_GetMagicNumber() );
+	return h;
+}
+
+std::string compiledCacheFileName( const std::string &serialisation, const IECore::MurmurHash &hash )
+{
+	if( g_compiledCacheDirectory.empty() || serialisation.size() < g_compiledCacheMinSize )
+	{
+		return "";
+	}
+
+	return g_compiledCacheDirectory + "/" + hash.toString() + ".gfc";
+}
+
+// We also keep recently compiled statements in memory, so that
+// executing the same serialisation many times over in one process
+// compiles it only once. The main beneficiary is Reference, where
+// many nodes may load the same file. Code objects are immutable, so
+// they can be reused freely. Keying on the contents rather than the
+// file name means that edits to referenced files are picked up
+// without needing to check modification times.
+struct CompiledMemoryCacheEntry
+{
+	IECore::MurmurHash hash;
+	size_t size;
+	PyObject *statements;
+};
+
+typedef std::list<CompiledMemoryCacheEntry> CompiledMemoryCache;
+
+// Limit in bytes of serialisation.
+const size_t g_compiledMemoryCacheLimit = 256 * 1024 * 1024;
+
+CompiledMemoryCache &compiledMemoryCache()
+{
+	// Deliberately leaked, since we mustn't release the python
+	// objects after the interpreter has been shut down.
+	static CompiledMemoryCache *c = new CompiledMemoryCache;
+	return *c;
+}
+
+size_t g_compiledMemoryCacheSize = 0;
+
+boost::python::object readCompiledMemoryCache( const IECore::MurmurHash &hash )
+{
+	CompiledMemoryCache &cache = compiledMemoryCache();
+	for( CompiledMemoryCache::iterator it = cache.begin(), eIt = cache.end(); it != eIt; ++it )
+	{
+		if( it->hash == hash )
+		{
+			// Move to the front, so we evict the least recently used first.
+			cache.splice( cache.begin(), cache, it );
+			return boost::python::object( boost::python::handle<>( boost::python::borrowed( cache.front().statements ) ) );
+		}
+	}
+	return boost::python::object();
+}
+
+void writeCompiledMemoryCache( const IECore::MurmurHash &hash, size_t size, boost::python::object statements )
+{
+	if( size > g_compiledMemoryCacheLimit )
+	{
+		return;
+	}
+
+	CompiledMemoryCache &cache = compiledMemoryCache();
+	while( !cache.empty() && g_compiledMemoryCacheSize + size > g_compiledMemoryCacheLimit )
+	{
+		g_compiledMemoryCacheSize -= cache.back().size;
+		Py_DECREF( cache.back().statements );
+		cache.pop_back();
+	}
+
+	CompiledMemoryCacheEntry entry;
+	entry.hash = hash;
+	entry.size = size;
+	entry.statements = boost::python::incref( statements.ptr() );
+	cache.push_front( entry );
+	g_compiledMemoryCacheSize += size;
+}
+
+boost::python::object readCompiledCache( const std::string &fileName )
+{
+	std::ifstream f( fileName.c_str(), std::ios::binary );
+	if( !f.good() )
+	{
+		return boost::python::object();
+	}
+
+	const std::string data( ( std::istreambuf_iterator<char>( f ) ), std::istreambuf_iterator<char>() );
+	boost::python::handle<> result( boost::python::allow_null(
+		PyMarshal_ReadObjectFromString( const_cast<char *>( data.c_str() ), data.size() )
+	) );
+
+	if( !result || !PyList_Check( result.get() ) )
+	{
+		// Corrupt or incompatible cache entry. We'll just recompile.
+		PyErr_Clear();
+		return boost::python::object();
+	}
+
+	return boost::python::object( result );
+}
+
+void writeCompiledCache( const std::string &fileName, boost::python::object statements )
 {
+	boost::python::handle<> data( boost::python::allow_null(
+		PyMarshal_WriteObjectToString( statements.ptr(), Py_MARSHAL_VERSION )
+	) );
+	if( !data )
+	{
+		PyErr_Clear();
+		return;
+	}
+
+	// Write to a temporary file and rename, so that concurrent
+	// processes never see a partially written entry.
+	const std::string tmpFileName = fileName + "." + boost::lexical_cast<std::string>( getpid() ) + ".tmp";
+	{
+		std::ofstream f( tmpFileName.c_str(), std::ios::binary );
+		f.write( PyString_AS_STRING( data.get() ), PyString_GET_SIZE( data.get() ) );
+		if( !f.good() )
+		{
+			IECore::msg( IECore::Msg::Warning, "ScriptNode", boost::format( "Unable to write serialisation cache file \"%s\"" ) % fileName );
+			f.close();
+			std::remove( tmpFileName.c_str() );
+			return;
+		}
+	}
+	std::rename( tmpFileName.c_str(), fileName.c_str() );
+}
+
+// Returns a list containing a code object for each top level
+// statement in the script. Throws error_already_set on syntax
+// errors.
+boost::python::list compileStatements( const std::string &pythonScript )
+{
+	const IECore::MurmurHash hash = serialisationHash( pythonScript );
+	boost::python::object cached = readCompiledMemoryCache( hash );
+	if( cached != boost::python::object() )
+	{
+		return boost::python::extract<boost::python::list>( cached );
+	}
+
+	const std::string cacheFileName = compiledCacheFileName( pythonScript, hash );
+	if( !cacheFileName.empty() )
+	{
+		cached = readCompiledCache( cacheFileName );
+		if( cached != boost::python::object() )
+		{
+			writeCompiledMemoryCache( hash, pythonScript.size(), cached );
+			return boost::python::extract<boost::python::list>( cached );
+		}
+	}
+
 	// The python parsing framework uses an arena to simplify memory allocation,
 	// which is handy for us, since we're going to manipulate the AST a little.
 	boost::shared_ptr<PyArena> arena( PyArena_New(), PyArena_Free );
@@ -110,18 +307,23 @@ bool tolerantExec( const char *pythonScript, boost::python::object globals, boos
 	// Parse the whole script, getting an abstract syntax tree for a
 	// module which would execute everything.
 	mod_ty mod = PyParser_ASTFromString(
-		pythonScript,
+		pythonScript.c_str(),
 		"<string>",
 		Py_file_input,
 		NULL,
 		arena.get()
 	);
 
+	if( !mod )
+	{
+		boost::python::throw_error_already_set();
+	}
+
 	assert( mod->kind == Module_kind );
 
 	// Loop over the top-level statements in the module body,
-	// executing one at a time.
-	bool result = false;
+	// compiling one at a time.
+	boost::python::list result;
 	int numStatements = asdl_seq_LEN( mod->v.Module.body );
 	for( int i=0; i<numStatements; ++i )
 	{
@@ -134,22 +336,62 @@ bool tolerantExec( const char *pythonScript, boost::python::object globals, boos
 		);
 
 		// Compile it.
-		boost::python::handle<PyCodeObject> code( PyAST_Compile( newModule, "<string>", NULL, arena.get() ) );
+		boost::python::handle<> code( (PyObject *)PyAST_Compile( newModule, "<string>", NULL, arena.get() ) );
+		result.append( boost::python::object( code ) );
+	}
 
-		// And execute it.
+	if( !cacheFileName.empty() )
+	{
+		writeCompiledCache( cacheFileName, result );
+	}
+	writeCompiledMemoryCache( hash, pythonScript.size(), result );
+
+	return result;
+}
+
+// Execute the script one top level statement at a time. If
+// continueOnError is true, then errors are reported but otherwise
+// execution continues, otherwise we throw at the first error.
+bool execStatements( const std::string &pythonScript, boost::python::object globals, boost::python::object locals, bool continueOnError, const std::string &context )
+{
+	boost::python::list statements;
+	try
+	{
+		statements = compileStatements( pythonScript );
+	}
+	catch( boost::python::error_already_set &e )
+	{
+		int lineNumber = 0;
+		std::string message = ExceptionAlgo::formatPythonException( /* withTraceback = */ false, &lineNumber );
+		if( !continueOnError )
+		{
+			throw IECore::Exception( formattedErrorContext( lineNumber, context ) + " : " + message );
+		}
+		IECore::msg( IECore::Msg::Error, formattedErrorContext( lineNumber, context ), message );
+		return true;
+	}
+
+	bool result = false;
+	for( boost::python::ssize_t i = 0, e = boost::python::len( statements ); i < e; ++i )
+	{
+		boost::python::object code = statements[i];
 		boost::python::handle<> v( boost::python::allow_null(
 			PyEval_EvalCode(
-				code.get(),
+				(PyCodeObject *)code.ptr(),
 				globals.ptr(),
 				locals.ptr()
 			)
 		) );
 
 		// Report any errors.
-		if( v == NULL)
+		if( v == NULL )
 		{
 			int lineNumber = 0;
 			std::string message = ExceptionAlgo::formatPythonException( /* withTraceback = */ false, &lineNumber );
+			if( !continueOnError )
+			{
+				throw IECore::Exception( formattedErrorContext( lineNumber, context ) + " : " + message );
+			}
 			IECore::msg( IECore::Msg::Error, formattedErrorContext( lineNumber, context ), message );
 			result = true;
 		}
@@ -212,24 +454,7 @@ bool execute( ScriptNode *script, const std::string &serialisation, Node *parent
 	try
 	{
 		boost::python::object e = executionDict( script, parent );
-
-		if( !continueOnError )
-		{
-			try
-			{
-				exec( serialisation.c_str(), e, e );
-			}
-			catch( boost::python::error_already_set &e )
-			{
-				int lineNumber = 0;
-				std::string message = ExceptionAlgo::formatPythonException( /* withTraceback = */ false, &lineNumber );
-				throw IECore::Exception( formattedErrorContext( lineNumber, context ) + " : " + message );
-			}
-		}
-		else
-		{
-			result = tolerantExec( serialisation.c_str(), e, e, context );
-		}
+		result = execStatements( serialisation, e, e, continueOnError, context );
 	}
 	catch( boost::python::error_already_set &e )
 	{
@@ -374,6 +599,8 @@ void GafferBindings::bindScriptNode()
 		.def( "currentActionStage", &ScriptNode::currentActionStage )
 		.def( "actionSignal", &ScriptNode::actionSignal, boost::python::return_internal_reference<1>() )
 		.def( "undoAddedSignal", &ScriptNode::undoAddedSignal, boost::python::return_internal_reference<1>() )
+		.def( "setUndoMemoryLimit", &ScriptNode::setUndoMemoryLimit )
+		.def( "getUndoMemoryLimit", &ScriptNode::getUndoMemoryLimit )
 		.def( "copy", &ScriptNode::copy, ( boost::python::arg( "parent" ) = boost::python::object(), boost::python::arg( "filter" ) = boost::python::object() ) )
 		.def( "cut", &ScriptNode::cut, ( boost::python::arg( "parent" ) = boost::python::object(), boost::python::arg( "filter" ) = boost::python::object() ) )
 		.def( "paste", &ScriptNode::paste, ( boost::python::arg( "parent" ) = boost::python::object() ) )
@@ -387,6 +614,10 @@ void GafferBindings::bindScriptNode()
 		.def( "save", &ScriptNode::save )
 		.def( "load", &ScriptNode::load, ( boost::python::arg( "continueOnError" ) = false ) )
 		.def( "context", &context )
+		.def( "setSerialisationCacheDirectory", &setCompiledCacheDirectory )
+		.staticmethod( "setSerialisationCacheDirectory" )
+		.def( "getSerialisationCacheDirectory", &getCompiledCacheDirectory, boost::python::return_value_policy<boost::python::copy_const_reference>() )
+		.staticmethod( "getSerialisationCacheDirectory" )
 	;
 
 	SignalClass<ScriptNode::ActionSignal, DefaultSignalCaller<ScriptNode::ActionSignal>, ActionSlotCaller>( "ActionSignal" );
@@ -90,6 +90,9 @@ const Gaffer::GraphComponent *Serialisation::parent() const
 std::string Serialisation::result() const
 {
 	std::string result;
+	// The scripts can be very large, so avoid repeated
+	// reallocation while assembling the result.
+	result.reserve( m_hierarchyScript.size() + m_connectionScript.size() + m_postScript.size() + 1024 );
 	for( std::set<std::string>::const_iterator it=m_modules.begin(); it!=m_modules.end(); it++ )
 	{
 		result += "import " + *it + "\n";
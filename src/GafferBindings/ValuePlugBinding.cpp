@@ -38,11 +38,14 @@
 #include "boost/python.hpp"
 #include "boost/format.hpp"
 
+#include "IECorePython/ScopedGILRelease.h"
+
 #include "Gaffer/ValuePlug.h"
 #include "Gaffer/Node.h"
 #include "Gaffer/Context.h"
 #include "Gaffer/Reference.h"
 #include "Gaffer/Metadata.h"
+#include "Gaffer/RemoteCompute.h"
 
 #include "GafferBindings/ValuePlugBinding.h"
 #include "GafferBindings/PlugBinding.h"
@@ -67,6 +70,88 @@ static bool shouldResetPlugDefault( const Gaffer::Plug *plug, const Serialisatio
 	return Context::current()->get<bool>( "valuePlugSerialiser:resetParentPlugDefaults", false );
 }
 
+static void batchArguments( object pythonPlugs, object pythonContexts, std::vector<const ValuePlug *> &plugs, std::vector<const Context *> &contexts )
+{
+	for( size_t i = 0, e = len( pythonPlugs ); i < e; ++i )
+	{
+		plugs.push_back( extract<const ValuePlug *>( pythonPlugs[i] ) );
+	}
+	if( pythonContexts != object() )
+	{
+		for( size_t i = 0, e = len( pythonContexts ); i < e; ++i )
+		{
+			contexts.push_back( extract<const Context *>( pythonContexts[i] ) );
+		}
+	}
+}
+
+static list hashes( object pythonPlugs, object pythonContexts )
+{
+	std::vector<const ValuePlug *> plugs;
+	std::vector<const Context *> contexts;
+	batchArguments( pythonPlugs, pythonContexts, plugs, contexts );
+
+	std::vector<IECore::MurmurHash> hashes;
+	{
+		IECorePython::ScopedGILRelease gilRelease;
+		ValuePlug::hashes( plugs, contexts, hashes );
+	}
+
+	list result;
+	for( std::vector<IECore::MurmurHash>::const_iterator it = hashes.begin(), eIt = hashes.end(); it != eIt; ++it )
+	{
+		result.append( *it );
+	}
+	return result;
+}
+
+static void prefetch( object pythonPlugs, object pythonContexts )
+{
+	std::vector<const ValuePlug *> plugs;
+	std::vector<const Context *> contexts;
+	batchArguments( pythonPlugs, pythonContexts, plugs, contexts );
+
+	IECorePython::ScopedGILRelease gilRelease;
+	ValuePlug::prefetch( plugs, contexts );
+}
+
+static void setFrom( ValuePlug *plug, const ValuePlug *other )
+{
+	// Must release GIL in case this triggers a graph evaluation
+	// which wants to enter Python on another thread.
+	IECorePython::ScopedGILRelease gilRelease;
+	plug->setFrom( other );
+}
+
+static void setToDefault( ValuePlug *plug )
+{
+	IECorePython::ScopedGILRelease gilRelease;
+	plug->setToDefault();
+}
+
+static bool isSetToDefault( const ValuePlug *plug )
+{
+	IECorePython::ScopedGILRelease gilRelease;
+	return plug->isSetToDefault();
+}
+
+static IECore::MurmurHash hash( const ValuePlug *plug )
+{
+	IECorePython::ScopedGILRelease gilRelease;
+	return plug->hash();
+}
+
+static void hash2( const ValuePlug *plug, IECore::MurmurHash &h )
+{
+	IECorePython::ScopedGILRelease gilRelease;
+	plug->hash( h );
+}
+
+static ComputeClientPtr getComputeClient()
+{
+	return ValuePlug::getComputeClient();
+}
+
 static std::string repr( const ValuePlug *plug )
 {
 	return ValuePlugSerialiser::repr( plug );
@@ -279,19 +364,43 @@ void GafferBindings::bindValuePlug()
 			)
 		)
 		.def( "settable", &ValuePlug::settable )
-		.def( "setFrom", &ValuePlug::setFrom )
-		.def( "setToDefault", &ValuePlug::setToDefault )
-		.def( "isSetToDefault", &ValuePlug::isSetToDefault )
-		.def( "hash", (IECore::MurmurHash (ValuePlug::*)() const)&ValuePlug::hash )
-		.def( "hash", (void (ValuePlug::*)( IECore::MurmurHash & ) const)&ValuePlug::hash )
+		.def( "setFrom", &setFrom )
+		.def( "setToDefault", &setToDefault )
+		.def( "isSetToDefault", &isSetToDefault )
+		.def( "defaultHash", &ValuePlug::defaultHash )
+		.def( "hash", &hash )
+		.def( "hash", &hash2 )
+		.def( "hashes", &hashes, ( boost::python::arg_( "plugs" ), boost::python::arg_( "contexts" ) = object() ) )
+		.staticmethod( "hashes" )
+		.def( "prefetch", &prefetch, ( boost::python::arg_( "plugs" ), boost::python::arg_( "contexts" ) = object() ) )
+		.staticmethod( "prefetch" )
 		.def( "getCacheMemoryLimit", &ValuePlug::getCacheMemoryLimit )
 		.staticmethod( "getCacheMemoryLimit" )
 		.def( "setCacheMemoryLimit", &ValuePlug::setCacheMemoryLimit )
 		.staticmethod( "setCacheMemoryLimit" )
-		.def( "cacheMemoryUsage", &ValuePlug::cacheMemoryUsage )
+		.def( "cacheMemoryUsage", (size_t (*)())&ValuePlug::cacheMemoryUsage )
+		.def( "cacheMemoryUsage", (size_t (*)( const GraphComponent * ))&ValuePlug::cacheMemoryUsage )
 		.staticmethod( "cacheMemoryUsage" )
 		.def( "clearCache", &ValuePlug::clearCache )
 		.staticmethod( "clearCache" )
+		.def( "getHashCacheSizeLimit", &ValuePlug::getHashCacheSizeLimit )
+		.staticmethod( "getHashCacheSizeLimit" )
+		.def( "setHashCacheSizeLimit", &ValuePlug::setHashCacheSizeLimit )
+		.staticmethod( "setHashCacheSizeLimit" )
+		.def( "clearHashCache", &ValuePlug::clearHashCache )
+		.staticmethod( "clearHashCache" )
+		.def( "setDiskCacheDirectory", &ValuePlug::setDiskCacheDirectory )
+		.staticmethod( "setDiskCacheDirectory" )
+		.def( "getDiskCacheDirectory", &ValuePlug::getDiskCacheDirectory, boost::python::return_value_policy<boost::python::copy_const_reference>() )
+		.staticmethod( "getDiskCacheDirectory" )
+		.def( "setDiskCacheSizeLimit", &ValuePlug::setDiskCacheSizeLimit )
+		.staticmethod( "setDiskCacheSizeLimit" )
+		.def( "getDiskCacheSizeLimit", &ValuePlug::getDiskCacheSizeLimit )
+		.staticmethod( "getDiskCacheSizeLimit" )
+		.def( "setComputeClient", &ValuePlug::setComputeClient )
+		.staticmethod( "setComputeClient" )
+		.def( "getComputeClient", &getComputeClient )
+		.staticmethod( "getComputeClient" )
 		.def( "__repr__", &repr )
 	;
 
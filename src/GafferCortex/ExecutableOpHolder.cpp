@@ -81,18 +81,16 @@ const IECore::Op *ExecutableOpHolder::getOp( std::string *className, int *classV
 
 IECore::MurmurHash ExecutableOpHolder::hash( const Gaffer::Context *context ) const
 {
-	std::string className;
-	int classVersion;
-	if ( !getOp( &className, &classVersion ) )
+	if ( !getOp() )
 	{
 		return IECore::MurmurHash();
 	}
 
 	IECore::MurmurHash h = ParameterisedHolderTaskNode::hash( context );
-	h.append( className );
-	h.append( classVersion );
 
 	Gaffer::Context::Scope scope( context );
+	getChild<Gaffer::ValuePlug>( "__className" )->hash( h );
+	getChild<Gaffer::ValuePlug>( "__classVersion" )->hash( h );
 	const Gaffer::ValuePlug *parametersPlug = getChild<Gaffer::ValuePlug>( "parameters" );
 	if( parametersPlug )
 	{
@@ -109,11 +109,11 @@ void OpHolder::hash( const Gaffer::ValuePlug *output, const Gaffer::Context *con
 	ParameterisedHolderComputeNode::hash( output, context, h );
 	if( output->getName()=="result" )
 	{
-		std::string className;
-		int classVersion;
-		getParameterised( &className, &classVersion );
-		h.append( className );
-		h.append( classVersion );
+		// We hash the plugs rather than their values, because for
+		// unconnected plugs this is just a lookup of the stored
+		// hash, without copying the class name.
+		getChild<Gaffer::ValuePlug>( "__className" )->hash( h );
+		getChild<Gaffer::ValuePlug>( "__classVersion" )->hash( h );
 
 		const Gaffer::ValuePlug *parametersPlug = getChild<Gaffer::ValuePlug>( "parameters" );
 		if( parametersPlug )
@@ -130,6 +130,11 @@ void OpHolder::compute( Gaffer::ValuePlug *output, const Gaffer::Context *contex
 		const_cast<CompoundParameterHandler *>( parameterHandler() )->setParameterValue();
 		const_cast<Op *>( getOp() )->operate();
 		m_resultParameterHandler->setPlugValue();
+		// The result is now owned by the compute cache, so we release
+		// the Op's reference to it. Otherwise the memory couldn't
+		// be reclaimed when the cache evicts the value.
+		Parameter *resultParameter = m_resultParameterHandler->parameter();
+		resultParameter->setValue( resultParameter->defaultValue()->copy() );
 		return;
 	}
 
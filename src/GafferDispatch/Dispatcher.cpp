@@ -34,7 +34,13 @@
 //
 //////////////////////////////////////////////////////////////////////////
 
+#include "tbb/concurrent_hash_map.h"
+#include "tbb/parallel_for.h"
+#include "tbb/blocked_range.h"
+
 #include "boost/filesystem.hpp"
+#include "boost/optional.hpp"
+#include "boost/functional/hash.hpp"
 
 #include "IECore/FrameRange.h"
 #include "IECore/MessageHandler.h"
@@ -45,6 +51,7 @@
 #include "Gaffer/SubGraph.h"
 
 #include "GafferDispatch/Dispatcher.h"
+#include "GafferDispatch/Private/TaskManifest.h"
 
 using namespace IECore;
 using namespace Gaffer;
@@ -76,6 +83,7 @@ Dispatcher::Dispatcher( const std::string &name )
 	addChild( new StringPlug( "frameRange", Plug::In, "1-100x10" ) );
 	addChild( new StringPlug( "jobName", Plug::In, "" ) );
 	addChild( new StringPlug( "jobsDirectory", Plug::In, "" ) );
+	addChild( new BoolPlug( "skipUpToDateTasks", Plug::In, false ) );
 }
 
 Dispatcher::~Dispatcher()
@@ -122,6 +130,16 @@ const StringPlug *Dispatcher::jobsDirectoryPlug() const
 	return getChild<StringPlug>( g_firstPlugIndex + 3 );
 }
 
+BoolPlug *Dispatcher::skipUpToDateTasksPlug()
+{
+	return getChild<BoolPlug>( g_firstPlugIndex + 4 );
+}
+
+const BoolPlug *Dispatcher::skipUpToDateTasksPlug() const
+{
+	return getChild<BoolPlug>( g_firstPlugIndex + 4 );
+}
+
 const std::string Dispatcher::jobDirectory() const
 {
 	return m_jobDirectory;
@@ -301,8 +319,8 @@ class Dispatcher::Batcher
 
 	public :
 
-		Batcher()
-			:	m_rootBatch( new TaskBatch() )
+		Batcher( bool skipUpToDateTasks = false )
+			:	m_rootBatch( new TaskBatch() ), m_skipUpToDateTasks( skipUpToDateTasks )
 		{
 		}
 
@@ -311,11 +329,57 @@ class Dispatcher::Batcher
 			addPreTask( m_rootBatch.get(), batchTasksWalk( task ) );
 		}
 
+		// Equivalent to calling `addTask()` for each node in turn, for
+		// each frame in turn. Hashing tasks and querying their dependencies
+		// can be expensive, so for long frame ranges we first do that for all
+		// tasks in parallel, and then build the DAG serially from the
+		// precomputed results.
+		void addTasks( const std::vector<TaskNodePtr> &nodes, const std::vector<FrameList::Frame> &frames, const Context *context )
+		{
+			std::vector<boost::optional<TaskNode::Task> > tasks( nodes.size() * frames.size() );
+
+			PrepareTasks functor( nodes, frames, context, tasks, m_dependencies );
+			tbb::task_group_context taskGroupContext( tbb::task_group_context::isolated );
+			tbb::parallel_for( tbb::blocked_range<size_t>( 0, tasks.size() ), functor, taskGroupContext );
+
+			for( std::vector<boost::optional<TaskNode::Task> >::const_iterator it = tasks.begin(), eIt = tasks.end(); it != eIt; ++it )
+			{
+				addTask( **it );
+			}
+		}
+
 		TaskBatch *rootBatch()
 		{
 			return m_rootBatch.get();
 		}
 
+		// Removes the frames of all up to date tasks from their
+		// batches. Must be called after all tasks have been added.
+		void pruneUpToDateTasks()
+		{
+			for( UpToDateFramesMap::const_iterator it = m_upToDateFrames.begin(), eIt = m_upToDateFrames.end(); it != eIt; ++it )
+			{
+				std::vector<float> &frames = it->first->frames();
+				if( it->first->plug()->requiresSequenceExecution() )
+				{
+					// Sequences are executed as a whole, often writing
+					// all frames into a single file, so we can only skip
+					// them if every single frame is up to date.
+					if( it->second.size() == frames.size() )
+					{
+						frames.clear();
+					}
+				}
+				else
+				{
+					frames.erase(
+						std::remove_if( frames.begin(), frames.end(), FrameIn( it->second ) ),
+						frames.end()
+					);
+				}
+			}
+		}
+
 	private :
 
 		TaskBatchPtr batchTasksWalk( const TaskNode::Task &task, const std::set<const TaskBatch *> &ancestors = std::set<const TaskBatch *>() )
@@ -332,11 +396,7 @@ class Dispatcher::Batcher
 			// Ask the task what preTasks and postTasks it would like.
 			TaskNode::Tasks preTasks;
 			TaskNode::Tasks postTasks;
-			{
-				Context::Scope scopedTaskContext( task.context() );
-				task.plug()->preTasks( preTasks );
-				task.plug()->postTasks( postTasks );
-			}
+			dependencies( task, preTasks, postTasks );
 
 			// Collect all the batches the postTasks belong in.
 			// We grab these first because they need to be included
@@ -358,9 +418,16 @@ class Dispatcher::Batcher
 				preTaskAncestors.insert( it->get() );
 			}
 
+			bool preTasksUpToDate = true;
 			for( TaskNode::Tasks::const_iterator it = preTasks.begin(); it != preTasks.end(); ++it )
 			{
 				addPreTask( batch.get(), batchTasksWalk( *it, preTaskAncestors ) );
+				preTasksUpToDate = preTasksUpToDate && upToDate( *it );
+			}
+
+			if( m_skipUpToDateTasks )
+			{
+				checkUpToDate( task, batch.get(), preTasksUpToDate );
 			}
 
 			// As far as TaskBatch and doDispatch() are concerned, there
@@ -382,14 +449,7 @@ class Dispatcher::Batcher
 			// See if we've previously visited this task, and therefore
 			// have placed it in a batch already, which we can return
 			// unchanged.
-			MurmurHash taskToBatchMapHash = task.hash();
-			taskToBatchMapHash.append( (uint64_t)task.node() );
-			if( task.hash() == MurmurHash() )
-			{
-				// Make sure we don't coalesce all no-ops into a single
-				// batch. See comments in batchHash().
-				taskToBatchMapHash.append( task.context()->getFrame() );
-			}
+			const MurmurHash taskToBatchMapHash = taskHash( task );
 			const TaskToBatchMap::const_iterator it = m_tasksToBatches.find( taskToBatchMapHash );
 			if( it != m_tasksToBatches.end() )
 			{
@@ -458,6 +518,181 @@ class Dispatcher::Batcher
 			return batch;
 		}
 
+		// Dependencies of a task, as precomputed by `addTasks()`.
+		struct Dependencies
+		{
+			TaskNode::Tasks preTasks;
+			TaskNode::Tasks postTasks;
+		};
+
+		struct HashCompare
+		{
+			static size_t hash( const IECore::MurmurHash &h )
+			{
+				return boost::hash<IECore::MurmurHash>()( h );
+			}
+
+			static bool equal( const IECore::MurmurHash &h1, const IECore::MurmurHash &h2 )
+			{
+				return h1 == h2;
+			}
+		};
+
+		typedef tbb::concurrent_hash_map<IECore::MurmurHash, Dependencies, HashCompare> DependenciesMap;
+
+		// Tasks with identical hashes may still have different
+		// dependencies if their contexts differ (consider a no-op
+		// downstream of a Wedge), so the dependencies are keyed by
+		// context as well.
+		static IECore::MurmurHash dependenciesHash( const TaskNode::Task &task )
+		{
+			MurmurHash result = taskHash( task );
+			result.append( task.context()->hash() );
+			return result;
+		}
+
+		// Fills `dependencies` for `task` and everything upstream
+		// of it. Threads visiting the same task concurrently will
+		// wait for the first to finish querying it, rather than
+		// duplicating the work.
+		static void prepareWalk( const TaskNode::Task &task, DependenciesMap &dependencies )
+		{
+			Dependencies taskDependencies;
+			{
+				DependenciesMap::accessor a;
+				if( !dependencies.insert( a, dependenciesHash( task ) ) )
+				{
+					// Visited already. This also terminates the walk
+					// for cyclic dependencies, which are reported later
+					// by `batchTasksWalk()`.
+					return;
+				}
+
+				Context::Scope scopedTaskContext( task.context() );
+				task.plug()->preTasks( a->second.preTasks );
+				task.plug()->postTasks( a->second.postTasks );
+				taskDependencies = a->second;
+			}
+
+			for( TaskNode::Tasks::const_iterator it = taskDependencies.postTasks.begin(), eIt = taskDependencies.postTasks.end(); it != eIt; ++it )
+			{
+				prepareWalk( *it, dependencies );
+			}
+			for( TaskNode::Tasks::const_iterator it = taskDependencies.preTasks.begin(), eIt = taskDependencies.preTasks.end(); it != eIt; ++it )
+			{
+				prepareWalk( *it, dependencies );
+			}
+		}
+
+		struct PrepareTasks
+		{
+
+			PrepareTasks( const std::vector<TaskNodePtr> &nodes, const std::vector<FrameList::Frame> &frames, const Context *context, std::vector<boost::optional<TaskNode::Task> > &tasks, DependenciesMap &dependencies )
+				:	m_nodes( nodes ), m_frames( frames ), m_context( context ), m_tasks( tasks ), m_dependencies( dependencies )
+			{
+			}
+
+			void operator()( const tbb::blocked_range<size_t> &r ) const
+			{
+				ContextPtr context = new Context( *m_context, Context::Borrowed );
+				for( size_t i = r.begin(); i != r.end(); ++i )
+				{
+					context->setFrame( m_frames[i / m_nodes.size()] );
+					m_tasks[i] = TaskNode::Task( m_nodes[i % m_nodes.size()], context.get() );
+					prepareWalk( *m_tasks[i], m_dependencies );
+				}
+			}
+
+			private :
+
+				const std::vector<TaskNodePtr> &m_nodes;
+				const std::vector<FrameList::Frame> &m_frames;
+				const Context *m_context;
+				std::vector<boost::optional<TaskNode::Task> > &m_tasks;
+				DependenciesMap &m_dependencies;
+
+		};
+
+		void dependencies( const TaskNode::Task &task, TaskNode::Tasks &preTasks, TaskNode::Tasks &postTasks ) const
+		{
+			DependenciesMap::const_accessor a;
+			if( m_dependencies.find( a, dependenciesHash( task ) ) )
+			{
+				preTasks = a->second.preTasks;
+				postTasks = a->second.postTasks;
+				return;
+			}
+
+			// Not added via `addTasks()`.
+			Context::Scope scopedTaskContext( task.context() );
+			task.plug()->preTasks( preTasks );
+			task.plug()->postTasks( postTasks );
+		}
+
+		// Hash used to uniquely identify a task.
+		static IECore::MurmurHash taskHash( const TaskNode::Task &task )
+		{
+			MurmurHash result = task.hash();
+			result.append( (uint64_t)task.node() );
+			if( task.hash() == MurmurHash() )
+			{
+				// Make sure we don't coalesce all no-ops into a single
+				// batch. See comments in batchHash().
+				result.append( task.context()->getFrame() );
+			}
+			return result;
+		}
+
+		// A task is up to date if its manifest says so, and all its
+		// preTasks are also up to date, in the manner of `make`. No-ops
+		// are up to date if their preTasks are.
+		void checkUpToDate( const TaskNode::Task &task, TaskBatch *batch, bool preTasksUpToDate )
+		{
+			const MurmurHash h = taskHash( task );
+			if( m_upToDateTasks.find( h ) != m_upToDateTasks.end() )
+			{
+				// We've visited this task before.
+				return;
+			}
+
+			bool result = preTasksUpToDate;
+			if( result && task.hash() != MurmurHash() )
+			{
+				result = GafferDispatch::Private::TaskManifest::upToDate( task );
+				if( result )
+				{
+					m_upToDateFrames[batch].insert( task.context()->getFrame() );
+				}
+			}
+
+			m_upToDateTasks[h] = result;
+		}
+
+		bool upToDate( const TaskNode::Task &task ) const
+		{
+			if( !m_skipUpToDateTasks )
+			{
+				return false;
+			}
+			const UpToDateMap::const_iterator it = m_upToDateTasks.find( taskHash( task ) );
+			return it != m_upToDateTasks.end() && it->second;
+		}
+
+		struct FrameIn
+		{
+			FrameIn( const std::set<float> &frames )
+				:	m_frames( frames )
+			{
+			}
+
+			bool operator()( float frame ) const
+			{
+				return m_frames.find( frame ) != m_frames.end();
+			}
+
+			const std::set<float> &m_frames;
+		};
+
 		// Hash used to determine how to coalesce tasks into batches.
 		// If `batchHash( task1 ) == batchHash( task2 )` then the two
 		// tasks can be placed in the same batch.
@@ -531,10 +766,19 @@ class Dispatcher::Batcher
 		typedef std::map<IECore::MurmurHash, TaskBatchPtr> BatchMap;
 		typedef std::map<IECore::MurmurHash, TaskBatchPtr> TaskToBatchMap;
 
+		typedef std::map<IECore::MurmurHash, bool> UpToDateMap;
+		typedef std::map<TaskBatchPtr, std::set<float> > UpToDateFramesMap;
+
 		TaskBatchPtr m_rootBatch;
 		BatchMap m_currentBatches;
 		TaskToBatchMap m_tasksToBatches;
 
+		DependenciesMap m_dependencies;
+
+		bool m_skipUpToDateTasks;
+		UpToDateMap m_upToDateTasks;
+		UpToDateFramesMap m_upToDateFrames;
+
 };
 
 //////////////////////////////////////////////////////////////////////////
@@ -638,6 +882,14 @@ void Dispatcher::dispatch( const std::vector<NodePtr> &nodes ) const
 	m_jobDirectory = createJobDirectory( context.get() );
 	context->set( g_jobDirectoryContextEntry, m_jobDirectory );
 
+	const bool skipUpToDateTasks = skipUpToDateTasksPlug()->getValue();
+	if( skipUpToDateTasks )
+	{
+		// Lets the tasks know that they should record manifests
+		// when they are executed.
+		context->set( GafferDispatch::Private::TaskManifest::skipUpToDateTasksContextName, true );
+	}
+
 	// this object calls this->preDispatchSignal() in its constructor and this->postDispatchSignal()
 	// in its destructor, thereby guaranteeing that we always call this->postDispatchSignal().
 
@@ -651,16 +903,10 @@ void Dispatcher::dispatch( const std::vector<NodePtr> &nodes ) const
 	FrameListPtr frameList = frameRange( script, context.get() );
 	frameList->asList( frames );
 
-	Batcher batcher;
-	for( std::vector<FrameList::Frame>::const_iterator fIt = frames.begin(); fIt != frames.end(); ++fIt )
-	{
-		for( std::vector<TaskNodePtr>::const_iterator nIt = taskNodes.begin(); nIt != taskNodes.end(); ++nIt )
-		{
-			context->setFrame( *fIt );
-			batcher.addTask( TaskNode::Task( *nIt, context.get() ) );
-		}
-	}
+	Batcher batcher( skipUpToDateTasks );
+	batcher.addTasks( taskNodes, frames, context.get() );
 
+	batcher.pruneUpToDateTasks();
 	executeAndPruneImmediateBatches( batcher.rootBatch() );
 
 	if( !batcher.rootBatch()->preTasks().empty() )
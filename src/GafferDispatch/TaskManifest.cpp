@@ -0,0 +1,166 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2017, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//      * Redistributions of source code must retain the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer.
+//
+//      * Redistributions in binary form must reproduce the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer in the documentation and/or other materials provided with
+//        the distribution.
+//
+//      * Neither the name of John Haddon nor the names of
+//        any other contributors to this software may be used to endorse or
+//        promote products derived from this software without specific prior
+//        written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#include <fstream>
+
+#include "boost/filesystem.hpp"
+#include "boost/lexical_cast.hpp"
+
+#include "IECore/MessageHandler.h"
+
+#include "Gaffer/Context.h"
+#include "Gaffer/StringPlug.h"
+
+#include "GafferDispatch/Private/TaskManifest.h"
+
+using namespace std;
+using namespace IECore;
+using namespace Gaffer;
+using namespace GafferDispatch;
+
+namespace
+{
+
+InternedString g_fileNamePlugName( "fileName" );
+
+// Returns the output file for the task in the current context,
+// or an empty path if it can't be determined.
+boost::filesystem::path outputFileName( const TaskNode::TaskPlug *plug )
+{
+	const StringPlug *fileNamePlug = plug->node()->getChild<StringPlug>( g_fileNamePlugName );
+	if( !fileNamePlug || fileNamePlug->direction() != Plug::In )
+	{
+		return boost::filesystem::path();
+	}
+	return fileNamePlug->getValue();
+}
+
+// Several frames may write to the same file (SceneWriter for instance),
+// so we keep a separate manifest entry per frame. Using a file per entry
+// also means that jobs executing different frames concurrently on a farm
+// don't need to coordinate their writes.
+boost::filesystem::path manifestFileName( const boost::filesystem::path &outputFileName )
+{
+	return outputFileName.parent_path() / ".gafferManifest" / (
+		outputFileName.filename().string() + "." + boost::lexical_cast<string>( Context::current()->getFrame() )
+	);
+}
+
+string manifestEntry( const MurmurHash &hash, const boost::filesystem::path &outputFileName )
+{
+	return hash.toString() + " " + boost::lexical_cast<string>( boost::filesystem::last_write_time( outputFileName ) );
+}
+
+} // namespace
+
+const InternedString GafferDispatch::Private::TaskManifest::skipUpToDateTasksContextName( "dispatcher:skipUpToDateTasks" );
+
+bool GafferDispatch::Private::TaskManifest::upToDate( const TaskNode::Task &task )
+{
+	if( task.hash() == MurmurHash() )
+	{
+		// No-ops have no outputs of their own.
+		return false;
+	}
+
+	Context::Scope scopedContext( task.context() );
+	const boost::filesystem::path output = outputFileName( task.plug() );
+	if( output.empty() )
+	{
+		return false;
+	}
+
+	try
+	{
+		if( !boost::filesystem::is_regular_file( output ) )
+		{
+			return false;
+		}
+
+		std::ifstream manifest( manifestFileName( output ).c_str() );
+		string entry;
+		if( !std::getline( manifest, entry ) )
+		{
+			return false;
+		}
+
+		return entry == manifestEntry( task.hash(), output );
+	}
+	catch( const boost::filesystem::filesystem_error & )
+	{
+		return false;
+	}
+}
+
+void GafferDispatch::Private::TaskManifest::record( const TaskNode::TaskPlug *plug )
+{
+	const MurmurHash hash = plug->hash();
+	if( hash == MurmurHash() )
+	{
+		return;
+	}
+
+	const boost::filesystem::path output = outputFileName( plug );
+	if( output.empty() )
+	{
+		return;
+	}
+
+	try
+	{
+		if( !boost::filesystem::is_regular_file( output ) )
+		{
+			// Task didn't produce the output we expected (an ArnoldRender
+			// in render mode, for instance), so we can't vouch for it.
+			return;
+		}
+
+		const boost::filesystem::path manifest = manifestFileName( output );
+		boost::filesystem::create_directories( manifest.parent_path() );
+		std::ofstream file( manifest.c_str() );
+		file << manifestEntry( hash, output ) << "\n";
+		if( !file )
+		{
+			IECore::msg( IECore::Msg::Warning, "TaskManifest::record", "Unable to write \"" + manifest.string() + "\"" );
+		}
+	}
+	catch( const boost::filesystem::filesystem_error &e )
+	{
+		// Failing to record the manifest mustn't fail the task - the worst
+		// that can happen is that it is executed again next time.
+		IECore::msg( IECore::Msg::Warning, "TaskManifest::record", e.what() );
+	}
+}
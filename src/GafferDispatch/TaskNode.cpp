@@ -42,6 +42,7 @@
 
 #include "GafferDispatch/Dispatcher.h"
 #include "GafferDispatch/TaskNode.h"
+#include "GafferDispatch/Private/TaskManifest.h"
 
 using namespace IECore;
 using namespace Gaffer;
@@ -205,14 +206,37 @@ IECore::MurmurHash TaskNode::TaskPlug::hash() const
 
 void TaskNode::TaskPlug::execute() const
 {
-	TaskNodeProcess p( TaskNodeProcess::executeProcessType, this );
-	return p.taskNode()->execute();
+	{
+		TaskNodeProcess p( TaskNodeProcess::executeProcessType, this );
+		p.taskNode()->execute();
+	}
+
+	if( Context::current()->get<bool>( GafferDispatch::Private::TaskManifest::skipUpToDateTasksContextName, false ) )
+	{
+		GafferDispatch::Private::TaskManifest::record( this );
+	}
 }
 
 void TaskNode::TaskPlug::executeSequence( const std::vector<float> &frames ) const
 {
-	TaskNodeProcess p( TaskNodeProcess::executeSequenceProcessType, this );
-	return p.taskNode()->executeSequence( frames );
+	{
+		TaskNodeProcess p( TaskNodeProcess::executeSequenceProcessType, this );
+		p.taskNode()->executeSequence( frames );
+	}
+
+	if( Context::current()->get<bool>( GafferDispatch::Private::TaskManifest::skipUpToDateTasksContextName, false ) )
+	{
+		// We record only once the whole sequence is complete, because
+		// sequence execution typically writes all frames to a single
+		// file, which is only finished at the very end.
+		ContextPtr context = new Context( *Context::current(), Context::Borrowed );
+		Context::Scope scopedContext( context.get() );
+		for( std::vector<float>::const_iterator it = frames.begin(), eIt = frames.end(); it != eIt; ++it )
+		{
+			context->setFrame( *it );
+			GafferDispatch::Private::TaskManifest::record( this );
+		}
+	}
 }
 
 bool TaskNode::TaskPlug::requiresSequenceExecution() const
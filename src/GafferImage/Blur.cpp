@@ -34,15 +34,118 @@
 //
 //////////////////////////////////////////////////////////////////////////
 
+#include "Gaffer/Context.h"
 #include "Gaffer/StringPlug.h"
 
 #include "GafferImage/Blur.h"
 #include "GafferImage/Resample.h"
+#include "GafferImage/Sampler.h"
 
 using namespace Imath;
+using namespace IECore;
 using namespace Gaffer;
 using namespace GafferImage;
 
+//////////////////////////////////////////////////////////////////////////
+// Utilities for the Fast mode
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+// Computes the radii of three box filters which, applied one after another,
+// approximate the "smoothGaussian" filter used by the Accurate mode. See
+// "Fast Almost-Gaussian Filtering", Peter Kovesi, 2010.
+void boxRadii( float radius, int radii[3] )
+{
+	// Matches the filter width we give to the Resample, and the
+	// `exp( -5 x^2 )` falloff of the smoothGaussian filter.
+	const float sigma = ( 1.0f + radius ) / sqrtf( 10.0f );
+	const float variance = sigma * sigma;
+
+	const int n = 3;
+	int wl = (int)floorf( sqrtf( 12.0f * variance / n + 1.0f ) );
+	if( wl % 2 == 0 )
+	{
+		wl--;
+	}
+	const int wu = wl + 2;
+	const float mIdeal = ( 12.0f * variance - n * wl * wl - 4.0f * n * wl - 3.0f * n ) / ( -4.0f * wl - 4.0f );
+	const int m = (int)floorf( mIdeal + 0.5f );
+
+	for( int i = 0; i < n; ++i )
+	{
+		radii[i] = ( ( i < m ? wl : wu ) - 1 ) / 2;
+	}
+}
+
+// Returns the input window needed to compute the specified tile.
+Box2i inputWindow( const V2i &tileOrigin, const int radiiX[3], const int radiiY[3] )
+{
+	const V2i support( radiiX[0] + radiiX[1] + radiiX[2], radiiY[0] + radiiY[1] + radiiY[2] );
+	return Box2i( tileOrigin - support, tileOrigin + V2i( ImagePlug::tileSize() ) + support );
+}
+
+// Box filters `size` values from `in` into `out` using a running sum.
+// Only values with full filter support are output, so `out` receives
+// `size - 2 * radius` values.
+void boxFilter( const float *in, int size, int radius, float *out )
+{
+	const int width = 2 * radius + 1;
+	const float normalisation = 1.0f / width;
+
+	double sum = 0;
+	for( int i = 0; i < width - 1; ++i )
+	{
+		sum += in[i];
+	}
+
+	for( int i = 0, e = size - 2 * radius; i < e; ++i )
+	{
+		sum += in[i + width - 1];
+		out[i] = sum * normalisation;
+		sum -= in[i];
+	}
+}
+
+// As above, but filtering vertically through `height` rows of `width`
+// values, keeping a running sum for every column. Operating on whole
+// rows at a time keeps the inner loops vectorisable.
+void boxFilterRows( const float *in, int width, int height, int radius, float *out, std::vector<double> &sums )
+{
+	const int size = 2 * radius + 1;
+	const float normalisation = 1.0f / size;
+
+	sums.assign( width, 0.0 );
+	for( int r = 0; r < size - 1; ++r )
+	{
+		const float *row = in + r * width;
+		for( int x = 0; x < width; ++x )
+		{
+			sums[x] += row[x];
+		}
+	}
+
+	for( int r = 0, e = height - 2 * radius; r < e; ++r )
+	{
+		const float *add = in + ( r + size - 1 ) * width;
+		const float *subtract = in + r * width;
+		float *o = out + r * width;
+		for( int x = 0; x < width; ++x )
+		{
+			sums[x] += add[x];
+			o[x] = sums[x] * normalisation;
+			sums[x] -= subtract[x];
+		}
+	}
+}
+
+} // namespace
+
+//////////////////////////////////////////////////////////////////////////
+// Blur
+//////////////////////////////////////////////////////////////////////////
+
 IE_CORE_DEFINERUNTIMETYPED( Blur );
 
 size_t Blur::g_firstPlugIndex = 0;
@@ -57,6 +160,7 @@ Blur::Blur( const std::string &name )
 	addChild( new V2fPlug( "radius", Plug::In, V2f( 0 ), V2f( 0 ) ) );
 	addChild( resample->boundingModePlug()->createCounterpart( "boundingMode", Plug::In ) );
 	addChild( new BoolPlug( "expandDataWindow" ) );
+	addChild( new IntPlug( "mode", Plug::In, Accurate, Accurate, Fast ) );
 
 	addChild( new V2fPlug( "__filterWidth", Plug::Out ) );
 
@@ -113,44 +217,54 @@ const Gaffer::BoolPlug *Blur::expandDataWindowPlug() const
 	return getChild<BoolPlug>( g_firstPlugIndex + 2 );
 }
 
+Gaffer::IntPlug *Blur::modePlug()
+{
+	return getChild<IntPlug>( g_firstPlugIndex + 3 );
+}
+
+const Gaffer::IntPlug *Blur::modePlug() const
+{
+	return getChild<IntPlug>( g_firstPlugIndex + 3 );
+}
+
 Gaffer::V2fPlug *Blur::filterWidthPlug()
 {
-	return getChild<V2fPlug>( g_firstPlugIndex + 3 );
+	return getChild<V2fPlug>( g_firstPlugIndex + 4 );
 }
 
 const Gaffer::V2fPlug *Blur::filterWidthPlug() const
 {
-	return getChild<V2fPlug>( g_firstPlugIndex + 3 );
+	return getChild<V2fPlug>( g_firstPlugIndex + 4 );
 }
 
 Gaffer::AtomicBox2iPlug *Blur::resampledDataWindowPlug()
 {
-	return getChild<AtomicBox2iPlug>( g_firstPlugIndex + 4 );
+	return getChild<AtomicBox2iPlug>( g_firstPlugIndex + 5 );
 }
 
 const Gaffer::AtomicBox2iPlug *Blur::resampledDataWindowPlug() const
 {
-	return getChild<AtomicBox2iPlug>( g_firstPlugIndex + 4 );
+	return getChild<AtomicBox2iPlug>( g_firstPlugIndex + 5 );
 }
 
 Gaffer::FloatVectorDataPlug *Blur::resampledChannelDataPlug()
 {
-	return getChild<FloatVectorDataPlug>( g_firstPlugIndex + 5 );
+	return getChild<FloatVectorDataPlug>( g_firstPlugIndex + 6 );
 }
 
 const Gaffer::FloatVectorDataPlug *Blur::resampledChannelDataPlug() const
 {
-	return getChild<FloatVectorDataPlug>( g_firstPlugIndex + 5 );
+	return getChild<FloatVectorDataPlug>( g_firstPlugIndex + 6 );
 }
 
 Resample *Blur::resample()
 {
-	return getChild<Resample>( g_firstPlugIndex + 6 );
+	return getChild<Resample>( g_firstPlugIndex + 7 );
 }
 
 const Resample *Blur::resample() const
 {
-	return getChild<Resample>( g_firstPlugIndex + 6 );
+	return getChild<Resample>( g_firstPlugIndex + 7 );
 }
 
 void Blur::affects( const Gaffer::Plug *input, AffectedPlugsContainer &outputs ) const
@@ -171,7 +285,11 @@ void Blur::affects( const Gaffer::Plug *input, AffectedPlugsContainer &outputs )
 		outputs.push_back( outPlug()->channelDataPlug() );
 	}
 	else if(
-		input == resampledChannelDataPlug()
+		input == resampledChannelDataPlug() ||
+		input == modePlug() ||
+		input == boundingModePlug() ||
+		input == inPlug()->dataWindowPlug() ||
+		input == inPlug()->channelDataPlug()
 	)
 	{
 		outputs.push_back( outPlug()->channelDataPlug() );
@@ -227,24 +345,108 @@ Imath::Box2i Blur::computeDataWindow( const Gaffer::Context *context, const Imag
 
 void Blur::hashChannelData( const GafferImage::ImagePlug *parent, const Gaffer::Context *context, IECore::MurmurHash &h ) const
 {
-	if( radiusPlug()->getValue() != V2f( 0 ) )
+	const V2f radius = radiusPlug()->getValue();
+	if( radius == V2f( 0 ) )
+	{
+		h = inPlug()->channelDataPlug()->hash();
+		return;
+	}
+
+	if( modePlug()->getValue() == Accurate )
 	{
 		h = resampledChannelDataPlug()->hash();
+		return;
 	}
-	else
+
+	ImageProcessor::hashChannelData( parent, context, h );
+
+	int radiiX[3], radiiY[3];
+	boxRadii( radius.x, radiiX );
+	boxRadii( radius.y, radiiY );
+	for( int i = 0; i < 3; ++i )
 	{
-		h = inPlug()->channelDataPlug()->hash();
+		h.append( radiiX[i] );
+		h.append( radiiY[i] );
 	}
+
+	const V2i tileOrigin = context->get<V2i>( ImagePlug::tileOriginContextName );
+	Sampler sampler(
+		inPlug(),
+		context->get<std::string>( ImagePlug::channelNameContextName ),
+		inputWindow( tileOrigin, radiiX, radiiY ),
+		(Sampler::BoundingMode)boundingModePlug()->getValue()
+	);
+	sampler.hash( h );
+	h.append( tileOrigin );
 }
 
 IECore::ConstFloatVectorDataPtr Blur::computeChannelData( const std::string &channelName, const Imath::V2i &tileOrigin, const Gaffer::Context *context, const ImagePlug *parent ) const
 {
-	if( radiusPlug()->getValue() != V2f( 0 ) )
+	const V2f radius = radiusPlug()->getValue();
+	if( radius == V2f( 0 ) )
+	{
+		return inPlug()->channelDataPlug()->getValue();
+	}
+
+	if( modePlug()->getValue() == Accurate )
 	{
 		return resampledChannelDataPlug()->getValue();
 	}
-	else
+
+	// Fast mode. We apply three box filters horizontally to every
+	// input row we need, and then three vertically to the result.
+	// Each box filter uses a running sum, so the cost per pixel is
+	// independent of the radius. Each filter also trims its radius
+	// from either end of its input, leaving exactly one tile after
+	// the last pass.
+
+	int radiiX[3], radiiY[3];
+	boxRadii( radius.x, radiiX );
+	boxRadii( radius.y, radiiY );
+
+	const Box2i window = inputWindow( tileOrigin, radiiX, radiiY );
+	Sampler sampler(
+		inPlug(),
+		channelName,
+		window,
+		(Sampler::BoundingMode)boundingModePlug()->getValue()
+	);
+	sampler.populate();
+
+	const int tileSize = ImagePlug::tileSize();
+	const int width = window.size().x;
+	const int height = window.size().y;
+
+	std::vector<float> horizontal( height * tileSize );
+	std::vector<float> row( width );
+	std::vector<float> scratch( width );
+	for( int y = 0; y < height; ++y )
 	{
-		return inPlug()->channelDataPlug()->getValue();
+		Canceller::check( context->canceller() );
+		sampler.sampleRow( window.min.x, window.min.y + y, width, &row[0] );
+		int size = width;
+		for( int i = 0; i < 3; ++i )
+		{
+			boxFilter( &row[0], size, radiiX[i], &scratch[0] );
+			size -= 2 * radiiX[i];
+			row.swap( scratch );
+		}
+		std::copy( row.begin(), row.begin() + tileSize, horizontal.begin() + y * tileSize );
 	}
+
+	std::vector<float> vertical( height * tileSize );
+	std::vector<double> sums;
+	int rows = height;
+	for( int i = 0; i < 3; ++i )
+	{
+		Canceller::check( context->canceller() );
+		boxFilterRows( &horizontal[0], tileSize, rows, radiiY[i], &vertical[0], sums );
+		rows -= 2 * radiiY[i];
+		horizontal.swap( vertical );
+	}
+
+	FloatVectorDataPtr resultData = new FloatVectorData;
+	horizontal.resize( tileSize * tileSize );
+	resultData->writable().swap( horizontal );
+	return resultData;
 }
@@ -106,7 +106,32 @@ bool ChannelDataProcessor::channelEnabled( const std::string &channel ) const
 
 IECore::ConstFloatVectorDataPtr ChannelDataProcessor::computeChannelData( const std::string &channelName, const Imath::V2i &tileOrigin, const Gaffer::Context *context, const ImagePlug *parent ) const
 {
-	IECore::FloatVectorDataPtr outData = inPlug()->channelData( channelName, tileOrigin )->copy();
+	IECore::ConstFloatVectorDataPtr inData = inPlug()->channelData( channelName, tileOrigin );
+	if( inData.get() == ImagePlug::blackTile() && preservesBlack( context, channelName ) )
+	{
+		return inData;
+	}
+
+	// If nothing other than ourselves holds a reference to the input
+	// tile then it isn't stored in the cache or being used elsewhere,
+	// so we can process it in place. This is the case when the input
+	// plug isn't cacheable. Otherwise we must copy it.
+	IECore::FloatVectorDataPtr outData;
+	if( inData->refCount() == 1 )
+	{
+		outData = const_cast<IECore::FloatVectorData *>( inData.get() );
+	}
+	else
+	{
+		outData = inData->copy();
+	}
+	inData = NULL;
+
 	processChannelData( context, parent, channelName, outData );
 	return outData;
 }
+
+bool ChannelDataProcessor::preservesBlack( const Gaffer::Context *context, const std::string &channel ) const
+{
+	return false;
+}
@@ -218,41 +218,42 @@ void Clamp::processChannelData( const Gaffer::Context *context, const ImagePlug
 	const bool maxClampToEnabled = maxClampToEnabledPlug()->getValue();
 
 	std::vector<float> &out = outData->writable();
+	float *outPtr = &out[0];
+	const int size = out.size();
 
-	std::vector<float>::iterator outDataIterator;
+	// We make all decisions up front, and then apply each clamp
+	// as a separate branchless pass over the tile, so that the
+	// loops can be vectorised by the compiler.
 
-	for (outDataIterator = out.begin(); outDataIterator != out.end(); ++outDataIterator)
+	if( minimumEnabled )
 	{
-
-		if (minimumEnabled)
+		const float minValue = minClampToEnabled ? minClampTo : minimum;
+		for( int i = 0; i < size; ++i )
 		{
-			if (*outDataIterator < minimum)
-			{
-				if (minClampToEnabled)
-				{
-					*outDataIterator = minClampTo;
-				}
-				else
-				{
-					*outDataIterator = minimum;
-				}
-			}
+			outPtr[i] = outPtr[i] < minimum ? minValue : outPtr[i];
 		}
+	}
 
-		if (maximumEnabled)
+	if( maximumEnabled )
+	{
+		const float maxValue = maxClampToEnabled ? maxClampTo : maximum;
+		for( int i = 0; i < size; ++i )
 		{
-			if (*outDataIterator > maximum)
-			{
-				if (maxClampToEnabled)
-				{
-					*outDataIterator = maxClampTo;
-				}
-				else
-				{
-					*outDataIterator = maximum;
-				}
-			}
+			outPtr[i] = outPtr[i] > maximum ? maxValue : outPtr[i];
 		}
+	}
+}
 
+bool Clamp::preservesBlack( const Gaffer::Context *context, const std::string &channel ) const
+{
+	const int channelIndex = std::max( 0, ImageAlgo::colorIndex( channel ) );
+	if( minEnabledPlug()->getValue() && 0.0f < minPlug()->getChild( channelIndex )->getValue() )
+	{
+		return false;
+	}
+	if( maxEnabledPlug()->getValue() && 0.0f > maxPlug()->getChild( channelIndex )->getValue() )
+	{
+		return false;
 	}
+	return true;
 }
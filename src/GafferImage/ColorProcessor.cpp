@@ -123,13 +123,12 @@ void ColorProcessor::compute( Gaffer::ValuePlug *output, const Gaffer::Context *
 	{
 		FloatVectorDataPtr r, g, b;
 		{
-			ContextPtr tmpContext = new Context( *context, Context::Borrowed );
-			Context::Scope scopedContext( tmpContext.get() );
-			tmpContext->set( ImagePlug::channelNameContextName, string( "R" ) );
+			Context::EditableScope scope( context );
+			scope.set( ImagePlug::channelNameContextName, string( "R" ) );
 			r = inPlug()->channelDataPlug()->getValue()->copy();
-			tmpContext->set( ImagePlug::channelNameContextName, string( "G" ) );
+			scope.set( ImagePlug::channelNameContextName, string( "G" ) );
 			g = inPlug()->channelDataPlug()->getValue()->copy();
-			tmpContext->set( ImagePlug::channelNameContextName, string( "B" ) );
+			scope.set( ImagePlug::channelNameContextName, string( "B" ) );
 			b = inPlug()->channelDataPlug()->getValue()->copy();
 		}
 
@@ -154,6 +153,8 @@ void ColorProcessor::hashChannelData( const GafferImage::ImagePlug *output, cons
 	{
 		ImageProcessor::hashChannelData( output, context, h );
 		h.append( channel );
+		Context::EditableScope scope( context );
+		scope.remove( ImagePlug::channelNameContextName );
 		colorDataPlug()->hash( h );
 	}
 	else
@@ -166,7 +167,20 @@ void ColorProcessor::hashChannelData( const GafferImage::ImagePlug *output, cons
 
 IECore::ConstFloatVectorDataPtr ColorProcessor::computeChannelData( const std::string &channelName, const Imath::V2i &tileOrigin, const Gaffer::Context *context, const ImagePlug *parent ) const
 {
-	ConstObjectVectorPtr colorData = boost::static_pointer_cast<const ObjectVector>( colorDataPlug()->getValue() );
+	if( channelName != "R" && channelName != "G" && channelName != "B" )
+	{
+		// ColorProcessor only handles RGB values at present
+		// so we just return the input value otherwise.
+		return inPlug()->channelDataPlug()->getValue();
+	}
+
+	ConstObjectVectorPtr colorData;
+	{
+		Context::EditableScope scope( context );
+		scope.remove( ImagePlug::channelNameContextName );
+		colorData = boost::static_pointer_cast<const ObjectVector>( colorDataPlug()->getValue() );
+	}
+
 	if( channelName == "R" )
 	{
 		return boost::static_pointer_cast<const FloatVectorData>( colorData->members()[0] );
@@ -175,14 +189,10 @@ IECore::ConstFloatVectorDataPtr ColorProcessor::computeChannelData( const std::s
 	{
 		return boost::static_pointer_cast<const FloatVectorData>( colorData->members()[1] );
 	}
-	else if( channelName == "B" )
+	else
 	{
 		return boost::static_pointer_cast<const FloatVectorData>( colorData->members()[2] );
 	}
-
-	// ColorProcessor only handles RGB values at present
-	// so we just return the input value otherwise.
-	return inPlug()->channelDataPlug()->getValue();
 }
 
 bool ColorProcessor::affectsColorData( const Gaffer::Plug *input ) const
@@ -192,12 +202,24 @@ bool ColorProcessor::affectsColorData( const Gaffer::Plug *input ) const
 
 void ColorProcessor::hashColorData( const Gaffer::Context *context, IECore::MurmurHash &h ) const
 {
-	ContextPtr tmpContext = new Context( *context, Context::Borrowed );
-	Context::Scope scopedContext( tmpContext.get() );
-	tmpContext->set( ImagePlug::channelNameContextName, string( "R" ) );
-	inPlug()->channelDataPlug()->hash( h );
-	tmpContext->set( ImagePlug::channelNameContextName, string( "G" ) );
-	inPlug()->channelDataPlug()->hash( h );
-	tmpContext->set( ImagePlug::channelNameContextName, string( "B" ) );
-	inPlug()->channelDataPlug()->hash( h );
+	// Hash all three channels in parallel.
+	static const char *channelNames[] = { "R", "G", "B" };
+	std::vector<ContextPtr> channelContexts;
+	std::vector<const Context *> contexts;
+	std::vector<const ValuePlug *> plugs;
+	for( int i = 0; i < 3; ++i )
+	{
+		ContextPtr c = new Context( *context, Context::Borrowed );
+		c->set( ImagePlug::channelNameContextName, string( channelNames[i] ) );
+		channelContexts.push_back( c );
+		contexts.push_back( c.get() );
+		plugs.push_back( inPlug()->channelDataPlug() );
+	}
+
+	std::vector<IECore::MurmurHash> hashes;
+	ValuePlug::hashes( plugs, contexts, hashes );
+	for( std::vector<IECore::MurmurHash>::const_iterator it = hashes.begin(), eIt = hashes.end(); it != eIt; ++it )
+	{
+		h.append( *it );
+	}
 }
@@ -168,6 +168,17 @@ IECore::ConstFloatVectorDataPtr Constant::computeChannelData( const std::string
 	const int channelIndex = ImageAlgo::colorIndex( context->get<std::string>( ImagePlug::channelNameContextName ) );
 	const float value = colorPlug()->getChild( channelIndex )->getValue();
 
+	// Return the shared tiles where possible, so that
+	// downstream nodes can optimise for them.
+	if( value == 0.0f )
+	{
+		return ImagePlug::blackTile();
+	}
+	else if( value == 1.0f )
+	{
+		return ImagePlug::whiteTile();
+	}
+
 	FloatVectorDataPtr result = new FloatVectorData;
 	result->writable().resize( ImagePlug::tileSize() * ImagePlug::tileSize(), value );
 
@@ -39,6 +39,10 @@
 #include "boost/bind/placeholders.hpp"
 #include "boost/lexical_cast.hpp"
 #include "boost/multi_array.hpp"
+#include "boost/scoped_array.hpp"
+
+#include "tbb/spin_mutex.h"
+#include "tbb/atomic.h"
 
 #include "IECore/LRUCache.h"
 #include "IECore/DisplayDriverServer.h"
@@ -91,7 +95,8 @@ class GafferDisplayDriver : public IECore::DisplayDriver
 			const vector<string> &channelNames, ConstCompoundDataPtr parameters )
 			:	DisplayDriver( displayWindow, dataWindow, channelNames, parameters ),
 				m_gafferFormat( displayWindow, 1, /* fromEXRSpace = */ true ),
-				m_gafferDataWindow( m_gafferFormat.fromEXRSpace( dataWindow ) )
+				m_gafferDataWindow( m_gafferFormat.fromEXRSpace( dataWindow ) ),
+				m_serial( g_serial.fetch_and_increment() )
 		{
 			const V2i dataWindowMinTileIndex = ImagePlug::tileOrigin( m_gafferDataWindow.min ) / ImagePlug::tileSize();
 			const V2i dataWindowMaxTileIndex = ImagePlug::tileOrigin( m_gafferDataWindow.max - Imath::V2i( 1 ) ) / ImagePlug::tileSize();
@@ -103,6 +108,14 @@ class GafferDisplayDriver : public IECore::DisplayDriver
 					[channelNames.size()]
 			);
 
+			m_tileVersions.resize(
+				TileVersionArray::extent_gen()
+					[TileVersionArray::extent_range( dataWindowMinTileIndex.x, dataWindowMaxTileIndex.x + 1 )]
+					[TileVersionArray::extent_range( dataWindowMinTileIndex.y, dataWindowMaxTileIndex.y + 1 )]
+			);
+			std::fill( m_tileVersions.data(), m_tileVersions.data() + m_tileVersions.num_elements(), 0 );
+			m_tileMutexes.reset( new tbb::spin_mutex[m_tileVersions.num_elements()] );
+
 			m_parameters = parameters ? parameters->copy() : CompoundDataPtr( new CompoundData );
 			instanceCreatedSignal()( this );
 		}
@@ -132,29 +145,51 @@ class GafferDisplayDriver : public IECore::DisplayDriver
 
 			const V2i boxMinTileOrigin = ImagePlug::tileOrigin( gafferBox.min );
 			const V2i boxMaxTileOrigin = ImagePlug::tileOrigin( gafferBox.max - Imath::V2i( 1 ) );
+			const int numChannels = channelNames().size();
 			for( int tileOriginY = boxMinTileOrigin.y; tileOriginY <= boxMaxTileOrigin.y; tileOriginY += ImagePlug::tileSize() )
 			{
 				for( int tileOriginX = boxMinTileOrigin.x; tileOriginX <= boxMaxTileOrigin.x; tileOriginX += ImagePlug::tileSize() )
 				{
-					for( int channelIndex = 0, numChannels = channelNames().size(); channelIndex < numChannels; ++channelIndex )
+					const V2i tileOrigin( tileOriginX, tileOriginY );
+					const V2i tileIndex = tileOrigin / ImagePlug::tileSize();
+					if( !tileIndexValid( tileIndex ) )
 					{
-						const V2i tileOrigin( tileOriginX, tileOriginY );
-						ConstFloatVectorDataPtr tileData = getTile( tileOrigin, channelIndex );
+						// we've been sent data outside of the data window
+						continue;
+					}
+
+					const Box2i tileBound( tileOrigin, tileOrigin + Imath::V2i( GafferImage::ImagePlug::tileSize() ) );
+					const Box2i transferBound = IECore::boxIntersection( tileBound, gafferBox );
+
+					// Each tile has its own lock, so buckets arriving concurrently
+					// from several renderer threads only contend when they overlap
+					// the same tile. All channels are transferred under a single
+					// acquisition of the lock.
+					tbb::spin_mutex::scoped_lock tileLock( tileMutex( tileIndex ) );
+
+					for( int channelIndex = 0; channelIndex < numChannels; ++channelIndex )
+					{
+						ConstFloatVectorDataPtr &tileData = m_tiles[tileIndex.x][tileIndex.y][channelIndex];
+
+						// If nothing other than ourselves holds a reference to the tile then
+						// we can update it in place. Otherwise we must create a new object to
+						// hold the updated tile data, because the old one might well have been
+						// returned from computeChannelData and be being held in the cache.
+						FloatVectorDataPtr updatedTileData;
 						if( !tileData )
 						{
-							// we've been sent data outside of the data window
-							continue;
+							updatedTileData = new FloatVectorData( vector<float>( ImagePlug::tileSize() * ImagePlug::tileSize(), 0.0f ) );
+						}
+						else if( tileData->refCount() == 1 )
+						{
+							updatedTileData = const_cast<FloatVectorData *>( tileData.get() );
+						}
+						else
+						{
+							updatedTileData = tileData->copy();
 						}
-
-						// we must create a new object to hold the updated tile data,
-						// because the old one might well have been returned from
-						// computeChannelData and be being held in the cache.
-						FloatVectorDataPtr updatedTileData = tileData->copy();
 						vector<float> &updatedTile = updatedTileData->writable();
 
-						const Box2i tileBound( tileOrigin, tileOrigin + Imath::V2i( GafferImage::ImagePlug::tileSize() ) );
-						const Box2i transferBound = IECore::boxIntersection( tileBound, gafferBox );
-
 						for( int y = transferBound.min.y; y<transferBound.max.y; ++y )
 						{
 							int srcY = m_gafferFormat.toEXRSpace( y );
@@ -169,8 +204,10 @@ class GafferDisplayDriver : public IECore::DisplayDriver
 							}
 						}
 
-						setTile( tileOrigin, channelIndex, updatedTileData );
+						tileData = updatedTileData;
 					}
+
+					m_tileVersions[tileIndex.x][tileIndex.y]++;
 				}
 			}
 
@@ -195,12 +232,14 @@ class GafferDisplayDriver : public IECore::DisplayDriver
 		ConstFloatVectorDataPtr channelData( const Imath::V2i &tileOrigin, const std::string &channelName )
 		{
 			vector<string>::const_iterator cIt = find( channelNames().begin(), channelNames().end(), channelName );
-			if( cIt == channelNames().end() )
+			const V2i tileIndex = tileOrigin / ImagePlug::tileSize();
+			if( cIt == channelNames().end() || !tileIndexValid( tileIndex ) )
 			{
 				return ImagePlug::blackTile();
 			}
 
-			ConstFloatVectorDataPtr tile = getTile( tileOrigin, cIt - channelNames().begin() );
+			tbb::spin_mutex::scoped_lock tileLock( tileMutex( tileIndex ) );
+			ConstFloatVectorDataPtr tile = m_tiles[tileIndex.x][tileIndex.y][cIt - channelNames().begin()];
 			if( tile )
 			{
 				return tile;
@@ -211,6 +250,37 @@ class GafferDisplayDriver : public IECore::DisplayDriver
 			}
 		}
 
+		/// Hashes the tile without touching its data, using a version number
+		/// which is incremented every time a bucket overlaps the tile. This
+		/// keeps the viewer's frequent rehashing cheap, and leaves the hashes
+		/// of untouched tiles unchanged so their textures can be reused.
+		void channelDataHash( const Imath::V2i &tileOrigin, const std::string &channelName, IECore::MurmurHash &h )
+		{
+			vector<string>::const_iterator cIt = find( channelNames().begin(), channelNames().end(), channelName );
+			const V2i tileIndex = tileOrigin / ImagePlug::tileSize();
+			if( cIt == channelNames().end() || !tileIndexValid( tileIndex ) )
+			{
+				h = ImagePlug::blackTileHash();
+				return;
+			}
+
+			unsigned version;
+			{
+				tbb::spin_mutex::scoped_lock tileLock( tileMutex( tileIndex ) );
+				if( !m_tiles[tileIndex.x][tileIndex.y][cIt - channelNames().begin()] )
+				{
+					h = ImagePlug::blackTileHash();
+					return;
+				}
+				version = m_tileVersions[tileIndex.x][tileIndex.y];
+			}
+
+			h.append( m_serial );
+			h.append( tileOrigin );
+			h.append( channelName );
+			h.append( version );
+		}
+
 		typedef boost::signal<void ( GafferDisplayDriver *, const Imath::Box2i & )> DataReceivedSignal;
 		DataReceivedSignal &dataReceivedSignal()
 		{
@@ -234,43 +304,31 @@ class GafferDisplayDriver : public IECore::DisplayDriver
 
 		static const DisplayDriverDescription<GafferDisplayDriver> g_description;
 
-		ConstFloatVectorDataPtr getTile( const V2i &tileOrigin, size_t channelIndex )
+		bool tileIndexValid( const V2i &tileIndex ) const
 		{
-			V2i tileIndex = tileOrigin / ImagePlug::tileSize();
-
-			if(
-				tileIndex.x < m_tiles.index_bases()[0] ||
-				tileIndex.x >= (int)(m_tiles.index_bases()[0] + m_tiles.shape()[0] ) ||
-				tileIndex.y < m_tiles.index_bases()[1] ||
-				tileIndex.y >= (int)(m_tiles.index_bases()[1] + m_tiles.shape()[1] )
-			)
-			{
-				// outside data window
-				return NULL;
-			}
-
-			tbb::spin_rw_mutex::scoped_lock tileLock( m_tileMutex, false /* read */ );
-
-			ConstFloatVectorDataPtr result = m_tiles[tileIndex.x][tileIndex.y][channelIndex];
-			if( !result )
-			{
-				result = ImagePlug::blackTile();
-			}
-
-			return result;
+			return
+				tileIndex.x >= m_tiles.index_bases()[0] &&
+				tileIndex.x < (int)(m_tiles.index_bases()[0] + m_tiles.shape()[0] ) &&
+				tileIndex.y >= m_tiles.index_bases()[1] &&
+				tileIndex.y < (int)(m_tiles.index_bases()[1] + m_tiles.shape()[1] )
+			;
 		}
 
-		void setTile( const V2i &tileOrigin, size_t channelIndex, ConstFloatVectorDataPtr tile )
+		tbb::spin_mutex &tileMutex( const V2i &tileIndex )
 		{
-			V2i tileIndex = tileOrigin / ImagePlug::tileSize();
-			tbb::spin_rw_mutex::scoped_lock tileLock( m_tileMutex, true /* write */ );
-			m_tiles[tileIndex.x][tileIndex.y][channelIndex] = tile;
+			const size_t i =
+				( tileIndex.y - m_tiles.index_bases()[1] ) * m_tiles.shape()[0] +
+				( tileIndex.x - m_tiles.index_bases()[0] );
+			return m_tileMutexes[i];
 		}
 
 		// indexed by tileIndexX, tileIndexY, channelIndex.
 		typedef boost::multi_array<ConstFloatVectorDataPtr, 3> TileArray;
 		TileArray m_tiles;
-		tbb::spin_rw_mutex m_tileMutex;
+		// indexed by tileIndexX, tileIndexY.
+		typedef boost::multi_array<unsigned, 2> TileVersionArray;
+		TileVersionArray m_tileVersions;
+		boost::scoped_array<tbb::spin_mutex> m_tileMutexes;
 
 		Format m_gafferFormat;
 		Imath::Box2i m_gafferDataWindow;
@@ -278,9 +336,15 @@ class GafferDisplayDriver : public IECore::DisplayDriver
 		DataReceivedSignal m_dataReceivedSignal;
 		ImageReceivedSignal m_imageReceivedSignal;
 
+		// Distinguishes the tile hashes of successive drivers,
+		// which may well be allocated at the same address.
+		const unsigned m_serial;
+		static tbb::atomic<unsigned> g_serial;
+
 };
 
 const DisplayDriver::DisplayDriverDescription<GafferDisplayDriver> GafferDisplayDriver::g_description;
+tbb::atomic<unsigned> GafferDisplayDriver::g_serial;
 
 } // namespace GafferImage
 
@@ -462,15 +526,19 @@ IECore::ConstCompoundObjectPtr Display::computeMetadata( const Gaffer::Context *
 
 void Display::hashChannelData( const GafferImage::ImagePlug *output, const Gaffer::Context *context, IECore::MurmurHash &h ) const
 {
-	ConstFloatVectorDataPtr channelData = ImagePlug::blackTile();
 	if( m_driver )
 	{
-		channelData = m_driver->channelData(
+		ImageNode::hashChannelData( output, context, h );
+		m_driver->channelDataHash(
 			context->get<Imath::V2i>( ImagePlug::tileOriginContextName ),
-			context->get<std::string>( ImagePlug::channelNameContextName )
+			context->get<std::string>( ImagePlug::channelNameContextName ),
+			h
 		);
 	}
-	h = channelData->Object::hash();
+	else
+	{
+		h = ImagePlug::blackTileHash();
+	}
 }
 
 IECore::ConstFloatVectorDataPtr Display::computeChannelData( const std::string &channelName, const Imath::V2i &tileOrigin, const Gaffer::Context *context, const ImagePlug *parent ) const
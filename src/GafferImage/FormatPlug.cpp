@@ -42,6 +42,7 @@
 
 #include "GafferImage/FormatPlug.h"
 #include "GafferImage/FormatData.h"
+#include "GafferImage/ImagePlug.h"
 
 using namespace Gaffer;
 using namespace GafferImage;
@@ -52,6 +53,8 @@ const IECore::InternedString g_defaultFormatContextName( "image:defaultFormat" )
 static const IECore::InternedString g_defaultFormatPlugName( "defaultFormat" );
 static const Format g_defaultFormatFallback( 1920, 1080 );
 
+const IECore::InternedString FormatPlug::proxyLevelContextName( "image:proxyLevel" );
+
 FormatPlug::FormatPlug( const std::string &name, Direction direction, Format defaultValue, unsigned flags )
 	:	ValuePlug( name, direction, flags ), m_defaultValue( defaultValue )
 {
@@ -105,12 +108,34 @@ void FormatPlug::setValue( const Format &value )
 	pixelAspectPlug()->setValue( value.getPixelAspect() );
 }
 
+namespace
+{
+
+// We only apply the proxy level to formats authored by the user
+// (directly or via an expression). Formats coming from the output
+// of an image have been computed by an upstream node, which is
+// responsible for having applied the proxy level already.
+bool sourceIsImage( const FormatPlug *plug )
+{
+	const FormatPlug *source = plug->source<FormatPlug>();
+	return source->direction() == Plug::Out && source->parent<ImagePlug>();
+}
+
+} // namespace
+
 Format FormatPlug::getValue() const
 {
 	Format result( displayWindowPlug()->getValue(), pixelAspectPlug()->getValue() );
-	if( direction() == Plug::In && result.getDisplayWindow().isEmpty() && Process::current() )
+	if( direction() == Plug::In && Process::current() )
 	{
-		return getDefaultFormat( Context::current() );
+		if( result.getDisplayWindow().isEmpty() )
+		{
+			return getDefaultFormat( Context::current() );
+		}
+		else if( !sourceIsImage( this ) )
+		{
+			return proxyFormat( result, getProxyLevel( Context::current() ) );
+		}
 	}
 	return result;
 }
@@ -124,6 +149,10 @@ IECore::MurmurHash FormatPlug::hash() const
 		{
 			v = getDefaultFormat( Context::current() );
 		}
+		else if( !sourceIsImage( this ) )
+		{
+			v = proxyFormat( v, getProxyLevel( Context::current() ) );
+		}
 
 		IECore::MurmurHash result;
 		result.append( v.getDisplayWindow() );
@@ -136,7 +165,8 @@ IECore::MurmurHash FormatPlug::hash() const
 
 Format FormatPlug::getDefaultFormat( const Gaffer::Context *context )
 {
-	return context->get<Format>( g_defaultFormatContextName, g_defaultFormatFallback );
+	const Format result = context->get<Format>( g_defaultFormatContextName, g_defaultFormatFallback );
+	return proxyFormat( result, getProxyLevel( context ) );
 }
 
 void FormatPlug::setDefaultFormat( Gaffer::Context *context, const Format &format )
@@ -144,6 +174,51 @@ void FormatPlug::setDefaultFormat( Gaffer::Context *context, const Format &forma
 	context->set( g_defaultFormatContextName, format );
 }
 
+int FormatPlug::getProxyLevel( const Gaffer::Context *context )
+{
+	const int proxyLevel = context->get<int>( proxyLevelContextName, 0 );
+	return std::max( 0, std::min( proxyLevel, (int)maxProxyLevel ) );
+}
+
+void FormatPlug::setProxyLevel( Gaffer::Context *context, int proxyLevel )
+{
+	context->set( proxyLevelContextName, proxyLevel );
+}
+
+Format FormatPlug::proxyFormat( const Format &format, int proxyLevel )
+{
+	if( proxyLevel <= 0 || format.getDisplayWindow().isEmpty() )
+	{
+		return format;
+	}
+	return Format( proxyWindow( format.getDisplayWindow(), proxyLevel ), format.getPixelAspect() );
+}
+
+namespace
+{
+
+// Division rounding towards negative infinity.
+int floorDivide( int a, int b )
+{
+	return a >= 0 ? a / b : -( ( -a + b - 1 ) / b );
+}
+
+} // namespace
+
+Imath::Box2i FormatPlug::proxyWindow( const Imath::Box2i &window, int proxyLevel )
+{
+	if( proxyLevel <= 0 || window.isEmpty() )
+	{
+		return window;
+	}
+
+	const int factor = 1 << proxyLevel;
+	return Imath::Box2i(
+		Imath::V2i( floorDivide( window.min.x, factor ), floorDivide( window.min.y, factor ) ),
+		Imath::V2i( -floorDivide( -window.max.x, factor ), -floorDivide( -window.max.y, factor ) )
+	);
+}
+
 FormatPlug *FormatPlug::acquireDefaultFormatPlug( Gaffer::ScriptNode *scriptNode )
 {
 	if( FormatPlug *p = scriptNode->getChild<FormatPlug>( g_defaultFormatPlugName ) )
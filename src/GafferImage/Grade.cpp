@@ -252,26 +252,52 @@ void Grade::processChannelData( const Gaffer::Context *context, const ImagePlug
 	const bool whiteClamp = whiteClampPlug()->getValue();
 	const bool blackClamp = blackClampPlug()->getValue();
 
-	// Get some useful pointers.
+	// As the input has been copied to outData, we grade in place.
+	// Each stage is performed as a separate pass over the tile, with
+	// any decisions made up front, so that the loops contain no branches
+	// and can be vectorised by the compiler.
 	float *outPtr = &(outData->writable()[0]);
-	const float *END = outPtr + dataWidth;
 
-	while (outPtr != END)
+	for( int i = 0; i < dataWidth; ++i )
 	{
-		// Calculate the colour of the graded pixel.
-		float colour = *outPtr;	// As the input has been copied to outData, grab the input colour from there.
-		const float c = A * colour + B;
-		colour = ( c >= 0.f && invGamma != 1.f ? (float)pow( c, invGamma ) : c );
+		outPtr[i] = A * outPtr[i] + B;
+	}
 
-		// Clamp the white and blacks if necessary.
-		if ( blackClamp && colour < 0.f ) colour = 0.f;
-		if ( whiteClamp && colour > 1.f ) colour = 1.f;
+	if( invGamma != 1.0f )
+	{
+		for( int i = 0; i < dataWidth; ++i )
+		{
+			const float c = outPtr[i];
+			outPtr[i] = c >= 0.0f ? (float)pow( c, invGamma ) : c;
+		}
+	}
+
+	if( blackClamp )
+	{
+		for( int i = 0; i < dataWidth; ++i )
+		{
+			outPtr[i] = std::max( outPtr[i], 0.0f );
+		}
+	}
 
-		// Write back the result.
-		*outPtr++ = colour;
+	if( whiteClamp )
+	{
+		for( int i = 0; i < dataWidth; ++i )
+		{
+			outPtr[i] = std::min( outPtr[i], 1.0f );
+		}
 	}
 }
 
+bool Grade::preservesBlack( const Gaffer::Context *context, const std::string &channel ) const
+{
+	// Black is mapped to `B`, and then neither the gamma
+	// nor the clamping can change zero to anything else.
+	float A, B, gamma;
+	parameters( std::max( 0, ImageAlgo::colorIndex( channel ) ), A, B, gamma );
+	return B == 0.0f;
+}
+
 void Grade::parameters( size_t channelIndex, float &a, float &b, float &gamma ) const
 {
 	gamma = gammaPlug()->getChild( channelIndex )->getValue();
@@ -35,6 +35,12 @@
 //
 //////////////////////////////////////////////////////////////////////////
 
+#include <stdlib.h>
+
+#include "boost/format.hpp"
+
+#include "IECore/MessageHandler.h"
+
 #include "Gaffer/Context.h"
 
 #include "GafferImage/ImagePlug.h"
@@ -213,6 +219,25 @@ ImagePlug::~ImagePlug()
 {
 }
 
+int ImagePlug::tileSizeFromEnvironment()
+{
+	const int defaultTileSize = 64;
+	const char *s = getenv( "GAFFERIMAGE_TILESIZE" );
+	if( !s )
+	{
+		return defaultTileSize;
+	}
+
+	const int tileSize = atoi( s );
+	if( tileSize < 16 || tileSize > 1024 || ( tileSize & ( tileSize - 1 ) ) )
+	{
+		msg( Msg::Warning, "ImagePlug::tileSize", boost::format( "Invalid GAFFERIMAGE_TILESIZE \"%s\" - using %d" ) % s % defaultTileSize );
+		return defaultTileSize;
+	}
+
+	return tileSize;
+}
+
 const IECore::FloatVectorData *ImagePlug::whiteTile()
 {
 	static IECore::ConstFloatVectorDataPtr g_whiteTile( new IECore::FloatVectorData( std::vector<float>( ImagePlug::tileSize()*ImagePlug::tileSize(), 1. ) ) );
@@ -225,6 +250,18 @@ const IECore::FloatVectorData *ImagePlug::blackTile()
 	return g_blackTile.get();
 };
 
+const IECore::MurmurHash &ImagePlug::whiteTileHash()
+{
+	static const IECore::MurmurHash g_whiteTileHash = whiteTile()->Object::hash();
+	return g_whiteTileHash;
+}
+
+const IECore::MurmurHash &ImagePlug::blackTileHash()
+{
+	static const IECore::MurmurHash g_blackTileHash = blackTile()->Object::hash();
+	return g_blackTileHash;
+}
+
 bool ImagePlug::acceptsChild( const GraphComponent *potentialChild ) const
 {
 	if( !ValuePlug::acceptsChild( potentialChild ) )
@@ -309,20 +346,18 @@ IECore::ConstFloatVectorDataPtr ImagePlug::channelData( const std::string &chann
 		return channelDataPlug()->defaultValue();
 	}
 
-	ContextPtr tmpContext = new Context( *Context::current(), Context::Borrowed );
-	tmpContext->set( ImagePlug::channelNameContextName, channelName );
-	tmpContext->set( ImagePlug::tileOriginContextName, tile );
-	Context::Scope scopedContext( tmpContext.get() );
+	Context::EditableScope tmpContext( Context::current() );
+	tmpContext.set( ImagePlug::channelNameContextName, channelName );
+	tmpContext.set( ImagePlug::tileOriginContextName, tile );
 
 	return channelDataPlug()->getValue();
 }
 
 IECore::MurmurHash ImagePlug::channelDataHash( const std::string &channelName, const Imath::V2i &tile ) const
 {
-	ContextPtr tmpContext = new Context( *Context::current(), Context::Borrowed );
-	tmpContext->set( ImagePlug::channelNameContextName, channelName );
-	tmpContext->set( ImagePlug::tileOriginContextName, tile );
-	Context::Scope scopedContext( tmpContext.get() );
+	Context::EditableScope tmpContext( Context::current() );
+	tmpContext.set( ImagePlug::channelNameContextName, channelName );
+	tmpContext.set( ImagePlug::tileOriginContextName, tile );
 	return channelDataPlug()->hash();
 }
 
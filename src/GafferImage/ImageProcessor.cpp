@@ -188,3 +188,26 @@ void ImageProcessor::compute( ValuePlug *output, const Context *context ) const
 		ImageNode::compute( output, context );
 	}
 }
+
+const ValuePlug *ImageProcessor::passThrough( const ValuePlug *output, const Context *context ) const
+{
+	const ImagePlug *imagePlug = output->parent<ImagePlug>();
+	if( !imagePlug )
+	{
+		return ImageNode::passThrough( output, context );
+	}
+
+	bool passThrough = !enabled();
+	if( !passThrough && output == imagePlug->channelDataPlug() )
+	{
+		const std::string &channel = context->get<std::string>( ImagePlug::channelNameContextName );
+		passThrough = !channelEnabled( channel );
+	}
+
+	if( passThrough )
+	{
+		return inPlug()->getChild<ValuePlug>( output->getName() );
+	}
+
+	return ImageNode::passThrough( output, context );
+}
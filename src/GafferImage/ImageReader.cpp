@@ -103,6 +103,13 @@ ImageReader::ImageReader( const std::string &name )
 	colorSpace->inputSpacePlug()->setInput( intermediateColorSpacePlug() );
 	colorSpace->outputSpacePlug()->setValue( OpenColorIO::ROLE_SCENE_LINEAR );
 	intermediateImagePlug()->setInput( colorSpace->outPlug() );
+
+	// Our channel data is just a view onto tiles which are already
+	// cached upstream, as part of the multi-channel tile batch read by
+	// the OpenImageIOReader or the colour-converted RGB data stored by
+	// the ColorSpace. Caching it again here would double the memory
+	// used per plate for no benefit.
+	outPlug()->channelDataPlug()->setFlags( Plug::Cacheable, false );
 }
 
 ImageReader::~ImageReader()
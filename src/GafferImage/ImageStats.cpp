@@ -43,10 +43,134 @@
 #include "GafferImage/ChannelMaskPlug.h"
 #include "GafferImage/FormatPlug.h"
 #include "GafferImage/ImageAlgo.h"
+#include "GafferImage/BufferAlgo.h"
 
+using namespace Imath;
+using namespace IECore;
 using namespace GafferImage;
 using namespace Gaffer;
 
+//////////////////////////////////////////////////////////////////////////
+// Utilities
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+// Layout of the values in the __allStats plug.
+enum StatsOffset
+{
+	MinOffset = 0,
+	MaxOffset = 4,
+	AverageOffset = 8,
+	NumStats = 12
+};
+
+struct TileStats
+{
+
+	TileStats()
+		:	min( limits<float>::max() ), max( -limits<float>::max() ), sum( 0 )
+	{
+	}
+
+	float min;
+	float max;
+	double sum;
+
+};
+
+// Computes the statistics for the portion of a single tile
+// which lies within the region of interest. Used with
+// ImageAlgo::parallelGatherTiles().
+struct TileStatsFunctor
+{
+
+	typedef TileStats Result;
+
+	TileStatsFunctor( const Box2i &window )
+		:	m_window( window )
+	{
+	}
+
+	Result operator()( const ImagePlug *imagePlug, const std::string &channelName, const V2i &tileOrigin )
+	{
+		const Box2i tileBound( tileOrigin, tileOrigin + V2i( ImagePlug::tileSize() ) );
+		const Box2i b = BufferAlgo::intersection( tileBound, m_window );
+
+		Result result;
+		if( BufferAlgo::empty( b ) )
+		{
+			return result;
+		}
+
+		ConstFloatVectorDataPtr channelData = imagePlug->channelDataPlug()->getValue();
+		const std::vector<float> &data = channelData->readable();
+
+		if( b == tileBound )
+		{
+			// Tile is entirely within the window, so we can
+			// just run through the whole array in one go.
+			for( std::vector<float>::const_iterator it = data.begin(), eIt = data.end(); it != eIt; ++it )
+			{
+				result.min = std::min( *it, result.min );
+				result.max = std::max( *it, result.max );
+				result.sum += *it;
+			}
+			return result;
+		}
+
+		for( int y = b.min.y; y < b.max.y; ++y )
+		{
+			const float *v = &data[BufferAlgo::index( V2i( b.min.x, y ), tileBound )];
+			for( int x = b.min.x; x < b.max.x; ++x, ++v )
+			{
+				result.min = std::min( *v, result.min );
+				result.max = std::max( *v, result.max );
+				result.sum += *v;
+			}
+		}
+
+		return result;
+	}
+
+	private :
+
+		const Box2i m_window;
+
+};
+
+// Accumulates the per-tile statistics into per-channel statistics.
+struct GatherStatsFunctor
+{
+
+	GatherStatsFunctor( const std::vector<std::string> &channelNames, TileStats *stats )
+		:	m_channelNames( channelNames ), m_stats( stats )
+	{
+	}
+
+	void operator()( const ImagePlug *imagePlug, const std::string &channelName, const V2i &tileOrigin, const TileStats &tileStats )
+	{
+		const size_t i = std::find( m_channelNames.begin(), m_channelNames.end(), channelName ) - m_channelNames.begin();
+		TileStats &stats = m_stats[i];
+		stats.min = std::min( stats.min, tileStats.min );
+		stats.max = std::max( stats.max, tileStats.max );
+		stats.sum += tileStats.sum;
+	}
+
+	private :
+
+		const std::vector<std::string> &m_channelNames;
+		TileStats *m_stats;
+
+};
+
+} // namespace
+
+//////////////////////////////////////////////////////////////////////////
+// ImageStats
+//////////////////////////////////////////////////////////////////////////
+
 IE_CORE_DEFINERUNTIMETYPED( ImageStats );
 
 size_t ImageStats::g_firstPlugIndex = 0;
@@ -68,6 +192,7 @@ ImageStats::ImageStats( const std::string &name )
 	addChild( new Color4fPlug( "average", Gaffer::Plug::Out ) );
 	addChild( new Color4fPlug( "min", Gaffer::Plug::Out ) );
 	addChild( new Color4fPlug( "max", Gaffer::Plug::Out ) );
+	addChild( new FloatVectorDataPlug( "__allStats", Gaffer::Plug::Out, new FloatVectorData() ) );
 }
 
 ImageStats::~ImageStats()
@@ -134,6 +259,16 @@ const Color4fPlug *ImageStats::maxPlug() const
 	return getChild<Color4fPlug>( g_firstPlugIndex + 5 );
 }
 
+FloatVectorDataPlug *ImageStats::allStatsPlug()
+{
+	return getChild<FloatVectorDataPlug>( g_firstPlugIndex + 6 );
+}
+
+const FloatVectorDataPlug *ImageStats::allStatsPlug() const
+{
+	return getChild<FloatVectorDataPlug>( g_firstPlugIndex + 6 );
+}
+
 void ImageStats::parentChanging( Gaffer::GraphComponent *newParent )
 {
 	ComputeNode::parentChanging( newParent );
@@ -160,6 +295,10 @@ void ImageStats::affects( const Gaffer::Plug *input, AffectedPlugsContainer &out
 			input->parent<ImagePlug>() == inPlug() ||
 			regionOfInterestPlug()->isAncestorOf( input )
 	   )
+	{
+		outputs.push_back( allStatsPlug() );
+	}
+	else if( input == allStatsPlug() )
 	{
 		for( unsigned int i = 0; i < 4; ++i )
 		{
@@ -167,7 +306,6 @@ void ImageStats::affects( const Gaffer::Plug *input, AffectedPlugsContainer &out
 			outputs.push_back( averagePlug()->getChild(i) );
 			outputs.push_back( maxPlug()->getChild(i) );
 		}
-		return;
 	}
 }
 
@@ -175,66 +313,40 @@ void ImageStats::hash( const ValuePlug *output, const Context *context, IECore::
 {
 	ComputeNode::hash( output, context, h);
 
-	bool earlyOut = true;
-	for( int i = 0; i < 4; ++i )
+	if( output == allStatsPlug() )
 	{
-		if (
-				output == minPlug()->getChild(i) ||
-				output == maxPlug()->getChild(i) ||
-				output == averagePlug()->getChild(i)
-		   )
+		regionOfInterestPlug()->hash( h );
+		inPlug()->channelNamesPlug()->hash( h );
+		inPlug()->dataWindowPlug()->hash( h );
+
+		const Box2i regionOfInterest( regionOfInterestPlug()->getValue() );
+		if( BufferAlgo::empty( regionOfInterest ) )
 		{
-			earlyOut = false;
-			break;
+			return;
 		}
-	}
-	if( earlyOut )
-	{
-		return;
-	}
-
-	const Imath::Box2i regionOfInterest( regionOfInterestPlug()->getValue() );
-	regionOfInterestPlug()->hash( h );
-	inPlug()->channelNamesPlug()->hash( h );
-	inPlug()->dataWindowPlug()->hash( h );
-
-	IECore::ConstStringVectorDataPtr channelNamesData = inPlug()->channelNamesPlug()->getValue();
-	std::vector<std::string> maskChannels = channelNamesData->readable();
-	channelsPlug()->maskChannels( maskChannels );
-	const int nChannels( maskChannels.size() );
 
-	if ( nChannels > 0 )
-	{
-		std::vector<std::string> uniqueChannels = maskChannels;
-		GafferImage::ChannelMaskPlug::removeDuplicateIndices( uniqueChannels );
-		std::string channel;
-		channelNameFromOutput( output, channel );
-
-		if ( !channel.empty() )
+		std::string channels[4];
+		statsChannels( channels );
+		for( int i = 0; i < 4; ++i )
 		{
-			h.append( channel );
-			Sampler s( inPlug(), channel, regionOfInterest );
-			s.hash( h );
-			return;
+			h.append( channels[i] );
+			if( !channels[i].empty() )
+			{
+				Sampler s( inPlug(), channels[i], regionOfInterest );
+				s.hash( h );
+			}
 		}
+		return;
 	}
 
-	// If our node is not enabled then we just append the default value that we will give the plug.
-	if(
-			output == maxPlug()->getChild(3) ||
-			output == minPlug()->getChild(3) ||
-			output == averagePlug()->getChild(3)
-	  )
-	{
-		h.append( 0 );
-	}
-	else
+	const GraphComponent *parent = output->parent<GraphComponent>();
+	if( parent == minPlug() || parent == maxPlug() || parent == averagePlug() )
 	{
-		h.append( 1 );
+		allStatsPlug()->hash( h );
 	}
 }
 
-void ImageStats::channelNameFromOutput( const ValuePlug *output, std::string &channelName ) const
+void ImageStats::statsChannels( std::string channels[4] ) const
 {
 	IECore::ConstStringVectorDataPtr channelNamesData = inPlug()->channelNamesPlug()->getValue();
 	std::vector<std::string> maskChannels = channelNamesData->readable();
@@ -243,99 +355,112 @@ void ImageStats::channelNameFromOutput( const ValuePlug *output, std::string &ch
 	/// As the channelMaskPlug allows any combination of channels to be input we need to make sure that
 	/// the channels that it masks each have a distinct channelIndex. Otherwise multiple channels would be
 	/// outputting to the same plug.
-	std::vector<std::string> uniqueChannels = maskChannels;
-	GafferImage::ChannelMaskPlug::removeDuplicateIndices( uniqueChannels );
+	GafferImage::ChannelMaskPlug::removeDuplicateIndices( maskChannels );
 
-	for( int channelIndex = 0; channelIndex < 4; ++channelIndex )
+	for( std::vector<std::string>::const_iterator it = maskChannels.begin(), eIt = maskChannels.end(); it != eIt; ++it )
 	{
-		if ( output == minPlug()->getChild( channelIndex ) ||
-			 output == maxPlug()->getChild( channelIndex ) ||
-			 output == averagePlug()->getChild( channelIndex )
-		   )
+		const int channelIndex = ImageAlgo::colorIndex( *it );
+		if( channelIndex >= 0 && channels[channelIndex].empty() )
 		{
-			for( std::vector<std::string>::iterator it( uniqueChannels.begin() ); it != uniqueChannels.end(); ++it )
-			{
-				if( ImageAlgo::colorIndex( *it ) == channelIndex )
-				{
-					channelName = *it;
-					return;
-				}
-			}
+			channels[channelIndex] = *it;
 		}
 	}
-	return;
-}
-
-void ImageStats::setOutputToDefault( FloatPlug *output ) const
-{
-	if (
-			output == minPlug()->getChild(3) ||
-			output == maxPlug()->getChild(3) ||
-			output == averagePlug()->getChild(3)
-	   )
-	{
-		output->setValue( 1. );
-	}
-	else
-	{
-		output->setValue( 0. );
-	}
 }
 
 void ImageStats::compute( ValuePlug *output, const Context *context ) const
 {
-	const Imath::Box2i &regionOfInterest( regionOfInterestPlug()->getValue() );
-	if( regionOfInterest.isEmpty() )
+	if( output == allStatsPlug() )
 	{
-		setOutputToDefault( static_cast<FloatPlug*>( output ) );
-		return;
-	}
+		// Start with the defaults we output for missing channels.
+		FloatVectorDataPtr resultData = new FloatVectorData;
+		std::vector<float> &result = resultData->writable();
+		result.resize( NumStats, 0.0f );
+		result[MinOffset+3] = result[MaxOffset+3] = result[AverageOffset+3] = 1.0f;
+
+		const Box2i regionOfInterest( regionOfInterestPlug()->getValue() );
+		if( BufferAlgo::empty( regionOfInterest ) )
+		{
+			static_cast<FloatVectorDataPlug *>( output )->setValue( resultData );
+			return;
+		}
 
-	std::string channelName;
-	channelNameFromOutput( output, channelName );
-	if ( channelName.empty() )
-	{
-		setOutputToDefault( static_cast<FloatPlug*>( output ) );
-		return;
-	}
+		std::string channels[4];
+		statsChannels( channels );
+
+		std::vector<std::string> channelNames;
+		std::vector<int> channelIndices;
+		for( int i = 0; i < 4; ++i )
+		{
+			if( !channels[i].empty() )
+			{
+				channelNames.push_back( channels[i] );
+				channelIndices.push_back( i );
+			}
+		}
 
-	const int channelIndex = ImageAlgo::colorIndex( channelName );
+		if( channelNames.empty() )
+		{
+			static_cast<FloatVectorDataPlug *>( output )->setValue( resultData );
+			return;
+		}
 
-	// Loop over the ROI and compute the min, max and average channel values and then set our outputs.
-	Sampler s( inPlug(), channelName, regionOfInterest );
+		// Compute statistics for all channels and all tiles in parallel,
+		// accessing the tile data directly. Pixels in the region of interest
+		// but outside the data window are black, so contribute nothing to
+		// the sum but may affect the min and max.
 
-	float min = Imath::limits<float>::max();
-	float max = Imath::limits<float>::min();
+		const Box2i dataWindow = inPlug()->dataWindowPlug()->getValue();
+		const Box2i window = BufferAlgo::intersection( regionOfInterest, dataWindow );
 
-	float average = 0.f;
+		std::vector<TileStats> stats( channelNames.size() );
+		if( !BufferAlgo::empty( window ) )
+		{
+			TileStatsFunctor tileStatsFunctor( window );
+			GatherStatsFunctor gatherStatsFunctor( channelNames, &stats[0] );
+			ImageAlgo::parallelGatherTiles( inPlug(), channelNames, tileStatsFunctor, gatherStatsFunctor, window );
+		}
 
-	double sum = 0.;
-	for( int y = regionOfInterest.min.y; y < regionOfInterest.max.y; ++y )
-	{
-		for( int x = regionOfInterest.min.x; x < regionOfInterest.max.x; ++x )
+		const bool outsideDataWindow = window != regionOfInterest;
+		const double numPixels = double( regionOfInterest.size().x ) * double( regionOfInterest.size().y );
+		for( size_t i = 0; i < channelNames.size(); ++i )
 		{
-			float v = s.sample( x, y );
-			min = std::min( v, min );
-			max = std::max( v, max );
-			sum += v;
+			const int channelIndex = channelIndices[i];
+			if( outsideDataWindow )
+			{
+				stats[i].min = std::min( stats[i].min, 0.0f );
+				stats[i].max = std::max( stats[i].max, 0.0f );
+			}
+			result[MinOffset+channelIndex] = stats[i].min;
+			result[MaxOffset+channelIndex] = stats[i].max;
+			result[AverageOffset+channelIndex] = stats[i].sum / numPixels;
 		}
+
+		static_cast<FloatVectorDataPlug *>( output )->setValue( resultData );
+		return;
 	}
-	average = sum / double( (regionOfInterest.size().x) * (regionOfInterest.size().y) );
 
-	if ( minPlug()->getChild( channelIndex ) == output )
+	const GraphComponent *parent = output->parent<GraphComponent>();
+	int offset = -1;
+	if( parent == minPlug() )
 	{
-		static_cast<FloatPlug *>( output )->setValue( min );
+		offset = MinOffset;
 	}
-	else if ( maxPlug()->getChild( channelIndex ) == output )
+	else if( parent == maxPlug() )
 	{
-		static_cast<FloatPlug *>( output )->setValue( max );
+		offset = MaxOffset;
 	}
-	else if ( averagePlug()->getChild( channelIndex ) == output )
+	else if( parent == averagePlug() )
 	{
-		static_cast<FloatPlug *>( output )->setValue( average );
+		offset = AverageOffset;
 	}
-	else
+
+	if( offset < 0 )
 	{
-		static_cast<FloatPlug *>( output )->setValue( 0 );
+		ComputeNode::compute( output, context );
+		return;
 	}
+
+	ConstFloatVectorDataPtr allStatsData = allStatsPlug()->getValue();
+	const size_t channelIndex = std::find( parent->children().begin(), parent->children().end(), output ) - parent->children().begin();
+	static_cast<FloatPlug *>( output )->setValue( allStatsData->readable()[offset+channelIndex] );
 }
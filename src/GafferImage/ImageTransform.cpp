@@ -34,6 +34,10 @@
 //
 //////////////////////////////////////////////////////////////////////////
 
+#include "boost/bind.hpp"
+
+#include "OpenEXR/ImathMatrixAlgo.h"
+
 #include "IECore/AngleConversion.h"
 
 #include "Gaffer/Context.h"
@@ -98,6 +102,7 @@ ImageTransform::ImageTransform( const std::string &name )
 
 	addChild( new Gaffer::Transform2DPlug( "transform" ) );
 	addChild( new StringPlug( "filter", Plug::In, "cubic" ) );
+	addChild( new BoolPlug( "concatenate", Plug::In, true, Plug::Default & ~Plug::AcceptsInputs ) );
 
 	// We use an internal Resample node to do filtered
 	// sampling of the translate and scale in one. Then,
@@ -110,7 +115,19 @@ ImageTransform::ImageTransform( const std::string &name )
 	ResamplePtr resample = new Resample( "__resample" );
 	addChild( resample );
 
-	resample->inPlug()->setInput( inPlug() );
+	// When the input is provided directly by another ImageTransform,
+	// we can concatenate with it, sampling from its input with the
+	// combined matrix. This avoids the softening and expense of
+	// filtering the image twice. The connections for this are made
+	// in updateConcatenation().
+
+	addChild( new M33fPlug( "__concatenatedMatrix", Plug::Out ) );
+	addChild( new ImagePlug( "__concatenatedIn", Plug::In, Plug::Default & ~Plug::Serialisable ) );
+	addChild( new M33fPlug( "__upstreamMatrix", Plug::In, M33f(), Plug::Default & ~Plug::Serialisable ) );
+
+	concatenatedInPlug()->setInput( inPlug() );
+
+	resample->inPlug()->setInput( concatenatedInPlug() );
 	resample->filterPlug()->setInput( filterPlug() );
 	resample->matrixPlug()->setInput( resampleMatrixPlug() );
 	resampledInPlug()->setInput( resample->outPlug() );
@@ -119,6 +136,9 @@ ImageTransform::ImageTransform( const std::string &name )
 	outPlug()->formatPlug()->setInput( inPlug()->formatPlug() );
 	outPlug()->metadataPlug()->setInput( inPlug()->metadataPlug() );
 	outPlug()->channelNamesPlug()->setInput( inPlug()->channelNamesPlug() );
+
+	plugInputChangedSignal().connect( boost::bind( &ImageTransform::plugInputChanged, this, ::_1 ) );
+	plugSetSignal().connect( boost::bind( &ImageTransform::plugSet, this, ::_1 ) );
 }
 
 ImageTransform::~ImageTransform()
@@ -145,34 +165,74 @@ const Gaffer::StringPlug *ImageTransform::filterPlug() const
 	return getChild<StringPlug>( g_firstPlugIndex + 1 );
 }
 
+Gaffer::BoolPlug *ImageTransform::concatenatePlug()
+{
+	return getChild<BoolPlug>( g_firstPlugIndex + 2 );
+}
+
+const Gaffer::BoolPlug *ImageTransform::concatenatePlug() const
+{
+	return getChild<BoolPlug>( g_firstPlugIndex + 2 );
+}
+
 Gaffer::M33fPlug *ImageTransform::resampleMatrixPlug()
 {
-	return getChild<M33fPlug>( g_firstPlugIndex + 2 );
+	return getChild<M33fPlug>( g_firstPlugIndex + 3 );
 }
 
 const Gaffer::M33fPlug *ImageTransform::resampleMatrixPlug() const
 {
-	return getChild<M33fPlug>( g_firstPlugIndex + 2 );
+	return getChild<M33fPlug>( g_firstPlugIndex + 3 );
 }
 
 ImagePlug *ImageTransform::resampledInPlug()
 {
-	return getChild<ImagePlug>( g_firstPlugIndex + 3 );
+	return getChild<ImagePlug>( g_firstPlugIndex + 4 );
 }
 
 const ImagePlug *ImageTransform::resampledInPlug() const
 {
-	return getChild<ImagePlug>( g_firstPlugIndex + 3 );
+	return getChild<ImagePlug>( g_firstPlugIndex + 4 );
 }
 
 Resample *ImageTransform::resample()
 {
-	return getChild<Resample>( g_firstPlugIndex + 4 );
+	return getChild<Resample>( g_firstPlugIndex + 5 );
 }
 
 const Resample *ImageTransform::resample() const
 {
-	return getChild<Resample>( g_firstPlugIndex + 4 );
+	return getChild<Resample>( g_firstPlugIndex + 5 );
+}
+
+Gaffer::M33fPlug *ImageTransform::concatenatedMatrixPlug()
+{
+	return getChild<M33fPlug>( g_firstPlugIndex + 6 );
+}
+
+const Gaffer::M33fPlug *ImageTransform::concatenatedMatrixPlug() const
+{
+	return getChild<M33fPlug>( g_firstPlugIndex + 6 );
+}
+
+ImagePlug *ImageTransform::concatenatedInPlug()
+{
+	return getChild<ImagePlug>( g_firstPlugIndex + 7 );
+}
+
+const ImagePlug *ImageTransform::concatenatedInPlug() const
+{
+	return getChild<ImagePlug>( g_firstPlugIndex + 7 );
+}
+
+Gaffer::M33fPlug *ImageTransform::upstreamMatrixPlug()
+{
+	return getChild<M33fPlug>( g_firstPlugIndex + 8 );
+}
+
+const Gaffer::M33fPlug *ImageTransform::upstreamMatrixPlug() const
+{
+	return getChild<M33fPlug>( g_firstPlugIndex + 8 );
 }
 
 void ImageTransform::affects( const Gaffer::Plug *input, AffectedPlugsContainer &outputs ) const
@@ -182,16 +242,29 @@ void ImageTransform::affects( const Gaffer::Plug *input, AffectedPlugsContainer
 	if(
 		input->parent<Plug>() == transformPlug()->translatePlug() ||
 		input->parent<Plug>() == transformPlug()->scalePlug() ||
-		input->parent<Plug>() == transformPlug()->pivotPlug()
+		input->parent<Plug>() == transformPlug()->pivotPlug() ||
+		input == transformPlug()->rotatePlug() ||
+		input == upstreamMatrixPlug()
 	)
 	{
 		outputs.push_back( resampleMatrixPlug() );
 	}
 
+	if(
+		transformPlug()->isAncestorOf( input ) ||
+		input == upstreamMatrixPlug() ||
+		input == enabledPlug()
+	)
+	{
+		outputs.push_back( concatenatedMatrixPlug() );
+	}
+
 	if(
 		input == inPlug()->dataWindowPlug() ||
+		input == concatenatedInPlug()->dataWindowPlug() ||
 		input == resampledInPlug()->dataWindowPlug() ||
-		transformPlug()->isAncestorOf( input )
+		transformPlug()->isAncestorOf( input ) ||
+		input == upstreamMatrixPlug()
 	)
 	{
 		outputs.push_back( outPlug()->dataWindowPlug() );
@@ -200,8 +273,11 @@ void ImageTransform::affects( const Gaffer::Plug *input, AffectedPlugsContainer
 	if(
 		input == inPlug()->channelDataPlug() ||
 		input == inPlug()->dataWindowPlug() ||
+		input == concatenatedInPlug()->channelDataPlug() ||
+		input == concatenatedInPlug()->dataWindowPlug() ||
 		input == resampledInPlug()->channelDataPlug() ||
-		transformPlug()->isAncestorOf( input )
+		transformPlug()->isAncestorOf( input ) ||
+		input == upstreamMatrixPlug()
 	)
 	{
 		outputs.push_back( outPlug()->channelDataPlug() );
@@ -218,6 +294,22 @@ void ImageTransform::hash( const ValuePlug *output, const Context *context, IECo
 		transformPlug()->translatePlug()->hash( h );
 		transformPlug()->scalePlug()->hash( h );
 		transformPlug()->pivotPlug()->hash( h );
+		if( concatenating() )
+		{
+			// When concatenating, the rotation may contribute to
+			// the scale we resample with.
+			transformPlug()->rotatePlug()->hash( h );
+			upstreamMatrixPlug()->hash( h );
+		}
+	}
+	else if( output == concatenatedMatrixPlug() )
+	{
+		enabledPlug()->hash( h );
+		transformPlug()->hash( h );
+		if( concatenating() )
+		{
+			upstreamMatrixPlug()->hash( h );
+		}
 	}
 }
 
@@ -230,6 +322,23 @@ void ImageTransform::compute( ValuePlug *output, const Context *context ) const
 		static_cast<M33fPlug *>( output )->setValue( resampleMatrix );
 		return;
 	}
+	else if( output == concatenatedMatrixPlug() )
+	{
+		M33f matrix;
+		if( enabledPlug()->getValue() )
+		{
+			M33f resampleMatrix;
+			operation( matrix, resampleMatrix );
+		}
+		else if( concatenating() )
+		{
+			// Disabled, so we simply pass through the
+			// upstream transform.
+			matrix = upstreamMatrixPlug()->getValue();
+		}
+		static_cast<M33fPlug *>( output )->setValue( matrix );
+		return;
+	}
 
 	ImageProcessor::compute( output, context );
 }
@@ -245,7 +354,7 @@ void ImageTransform::hashDataWindow( const GafferImage::ImagePlug *parent, const
 	else
 	{
 		ImageProcessor::hashDataWindow( parent, context, h );
-		inPlug()->dataWindowPlug()->hash( h );
+		concatenatedInPlug()->dataWindowPlug()->hash( h );
 		h.append( matrix );
 	}
 }
@@ -260,7 +369,7 @@ Imath::Box2i ImageTransform::computeDataWindow( const Gaffer::Context *context,
 	}
 	else
 	{
-		const Box2i in = inPlug()->dataWindowPlug()->getValue();
+		const Box2i in = concatenatedInPlug()->dataWindowPlug()->getValue();
 		return box2fToBox2i( transform( Box2f( V2f( in.min ), V2f( in.max ) ), matrix ) );
 	}
 }
@@ -348,6 +457,40 @@ unsigned ImageTransform::operation( Imath::M33f &matrix, Imath::M33f &resampleMa
 	M33f rotateMatrix; rotateMatrix.setRotation( degreesToRadians( rotate ) );
 
 	matrix = pivotInverseMatrix * scaleMatrix * rotateMatrix * pivotMatrix * translateMatrix;
+
+	if( concatenating() )
+	{
+		matrix = upstreamMatrixPlug()->getValue() * matrix;
+		if( matrix[0][1] == 0.0f && matrix[1][0] == 0.0f )
+		{
+			// No rotation or shear, so the Resample can do
+			// everything in a single pass.
+			resampleMatrix = matrix;
+			unsigned op = 0;
+			if( matrix.translation() != V2f( 0 ) )
+			{
+				op |= Translate;
+			}
+			if( matrix[0][0] != 1.0f || matrix[1][1] != 1.0f )
+			{
+				op |= Scale;
+			}
+			return op;
+		}
+
+		// Use the Resample to do the filtered scaling, and
+		// leave the remainder of the matrix to the sampling
+		// in computeChannelData().
+		V2f s( 1 );
+		if( !extractScaling( matrix, s, false ) || s.x == 0.0f || s.y == 0.0f )
+		{
+			s = V2f( 1 );
+		}
+		resampleMatrix.makeIdentity();
+		resampleMatrix.setScale( s );
+		return s != V2f( 1 ) ? Rotate | Scale : Rotate;
+	}
+
 	resampleMatrix = pivotInverseMatrix * scaleMatrix * pivotMatrix * translateMatrix;
 
 	unsigned op = 0;
@@ -378,10 +521,61 @@ Imath::Box2i ImageTransform::sampler( unsigned op, const Imath::M33f &matrix, co
 	}
 	else
 	{
-		samplerImage = inPlug();
+		samplerImage = concatenatedInPlug();
 		samplerMatrix = matrix.inverse();
 	}
 
 	const Box2f tileBound( tileOrigin, tileOrigin + V2i( ImagePlug::tileSize() ) );
 	return box2fToBox2i( transform( tileBound, samplerMatrix ) );
 }
+
+bool ImageTransform::concatenating() const
+{
+	return upstreamMatrixPlug()->getInput<Plug>();
+}
+
+void ImageTransform::plugInputChanged( Gaffer::Plug *plug )
+{
+	if( plug == inPlug() )
+	{
+		updateConcatenation();
+	}
+}
+
+void ImageTransform::plugSet( Gaffer::Plug *plug )
+{
+	if( plug == concatenatePlug() )
+	{
+		updateConcatenation();
+	}
+}
+
+void ImageTransform::updateConcatenation()
+{
+	// We only concatenate when connected directly to another
+	// ImageTransform, because any node in between could be
+	// modifying the image, and we mustn't skip over it.
+	ImageTransform *upstream = NULL;
+	if( concatenatePlug()->getValue() )
+	{
+		if( ImagePlug *input = inPlug()->getInput<ImagePlug>() )
+		{
+			upstream = runTimeCast<ImageTransform>( input->node() );
+			if( upstream && input != upstream->outPlug() )
+			{
+				upstream = NULL;
+			}
+		}
+	}
+
+	if( upstream )
+	{
+		concatenatedInPlug()->setInput( upstream->concatenatedInPlug() );
+		upstreamMatrixPlug()->setInput( upstream->concatenatedMatrixPlug() );
+	}
+	else
+	{
+		concatenatedInPlug()->setInput( inPlug() );
+		upstreamMatrixPlug()->setInput( NULL );
+	}
+}
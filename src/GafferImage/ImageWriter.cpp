@@ -40,6 +40,8 @@
 #include "tbb/spin_mutex.h"
 
 #include "boost/filesystem.hpp"
+#include "boost/noncopyable.hpp"
+#include "boost/scoped_ptr.hpp"
 
 #include "OpenImageIO/imageio.h"
 OIIO_NAMESPACE_USING
@@ -73,6 +75,9 @@ static InternedString g_compressionPlugName( "compression" );
 static InternedString g_compressionQualityPlugName( "compressionQuality" );
 static InternedString g_compressionLevelPlugName( "compressionLevel" );
 static InternedString g_dataTypePlugName( "dataType" );
+static InternedString g_additionalOutputsPlugName( "additionalOutputs" );
+static InternedString g_fileNamePlugName( "fileName" );
+static InternedString g_channelsPlugName( "channels" );
 
 namespace
 {
@@ -154,17 +159,19 @@ class FlatTileWriter
 	// so set the appropriate m_tilesFilled value.
 	//
 	// After flagging filled tiles, it iterates through tiles, starting at
-	// m_nextTileIndex, and for each tile, if the tile is marked as filled,
-	// write it, and if the tile does not intersect the region covered by the
-	// input tiles, write a black tile. If neither of these is the case, stop,
-	// and set m_nextTileIndex to the tile that it stopped on, which is the
-	// next tile to write.
+	// m_nextTileIndex, to find the tiles which are ready to write. A tile is
+	// ready if it is marked as filled, or if it does not intersect the region
+	// covered by the input tiles, in which case it is black. Once one or more
+	// complete rows of output tiles are ready, they are written with a single
+	// call to write_tiles(), and m_nextTileIndex is set to the start of the
+	// next row. Writing whole rows at once allows OpenEXR to compress the
+	// tiles in parallel using its thread pool, rather than compressing each
+	// one serially in write_tile().
 	//
 	// Once all Gaffer tiles have been processed, there may still be partially
 	// unfilled tiles, which will be fine, as their unfilled areas will be
-	// black, which is what we want. So iterate over the remaining tiles, and
-	// if memory has been allocated for that tile, write it to the file, and if
-	// nothing has been allocated, write a black tile.
+	// black, which is what we want. So write all the remaining rows, using
+	// black for any tile that has never had memory allocated.
 	public:
 		FlatTileWriter(
 				ImageOutputPtr out,
@@ -180,8 +187,7 @@ class FlatTileWriter
 				m_inputTilesBounds( Imath::Box2i( ImagePlug::tileOrigin( processWindow.min ), ImagePlug::tileOrigin( processWindow.max - Imath::V2i( 1 ) ) + Imath::V2i( ImagePlug::tileSize() ) ) ),
 				m_outputDataWindow( m_format.fromEXRSpace( Imath::Box2i( Imath::V2i( m_spec.x, m_spec.y ), Imath::V2i( m_spec.x + m_spec.width - 1, m_spec.y + m_spec.height - 1 ) ) ) ),
 				m_numTiles( Imath::V2i( (int)ceil( float( m_spec.width ) / m_spec.tile_width ), (int)ceil( float( m_spec.height ) / m_spec.tile_height ) ) ),
-				m_nextTileIndex( 0 ),
-				m_blackTile( NULL )
+				m_nextTileIndex( 0 )
 		{
 			m_tilesData.resize( m_numTiles.x * m_numTiles.y );
 			m_tilesFilled.resize( m_numTiles.x * m_numTiles.y, false );
@@ -194,21 +200,8 @@ class FlatTileWriter
 
 		void finish()
 		{
-			for( size_t tileIndex = m_nextTileIndex; tileIndex < m_tilesData.size(); ++tileIndex )
-			{
-				Imath::V2i tileOrigin = outTileOrigin( tileIndex );
-				if( !m_tilesData[tileIndex]->readable().empty() )
-				{
-					writeTile( tileOrigin, m_tilesData[tileIndex] );
-				}
-				else
-				{
-					// If the tileData object hasn't been resized, then
-					// we have never even tried to write data to this
-					// tile, so write the static black tile.
-					writeTile( tileOrigin, blackTile() );
-				}
-			}
+			writeTileRows( m_nextTileIndex, m_tilesData.size() );
+			m_nextTileIndex = m_tilesData.size();
 		}
 
 		void operator()( const ImagePlug *imagePlug, const string &channelName, const V2i &tileOrigin, ConstFloatVectorDataPtr data )
@@ -250,16 +243,6 @@ class FlatTileWriter
 
 	private:
 
-		inline ConstFloatVectorDataPtr blackTile()
-		{
-			if( m_blackTile == NULL )
-			{
-				m_blackTile = new IECore::FloatVectorData( std::vector<float>( m_spec.tile_width * m_spec.tile_height * m_spec.channelnames.size(), 0. ) );
-			}
-
-			return m_blackTile;
-		}
-
 		inline size_t outTileIndex( const Imath::V2i &tileOrigin ) const
 		{
 			return ( ( ( m_outputDataWindow.max.y - m_spec.tile_height - tileOrigin.y ) / m_spec.tile_height ) * m_numTiles.x ) + ( ( tileOrigin.x - m_outputDataWindow.min.x ) / m_spec.tile_width );
@@ -324,32 +307,63 @@ class FlatTileWriter
 			size_t tileIndex;
 			for( tileIndex = m_nextTileIndex; tileIndex < m_tilesData.size(); ++tileIndex )
 			{
-				Imath::V2i tileOrigin = outTileOrigin( tileIndex );
-
-				if( m_tilesFilled[tileIndex] )
-				{
-					writeTile( tileOrigin, m_tilesData[tileIndex] );
-					m_tilesData[tileIndex].reset();
-				}
-				else if( !BufferAlgo::intersects( m_inputTilesBounds, outTileBounds( tileOrigin ) ) )
-				{
-					writeTile( tileOrigin, blackTile() );
-				}
-				else
+				if(
+					!m_tilesFilled[tileIndex] &&
+					BufferAlgo::intersects( m_inputTilesBounds, outTileBounds( outTileOrigin( tileIndex ) ) )
+				)
 				{
 					break;
 				}
 			}
 
-			m_nextTileIndex = tileIndex;
+			// Only write complete rows.
+			const size_t rowsEnd = ( tileIndex / m_numTiles.x ) * m_numTiles.x;
+			if( rowsEnd > m_nextTileIndex )
+			{
+				writeTileRows( m_nextTileIndex, rowsEnd );
+				m_nextTileIndex = rowsEnd;
+			}
 		}
 
-
-		void writeTile( const Imath::V2i &tileOrigin, ConstFloatVectorDataPtr tileData ) const
+		// Writes the rows of tiles in the range [beginIndex, endIndex), both
+		// of which must be at the start of a row, and frees the tile data.
+		void writeTileRows( size_t beginIndex, size_t endIndex )
 		{
-			Imath::V2i exrTileOrigin = m_format.toEXRSpace( tileOrigin + Imath::V2i( 0, m_spec.tile_height - 1 ) );
+			if( endIndex <= beginIndex )
+			{
+				return;
+			}
 
-			if( !m_out->write_tile( exrTileOrigin.x, exrTileOrigin.y, 0, TypeDesc::FLOAT, &tileData->readable()[0] ) )
+			const int numChannels = m_spec.channelnames.size();
+			const int beginRow = beginIndex / m_numTiles.x;
+			const int endRow = ( endIndex + m_numTiles.x - 1 ) / m_numTiles.x;
+			const int exrYBegin = m_spec.y + beginRow * m_spec.tile_height;
+			const int exrYEnd = std::min( m_spec.y + endRow * m_spec.tile_height, m_spec.y + m_spec.height );
+
+			// Assemble the tiles into a single buffer covering the
+			// rows, clipped to the data window. Unfilled tiles are
+			// black.
+			std::vector<float> rows( m_spec.width * ( exrYEnd - exrYBegin ) * numChannels, 0.0f );
+			for( size_t tileIndex = beginIndex; tileIndex < endIndex; ++tileIndex )
+			{
+				const vector<float> &tile = m_tilesData[tileIndex]->readable();
+				if( !tile.empty() )
+				{
+					const int tileX = ( tileIndex % m_numTiles.x ) * m_spec.tile_width;
+					const int tileY = ( tileIndex / m_numTiles.x ) * m_spec.tile_height - beginRow * m_spec.tile_height;
+					const int width = std::min( m_spec.tile_width, m_spec.width - tileX );
+					const int height = std::min( m_spec.tile_height, exrYEnd - exrYBegin - tileY );
+					for( int y = 0; y < height; ++y )
+					{
+						const float *in = &tile[ y * m_spec.tile_width * numChannels ];
+						float *out = &rows[ ( ( tileY + y ) * m_spec.width + tileX ) * numChannels ];
+						std::copy( in, in + width * numChannels, out );
+					}
+				}
+				m_tilesData[tileIndex].reset();
+			}
+
+			if( !m_out->write_tiles( m_spec.x, m_spec.x + m_spec.width, exrYBegin, exrYEnd, 0, 1, TypeDesc::FLOAT, &rows[0] ) )
 			{
 				throw IECore::Exception( boost::str( boost::format( "Could not write tile to \"%s\", error = %s" ) % m_fileName % m_out->geterror() ) );
 			}
@@ -366,7 +380,6 @@ class FlatTileWriter
 		size_t m_nextTileIndex;
 		std::vector<FloatVectorDataPtr> m_tilesData;
 		std::vector<bool> m_tilesFilled;
-		ConstFloatVectorDataPtr m_blackTile;
 };
 
 class FlatScanlineWriter
@@ -378,11 +391,13 @@ class FlatScanlineWriter
 	// scanlines that fall between the start of the image and the start of the
 	// data that it is going to be given.
 	//
-	// It stores a vector of floats big enough to hold ImagePlug::tileSize()
-	// scanlines. As it receives each tile, it copies the data into the
-	// appropriate location in the buffer. When it's copied the last channel
-	// of the last tile of each row, it writes all of the data from the buffer
-	// into the ImageOutput object.
+	// It stores a vector of floats big enough to hold a block of several rows
+	// of tiles' worth of scanlines. As it receives each tile, it copies the
+	// data into the appropriate location in the buffer. When it's copied the
+	// last channel of the last tile of the last row in the block, it writes
+	// all of the data from the buffer into the ImageOutput object. Writing
+	// many scanlines at once allows OpenEXR to compress the chunks within
+	// them in parallel using its thread pool.
 	public:
 		FlatScanlineWriter(
 				ImageOutputPtr out,
@@ -395,9 +410,12 @@ class FlatScanlineWriter
 				m_format( format ),
 				m_spec( m_out->spec() ),
 				m_processWindow( processWindow ),
-				m_tilesBounds( Imath::Box2i( ImagePlug::tileOrigin( processWindow.min ), ImagePlug::tileOrigin( processWindow.max - Imath::V2i( 1 ) ) + Imath::V2i( ImagePlug::tileSize() ) ) )
+				m_tilesBounds( Imath::Box2i( ImagePlug::tileOrigin( processWindow.min ), ImagePlug::tileOrigin( processWindow.max - Imath::V2i( 1 ) ) + Imath::V2i( ImagePlug::tileSize() ) ) ),
+				m_rowsPerBlock( rowsPerBlock( m_spec ) ),
+				m_blockRows( 0 ),
+				m_blockExrYBegin( 0 )
 		{
-			m_scanlinesData.resize( m_spec.width * ImagePlug::tileSize() * m_spec.channelnames.size(), 0.0 );
+			m_scanlinesData.resize( m_spec.width * scanlinesPerBlock() * m_spec.channelnames.size(), 0.0 );
 
 			writeInitialBlankScanlines();
 		}
@@ -418,30 +436,56 @@ class FlatScanlineWriter
 			const Imath::Box2i inTileBounds( tileOrigin, tileOrigin + Imath::V2i( ImagePlug::tileSize() ) );
 			const Imath::Box2i exrInTileBounds( m_format.toEXRSpace( inTileBounds ) );
 
-			const Imath::Box2i exrScanlinesBounds( Imath::V2i( m_spec.x, exrInTileBounds.min.y ), Imath::V2i( m_spec.x + m_spec.width - 1, exrInTileBounds.max.y ) );
-			const Imath::Box2i scanlinesBounds( m_format.fromEXRSpace( exrScanlinesBounds ) );
-
-			if( firstTileOfRow( channelIndex, tileOrigin ) )
+			if( firstTileOfRow( channelIndex, tileOrigin ) && m_blockRows == 0 )
 			{
 				std::fill( m_scanlinesData.begin(), m_scanlinesData.end(), 0.0 );
+				m_blockExrYBegin = exrInTileBounds.min.y;
 			}
 
+			const Imath::Box2i exrScanlinesBounds( Imath::V2i( m_spec.x, m_blockExrYBegin ), Imath::V2i( m_spec.x + m_spec.width - 1, m_blockExrYBegin + scanlinesPerBlock() - 1 ) );
+			const Imath::Box2i scanlinesBounds( m_format.fromEXRSpace( exrScanlinesBounds ) );
+
 			Imath::Box2i copyArea( BufferAlgo::intersection( m_processWindow, BufferAlgo::intersection( inTileBounds, scanlinesBounds ) ) );
 
 			copyBufferArea( &data->readable()[0], inTileBounds, &m_scanlinesData[0], scanlinesBounds, channelIndex, m_spec.channelnames.size(), true, copyArea );
 
 			if( lastTileOfRow( channelIndex, tileOrigin ) )
 			{
-				writeScanlines(
-					std::max( exrInTileBounds.min.y, m_spec.y ),
-					std::min( exrInTileBounds.max.y + 1, m_spec.y + m_spec.height ),
-					std::max( m_spec.y - exrInTileBounds.min.y, 0 )
-				);
+				if( ++m_blockRows == m_rowsPerBlock || tileOrigin.y == m_tilesBounds.min.y )
+				{
+					writeScanlines(
+						std::max( m_blockExrYBegin, m_spec.y ),
+						std::min( exrInTileBounds.max.y + 1, m_spec.y + m_spec.height ),
+						std::max( m_spec.y - m_blockExrYBegin, 0 )
+					);
+					m_blockRows = 0;
+				}
 			}
 		}
 
 	private:
 
+		// We aim to write at least 256 scanlines at a time, which is
+		// enough to give OpenEXR several chunks to compress in parallel
+		// with any of its compression methods, but limit the buffer to
+		// a reasonable amount of memory for large images.
+		static int rowsPerBlock( const ImageSpec &spec )
+		{
+			const size_t rowBytes = spec.width * ImagePlug::tileSize() * spec.channelnames.size() * sizeof( float );
+			const size_t maxBytes = 128 * 1024 * 1024;
+			int result = std::max( 256 / ImagePlug::tileSize(), 1 );
+			while( result > 1 && result * rowBytes > maxBytes )
+			{
+				--result;
+			}
+			return result;
+		}
+
+		inline int scanlinesPerBlock() const
+		{
+			return m_rowsPerBlock * ImagePlug::tileSize();
+		}
+
 		inline bool firstTileOfRow( const size_t channelIndex, const Imath::V2i &tileOrigin ) const
 		{
 			return channelIndex == 0 && tileOrigin.x == m_tilesBounds.min.x;
@@ -463,14 +507,10 @@ class FlatScanlineWriter
 		void writeBlankScanlines( const int yBegin, const int yEnd )
 		{
 			float *scanlines = &m_scanlinesData[0];
-			memset( scanlines, 0, sizeof(float) * m_spec.width * std::min( ImagePlug::tileSize(), yEnd - yBegin ) * m_spec.channelnames.size() );
-			for(
-				int blankScanlinesBegin = yBegin, blankScanlinesEnd = std::min( yBegin + ImagePlug::tileSize(), yEnd );
-				blankScanlinesEnd <= yEnd;
-				blankScanlinesBegin += ImagePlug::tileSize(), blankScanlinesEnd += ImagePlug::tileSize()
-			)
+			memset( scanlines, 0, sizeof(float) * m_spec.width * std::min( scanlinesPerBlock(), yEnd - yBegin ) * m_spec.channelnames.size() );
+			for( int blankScanlinesBegin = yBegin; blankScanlinesBegin < yEnd; blankScanlinesBegin += scanlinesPerBlock() )
 			{
-				writeScanlines( blankScanlinesBegin, std::min( blankScanlinesEnd, yEnd ) );
+				writeScanlines( blankScanlinesBegin, std::min( blankScanlinesBegin + scanlinesPerBlock(), yEnd ) );
 			}
 		}
 
@@ -489,6 +529,9 @@ class FlatScanlineWriter
 		const ImageSpec m_spec;
 		const Imath::Box2i &m_processWindow;
 		const Imath::Box2i m_tilesBounds;
+		const int m_rowsPerBlock;
+		int m_blockRows;
+		int m_blockExrYBegin;
 		vector<float> m_scanlinesData;
 };
 
@@ -696,6 +739,212 @@ ImageSpec createImageSpec( const ImageWriter *node, const ImageOutput *out, cons
 // ImageWriter implementation
 //////////////////////////////////////////////////////////////////////////
 
+//////////////////////////////////////////////////////////////////////////
+// Output. Manages the writing of a single file. An ImageWriter may write
+// several of these from a single traversal of the input image.
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+class Output : boost::noncopyable
+{
+
+	public :
+
+		Output( const ImageWriter *node, const std::string &fileName, const ChannelMaskPlug *channelsPlug, const std::vector<std::string> &inputChannels, const Format &format, Imath::Box2i dataWindow )
+			:	m_fileName( fileName ), m_format( format ), m_out( ImageOutput::create( fileName.c_str() ) )
+		{
+			if( !m_out )
+			{
+				throw IECore::Exception( OpenImageIO::geterror() );
+			}
+
+			// Grab the intersection of the channels from the "channels" plug and the image input to see which channels we are to write out.
+			std::vector<std::string> maskChannels = inputChannels;
+			channelsPlug->maskChannels( maskChannels );
+
+			if ( !m_out->supports( "nchannels" ) )
+			{
+				std::vector<std::string>::iterator cIt( maskChannels.begin() );
+				while ( cIt != maskChannels.end() )
+				{
+					if ( (*cIt) != "R" && (*cIt) != "G" && (*cIt) != "B" && (*cIt) != "A" )
+					{
+						cIt = maskChannels.erase( cIt );
+					}
+					else
+					{
+						++cIt;
+					}
+				}
+			}
+
+			if ( !m_out->supports( "alpha" ) )
+			{
+				std::vector<std::string>::iterator alphaChannel( std::find( maskChannels.begin(), maskChannels.end(), "A" ) );
+				if ( alphaChannel != maskChannels.end() )
+				{
+					maskChannels.erase( alphaChannel );
+				}
+			}
+
+			Imath::Box2i exrDataWindow( Imath::V2i( 0 ) );
+
+			if( !BufferAlgo::empty( dataWindow ) )
+			{
+				exrDataWindow = m_format.toEXRSpace( dataWindow );
+			}
+			else
+			{
+				dataWindow = exrDataWindow;
+			}
+
+			const Imath::Box2i exrDisplayWindow = m_format.toEXRSpace( m_format.getDisplayWindow() );
+
+			ImageSpec spec = createImageSpec( node, m_out.get(), exrDataWindow, exrDisplayWindow );
+
+			const int nChannels = maskChannels.size();
+			spec.nchannels = nChannels;
+			spec.default_channel_names();
+
+			spec.channelnames.clear();
+			for ( std::vector<std::string>::iterator channelIt( maskChannels.begin() ); channelIt != maskChannels.end(); channelIt++ )
+			{
+				spec.channelnames.push_back( *channelIt );
+
+				// OIIO has a special attribute for the Alpha and Z channels. If we find some, we should tag them...
+				if ( *channelIt == "A" )
+				{
+					spec.alpha_channel = channelIt-maskChannels.begin();
+				} else if ( *channelIt == "Z" )
+				{
+					spec.z_channel = channelIt-maskChannels.begin();
+				}
+			}
+
+			// create the directories before opening the file
+			boost::filesystem::path directory = boost::filesystem::path( m_fileName ).parent_path();
+			if( !directory.empty() )
+			{
+				boost::filesystem::create_directories( directory );
+			}
+
+			if ( m_out->open( m_fileName, spec ) )
+			{
+				IECore::msg( IECore::MessageHandler::Info, node->relativeName( node->scriptNode() ), "Writing " + m_fileName );
+			}
+			else
+			{
+				throw IECore::Exception( boost::str( boost::format( "Could not open \"%s\", error = %s" ) % m_fileName % m_out->geterror() ) );
+			}
+
+			m_channelNames = spec.channelnames;
+
+			const Imath::Box2i extImageDataWindow( Imath::V2i( spec.x, spec.y ), Imath::V2i( spec.x + spec.width - 1, spec.y + spec.height - 1 ) );
+			const Imath::Box2i imageDataWindow( m_format.fromEXRSpace( extImageDataWindow ) );
+			m_processWindow = BufferAlgo::intersection( imageDataWindow, dataWindow );
+
+			if ( spec.tile_width == 0 )
+			{
+				m_scanlineWriter.reset( new FlatScanlineWriter( m_out, m_fileName, m_processWindow, m_format ) );
+			}
+			else
+			{
+				m_tileWriter.reset( new FlatTileWriter( m_out, m_fileName, m_processWindow, m_format ) );
+			}
+		}
+
+		bool wantsChannel( const std::string &channelName ) const
+		{
+			return std::find( m_channelNames.begin(), m_channelNames.end(), channelName ) != m_channelNames.end();
+		}
+
+		const Imath::Box2i &processWindow() const
+		{
+			return m_processWindow;
+		}
+
+		void operator()( const ImagePlug *imagePlug, const string &channelName, const V2i &tileOrigin, ConstFloatVectorDataPtr data )
+		{
+			// We may be receiving tiles for other outputs, which
+			// the writers aren't expecting.
+			if(
+				!wantsChannel( channelName ) ||
+				!BufferAlgo::intersects( m_processWindow, Imath::Box2i( tileOrigin, tileOrigin + Imath::V2i( ImagePlug::tileSize() ) ) )
+			)
+			{
+				return;
+			}
+
+			if( m_scanlineWriter )
+			{
+				(*m_scanlineWriter)( imagePlug, channelName, tileOrigin, data );
+			}
+			else
+			{
+				(*m_tileWriter)( imagePlug, channelName, tileOrigin, data );
+			}
+		}
+
+		void finish()
+		{
+			if( m_scanlineWriter )
+			{
+				m_scanlineWriter->finish();
+			}
+			else
+			{
+				m_tileWriter->finish();
+			}
+			m_out->close();
+		}
+
+	private :
+
+		// The writers hold references to these, so
+		// they must outlive them.
+		const std::string m_fileName;
+		const Format m_format;
+		Imath::Box2i m_processWindow;
+
+		ImageOutputPtr m_out;
+		std::vector<std::string> m_channelNames;
+		boost::scoped_ptr<FlatScanlineWriter> m_scanlineWriter;
+		boost::scoped_ptr<FlatTileWriter> m_tileWriter;
+
+};
+
+typedef boost::shared_ptr<Output> OutputPtr;
+
+// Gather functor for parallelGatherTiles(), passing
+// each tile on to all the outputs.
+class OutputsWriter
+{
+
+	public :
+
+		OutputsWriter( const std::vector<OutputPtr> &outputs )
+			:	m_outputs( outputs )
+		{
+		}
+
+		void operator()( const ImagePlug *imagePlug, const string &channelName, const V2i &tileOrigin, ConstFloatVectorDataPtr data )
+		{
+			for( std::vector<OutputPtr>::const_iterator it = m_outputs.begin(), eIt = m_outputs.end(); it != eIt; ++it )
+			{
+				(**it)( imagePlug, channelName, tileOrigin, data );
+			}
+		}
+
+	private :
+
+		const std::vector<OutputPtr> &m_outputs;
+
+};
+
+} // namespace
+
 IE_CORE_DEFINERUNTIMETYPED( ImageWriter );
 
 size_t ImageWriter::g_firstPlugIndex = 0;
@@ -718,6 +967,8 @@ ImageWriter::ImageWriter( const std::string &name )
 	outPlug()->setInput( inPlug() );
 
 	createFileFormatOptionsPlugs();
+
+	addChild( new ValuePlug( g_additionalOutputsPlugName ) );
 }
 
 ImageWriter::~ImageWriter()
@@ -835,6 +1086,16 @@ const Gaffer::ValuePlug *ImageWriter::fileFormatSettingsPlug( const std::string
 	return getChild<ValuePlug>( fileFormat );
 }
 
+Gaffer::ValuePlug *ImageWriter::additionalOutputsPlug()
+{
+	return getChild<ValuePlug>( g_additionalOutputsPlugName );
+}
+
+const Gaffer::ValuePlug *ImageWriter::additionalOutputsPlug() const
+{
+	return getChild<ValuePlug>( g_additionalOutputsPlugName );
+}
+
 const std::string ImageWriter::currentFileFormat() const
 {
 	const std::string fileName = fileNamePlug()->getValue();
@@ -871,11 +1132,32 @@ IECore::MurmurHash ImageWriter::hash( const Context *context ) const
 		}
 	}
 
+	for( ValuePlugIterator it( additionalOutputsPlug() ); !it.done(); ++it )
+	{
+		const StringPlug *outputFileNamePlug = (*it)->getChild<StringPlug>( g_fileNamePlugName );
+		const ChannelMaskPlug *outputChannelsPlug = (*it)->getChild<ChannelMaskPlug>( g_channelsPlugName );
+		if( !outputFileNamePlug || !outputChannelsPlug )
+		{
+			continue;
+		}
+
+		const std::string fileName = outputFileNamePlug->getValue();
+		h.append( fileName );
+		outputChannelsPlug->hash( h );
+
+		ImageOutputPtr out( ImageOutput::create( fileName.c_str() ) );
+		if( out )
+		{
+			if( const ValuePlug *fmtSettingsPlug = fileFormatSettingsPlug( out->format_name() ) )
+			{
+				h.append( fmtSettingsPlug->hash() );
+			}
+		}
+	}
+
 	return h;
 }
 
-///\todo: We are currently computing all of the channels regardless of whether or not we are outputting them.
-/// Change the execute() method to only compute the channels that are masked by the channelsPlug().
 void ImageWriter::execute() const
 {
 	if( !inPlug()->getInput<ImagePlug>() )
@@ -883,114 +1165,66 @@ void ImageWriter::execute() const
 		throw IECore::Exception( "No input image." );
 	}
 
-	const std::string fileName = fileNamePlug()->getValue();
-
-	ImageOutputPtr out( ImageOutput::create( fileName.c_str() ) );
-	if( !out )
-	{
-		throw IECore::Exception( OpenImageIO::geterror() );
-	}
+	// Open all the outputs.
 
-	// Grab the intersection of the channels from the "channels" plug and the image input to see which channels we are to write out.
 	IECore::ConstStringVectorDataPtr channelNamesData = inPlug()->channelNamesPlug()->getValue();
-	std::vector<std::string> maskChannels = channelNamesData->readable();
-	channelsPlug()->maskChannels( maskChannels );
+	const Format imageFormat = inPlug()->formatPlug()->getValue();
+	const Imath::Box2i dataWindow = inPlug()->dataWindowPlug()->getValue();
 
-	if ( !out->supports( "nchannels" ) )
+	std::vector<OutputPtr> outputs;
+	outputs.push_back( OutputPtr( new Output( this, fileNamePlug()->getValue(), channelsPlug(), channelNamesData->readable(), imageFormat, dataWindow ) ) );
+	for( ValuePlugIterator it( additionalOutputsPlug() ); !it.done(); ++it )
 	{
-		std::vector<std::string>::iterator cIt( maskChannels.begin() );
-		while ( cIt != maskChannels.end() )
+		const StringPlug *outputFileNamePlug = (*it)->getChild<StringPlug>( g_fileNamePlugName );
+		const ChannelMaskPlug *outputChannelsPlug = (*it)->getChild<ChannelMaskPlug>( g_channelsPlugName );
+		if( !outputFileNamePlug || !outputChannelsPlug )
 		{
-			if ( (*cIt) != "R" && (*cIt) != "G" && (*cIt) != "B" && (*cIt) != "A" )
-			{
-				cIt = maskChannels.erase( cIt );
-			}
-			else
-			{
-				++cIt;
-			}
+			throw IECore::Exception( boost::str( boost::format( "Additional output \"%s\" must have \"fileName\" and \"channels\" plugs" ) % (*it)->getName().string() ) );
 		}
-	}
 
-	if ( !out->supports( "alpha" ) )
-	{
-		std::vector<std::string>::iterator alphaChannel( std::find( maskChannels.begin(), maskChannels.end(), "A" ) );
-		if ( alphaChannel != maskChannels.end() )
+		const std::string fileName = outputFileNamePlug->getValue();
+		if( fileName.empty() )
 		{
-			maskChannels.erase( alphaChannel );
+			continue;
 		}
+		outputs.push_back( OutputPtr( new Output( this, fileName, outputChannelsPlug, channelNamesData->readable(), imageFormat, dataWindow ) ) );
 	}
 
-	const Format imageFormat = inPlug()->formatPlug()->getValue();
-	Imath::Box2i dataWindow = inPlug()->dataWindowPlug()->getValue();
-	Imath::Box2i exrDataWindow( Imath::V2i( 0 ) );
-
-	if( !BufferAlgo::empty( dataWindow ) )
-	{
-		exrDataWindow = imageFormat.toEXRSpace( dataWindow );
-	}
-	else
-	{
-		dataWindow = exrDataWindow;
-	}
-
-	const Imath::Box2i exrDisplayWindow = imageFormat.toEXRSpace( imageFormat.getDisplayWindow() );
-
-	ImageSpec spec = createImageSpec( this, out.get(), exrDataWindow, exrDisplayWindow );
+	// Compute the union of the channels and the regions they need,
+	// so that we can visit every tile just once and share it between
+	// all the outputs.
 
-	const int nChannels = maskChannels.size();
-	spec.nchannels = nChannels;
-	spec.default_channel_names();
-
-	spec.channelnames.clear();
-	for ( std::vector<std::string>::iterator channelIt( maskChannels.begin() ); channelIt != maskChannels.end(); channelIt++ )
+	std::vector<std::string> channelNames;
+	for( std::vector<std::string>::const_iterator cIt = channelNamesData->readable().begin(), cEIt = channelNamesData->readable().end(); cIt != cEIt; ++cIt )
 	{
-		spec.channelnames.push_back( *channelIt );
-
-		// OIIO has a special attribute for the Alpha and Z channels. If we find some, we should tag them...
-		if ( *channelIt == "A" )
-		{
-			spec.alpha_channel = channelIt-maskChannels.begin();
-		} else if ( *channelIt == "Z" )
+		for( std::vector<OutputPtr>::const_iterator oIt = outputs.begin(), oEIt = outputs.end(); oIt != oEIt; ++oIt )
 		{
-			spec.z_channel = channelIt-maskChannels.begin();
+			if( (*oIt)->wantsChannel( *cIt ) )
+			{
+				channelNames.push_back( *cIt );
+				break;
+			}
 		}
 	}
 
-	// create the directories before opening the file
-	boost::filesystem::path directory = boost::filesystem::path( fileName ).parent_path();
-	if( !directory.empty() )
+	Imath::Box2i processWindow;
+	for( std::vector<OutputPtr>::const_iterator it = outputs.begin(), eIt = outputs.end(); it != eIt; ++it )
 	{
-		boost::filesystem::create_directories( directory );
+		if( !BufferAlgo::empty( (*it)->processWindow() ) )
+		{
+			processWindow.extendBy( (*it)->processWindow() );
+		}
 	}
 
-	if ( out->open( fileName, spec ) )
-	{
-		IECore::msg( IECore::MessageHandler::Info, this->relativeName( this->scriptNode() ), "Writing " + fileName );
-	}
-	else
+	if( !processWindow.isEmpty() )
 	{
-		throw IECore::Exception( boost::str( boost::format( "Could not open \"%s\", error = %s" ) % fileName % out->geterror() ) );
+		TileProcessor processor = TileProcessor();
+		OutputsWriter writer( outputs );
+		ImageAlgo::parallelGatherTiles( inPlug(), channelNames, processor, writer, processWindow, ImageAlgo::TopToBottom );
 	}
 
-	const Imath::Box2i extImageDataWindow( Imath::V2i( spec.x, spec.y ), Imath::V2i( spec.x + spec.width - 1, spec.y + spec.height - 1 ) );
-	const Imath::Box2i imageDataWindow( imageFormat.fromEXRSpace( extImageDataWindow ) );
-	const Imath::Box2i processDataWindow( BufferAlgo::intersection( imageDataWindow, dataWindow ) );
-
-	TileProcessor processor = TileProcessor();
-
-	if ( spec.tile_width == 0 )
-	{
-		FlatScanlineWriter flatScanlineWriter( out, fileName, processDataWindow, imageFormat );
-		ImageAlgo::parallelGatherTiles( inPlug(), spec.channelnames, processor, flatScanlineWriter, processDataWindow, ImageAlgo::TopToBottom );
-		flatScanlineWriter.finish();
-	}
-	else
+	for( std::vector<OutputPtr>::const_iterator it = outputs.begin(), eIt = outputs.end(); it != eIt; ++it )
 	{
-		FlatTileWriter flatTileWriter( out, fileName, processDataWindow, imageFormat );
-		ImageAlgo::parallelGatherTiles( inPlug(), spec.channelnames, processor, flatTileWriter, processDataWindow, ImageAlgo::TopToBottom );
-		flatTileWriter.finish();
+		(*it)->finish();
 	}
-
-	out->close();
 }
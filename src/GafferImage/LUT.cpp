@@ -34,6 +34,11 @@
 //
 //////////////////////////////////////////////////////////////////////////
 
+#include "tbb/mutex.h"
+
+#include "boost/filesystem/operations.hpp"
+#include "boost/unordered_map.hpp"
+
 #include "Gaffer/StringPlug.h"
 
 #include "GafferImage/LUT.h"
@@ -43,6 +48,42 @@ using namespace IECore;
 using namespace Gaffer;
 using namespace GafferImage;
 
+namespace
+{
+
+std::time_t modificationTime( const std::string &fileName )
+{
+	boost::system::error_code ec;
+	const std::time_t result = boost::filesystem::last_write_time( fileName, ec );
+	return ec ? 0 : result;
+}
+
+// OpenColorIO caches the contents of LUT files internally, keyed only by
+// file name, so it won't notice if a file is modified on disk. We record
+// the modification time of each file when we make a transform for it, so
+// that we can clear the OpenColorIO caches if the file has since changed.
+// Our processors are cached by OpenColorIOTransform using a hash which
+// includes the modification time, so this happens at most once per edit.
+
+typedef boost::unordered_map<std::string, std::time_t> ModificationTimes;
+ModificationTimes g_modificationTimes;
+tbb::mutex g_modificationTimesMutex;
+
+void updateModificationTime( const std::string &fileName )
+{
+	const std::time_t time = modificationTime( fileName );
+
+	tbb::mutex::scoped_lock lock( g_modificationTimesMutex );
+	std::pair<ModificationTimes::iterator, bool> inserted = g_modificationTimes.insert( ModificationTimes::value_type( fileName, time ) );
+	if( !inserted.second && inserted.first->second != time )
+	{
+		inserted.first->second = time;
+		OpenColorIO::ClearAllCaches();
+	}
+}
+
+} // namespace
+
 IE_CORE_DEFINERUNTIMETYPED( LUT );
 
 size_t LUT::g_firstPlugIndex = 0;
@@ -121,7 +162,8 @@ bool LUT::affectsTransform( const Gaffer::Plug *input ) const
 
 void LUT::hashTransform( const Gaffer::Context *context, IECore::MurmurHash &h ) const
 {
-	if( fileNamePlug()->getValue().empty() )
+	const std::string fileName = fileNamePlug()->getValue();
+	if( fileName.empty() )
 	{
 		h = MurmurHash();
 		return;
@@ -130,6 +172,9 @@ void LUT::hashTransform( const Gaffer::Context *context, IECore::MurmurHash &h )
 	fileNamePlug()->hash( h );
 	directionPlug()->hash( h );
 	interpolationPlug()->hash( h );
+	// So that we get a new processor, and new results,
+	// if the file is modified on disk.
+	h.append( (uint64_t)modificationTime( fileName ) );
 }
 
 OpenColorIO::ConstTransformRcPtr LUT::transform() const
@@ -143,6 +188,8 @@ OpenColorIO::ConstTransformRcPtr LUT::transform() const
 		return OpenColorIO::FileTransformRcPtr();
 	}
 
+	updateModificationTime( fileName );
+
 	OpenColorIO::FileTransformRcPtr result = OpenColorIO::FileTransform::Create();
 	result->setSrc( fileName.c_str() );
 
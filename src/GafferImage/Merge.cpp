@@ -64,6 +64,36 @@ float opSubtract( float A, float B, float a, float b){ return A - B; }
 float opDifference( float A, float B, float a, float b){ return fabs( A - B ); }
 float opUnder( float A, float B, float a, float b){ return A*(1.-b) + B; }
 
+// Returns true if the image has an alpha of exactly 1 for every
+// pixel of the tile, so that it hides anything beneath it when
+// composited with Over.
+bool opaque( const ImagePlug *image, const V2i &tileOrigin )
+{
+	const Box2i tileBound( tileOrigin, tileOrigin + V2i( ImagePlug::tileSize() ) );
+	if( boxIntersection( tileBound, image->dataWindowPlug()->getValue() ) != tileBound )
+	{
+		return false;
+	}
+
+	IECore::ConstStringVectorDataPtr channelNamesData = image->channelNamesPlug()->getValue();
+	if( !ImageAlgo::channelExists( channelNamesData->readable(), "A" ) )
+	{
+		return false;
+	}
+
+	ConstFloatVectorDataPtr alphaData = image->channelData( "A", tileOrigin );
+	const vector<float> &alpha = alphaData->readable();
+	for( vector<float>::const_iterator it = alpha.begin(), eIt = alpha.end(); it != eIt; ++it )
+	{
+		if( *it != 1.0f )
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
 } // namespace
 
 IE_CORE_DEFINERUNTIMETYPED( Merge );
@@ -192,26 +222,48 @@ void Merge::hashChannelData( const GafferImage::ImagePlug *output, const Gaffer:
 	const V2i tileOrigin = context->get<V2i>( ImagePlug::tileOriginContextName );
 	const Box2i tileBound( tileOrigin, tileOrigin + V2i( ImagePlug::tileSize() ) );
 
-	for( ImagePlugIterator it( inPlugs() ); !it.done(); ++it )
+	// The channel data for each input is independent, so rather than
+	// hash it input by input we gather the plugs and contexts we need,
+	// hash them as a batch in parallel, and then append the results in
+	// the same order as a serial evaluation would.
+	ContextPtr alphaContext = new Context( *context, Context::Borrowed );
+	alphaContext->set( ImagePlug::channelNameContextName, std::string( "A" ) );
+
+	std::vector<const ValuePlug *> plugs;
+	std::vector<const Context *> contexts;
+	// The number of hashes gathered for each input, and
+	// its valid bound.
+	std::vector<size_t> hashCounts;
+	std::vector<Box2i> validBounds;
+
+	// Layers hidden beneath opaque ones are omitted, so
+	// their hashes need never be computed.
+	const int operation = operationPlug()->getValue();
+	std::vector<const ImagePlug *> inputs;
+	visibleInputs( operation, tileOrigin, inputs );
+
+	for( std::vector<const ImagePlug *>::const_iterator it = inputs.begin(), eIt = inputs.end(); it != eIt; ++it )
 	{
-		if( !(*it)->getInput<ValuePlug>() )
-		{
-			continue;
-		}
-
 		IECore::ConstStringVectorDataPtr channelNamesData = (*it)->channelNamesPlug()->getValue();
 		const std::vector<std::string> &channelNames = channelNamesData->readable();
 
+		size_t count = 0;
 		if( ImageAlgo::channelExists( channelNames, channelName ) )
 		{
-			(*it)->channelDataPlug()->hash( h );
+			plugs.push_back( (*it)->channelDataPlug() );
+			contexts.push_back( context );
+			count++;
 		}
 
 		if( ImageAlgo::channelExists( channelNames, "A" ) )
 		{
-			h.append( (*it)->channelDataHash( "A", tileOrigin ) );
+			plugs.push_back( (*it)->channelDataPlug() );
+			contexts.push_back( alphaContext.get() );
+			count++;
 		}
 
+		hashCounts.push_back( count );
+
 		// The hash of the channel data we include above represents just the data in
 		// the tile itself, and takes no account of the possibility that parts of the
 		// tile may be outside of the data window. This simplifies the implementation of
@@ -222,62 +274,114 @@ void Merge::hashChannelData( const GafferImage::ImagePlug *output, const Gaffer:
 		// input data windows, we may be using/revealing the invalid parts of a tile. We
 		// deal with this in computeChannelData() by treating the invalid parts as black,
 		// and must therefore hash in the valid bound here to take that into account.
-		const Box2i validBound = boxIntersection( tileBound, (*it)->dataWindowPlug()->getValue() );
-		h.append( validBound );
+		validBounds.push_back( boxIntersection( tileBound, (*it)->dataWindowPlug()->getValue() ) );
+	}
+
+	std::vector<IECore::MurmurHash> hashes;
+	ValuePlug::hashes( plugs, contexts, hashes );
+
+	std::vector<IECore::MurmurHash>::const_iterator hashIt = hashes.begin();
+	for( size_t i = 0, e = hashCounts.size(); i < e; ++i )
+	{
+		for( size_t j = 0; j < hashCounts[i]; ++j )
+		{
+			h.append( *hashIt++ );
+		}
+		h.append( validBounds[i] );
 	}
 
-	operationPlug()->hash( h );
+	h.append( operation );
 }
 
 IECore::ConstFloatVectorDataPtr Merge::computeChannelData( const std::string &channelName, const Imath::V2i &tileOrigin, const Gaffer::Context *context, const ImagePlug *parent ) const
 {
-	switch( operationPlug()->getValue() )
+	const int operation = operationPlug()->getValue();
+	std::vector<const ImagePlug *> inputs;
+	visibleInputs( operation, tileOrigin, inputs );
+
+	switch( operation )
 	{
 		case Add :
-			return merge( opAdd, channelName, tileOrigin);
+			return merge( opAdd, inputs, channelName, tileOrigin );
 		case Atop :
-			return merge( opAtop, channelName, tileOrigin);
+			return merge( opAtop, inputs, channelName, tileOrigin );
 		case Divide :
-			return merge( opDivide, channelName, tileOrigin);
+			return merge( opDivide, inputs, channelName, tileOrigin );
 		case In :
-			return merge( opIn, channelName, tileOrigin);
+			return merge( opIn, inputs, channelName, tileOrigin );
 		case Out :
-			return merge( opOut, channelName, tileOrigin);
+			return merge( opOut, inputs, channelName, tileOrigin );
 		case Mask :
-			return merge( opMask, channelName, tileOrigin);
+			return merge( opMask, inputs, channelName, tileOrigin );
 		case Matte :
-			return merge( opMatte, channelName, tileOrigin);
+			return merge( opMatte, inputs, channelName, tileOrigin );
 		case Multiply :
-			return merge( opMultiply, channelName, tileOrigin);
+			return merge( opMultiply, inputs, channelName, tileOrigin );
 		case Over :
-			return merge( opOver, channelName, tileOrigin);
+			return merge( opOver, inputs, channelName, tileOrigin );
 		case Subtract :
-			return merge( opSubtract, channelName, tileOrigin);
+			return merge( opSubtract, inputs, channelName, tileOrigin );
 		case Difference :
-			return merge( opDifference, channelName, tileOrigin);
+			return merge( opDifference, inputs, channelName, tileOrigin );
 		case Under :
-			return merge( opUnder, channelName, tileOrigin);
+			return merge( opUnder, inputs, channelName, tileOrigin );
 	}
 
 	throw Exception( "Merge::computeChannelData : Invalid operation mode." );
 }
 
-template<typename F>
-IECore::ConstFloatVectorDataPtr Merge::merge( F f, const std::string &channelName, const Imath::V2i &tileOrigin ) const
+void Merge::visibleInputs( int operation, const Imath::V2i &tileOrigin, std::vector<const ImagePlug *> &inputs ) const
 {
-	FloatVectorDataPtr resultData = NULL;
-	// Temporary buffer for computing the alpha of intermediate composited layers.
-	FloatVectorDataPtr resultAlphaData = NULL;
-
-	const Box2i tileBound( tileOrigin, tileOrigin + V2i( ImagePlug::tileSize() ) );
-
 	for( ImagePlugIterator it( inPlugs() ); !it.done(); ++it )
 	{
-		if( !(*it)->getInput<ValuePlug>() )
+		if( (*it)->getInput<ValuePlug>() )
 		{
-			continue;
+			inputs.push_back( it->get() );
 		}
+	}
 
+	// With Over, an opaque layer hides all the layers beneath it, so we
+	// search top-down for the first one and discard everything below.
+	// Because the opaque layer covers the whole tile, using it to initialise
+	// the result gives exactly the same values as compositing it over the
+	// layers beneath. Under is the mirror image - an opaque layer makes the
+	// accumulated alpha 1, and thereafter the layers above contribute nothing.
+	if( operation == Over )
+	{
+		for( size_t i = inputs.size(); i > 1; --i )
+		{
+			if( opaque( inputs[i-1], tileOrigin ) )
+			{
+				inputs.erase( inputs.begin(), inputs.begin() + i - 1 );
+				break;
+			}
+		}
+	}
+	else if( operation == Under )
+	{
+		for( size_t i = 0, e = inputs.size(); i + 1 < e; ++i )
+		{
+			if( opaque( inputs[i], tileOrigin ) )
+			{
+				inputs.erase( inputs.begin() + i + 1, inputs.end() );
+				break;
+			}
+		}
+	}
+}
+
+template<typename F>
+IECore::ConstFloatVectorDataPtr Merge::merge( F f, const std::vector<const ImagePlug *> &inputs, const std::string &channelName, const Imath::V2i &tileOrigin ) const
+{
+	const Box2i tileBound( tileOrigin, tileOrigin + V2i( ImagePlug::tileSize() ) );
+
+	// Gather the input tiles first, so that we can avoid
+	// compositing entirely if they are all black.
+	std::vector<ConstFloatVectorDataPtr> inputChannelData;
+	std::vector<ConstFloatVectorDataPtr> inputAlphaData;
+	bool allBlack = true;
+	for( std::vector<const ImagePlug *>::const_iterator it = inputs.begin(), eIt = inputs.end(); it != eIt; ++it )
+	{
 		IECore::ConstStringVectorDataPtr channelNamesData = (*it)->channelNamesPlug()->getValue();
 		const std::vector<std::string> &channelNames = channelNamesData->readable();
 
@@ -302,7 +406,29 @@ IECore::ConstFloatVectorDataPtr Merge::merge( F f, const std::string &channelNam
 			alphaData = ImagePlug::blackTile();
 		}
 
-		const Box2i validBound = boxIntersection( tileBound, (*it)->dataWindowPlug()->getValue() );
+		allBlack = allBlack && channelData.get() == ImagePlug::blackTile() && alphaData.get() == ImagePlug::blackTile();
+
+		inputChannelData.push_back( channelData );
+		inputAlphaData.push_back( alphaData );
+	}
+
+	// Compositing black with black gives black for all operations
+	// except Divide.
+	if( allBlack && f( 0.0f, 0.0f, 0.0f, 0.0f ) == 0.0f )
+	{
+		return ImagePlug::blackTile();
+	}
+
+	FloatVectorDataPtr resultData = NULL;
+	// Temporary buffer for computing the alpha of intermediate composited layers.
+	FloatVectorDataPtr resultAlphaData = NULL;
+
+	for( size_t i = 0, e = inputs.size(); i < e; ++i )
+	{
+		const ConstFloatVectorDataPtr &channelData = inputChannelData[i];
+		const ConstFloatVectorDataPtr &alphaData = inputAlphaData[i];
+
+		const Box2i validBound = boxIntersection( tileBound, inputs[i]->dataWindowPlug()->getValue() );
 
 		if( !resultData )
 		{
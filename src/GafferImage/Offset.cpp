@@ -38,6 +38,7 @@
 
 #include "GafferImage/Offset.h"
 #include "GafferImage/BufferAlgo.h"
+#include "GafferImage/ImageAlgo.h"
 
 using namespace std;
 using namespace Imath;
@@ -172,38 +173,51 @@ IECore::ConstFloatVectorDataPtr Offset::computeChannelData( const std::string &c
 		const Box2i outTileBound( tileOrigin, tileOrigin + V2i( ImagePlug::tileSize() ) );
 		const Box2i inBound( outTileBound.min - offset, outTileBound.max - offset );
 
+		// Fetch all the input tiles we overlap, in parallel. If they
+		// are all black then so is the output, and we needn't copy anything.
+		std::vector<ConstFloatVectorDataPtr> inTiles;
+		ImageAlgo::parallelFetchTiles( inPlug(), channelName, inBound, inTiles );
+
+		bool allBlack = true;
+		for( std::vector<ConstFloatVectorDataPtr>::const_iterator it = inTiles.begin(), eIt = inTiles.end(); it != eIt; ++it )
+		{
+			allBlack = allBlack && it->get() == ImagePlug::blackTile();
+		}
+
+		if( allBlack )
+		{
+			return ImagePlug::blackTile();
+		}
+
 		FloatVectorDataPtr outData = new FloatVectorData;
 		outData->writable().resize( ImagePlug::tileSize() * ImagePlug::tileSize() );
 		float *out = &outData->writable().front();
 
-		V2i inTileOrigin;
-		for( inTileOrigin.y = ImagePlug::tileOrigin( inBound.min ).y; inTileOrigin.y < inBound.max.y; inTileOrigin.y += ImagePlug::tileSize() )
+		const V2i inTilesOrigin = ImagePlug::tileOrigin( inBound.min );
+		const int numInTilesX = ( ImagePlug::tileOrigin( inBound.max - V2i( 1 ) ).x - inTilesOrigin.x ) / ImagePlug::tileSize() + 1;
+		for( size_t i = 0, e = inTiles.size(); i < e; ++i )
 		{
-			for( inTileOrigin.x = ImagePlug::tileOrigin( inBound.min ).x; inTileOrigin.x < inBound.max.x; inTileOrigin.x += ImagePlug::tileSize() )
+			const float *in = &inTiles[i]->readable().front();
+
+			const V2i inTileOrigin = inTilesOrigin + V2i( i % numInTilesX, i / numInTilesX ) * ImagePlug::tileSize();
+			const Box2i inTileBound( inTileOrigin, inTileOrigin + V2i( ImagePlug::tileSize() ) );
+			const Box2i inRegion = BufferAlgo::intersection(
+				inBound,
+				inTileBound
+			);
+
+			V2i inScanlineOrigin = inRegion.min;
+			const size_t scanlineLength = inRegion.size().x;
+			while( inScanlineOrigin.y < inRegion.max.y )
 			{
-				offsetContext->set( ImagePlug::tileOriginContextName, inTileOrigin );
-				ConstFloatVectorDataPtr inData = inPlug()->channelDataPlug()->getValue();
-				const float *in = &inData->readable().front();
-
-				const Box2i inTileBound( inTileOrigin, inTileOrigin + V2i( ImagePlug::tileSize() ) );
-				const Box2i inRegion = BufferAlgo::intersection(
-					inBound,
-					inTileBound
+				memcpy(
+					// to
+					out + BufferAlgo::index( inScanlineOrigin + offset, outTileBound ),
+					// from
+					in + BufferAlgo::index( inScanlineOrigin, inTileBound ),
+					sizeof( float ) * scanlineLength
 				);
-
-				V2i inScanlineOrigin = inRegion.min;
-				const size_t scanlineLength = inRegion.size().x;
-				while( inScanlineOrigin.y < inRegion.max.y )
-				{
-					memcpy(
-						// to
-						out + BufferAlgo::index( inScanlineOrigin + offset, outTileBound ),
-						// from
-						in + BufferAlgo::index( inScanlineOrigin, inTileBound ),
-						sizeof( float ) * scanlineLength
-					);
-					++inScanlineOrigin.y;
-				}
+				++inScanlineOrigin.y;
 			}
 		}
 
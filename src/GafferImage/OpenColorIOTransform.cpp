@@ -40,6 +40,7 @@
 #include "IECore/SimpleTypedData.h"
 
 #include "Gaffer/Context.h"
+#include "Gaffer/Private/IECorePreview/LRUCache.h"
 
 #include "GafferImage/OpenColorIOTransform.h"
 
@@ -66,6 +67,31 @@ typedef tbb::null_mutex OCIOMutex;
 
 static OCIOMutex g_ocioMutex;
 
+// Creating a Processor can be expensive, and we'd otherwise be doing it
+// for every tile, so we cache them. The key combines the cache ID of the
+// config with the hash of the transform, so we automatically get new
+// processors if either changes. We only ever use getIfCached() and
+// setIfUncached(), because the transform itself is needed to make a
+// processor and can't be derived from the key.
+
+typedef IECorePreview::LRUCache<IECore::MurmurHash, OpenColorIO::ConstProcessorRcPtr> ProcessorCache;
+
+OpenColorIO::ConstProcessorRcPtr processorCacheGetter( const IECore::MurmurHash &h, size_t &cost )
+{
+	throw IECore::Exception( "Unexpected call to processorCacheGetter" );
+}
+
+size_t processorCost( const OpenColorIO::ConstProcessorRcPtr &processor )
+{
+	return 1;
+}
+
+ProcessorCache &processorCache()
+{
+	static ProcessorCache *g_cache = new ProcessorCache( processorCacheGetter, 100 );
+	return *g_cache;
+}
+
 } // namespace
 
 IE_CORE_DEFINERUNTIMETYPED( OpenColorIOTransform );
@@ -110,17 +136,31 @@ void OpenColorIOTransform::hashColorData( const Gaffer::Context *context, IECore
 
 void OpenColorIOTransform::processColorData( const Gaffer::Context *context, IECore::FloatVectorData *r, IECore::FloatVectorData *g, IECore::FloatVectorData *b ) const
 {
-	OpenColorIO::ConstTransformRcPtr colorTransform = transform();
-	if( !colorTransform )
-	{
-		return;
-	}
+	OpenColorIO::ConstConfigRcPtr config = OpenColorIO::GetCurrentConfig();
+
+	MurmurHash processorHash;
+	processorHash.append( typeId() );
+	processorHash.append( config->getCacheID() );
+	hashTransform( context, processorHash );
 
 	OpenColorIO::ConstProcessorRcPtr processor;
+	if( boost::optional<OpenColorIO::ConstProcessorRcPtr> cached = processorCache().getIfCached( processorHash ) )
+	{
+		processor = *cached;
+	}
+	else
 	{
-		OCIOMutex::scoped_lock lock( g_ocioMutex );
-		OpenColorIO::ConstConfigRcPtr config = OpenColorIO::GetCurrentConfig();
-		processor = config->getProcessor( colorTransform );
+		OpenColorIO::ConstTransformRcPtr colorTransform = transform();
+		if( !colorTransform )
+		{
+			return;
+		}
+
+		{
+			OCIOMutex::scoped_lock lock( g_ocioMutex );
+			processor = config->getProcessor( colorTransform );
+		}
+		processorCache().setIfUncached( processorHash, processor, processorCost );
 	}
 
 	OpenColorIO::PlanarImageDesc image(
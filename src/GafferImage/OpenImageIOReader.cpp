@@ -37,17 +37,30 @@
 
 #include "boost/bind.hpp"
 #include "boost/filesystem/path.hpp"
+#include "boost/noncopyable.hpp"
 #include "boost/regex.hpp"
+#include "boost/shared_ptr.hpp"
 
 #include "OpenEXR/half.h"
 
+#include <fstream>
+#include <limits>
+
+#include "tbb/spin_mutex.h"
+#include "tbb/concurrent_queue.h"
+#include "tbb/tbb_thread.h"
+
 #include "OpenImageIO/imagecache.h"
+#include "OpenImageIO/imageio.h"
 OIIO_NAMESPACE_USING
 
 #include "IECore/FileSequence.h"
 #include "IECore/FileSequenceFunctions.h"
+#include "IECore/ObjectVector.h"
 
 #include "Gaffer/Context.h"
+#include "Gaffer/MemoryGovernor.h"
+#include "Gaffer/Private/IECorePreview/LRUCache.h"
 #include "Gaffer/StringPlug.h"
 
 #include "GafferImage/OpenImageIOReader.h"
@@ -71,54 +84,492 @@ using namespace Gaffer;
 namespace
 {
 
-spin_rw_mutex g_imageCacheMutex;
+ImageCache *createImageCache()
+{
+	ImageCache *cache = ImageCache::create();
+	// ImageReaderTest.testOIIOJpgRead exposes a bug in
+	// OpenImageIO where ImageCache::get_pixels() returns
+	// incorrect data when reading from non-float images.
+	// By forcing the image to be float on loading, we
+	// can work around that problem.
+	/// \todo Consider removing this once the bug is fixed in
+	/// OIIO - and test any performance implications of performing
+	/// the conversion in get_pixels() rather than immediately on load.
+	cache->attribute( "forcefloat", 1 );
+
+	// Set an initial cache size of 500Mb
+	cache->attribute( "max_memory_MB", 500.0f );
+
+	return cache;
+}
+
+// The initialisation of function-level statics is threadsafe, so
+// there is no need for any locking after the first call.
 ImageCache *imageCache()
 {
-	spin_rw_mutex::scoped_lock lock( g_imageCacheMutex, false );
-	static ImageCache *cache = 0;
-	if( cache == 0 )
+	static ImageCache *g_cache = createImageCache();
+	return g_cache;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Direct reads. When enabled, tiled files whose tiles match our own are
+// read with ImageInput::read_tiles(), bypassing the ImageCache entirely
+// so that the Gaffer cache is the only one holding the pixels. ImageInputs
+// aren't threadsafe, so we keep a pool of open files, and each compute
+// checks one out for exclusive use while it reads.
+//////////////////////////////////////////////////////////////////////////
+
+bool g_directReads = false;
+
+class ImageInputPool
+{
+
+	public :
+
+		ImageInputPool()
+		{
+		}
+
+		~ImageInputPool()
+		{
+			clear();
+		}
+
+		ImageInput *acquire( const std::string &fileName )
+		{
+			{
+				spin_mutex::scoped_lock lock( m_mutex );
+				Inputs::iterator it = m_inputs.find( fileName );
+				if( it != m_inputs.end() )
+				{
+					ImageInput *result = it->second;
+					m_inputs.erase( it );
+					return result;
+				}
+			}
+
+			ImageInput *result = ImageInput::open( fileName );
+			if( !result )
+			{
+				throw IECore::Exception( OIIO::geterror() );
+			}
+			return result;
+		}
+
+		void release( const std::string &fileName, ImageInput *input )
+		{
+			{
+				spin_mutex::scoped_lock lock( m_mutex );
+				if( m_inputs.size() < g_maxInputs )
+				{
+					m_inputs.insert( Inputs::value_type( fileName, input ) );
+					return;
+				}
+			}
+			destroy( input );
+		}
+
+		void clear()
+		{
+			Inputs inputs;
+			{
+				spin_mutex::scoped_lock lock( m_mutex );
+				inputs.swap( m_inputs );
+			}
+			for( Inputs::const_iterator it = inputs.begin(), eIt = inputs.end(); it != eIt; ++it )
+			{
+				destroy( it->second );
+			}
+		}
+
+	private :
+
+		static void destroy( ImageInput *input )
+		{
+			input->close();
+			ImageInput::destroy( input );
+		}
+
+		// Enough for one handle per thread for a handful
+		// of plates, without risking running out of file
+		// descriptors.
+		static const size_t g_maxInputs = 256;
+
+		typedef std::multimap<std::string, ImageInput *> Inputs;
+		Inputs m_inputs;
+		spin_mutex m_mutex;
+
+};
+
+ImageInputPool &imageInputPool()
+{
+	static ImageInputPool *pool = new ImageInputPool;
+	return *pool;
+}
+
+// Checks an ImageInput out of the pool for the
+// lifetime of the scope.
+class PooledImageInput : boost::noncopyable
+{
+
+	public :
+
+		PooledImageInput( const std::string &fileName )
+			:	m_fileName( fileName ), m_input( imageInputPool().acquire( fileName ) )
+		{
+		}
+
+		~PooledImageInput()
+		{
+			imageInputPool().release( m_fileName, m_input );
+		}
+
+		ImageInput *operator->() const
+		{
+			return m_input;
+		}
+
+	private :
+
+		const std::string m_fileName;
+		ImageInput *m_input;
+
+};
+
+int positiveModulo( int a, int b )
+{
+	const int r = a % b;
+	return r < 0 ? r + b : r;
+}
+
+// Reads all channels of the EXR space region starting at `begin` and
+// extending for one tile, writing them into `data` with the specified
+// strides. Returns false if the file layout doesn't allow the region to
+// be read directly, in which case nothing is written.
+bool directRead( const std::string &fileName, const ImageSpec &spec, const V2i &begin, float *data, stride_t xStride, stride_t yStride )
+{
+	const int tileSize = ImagePlug::tileSize();
+	if(
+		spec.deep || spec.depth > 1 ||
+		spec.tile_width != tileSize || spec.tile_height != tileSize || spec.tile_depth > 1 ||
+		positiveModulo( begin.x - spec.x, tileSize ) || positiveModulo( begin.y - spec.y, tileSize )
+	)
+	{
+		// Scanline files aren't read directly, because each tile in a
+		// row would decompress the same scanlines again, whereas the
+		// ImageCache only has to do it once.
+		return false;
+	}
+
+	// Our tile is aligned with one in the file, so all we have to do
+	// is clip it to the data window.
+	const V2i min( std::max( begin.x, spec.x ), std::max( begin.y, spec.y ) );
+	const V2i max( std::min( begin.x + tileSize, spec.x + spec.width ), std::min( begin.y + tileSize, spec.y + spec.height ) );
+	if( min.x >= max.x || min.y >= max.y )
+	{
+		// Entirely outside the data window, so there's
+		// nothing to read.
+		return true;
+	}
+
+	char *start = reinterpret_cast<char *>( data ) + ( min.x - begin.x ) * xStride + ( min.y - begin.y ) * yStride;
+
+	PooledImageInput input( fileName );
+	if( !input->read_tiles( min.x, max.x, min.y, max.y, 0, 1, 0, spec.nchannels, TypeDesc::FLOAT, start, xStride, yStride ) )
+	{
+		throw IECore::Exception( input->geterror() );
+	}
+
+	return true;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Read ahead. When frames of a sequence are accessed in order, we queue
+// the following frames to be loaded on a small pool of dedicated threads,
+// so that file access latency is hidden behind the processing of the
+// current frame. We use dedicated threads rather than TBB tasks because
+// the work is I/O bound and would otherwise tie up the compute threads.
+//////////////////////////////////////////////////////////////////////////
+
+int g_readAheadFrames = 0;
+
+// Fills `result` with the interleaved pixels for the tile at `tileOrigin`
+// in the image scaled down for `proxyLevel`, in Gaffer's bottom-to-top row
+// order. Uses the matching MIP level when the file provides one, and
+// otherwise box filters the full resolution pixels.
+void readProxyPixels( const std::string &fileName, const ImageSpec &spec, const Format &format, const V2i &tileOrigin, int proxyLevel, float *result )
+{
+	const int tileSize = ImagePlug::tileSize();
+	const int numChannels = spec.nchannels;
+	const stride_t xStride = numChannels * sizeof( float );
+
+	const Format proxyFormat = FormatPlug::proxyFormat( format, proxyLevel );
+	const Box2i proxyDataWindow = FormatPlug::proxyWindow(
+		format.fromEXRSpace( Box2i( V2i( spec.x, spec.y ), V2i( spec.x + spec.width - 1, spec.y + spec.height - 1 ) ) ),
+		proxyLevel
+	);
+
+	const ustring uFileName( fileName );
+	const ImageSpec *mipSpec = imageCache()->imagespec( uFileName, 0, proxyLevel );
+	if(
+		mipSpec &&
+		Box2i( V2i( mipSpec->full_x, mipSpec->full_y ), V2i( mipSpec->full_x + mipSpec->full_width, mipSpec->full_y + mipSpec->full_height ) ) == proxyFormat.getDisplayWindow() &&
+		proxyFormat.fromEXRSpace( Box2i( V2i( mipSpec->x, mipSpec->y ), V2i( mipSpec->x + mipSpec->width - 1, mipSpec->y + mipSpec->height - 1 ) ) ) == proxyDataWindow
+	)
+	{
+		const int newY = proxyFormat.toEXRSpace( tileOrigin.y + tileSize - 1 );
+		imageCache()->get_pixels(
+			uFileName,
+			0, proxyLevel, // subimage, miplevel
+			tileOrigin.x, tileOrigin.x + tileSize,
+			newY, newY + tileSize,
+			0, 1,
+			0, numChannels,
+			TypeDesc::FLOAT,
+			result + ( tileSize - 1 ) * tileSize * numChannels,
+			xStride, -(stride_t)tileSize * xStride
+		);
+		return;
+	}
+
+	// No suitable MIP level, so read the full resolution region
+	// covered by the tile and average it down.
+	const int factor = 1 << proxyLevel;
+	const int sourceSize = tileSize * factor;
+	const V2i sourceOrigin = tileOrigin * factor;
+	const int newY = format.toEXRSpace( sourceOrigin.y + sourceSize - 1 );
+
+	std::vector<float> source( sourceSize * sourceSize * numChannels );
+	imageCache()->get_pixels(
+		uFileName,
+		0, 0, // subimage, miplevel
+		sourceOrigin.x, sourceOrigin.x + sourceSize,
+		newY, newY + sourceSize,
+		0, 1,
+		0, numChannels,
+		TypeDesc::FLOAT,
+		&(source[( sourceSize - 1 ) * sourceSize * numChannels]),
+		xStride, -(stride_t)sourceSize * xStride
+	);
+
+	const float weight = 1.0f / ( factor * factor );
+	std::fill( result, result + tileSize * tileSize * numChannels, 0.0f );
+	for( int sy = 0; sy < sourceSize; ++sy )
 	{
-		if( lock.upgrade_to_writer() )
+		const float *in = &(source[sy * sourceSize * numChannels]);
+		float *outRow = result + ( sy / factor ) * tileSize * numChannels;
+		for( int sx = 0; sx < sourceSize; ++sx )
 		{
-			cache = ImageCache::create();
-			// ImageReaderTest.testOIIOJpgRead exposes a bug in
-			// OpenImageIO where ImageCache::get_pixels() returns
-			// incorrect data when reading from non-float images.
-			// By forcing the image to be float on loading, we
-			// can work around that problem.
-			/// \todo Consider removing this once the bug is fixed in
-			/// OIIO - and test any performance implications of performing
-			/// the conversion in get_pixels() rather than immediately on load.
-			cache->attribute( "forcefloat", 1 );
-
-			// Set an initial cache size of 500Mb
-			cache->attribute( "max_memory_MB", 500.0f );
+			float *out = outRow + ( sx / factor ) * numChannels;
+			for( int c = 0; c < numChannels; ++c )
+			{
+				out[c] += *in++ * weight;
+			}
 		}
 	}
-	return cache;
+}
+
+class ReadAhead : boost::noncopyable
+{
+
+	public :
+
+		ReadAhead()
+		{
+			// Bound the queue so that we never get too far
+			// behind if the reads are slower than playback.
+			m_queue.set_capacity( 32 );
+			for( int i = 0; i < g_numThreads; ++i )
+			{
+				tbb::tbb_thread( &ReadAhead::threadFunction, this ).detach();
+			}
+		}
+
+		// To be called with the unsubstituted file name and the
+		// frame currently being read.
+		void frameAccessed( const std::string &fileName, const Context *context )
+		{
+			const int frame = (int)context->getFrame();
+
+			int first, last;
+			{
+				spin_mutex::scoped_lock lock( m_mutex );
+				Sequence &sequence = m_sequences[fileName];
+				if( frame == sequence.lastFrame )
+				{
+					return;
+				}
+				if( frame != sequence.lastFrame + 1 )
+				{
+					// Random access - wait to see if we're
+					// being read in order before reading ahead.
+					sequence.lastFrame = frame;
+					sequence.queuedUntil = frame;
+					return;
+				}
+				sequence.lastFrame = frame;
+				first = std::max( frame, sequence.queuedUntil ) + 1;
+				last = frame + g_readAheadFrames;
+				sequence.queuedUntil = std::max( sequence.queuedUntil, last );
+			}
+
+			ContextPtr frameContext = new Context( *context, Context::Shared );
+			for( int f = first; f <= last; ++f )
+			{
+				frameContext->setFrame( f );
+				if( !m_queue.try_push( frameContext->substitute( fileName ) ) )
+				{
+					break;
+				}
+			}
+		}
+
+	private :
+
+		static void threadFunction( ReadAhead *readAhead )
+		{
+			while( true )
+			{
+				std::string fileName;
+				readAhead->m_queue.pop( fileName );
+				readAhead->read( fileName );
+			}
+		}
+
+		void read( const std::string &fileName )
+		{
+			ImageCache *cache = imageCache();
+			const ImageSpec *spec = cache->imagespec( ustring( fileName ) );
+			if( !spec )
+			{
+				// Missing frames are dealt with when they're
+				// actually requested.
+				cache->geterror();
+				return;
+			}
+
+			const size_t frameBytes = spec->image_bytes();
+			if( frameBytes * g_readAheadFrames > OpenImageIOReader::getCacheMemoryLimit() / 2 )
+			{
+				// Reading ahead would just evict the frames currently
+				// being used from the cache. Instead, warm the operating
+				// system's file cache, which is not limited in the
+				// same way.
+				warmFile( fileName );
+				return;
+			}
+
+			if( g_directReads && spec->tile_width == ImagePlug::tileSize() && spec->tile_height == ImagePlug::tileSize() )
+			{
+				// This file will bypass the ImageCache. Warm the file
+				// cache instead.
+				warmFile( fileName );
+				return;
+			}
+
+			// Load the tiles into the ImageCache. Untiled files are
+			// treated as a single tile by the cache.
+			const int tileWidth = spec->tile_width ? spec->tile_width : spec->width;
+			const int tileHeight = spec->tile_height ? spec->tile_height : spec->height;
+			const ustring uFileName( fileName );
+			for( int y = spec->y; y < spec->y + spec->height; y += tileHeight )
+			{
+				for( int x = spec->x; x < spec->x + spec->width; x += tileWidth )
+				{
+					if( ImageCache::Tile *tile = cache->get_tile( uFileName, 0, 0, x, y, spec->z ) )
+					{
+						cache->release_tile( tile );
+					}
+				}
+			}
+			cache->geterror();
+		}
+
+		static void warmFile( const std::string &fileName )
+		{
+			std::ifstream file( fileName.c_str(), std::ios::binary );
+			std::vector<char> buffer( 1024 * 1024 );
+			while( file.read( &buffer[0], buffer.size() ) )
+			{
+			}
+		}
+
+		struct Sequence
+		{
+			Sequence() : lastFrame( std::numeric_limits<int>::min() ), queuedUntil( std::numeric_limits<int>::min() ) {}
+			int lastFrame;
+			int queuedUntil;
+		};
+
+		static const int g_numThreads = 2;
+
+		typedef std::map<std::string, Sequence> Sequences;
+		Sequences m_sequences;
+		spin_mutex m_mutex;
+
+		tbb::concurrent_bounded_queue<std::string> m_queue;
+
+};
+
+ReadAhead &readAhead()
+{
+	static ReadAhead *r = new ReadAhead;
+	return *r;
+}
+
+// Every compute needs the ImageSpec for its file, and querying it from
+// the ImageCache is relatively expensive, so we keep our own cache of
+// copies, keyed by resolved file name. This is cleared whenever the
+// ImageCache is invalidated. We only ever use getIfCached() and
+// setIfUncached(), so that failures are not remembered, and we can
+// still get the error from the ImageCache when a file is missing.
+
+typedef boost::shared_ptr<const ImageSpec> ConstImageSpecPtr;
+typedef IECorePreview::LRUCache<std::string, ConstImageSpecPtr> ImageSpecCache;
+
+ConstImageSpecPtr imageSpecCacheGetter( const std::string &fileName, size_t &cost )
+{
+	throw IECore::Exception( "Unexpected call to imageSpecCacheGetter" );
+}
+
+size_t imageSpecCost( const ConstImageSpecPtr &spec )
+{
+	return 1;
+}
+
+ImageSpecCache &imageSpecCache()
+{
+	static ImageSpecCache *g_cache = new ImageSpecCache( imageSpecCacheGetter, 10000 );
+	return *g_cache;
 }
 
 // Returns the OIIO ImageSpec for the given filename in the current
 // context. Throws if the file is invalid, and returns NULL if
 // the filename is empty.
-const ImageSpec *imageSpec( std::string &fileName, OpenImageIOReader::MissingFrameMode mode, const OpenImageIOReader *node, const Context *context )
+ConstImageSpecPtr imageSpec( std::string &fileName, OpenImageIOReader::MissingFrameMode mode, const OpenImageIOReader *node, const Context *context )
 {
 	if( fileName.empty() )
 	{
-		return NULL;
+		return ConstImageSpecPtr();
 	}
 
 	const std::string resolvedFileName = context->substitute( fileName );
 
+	if( boost::optional<ConstImageSpecPtr> cached = imageSpecCache().getIfCached( resolvedFileName ) )
+	{
+		fileName = resolvedFileName;
+		return *cached;
+	}
+
 	ImageCache *cache = imageCache();
-	const ImageSpec *spec = cache->imagespec( ustring( resolvedFileName ) );
-	if( !spec )
+	const ImageSpec *oiioSpec = cache->imagespec( ustring( resolvedFileName ) );
+	if( !oiioSpec )
 	{
 		if( mode == OpenImageIOReader::Black )
 		{
 			// we can simply return the null spec and rely on the
 			// compute methods to return default plug values.
-			return spec;
+			return ConstImageSpecPtr();
 		}
 		else if( mode == OpenImageIOReader::Hold )
 		{
@@ -162,6 +613,8 @@ const ImageSpec *imageSpec( std::string &fileName, OpenImageIOReader::MissingFra
 	// isn't available from the ImageSpec directly.
 	fileName = resolvedFileName;
 
+	ConstImageSpecPtr spec( new ImageSpec( *oiioSpec ) );
+	imageSpecCache().setIfUncached( resolvedFileName, spec, imageSpecCost );
 	return spec;
 }
 
@@ -346,6 +799,25 @@ void oiioParameterListToMetadata( const ImageIOParameterList &paramList, Compoun
 
 } // namespace
 
+//////////////////////////////////////////////////////////////////////////
+// Memory governor registration
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+struct ImageCacheRegistration
+{
+	ImageCacheRegistration()
+	{
+		MemoryGovernor::registerCache( "imageReaderCache", &OpenImageIOReader::cacheMemoryUsage, &OpenImageIOReader::setCacheMemoryLimit );
+	}
+};
+
+ImageCacheRegistration g_imageCacheRegistration;
+
+} // namespace
+
 //////////////////////////////////////////////////////////////////////////
 // OpenImageIOReader implementation
 //////////////////////////////////////////////////////////////////////////
@@ -368,8 +840,11 @@ OpenImageIOReader::OpenImageIOReader( const std::string &name )
 	addChild( new IntPlug( "refreshCount" ) );
 	addChild( new IntPlug( "missingFrameMode", Plug::In, Error, /* min */ Error, /* max */ Hold ) );
 	addChild( new IntVectorDataPlug( "availableFrames", Plug::Out, new IntVectorData ) );
+	addChild( new ObjectPlug( "__tileBatch", Plug::Out, new ObjectVector ) );
 
 	// disable caching on our outputs, as OIIO is already doing caching for us.
+	// The tile batch is still cached though, so that all the channels of a tile
+	// can be served by a single OIIO lookup.
 	for( OutputPlugIterator it( outPlug() ); !it.done(); ++it )
 	{
 		(*it)->setFlags( Plug::Cacheable, false );
@@ -422,6 +897,16 @@ const Gaffer::IntVectorDataPlug *OpenImageIOReader::availableFramesPlug() const
 	return getChild<IntVectorDataPlug>( g_firstPlugIndex + 3 );
 }
 
+Gaffer::ObjectPlug *OpenImageIOReader::tileBatchPlug()
+{
+	return getChild<ObjectPlug>( g_firstPlugIndex + 4 );
+}
+
+const Gaffer::ObjectPlug *OpenImageIOReader::tileBatchPlug() const
+{
+	return getChild<ObjectPlug>( g_firstPlugIndex + 4 );
+}
+
 size_t OpenImageIOReader::supportedExtensions( std::vector<std::string> &extensions )
 {
 	std::string attr;
@@ -457,6 +942,7 @@ void OpenImageIOReader::affects( const Gaffer::Plug *input, AffectedPlugsContain
 
 	if( input == fileNamePlug() || input == refreshCountPlug() || input == missingFrameModePlug() )
 	{
+		outputs.push_back( tileBatchPlug() );
 		for( ValuePlugIterator it( outPlug() ); !it.done(); ++it )
 		{
 			outputs.push_back( it->get() );
@@ -473,6 +959,14 @@ void OpenImageIOReader::hash( const ValuePlug *output, const Context *context, I
 		fileNamePlug()->hash( h );
 		refreshCountPlug()->hash( h );
 	}
+	else if( output == tileBatchPlug() )
+	{
+		h.append( context->get<V2i>( ImagePlug::tileOriginContextName ) );
+		h.append( FormatPlug::getProxyLevel( context ) );
+		hashFileName( context, h );
+		refreshCountPlug()->hash( h );
+		missingFrameModePlug()->hash( h );
+	}
 }
 
 void OpenImageIOReader::compute( ValuePlug *output, const Context *context ) const
@@ -497,6 +991,10 @@ void OpenImageIOReader::compute( ValuePlug *output, const Context *context ) con
 			static_cast<IntVectorDataPlug *>( output )->setToDefault();
 		}
 	}
+	else if( output == tileBatchPlug() )
+	{
+		static_cast<ObjectPlug *>( output )->setValue( computeTileBatch( context ) );
+	}
 	else
 	{
 		ImageNode::compute( output, context );
@@ -520,6 +1018,7 @@ void OpenImageIOReader::hashFileName( const Gaffer::Context *context, IECore::Mu
 void OpenImageIOReader::hashFormat( const GafferImage::ImagePlug *output, const Gaffer::Context *context, IECore::MurmurHash &h ) const
 {
 	ImageNode::hashFormat( output, context, h );
+	h.append( FormatPlug::getProxyLevel( context ) );
 	hashFileName( context, h );
 	refreshCountPlug()->hash( h );
 	missingFrameModePlug()->hash( h );
@@ -532,24 +1031,27 @@ GafferImage::Format OpenImageIOReader::computeFormat( const Gaffer::Context *con
 	// match the format of the Hold frame.
 	MissingFrameMode mode = (MissingFrameMode)missingFrameModePlug()->getValue();
 	mode = ( mode == Black ) ? Hold : mode;
-	const ImageSpec *spec = imageSpec( fileName, mode, this, context );
+	ConstImageSpecPtr spec = imageSpec( fileName, mode, this, context );
 	if( !spec )
 	{
 		return FormatPlug::getDefaultFormat( context );
 	}
 
-	return GafferImage::Format(
+	const GafferImage::Format format(
 		Imath::Box2i(
 			Imath::V2i( spec->full_x, spec->full_y ),
 			Imath::V2i( spec->full_x + spec->full_width, spec->full_y + spec->full_height )
 		),
 		spec->get_float_attribute( "PixelAspectRatio", 1.0f )
 	);
+
+	return FormatPlug::proxyFormat( format, FormatPlug::getProxyLevel( context ) );
 }
 
 void OpenImageIOReader::hashDataWindow( const GafferImage::ImagePlug *output, const Gaffer::Context *context, IECore::MurmurHash &h ) const
 {
 	ImageNode::hashDataWindow( output, context, h );
+	h.append( FormatPlug::getProxyLevel( context ) );
 	hashFileName( context, h );
 	refreshCountPlug()->hash( h );
 	missingFrameModePlug()->hash( h );
@@ -558,7 +1060,7 @@ void OpenImageIOReader::hashDataWindow( const GafferImage::ImagePlug *output, co
 Imath::Box2i OpenImageIOReader::computeDataWindow( const Gaffer::Context *context, const ImagePlug *parent ) const
 {
 	std::string fileName = fileNamePlug()->getValue();
-	const ImageSpec *spec = imageSpec( fileName, (MissingFrameMode)missingFrameModePlug()->getValue(), this, context );
+	ConstImageSpecPtr spec = imageSpec( fileName, (MissingFrameMode)missingFrameModePlug()->getValue(), this, context );
 	if( !spec )
 	{
 		return parent->dataWindowPlug()->defaultValue();
@@ -567,7 +1069,7 @@ Imath::Box2i OpenImageIOReader::computeDataWindow( const Gaffer::Context *contex
 	Format format( Imath::Box2i( Imath::V2i( spec->full_x, spec->full_y ), Imath::V2i( spec->full_width + spec->full_x, spec->full_height + spec->full_y ) ) );
 	Imath::Box2i dataWindow( Imath::V2i( spec->x, spec->y ), Imath::V2i( spec->width + spec->x - 1, spec->height + spec->y - 1 ) );
 
-	return format.fromEXRSpace( dataWindow );
+	return FormatPlug::proxyWindow( format.fromEXRSpace( dataWindow ), FormatPlug::getProxyLevel( context ) );
 }
 
 void OpenImageIOReader::hashMetadata( const GafferImage::ImagePlug *output, const Gaffer::Context *context, IECore::MurmurHash &h ) const
@@ -581,7 +1083,7 @@ void OpenImageIOReader::hashMetadata( const GafferImage::ImagePlug *output, cons
 IECore::ConstCompoundObjectPtr OpenImageIOReader::computeMetadata( const Gaffer::Context *context, const ImagePlug *parent ) const
 {
 	std::string fileName = fileNamePlug()->getValue();
-	const ImageSpec *spec = imageSpec( fileName, (MissingFrameMode)missingFrameModePlug()->getValue(), this, context );
+	ConstImageSpecPtr spec = imageSpec( fileName, (MissingFrameMode)missingFrameModePlug()->getValue(), this, context );
 	if( !spec )
 	{
 		return parent->metadataPlug()->defaultValue();
@@ -604,7 +1106,7 @@ void OpenImageIOReader::hashChannelNames( const GafferImage::ImagePlug *output,
 IECore::ConstStringVectorDataPtr OpenImageIOReader::computeChannelNames( const Gaffer::Context *context, const ImagePlug *parent ) const
 {
 	std::string fileName = fileNamePlug()->getValue();
-	const ImageSpec *spec = imageSpec( fileName, (MissingFrameMode)missingFrameModePlug()->getValue(), this, context );
+	ConstImageSpecPtr spec = imageSpec( fileName, (MissingFrameMode)missingFrameModePlug()->getValue(), this, context );
 	if( !spec )
 	{
 		return parent->channelNamesPlug()->defaultValue();
@@ -620,6 +1122,7 @@ void OpenImageIOReader::hashChannelData( const GafferImage::ImagePlug *output, c
 	ImageNode::hashChannelData( output, context, h );
 	h.append( context->get<V2i>( ImagePlug::tileOriginContextName ) );
 	h.append( context->get<std::string>( ImagePlug::channelNameContextName ) );
+	h.append( FormatPlug::getProxyLevel( context ) );
 	hashFileName( context, h );
 	refreshCountPlug()->hash( h );
 	missingFrameModePlug()->hash( h );
@@ -628,7 +1131,7 @@ void OpenImageIOReader::hashChannelData( const GafferImage::ImagePlug *output, c
 IECore::ConstFloatVectorDataPtr OpenImageIOReader::computeChannelData( const std::string &channelName, const Imath::V2i &tileOrigin, const Gaffer::Context *context, const ImagePlug *parent ) const
 {
 	std::string fileName = fileNamePlug()->getValue();
-	const ImageSpec *spec = imageSpec( fileName, (MissingFrameMode)missingFrameModePlug()->getValue(), this, context );
+	ConstImageSpecPtr spec = imageSpec( fileName, (MissingFrameMode)missingFrameModePlug()->getValue(), this, context );
 	if( !spec )
 	{
 		return parent->channelDataPlug()->defaultValue();
@@ -637,39 +1140,117 @@ IECore::ConstFloatVectorDataPtr OpenImageIOReader::computeChannelData( const std
 	vector<string>::const_iterator channelIt = find( spec->channelnames.begin(), spec->channelnames.end(), channelName );
 	if( channelIt == spec->channelnames.end() )
 	{
-		{
-			return parent->channelDataPlug()->defaultValue();
-		}
+		return parent->channelDataPlug()->defaultValue();
+	}
+
+	ConstObjectVectorPtr tileBatch;
+	{
+		Context::EditableScope scope( context );
+		scope.remove( ImagePlug::channelNameContextName );
+		tileBatch = boost::static_pointer_cast<const ObjectVector>( tileBatchPlug()->getValue() );
+	}
+
+	const size_t channelIndex = channelIt - spec->channelnames.begin();
+	if( channelIndex >= tileBatch->members().size() )
+	{
+		// The file has changed on disk since the batch was read.
+		return parent->channelDataPlug()->defaultValue();
 	}
 
+	return boost::static_pointer_cast<const FloatVectorData>( tileBatch->members()[channelIndex] );
+}
+
+IECore::ConstObjectVectorPtr OpenImageIOReader::computeTileBatch( const Gaffer::Context *context ) const
+{
+	ObjectVectorPtr result = new ObjectVector;
+
+	std::string fileName = fileNamePlug()->getValue();
+	if( g_readAheadFrames > 0 && Context::substitutions( fileName ) & Context::FrameSubstitutions )
+	{
+		readAhead().frameAccessed( fileName, context );
+	}
+
+	ConstImageSpecPtr spec = imageSpec( fileName, (MissingFrameMode)missingFrameModePlug()->getValue(), this, context );
+	if( !spec || !spec->nchannels )
+	{
+		return result;
+	}
+
+	const V2i tileOrigin = context->get<V2i>( ImagePlug::tileOriginContextName );
+	const int tileSize = ImagePlug::tileSize();
+	const int numChannels = spec->nchannels;
+
 	Format format( Imath::Box2i( Imath::V2i( spec->full_x, spec->full_y ), Imath::V2i( spec->full_width + spec->full_x, spec->full_height + spec->full_y ) ) );
-	const int newY = format.toEXRSpace( tileOrigin.y + ImagePlug::tileSize() - 1 );
+	const int newY = format.toEXRSpace( tileOrigin.y + tileSize - 1 );
+
+	// Read all channels in one go. We pass a pointer to the last row
+	// with a negative y stride, so that OIIO does the Y flip to our
+	// internal representation as it writes the pixels.
+	std::vector<float> interleaved( tileSize * tileSize * numChannels );
+	const stride_t xStride = numChannels * sizeof( float );
+	const stride_t yStride = -(stride_t)tileSize * xStride;
+	float *lastRow = &(interleaved[ ( tileSize - 1 ) * tileSize * numChannels ]);
+	const int proxyLevel = FormatPlug::getProxyLevel( context );
+	if( proxyLevel )
+	{
+		readProxyPixels( fileName, *spec, format, tileOrigin, proxyLevel, &(interleaved[0]) );
+	}
+	else if( !g_directReads || !directRead( fileName, *spec, V2i( tileOrigin.x, newY ), lastRow, xStride, yStride ) )
+	{
+		imageCache()->get_pixels(
+			ustring( fileName ),
+			0, 0, // subimage, miplevel
+			tileOrigin.x, tileOrigin.x + tileSize,
+			newY, newY + tileSize,
+			0, 1,
+			0, numChannels,
+			TypeDesc::FLOAT,
+			lastRow,
+			xStride, yStride
+		);
+	}
 
-	std::vector<float> channelData( ImagePlug::tileSize() * ImagePlug::tileSize() );
-	size_t channelIndex = channelIt - spec->channelnames.begin();
-	imageCache()->get_pixels(
-		ustring( fileName ),
-		0, 0, // subimage, miplevel
-		tileOrigin.x, tileOrigin.x + ImagePlug::tileSize(),
-		newY, newY + ImagePlug::tileSize(),
-		0, 1,
-		channelIndex, channelIndex + 1,
-		TypeDesc::FLOAT,
-		&(channelData[0])
-	);
+	// Deinterleave into the individual channels.
+	result->members().resize( numChannels );
+	const size_t numPixels = tileSize * tileSize;
+	for( int c = 0; c < numChannels; ++c )
+	{
+		FloatVectorDataPtr channelData = new FloatVectorData;
+		vector<float> &channel = channelData->writable();
+		channel.resize( numPixels );
+		const float *in = &(interleaved[c]);
+		for( size_t i = 0; i < numPixels; ++i, in += numChannels )
+		{
+			channel[i] = *in;
+		}
+		result->members()[c] = channelData;
+	}
 
-	// Create the output data buffer.
-	FloatVectorDataPtr resultData = new FloatVectorData;
-	vector<float> &result = resultData->writable();
-	result.resize( ImagePlug::tileSize() * ImagePlug::tileSize() );
+	return result;
+}
 
-	// Flip the tile in the Y axis to convert it to our internal image data representation.
-	for( int y = 0; y < ImagePlug::tileSize(); ++y )
+bool OpenImageIOReader::getDirectReadsEnabled()
+{
+	return g_directReads;
+}
+
+void OpenImageIOReader::setDirectReadsEnabled( bool enabled )
+{
+	g_directReads = enabled;
+	if( !enabled )
 	{
-		memcpy( &(result[ ( ImagePlug::tileSize() - y - 1 ) * ImagePlug::tileSize() ]), &(channelData[ y * ImagePlug::tileSize() ]), sizeof(float)*ImagePlug::tileSize()  );
+		imageInputPool().clear();
 	}
+}
 
-	return resultData;
+int OpenImageIOReader::getReadAheadFrames()
+{
+	return g_readAheadFrames;
+}
+
+void OpenImageIOReader::setReadAheadFrames( int frames )
+{
+	g_readAheadFrames = std::max( frames, 0 );
 }
 
 size_t OpenImageIOReader::getCacheMemoryLimit()
@@ -698,5 +1279,7 @@ void OpenImageIOReader::plugSet( Gaffer::Plug *plug )
 	if( plug == refreshCountPlug() )
 	{
 		imageCache()->invalidate_all( true );
+		imageSpecCache().clear();
+		imageInputPool().clear();
 	}
 }
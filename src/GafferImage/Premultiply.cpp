@@ -129,4 +129,13 @@ void Premultiply::processChannelData( const Gaffer::Context *context, const Imag
 	}
 }
 
+bool Premultiply::preservesBlack( const Gaffer::Context *context, const std::string &channel ) const
+{
+	// We return false for a missing alpha channel, so that
+	// processChannelData() can report the error.
+	ConstStringVectorDataPtr inChannelNamesPtr = inPlug()->channelNamesPlug()->getValue();
+	const std::vector<std::string> &inChannelNames = inChannelNamesPtr->readable();
+	return std::find( inChannelNames.begin(), inChannelNames.end(), alphaChannelPlug()->getValue() ) != inChannelNames.end();
+}
+
 } // namespace GafferImage
@@ -262,13 +262,9 @@ Filter2DPtr createFilter( const std::string &name, const V2f &filterWidth, V2f r
 }
 
 // Precomputes all the filter weights for a whole row or column of a tile. For separable
-// filters these weights can then be reused across all rows/columns in the same tile.
-/// \todo The weights computed for a particular tile could also be reused for all
-/// tiles in the same tile column or row. We could achieve this by outputting
-/// the weights on an internal plug, and using Gaffer's caching to ensure they are
-/// only computed once and then reused. At the time of writing, profiles indicate that
-/// accessing pixels via the Sampler is the main bottleneck, but once that is optimised
-/// perhaps cached filter weights could have a benefit.
+// filters these weights can then be reused across all rows/columns in the same tile, and
+// because we output them on internal plugs, across all channels and all tiles in the
+// same tile column or row.
 void filterWeights( const OIIO::Filter2D *filter, const int filterRadius, const int x, const float ratio, const float offset, Passes pass, std::vector<float> &weights )
 {
 	weights.reserve( ( 2 * filterRadius + 1 ) * ImagePlug::tileSize() );
@@ -291,6 +287,48 @@ void filterWeights( const OIIO::Filter2D *filter, const int filterRadius, const
 	}
 }
 
+// Returns true if we're downsizing by an integer factor using a box filter
+// exactly one output pixel wide, with input pixels aligned to output pixels.
+// In this case each output pixel is just the mean of a block of `factor`
+// input pixels, whose minimum is `tileOrigin * factor + blockOffset`, and
+// we can bypass all the general filtering machinery.
+bool boxDownsize( const Resample *resample, const ImagePlug *image, const OIIO::Filter2D *filter, const V2f &ratio, const V2f &offset, V2i &factor, V2i &blockOffset )
+{
+	if( image != image->parent<ImageNode>()->outPlug() || resample->debugPlug()->getValue() != Resample::Off )
+	{
+		return false;
+	}
+
+	if( strcmp( filter->name().c_str(), "box" ) || filter->width() != 1.0f || filter->height() != 1.0f )
+	{
+		return false;
+	}
+
+	for( int i = 0; i < 2; ++i )
+	{
+		if( ratio[i] <= 0.0f || ratio[i] > 1.0f )
+		{
+			return false;
+		}
+
+		const float inverseRatio = 1.0f / ratio[i];
+		factor[i] = (int)roundf( inverseRatio );
+		blockOffset[i] = (int)roundf( offset[i] );
+		if( fabs( inverseRatio - factor[i] ) > 1e-5f || fabs( offset[i] - blockOffset[i] ) > 1e-4f )
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+Box2i boxDownsizeInputRegion( const V2i &tileOrigin, const V2i &factor, const V2i &blockOffset )
+{
+	const V2i min( tileOrigin.x * factor.x + blockOffset.x, tileOrigin.y * factor.y + blockOffset.y );
+	return Box2i( min, min + factor * ImagePlug::tileSize() );
+}
+
 Box2f transform( const Box2f &b, const M33f &m )
 {
 	if( b.isEmpty() )
@@ -327,6 +365,8 @@ Resample::Resample( const std::string &name )
 	addChild( new BoolPlug( "expandDataWindow" ) );
 	addChild( new IntPlug( "debug", Plug::In, Off, Off, SinglePass ) );
 	addChild( new ImagePlug( "__horizontalPass", Plug::Out ) );
+	addChild( new FloatVectorDataPlug( "__horizontalWeights", Plug::Out, new FloatVectorData ) );
+	addChild( new FloatVectorDataPlug( "__verticalWeights", Plug::Out, new FloatVectorData ) );
 
 	// We don't ever want to change these, so we make pass-through connections.
 
@@ -414,6 +454,26 @@ const ImagePlug *Resample::horizontalPassPlug() const
 	return getChild<ImagePlug>( g_firstPlugIndex + 6 );
 }
 
+Gaffer::FloatVectorDataPlug *Resample::horizontalWeightsPlug()
+{
+	return getChild<FloatVectorDataPlug>( g_firstPlugIndex + 7 );
+}
+
+const Gaffer::FloatVectorDataPlug *Resample::horizontalWeightsPlug() const
+{
+	return getChild<FloatVectorDataPlug>( g_firstPlugIndex + 7 );
+}
+
+Gaffer::FloatVectorDataPlug *Resample::verticalWeightsPlug()
+{
+	return getChild<FloatVectorDataPlug>( g_firstPlugIndex + 8 );
+}
+
+const Gaffer::FloatVectorDataPlug *Resample::verticalWeightsPlug() const
+{
+	return getChild<FloatVectorDataPlug>( g_firstPlugIndex + 8 );
+}
+
 void Resample::affects( const Gaffer::Plug *input, AffectedPlugsContainer &outputs ) const
 {
 	ImageProcessor::affects( input, outputs );
@@ -444,6 +504,22 @@ void Resample::affects( const Gaffer::Plug *input, AffectedPlugsContainer &outpu
 		outputs.push_back( outPlug()->channelDataPlug() );
 		outputs.push_back( horizontalPassPlug()->channelDataPlug() );
 	}
+
+	if(
+		input == matrixPlug() ||
+		input == filterPlug() ||
+		input->parent<V2fPlug>() == filterWidthPlug()
+	)
+	{
+		outputs.push_back( horizontalWeightsPlug() );
+		outputs.push_back( verticalWeightsPlug() );
+	}
+
+	if( input == horizontalWeightsPlug() || input == verticalWeightsPlug() )
+	{
+		outputs.push_back( outPlug()->channelDataPlug() );
+		outputs.push_back( horizontalPassPlug()->channelDataPlug() );
+	}
 }
 
 const std::vector<std::string> &Resample::filters()
@@ -461,6 +537,58 @@ const std::vector<std::string> &Resample::filters()
 	return f;
 }
 
+void Resample::hash( const Gaffer::ValuePlug *output, const Gaffer::Context *context, IECore::MurmurHash &h ) const
+{
+	ImageProcessor::hash( output, context, h );
+
+	if( output == horizontalWeightsPlug() || output == verticalWeightsPlug() )
+	{
+		matrixPlug()->hash( h );
+		filterPlug()->hash( h );
+		filterWidthPlug()->hash( h );
+		// Only the tile column (or row) affects the weights, so we
+		// don't hash the full tile origin. This allows all tiles in
+		// the same column (or row) to share a single cache entry.
+		const V2i tileOrigin = context->get<V2i>( ImagePlug::tileOriginContextName );
+		h.append( output == horizontalWeightsPlug() ? tileOrigin.x : tileOrigin.y );
+	}
+}
+
+void Resample::compute( Gaffer::ValuePlug *output, const Gaffer::Context *context ) const
+{
+	if( output == horizontalWeightsPlug() || output == verticalWeightsPlug() )
+	{
+		V2f ratio, offset;
+		ratioAndOffset( matrixPlug()->getValue(), ratio, offset );
+
+		Filter2DPtr filter = createFilter( filterPlug()->getValue(), filterWidthPlug()->getValue(), ratio );
+		const V2i filterRadius = inputFilterRadius( filter.get(), ratio );
+		const V2i tileOrigin = context->get<V2i>( ImagePlug::tileOriginContextName );
+
+		FloatVectorDataPtr weights = new FloatVectorData;
+		if( output == horizontalWeightsPlug() )
+		{
+			filterWeights( filter.get(), filterRadius.x, tileOrigin.x, ratio.x, offset.x, Horizontal, weights->writable() );
+		}
+		else
+		{
+			filterWeights( filter.get(), filterRadius.y, tileOrigin.y, ratio.y, offset.y, Vertical, weights->writable() );
+		}
+
+		static_cast<FloatVectorDataPlug *>( output )->setValue( weights );
+		return;
+	}
+
+	ImageProcessor::compute( output, context );
+}
+
+IECore::ConstFloatVectorDataPtr Resample::cachedFilterWeights( const Gaffer::FloatVectorDataPlug *weightsPlug, const Gaffer::Context *context ) const
+{
+	Context::EditableScope weightsScope( context );
+	weightsScope.remove( ImagePlug::channelNameContextName );
+	return weightsPlug->getValue();
+}
+
 void Resample::hashDataWindow( const GafferImage::ImagePlug *parent, const Gaffer::Context *context, IECore::MurmurHash &h ) const
 {
 	ImageProcessor::hashDataWindow( parent, context, h );
@@ -547,6 +675,24 @@ void Resample::hashChannelData( const GafferImage::ImagePlug *parent, const Gaff
 	const Filter2DPtr filter = createFilter( filterPlug()->getValue(), filterWidthPlug()->getValue(), ratio );
 	h.append( filter->name().c_str() );
 
+	const V2i tileOrigin = context->get<V2i>( ImagePlug::tileOriginContextName );
+
+	V2i factor, blockOffset;
+	if( boxDownsize( this, parent, filter.get(), ratio, offset, factor, blockOffset ) )
+	{
+		h.append( factor );
+		h.append( blockOffset );
+		Sampler sampler(
+			inPlug(),
+			context->get<std::string>( ImagePlug::channelNameContextName ),
+			boxDownsizeInputRegion( tileOrigin, factor, blockOffset ),
+			(Sampler::BoundingMode)boundingModePlug()->getValue()
+		);
+		sampler.hash( h );
+		h.append( tileOrigin );
+		return;
+	}
+
 	const unsigned passes = requiredPasses( this, parent, filter.get() );
 	if( passes & Horizontal )
 	{
@@ -561,7 +707,6 @@ void Resample::hashChannelData( const GafferImage::ImagePlug *parent, const Gaff
 		h.append( offset.y );
 	}
 
-	const V2i tileOrigin = context->get<V2i>( ImagePlug::tileOriginContextName );
 	Sampler sampler(
 		passes == Vertical ? horizontalPassPlug() : inPlug(),
 		context->get<std::string>( ImagePlug::channelNameContextName ),
@@ -582,6 +727,13 @@ IECore::ConstFloatVectorDataPtr Resample::computeChannelData( const std::string
 	ratioAndOffset( matrixPlug()->getValue(), ratio, offset );
 
 	Filter2DPtr filter = createFilter( filterPlug()->getValue(), filterWidthPlug()->getValue(), ratio );
+
+	V2i factor, blockOffset;
+	if( boxDownsize( this, parent, filter.get(), ratio, offset, factor, blockOffset ) )
+	{
+		return boxDownsizeChannelData( channelName, tileOrigin, factor, blockOffset, context );
+	}
+
 	const unsigned passes = requiredPasses( this, parent, filter.get() );
 
 	Sampler sampler(
@@ -590,6 +742,9 @@ IECore::ConstFloatVectorDataPtr Resample::computeChannelData( const std::string
 		inputRegion( tileOrigin, passes, ratio, offset, filter.get() ),
 		(Sampler::BoundingMode)boundingModePlug()->getValue()
 	);
+	// Large downsizes can require many input tiles, so
+	// we fetch them in parallel up front.
+	sampler.populate();
 
 	const V2i filterRadius = inputFilterRadius( filter.get(), ratio );
 	const Box2i tileBound( tileOrigin, tileOrigin + V2i( ImagePlug::tileSize() ) );
@@ -613,6 +768,7 @@ IECore::ConstFloatVectorDataPtr Resample::computeChannelData( const std::string
 
 		for( oP.y = tileBound.min.y; oP.y < tileBound.max.y; ++oP.y )
 		{
+			Canceller::check( context->canceller() );
 			iP.y = ( oP.y + 0.5 ) / ratio.y + offset.y;
 			iPF.y = OIIO::floorfrac( iP.y, &iPI.y );
 
@@ -663,21 +819,37 @@ IECore::ConstFloatVectorDataPtr Resample::computeChannelData( const std::string
 
 		// Pixels in the same column share the same filter weights, so
 		// we precompute the weights now to avoid repeating work later.
-		std::vector<float> weights;
-		filterWeights( filter.get(), filterRadius.x, tileBound.min.x, ratio.x, offset.x, Horizontal, weights );
+		ConstFloatVectorDataPtr weightsData = cachedFilterWeights( horizontalWeightsPlug(), context );
+		const std::vector<float> &weights = weightsData->readable();
+
+		// Likewise, pixels in the same column share the same input
+		// positions, and each output row reads from a single span of
+		// an input row, which we fetch in one go.
+		std::vector<int> inputX; // input pixel positions (floored to int)
+		inputX.reserve( ImagePlug::tileSize() );
+		for( int oX = tileBound.min.x; oX < tileBound.max.x; ++oX )
+		{
+			int iXI;
+			OIIO::floorfrac( ( oX + 0.5 ) / ratio.x + offset.x, &iXI );
+			inputX.push_back( iXI );
+		}
+
+		const int rowMin = std::min( inputX.front(), inputX.back() ) - filterRadius.x;
+		const int rowMax = std::max( inputX.front(), inputX.back() ) + filterRadius.x;
+		std::vector<float> row( rowMax - rowMin + 1 );
 
 		V2i oP; // output pixel position
-		float iX; // input pixel x coordinate (floating point)
-		int iXI; // input pixel position (floored to int)
 
 		for( oP.y = tileBound.min.y; oP.y < tileBound.max.y; ++oP.y )
 		{
+			Canceller::check( context->canceller() );
+			sampler.sampleRow( rowMin, oP.y, row.size(), &row[0] );
+
 			std::vector<float>::const_iterator wIt = weights.begin();
-			for( oP.x = tileBound.min.x; oP.x < tileBound.max.x; ++oP.x )
+			std::vector<int>::const_iterator iXIt = inputX.begin();
+			for( oP.x = tileBound.min.x; oP.x < tileBound.max.x; ++oP.x, ++iXIt )
 			{
-
-				iX = ( oP.x + 0.5 ) / ratio.x + offset.x;
-				OIIO::floorfrac( iX, &iXI );
+				const float *r = &row[*iXIt - rowMin];
 
 				int fX; // relative filter position
 				float v = 0.0f;
@@ -690,7 +862,7 @@ IECore::ConstFloatVectorDataPtr Resample::computeChannelData( const std::string
 						continue;
 					}
 
-					v += w * sampler.sample( iXI + fX, oP.y );
+					v += w * r[fX];
 					totalW += w;
 				}
 
@@ -711,40 +883,100 @@ IECore::ConstFloatVectorDataPtr Resample::computeChannelData( const std::string
 
 		// Pixels in the same row share the same filter weights, so
 		// we precompute the weights now to avoid repeating work later.
-		std::vector<float> weights;
-		filterWeights( filter.get(), filterRadius.y, tileBound.min.y, ratio.y, offset.y, Vertical, weights );
+		ConstFloatVectorDataPtr weightsData = cachedFilterWeights( verticalWeightsPlug(), context );
+		const std::vector<float> &weights = weightsData->readable();
+
+		// Since the weights are shared by the whole row, we can accumulate
+		// entire input rows at a time, in a loop that can be vectorised.
+		std::vector<float> row( ImagePlug::tileSize() );
+		std::vector<float> v( ImagePlug::tileSize() );
 
 		for( oP.y = tileBound.min.y; oP.y < tileBound.max.y; ++oP.y )
 		{
+			Canceller::check( context->canceller() );
 			iY = ( oP.y + 0.5 ) / ratio.y + offset.y;
 			OIIO::floorfrac( iY, &iYI );
 
-			for( oP.x = tileBound.min.x; oP.x < tileBound.max.x; ++oP.x )
+			int fY; // relative filter position
+			float totalW = 0.0f;
+			std::fill( v.begin(), v.end(), 0.0f );
+			std::vector<float>::const_iterator wIt = weights.begin() + ( oP.y - tileBound.min.y ) * ( filterRadius.y * 2 + 1);
+			for( fY = -filterRadius.y; fY<= filterRadius.y; ++fY )
 			{
-				int fY; // relative filter position
-				float v = 0.0f;
-				float totalW = 0.0f;
-				std::vector<float>::const_iterator wIt = weights.begin() + ( oP.y - tileBound.min.y ) * ( filterRadius.y * 2 + 1);
-				for( fY = -filterRadius.y; fY<= filterRadius.y; ++fY )
+				const float w = *wIt++;
+				if( w == 0.0f )
 				{
-					const float w = *wIt++;
-					if( w == 0.0f )
-					{
-						continue;
-					}
+					continue;
+				}
 
-					v += w * sampler.sample( oP.x, iYI + fY );
-					totalW += w;
+				sampler.sampleRow( tileBound.min.x, iYI + fY, ImagePlug::tileSize(), &row[0] );
+				for( int x = 0; x < ImagePlug::tileSize(); ++x )
+				{
+					v[x] += w * row[x];
 				}
+				totalW += w;
+			}
 
-				if( totalW != 0.0f )
+			if( totalW != 0.0f )
+			{
+				for( int x = 0; x < ImagePlug::tileSize(); ++x )
 				{
-					*pIt = v / totalW;
+					pIt[x] = v[x] / totalW;
 				}
+			}
 
-				++pIt;
+			pIt += ImagePlug::tileSize();
+		}
+	}
+
+	return resultData;
+}
+
+IECore::ConstFloatVectorDataPtr Resample::boxDownsizeChannelData( const std::string &channelName, const Imath::V2i &tileOrigin, const Imath::V2i &factor, const Imath::V2i &blockOffset, const Gaffer::Context *context ) const
+{
+	// Each output pixel is the mean of a block of input pixels, so
+	// rather than filter in two passes, we read whole input rows in
+	// a single pass and sum them in tight loops which the compiler can
+	// vectorise. This is much quicker than evaluating filter weights,
+	// and is bandwidth limited for the common proxy resolutions.
+
+	const Box2i region = boxDownsizeInputRegion( tileOrigin, factor, blockOffset );
+	Sampler sampler( inPlug(), channelName, region, (Sampler::BoundingMode)boundingModePlug()->getValue() );
+	sampler.populate();
+
+	FloatVectorDataPtr resultData = new FloatVectorData;
+	std::vector<float> &result = resultData->writable();
+	result.resize( ImagePlug::tileSize() * ImagePlug::tileSize() );
+
+	std::vector<float> row( region.size().x );
+	std::vector<float> v( ImagePlug::tileSize() );
+	const float scale = 1.0f / ( factor.x * factor.y );
+
+	std::vector<float>::iterator pIt = result.begin();
+	for( int y = region.min.y; y < region.max.y; y += factor.y )
+	{
+		Canceller::check( context->canceller() );
+		std::fill( v.begin(), v.end(), 0.0f );
+		for( int fY = 0; fY < factor.y; ++fY )
+		{
+			sampler.sampleRow( region.min.x, y + fY, row.size(), &row[0] );
+			const float *r = &row[0];
+			for( int x = 0; x < ImagePlug::tileSize(); ++x )
+			{
+				float s = 0.0f;
+				for( int fX = 0; fX < factor.x; ++fX )
+				{
+					s += *r++;
+				}
+				v[x] += s;
 			}
 		}
+
+		for( int x = 0; x < ImagePlug::tileSize(); ++x )
+		{
+			pIt[x] = v[x] * scale;
+		}
+		pIt += ImagePlug::tileSize();
 	}
 
 	return resultData;
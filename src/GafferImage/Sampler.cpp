@@ -35,6 +35,7 @@
 //////////////////////////////////////////////////////////////////////////
 
 #include "GafferImage/Sampler.h"
+#include "GafferImage/ImageAlgo.h"
 
 using namespace IECore;
 using namespace Imath;
@@ -89,6 +90,73 @@ Sampler::Sampler( const GafferImage::ImagePlug *plug, const std::string &channel
 	m_dataCache.resize( m_cacheWidth * cacheHeight, NULL );
 }
 
+void Sampler::sampleRow( int x, int y, int width, float *result )
+{
+	assert( BufferAlgo::contains( m_sampleWindow, V2i( x, y ) ) );
+	assert( BufferAlgo::contains( m_sampleWindow, V2i( x + width - 1, y ) ) );
+
+	float *resultEnd = result + width;
+	if(
+		BufferAlgo::empty( m_dataWindow ) ||
+		( m_boundingMode == Black && ( y < m_dataWindow.min.y || y >= m_dataWindow.max.y ) )
+	)
+	{
+		std::fill( result, resultEnd, 0.0f );
+		return;
+	}
+
+	y = std::max( m_dataWindow.min.y, std::min( y, m_dataWindow.max.y - 1 ) );
+
+	const float *tileData;
+	V2i tileOrigin;
+	V2i tileIndex;
+
+	// Pixels to the left of the data window.
+
+	const int begin = std::min( std::max( x, m_dataWindow.min.x ), x + width );
+	if( begin > x )
+	{
+		float value = 0.0f;
+		if( m_boundingMode == Clamp )
+		{
+			cachedData( V2i( m_dataWindow.min.x, y ), tileData, tileOrigin, tileIndex );
+			value = *(tileData + tileIndex.y * ImagePlug::tileSize() + tileIndex.x);
+		}
+		std::fill( result, result + ( begin - x ), value );
+		result += begin - x;
+	}
+
+	// Pixels inside the data window, copied a tile at a time.
+
+	const int end = std::max( begin, std::min( x + width, m_dataWindow.max.x ) );
+	for( int px = begin; px < end; )
+	{
+		cachedData( V2i( px, y ), tileData, tileOrigin, tileIndex );
+		const float *row = tileData + tileIndex.y * ImagePlug::tileSize() + tileIndex.x;
+		const int n = std::min( end - px, ImagePlug::tileSize() - tileIndex.x );
+		result = std::copy( row, row + n, result );
+		px += n;
+	}
+
+	// Pixels to the right of the data window.
+
+	if( result != resultEnd )
+	{
+		float value = 0.0f;
+		if( m_boundingMode == Clamp )
+		{
+			cachedData( V2i( m_dataWindow.max.x - 1, y ), tileData, tileOrigin, tileIndex );
+			value = *(tileData + tileIndex.y * ImagePlug::tileSize() + tileIndex.x);
+		}
+		std::fill( result, resultEnd, value );
+	}
+}
+
+void Sampler::populate()
+{
+	ImageAlgo::parallelFetchTiles( m_plug, m_channelName, m_cacheWindow, m_dataCache );
+}
+
 void Sampler::hash( IECore::MurmurHash &h ) const
 {
 	for ( int x = m_cacheWindow.min.x; x < m_cacheWindow.max.x; x += GafferImage::ImagePlug::tileSize() )
@@ -180,11 +180,11 @@ void Shuffle::hashChannelData( const GafferImage::ImagePlug *parent, const Gaffe
 
 	if( c == "__black" || c == "" )
 	{
-		h = ImagePlug::blackTile()->Object::hash();
+		h = ImagePlug::blackTileHash();
 	}
 	else if( c == "__white" )
 	{
-		h = ImagePlug::whiteTile()->Object::hash();
+		h = ImagePlug::whiteTileHash();
 	}
 	else
 	{
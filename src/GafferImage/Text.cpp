@@ -37,6 +37,8 @@
 #include "ft2build.h"
 #include FT_FREETYPE_H
 
+#include "boost/functional/hash.hpp"
+
 #include "tbb/enumerable_thread_specific.h"
 
 #include "IECore/LRUCache.h"
@@ -44,6 +46,7 @@
 
 #include "Gaffer/StringPlug.h"
 #include "Gaffer/Transform2DPlug.h"
+#include "Gaffer/Private/IECorePreview/LRUCache.h"
 
 #include "GafferImage/Text.h"
 #include "GafferImage/BufferAlgo.h"
@@ -149,6 +152,123 @@ FT_Matrix transform( const M33f &transform, FT_Vector &delta )
 	return matrix;
 }
 
+// Rasterising glyphs is by far the most expensive part of our work,
+// and would otherwise be repeated for every tile a glyph overlaps, and
+// again every time the layout is recomputed (when only a frame number
+// changes, for instance). We therefore keep a cache of rasterised glyph
+// coverage, shared between all threads. Glyphs are keyed by their
+// transform with the whole pixel part of the translation removed,
+// so that identical characters at different positions share a
+// single entry.
+struct GlyphKey
+{
+
+	GlyphKey( const string &font, const V2i &size, char character, const FT_Matrix &matrix, const FT_Vector &delta )
+		:	font( font ), size( size ), character( character ), matrix( matrix ), delta( delta )
+	{
+	}
+
+	bool operator == ( const GlyphKey &other ) const
+	{
+		return
+			character == other.character &&
+			size == other.size &&
+			matrix.xx == other.matrix.xx && matrix.xy == other.matrix.xy &&
+			matrix.yx == other.matrix.yx && matrix.yy == other.matrix.yy &&
+			delta.x == other.delta.x && delta.y == other.delta.y &&
+			font == other.font;
+	}
+
+	string font;
+	V2i size;
+	char character;
+	FT_Matrix matrix;
+	// Fractional part of the translation, in 64ths of a pixel.
+	FT_Vector delta;
+
+};
+
+size_t hash_value( const GlyphKey &key )
+{
+	size_t result = boost::hash<string>()( key.font );
+	boost::hash_combine( result, key.size.x );
+	boost::hash_combine( result, key.size.y );
+	boost::hash_combine( result, key.character );
+	boost::hash_combine( result, key.matrix.xx );
+	boost::hash_combine( result, key.matrix.xy );
+	boost::hash_combine( result, key.matrix.yx );
+	boost::hash_combine( result, key.matrix.yy );
+	boost::hash_combine( result, key.delta.x );
+	boost::hash_combine( result, key.delta.y );
+	return result;
+}
+
+struct Glyph
+{
+	// Bound of the coverage relative to the whole pixel
+	// part of the translation.
+	Box2i bound;
+	// Coverage values, stored top row first, with a pitch
+	// equal to the width of the bound.
+	vector<unsigned char> coverage;
+	V2i advance;
+};
+
+typedef boost::shared_ptr<const Glyph> ConstGlyphPtr;
+
+ConstGlyphPtr glyphGetter( const GlyphKey &key, size_t &cost )
+{
+	// The face is owned by the current thread, so it is safe
+	// for us to modify its transform.
+	FacePtr face = ::face( key.font, key.size );
+	FT_Matrix matrix = key.matrix;
+	FT_Vector delta = key.delta;
+	FT_Set_Transform( face.get(), &matrix, &delta );
+
+	cost = 1;
+	FT_Error e = FT_Load_Char( face.get(), key.character, FT_LOAD_RENDER );
+	if( e )
+	{
+		return ConstGlyphPtr();
+	}
+
+	const FT_GlyphSlot slot = face->glyph;
+	const FT_Bitmap &bitmap = slot->bitmap;
+
+	boost::shared_ptr<Glyph> result( new Glyph );
+	result->bound = Box2i(
+		V2i( slot->bitmap_left, slot->bitmap_top - bitmap.rows ),
+		V2i( slot->bitmap_left + bitmap.width, slot->bitmap_top )
+	);
+	result->advance = V2i( slot->advance.x, slot->advance.y );
+	result->coverage.resize( bitmap.width * bitmap.rows );
+	for( int y = 0; y < (int)bitmap.rows; ++y )
+	{
+		const unsigned char *src = bitmap.buffer + y * bitmap.pitch;
+		std::copy( src, src + bitmap.width, result->coverage.begin() + y * bitmap.width );
+	}
+
+	cost += result->coverage.size();
+	return result;
+}
+
+typedef IECorePreview::LRUCache<GlyphKey, ConstGlyphPtr> GlyphCache;
+GlyphCache g_glyphCache( glyphGetter, 100 * 1024 * 1024 );
+
+// Returns the rasterised glyph for a character with the specified transform,
+// or NULL if the character can't be loaded. `offset` is filled with the
+// whole pixel translation which must be added to the glyph bound.
+ConstGlyphPtr glyph( const string &font, const V2i &size, char character, const M33f &transform, V2i &offset )
+{
+	FT_Vector delta;
+	const FT_Matrix matrix = ::transform( transform, delta );
+
+	const FT_Vector fractionalDelta = { delta.x & 63, delta.y & 63 };
+	offset = V2i( ( delta.x - fractionalDelta.x ) / 64, ( delta.y - fractionalDelta.y ) / 64 );
+
+	return g_glyphCache.get( GlyphKey( font, size, character, matrix, fractionalDelta ) );
+}
+
 int width( const string &word, FT_FaceRec *face )
 {
 	int result = 0;
@@ -459,8 +579,6 @@ IECore::ConstCompoundObjectPtr Text::computeLayout( const Gaffer::Context *conte
 		yOffset = (float)(area.min.y - (pen.y + face->size->metrics.descender) ) / (64.0f * 2.0f);
 	}
 
-	FT_GlyphSlot slot = face->glyph;
-
 	for( vector<Line>::const_iterator lIt = lines.begin(), leIt = lines.end(); lIt != leIt; ++lIt )
 	{
 		float xOffset = 0;
@@ -482,28 +600,19 @@ IECore::ConstCompoundObjectPtr Text::computeLayout( const Gaffer::Context *conte
 
 			for( const char *c = wIt->text.c_str(); *c; ++c )
 			{
-				FT_Vector delta;
-				FT_Matrix matrix = ::transform( characterTransform, delta );
-				FT_Set_Transform( face.get(), &matrix, &delta );
-
-				FT_Error e = FT_Load_Char( face.get(), *c, FT_LOAD_RENDER );
-				if( e )
+				V2i offset;
+				ConstGlyphPtr glyph = ::glyph( font, size, *c, characterTransform, offset );
+				if( !glyph )
 				{
 					continue;
 				}
 
-				const FT_Bitmap &bitmap = slot->bitmap;
-				const Box2i bound(
-					V2i( slot->bitmap_left, slot->bitmap_top - bitmap.rows ),
-					V2i( slot->bitmap_left + bitmap.width, slot->bitmap_top )
-				);
-
 				characters->writable().push_back( *c );
 				transforms->writable().push_back( characterTransform );
-				bounds->writable().push_back( bound );
+				bounds->writable().push_back( Box2i( glyph->bound.min + offset, glyph->bound.max + offset ) );
 
-				characterTransform[2][0] += (float)slot->advance.x / 64.0f;
-				characterTransform[2][1] += (float)slot->advance.y / 64.0f;
+				characterTransform[2][0] += (float)glyph->advance.x / 64.0f;
+				characterTransform[2][1] += (float)glyph->advance.y / 64.0f;
 			}
 		}
 	}
@@ -566,8 +675,8 @@ IECore::ConstFloatVectorDataPtr Text::computeShapeChannelData(  const Imath::V2i
 	const vector<M33f> &transforms = layout->member<M33fVectorData>( "transforms" )->readable();
 	const vector<Box2i> &bounds = layout->member<Box2iVectorData>( "bounds" )->readable();
 
-	FacePtr face = ::face( layout->member<StringData>( "font" )->readable(), layout->member<V2iData>( "size" )->readable() );
-	FT_GlyphSlot slot = face->glyph;
+	const string &font = layout->member<StringData>( "font" )->readable();
+	const V2i &size = layout->member<V2iData>( "size" )->readable();
 
 	FloatVectorDataPtr resultData = new FloatVectorData();
 	vector<float> &result = resultData->writable();
@@ -584,22 +693,21 @@ IECore::ConstFloatVectorDataPtr Text::computeShapeChannelData(  const Imath::V2i
 			continue;
 		}
 
-		FT_Vector delta;
-		FT_Matrix matrix = transform( transforms[i], delta );
-		FT_Set_Transform( face.get(), &matrix, &delta );
-
-		FT_Error error = FT_Load_Char( face.get(), characters[i], FT_LOAD_RENDER );
-		if( error )
+		// The glyph was rasterised when computing the layout,
+		// so this will almost always be a cache hit.
+		V2i offset;
+		ConstGlyphPtr glyph = ::glyph( font, size, characters[i], transforms[i], offset );
+		if( !glyph )
 		{
 			continue;
 		}
 
-		const FT_Bitmap &bitmap = slot->bitmap;
+		const int pitch = bitmapBound.size().x;
 
 		V2i p;
 		for( p.y = validBound.min.y; p.y < validBound.max.y; ++p.y )
 		{
-			const unsigned char *src = bitmap.buffer + ( bitmapBound.max.y - 1 - p.y ) * bitmap.pitch + validBound.min.x - bitmapBound.min.x;
+			const unsigned char *src = &glyph->coverage[0] + ( bitmapBound.max.y - 1 - p.y ) * pitch + validBound.min.x - bitmapBound.min.x;
 			vector<float>::iterator dst = result.begin() + ( p.y - tileBound.min.y ) * ImagePlug::tileSize() + validBound.min.x - tileBound.min.x;
 			for( p.x = validBound.min.x; p.x < validBound.max.x; ++p.x )
 			{
@@ -122,14 +122,22 @@ void Unpremultiply::processChannelData( const Gaffer::Context *context, const Im
 	const std::vector<float> &a = aData->readable();
 	std::vector<float> &out = outData->writable();
 
-	std::vector<float>::const_iterator aIt = a.begin();
-	for ( std::vector<float>::iterator outIt = out.begin(), outItEnd = out.end(); outIt != outItEnd; ++outIt, ++aIt )
+	// Written without branches so that the compiler can vectorise it.
+	const float *aPtr = &a[0];
+	float *outPtr = &out[0];
+	for( int i = 0, e = out.size(); i < e; ++i )
 	{
-		if ( *aIt != 0.0f )
-		{
-			*outIt /= *aIt;
-		}
+		outPtr[i] = aPtr[i] != 0.0f ? outPtr[i] / aPtr[i] : outPtr[i];
 	}
 }
 
+bool Unpremultiply::preservesBlack( const Gaffer::Context *context, const std::string &channel ) const
+{
+	// We return false for a missing alpha channel, so that
+	// processChannelData() can report the error.
+	ConstStringVectorDataPtr inChannelNamesPtr = inPlug()->channelNamesPlug()->getValue();
+	const std::vector<std::string> &inChannelNames = inChannelNamesPtr->readable();
+	return std::find( inChannelNames.begin(), inChannelNames.end(), alphaChannelPlug()->getValue() ) != inChannelNames.end();
+}
+
 } // namespace GafferImage
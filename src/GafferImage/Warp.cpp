@@ -244,6 +244,9 @@ IECore::ConstFloatVectorDataPtr Warp::computeChannelData( const std::string &cha
 		e->inputWindow( tileOrigin ),
 		(Sampler::BoundingMode)boundingModePlug()->getValue()
 	);
+	// Fetch the input tiles in parallel, rather than
+	// one by one as the warped lookups reach them.
+	sampler.populate();
 
 	const Box2i dataWindow = outPlug()->dataWindowPlug()->getValue();
 
@@ -109,6 +109,15 @@ void GafferImageBindings::bindFormatPlug()
 		.staticmethod( "getDefaultFormat" )
 		.def( "acquireDefaultFormatPlug", &FormatPlug::acquireDefaultFormatPlug, return_value_policy<CastToIntrusivePtr>() )
 		.staticmethod( "acquireDefaultFormatPlug" )
+		.def( "setProxyLevel", &FormatPlug::setProxyLevel )
+		.staticmethod( "setProxyLevel" )
+		.def( "getProxyLevel", &FormatPlug::getProxyLevel )
+		.staticmethod( "getProxyLevel" )
+		.def( "proxyFormat", &FormatPlug::proxyFormat )
+		.staticmethod( "proxyFormat" )
+		.def( "proxyWindow", &FormatPlug::proxyWindow )
+		.staticmethod( "proxyWindow" )
+		.setattr( "maxProxyLevel", (int)FormatPlug::maxProxyLevel )
 	;
 
 	Serialisation::registerSerialiser( FormatPlug::staticTypeId(), new FormatPlugSerialiser );
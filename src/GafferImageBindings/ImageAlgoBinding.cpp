@@ -81,6 +81,12 @@ inline bool channelExistsWrapper( const GafferImage::ImagePlug *image, const std
 	return GafferImage::ImageAlgo::channelExists( image, channelName );
 }
 
+IECore::FloatVectorDataPtr channelDataWrapper( const GafferImage::ImagePlug *image, const std::string &channelName, const Imath::Box2i &window )
+{
+	IECorePython::ScopedGILRelease r;
+	return GafferImage::ImageAlgo::channelData( image, channelName, window );
+}
+
 } // namespace
 
 namespace GafferImageBindings
@@ -97,6 +103,7 @@ void bindImageAlgo()
 	def( "colorIndex", &GafferImage::ImageAlgo::colorIndex );
 	def( "channelExists", &channelExistsWrapper );
 	def( "channelExists", ( bool (*)( const std::vector<std::string> &channelNames, const std::string &channelName ) )&GafferImage::ImageAlgo::channelExists );
+	def( "channelData", &channelDataWrapper );
 
 	StringVectorFromStringVectorData();
 
@@ -36,6 +36,8 @@
 
 #include "boost/python.hpp"
 
+#include "IECorePython/ScopedGILRelease.h"
+
 #include "GafferBindings/PlugBinding.h"
 
 #include "GafferImage/ImagePlug.h"
@@ -56,12 +58,24 @@ IECore::FloatVectorDataPtr channelData( const ImagePlug &plug,  const std::strin
 	return copy ? d->copy() : boost::const_pointer_cast<IECore::FloatVectorData>( d );
 }
 
+IECore::MurmurHash channelDataHash( const ImagePlug &plug, const std::string &channelName, const Imath::V2i &tile )
+{
+	IECorePython::ScopedGILRelease gilRelease;
+	return plug.channelDataHash( channelName, tile );
+}
+
 IECore::ImagePrimitivePtr image( const ImagePlug &plug )
 {
 	IECorePython::ScopedGILRelease gilRelease;
 	return plug.image();
 }
 
+IECore::MurmurHash imageHash( const ImagePlug &plug )
+{
+	IECorePython::ScopedGILRelease gilRelease;
+	return plug.imageHash();
+}
+
 } // namespace
 
 void GafferImageBindings::bindImagePlug()
@@ -79,9 +93,9 @@ void GafferImageBindings::bindImagePlug()
 			)
 		)
 		.def( "channelData", &channelData, ( arg( "_copy" ) = true ) )
-		.def( "channelDataHash", &ImagePlug::channelDataHash )
+		.def( "channelDataHash", &channelDataHash )
 		.def( "image", &image )
-		.def( "imageHash", &ImagePlug::imageHash )
+		.def( "imageHash", &imageHash )
 		.def( "tileSize", &ImagePlug::tileSize ).staticmethod( "tileSize" )
 		.def( "tileOrigin", &ImagePlug::tileOrigin ).staticmethod( "tileOrigin" )
 	;
@@ -66,6 +66,10 @@ void GafferImageBindings::bindOpenImageIOReader()
 		.def( "getCacheMemoryLimit", &OpenImageIOReader::getCacheMemoryLimit ).staticmethod( "getCacheMemoryLimit" )
 		.def( "setCacheMemoryLimit", &OpenImageIOReader::setCacheMemoryLimit ).staticmethod( "setCacheMemoryLimit" )
 		.def( "cacheMemoryUsage", &OpenImageIOReader::cacheMemoryUsage ).staticmethod( "cacheMemoryUsage" )
+		.def( "getDirectReadsEnabled", &OpenImageIOReader::getDirectReadsEnabled ).staticmethod( "getDirectReadsEnabled" )
+		.def( "setDirectReadsEnabled", &OpenImageIOReader::setDirectReadsEnabled ).staticmethod( "setDirectReadsEnabled" )
+		.def( "getReadAheadFrames", &OpenImageIOReader::getReadAheadFrames ).staticmethod( "getReadAheadFrames" )
+		.def( "setReadAheadFrames", &OpenImageIOReader::setReadAheadFrames ).staticmethod( "setReadAheadFrames" )
 	;
 
 	boost::python::enum_<OpenImageIOReader::MissingFrameMode>( "MissingFrameMode" )
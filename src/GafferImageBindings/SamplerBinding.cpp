@@ -34,11 +34,46 @@
 
 #include "boost/python.hpp"
 
+#include "IECorePython/ScopedGILRelease.h"
+
 #include "GafferImageBindings/SamplerBinding.h"
 
 using namespace boost::python;
 using namespace GafferImage;
 
+namespace
+{
+
+// Sampling may compute tiles on demand, so we must release the
+// GIL in case the computation needs to enter Python on another
+// thread.
+
+IECore::MurmurHash hash( const Sampler &sampler )
+{
+	IECorePython::ScopedGILRelease gilRelease;
+	return sampler.hash();
+}
+
+void hash2( const Sampler &sampler, IECore::MurmurHash &h )
+{
+	IECorePython::ScopedGILRelease gilRelease;
+	sampler.hash( h );
+}
+
+float sampleFloat( Sampler &sampler, float x, float y )
+{
+	IECorePython::ScopedGILRelease gilRelease;
+	return sampler.sample( x, y );
+}
+
+float sampleInt( Sampler &sampler, int x, int y )
+{
+	IECorePython::ScopedGILRelease gilRelease;
+	return sampler.sample( x, y );
+}
+
+} // namespace
+
 namespace GafferImageBindings
 {
 
@@ -65,10 +100,10 @@ void bindSampler()
 				)
 			)
 		)
-		.def( "hash", (IECore::MurmurHash (Sampler::*)() const)&Sampler::hash )
-		.def( "hash", (void (Sampler::*)( IECore::MurmurHash & ) const)&Sampler::hash )
-		.def( "sample", (float (Sampler::*)( float, float ) )&Sampler::sample )
-		.def( "sample", (float (Sampler::*)( int, int ) )&Sampler::sample )
+		.def( "hash", &hash )
+		.def( "hash", &hash2 )
+		.def( "sample", &sampleFloat )
+		.def( "sample", &sampleInt )
 	;
 }
 
@@ -38,6 +38,12 @@
 #include "boost/algorithm/string/predicate.hpp"
 #include "boost/lexical_cast.hpp"
 
+#include "tbb/parallel_for.h"
+#include "tbb/blocked_range.h"
+#include "tbb/tick_count.h"
+
+#include "Gaffer/Private/IECorePreview/LRUCache.h"
+
 #include "IECoreGL/Selector.h"
 #include "IECoreGL/LuminanceTexture.h"
 #include "IECoreGL/IECoreGL.h"
@@ -53,6 +59,7 @@
 
 #include "GafferImage/ImagePlug.h"
 #include "GafferImage/ImageAlgo.h"
+#include "GafferImage/FormatPlug.h"
 
 #include "GafferImageUI/ImageGadget.h"
 
@@ -66,6 +73,110 @@ using namespace GafferUI;
 using namespace GafferImage;
 using namespace GafferImageUI;
 
+//////////////////////////////////////////////////////////////////////////
+// FrameCache class
+//////////////////////////////////////////////////////////////////////////
+
+class ImageGadget::FrameCache
+{
+
+	public :
+
+		// Everything needed to display a single frame.
+		struct Frame : public IECore::RefCounted
+		{
+			Format format;
+			Box2i dataWindow;
+			vector<string> channelNames;
+			// The tiles are indexed by tileIndex * channelsToCache.size() + channelIndex.
+			vector<V2i> tileOrigins;
+			vector<string> channelsToCache;
+			vector<ConstHalfVectorDataPtr> tiles;
+
+			size_t memoryUsage() const
+			{
+				return sizeof( Frame ) + tiles.size() * ( sizeof( HalfVectorData ) + ImagePlug::tileSize() * ImagePlug::tileSize() * sizeof( half ) );
+			}
+		};
+
+		typedef boost::intrusive_ptr<Frame> FramePtr;
+		typedef boost::intrusive_ptr<const Frame> ConstFramePtr;
+		typedef IECorePreview::LRUCache<float, ConstFramePtr> Cache;
+
+		// Computes and stores tiles for fillFrame.
+		struct FillFunctor
+		{
+
+			FillFunctor( const ImagePlug *image, size_t begin, Frame *frame, const Context *context )
+				:	m_image( image ), m_begin( begin ), m_frame( frame ), m_context( context )
+			{
+			}
+
+			void operator()( const tbb::blocked_range<size_t> &r ) const
+			{
+				Context::EditableScope context( m_context );
+				const size_t numChannels = m_frame->channelsToCache.size();
+				for( size_t i = r.begin(); i != r.end(); ++i )
+				{
+					const size_t index = m_begin + i;
+					const V2i &tileOrigin = m_frame->tileOrigins[index / numChannels];
+					const string &channelName = m_frame->channelsToCache[index % numChannels];
+					context.set( ImagePlug::tileOriginContextName, tileOrigin );
+					context.set( ImagePlug::channelNameContextName, channelName );
+
+					ConstFloatVectorDataPtr channelData = m_image->channelDataPlug()->getValue();
+					const vector<float> &in = channelData->readable();
+					HalfVectorDataPtr halfData = new HalfVectorData;
+					vector<half> &out = halfData->writable();
+					out.resize( in.size() );
+					for( size_t j = 0, e = in.size(); j < e; ++j )
+					{
+						out[j] = in[j];
+					}
+					m_frame->tiles[index] = halfData;
+				}
+			}
+
+			private :
+
+				const ImagePlug *m_image;
+				const size_t m_begin;
+				Frame *m_frame;
+				const Context *m_context;
+
+		};
+
+		FrameCache()
+			:	cache( getter, 0 ), startFrame( 0 ), endFrame( -1 ), fillTileIndex( 0 )
+		{
+		}
+
+		void clear()
+		{
+			cache.clear();
+			fillFrame = NULL;
+			fillContext = NULL;
+		}
+
+		Cache cache;
+		int startFrame;
+		int endFrame;
+
+		// The frame currently being filled in the background.
+		FramePtr fillFrame;
+		ContextPtr fillContext;
+		size_t fillTileIndex;
+
+	private :
+
+		static ConstFramePtr getter( const float &frame, size_t &cost )
+		{
+			// Frames are only ever added with set().
+			throw IECore::Exception( "Frame not cached" );
+		}
+
+};
+
 //////////////////////////////////////////////////////////////////////////
 // ImageGadget implementation
 //////////////////////////////////////////////////////////////////////////
@@ -74,7 +185,9 @@ ImageGadget::ImageGadget()
 	:	Gadget( defaultName<ImageGadget>() ),
 		m_image( NULL ),
 		m_soloChannel( -1 ),
-		m_dirtyFlags( AllDirty )
+		m_proxyLevel( 0 ),
+		m_dirtyFlags( AllDirty ),
+		m_frameCache( new FrameCache )
 {
 	/// \todo Expose accessors to allow the user
 	/// to choose which channels are displayed.
@@ -110,6 +223,7 @@ void ImageGadget::setImage( GafferImage::ConstImagePlugPtr image )
 		m_plugDirtiedConnection.disconnect();
 	}
 
+	clearFrameCache();
 	m_dirtyFlags = AllDirty;
 	requestRender();
 }
@@ -129,6 +243,7 @@ void ImageGadget::setContext( Gaffer::ContextPtr context )
 	m_context = context;
 	m_contextChangedConnection = m_context->changedSignal().connect( boost::bind( &ImageGadget::contextChanged, this, ::_2 ) );
 
+	clearFrameCache();
 	m_dirtyFlags = AllDirty;
 	requestRender();
 }
@@ -171,6 +286,33 @@ int ImageGadget::getSoloChannel() const
 	return m_soloChannel;
 }
 
+void ImageGadget::setProxyLevel( int proxyLevel )
+{
+	proxyLevel = std::max( 0, std::min( proxyLevel, (int)FormatPlug::maxProxyLevel ) );
+	if( proxyLevel == m_proxyLevel )
+	{
+		return;
+	}
+
+	m_proxyLevel = proxyLevel;
+	// Tiles are indexed in proxy space, so none
+	// of the existing ones are any use to us now.
+	m_tiles.clear();
+	clearFrameCache();
+	m_dirtyFlags = AllDirty;
+	requestRender();
+}
+
+int ImageGadget::getProxyLevel() const
+{
+	return m_proxyLevel;
+}
+
+float ImageGadget::proxyScale() const
+{
+	return (float)( 1 << m_proxyLevel );
+}
+
 Imath::V2f ImageGadget::pixelAt( const IECore::LineSegment3f &lineInGadgetSpace ) const
 {
 	V3f i;
@@ -179,6 +321,8 @@ Imath::V2f ImageGadget::pixelAt( const IECore::LineSegment3f &lineInGadgetSpace
 		return V2f( 0 );
 	}
 
+	// Gadget space is always in full resolution pixels,
+	// regardless of the proxy level.
 	return V2f( i.x / format().getPixelAspect(), i.y );
 }
 
@@ -200,10 +344,11 @@ Imath::Box3f ImageGadget::bound() const
 		return Box3f();
 	}
 
-	const float a = f.getPixelAspect();
+	const float a = f.getPixelAspect() * proxyScale();
+	const float s = proxyScale();
 	return Box3f(
-		V3f( (float)w.min.x * a, (float)w.min.y, 0 ),
-		V3f( (float)w.max.x * a, (float)w.max.y, 0 )
+		V3f( (float)w.min.x * a, (float)w.min.y * s, 0 ),
+		V3f( (float)w.max.x * a, (float)w.max.y * s, 0 )
 	);
 }
 
@@ -225,7 +370,12 @@ void ImageGadget::plugDirtied( const Gaffer::Plug *plug )
 	{
 		m_dirtyFlags |= TilesDirty;
 	}
+	else
+	{
+		return;
+	}
 
+	clearFrameCache();
 	if( m_dirtyFlags )
 	{
 		requestRender();
@@ -236,6 +386,13 @@ void ImageGadget::contextChanged( const IECore::InternedString &name )
 {
 	if( !boost::starts_with( name.string(), "ui:" ) )
 	{
+		// Cached frames remain valid when only the frame changes.
+		// In that case, restoreCachedFrame() will take care of
+		// everything in doRender().
+		if( name != "frame" )
+		{
+			clearFrameCache();
+		}
 		m_dirtyFlags = AllDirty;
 		requestRender();
 	}
@@ -245,6 +402,22 @@ void ImageGadget::contextChanged( const IECore::InternedString &name )
 // Image property access.
 //////////////////////////////////////////////////////////////////////////
 
+class ImageGadget::ProxyScope : public Context::EditableScope
+{
+
+	public :
+
+		ProxyScope( const Context *context, int proxyLevel )
+			:	EditableScope( context )
+		{
+			if( proxyLevel )
+			{
+				set( FormatPlug::proxyLevelContextName, proxyLevel );
+			}
+		}
+
+};
+
 const GafferImage::Format &ImageGadget::format() const
 {
 	if( m_dirtyFlags & FormatDirty )
@@ -255,7 +428,7 @@ const GafferImage::Format &ImageGadget::format() const
 		}
 		else
 		{
-			Context::Scope scopedContext( m_context.get() );
+			ProxyScope scopedContext( m_context.get(), m_proxyLevel );
 			m_format = m_image->formatPlug()->getValue();
 		}
 		m_dirtyFlags &= ~FormatDirty;
@@ -274,7 +447,7 @@ const Imath::Box2i &ImageGadget::dataWindow() const
 		}
 		else
 		{
-			Context::Scope scopedContext( m_context.get() );
+			ProxyScope scopedContext( m_context.get(), m_proxyLevel );
 			m_dataWindow = m_image->dataWindowPlug()->getValue();
 		}
 		m_dirtyFlags &= ~DataWindowDirty;
@@ -293,7 +466,7 @@ const std::vector<std::string> &ImageGadget::channelNames() const
 		}
 		else
 		{
-			Context::Scope scopedContext( m_context.get() );
+			ProxyScope scopedContext( m_context.get(), m_proxyLevel );
 			m_channelNames = m_image->channelNamesPlug()->getValue()->readable();
 		}
 		m_dirtyFlags &= ~ChannelNamesDirty;
@@ -314,91 +487,182 @@ inline size_t GafferImageUI::tbb_hasher( const ImageGadget::TileIndex &tileIndex
 		tbb::tbb_hasher( tileIndex.channelName.c_str() );
 }
 
+namespace
+{
+
+// The maximum time we spend computing tiles before
+// returning control to the UI and continuing later.
+const double g_tileUpdateTimeBudget = 0.05;
+// The number of tiles computed in parallel between
+// checks against the time budget.
+const size_t g_tileUpdateBatchSize = 32;
+
+struct DistanceLess
+{
+
+	DistanceLess( const V2f &centre )
+		:	m_centre( centre )
+	{
+	}
+
+	bool operator()( const V2i &a, const V2i &b ) const
+	{
+		return distance2( a ) < distance2( b );
+	}
+
+	private :
+
+		float distance2( const V2i &tileOrigin ) const
+		{
+			const V2f tileCentre = V2f( tileOrigin ) + V2f( ImagePlug::tileSize() / 2 );
+			return ( tileCentre - m_centre ).length2();
+		}
+
+		V2f m_centre;
+
+};
+
+} // namespace
+
 // Tests to see if a tile needs updating, and if it does, computes
 // the channel data to go into it.
 struct ImageGadget::TileFunctor
 {
 
-	TileFunctor( Tiles &tiles )
-		:	m_tiles( tiles )
+	TileFunctor( const ImagePlug *image, const vector<V2i> &tileOrigins, const vector<string> &channelNames, Tiles &tiles, const Context *context )
+		:	m_image( image ), m_tileOrigins( tileOrigins ), m_channelNames( channelNames ), m_tiles( tiles ), m_context( context )
 	{
 	}
 
-	void operator()( const ImagePlug *image, const string &channelName, const V2i &tileOrigin )
+	void operator()( const tbb::blocked_range<size_t> &r ) const
 	{
-		Tile &tile = m_tiles[TileIndex(tileOrigin, channelName)];
-		ConstFloatVectorDataPtr channelData;
-		const IECore::MurmurHash h = image->channelDataPlug()->hash();
-		if( !tile.texture || tile.channelDataHash != h )
+		Context::EditableScope context( m_context );
+		for( size_t i = r.begin(); i != r.end(); ++i )
 		{
-			tile.channelDataToConvert = image->channelDataPlug()->getValue( &h );
-			tile.channelDataHash = h;
+			const V2i &tileOrigin = m_tileOrigins[i];
+			context.set( ImagePlug::tileOriginContextName, tileOrigin );
+			for( vector<string>::const_iterator it = m_channelNames.begin(), eIt = m_channelNames.end(); it != eIt; ++it )
+			{
+				context.set( ImagePlug::channelNameContextName, *it );
+				Tile &tile = m_tiles[TileIndex(tileOrigin, *it)];
+				const IECore::MurmurHash h = m_image->channelDataPlug()->hash();
+				if( !tile.texture || tile.channelDataHash != h )
+				{
+					tile.channelDataToConvert = m_image->channelDataPlug()->getValue( &h );
+					tile.channelDataHash = h;
+				}
+			}
 		}
 	}
 
 	private :
 
+		const ImagePlug *m_image;
+		const vector<V2i> &m_tileOrigins;
+		const vector<string> &m_channelNames;
 		Tiles &m_tiles;
+		const Context *m_context;
 
 };
 
 void ImageGadget::updateTiles() const
 {
-	if( !(m_dirtyFlags & TilesDirty) )
+	if( m_dirtyFlags & TilesDirty )
 	{
-		return;
-	}
-
-	removeOutOfBoundsTiles();
+		removeOutOfBoundsTiles();
+
+		// Decide which channels to compute. This is the intersection
+		// of the available channels (channelNames) and the channels
+		// we want to display (m_rgbaChannels).
+		const vector<string> &channelNames = this->channelNames();
+		m_channelsToUpdate.clear();
+		for( vector<string>::const_iterator it = channelNames.begin(), eIt = channelNames.end(); it != eIt; ++it )
+		{
+			if( find( m_rgbaChannels.begin(), m_rgbaChannels.end(), *it ) != m_rgbaChannels.end() )
+			{
+				if( m_soloChannel == -1 || m_rgbaChannels[m_soloChannel] == *it )
+				{
+					m_channelsToUpdate.push_back( *it );
+				}
+			}
+		}
 
-	// Decide which channels to compute. This is the intersection
-	// of the available channels (channelNames) and the channels
-	// we want to display (m_rgbaChannels).
-	const vector<string> &channelNames = this->channelNames();
-	vector<string> channelsToCompute;
-	for( vector<string>::const_iterator it = channelNames.begin(), eIt = channelNames.end(); it != eIt; ++it )
-	{
-		if( find( m_rgbaChannels.begin(), m_rgbaChannels.end(), *it ) != m_rgbaChannels.end() )
+		// Queue up every tile in the data window. Any update
+		// still in progress is superseded by this one.
+		m_tilesToUpdate.clear();
+		const Box2i &dataWindow = this->dataWindow();
+		if( !BufferAlgo::empty( dataWindow ) )
 		{
-			if( m_soloChannel == -1 || m_rgbaChannels[m_soloChannel] == *it )
+			V2i tileOrigin = ImagePlug::tileOrigin( dataWindow.min );
+			for( ; tileOrigin.y < dataWindow.max.y; tileOrigin.y += ImagePlug::tileSize() )
 			{
-				channelsToCompute.push_back( *it );
+				for( tileOrigin.x = ImagePlug::tileOrigin( dataWindow.min ).x; tileOrigin.x < dataWindow.max.x; tileOrigin.x += ImagePlug::tileSize() )
+				{
+					m_tilesToUpdate.push_back( tileOrigin );
+				}
 			}
 		}
+
+		m_dirtyFlags &= ~TilesDirty;
 	}
 
-	// Use parallelGatherTiles() to do the hard work of launching
-	// threads and iterating over tiles to get any modified channelData.
-	TileFunctor tileFunctor( m_tiles );
+	if( m_tilesToUpdate.empty() )
 	{
-		Context::Scope scopedContext( m_context.get() );
-		ImageAlgo::parallelProcessTiles( m_image.get(), channelsToCompute, tileFunctor, dataWindow() );
+		return;
 	}
 
-	// Now take the new channelData and convert it into textures for display.
-	// We must do this on the main thread because it involves OpenGL.
-	for( Tiles::iterator it = m_tiles.begin(); it != m_tiles.end(); ++it )
+	// Prioritise the tiles nearest the centre of the viewport. We do
+	// this on every pass, so that when the user pans during a long
+	// update, the tiles they're looking at are computed next. We keep
+	// the queue sorted in reverse, so that completed tiles can be
+	// popped cheaply from the back.
+	std::sort( m_tilesToUpdate.rbegin(), m_tilesToUpdate.rend(), DistanceLess( viewportCentre() ) );
+
+	// Compute tiles in parallel batches until we run out of time.
+	const tbb::tick_count startTime = tbb::tick_count::now();
+	ProxyScope scopedContext( m_context.get(), m_proxyLevel );
+	do
 	{
-		if( it->second.channelDataToConvert )
-		{
-			GLuint texture;
-			glGenTextures( 1, &texture );
-			it->second.texture = new Texture( texture );
-			Texture::ScopedBinding binding( *it->second.texture );
-
-			glPixelStorei( GL_UNPACK_ALIGNMENT, 1 );
-			glTexImage2D( GL_TEXTURE_2D, 0, GL_LUMINANCE, ImagePlug::tileSize(), ImagePlug::tileSize(), 0, GL_LUMINANCE,
-				GL_FLOAT, &it->second.channelDataToConvert->readable().front() );
+		const size_t batchSize = std::min( g_tileUpdateBatchSize, m_tilesToUpdate.size() );
+		const vector<V2i> batch( m_tilesToUpdate.end() - batchSize, m_tilesToUpdate.end() );
+		TileFunctor tileFunctor( m_image.get(), batch, m_channelsToUpdate, m_tiles, Context::current() );
+		tbb::parallel_for( tbb::blocked_range<size_t>( 0, batch.size() ), tileFunctor );
+		m_tilesToUpdate.resize( m_tilesToUpdate.size() - batchSize );
+	} while( !m_tilesToUpdate.empty() && ( tbb::tick_count::now() - startTime ).seconds() < g_tileUpdateTimeBudget );
 
-			glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST );
-			glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST );
-			glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE );
-			glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE );
+	uploadTextures();
 
-			it->second.channelDataToConvert = NULL;
+	if( !m_tilesToUpdate.empty() )
+	{
+		// Continue when the UI is next idle, giving it a chance to
+		// respond to events before we carry on.
+		if( !m_updateTilesIdleConnection.connected() )
+		{
+			m_updateTilesIdleConnection = idleSignal().connect( boost::bind( &ImageGadget::updateTilesIdle, const_cast<ImageGadget *>( this ) ) );
 		}
 	}
-	m_dirtyFlags &= ~TilesDirty;
+	else
+	{
+		m_updateTilesIdleConnection.disconnect();
+	}
+}
+
+void ImageGadget::updateTilesIdle()
+{
+	m_updateTilesIdleConnection.disconnect();
+	requestRender();
+}
+
+Imath::V2f ImageGadget::viewportCentre() const
+{
+	if( const ViewportGadget *viewport = ancestor<ViewportGadget>() )
+	{
+		const V2f rasterCentre = V2f( viewport->getViewport() ) / 2.0f;
+		return pixelAt( viewport->rasterToGadgetSpace( rasterCentre, this ) ) / proxyScale();
+	}
+
+	const Box2i &dataWindow = this->dataWindow();
+	return V2f( dataWindow.min + dataWindow.max ) / 2.0f;
 }
 
 void ImageGadget::removeOutOfBoundsTiles() const
@@ -426,6 +690,320 @@ void ImageGadget::removeOutOfBoundsTiles() const
 	}
 }
 
+void ImageGadget::uploadTextures() const
+{
+	// Take the new channelData and convert it into textures for display.
+	// We must do this on the main thread because it involves OpenGL. We
+	// stage all the data through a single pixel buffer object, which lets
+	// the driver transfer it to the GPU without stalling on each tile.
+
+	vector<Tile *> tilesToUpload;
+	size_t totalBytes = 0;
+	for( Tiles::iterator it = m_tiles.begin(); it != m_tiles.end(); ++it )
+	{
+		if( it->second.channelDataToConvert )
+		{
+			tilesToUpload.push_back( &it->second );
+			totalBytes += it->second.channelDataToConvert->readable().size() * sizeof( float );
+		}
+		else if( it->second.halfChannelDataToConvert )
+		{
+			tilesToUpload.push_back( &it->second );
+			totalBytes += it->second.halfChannelDataToConvert->readable().size() * sizeof( half );
+		}
+	}
+
+	if( tilesToUpload.empty() )
+	{
+		return;
+	}
+
+	GLuint pixelBuffer = 0;
+	char *mappedBuffer = NULL;
+	if( GLEW_VERSION_2_1 || GLEW_ARB_pixel_buffer_object )
+	{
+		glGenBuffers( 1, &pixelBuffer );
+		glBindBuffer( GL_PIXEL_UNPACK_BUFFER, pixelBuffer );
+		glBufferData( GL_PIXEL_UNPACK_BUFFER, totalBytes, NULL, GL_STREAM_DRAW );
+		mappedBuffer = static_cast<char *>( glMapBuffer( GL_PIXEL_UNPACK_BUFFER, GL_WRITE_ONLY ) );
+		if( mappedBuffer )
+		{
+			char *p = mappedBuffer;
+			for( vector<Tile *>::const_iterator it = tilesToUpload.begin(), eIt = tilesToUpload.end(); it != eIt; ++it )
+			{
+				if( (*it)->channelDataToConvert )
+				{
+					const vector<float> &data = (*it)->channelDataToConvert->readable();
+					memcpy( p, &data.front(), data.size() * sizeof( float ) );
+					p += data.size() * sizeof( float );
+				}
+				else
+				{
+					const vector<half> &data = (*it)->halfChannelDataToConvert->readable();
+					memcpy( p, &data.front(), data.size() * sizeof( half ) );
+					p += data.size() * sizeof( half );
+				}
+			}
+			glUnmapBuffer( GL_PIXEL_UNPACK_BUFFER );
+		}
+		else
+		{
+			// Fall back to uploading directly from the channel data.
+			glBindBuffer( GL_PIXEL_UNPACK_BUFFER, 0 );
+		}
+	}
+
+	glPixelStorei( GL_UNPACK_ALIGNMENT, 1 );
+	size_t offset = 0;
+	for( vector<Tile *>::const_iterator it = tilesToUpload.begin(), eIt = tilesToUpload.end(); it != eIt; ++it )
+	{
+		Tile &tile = **it;
+
+		GLuint texture;
+		glGenTextures( 1, &texture );
+		tile.texture = new Texture( texture );
+		Texture::ScopedBinding binding( *tile.texture );
+
+		GLenum type;
+		const void *pixels;
+		size_t bytes;
+		if( tile.channelDataToConvert )
+		{
+			type = GL_FLOAT;
+			pixels = &tile.channelDataToConvert->readable().front();
+			bytes = tile.channelDataToConvert->readable().size() * sizeof( float );
+		}
+		else
+		{
+			type = GL_HALF_FLOAT;
+			pixels = &tile.halfChannelDataToConvert->readable().front();
+			bytes = tile.halfChannelDataToConvert->readable().size() * sizeof( half );
+		}
+
+		if( mappedBuffer )
+		{
+			pixels = reinterpret_cast<const void *>( offset );
+		}
+		offset += bytes;
+
+		glTexImage2D( GL_TEXTURE_2D, 0, GL_LUMINANCE, ImagePlug::tileSize(), ImagePlug::tileSize(), 0, GL_LUMINANCE,
+			type, pixels );
+
+		glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST );
+		glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST );
+		glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE );
+		glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE );
+
+		tile.channelDataToConvert = NULL;
+		tile.halfChannelDataToConvert = NULL;
+	}
+
+	if( pixelBuffer )
+	{
+		glBindBuffer( GL_PIXEL_UNPACK_BUFFER, 0 );
+		glDeleteBuffers( 1, &pixelBuffer );
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Frame cache
+//////////////////////////////////////////////////////////////////////////
+
+void ImageGadget::setFrameCacheMemoryLimit( size_t bytes )
+{
+	m_frameCache->cache.setMaxCost( bytes );
+	if( !bytes )
+	{
+		clearFrameCache();
+	}
+	else
+	{
+		requestRender();
+	}
+}
+
+size_t ImageGadget::getFrameCacheMemoryLimit() const
+{
+	return m_frameCache->cache.getMaxCost();
+}
+
+size_t ImageGadget::frameCacheMemoryUsage() const
+{
+	return m_frameCache->cache.currentCost();
+}
+
+void ImageGadget::setFrameCacheRange( int startFrame, int endFrame )
+{
+	if( startFrame == m_frameCache->startFrame && endFrame == m_frameCache->endFrame )
+	{
+		return;
+	}
+
+	m_frameCache->startFrame = startFrame;
+	m_frameCache->endFrame = endFrame;
+	requestRender();
+}
+
+void ImageGadget::clearFrameCache() const
+{
+	m_frameCache->clear();
+}
+
+bool ImageGadget::restoreCachedFrame() const
+{
+	if( !m_frameCache->cache.getMaxCost() )
+	{
+		return false;
+	}
+
+	boost::optional<FrameCache::ConstFramePtr> cachedFrame = m_frameCache->cache.getIfCached( m_context->getFrame() );
+	if( !cachedFrame )
+	{
+		return false;
+	}
+
+	const FrameCache::Frame *frame = cachedFrame->get();
+	m_format = frame->format;
+	m_dataWindow = frame->dataWindow;
+	m_channelNames = frame->channelNames;
+	m_dirtyFlags = NothingDirty;
+	m_tilesToUpdate.clear();
+
+	removeOutOfBoundsTiles();
+
+	const size_t numChannels = frame->channelsToCache.size();
+	for( size_t i = 0; i < frame->tiles.size(); ++i )
+	{
+		Tile &tile = m_tiles[TileIndex( frame->tileOrigins[i / numChannels], frame->channelsToCache[i % numChannels] )];
+		tile.halfChannelDataToConvert = frame->tiles[i];
+		tile.channelDataToConvert = NULL;
+		// We don't know the hash, so make sure that
+		// the tile is recomputed on the next regular
+		// update.
+		tile.channelDataHash = IECore::MurmurHash();
+	}
+
+	uploadTextures();
+	return true;
+}
+
+void ImageGadget::frameCacheIdle()
+{
+	FrameCache &frameCache = *m_frameCache;
+	const size_t maxCost = frameCache.cache.getMaxCost();
+	if( !maxCost || !m_image || frameCache.endFrame < frameCache.startFrame )
+	{
+		m_frameCacheIdleConnection.disconnect();
+		return;
+	}
+
+	if( !m_tilesToUpdate.empty() )
+	{
+		// Updating the frame being viewed takes priority.
+		return;
+	}
+
+	try
+	{
+		if( !frameCache.fillFrame )
+		{
+			// Find the next uncached frame, starting from the
+			// current frame and wrapping around the range.
+			const int numFrames = frameCache.endFrame - frameCache.startFrame + 1;
+			const int currentFrame = std::max( frameCache.startFrame, std::min( (int)m_context->getFrame(), frameCache.endFrame ) );
+			int frameToFill = frameCache.startFrame - 1;
+			for( int i = 0; i < numFrames; ++i )
+			{
+				const int f = frameCache.startFrame + ( currentFrame - frameCache.startFrame + i ) % numFrames;
+				if( !frameCache.cache.cached( f ) )
+				{
+					frameToFill = f;
+					break;
+				}
+			}
+
+			if( frameToFill < frameCache.startFrame )
+			{
+				// Everything is cached.
+				m_frameCacheIdleConnection.disconnect();
+				return;
+			}
+
+			FrameCache::FramePtr frame = new FrameCache::Frame;
+			ContextPtr fillContext = new Context( *m_context, Context::Borrowed );
+			fillContext->setFrame( frameToFill );
+			{
+				ProxyScope scopedContext( fillContext.get(), m_proxyLevel );
+				frame->format = m_image->formatPlug()->getValue();
+				frame->dataWindow = m_image->dataWindowPlug()->getValue();
+				frame->channelNames = m_image->channelNamesPlug()->getValue()->readable();
+			}
+
+			for( vector<string>::const_iterator it = frame->channelNames.begin(), eIt = frame->channelNames.end(); it != eIt; ++it )
+			{
+				if( find( m_rgbaChannels.begin(), m_rgbaChannels.end(), *it ) != m_rgbaChannels.end() )
+				{
+					frame->channelsToCache.push_back( *it );
+				}
+			}
+
+			if( !BufferAlgo::empty( frame->dataWindow ) )
+			{
+				const Box2i &dataWindow = frame->dataWindow;
+				V2i tileOrigin = ImagePlug::tileOrigin( dataWindow.min );
+				for( ; tileOrigin.y < dataWindow.max.y; tileOrigin.y += ImagePlug::tileSize() )
+				{
+					for( tileOrigin.x = ImagePlug::tileOrigin( dataWindow.min ).x; tileOrigin.x < dataWindow.max.x; tileOrigin.x += ImagePlug::tileSize() )
+					{
+						frame->tileOrigins.push_back( tileOrigin );
+					}
+				}
+			}
+			frame->tiles.resize( frame->tileOrigins.size() * frame->channelsToCache.size() );
+
+			if( frameCache.cache.currentCost() + frame->memoryUsage() > maxCost )
+			{
+				// Don't evict frames we've already cached (and would
+				// then want to cache again) just to fill another one.
+				m_frameCacheIdleConnection.disconnect();
+				return;
+			}
+
+			frameCache.fillFrame = frame;
+			frameCache.fillContext = fillContext;
+			frameCache.fillTileIndex = 0;
+		}
+
+		// Compute tiles in parallel batches until we run out of time.
+		FrameCache::Frame *frame = frameCache.fillFrame.get();
+		const tbb::tick_count startTime = tbb::tick_count::now();
+		ProxyScope scopedContext( frameCache.fillContext.get(), m_proxyLevel );
+		while( frameCache.fillTileIndex < frame->tiles.size() && ( tbb::tick_count::now() - startTime ).seconds() < g_tileUpdateTimeBudget )
+		{
+			const size_t batchSize = std::min( g_tileUpdateBatchSize * frame->channelsToCache.size(), frame->tiles.size() - frameCache.fillTileIndex );
+			FrameCache::FillFunctor functor( m_image.get(), frameCache.fillTileIndex, frame, Context::current() );
+			tbb::parallel_for( tbb::blocked_range<size_t>( 0, batchSize ), functor );
+			frameCache.fillTileIndex += batchSize;
+		}
+
+		if( frameCache.fillTileIndex >= frame->tiles.size() )
+		{
+			frameCache.cache.set( frameCache.fillContext->getFrame(), frameCache.fillFrame, frame->memoryUsage() );
+			frameCache.fillFrame = NULL;
+			frameCache.fillContext = NULL;
+		}
+	}
+	catch( ... )
+	{
+		// Computation errors will be reported when
+		// the frame is viewed. Stop filling until
+		// something changes.
+		frameCache.fillFrame = NULL;
+		frameCache.fillContext = NULL;
+		m_frameCacheIdleConnection.disconnect();
+	}
+}
+
 //////////////////////////////////////////////////////////////////////////
 // Rendering
 //////////////////////////////////////////////////////////////////////////
@@ -546,6 +1124,7 @@ void ImageGadget::renderTiles() const
 
 	const Box2i dataWindow = this->dataWindow();
 	const float pixelAspect = this->format().getPixelAspect();
+	const float scale = proxyScale();
 
 	V2i tileOrigin = ImagePlug::tileOrigin( dataWindow.min );
 	for( ; tileOrigin.y < dataWindow.max.y; tileOrigin.y += ImagePlug::tileSize() )
@@ -583,16 +1162,16 @@ void ImageGadget::renderTiles() const
 			glBegin( GL_QUADS );
 
 				glTexCoord2f( uvBound.min.x, uvBound.min.y  );
-				glVertex2f( validBound.min.x * pixelAspect, validBound.min.y );
+				glVertex2f( validBound.min.x * pixelAspect * scale, validBound.min.y * scale );
 
 				glTexCoord2f( uvBound.min.x, uvBound.max.y  );
-				glVertex2f( validBound.min.x * pixelAspect, validBound.max.y );
+				glVertex2f( validBound.min.x * pixelAspect * scale, validBound.max.y * scale );
 
 				glTexCoord2f( uvBound.max.x, uvBound.max.y  );
-				glVertex2f( validBound.max.x * pixelAspect, validBound.max.y );
+				glVertex2f( validBound.max.x * pixelAspect * scale, validBound.max.y * scale );
 
 				glTexCoord2f( uvBound.max.x, uvBound.min.y  );
-				glVertex2f( validBound.max.x * pixelAspect, validBound.min.y );
+				glVertex2f( validBound.max.x * pixelAspect * scale, validBound.min.y * scale );
 
 			glEnd();
 
@@ -633,15 +1212,23 @@ void ImageGadget::doRender( const GafferUI::Style *style ) const
 	Box2i dataWindow;
 	try
 	{
+		if( m_dirtyFlags != AllDirty || !restoreCachedFrame() )
+		{
+			updateTiles();
+		}
 		format = this->format();
 		dataWindow = this->dataWindow();
-		updateTiles();
 	}
 	catch( ... )
 	{
 		return;
 	}
 
+	if( m_frameCache->cache.getMaxCost() && !m_frameCacheIdleConnection.connected() )
+	{
+		m_frameCacheIdleConnection = idleSignal().connect( boost::bind( &ImageGadget::frameCacheIdle, const_cast<ImageGadget *>( this ) ) );
+	}
+
 	// Early out if the image has no size.
 
 	const Box2i &displayWindow = format.getDisplayWindow();
@@ -653,16 +1240,18 @@ void ImageGadget::doRender( const GafferUI::Style *style ) const
 	// Render a black background the size of the image.
 	// We need to account for the pixel aspect ratio here
 	// and in all our drawing. Variables ending in F denote
-	// windows corrected for pixel aspect.
+	// windows corrected for pixel aspect and scaled up
+	// from the proxy level.
 
+	const V2f windowScale = V2f( format.getPixelAspect(), 1.0f ) * proxyScale();
 	const Box2f displayWindowF(
-		V2f( displayWindow.min ) * V2f( format.getPixelAspect(), 1.0f ),
-		V2f( displayWindow.max ) * V2f( format.getPixelAspect(), 1.0f )
+		V2f( displayWindow.min ) * windowScale,
+		V2f( displayWindow.max ) * windowScale
 	);
 
 	const Box2f dataWindowF(
-		V2f( dataWindow.min ) * V2f( format.getPixelAspect(), 1.0f ),
-		V2f( dataWindow.max ) * V2f( format.getPixelAspect(), 1.0f )
+		V2f( dataWindow.min ) * windowScale,
+		V2f( dataWindow.max ) * windowScale
 	);
 
 	glColor3f( 0.0f, 0.0f, 0.0f );
@@ -692,6 +1281,13 @@ void ImageGadget::doRender( const GafferUI::Style *style ) const
 		formatText += " ( " + dimensionsText + " )";
 	}
 
+	if( m_proxyLevel )
+	{
+		formatText += " [ proxy 1/" + lexical_cast<string>( 1 << m_proxyLevel ) + " ]";
+	}
+
+	Style::TextBatchScope textBatchScope( style );
+
 	renderText( formatText, V2f( displayWindowF.center().x, displayWindowF.min.y ), V2f( 0.5, 1.5 ), style );
 
 	if( displayWindow.min != V2i( 0 ) )
@@ -0,0 +1,498 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2017, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//      * Redistributions of source code must retain the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer.
+//
+//      * Redistributions in binary form must reproduce the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer in the documentation and/or other materials provided with
+//        the distribution.
+//
+//      * Neither the name of John Haddon nor the names of
+//        any other contributors to this software may be used to endorse or
+//        promote products derived from this software without specific prior
+//        written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+
+#include "OpenEXR/ImathLimits.h"
+
+#include "Gaffer/Context.h"
+
+#include "GafferImage/ImagePlug.h"
+#include "GafferImage/ImageAlgo.h"
+#include "GafferImage/BufferAlgo.h"
+
+#include "GafferImageUI/ImageScopes.h"
+
+using namespace std;
+using namespace Imath;
+using namespace IECore;
+using namespace Gaffer;
+using namespace GafferImage;
+using namespace GafferImageUI;
+
+//////////////////////////////////////////////////////////////////////////
+// Internal utilities
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+const float g_lumaWeights[3] = { 0.2126f, 0.7152f, 0.0722f };
+
+inline unsigned bin( float v, float min, float max, size_t numBins )
+{
+	const int i = (int)floorf( ( v - min ) / ( max - min ) * numBins );
+	return (unsigned)std::max( 0, std::min( i, (int)numBins - 1 ) );
+}
+
+// Sparse storage for the counts contributed by a single tile.
+// Each pair holds a bin index and the number of pixels in it.
+typedef std::vector<std::pair<unsigned, unsigned> > SparseCounts;
+
+// Sorts `indices` and converts them into `counts`. This is much
+// more compact than storing dense arrays for every tile, because
+// the pixels of a tile tend to fall into a small number of bins.
+void compress( std::vector<unsigned> &indices, SparseCounts &counts )
+{
+	std::sort( indices.begin(), indices.end() );
+	counts.clear();
+	for( std::vector<unsigned>::const_iterator it = indices.begin(), eIt = indices.end(); it != eIt; ++it )
+	{
+		if( counts.empty() || counts.back().first != *it )
+		{
+			counts.push_back( std::pair<unsigned, unsigned>( *it, 0 ) );
+		}
+		counts.back().second++;
+	}
+}
+
+void accumulateCounts( const SparseCounts &counts, std::vector<unsigned> &totals, bool add )
+{
+	for( SparseCounts::const_iterator it = counts.begin(), eIt = counts.end(); it != eIt; ++it )
+	{
+		if( add )
+		{
+			totals[it->first] += it->second;
+		}
+		else
+		{
+			totals[it->first] -= it->second;
+		}
+	}
+}
+
+const char *g_channelNames[4] = { "R", "G", "B", "A" };
+
+} // namespace
+
+//////////////////////////////////////////////////////////////////////////
+// Tile
+//////////////////////////////////////////////////////////////////////////
+
+struct ImageScopes::Tile
+{
+
+	IECore::MurmurHash hash;
+
+	SparseCounts histogram;
+	SparseCounts waveform;
+	SparseCounts vectorscope;
+
+	Color4f minimum;
+	Color4f maximum;
+	double sum[4];
+	size_t numPixels;
+
+};
+
+//////////////////////////////////////////////////////////////////////////
+// TileFunctor
+//////////////////////////////////////////////////////////////////////////
+
+struct ImageScopes::TileFunctor
+{
+
+	TileFunctor( const Box2i &dataWindow, const std::vector<std::string> &channelNames, const std::vector<ConstTilePtr> &previousTiles, std::vector<ConstTilePtr> &updatedTiles )
+		:	m_dataWindow( dataWindow ), m_previousTiles( previousTiles ), m_updatedTiles( updatedTiles )
+	{
+		for( int c = 0; c < 4; ++c )
+		{
+			m_channelExists[c] = ImageAlgo::channelExists( channelNames, g_channelNames[c] );
+		}
+		m_tilesOrigin = ImagePlug::tileOrigin( dataWindow.min );
+		m_numTilesX = ( ImagePlug::tileOrigin( dataWindow.max - V2i( 1 ) ).x - m_tilesOrigin.x ) / ImagePlug::tileSize() + 1;
+	}
+
+	void operator()( const ImagePlug *image, const V2i &tileOrigin )
+	{
+		const V2i tileId = ( tileOrigin - m_tilesOrigin ) / ImagePlug::tileSize();
+		const size_t tileIndex = tileId.y * m_numTilesX + tileId.x;
+
+		// Hash the tile, and early out if it hasn't changed.
+
+		Context::EditableScope context( Context::current() );
+
+		IECore::MurmurHash channelHashes[4];
+		IECore::MurmurHash tileHash;
+		for( int c = 0; c < 4; ++c )
+		{
+			if( m_channelExists[c] )
+			{
+				context.set( ImagePlug::channelNameContextName, std::string( g_channelNames[c] ) );
+				channelHashes[c] = image->channelDataPlug()->hash();
+				tileHash.append( channelHashes[c] );
+			}
+			tileHash.append( m_channelExists[c] );
+		}
+
+		const ConstTilePtr &previousTile = m_previousTiles[tileIndex];
+		if( previousTile && previousTile->hash == tileHash )
+		{
+			return;
+		}
+
+		// Get the channel data. Tiles that have been displayed will
+		// already be in the compute cache.
+
+		ConstFloatVectorDataPtr channelData[4];
+		for( int c = 0; c < 4; ++c )
+		{
+			if( m_channelExists[c] )
+			{
+				context.set( ImagePlug::channelNameContextName, std::string( g_channelNames[c] ) );
+				channelData[c] = image->channelDataPlug()->getValue( &channelHashes[c] );
+			}
+			else
+			{
+				channelData[c] = ImagePlug::blackTile();
+			}
+		}
+
+		// Compute the contribution of each pixel.
+
+		boost::shared_ptr<Tile> tile( new Tile );
+		tile->hash = tileHash;
+		tile->minimum = Color4f( Imath::limits<float>::max() );
+		tile->maximum = Color4f( -Imath::limits<float>::max() );
+		std::fill( tile->sum, tile->sum + 4, 0.0 );
+
+		const Box2i tileBound( tileOrigin, tileOrigin + V2i( ImagePlug::tileSize() ) );
+		const Box2i window = BufferAlgo::intersection( tileBound, m_dataWindow );
+		tile->numPixels = window.size().x * window.size().y;
+
+		std::vector<unsigned> histogramIndices; histogramIndices.reserve( tile->numPixels * 4 );
+		std::vector<unsigned> waveformIndices; waveformIndices.reserve( tile->numPixels );
+		std::vector<unsigned> vectorscopeIndices; vectorscopeIndices.reserve( tile->numPixels );
+
+		const float *data[4];
+		for( int c = 0; c < 4; ++c )
+		{
+			data[c] = &channelData[c]->readable().front();
+		}
+
+		const int dataWindowWidth = m_dataWindow.size().x;
+		V2i p;
+		for( p.y = window.min.y; p.y < window.max.y; ++p.y )
+		{
+			for( p.x = window.min.x; p.x < window.max.x; ++p.x )
+			{
+				const size_t i = BufferAlgo::index( p, tileBound );
+				Color4f color;
+				for( int c = 0; c < 4; ++c )
+				{
+					color[c] = data[c][i];
+					tile->minimum[c] = std::min( tile->minimum[c], color[c] );
+					tile->maximum[c] = std::max( tile->maximum[c], color[c] );
+					tile->sum[c] += color[c];
+				}
+
+				const float luminance = color.r * g_lumaWeights[0] + color.g * g_lumaWeights[1] + color.b * g_lumaWeights[2];
+
+				for( int c = 0; c < 3; ++c )
+				{
+					histogramIndices.push_back( c * histogramBins + bin( color[c], 0.0f, 1.0f, histogramBins ) );
+				}
+				histogramIndices.push_back( Luminance * histogramBins + bin( luminance, 0.0f, 1.0f, histogramBins ) );
+
+				const unsigned column = (unsigned)( (size_t)( p.x - m_dataWindow.min.x ) * waveformWidth / dataWindowWidth );
+				waveformIndices.push_back( bin( luminance, 0.0f, 1.0f, waveformHeight ) * waveformWidth + column );
+
+				const float cb = ( color.b - luminance ) / 1.8556f;
+				const float cr = ( color.r - luminance ) / 1.5748f;
+				vectorscopeIndices.push_back( bin( cr, -0.5f, 0.5f, vectorscopeSize ) * vectorscopeSize + bin( cb, -0.5f, 0.5f, vectorscopeSize ) );
+			}
+		}
+
+		compress( histogramIndices, tile->histogram );
+		compress( waveformIndices, tile->waveform );
+		compress( vectorscopeIndices, tile->vectorscope );
+
+		// Each tile is only visited once, so we can write the result
+		// without any locking.
+		m_updatedTiles[tileIndex] = tile;
+	}
+
+	private :
+
+		const Box2i m_dataWindow;
+		bool m_channelExists[4];
+		V2i m_tilesOrigin;
+		int m_numTilesX;
+		const std::vector<ConstTilePtr> &m_previousTiles;
+		std::vector<ConstTilePtr> &m_updatedTiles;
+
+};
+
+//////////////////////////////////////////////////////////////////////////
+// ImageScopes
+//////////////////////////////////////////////////////////////////////////
+
+const size_t ImageScopes::histogramBins;
+const size_t ImageScopes::waveformWidth;
+const size_t ImageScopes::waveformHeight;
+const size_t ImageScopes::vectorscopeSize;
+
+ImageScopes::ImageScopes()
+	:	m_minimum( 0 ), m_maximum( 0 ), m_average( 0 )
+{
+	publish();
+}
+
+ImageScopes::~ImageScopes()
+{
+}
+
+void ImageScopes::setImage( GafferImage::ConstImagePlugPtr image )
+{
+	tbb::spin_mutex::scoped_lock lock( m_settingsMutex );
+	m_image = image;
+}
+
+GafferImage::ConstImagePlugPtr ImageScopes::getImage() const
+{
+	tbb::spin_mutex::scoped_lock lock( m_settingsMutex );
+	return m_image;
+}
+
+void ImageScopes::setContext( Gaffer::ConstContextPtr context )
+{
+	tbb::spin_mutex::scoped_lock lock( m_settingsMutex );
+	m_context = context;
+}
+
+Gaffer::ConstContextPtr ImageScopes::getContext() const
+{
+	tbb::spin_mutex::scoped_lock lock( m_settingsMutex );
+	return m_context;
+}
+
+bool ImageScopes::update()
+{
+	tbb::mutex::scoped_lock updateLock( m_updateMutex );
+
+	ConstImagePlugPtr image = getImage();
+	ConstContextPtr context = getContext();
+
+	Box2i dataWindow;
+	std::vector<std::string> channelNames;
+	if( image && context )
+	{
+		Context::Scope scopedContext( context.get() );
+		dataWindow = image->dataWindowPlug()->getValue();
+		channelNames = image->channelNamesPlug()->getValue()->readable();
+	}
+
+	// The waveform columns depend on the data window, so
+	// when it changes we must start again from scratch.
+
+	bool changed = false;
+	if( dataWindow != m_dataWindow || m_histogramTotals.empty() )
+	{
+		m_dataWindow = dataWindow;
+		m_tiles.clear();
+		if( !BufferAlgo::empty( dataWindow ) )
+		{
+			const V2i numTiles = ( ImagePlug::tileOrigin( dataWindow.max - V2i( 1 ) ) - ImagePlug::tileOrigin( dataWindow.min ) ) / ImagePlug::tileSize() + V2i( 1 );
+			m_tiles.resize( numTiles.x * numTiles.y );
+		}
+		m_histogramTotals.assign( histogramBins * 4, 0 );
+		m_waveformTotals.assign( waveformWidth * waveformHeight, 0 );
+		m_vectorscopeTotals.assign( vectorscopeSize * vectorscopeSize, 0 );
+		changed = true;
+	}
+
+	if( !BufferAlgo::empty( dataWindow ) )
+	{
+		std::vector<ConstTilePtr> updatedTiles( m_tiles.size() );
+		TileFunctor tileFunctor( dataWindow, channelNames, m_tiles, updatedTiles );
+		{
+			Context::Scope scopedContext( context.get() );
+			ImageAlgo::parallelProcessTiles( image.get(), tileFunctor, dataWindow );
+		}
+
+		for( size_t i = 0, e = m_tiles.size(); i < e; ++i )
+		{
+			if( !updatedTiles[i] )
+			{
+				continue;
+			}
+			if( m_tiles[i] )
+			{
+				accumulate( m_tiles[i].get(), false );
+			}
+			accumulate( updatedTiles[i].get(), true );
+			m_tiles[i] = updatedTiles[i];
+			changed = true;
+		}
+	}
+
+	if( changed )
+	{
+		publish();
+	}
+
+	return changed;
+}
+
+void ImageScopes::accumulate( const Tile *tile, bool add )
+{
+	accumulateCounts( tile->histogram, m_histogramTotals, add );
+	accumulateCounts( tile->waveform, m_waveformTotals, add );
+	accumulateCounts( tile->vectorscope, m_vectorscopeTotals, add );
+}
+
+void ImageScopes::publish()
+{
+	UIntVectorDataPtr histograms[4];
+	for( int c = 0; c < 4; ++c )
+	{
+		histograms[c] = new UIntVectorData;
+		if( m_histogramTotals.size() )
+		{
+			histograms[c]->writable().assign( m_histogramTotals.begin() + c * histogramBins, m_histogramTotals.begin() + ( c + 1 ) * histogramBins );
+		}
+		else
+		{
+			histograms[c]->writable().resize( histogramBins, 0 );
+		}
+	}
+
+	UIntVectorDataPtr waveform = new UIntVectorData( m_waveformTotals );
+	waveform->writable().resize( waveformWidth * waveformHeight, 0 );
+	UIntVectorDataPtr vectorscope = new UIntVectorData( m_vectorscopeTotals );
+	vectorscope->writable().resize( vectorscopeSize * vectorscopeSize, 0 );
+
+	// The minimum and maximum can't be updated incrementally
+	// when a tile changes, so we recompute them from all the
+	// tiles. This is cheap since we're only visiting one value
+	// per tile.
+
+	Color4f minimum( Imath::limits<float>::max() );
+	Color4f maximum( -Imath::limits<float>::max() );
+	double sum[4] = { 0, 0, 0, 0 };
+	size_t numPixels = 0;
+	for( std::vector<ConstTilePtr>::const_iterator it = m_tiles.begin(), eIt = m_tiles.end(); it != eIt; ++it )
+	{
+		if( !*it )
+		{
+			continue;
+		}
+		for( int c = 0; c < 4; ++c )
+		{
+			minimum[c] = std::min( minimum[c], (*it)->minimum[c] );
+			maximum[c] = std::max( maximum[c], (*it)->maximum[c] );
+			sum[c] += (*it)->sum[c];
+		}
+		numPixels += (*it)->numPixels;
+	}
+
+	Color4f average( 0 );
+	if( numPixels )
+	{
+		for( int c = 0; c < 4; ++c )
+		{
+			average[c] = sum[c] / numPixels;
+		}
+	}
+	else
+	{
+		minimum = maximum = Color4f( 0 );
+	}
+
+	tbb::spin_mutex::scoped_lock lock( m_resultsMutex );
+	for( int c = 0; c < 4; ++c )
+	{
+		m_histograms[c] = histograms[c];
+	}
+	m_waveform = waveform;
+	m_vectorscope = vectorscope;
+	m_minimum = minimum;
+	m_maximum = maximum;
+	m_average = average;
+	m_resultDataWindow = m_dataWindow;
+}
+
+IECore::ConstUIntVectorDataPtr ImageScopes::histogram( Channel channel ) const
+{
+	tbb::spin_mutex::scoped_lock lock( m_resultsMutex );
+	return m_histograms[channel];
+}
+
+IECore::ConstUIntVectorDataPtr ImageScopes::waveform() const
+{
+	tbb::spin_mutex::scoped_lock lock( m_resultsMutex );
+	return m_waveform;
+}
+
+IECore::ConstUIntVectorDataPtr ImageScopes::vectorscope() const
+{
+	tbb::spin_mutex::scoped_lock lock( m_resultsMutex );
+	return m_vectorscope;
+}
+
+Imath::Color4f ImageScopes::minimum() const
+{
+	tbb::spin_mutex::scoped_lock lock( m_resultsMutex );
+	return m_minimum;
+}
+
+Imath::Color4f ImageScopes::maximum() const
+{
+	tbb::spin_mutex::scoped_lock lock( m_resultsMutex );
+	return m_maximum;
+}
+
+Imath::Color4f ImageScopes::average() const
+{
+	tbb::spin_mutex::scoped_lock lock( m_resultsMutex );
+	return m_average;
+}
+
+Imath::Box2i ImageScopes::dataWindow() const
+{
+	tbb::spin_mutex::scoped_lock lock( m_resultsMutex );
+	return m_resultDataWindow;
+}
@@ -56,6 +56,7 @@
 #include "IECoreGL/IECoreGL.h"
 
 #include "Gaffer/Context.h"
+#include "Gaffer/ScriptNode.h"
 #include "Gaffer/StringPlug.h"
 
 #include "GafferUI/Gadget.h"
@@ -64,6 +65,7 @@
 #include "GafferUI/Pointer.h"
 
 #include "GafferImage/Format.h"
+#include "GafferImage/FormatPlug.h"
 #include "GafferImage/Grade.h"
 #include "GafferImage/ImagePlug.h"
 #include "GafferImage/ImageStats.h"
@@ -71,6 +73,7 @@
 #include "GafferImage/ImageSampler.h"
 
 #include "GafferImageUI/ImageGadget.h"
+#include "GafferImageUI/ImageScopes.h"
 #include "GafferImageUI/ImageView.h"
 
 using namespace boost;
@@ -263,6 +266,7 @@ ImageView::ViewDescription<ImageView> ImageView::g_viewDescription( GafferImage:
 ImageView::ImageView( const std::string &name )
 	:	View( name, new GafferImage::ImagePlug() ),
 		m_imageGadget( new ImageGadget() ),
+		m_imageScopes( new ImageScopes() ),
 		m_framed( false )
 {
 
@@ -300,6 +304,10 @@ ImageView::ImageView( const std::string &name )
 
 	addChild( new StringPlug( "displayTransform", Plug::In, "Default", Plug::Default & ~Plug::AcceptsInputs ) );
 
+	addChild( new IntPlug( "playbackCacheMemoryLimit", Plug::In, 0, 0, Imath::limits<int>::max(), Plug::Default & ~Plug::AcceptsInputs ) );
+
+	addChild( new BoolPlug( "scopes", Plug::In, false, Plug::Default & ~Plug::AcceptsInputs ) );
+
 	ImagePlugPtr preprocessorOutput = new ImagePlug( "out", Plug::Out );
 	preprocessor->addChild( preprocessorOutput );
 	preprocessorOutput->setInput( gradeNode->outPlug() );
@@ -325,6 +333,11 @@ ImageView::ImageView( const std::string &name )
 	m_imageGadget->setContext( getContext() );
 	viewportGadget()->setPrimaryChild( m_imageGadget );
 
+	// The scopes measure the same image as the ColorInspector, for
+	// the same reasons.
+	m_imageScopes->setImage( clampNode->inPlug() );
+	m_imageScopes->setContext( getContext() );
+
 	m_channelChooser = shared_ptr<ChannelChooser>( new ChannelChooser( this ) );
 	m_colorInspector = shared_ptr<ColorInspector>( new ColorInspector( this ) );
 }
@@ -405,6 +418,31 @@ const Gaffer::StringPlug *ImageView::displayTransformPlug() const
 	return getChild<StringPlug>( "displayTransform" );
 }
 
+Gaffer::IntPlug *ImageView::playbackCacheMemoryLimitPlug()
+{
+	return getChild<IntPlug>( "playbackCacheMemoryLimit" );
+}
+
+const Gaffer::IntPlug *ImageView::playbackCacheMemoryLimitPlug() const
+{
+	return getChild<IntPlug>( "playbackCacheMemoryLimit" );
+}
+
+Gaffer::BoolPlug *ImageView::scopesPlug()
+{
+	return getChild<BoolPlug>( "scopes" );
+}
+
+const Gaffer::BoolPlug *ImageView::scopesPlug() const
+{
+	return getChild<BoolPlug>( "scopes" );
+}
+
+ImageScopes *ImageView::imageScopes()
+{
+	return m_imageScopes.get();
+}
+
 GafferImage::Clamp *ImageView::clampNode()
 {
 	return getPreprocessor<Node>()->getChild<Clamp>( "__clamp" );
@@ -429,6 +467,7 @@ void ImageView::setContext( Gaffer::ContextPtr context )
 {
 	View::setContext( context );
 	m_imageGadget->setContext( context );
+	m_imageScopes->setContext( context );
 }
 
 void ImageView::plugSet( Gaffer::Plug *plug )
@@ -450,6 +489,10 @@ void ImageView::plugSet( Gaffer::Plug *plug )
 	{
 		insertDisplayTransform();
 	}
+	else if( plug == playbackCacheMemoryLimitPlug() )
+	{
+		m_imageGadget->setFrameCacheMemoryLimit( (size_t)playbackCacheMemoryLimitPlug()->getValue() * 1024 * 1024 );
+	}
 }
 
 bool ImageView::keyPress( const GafferUI::KeyEvent &event )
@@ -476,6 +519,9 @@ bool ImageView::keyPress( const GafferUI::KeyEvent &event )
 
 void ImageView::preRender()
 {
+	updateProxyLevel();
+	updateFrameCacheRange();
+
 	if( m_framed )
 	{
 		return;
@@ -491,6 +537,39 @@ void ImageView::preRender()
 	m_framed = true;
 }
 
+void ImageView::updateProxyLevel()
+{
+	// Compute the image at the lowest resolution which still
+	// provides at least one image pixel per screen pixel.
+	const V2f p0 = viewportGadget()->gadgetToRasterSpace( V3f( 0 ), m_imageGadget.get() );
+	const V2f p1 = viewportGadget()->gadgetToRasterSpace( V3f( 0, 1, 0 ), m_imageGadget.get() );
+	const float rasterPixelsPerImagePixel = ( p1 - p0 ).length();
+
+	int proxyLevel = 0;
+	while( proxyLevel < GafferImage::FormatPlug::maxProxyLevel && rasterPixelsPerImagePixel * (float)( 2 << proxyLevel ) <= 1.0f )
+	{
+		proxyLevel++;
+	}
+
+	m_imageGadget->setProxyLevel( proxyLevel );
+}
+
+void ImageView::updateFrameCacheRange()
+{
+	// Fill the playback cache over the frame range
+	// of the script containing the viewed node.
+	const Plug *input = inPlug<ImagePlug>()->getInput<Plug>();
+	const ScriptNode *script = input && input->node() ? input->node()->scriptNode() : NULL;
+	if( script )
+	{
+		m_imageGadget->setFrameCacheRange( script->frameStartPlug()->getValue(), script->frameEndPlug()->getValue() );
+	}
+	else
+	{
+		m_imageGadget->setFrameCacheRange( 0, -1 );
+	}
+}
+
 void ImageView::insertDisplayTransform()
 {
 	const std::string name = displayTransformPlug()->getValue();
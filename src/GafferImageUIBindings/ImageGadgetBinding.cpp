@@ -81,6 +81,12 @@ void GafferImageUIBindings::bindImageGadget()
 		.def( "getContext", (Context *(ImageGadget::*)())&ImageGadget::getContext, return_value_policy<CastToIntrusivePtr>() )
 		.def( "setSoloChannel", &ImageGadget::setSoloChannel )
 		.def( "getSoloChannel", &ImageGadget::getSoloChannel )
+		.def( "setProxyLevel", &ImageGadget::setProxyLevel )
+		.def( "getProxyLevel", &ImageGadget::getProxyLevel )
+		.def( "setFrameCacheMemoryLimit", &ImageGadget::setFrameCacheMemoryLimit )
+		.def( "getFrameCacheMemoryLimit", &ImageGadget::getFrameCacheMemoryLimit )
+		.def( "frameCacheMemoryUsage", &ImageGadget::frameCacheMemoryUsage )
+		.def( "setFrameCacheRange", &ImageGadget::setFrameCacheRange )
 		.def( "pixelAt", &pixelAt )
 	;
 }
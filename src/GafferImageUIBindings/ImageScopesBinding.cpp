@@ -0,0 +1,124 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2017, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//      * Redistributions of source code must retain the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer.
+//
+//      * Redistributions in binary form must reproduce the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer in the documentation and/or other materials provided with
+//        the distribution.
+//
+//      * Neither the name of John Haddon nor the names of
+//        any other contributors to this software may be used to endorse or
+//        promote products derived from this software without specific prior
+//        written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#include "boost/python.hpp"
+
+#include "IECorePython/RefCountedBinding.h"
+#include "IECorePython/ScopedGILRelease.h"
+
+#include "Gaffer/Context.h"
+
+#include "GafferImage/ImagePlug.h"
+
+#include "GafferImageUI/ImageScopes.h"
+#include "GafferImageUIBindings/ImageScopesBinding.h"
+
+using namespace boost::python;
+using namespace IECorePython;
+using namespace Gaffer;
+using namespace GafferImage;
+using namespace GafferImageUI;
+
+namespace
+{
+
+ImagePlugPtr getImage( const ImageScopes &s )
+{
+	return boost::const_pointer_cast<ImagePlug>( s.getImage() );
+}
+
+void setContext( ImageScopes &s, ContextPtr context )
+{
+	s.setContext( context );
+}
+
+ContextPtr getContext( const ImageScopes &s )
+{
+	return boost::const_pointer_cast<Context>( s.getContext() );
+}
+
+bool update( ImageScopes &s )
+{
+	IECorePython::ScopedGILRelease gilRelease;
+	return s.update();
+}
+
+IECore::UIntVectorDataPtr histogram( const ImageScopes &s, ImageScopes::Channel channel )
+{
+	return s.histogram( channel )->copy();
+}
+
+IECore::UIntVectorDataPtr waveform( const ImageScopes &s )
+{
+	return s.waveform()->copy();
+}
+
+IECore::UIntVectorDataPtr vectorscope( const ImageScopes &s )
+{
+	return s.vectorscope()->copy();
+}
+
+} // namespace
+
+void GafferImageUIBindings::bindImageScopes()
+{
+	scope s = RefCountedClass<ImageScopes, IECore::RefCounted>( "ImageScopes" )
+		.def( init<>() )
+		.def( "setImage", &ImageScopes::setImage )
+		.def( "getImage", &getImage )
+		.def( "setContext", &setContext )
+		.def( "getContext", &getContext )
+		.def( "update", &update )
+		.def( "histogram", &histogram )
+		.def( "waveform", &waveform )
+		.def( "vectorscope", &vectorscope )
+		.def( "minimum", &ImageScopes::minimum )
+		.def( "maximum", &ImageScopes::maximum )
+		.def( "average", &ImageScopes::average )
+		.def( "dataWindow", &ImageScopes::dataWindow )
+		.def_readonly( "histogramBins", &ImageScopes::histogramBins )
+		.def_readonly( "waveformWidth", &ImageScopes::waveformWidth )
+		.def_readonly( "waveformHeight", &ImageScopes::waveformHeight )
+		.def_readonly( "vectorscopeSize", &ImageScopes::vectorscopeSize )
+	;
+
+	enum_<ImageScopes::Channel>( "Channel" )
+		.value( "Red", ImageScopes::Red )
+		.value( "Green", ImageScopes::Green )
+		.value( "Blue", ImageScopes::Blue )
+		.value( "Luminance", ImageScopes::Luminance )
+	;
+}
@@ -41,6 +41,7 @@
 #include "GafferImage/ImageProcessor.h"
 
 #include "GafferImageUI/ImageView.h"
+#include "GafferImageUI/ImageScopes.h"
 #include "GafferImageUIBindings/ImageViewBinding.h"
 
 using namespace std;
@@ -87,6 +88,11 @@ static void registerDisplayTransform( const std::string &name, object creator )
 	ImageView::registerDisplayTransform( name, DisplayTransformCreator( creator ) );
 }
 
+static ImageScopesPtr imageScopes( ImageView &v )
+{
+	return v.imageScopes();
+}
+
 static boost::python::list registeredDisplayTransforms()
 {
 	vector<string> n;
@@ -106,6 +112,7 @@ void GafferImageUIBindings::bindImageView()
 	GafferBindings::NodeClass<ImageView, ImageViewWrapper>()
 		.def( init<const std::string &>() )
 		.def( "_insertConverter", &ImageView::insertConverter )
+		.def( "imageScopes", &imageScopes )
 		.def( "registerDisplayTransform", &registerDisplayTransform )
 		.staticmethod( "registerDisplayTransform" )
 		.def( "registeredDisplayTransforms", &registeredDisplayTransforms )
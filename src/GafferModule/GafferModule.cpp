@@ -92,6 +92,10 @@
 #include "GafferBindings/MonitorBinding.h"
 #include "GafferBindings/MetadataAlgoBinding.h"
 #include "GafferBindings/SwitchBinding.h"
+#include "GafferBindings/DataBinding.h"
+#include "GafferBindings/MemoryGovernorBinding.h"
+#include "GafferBindings/NUMABinding.h"
+#include "GafferBindings/RemoteComputeBinding.h"
 
 using namespace boost::python;
 using namespace Gaffer;
@@ -188,6 +192,10 @@ BOOST_PYTHON_MODULE( _Gaffer )
 	bindMonitor();
 	bindMetadataAlgo();
 	bindSwitch();
+	bindData();
+	bindMemoryGovernor();
+	bindNUMA();
+	bindRemoteCompute();
 
 	NodeClass<Backdrop>();
 
@@ -38,10 +38,14 @@
 
 #include "boost/filesystem.hpp"
 #include "boost/bind.hpp"
+#include "boost/lexical_cast.hpp"
+#include "boost/format.hpp"
 
 #include "OSL/oslcomp.h"
+#include "OSL/oslversion.h"
 
 #include "IECore/Exception.h"
+#include "IECore/MessageHandler.h"
 
 #include "Gaffer/StringAlgo.h"
 #include "Gaffer/StringPlug.h"
@@ -211,30 +215,18 @@ class ScopedDirectory : boost::noncopyable
 
 };
 
-boost::filesystem::path compile( const std::string &shaderName, const std::string &shaderSource )
+boost::filesystem::path defaultCodeDirectory()
 {
+	return boost::filesystem::temp_directory_path() / "gafferOSLCode";
+}
 
-	// We need to ensure the existence of a unique .oso file
-	// containing the compiled code. We allow the user to specify
-	// the base location for such files using the GAFFEROSL_CODE_DIRECTORY
-	// environment variable, but we must also assume that multiple processes
-	// on multiple machines will be concurrently trying to ensure the
-	// same .oso files exist (think renderfarm). We achieve this as follows :
-	//
-	// - Use a hash of the code itself to generate the final .oso filename.
-	//   This does nothing to resolve concurrent accesses, but ensures that
-	//   different code goes in different files.
-	// - If the required file does not exist yet, first generate it in a temporary
-	//   location unique to this process.
-	// - Finally, move the file into place using an atomic `rename()`.
-
-	// Start by generating our final desired filename.
+boost::filesystem::path compileInDirectory( boost::filesystem::path directory, const std::string &shaderName, const std::string &shaderSource )
+{
+	// Start by generating our final desired filename. A shared directory
+	// may well be used by processes built against different versions of
+	// OSL, so we keep the .oso files for each version separate.
 
-	boost::filesystem::path directory = boost::filesystem::temp_directory_path() / "gafferOSLCode";
-	if( const char *cd = getenv( "GAFFEROSL_CODE_DIRECTORY" ) )
-	{
-		directory = cd;
-	}
+	directory /= "osl" + boost::lexical_cast<std::string>( OSL_LIBRARY_VERSION_CODE );
 
 	for( size_t i = 0; i < shaderName.length(); i += 8 )
 	{
@@ -312,6 +304,57 @@ boost::filesystem::path compile( const std::string &shaderName, const std::strin
 	return osoFileName;
 }
 
+boost::filesystem::path compile( const std::string &shaderName, const std::string &shaderSource )
+{
+
+	// We need to ensure the existence of a unique .oso file
+	// containing the compiled code. We allow the user to specify
+	// the base location for such files using the GAFFEROSL_CODE_DIRECTORY
+	// environment variable, but we must also assume that multiple processes
+	// on multiple machines will be concurrently trying to ensure the
+	// same .oso files exist (think renderfarm). We achieve this as follows :
+	//
+	// - Use a hash of the code itself to generate the final .oso filename.
+	//   This does nothing to resolve concurrent accesses, but ensures that
+	//   different code goes in different files.
+	// - If the required file does not exist yet, first generate it in a temporary
+	//   location unique to this process.
+	// - Finally, move the file into place using an atomic `rename()`.
+	//
+	// This allows GAFFEROSL_CODE_DIRECTORY to point to a location shared by
+	// a whole facility, so that each shader is compiled only once. Existing
+	// files can be used even if the directory is read-only for the current
+	// user. If we can't write a new file there, we fall back to compiling
+	// into the default local directory rather than failing outright.
+
+	const boost::filesystem::path defaultDirectory = defaultCodeDirectory();
+	boost::filesystem::path directory = defaultDirectory;
+	if( const char *cd = getenv( "GAFFEROSL_CODE_DIRECTORY" ) )
+	{
+		directory = cd;
+	}
+
+	if( directory == defaultDirectory )
+	{
+		return compileInDirectory( directory, shaderName, shaderSource );
+	}
+
+	try
+	{
+		return compileInDirectory( directory, shaderName, shaderSource );
+	}
+	catch( const boost::filesystem::filesystem_error &e )
+	{
+		IECore::msg( IECore::Msg::Warning, "OSLCode", boost::format( "Unable to write to code directory \"%s\" (%s). Using \"%s\" instead." ) % directory.string() % e.what() % defaultDirectory.string() );
+	}
+	catch( const IECore::IOException &e )
+	{
+		IECore::msg( IECore::Msg::Warning, "OSLCode", boost::format( "Unable to write to code directory \"%s\" (%s). Using \"%s\" instead." ) % directory.string() % e.what() % defaultDirectory.string() );
+	}
+
+	return compileInDirectory( defaultDirectory, shaderName, shaderSource );
+}
+
 class CompileProcess : public Gaffer::Process
 {
 
@@ -225,6 +225,7 @@ class OSLExpressionEngine : public Gaffer::Expression::Engine
 		{
 			m_inParameters.clear();
 			m_outSymbols.clear();
+			m_outTypes.clear();
 			m_shaderGroup.reset();
 
 			// Find all references to plugs within the expression.
@@ -302,11 +303,14 @@ class OSLExpressionEngine : public Gaffer::Expression::Engine
 				}
 			}
 
-			// Grab the symbols for each of the output parameters so we can
-			// query their values in execute().
+			// Grab the symbols and types for each of the output parameters so
+			// we can query their values in execute() without repeating the
+			// lookups for every evaluation.
 			for( vector<ustring>::const_iterator it = outParameters.begin(), eIt = outParameters.end(); it != eIt; ++it )
 			{
-				m_outSymbols.push_back( shadingSys->find_symbol( *m_shaderGroup, *it ) );
+				const OSL::ShaderSymbol *symbol = shadingSys->find_symbol( *m_shaderGroup, *it );
+				m_outSymbols.push_back( symbol );
+				m_outTypes.push_back( shadingSys->symbol_typedesc( symbol ) );
 			}
 
 		}
@@ -332,10 +336,10 @@ class OSLExpressionEngine : public Gaffer::Expression::Engine
 			ObjectVectorPtr result = new ObjectVector;
 			result->members().reserve( m_outSymbols.size() );
 
-			for( vector<const OSL::ShaderSymbol *>::const_iterator it = m_outSymbols.begin(), eIt = m_outSymbols.end(); it != eIt; ++it )
+			for( size_t i = 0, e = m_outSymbols.size(); i < e; ++i )
 			{
-				const TypeDesc type = s->symbol_typedesc( *it );
-				const void *storage = s->symbol_address( *shadingContext, *it );
+				const TypeDesc &type = m_outTypes[i];
+				const void *storage = s->symbol_address( *shadingContext, m_outSymbols[i] );
 				if( type == TypeDesc::TypeFloat )
 				{
 					result->members().push_back( new FloatData( *(const float *)storage ) );
@@ -778,6 +782,7 @@ class OSLExpressionEngine : public Gaffer::Expression::Engine
 		// Initialised by parse().
 		vector<ustring> m_inParameters;
 		vector<const OSL::ShaderSymbol *> m_outSymbols;
+		vector<TypeDesc> m_outTypes;
 		OSL::ShaderGroupRef m_shaderGroup;
 
 };
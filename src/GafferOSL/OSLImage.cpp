@@ -35,7 +35,11 @@
 //
 //////////////////////////////////////////////////////////////////////////
 
+#include "tbb/enumerable_thread_specific.h"
+
 #include "IECore/CompoundData.h"
+#include "IECore/CompoundObject.h"
+#include "IECore/ObjectVector.h"
 
 #include "Gaffer/Context.h"
 #include "Gaffer/StringPlug.h"
@@ -51,6 +55,148 @@ using namespace Gaffer;
 using namespace GafferImage;
 using namespace GafferOSL;
 
+//////////////////////////////////////////////////////////////////////////
+// Utilities
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+// Rather than shade each tile individually, we shade blocks of
+// g_blockTiles * g_blockTiles tiles at once. This amortises the
+// per-shade overhead across many more points, and gives the
+// ShadingEngine enough work to parallelise effectively.
+const int g_blockTiles = 4;
+
+int blockSize()
+{
+	return ImagePlug::tileSize() * g_blockTiles;
+}
+
+int floorDivide( int a, int b )
+{
+	return a >= 0 ? a / b : ( a - b + 1 ) / b;
+}
+
+// Returns the origin of the block containing the specified tile.
+V2i blockOrigin( const V2i &tileOrigin )
+{
+	const int size = blockSize();
+	return V2i(
+		floorDivide( tileOrigin.x, size ) * size,
+		floorDivide( tileOrigin.y, size ) * size
+	);
+}
+
+// Returns the range of tile origins within the block that intersect
+// the data window. Note that unlike image windows, the max of the result
+// is inclusive, being the origin of the last tile.
+Box2i blockTiles( const V2i &blockOrigin, const Box2i &dataWindow )
+{
+	if( dataWindow.isEmpty() )
+	{
+		return Box2i();
+	}
+
+	const int tileSize = ImagePlug::tileSize();
+	Box2i result(
+		ImagePlug::tileOrigin( dataWindow.min ),
+		ImagePlug::tileOrigin( dataWindow.max - V2i( 1 ) )
+	);
+	result.min.x = std::max( result.min.x, blockOrigin.x );
+	result.min.y = std::max( result.min.y, blockOrigin.y );
+	result.max.x = std::min( result.max.x, blockOrigin.x + blockSize() - tileSize );
+	result.max.y = std::min( result.max.y, blockOrigin.y + blockSize() - tileSize );
+	return result;
+}
+
+// Returns the index of the tile within the ObjectVectors stored
+// for each channel of the shading results.
+size_t blockTileIndex( const V2i &tileOrigin, const Box2i &blockTiles )
+{
+	const int tileSize = ImagePlug::tileSize();
+	const int numTilesX = ( blockTiles.max.x - blockTiles.min.x ) / tileSize + 1;
+	return ( ( tileOrigin.y - blockTiles.min.y ) / tileSize ) * numTilesX + ( tileOrigin.x - blockTiles.min.x ) / tileSize;
+}
+
+// Buffers for the P, u and v globals. These are the same for every
+// shade of the same block, so we keep one set of buffers per thread
+// and reuse them rather than reallocate and refill for every compute.
+struct GlobalsBuffers
+{
+
+	void update( const Box2i &pixelBound, const Format &format )
+	{
+		if(
+			p && p->refCount() == 1 && u->refCount() == 1 && v->refCount() == 1 &&
+			pixelBound == m_pixelBound && format == m_format
+		)
+		{
+			return;
+		}
+
+		// If the buffers are still referenced elsewhere (by a shade in
+		// progress further up the stack on this thread, for instance)
+		// then we mustn't modify them, so make new ones instead.
+		if( !p || p->refCount() > 1 || u->refCount() > 1 || v->refCount() > 1 )
+		{
+			p = new V3fVectorData;
+			u = new FloatVectorData;
+			v = new FloatVectorData;
+		}
+
+		vector<V3f> &pWritable = p->writable();
+		vector<float> &uWritable = u->writable();
+		vector<float> &vWritable = v->writable();
+
+		const size_t numPoints = pixelBound.size().x * pixelBound.size().y;
+		pWritable.resize( numPoints );
+		uWritable.resize( numPoints );
+		vWritable.resize( numPoints );
+
+		/// \todo Non-zero display window origins - do we have those?
+		const float uStep = 1.0f / format.width();
+		const float uMin = 0.5f * uStep;
+
+		const float vStep = 1.0f / format.height();
+		const float vMin = 0.5f * vStep;
+
+		size_t i = 0;
+		for( int y = pixelBound.min.y; y < pixelBound.max.y; ++y )
+		{
+			const float vv = vMin + y * vStep;
+			for( int x = pixelBound.min.x; x < pixelBound.max.x; ++x, ++i )
+			{
+				uWritable[i] = uMin + x * uStep;
+				vWritable[i] = vv;
+				pWritable[i] = V3f( x, y, 0.0f );
+			}
+		}
+
+		m_pixelBound = pixelBound;
+		m_format = format;
+	}
+
+	V3fVectorDataPtr p;
+	FloatVectorDataPtr u;
+	FloatVectorDataPtr v;
+
+	private :
+
+		Box2i m_pixelBound;
+		Format m_format;
+
+};
+
+typedef tbb::enumerable_thread_specific<GlobalsBuffers> ThreadGlobalsBuffers;
+ThreadGlobalsBuffers g_globalsBuffers;
+
+} // namespace
+
+//////////////////////////////////////////////////////////////////////////
+// OSLImage
+//////////////////////////////////////////////////////////////////////////
+
 IE_CORE_DEFINERUNTIMETYPED( OSLImage );
 
 size_t OSLImage::g_firstPlugIndex = 0;
@@ -62,7 +208,7 @@ OSLImage::OSLImage( const std::string &name )
 
 	addChild( new GafferScene::ShaderPlug( "shader" ) );
 
-	addChild( new Gaffer::ObjectPlug( "__shading", Gaffer::Plug::Out, new CompoundData() ) );
+	addChild( new Gaffer::ObjectPlug( "__shading", Gaffer::Plug::Out, new CompoundObject() ) );
 
 	// we disable caching for the channel data plug, because our compute
 	// simply references data direct from the shading plug, which will itself
@@ -106,6 +252,7 @@ void OSLImage::affects( const Gaffer::Plug *input, AffectedPlugsContainer &outpu
 	if(
 		input == shaderPlug() ||
 		input == inPlug()->formatPlug() ||
+		input == inPlug()->dataWindowPlug() ||
 		input == inPlug()->channelNamesPlug() ||
 		input == inPlug()->channelDataPlug()
 	)
@@ -184,9 +331,8 @@ void OSLImage::hashChannelNames( const GafferImage::ImagePlug *output, const Gaf
 	const Box2i dataWindow = inPlug()->dataWindowPlug()->getValue();
 	if( !dataWindow.isEmpty() )
 	{
-		ContextPtr c = new Context( *context, Context::Borrowed );
-		c->set( ImagePlug::tileOriginContextName, ImagePlug::tileOrigin( dataWindow.min ) );
-		Context::Scope s( c.get() );
+		Context::EditableScope c( context );
+		c.set( ImagePlug::tileOriginContextName, blockOrigin( ImagePlug::tileOrigin( dataWindow.min ) ) );
 		shadingPlug()->hash( h );
 	}
 }
@@ -200,12 +346,11 @@ IECore::ConstStringVectorDataPtr OSLImage::computeChannelNames( const Gaffer::Co
 	const Box2i dataWindow = inPlug()->dataWindowPlug()->getValue();
 	if( !dataWindow.isEmpty() )
 	{
-		ContextPtr c = new Context( *context, Context::Borrowed );
-		c->set( ImagePlug::tileOriginContextName, ImagePlug::tileOrigin( dataWindow.min ) );
-		Context::Scope s( c.get() );
+		Context::EditableScope c( context );
+		c.set( ImagePlug::tileOriginContextName, blockOrigin( ImagePlug::tileOrigin( dataWindow.min ) ) );
 
-		ConstCompoundDataPtr shading = runTimeCast<const CompoundData>( shadingPlug()->getValue() );
-		for( CompoundDataMap::const_iterator it = shading->readable().begin(), eIt = shading->readable().end(); it != eIt; ++it )
+		ConstCompoundObjectPtr shading = runTimeCast<const CompoundObject>( shadingPlug()->getValue() );
+		for( CompoundObject::ObjectMap::const_iterator it = shading->members().begin(), eIt = shading->members().end(); it != eIt; ++it )
 		{
 			result.insert( it->first );
 		}
@@ -218,33 +363,63 @@ void OSLImage::hashChannelData( const GafferImage::ImagePlug *output, const Gaff
 {
 	ImageProcessor::hashChannelData( output, context, h );
 	h.append( context->get<std::string>( ImagePlug::channelNameContextName ) );
+
+	const V2i tileOrigin = context->get<V2i>( ImagePlug::tileOriginContextName );
+	h.append( tileOrigin );
+
+	Context::EditableScope c( context );
+	c.set( ImagePlug::tileOriginContextName, blockOrigin( tileOrigin ) );
 	shadingPlug()->hash( h );
 }
 
 IECore::ConstFloatVectorDataPtr OSLImage::computeChannelData( const std::string &channelName, const Imath::V2i &tileOrigin, const Gaffer::Context *context, const GafferImage::ImagePlug *parent ) const
 {
-	ConstCompoundDataPtr shadedPoints = runTimeCast<const CompoundData>( shadingPlug()->getValue() );
-	ConstFloatVectorDataPtr result = shadedPoints->member<FloatVectorData>( channelName );
+	ConstCompoundObjectPtr shading;
+	{
+		Context::EditableScope c( context );
+		c.set( ImagePlug::tileOriginContextName, blockOrigin( tileOrigin ) );
+		shading = runTimeCast<const CompoundObject>( shadingPlug()->getValue() );
+	}
 
-	if( !result )
+	// The shading contains an ObjectVector of tiles for each channel,
+	// so we can return the appropriate tile directly without copying.
+	CompoundObject::ObjectMap::const_iterator it = shading->members().find( channelName );
+	if( it == shading->members().end() )
 	{
-		result = inPlug()->channelDataPlug()->getValue();
+		return inPlug()->channelDataPlug()->getValue();
 	}
 
-	return result;
+	const Box2i tiles = blockTiles( blockOrigin( tileOrigin ), inPlug()->dataWindowPlug()->getValue() );
+	if( !tiles.intersects( tileOrigin ) )
+	{
+		return inPlug()->channelDataPlug()->getValue();
+	}
+
+	const ObjectVector *channelTiles = static_cast<const ObjectVector *>( it->second.get() );
+	return static_cast<const FloatVectorData *>( channelTiles->members()[blockTileIndex( tileOrigin, tiles )].get() );
 }
 
 void OSLImage::hashShading( const Gaffer::Context *context, IECore::MurmurHash &h ) const
 {
-	const V2i tileOrigin = context->get<V2i>( ImagePlug::tileOriginContextName );
-	h.append( tileOrigin );
+	const V2i blockOrigin = context->get<V2i>( ImagePlug::tileOriginContextName );
+	h.append( blockOrigin );
 	inPlug()->formatPlug()->hash( h );
 
+	const Box2i tiles = blockTiles( blockOrigin, inPlug()->dataWindowPlug()->getValue() );
+	h.append( tiles );
+
 	ConstStringVectorDataPtr channelNamesData = inPlug()->channelNamesPlug()->getValue();
 	const vector<string> &channelNames = channelNamesData->readable();
+	const int tileSize = ImagePlug::tileSize();
 	for( vector<string>::const_iterator it = channelNames.begin(), eIt = channelNames.end(); it != eIt; ++it )
 	{
-		h.append( inPlug()->channelDataHash( *it, tileOrigin ) );
+		for( int y = tiles.min.y; y <= tiles.max.y; y += tileSize )
+		{
+			for( int x = tiles.min.x; x <= tiles.max.x; x += tileSize )
+			{
+				h.append( inPlug()->channelDataHash( *it, V2i( x, y ) ) );
+			}
+		}
 	}
 
 	const OSLShader *shader = runTimeCast<const OSLShader>( shaderPlug()->source<Plug>()->node() );
@@ -254,7 +429,7 @@ void OSLImage::hashShading( const Gaffer::Context *context, IECore::MurmurHash &
 	}
 }
 
-IECore::ConstCompoundDataPtr OSLImage::computeShading( const Gaffer::Context *context ) const
+IECore::ConstCompoundObjectPtr OSLImage::computeShading( const Gaffer::Context *context ) const
 {
 	ConstShadingEnginePtr shadingEngine;
 	if( const OSLShader *shader = runTimeCast<const OSLShader>( shaderPlug()->source<Plug>()->node() ) )
@@ -264,69 +439,92 @@ IECore::ConstCompoundDataPtr OSLImage::computeShading( const Gaffer::Context *co
 
 	if( !shadingEngine )
 	{
-		return static_cast<const CompoundData *>( shadingPlug()->defaultValue() );
+		return static_cast<const CompoundObject *>( shadingPlug()->defaultValue() );
 	}
 
-	const V2i tileOrigin = context->get<V2i>( ImagePlug::tileOriginContextName );
+	const V2i blockOrigin = context->get<V2i>( ImagePlug::tileOriginContextName );
 	const Format format = inPlug()->formatPlug()->getValue();
+	const Box2i tiles = blockTiles( blockOrigin, inPlug()->dataWindowPlug()->getValue() );
+	if( tiles.isEmpty() )
+	{
+		return static_cast<const CompoundObject *>( shadingPlug()->defaultValue() );
+	}
 
-	CompoundDataPtr shadingPoints = new CompoundData();
-
-	V3fVectorDataPtr pData = new V3fVectorData;
-	FloatVectorDataPtr uData = new FloatVectorData;
-	FloatVectorDataPtr vData = new FloatVectorData;
-
-	vector<V3f> &pWritable = pData->writable();
-	vector<float> &uWritable = uData->writable();
-	vector<float> &vWritable = vData->writable();
-
-	const size_t tileSize = ImagePlug::tileSize();
-	pWritable.reserve( tileSize * tileSize );
-	uWritable.reserve( tileSize * tileSize );
-	vWritable.reserve( tileSize * tileSize );
+	const int tileSize = ImagePlug::tileSize();
+	const Box2i pixelBound( tiles.min, tiles.max + V2i( tileSize ) );
+	const int blockWidth = pixelBound.size().x;
+	const size_t numPoints = blockWidth * pixelBound.size().y;
 
-	/// \todo Non-zero display window origins - do we have those?
-	const float uStep = 1.0f / format.width();
-	const float uMin = 0.5f * uStep;
+	// Build the globals, reusing the buffers from previous
+	// computes on this thread where possible.
 
-	const float vStep = 1.0f / format.height();
-	const float vMin = 0.5f * vStep;
+	GlobalsBuffers &globals = g_globalsBuffers.local();
+	globals.update( pixelBound, format );
 
-	const size_t xMax = tileOrigin.x + tileSize;
-	const size_t yMax = tileOrigin.y + tileSize;
-	for( size_t y = tileOrigin.y; y < yMax; ++y )
-	{
-		const float v = vMin + y * vStep;
-		for( size_t x = tileOrigin.x; x < xMax; ++x )
-		{
-			uWritable.push_back( uMin + x * uStep );
-			vWritable.push_back( v );
-			pWritable.push_back( V3f( x, y, 0.0f ) );
-		}
-	}
+	CompoundDataPtr shadingPoints = new CompoundData();
+	shadingPoints->writable()["P"] = globals.p;
+	shadingPoints->writable()["u"] = globals.u;
+	shadingPoints->writable()["v"] = globals.v;
 
-	shadingPoints->writable()["P"] = pData;
-	shadingPoints->writable()["u"] = uData;
-	shadingPoints->writable()["v"] = vData;
+	// Gather the input channels for all the tiles in the block.
 
 	ConstStringVectorDataPtr channelNamesData = inPlug()->channelNamesPlug()->getValue();
 	const vector<string> &channelNames = channelNamesData->readable();
 	for( vector<string>::const_iterator it = channelNames.begin(), eIt = channelNames.end(); it != eIt; ++it )
 	{
-		shadingPoints->writable()[*it] = boost::const_pointer_cast<FloatVectorData>( inPlug()->channelData( *it, tileOrigin ) );
+		FloatVectorDataPtr channelData = new FloatVectorData;
+		vector<float> &channel = channelData->writable();
+		channel.resize( numPoints );
+		for( int ty = tiles.min.y; ty <= tiles.max.y; ty += tileSize )
+		{
+			for( int tx = tiles.min.x; tx <= tiles.max.x; tx += tileSize )
+			{
+				ConstFloatVectorDataPtr tileData = inPlug()->channelData( *it, V2i( tx, ty ) );
+				const float *src = &tileData->readable()[0];
+				float *dst = &channel[( ty - pixelBound.min.y ) * blockWidth + ( tx - pixelBound.min.x )];
+				for( int y = 0; y < tileSize; ++y, src += tileSize, dst += blockWidth )
+				{
+					std::copy( src, src + tileSize, dst );
+				}
+			}
+		}
+		shadingPoints->writable()[*it] = channelData;
 	}
 
-	CompoundDataPtr result = shadingEngine->shade( shadingPoints.get() );
+	CompoundDataPtr shading = shadingEngine->shade( shadingPoints.get() );
+	shadingPoints = NULL;
 
-	// remove results that aren't suitable to become channels
-	for( CompoundDataMap::iterator it = result->writable().begin(); it != result->writable().end();  )
+	// Split the results that are suitable to become channels into
+	// individual tiles, so computeChannelData() can return them directly.
+
+	CompoundObjectPtr result = new CompoundObject;
+	for( CompoundDataMap::const_iterator it = shading->readable().begin(), eIt = shading->readable().end(); it != eIt; ++it )
 	{
-		CompoundDataMap::iterator nextIt = it; nextIt++;
-		if( !runTimeCast<FloatVectorData>( it->second ) )
+		const FloatVectorData *shadedData = runTimeCast<const FloatVectorData>( it->second.get() );
+		if( !shadedData )
 		{
-			result->writable().erase( it );
+			continue;
 		}
-		it = nextIt;
+
+		ObjectVectorPtr channelTiles = new ObjectVector;
+		for( int ty = tiles.min.y; ty <= tiles.max.y; ty += tileSize )
+		{
+			for( int tx = tiles.min.x; tx <= tiles.max.x; tx += tileSize )
+			{
+				FloatVectorDataPtr tileData = new FloatVectorData;
+				vector<float> &tile = tileData->writable();
+				tile.resize( tileSize * tileSize );
+				const float *src = &shadedData->readable()[( ty - pixelBound.min.y ) * blockWidth + ( tx - pixelBound.min.x )];
+				float *dst = &tile[0];
+				for( int y = 0; y < tileSize; ++y, src += blockWidth, dst += tileSize )
+				{
+					std::copy( src, src + tileSize, dst );
+				}
+				channelTiles->members().push_back( tileData );
+			}
+		}
+
+		result->members()[it->first] = channelTiles;
 	}
 
 	return result;
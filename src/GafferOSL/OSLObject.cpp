@@ -37,6 +37,7 @@
 #include "IECore/Primitive.h"
 
 #include "Gaffer/StringPlug.h"
+#include "Gaffer/Context.h"
 
 #include "GafferOSL/OSLShader.h"
 #include "GafferOSL/OSLObject.h"
@@ -188,13 +189,21 @@ IECore::ConstObjectPtr OSLObject::computeProcessedObject( const ScenePath &path,
 		}
 	}
 
-	PrimitivePtr outputPrimitive = inputPrimitive->copy();
-
 	ShadingEngine::Transforms transforms;
 
 	transforms[ g_world ] = ShadingEngine::Transform( inPlug()->fullTransform( path ));
 
+	// Shading is the expensive part, so this is our last
+	// chance to avoid it if we've been cancelled already.
+	Canceller::check( context->canceller() );
+
 	CompoundDataPtr shadedPoints = shadingEngine->shade( shadingPoints.get(), transforms );
+
+	// The copy is cheap, because IECore data is copy-on-write - the output
+	// shares all the untouched primitive variables with the input. The shaded
+	// data need not be copied either, since the ShadingEngine creates it with
+	// the appropriate type for use directly as primitive variables.
+	PrimitivePtr outputPrimitive = inputPrimitive->copy();
 	for( CompoundDataMap::const_iterator it = shadedPoints->readable().begin(), eIt = shadedPoints->readable().end(); it != eIt; ++it )
 	{
 		if( it->first != "Ci" )
@@ -127,7 +127,8 @@ ConstShadingEnginePtr getter( const ShadingEngineCacheKey &key, size_t &cost )
 		return NULL;
 	}
 
-	return new ShadingEngine( network );
+	// Share engines with any other nodes generating equivalent networks.
+	return ShadingEngine::get( network );
 }
 
 typedef LRUCache<ShadingEngineCacheKey, ConstShadingEnginePtr> ShadingEngineCache;
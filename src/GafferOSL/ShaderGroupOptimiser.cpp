@@ -0,0 +1,90 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2017, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//      * Redistributions of source code must retain the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer.
+//
+//      * Redistributions in binary form must reproduce the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer in the documentation and/or other materials provided with
+//        the distribution.
+//
+//      * Neither the name of John Haddon nor the names of
+//        any other contributors to this software may be used to endorse or
+//        promote products derived from this software without specific prior
+//        written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#include "tbb/task.h"
+
+#include "IECore/MessageHandler.h"
+
+#include "GafferOSL/Private/ShaderGroupOptimiser.h"
+
+using namespace OSL;
+
+namespace
+{
+
+class OptimiseTask : public tbb::task
+{
+
+	public :
+
+		OptimiseTask( ShadingSystem *shadingSystem, ShaderGroupRef shaderGroup )
+			:	m_shadingSystem( shadingSystem ), m_shaderGroup( shaderGroup )
+		{
+		}
+
+		virtual tbb::task *execute()
+		{
+			try
+			{
+				m_shadingSystem->optimize_group( m_shaderGroup.get() );
+			}
+			catch( const std::exception &e )
+			{
+				// Any problem will be encountered again when the group
+				// is executed, and reported appropriately there.
+				IECore::msg( IECore::Msg::Debug, "optimiseShaderGroupAsync", e.what() );
+			}
+			return NULL;
+		}
+
+	private :
+
+		ShadingSystem *m_shadingSystem;
+		// Holding a reference keeps the group alive until we're done,
+		// even if all other owners release it in the meantime.
+		ShaderGroupRef m_shaderGroup;
+
+};
+
+} // namespace
+
+void GafferOSL::Private::optimiseShaderGroupAsync( OSL::ShadingSystem *shadingSystem, OSL::ShaderGroupRef shaderGroup )
+{
+	// We use enqueue() rather than spawn() so that the task runs
+	// even if the calling thread never waits for it, and doesn't
+	// delay any parallel work the caller might be doing.
+	tbb::task::enqueue( *new( tbb::task::allocate_root() ) OptimiseTask( shadingSystem, shaderGroup ) );
+}
@@ -35,11 +35,15 @@
 //////////////////////////////////////////////////////////////////////////
 
 #include "tbb/spin_mutex.h"
+#include "tbb/spin_rw_mutex.h"
+#include "tbb/parallel_for.h"
+#include "tbb/task_group.h"
 
 #include "boost/algorithm/string/split.hpp"
 #include "boost/algorithm/string/predicate.hpp"
 #include "boost/algorithm/string/classification.hpp"
 #include "boost/unordered_map.hpp"
+#include "boost/noncopyable.hpp"
 
 #include "OSL/oslclosure.h"
 #include "OSL/genclosure.h"
@@ -49,6 +53,7 @@
 
 
 #include "IECore/MessageHandler.h"
+#include "IECore/LRUCache.h"
 #include "IECore/SimpleTypedData.h"
 #include "IECore/VectorTypedData.h"
 #include "IECore/Shader.h"
@@ -56,6 +61,8 @@
 
 #include "GafferImage/OpenImageIOAlgo.h"
 
+#include "GafferOSL/Private/ShaderGroupOptimiser.h"
+
 #include "GafferOSL/ShadingEngine.h"
 
 using namespace std;
@@ -230,6 +237,11 @@ class RenderState
 			return ShadingSystem::convert_value( value, type, src, it->dataView.type );
 		}
 
+		void setPointIndex( size_t pointIndex )
+		{
+			m_pointIndex = pointIndex;
+		}
+
 		void incrementPointIndex()
 		{
 			m_pointIndex++;
@@ -527,6 +539,30 @@ class ShadingResults
 
 	private :
 
+		/// \todo This is a lot like the UserData struct above - maybe we should
+		/// just have one type we can use for both?
+		struct DebugResult
+		{
+			DebugResult()
+				:	basePointer( NULL )
+			{
+			}
+
+			ustring name;
+			TypeDesc type;
+			void *basePointer;
+
+			bool operator < ( const DebugResult &rhs ) const
+			{
+				return name.c_str() < rhs.name.c_str();
+			}
+
+			bool operator < ( const ustring &rhs ) const
+			{
+				return name.c_str() < rhs.c_str();
+			}
+		};
+
 		void addResult( size_t pointIndex, const ClosureColor *closure, const Color3f &weight )
 		{
 			if( closure )
@@ -561,66 +597,94 @@ class ShadingResults
 
 		void addDebug( size_t pointIndex, const DebugParameters *parameters, const Color3f &weight )
 		{
-			vector<DebugResult>::iterator it = lower_bound(
-				m_debugResults.begin(),
-				m_debugResults.end(),
-				parameters->name
-			);
+			const DebugResult result = debugResult( parameters );
+			Color3f value = weight * parameters->value;
+
+			char *dst = static_cast<char *>( result.basePointer );
+			dst += pointIndex * result.type.elementsize();
 
-			if( it == m_debugResults.end() || it->name != parameters->name )
+			// Float results are by far the most common, and can be written
+			// directly into the final V3fVectorData, Color3fVectorData or
+			// FloatVectorData without the overhead of convert_value(), which
+			// must rediscover the types for every single point.
+			if( result.type.basetype == TypeDesc::FLOAT )
 			{
-				DebugResult result;
-				result.name = parameters->name;
-				result.type = parameters->type != ustring() ? TypeDesc( parameters->type.c_str() ) : TypeDesc::TypeColor;
-				result.type.arraylen = m_ci->size();
-				DataPtr data = dataFromTypeDesc( result.type, result.basePointer );
-				if( !data )
+				if( result.type.aggregate == TypeDesc::VEC3 )
+				{
+					*reinterpret_cast<Color3f *>( dst ) = value;
+					return;
+				}
+				else if( result.type.aggregate == TypeDesc::SCALAR )
 				{
-					throw IECore::Exception( "Unsupported type specified in debug() closure." );
+					*reinterpret_cast<float *>( dst ) = value[0];
+					return;
 				}
-				result.type.unarray(); // so we can use convert_value
-				m_results->writable()[result.name.c_str()] = data;
-				it = m_debugResults.insert( it, result );
 			}
 
-			Color3f value = weight * parameters->value;
-
-			char *dst = static_cast<char *>( it->basePointer );
-			dst += pointIndex * it->type.elementsize();
 			ShadingSystem::convert_value(
 				dst,
-				it->type,
+				result.type,
 				&value,
-				it->type.aggregate == TypeDesc::SCALAR ? TypeDesc::TypeFloat : TypeDesc::TypeColor
+				result.type.aggregate == TypeDesc::SCALAR ? TypeDesc::TypeFloat : TypeDesc::TypeColor
 			);
 		}
 
-		/// \todo This is a lot like the UserData struct above - maybe we should
-		/// just have one type we can use for both?
-		struct DebugResult
+		// Returns the DebugResult for the specified closure, creating it
+		// if necessary. Results are added to concurrently from several
+		// shading threads, so creation is serialised via m_debugResultsMutex.
+		// The data for each result covers all the points, and each thread
+		// writes only to the points it is shading, so no locking is
+		// needed when writing the values themselves.
+		DebugResult debugResult( const DebugParameters *parameters )
 		{
-			DebugResult()
-				:	basePointer( NULL )
+			DebugResultsMutex::scoped_lock lock( m_debugResultsMutex, /* write = */ false );
+			vector<DebugResult>::iterator it = lower_bound(
+				m_debugResults.begin(),
+				m_debugResults.end(),
+				parameters->name
+			);
+
+			if( it != m_debugResults.end() && it->name == parameters->name )
 			{
+				return *it;
 			}
 
-			ustring name;
-			TypeDesc type;
-			void *basePointer;
-
-			bool operator < ( const DebugResult &rhs ) const
+			if( !lock.upgrade_to_writer() )
 			{
-				return name.c_str() < rhs.name.c_str();
+				// Lock was released temporarily during the upgrade, so
+				// another thread may have created the result already.
+				it = lower_bound(
+					m_debugResults.begin(),
+					m_debugResults.end(),
+					parameters->name
+				);
+				if( it != m_debugResults.end() && it->name == parameters->name )
+				{
+					return *it;
+				}
 			}
 
-			bool operator < ( const ustring &rhs ) const
+			DebugResult result;
+			result.name = parameters->name;
+			result.type = parameters->type != ustring() ? TypeDesc( parameters->type.c_str() ) : TypeDesc::TypeColor;
+			result.type.arraylen = m_ci->size();
+			DataPtr data = dataFromTypeDesc( result.type, result.basePointer );
+			if( !data )
 			{
-				return name.c_str() < rhs.c_str();
+				throw IECore::Exception( "Unsupported type specified in debug() closure." );
 			}
-		};
+			result.type.unarray(); // so we can use convert_value
+			m_results->writable()[result.name.c_str()] = data;
+			m_debugResults.insert( it, result );
+
+			return result;
+		}
 
 		CompoundDataPtr m_results;
 		vector<Color3f> *m_ci;
+
+		typedef tbb::spin_rw_mutex DebugResultsMutex;
+		DebugResultsMutex m_debugResultsMutex;
 		vector<DebugResult> m_debugResults; // sorted on name for quick lookups
 
 };
@@ -785,44 +849,288 @@ static const T *varyingValue( const IECore::CompoundData *points, const char *na
 ShadingEngine::ShadingEngine( const IECore::ObjectVector *shaderNetwork )
 {
 	ShadingSystem *shadingSystem = ::shadingSystem();
-	ShadingSystemWriteMutex::scoped_lock shadingSystemWriteLock( g_shadingSystemWriteMutex );
 
-	m_shaderGroupRef = new ShaderGroupRef( shadingSystem->ShaderGroupBegin() );
+	{
+		ShadingSystemWriteMutex::scoped_lock shadingSystemWriteLock( g_shadingSystemWriteMutex );
+		m_shaderGroupRef = new ShaderGroupRef( shadingSystem->ShaderGroupBegin() );
 
-		for( ObjectVector::MemberContainer::const_iterator it = shaderNetwork->members().begin(), eIt = shaderNetwork->members().end(); it != eIt; ++it )
-		{
-			const Shader *shader = runTimeCast<const Shader>( it->get() );
-			if( !shader )
+			for( ObjectVector::MemberContainer::const_iterator it = shaderNetwork->members().begin(), eIt = shaderNetwork->members().end(); it != eIt; ++it )
 			{
-				continue;
+				const Shader *shader = runTimeCast<const Shader>( it->get() );
+				if( !shader )
+				{
+					continue;
+				}
+
+				declareParameters( shader->parameters(), shadingSystem );
+				const char *handle = NULL;
+				if( const StringData *handleData = shader->parametersData()->member<StringData>( "__handle" ) )
+				{
+					handle = handleData->readable().c_str();
+				}
+				else if( it == eIt - 1 )
+				{
+					handle = "gafferOSL:shadingSystem:root";
+				}
+
+				shadingSystem->Shader( "surface", shader->getName().c_str(), handle );
+				if( handle )
+				{
+					declareConnections( handle, shader->parameters(), shadingSystem );
+				}
 			}
 
-			declareParameters( shader->parameters(), shadingSystem );
-			const char *handle = NULL;
+		shadingSystem->ShaderGroupEnd();
+	}
+
+	// Start the JIT compilation now, without holding the write lock,
+	// so that it overlaps with whatever the caller does before shading.
+	GafferOSL::Private::optimiseShaderGroupAsync( shadingSystem, *static_cast<ShaderGroupRef *>( m_shaderGroupRef ) );
+}
+
+ShadingEngine::~ShadingEngine()
+{
+	delete static_cast<ShaderGroupRef *>( m_shaderGroupRef );
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Cache of ShadingEngines
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+// Computes a hash for the network which is independent of the names
+// of the shader handles, so that networks which differ only in the
+// names of the nodes they were generated from hash identically.
+IECore::MurmurHash networkHash( const IECore::ObjectVector *shaderNetwork )
+{
+	typedef boost::unordered_map<std::string, size_t> HandleIndices;
+	HandleIndices handleIndices;
+
+	const ObjectVector::MemberContainer &members = shaderNetwork->members();
+	for( size_t i = 0; i < members.size(); ++i )
+	{
+		if( const Shader *shader = runTimeCast<const Shader>( members[i].get() ) )
+		{
 			if( const StringData *handleData = shader->parametersData()->member<StringData>( "__handle" ) )
 			{
-				handle = handleData->readable().c_str();
+				handleIndices[handleData->readable()] = i;
 			}
-			else if( it == eIt - 1 )
+		}
+	}
+
+	IECore::MurmurHash h;
+	for( size_t i = 0; i < members.size(); ++i )
+	{
+		const Shader *shader = runTimeCast<const Shader>( members[i].get() );
+		if( !shader )
+		{
+			continue;
+		}
+
+		h.append( i );
+		h.append( shader->getName() );
+		h.append( shader->getType() );
+
+		const CompoundDataMap &parameters = shader->parameters();
+		for( CompoundDataMap::const_iterator it = parameters.begin(), eIt = parameters.end(); it != eIt; ++it )
+		{
+			if( it->first == "__handle" )
 			{
-				handle = "gafferOSL:shadingSystem:root";
+				continue;
 			}
 
-			shadingSystem->Shader( "surface", shader->getName().c_str(), handle );
-			if( handle )
+			h.append( it->first );
+			if( it->second->typeId() == StringDataTypeId )
 			{
-				declareConnections( handle, shader->parameters(), shadingSystem );
+				const std::string &value = static_cast<const StringData *>( it->second.get() )->readable();
+				if( boost::starts_with( value, "link:" ) )
+				{
+					const size_t dotPosition = value.find( '.' );
+					const std::string handle = value.substr( 5, dotPosition == std::string::npos ? std::string::npos : dotPosition - 5 );
+					HandleIndices::const_iterator hIt = handleIndices.find( handle );
+					if( hIt != handleIndices.end() && dotPosition != std::string::npos )
+					{
+						h.append( "link" );
+						h.append( hIt->second );
+						h.append( value.c_str() + dotPosition + 1 );
+						continue;
+					}
+				}
 			}
+			it->second->hash( h );
 		}
+	}
 
-	shadingSystem->ShaderGroupEnd();
+	return h;
 }
 
-ShadingEngine::~ShadingEngine()
+struct ShadingEngineCacheKey
 {
-	delete static_cast<ShaderGroupRef *>( m_shaderGroupRef );
+
+	ShadingEngineCacheKey()
+		:	shaderNetwork( NULL )
+	{
+	}
+
+	ShadingEngineCacheKey( const IECore::ObjectVector *n )
+		:	shaderNetwork( n ), hash( networkHash( n ) )
+	{
+	}
+
+	bool operator == ( const ShadingEngineCacheKey &other ) const
+	{
+		return hash == other.hash;
+	}
+
+	bool operator != ( const ShadingEngineCacheKey &other ) const
+	{
+		return hash != other.hash;
+	}
+
+	bool operator < ( const ShadingEngineCacheKey &other ) const
+	{
+		return hash < other.hash;
+	}
+
+	mutable const IECore::ObjectVector *shaderNetwork;
+	IECore::MurmurHash hash;
+
+};
+
+inline size_t tbb_hasher( const ShadingEngineCacheKey &cacheKey )
+{
+	return tbb_hasher( cacheKey.hash );
+}
+
+ShadingEngine::ConstPtr getter( const ShadingEngineCacheKey &key, size_t &cost )
+{
+	cost = 1;
+	ShadingEngine::ConstPtr result = new ShadingEngine( key.shaderNetwork );
+	key.shaderNetwork = NULL; // not guaranteed to exist after the call to get()
+	return result;
+}
+
+typedef LRUCache<ShadingEngineCacheKey, ShadingEngine::ConstPtr> ShadingEngineCache;
+ShadingEngineCache g_shadingEngineCache( getter, 10000 );
+
+} // namespace
+
+ShadingEngine::ConstPtr ShadingEngine::get( const IECore::ObjectVector *shaderNetwork )
+{
+	return g_shadingEngineCache.get( ShadingEngineCacheKey( shaderNetwork ) );
 }
 
+namespace
+{
+
+// Shading is relatively expensive per point, so we can afford to use
+// smaller chunks than we would for simple array operations.
+const size_t g_shadeGrainSize = 1000;
+
+// Acquires a ShadingContext for the lifetime of the object,
+// releasing it even if shading throws.
+class ShadingContextScope : boost::noncopyable
+{
+
+	public :
+
+		ShadingContextScope( ShadingSystem *shadingSystem )
+			:	m_shadingSystem( shadingSystem ), m_shadingContext( shadingSystem->get_context() )
+		{
+		}
+
+		~ShadingContextScope()
+		{
+			m_shadingSystem->release_context( m_shadingContext );
+		}
+
+		ShadingContext *shadingContext()
+		{
+			return m_shadingContext;
+		}
+
+	private :
+
+		ShadingSystem *m_shadingSystem;
+		ShadingContext *m_shadingContext;
+
+};
+
+// Shades a range of points, using its own ShadingContext, ShaderGlobals
+// and RenderState so that ranges may be processed concurrently. Each
+// range writes only to its own indices in the ShadingResults, so the
+// results are identical to those of a serial loop.
+class ShadeFunctor
+{
+
+	public :
+
+		ShadeFunctor(
+			ShadingSystem *shadingSystem, ShaderGroup &shaderGroup,
+			const ShaderGlobals &shaderGlobals, const RenderState &renderState,
+			const OSL::Vec3 *p, const float *u, const float *v, const V3f *n,
+			ShadingResults &results
+		)
+			:	m_shadingSystem( shadingSystem ), m_shaderGroup( shaderGroup ),
+				m_shaderGlobals( shaderGlobals ), m_renderState( renderState ),
+				m_p( p ), m_u( u ), m_v( v ), m_n( n ),
+				m_results( results )
+		{
+		}
+
+		void operator()( const tbb::blocked_range<size_t> &r ) const
+		{
+			ShaderGlobals shaderGlobals = m_shaderGlobals;
+
+			RenderState renderState( m_renderState );
+			renderState.setPointIndex( r.begin() );
+			shaderGlobals.renderstate = &renderState;
+
+			ShadingContextScope shadingContextScope( m_shadingSystem );
+			ShadingContext *shadingContext = shadingContextScope.shadingContext();
+
+			for( size_t i = r.begin(); i != r.end(); ++i )
+			{
+				shaderGlobals.P = m_p[i];
+				if( m_u )
+				{
+					shaderGlobals.u = m_u[i];
+				}
+				if( m_v )
+				{
+					shaderGlobals.v = m_v[i];
+				}
+				if( m_n )
+				{
+					shaderGlobals.N = m_n[i];
+				}
+
+				shaderGlobals.Ci = NULL;
+
+				m_shadingSystem->execute( shadingContext, m_shaderGroup, shaderGlobals );
+				m_results.addResult( i, shaderGlobals.Ci );
+				renderState.incrementPointIndex();
+			}
+		}
+
+	private :
+
+		ShadingSystem *m_shadingSystem;
+		ShaderGroup &m_shaderGroup;
+		const ShaderGlobals &m_shaderGlobals;
+		const RenderState &m_renderState;
+		const OSL::Vec3 *m_p;
+		const float *m_u;
+		const float *m_v;
+		const V3f *m_n;
+		ShadingResults &m_results;
+
+};
+
+} // namespace
+
 IECore::CompoundDataPtr ShadingEngine::shade( const IECore::CompoundData *points, const Transforms &transforms ) const
 {
 	// Get the data for "P" - this determines the number of points to be shaded.
@@ -868,11 +1176,11 @@ IECore::CompoundDataPtr ShadingEngine::shade( const IECore::CompoundData *points
 	shaderGlobals.dPdu = uniformValue<V3f>( points, "dPdu" );
 	shaderGlobals.dPdv = uniformValue<V3f>( points, "dPdv" );
 
-	// Add a RenderState to the ShaderGlobals. This will
-	// get passed to our RendererServices queries.
+	// Create a RenderState to be passed to our RendererServices
+	// queries. Each chunk of points gets its own copy of this,
+	// so that the point index can be tracked independently.
 
-	RenderState renderState( points, transforms );
-	shaderGlobals.renderstate = &renderState;
+	const RenderState renderState( points, transforms );
 
 	// Get pointers to varying data, we'll use these to
 	// update the shaderGlobals as we iterate over our points.
@@ -887,35 +1195,17 @@ IECore::CompoundDataPtr ShadingEngine::shade( const IECore::CompoundData *points
 
 	ShadingResults results( numPoints );
 
-	// Iterate over the input points, doing the shading as we go
+	// Iterate over the input points in parallel, doing the shading as we go.
+	// We use an isolated task_group_context so that cancellation or exceptions
+	// in any outer parallel work (for instance, another compute in progress
+	// on the same thread) are not propagated into our shading tasks.
 
 	ShadingSystem *shadingSystem = ::shadingSystem();
-	ShadingContext *shadingContext = shadingSystem->get_context();
 	ShaderGroup &shaderGroup = **static_cast<ShaderGroupRef *>( m_shaderGroupRef );
-	for( size_t i = 0; i < numPoints; ++i )
-	{
-		shaderGlobals.P = *p++;
-		if( u )
-		{
-			shaderGlobals.u = *u++;
-		}
-		if( v )
-		{
-			shaderGlobals.v = *v++;
-		}
-		if( n )
-		{
-			shaderGlobals.N = *n++;
-		}
-
-		shaderGlobals.Ci = NULL;
-
-		shadingSystem->execute( shadingContext, shaderGroup, shaderGlobals );
-		results.addResult( i, shaderGlobals.Ci );
-		renderState.incrementPointIndex();
-	}
 
-	shadingSystem->release_context( shadingContext );
+	ShadeFunctor functor( shadingSystem, shaderGroup, shaderGlobals, renderState, p, u, v, n, results );
+	tbb::task_group_context taskGroupContext( tbb::task_group_context::isolated );
+	tbb::parallel_for( tbb::blocked_range<size_t>( 0, numPoints, g_shadeGrainSize ), functor, taskGroupContext );
 
 	return results.results();
 }
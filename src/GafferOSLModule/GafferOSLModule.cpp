@@ -159,6 +159,11 @@ IECore::CompoundDataPtr shadeWrapper( ShadingEngine &shadingEngine, const IECore
 	return shadingEngine.shade( points, transforms );
 }
 
+ShadingEnginePtr shadingEngineGet( const IECore::ObjectVector *shaderNetwork )
+{
+	return boost::const_pointer_cast<ShadingEngine>( ShadingEngine::get( shaderNetwork ) );
+}
+
 } // namespace
 
 BOOST_PYTHON_MODULE( _GafferOSL )
@@ -190,6 +195,7 @@ BOOST_PYTHON_MODULE( _GafferOSL )
 					boost::python::arg( "transforms" ) = boost::python::dict()
 				)
 			)
+			.def( "get", &shadingEngineGet ).staticmethod( "get" )
 		;
 
 		class_<ShadingEngine::Transform>( "Transform" )
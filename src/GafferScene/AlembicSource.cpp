@@ -35,9 +35,12 @@
 //
 //////////////////////////////////////////////////////////////////////////
 
+#include "tbb/enumerable_thread_specific.h"
+#include "tbb/atomic.h"
+
 #include "boost/bind.hpp"
+#include "boost/unordered_map.hpp"
 
-#include "IECore/LRUCache.h"
 #include "IECore/Renderable.h"
 
 #include "Gaffer/Context.h"
@@ -54,32 +57,124 @@ using namespace GafferScene;
 IE_CORE_DEFINERUNTIMETYPED( AlembicSource );
 
 //////////////////////////////////////////////////////////////////////////
-// Implementation of an LRUCache of FileIndexedIOs.
+// Per-thread caches of AlembicInputs.
 //////////////////////////////////////////////////////////////////////////
 
-namespace GafferScene
+namespace
 {
 
-namespace Detail
+// Alembic serialises all reads made through a single archive, so sharing
+// one AlembicInput per file between all threads limits us to reading one
+// location at a time. Instead, each thread opens its own archive for each
+// file it reads, which the Ogawa backend supports via independent streams.
+// Each thread also caches the inputs for the locations it visits, so that
+// a location can be found from its parent rather than by resolving the
+// whole path from the root.
+class ThreadInputs
 {
 
-AlembicInputPtr alembicInputGetter( const std::string &fileName, size_t &cost )
-{
-	cost = 1;
-	return new AlembicInput( fileName );
-}
+	public :
 
-typedef LRUCache<std::string, AlembicInputPtr> AlembicInputCache;
+		ThreadInputs()
+		{
+			clearRequested = 0;
+		}
 
-AlembicInputCache *alembicInputCache()
-{
-	static AlembicInputCache *c = new AlembicInputCache( alembicInputGetter, 200 );
-	return c;
-}
+		AlembicInputPtr input( const std::string &fileName, const ScenePlug::ScenePath &path )
+		{
+			if( clearRequested )
+			{
+				m_roots.clear();
+				m_inputs.clear();
+				clearRequested = 0;
+			}
+			return inputInternal( fileName, path, path.size() );
+		}
+
+		// Flag to request that the per-thread caches are cleared.
+		// We can't clear them directly from another thread, because
+		// they may be in use.
+		tbb::atomic<int> clearRequested;
+
+	private :
+
+		// Returns the input for the first `size` elements of `path`.
+		AlembicInputPtr inputInternal( const std::string &fileName, const ScenePlug::ScenePath &path, size_t size )
+		{
+			if( !size )
+			{
+				return root( fileName );
+			}
+
+			MurmurHash key;
+			key.append( fileName );
+			key.append( (uint64_t)size );
+			for( size_t i = 0; i < size; ++i )
+			{
+				key.append( path[i] );
+			}
+
+			Inputs::const_iterator it = m_inputs.find( key );
+			if( it != m_inputs.end() )
+			{
+				return it->second;
+			}
+
+			AlembicInputPtr parent = inputInternal( fileName, path, size - 1 );
+			AlembicInputPtr result = parent->child( path[size-1].value() );
+
+			if( m_inputs.size() >= g_maxInputs )
+			{
+				// Prevent unbounded growth. Inputs are cheap to
+				// find again from the root.
+				m_inputs.clear();
+			}
+			m_inputs[key] = result;
+			return result;
+		}
+
+		AlembicInputPtr root( const std::string &fileName )
+		{
+			for( Roots::iterator it = m_roots.begin(), eIt = m_roots.end(); it != eIt; ++it )
+			{
+				if( it->first == fileName )
+				{
+					return it->second;
+				}
+			}
+
+			if( m_roots.size() >= g_maxRoots )
+			{
+				// Close the archives for all files, which also
+				// requires us to forget their locations.
+				m_roots.clear();
+				m_inputs.clear();
+			}
+
+			AlembicInputPtr result = new AlembicInput( fileName );
+			m_roots.push_back( Root( fileName, result ) );
+			return result;
+		}
+
+		typedef std::pair<std::string, AlembicInputPtr> Root;
+		typedef std::vector<Root> Roots;
+		Roots m_roots;
 
-} // namespace Detail
+		typedef boost::unordered_map<MurmurHash, AlembicInputPtr> Inputs;
+		Inputs m_inputs;
 
-} // namespace GafferScene
+		static const size_t g_maxRoots;
+		static const size_t g_maxInputs;
+
+};
+
+const size_t ThreadInputs::g_maxRoots = 16;
+const size_t ThreadInputs::g_maxInputs = 10000;
+
+typedef tbb::enumerable_thread_specific<ThreadInputs, tbb::cache_aligned_allocator<ThreadInputs>, tbb::ets_key_per_instance> ThreadInputsContainer;
+ThreadInputsContainer g_threadInputs;
+
+} // namespace
 
 //////////////////////////////////////////////////////////////////////////
 // AlembicSource implementation
@@ -87,8 +182,6 @@ AlembicInputCache *alembicInputCache()
 
 size_t AlembicSource::g_firstPlugIndex = 0;
 
-using namespace GafferScene::Detail;
-
 AlembicSource::AlembicSource( const std::string &name )
 	:	SceneNode( name )
 {
@@ -139,7 +232,10 @@ void AlembicSource::plugSet( Gaffer::Plug *plug )
 {
 	if( plug == refreshCountPlug() )
 	{
-		alembicInputCache()->clear();
+		for( ThreadInputsContainer::iterator it = g_threadInputs.begin(), eIt = g_threadInputs.end(); it != eIt; ++it )
+		{
+			it->clearRequested = 1;
+		}
 	}
 }
 
@@ -179,7 +275,7 @@ void AlembicSource::hashTransform( const ScenePath &path, const Gaffer::Context
 	refreshCountPlug()->hash( h );
 
 	h.append( &(path[0]), path.size() );
-	h.append( context->getTime() );
+	appendTime( path, context, h );
 }
 
 Imath::M44f AlembicSource::computeTransform( const ScenePath &path, const Gaffer::Context *context, const ScenePlug *parent ) const
@@ -201,7 +297,7 @@ Imath::M44f AlembicSource::computeTransform( const ScenePath &path, const Gaffer
 
 void AlembicSource::hashAttributes( const ScenePath &path, const Gaffer::Context *context, const ScenePlug *parent, IECore::MurmurHash &h ) const
 {
-	h = parent->attributesPlug()->defaultValue()->Object::hash();
+	h = parent->attributesPlug()->defaultHash();
 }
 
 IECore::ConstCompoundObjectPtr AlembicSource::computeAttributes( const ScenePath &path, const Gaffer::Context *context, const ScenePlug *parent ) const
@@ -218,7 +314,7 @@ void AlembicSource::hashObject( const ScenePath &path, const Gaffer::Context *co
 	refreshCountPlug()->hash( h );
 
 	h.append( &(path[0]), path.size() );
-	h.append( context->getTime() );
+	appendTime( path, context, h );
 }
 
 IECore::ConstObjectPtr AlembicSource::computeObject( const ScenePath &path, const Gaffer::Context *context, const ScenePlug *parent ) const
@@ -263,7 +359,7 @@ IECore::ConstInternedStringVectorDataPtr AlembicSource::computeChildNames( const
 
 void AlembicSource::hashGlobals( const Gaffer::Context *context, const ScenePlug *parent, IECore::MurmurHash &h ) const
 {
-	h = parent->globalsPlug()->defaultValue()->Object::hash();
+	h = parent->globalsPlug()->defaultHash();
 }
 
 IECore::ConstCompoundObjectPtr AlembicSource::computeGlobals( const Gaffer::Context *context, const ScenePlug *parent ) const
@@ -273,7 +369,7 @@ IECore::ConstCompoundObjectPtr AlembicSource::computeGlobals( const Gaffer::Cont
 
 void AlembicSource::hashSetNames( const Gaffer::Context *context, const ScenePlug *parent, IECore::MurmurHash &h ) const
 {
-	h = parent->setNamesPlug()->defaultValue()->Object::hash();
+	h = parent->setNamesPlug()->defaultHash();
 }
 
 IECore::ConstInternedStringVectorDataPtr AlembicSource::computeSetNames( const Gaffer::Context *context, const ScenePlug *parent ) const
@@ -283,7 +379,7 @@ IECore::ConstInternedStringVectorDataPtr AlembicSource::computeSetNames( const G
 
 void AlembicSource::hashSet( const IECore::InternedString &setName, const Gaffer::Context *context, const ScenePlug *parent, IECore::MurmurHash &h ) const
 {
-	h = parent->setPlug()->defaultValue()->Object::hash();
+	h = parent->setPlug()->defaultHash();
 }
 
 GafferScene::ConstPathMatcherDataPtr AlembicSource::computeSet( const IECore::InternedString &setName, const Gaffer::Context *context, const ScenePlug *parent ) const
@@ -300,11 +396,20 @@ IECoreAlembic::AlembicInputPtr AlembicSource::inputForPath( const ScenePath &pat
 		return NULL;
 	}
 
-	AlembicInputPtr result = Detail::alembicInputCache()->get( fileName );
-	for( ScenePath::const_iterator it = path.begin(), eIt = path.end(); it != eIt; it++ )
+	return g_threadInputs.local().input( fileName, path );
+}
+
+void AlembicSource::appendTime( const ScenePath &path, const Gaffer::Context *context, IECore::MurmurHash &h ) const
+{
+	if( AlembicInputPtr i = inputForPath( path ) )
 	{
-		result = result->child( it->value() );
+		if( i->numSamples() <= 1 )
+		{
+			// The value is the same at all times, so we omit the time
+			// from the hash. This lets the compute cache reuse a single
+			// read across all frames.
+			return;
+		}
 	}
-
-	return result;
+	h.append( context->getTime() );
 }
@@ -0,0 +1,220 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2017, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//      * Redistributions of source code must retain the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer.
+//
+//      * Redistributions in binary form must reproduce the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer in the documentation and/or other materials provided with
+//        the distribution.
+//
+//      * Neither the name of John Haddon nor the names of
+//        any other contributors to this software may be used to endorse or
+//        promote products derived from this software without specific prior
+//        written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+
+#include "boost/filesystem.hpp"
+#include "boost/functional/hash.hpp"
+
+#include "IECore/SceneInterface.h"
+#include "IECore/SampledSceneInterface.h"
+#include "IECore/SimpleTypedData.h"
+
+#include "Gaffer/Private/IECorePreview/LRUCache.h"
+
+#include "GafferScene/ArchiveAlgo.h"
+
+using namespace std;
+using namespace Imath;
+using namespace IECore;
+using namespace GafferScene;
+
+//////////////////////////////////////////////////////////////////////////
+// Internal utilities
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+std::time_t modificationTime( const std::string &fileName )
+{
+	boost::system::error_code ec;
+	const std::time_t result = boost::filesystem::last_write_time( fileName, ec );
+	if( ec )
+	{
+		throw IECore::IOException( "File \"" + fileName + "\" does not exist" );
+	}
+	return result;
+}
+
+std::string extension( const std::string &fileName )
+{
+	const std::string e = boost::filesystem::path( fileName ).extension().string();
+	return e.size() ? e.substr( 1 ) : e;
+}
+
+IECore::CompoundDataPtr readSceneInterfaceMetadata( const std::string &fileName )
+{
+	ConstSceneInterfacePtr scene = SceneInterface::create( fileName, IndexedIO::Read );
+
+	CompoundDataPtr result = new CompoundData;
+	if( scene->hasBound() )
+	{
+		// Procedurals are given a single bound, so we take the
+		// union of all samples to cover the whole animation.
+		Box3d bound;
+		if( const SampledSceneInterface *sampledScene = runTimeCast<const SampledSceneInterface>( scene.get() ) )
+		{
+			for( size_t i = 0, n = sampledScene->numBoundSamples(); i < n; ++i )
+			{
+				bound.extendBy( sampledScene->readBoundAtSample( i ) );
+			}
+		}
+		else
+		{
+			bound = scene->readBound( 0 );
+		}
+		if( !bound.isEmpty() )
+		{
+			result->writable()["bound"] = new Box3fData( Box3f( bound.min, bound.max ) );
+		}
+	}
+
+	return result;
+}
+
+typedef std::map<std::string, ArchiveAlgo::MetadataReader> Readers;
+
+Readers &readers()
+{
+	static Readers r;
+	return r;
+}
+
+const ArchiveAlgo::MetadataReader *reader( const std::string &fileName )
+{
+	const std::string e = extension( fileName );
+
+	const Readers &r = readers();
+	Readers::const_iterator it = r.find( e );
+	if( it != r.end() )
+	{
+		return &it->second;
+	}
+
+	static const std::vector<std::string> sceneInterfaceExtensions = SceneInterface::supportedExtensions();
+	if( std::find( sceneInterfaceExtensions.begin(), sceneInterfaceExtensions.end(), e ) != sceneInterfaceExtensions.end() )
+	{
+		static const ArchiveAlgo::MetadataReader sceneInterfaceReader( readSceneInterfaceMetadata );
+		return &sceneInterfaceReader;
+	}
+
+	return NULL;
+}
+
+// Keyed by file name and modification time, so that stale
+// entries are simply never requested again, and age out of
+// the cache naturally.
+typedef std::pair<std::string, std::time_t> MetadataCacheKey;
+typedef IECorePreview::LRUCache<MetadataCacheKey, ConstCompoundDataPtr> MetadataCache;
+
+ConstCompoundDataPtr metadataGetter( const MetadataCacheKey &key, size_t &cost )
+{
+	cost = 1;
+	// Only called for files we've already found a reader for.
+	return (*reader( key.first ))( key.first );
+}
+
+MetadataCache &metadataCache()
+{
+	static MetadataCache c( metadataGetter, 10000 );
+	return c;
+}
+
+} // namespace
+
+//////////////////////////////////////////////////////////////////////////
+// Implementation of public API
+//////////////////////////////////////////////////////////////////////////
+
+namespace GafferScene
+{
+
+namespace ArchiveAlgo
+{
+
+void registerMetadataReader( const std::string &extension, MetadataReader reader )
+{
+	readers()[extension] = reader;
+}
+
+IECore::ConstCompoundDataPtr metadata( const std::string &fileName )
+{
+	if( !reader( fileName ) )
+	{
+		return NULL;
+	}
+	return metadataCache().get( MetadataCacheKey( fileName, modificationTime( fileName ) ) );
+}
+
+Imath::Box3f bound( const std::string &fileName )
+{
+	ConstCompoundDataPtr m = metadata( fileName );
+	if( !m )
+	{
+		return Box3f();
+	}
+
+	const Box3fData *b = m->member<Box3fData>( "bound" );
+	return b ? b->readable() : Box3f();
+}
+
+void hash( const std::string &fileName, IECore::MurmurHash &h )
+{
+	h.append( fileName );
+	boost::system::error_code ec;
+	const std::time_t time = boost::filesystem::last_write_time( fileName, ec );
+	h.append( (uint64_t)( ec ? 0 : time ) );
+}
+
+size_t getMetadataCacheSizeLimit()
+{
+	return metadataCache().getMaxCost();
+}
+
+void setMetadataCacheSizeLimit( size_t maxEntries )
+{
+	metadataCache().setMaxCost( maxEntries );
+}
+
+void clearMetadataCache()
+{
+	metadataCache().clear();
+}
+
+} // namespace ArchiveAlgo
+
+} // namespace GafferScene
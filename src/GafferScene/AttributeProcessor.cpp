@@ -127,8 +127,12 @@ IECore::ConstCompoundObjectPtr AttributeProcessor::computeProcessedAttributes( c
 	const std::string names = namesPlug()->getValue();
 	const bool invert = invertNamesPlug()->getValue();
 
-	CompoundObjectPtr result = new CompoundObject;
-	for( CompoundObject::ObjectMap::const_iterator it = inputAttributes->members().begin(), eIt = inputAttributes->members().end(); it != eIt; ++it )
+	// We only make a new CompoundObject when we find the first attribute
+	// that is actually modified, so that locations we don't change share
+	// the input attributes rather than paying for a copy.
+	const CompoundObject::ObjectMap &inputMembers = inputAttributes->members();
+	CompoundObjectPtr result;
+	for( CompoundObject::ObjectMap::const_iterator it = inputMembers.begin(), eIt = inputMembers.end(); it != eIt; ++it )
 	{
 		ConstObjectPtr attribute = it->second;
 		if( StringAlgo::matchMultiple( it->first, names ) != invert )
@@ -136,9 +140,21 @@ IECore::ConstCompoundObjectPtr AttributeProcessor::computeProcessedAttributes( c
 			attribute = processAttribute( path, context, it->first, attribute.get() );
 		}
 
+		if( !result )
+		{
+			if( attribute.get() == it->second.get() )
+			{
+				continue;
+			}
+			result = new CompoundObject;
+			result->members().insert( inputMembers.begin(), it );
+		}
+
 		if( attribute )
 		{
+			// Members are visited in order, so we can insert at the end.
 			result->members().insert(
+				result->members().end(),
 				CompoundObject::ObjectMap::value_type(
 					it->first,
 					// cast is ok - result is const immediately on
@@ -150,5 +166,10 @@ IECore::ConstCompoundObjectPtr AttributeProcessor::computeProcessedAttributes( c
 		}
 	}
 
+	if( !result )
+	{
+		return inputAttributes;
+	}
+
 	return result;
 }
@@ -185,14 +185,43 @@ IECore::ConstCompoundObjectPtr Attributes::computeProcessedAttributes( const Sce
 		return inputAttributes;
 	}
 
+	// When the attributes don't vary with context, this is computed
+	// once and shared by every location, rather than evaluating every
+	// member plug per location.
+	ConstCompoundDataPtr newAttributesData = ap->compoundData();
+	const CompoundDataMap &newAttributes = newAttributesData->readable();
+
+	// If we wouldn't change anything, then we can avoid the cost of copying
+	// the input attributes completely. This is common when an attribute is
+	// specified redundantly in a chain of nodes, or all our attributes are
+	// disabled.
+	const CompoundObject::ObjectMap &inputMembers = inputAttributes->members();
+	bool modified = false;
+	for( CompoundDataMap::const_iterator it = newAttributes.begin(), eIt = newAttributes.end(); it != eIt; ++it )
+	{
+		CompoundObject::ObjectMap::const_iterator inputIt = inputMembers.find( it->first );
+		if( inputIt == inputMembers.end() || !inputIt->second->isEqualTo( it->second.get() ) )
+		{
+			modified = true;
+			break;
+		}
+	}
+
+	if( !modified )
+	{
+		return inputAttributes;
+	}
+
 	CompoundObjectPtr result = new CompoundObject;
 	// Since we're not going to modify any existing members (only add new ones),
 	// and our result becomes const on returning it, we can directly reference
 	// the input members in our result without copying. Be careful not to modify
 	// them though!
-	result->members() = inputAttributes->members();
-
-	ap->fillCompoundObject( result->members() );
+	result->members() = inputMembers;
+	for( CompoundDataMap::const_iterator it = newAttributes.begin(), eIt = newAttributes.end(); it != eIt; ++it )
+	{
+		result->members()[it->first] = it->second;
+	}
 
 	return result;
 }
@@ -399,7 +399,7 @@ void BranchCreator::hashSet( const IECore::InternedString &setName, const Gaffer
 
 	SceneProcessor::hashSet( setName, context, parent, h );
 	h.append( inPlug()->setHash( setName ) );
-	mapping->hash( h );
+	mappingPlug()->hash( h );
 	h.append( branchSetHash );
 }
 
@@ -0,0 +1,150 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2017, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//      * Redistributions of source code must retain the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer.
+//
+//      * Redistributions in binary form must reproduce the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer in the documentation and/or other materials provided with
+//        the distribution.
+//
+//      * Neither the name of John Haddon nor the names of
+//        any other contributors to this software may be used to endorse or
+//        promote products derived from this software without specific prior
+//        written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#include "IECore/Renderer.h"
+#include "IECore/Exception.h"
+
+#include "GafferScene/Capsule.h"
+#include "GafferScene/SceneProcedural.h"
+
+using namespace std;
+using namespace Imath;
+using namespace IECore;
+using namespace Gaffer;
+using namespace GafferScene;
+
+IE_CORE_DEFINEOBJECTTYPEDESCRIPTION( Capsule );
+
+Capsule::Capsule()
+	:	m_scene( NULL ), m_context( new Context() )
+{
+}
+
+Capsule::Capsule( const ScenePlug *scene, const ScenePlug::ScenePath &root, const Gaffer::Context &context, const IECore::MurmurHash &hash, const Imath::Box3f &bound )
+	:	m_hash( hash ), m_scene( scene ), m_root( root ), m_context( new Context( context ) ), m_bound( bound )
+{
+}
+
+Capsule::~Capsule()
+{
+}
+
+bool Capsule::isEqualTo( const IECore::Object *other ) const
+{
+	if( !VisibleRenderable::isEqualTo( other ) )
+	{
+		return false;
+	}
+
+	const Capsule *capsule = static_cast<const Capsule *>( other );
+	return m_scene == capsule->m_scene && m_hash == capsule->m_hash;
+}
+
+void Capsule::hash( IECore::MurmurHash &h ) const
+{
+	VisibleRenderable::hash( h );
+	h.append( m_hash );
+}
+
+void Capsule::copyFrom( const IECore::Object *other, IECore::Object::CopyContext *context )
+{
+	VisibleRenderable::copyFrom( other, context );
+	const Capsule *capsule = static_cast<const Capsule *>( other );
+	m_hash = capsule->m_hash;
+	m_scene = capsule->m_scene;
+	m_root = capsule->m_root;
+	m_context = capsule->m_context;
+	m_bound = capsule->m_bound;
+}
+
+void Capsule::save( IECore::Object::SaveContext *context ) const
+{
+	throw IECore::NotImplementedException( "Capsule::save" );
+}
+
+void Capsule::load( IECore::Object::LoadContextPtr context )
+{
+	throw IECore::NotImplementedException( "Capsule::load" );
+}
+
+void Capsule::memoryUsage( IECore::Object::MemoryAccumulator &accumulator ) const
+{
+	VisibleRenderable::memoryUsage( accumulator );
+	accumulator.accumulate( sizeof( Capsule ) + m_root.capacity() * sizeof( InternedString ) );
+}
+
+void Capsule::render( IECore::Renderer *renderer ) const
+{
+	if( !m_scene )
+	{
+		return;
+	}
+
+	// The transform and attributes for the root itself have
+	// already been output by whoever is rendering us, so we
+	// only need to output the children.
+	Context::Scope scopedContext( m_context.get() );
+	ConstInternedStringVectorDataPtr childNamesData = m_scene->childNames( m_root );
+	const vector<InternedString> &childNames = childNamesData->readable();
+
+	ScenePlug::ScenePath childPath( m_root );
+	childPath.push_back( InternedString() ); // room for the child name
+	for( vector<InternedString>::const_iterator it = childNames.begin(), eIt = childNames.end(); it != eIt; ++it )
+	{
+		childPath.back() = *it;
+		renderer->procedural( new SceneProcedural( m_scene, m_context.get(), childPath ) );
+	}
+}
+
+Imath::Box3f Capsule::bound() const
+{
+	return m_bound;
+}
+
+const ScenePlug *Capsule::scene() const
+{
+	return m_scene;
+}
+
+const ScenePlug::ScenePath &Capsule::root() const
+{
+	return m_root;
+}
+
+const Gaffer::Context *Capsule::context() const
+{
+	return m_context.get();
+}
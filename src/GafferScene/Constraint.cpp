@@ -35,6 +35,7 @@
 //////////////////////////////////////////////////////////////////////////
 
 #include "Gaffer/StringPlug.h"
+#include "Gaffer/Context.h"
 
 #include "GafferScene/Constraint.h"
 
@@ -54,6 +55,7 @@ Constraint::Constraint( const std::string &name )
 	addChild( new StringPlug( "target" ) );
 	addChild( new IntPlug( "targetMode", Plug::In, Origin, Origin, BoundCenter ) );
 	addChild( new V3fPlug( "targetOffset" ) );
+	addChild( new M44fPlug( "__fullTargetTransform", Plug::Out ) );
 
 	// Pass through things we don't want to modify
 	outPlug()->attributesPlug()->setInput( inPlug()->attributesPlug() );
@@ -94,6 +96,16 @@ const Gaffer::V3fPlug *Constraint::targetOffsetPlug() const
 	return getChild<Gaffer::V3fPlug>( g_firstPlugIndex + 2 );
 }
 
+Gaffer::M44fPlug *Constraint::fullTargetTransformPlug()
+{
+	return getChild<Gaffer::M44fPlug>( g_firstPlugIndex + 3 );
+}
+
+const Gaffer::M44fPlug *Constraint::fullTargetTransformPlug() const
+{
+	return getChild<Gaffer::M44fPlug>( g_firstPlugIndex + 3 );
+}
+
 void Constraint::affects( const Gaffer::Plug *input, AffectedPlugsContainer &outputs ) const
 {
 	SceneElementProcessor::affects( input, outputs );
@@ -102,6 +114,15 @@ void Constraint::affects( const Gaffer::Plug *input, AffectedPlugsContainer &out
 		input == targetPlug() ||
 		input == targetModePlug() ||
 		input->parent<Plug>() == targetOffsetPlug() ||
+		input == inPlug()->transformPlug() ||
+		input == inPlug()->boundPlug()
+	)
+	{
+		outputs.push_back( fullTargetTransformPlug() );
+	}
+
+	if(
+		input == fullTargetTransformPlug() ||
 		// TypeId comparison is necessary to avoid calling pure virtual
 		// if we're called before being fully constructed.
 		( typeId() != staticTypeId() && affectsConstraint( input ) )
@@ -112,6 +133,67 @@ void Constraint::affects( const Gaffer::Plug *input, AffectedPlugsContainer &out
 	}
 }
 
+void Constraint::hash( const Gaffer::ValuePlug *output, const Gaffer::Context *context, IECore::MurmurHash &h ) const
+{
+	SceneElementProcessor::hash( output, context, h );
+
+	if( output == fullTargetTransformPlug() )
+	{
+		ScenePath targetPath;
+		tokenizeTargetPath( targetPath );
+		h.append( inPlug()->fullTransformHash( targetPath ) );
+
+		const TargetMode targetMode = (TargetMode)targetModePlug()->getValue();
+		h.append( targetMode );
+		if( targetMode != Origin )
+		{
+			h.append( inPlug()->boundHash( targetPath ) );
+		}
+
+		targetOffsetPlug()->hash( h );
+	}
+}
+
+void Constraint::compute( Gaffer::ValuePlug *output, const Gaffer::Context *context ) const
+{
+	if( output == fullTargetTransformPlug() )
+	{
+		ScenePath targetPath;
+		tokenizeTargetPath( targetPath );
+		M44f fullTargetTransform = inPlug()->fullTransform( targetPath );
+
+		const TargetMode targetMode = (TargetMode)targetModePlug()->getValue();
+		if( targetMode != Origin )
+		{
+			const Box3f targetBound = inPlug()->bound( targetPath );
+			if( !targetBound.isEmpty() )
+			{
+				switch( targetMode )
+				{
+					case BoundMin :
+						fullTargetTransform.translate( targetBound.min );
+						break;
+					case BoundMax :
+						fullTargetTransform.translate( targetBound.max );
+						break;
+					case BoundCenter :
+						fullTargetTransform.translate( targetBound.center() );
+						break;
+					default :
+						break;
+				}
+			}
+		}
+
+		fullTargetTransform.translate( targetOffsetPlug()->getValue() );
+
+		static_cast<M44fPlug *>( output )->setValue( fullTargetTransform );
+		return;
+	}
+
+	SceneElementProcessor::compute( output, context );
+}
+
 bool Constraint::processesTransform() const
 {
 	return true;
@@ -123,19 +205,12 @@ void Constraint::hashProcessedTransform( const ScenePath &path, const Gaffer::Co
 	parentPath.pop_back();
 	h.append( inPlug()->fullTransformHash( parentPath ) );
 
-	ScenePath targetPath;
-	tokenizeTargetPath( targetPath );
-	h.append( inPlug()->fullTransformHash( targetPath ) );
-
-	const TargetMode targetMode = (TargetMode)targetModePlug()->getValue();
-	h.append( targetMode );
-	if( targetMode != Origin )
 	{
-		h.append( inPlug()->boundHash( targetPath ) );
+		Context::EditableScope scope( context );
+		scope.remove( ScenePlug::scenePathContextName );
+		fullTargetTransformPlug()->hash( h );
 	}
 
-	targetOffsetPlug()->hash( h );
-
 	hashConstraint( context, h );
 }
 
@@ -147,35 +222,13 @@ Imath::M44f Constraint::computeProcessedTransform( const ScenePath &path, const
 	const M44f parentTransform = inPlug()->fullTransform( parentPath );
 	const M44f fullInputTransform = inputTransform * parentTransform;
 
-	ScenePath targetPath;
-	tokenizeTargetPath( targetPath );
-	M44f fullTargetTransform = inPlug()->fullTransform( targetPath );
-
-	const TargetMode targetMode = (TargetMode)targetModePlug()->getValue();
-	if( targetMode != Origin )
+	M44f fullTargetTransform;
 	{
-		const Box3f targetBound = inPlug()->bound( targetPath );
-		if( !targetBound.isEmpty() )
-		{
-			switch( targetMode )
-			{
-				case BoundMin :
-					fullTargetTransform.translate( targetBound.min );
-					break;
-				case BoundMax :
-					fullTargetTransform.translate( targetBound.max );
-					break;
-				case BoundCenter :
-					fullTargetTransform.translate( targetBound.center() );
-					break;
-				default :
-					break;
-			}
-		}
+		Context::EditableScope scope( context );
+		scope.remove( ScenePlug::scenePathContextName );
+		fullTargetTransform = fullTargetTransformPlug()->getValue();
 	}
 
-	fullTargetTransform.translate( targetOffsetPlug()->getValue() );
-
 	const M44f fullConstrainedTransform = computeConstraint( fullTargetTransform, fullInputTransform, inputTransform );
 	return fullConstrainedTransform * parentTransform.inverse();
 }
@@ -70,13 +70,12 @@ void CopyOptions::hashProcessedGlobals( const Gaffer::Context *context, IECore::
 
 IECore::ConstCompoundObjectPtr CopyOptions::computeProcessedGlobals( const Gaffer::Context *context, IECore::ConstCompoundObjectPtr inputGlobals ) const
 {
-
-	IECore::CompoundObjectPtr result = new IECore::CompoundObject;
-	// Since we're not going to modify any existing members (only add new ones),
-	// and our result becomes const on returning it, we can directly reference
-	// the input members in our result without copying. Be careful not to modify
-	// them though!
-	result->members() = inputGlobals->members();
+	// As for Options, we only make a new CompoundObject once we know
+	// we have something to copy. Since we're not going to modify any
+	// existing members (only add new ones), and our result becomes const
+	// on returning it, we can directly reference the input members in
+	// our result without copying. Be careful not to modify them though!
+	IECore::CompoundObjectPtr result;
 
 	// copy matching options
 	const std::string prefix = "option:";
@@ -89,10 +88,20 @@ IECore::ConstCompoundObjectPtr CopyOptions::computeProcessedGlobals( const Gaffe
 		{
 			if( StringAlgo::matchMultiple( it->first.c_str() + prefix.size(), names.c_str() ) )
 			{
+				if( !result )
+				{
+					result = new IECore::CompoundObject;
+					result->members() = inputGlobals->members();
+				}
 				result->members()[it->first] = it->second;
 			}
 		}
 	}
 
+	if( !result )
+	{
+		return inputGlobals;
+	}
+
 	return result;
 }
@@ -118,6 +118,7 @@ IECore::ConstCompoundObjectPtr DeleteGlobals::computeProcessedGlobals( const Gaf
 	const std::string prefix = namePrefix();
 
 	IECore::CompoundObjectPtr result = new IECore::CompoundObject;
+	bool deleted = false;
 	for( IECore::CompoundObject::ObjectMap::const_iterator it = inputGlobals->members().begin(), eIt = inputGlobals->members().end(); it != eIt; ++it )
 	{
 		bool keep = true;
@@ -130,8 +131,21 @@ IECore::ConstCompoundObjectPtr DeleteGlobals::computeProcessedGlobals( const Gaf
 		}
 		if( keep )
 		{
-			result->members()[it->first] = it->second;
+			// Inserting at the end is constant time, because
+			// we're iterating the input in sorted order.
+			result->members().insert( result->members().end(), *it );
 		}
+		else
+		{
+			deleted = true;
+		}
+	}
+
+	if( !deleted )
+	{
+		// Pass through the input, so that downstream nodes
+		// see an identical object.
+		return inputGlobals;
 	}
 
 	return result;
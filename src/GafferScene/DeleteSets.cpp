@@ -138,11 +138,11 @@ void DeleteSets::hashSet( const IECore::InternedString &setName, const Gaffer::C
 	const bool invert = invertNamesPlug()->getValue();
 	if( StringAlgo::matchMultiple( setName, names ) != (!invert) )
 	{
-		h = inPlug()->setPlug()->getValue()->Object::hash();
+		h = inPlug()->setPlug()->hash();
 	}
 	else
 	{
-		h = inPlug()->setPlug()->defaultValue()->Object::hash();
+		h = inPlug()->setPlug()->defaultHash();
 	}
 }
 
@@ -0,0 +1,237 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2017, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//      * Redistributions of source code must retain the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer.
+//
+//      * Redistributions in binary form must reproduce the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer in the documentation and/or other materials provided with
+//        the distribution.
+//
+//      * Neither the name of John Haddon nor the names of
+//        any other contributors to this software may be used to endorse or
+//        promote products derived from this software without specific prior
+//        written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#include "Gaffer/Context.h"
+
+#include "GafferScene/Encapsulate.h"
+#include "GafferScene/Capsule.h"
+#include "GafferScene/PathMatcherData.h"
+
+using namespace std;
+using namespace IECore;
+using namespace Gaffer;
+using namespace GafferScene;
+
+IE_CORE_DEFINERUNTIMETYPED( Encapsulate );
+
+Encapsulate::Encapsulate( const std::string &name )
+	:	FilteredSceneProcessor( name, Filter::NoMatch )
+{
+	// Direct pass-throughs
+	outPlug()->boundPlug()->setInput( inPlug()->boundPlug() );
+	outPlug()->transformPlug()->setInput( inPlug()->transformPlug() );
+	outPlug()->attributesPlug()->setInput( inPlug()->attributesPlug() );
+	outPlug()->globalsPlug()->setInput( inPlug()->globalsPlug() );
+	outPlug()->setNamesPlug()->setInput( inPlug()->setNamesPlug() );
+}
+
+Encapsulate::~Encapsulate()
+{
+}
+
+void Encapsulate::affects( const Gaffer::Plug *input, AffectedPlugsContainer &outputs ) const
+{
+	FilteredSceneProcessor::affects( input, outputs );
+
+	const ScenePlug *in = inPlug();
+	if( input->parent<ScenePlug>() == in )
+	{
+		if( input != in->objectPlug() )
+		{
+			outputs.push_back( outPlug()->getChild<ValuePlug>( input->getName() ) );
+		}
+		// A Capsule represents the whole subtree, so changes
+		// to anything at all affect it.
+		outputs.push_back( outPlug()->objectPlug() );
+	}
+	else if( input == filterPlug() )
+	{
+		outputs.push_back( outPlug()->objectPlug() );
+		outputs.push_back( outPlug()->childNamesPlug() );
+		outputs.push_back( outPlug()->setPlug() );
+	}
+}
+
+bool Encapsulate::acceptsInput( const Gaffer::Plug *plug, const Gaffer::Plug *inputPlug ) const
+{
+	if( !FilteredSceneProcessor::acceptsInput( plug, inputPlug ) )
+	{
+		return false;
+	}
+
+	if( plug == filterPlug() )
+	{
+		if( const Filter *filter = runTimeCast<const Filter>( inputPlug->source<Plug>()->node() ) )
+		{
+			if(
+				filter->sceneAffectsMatch( inPlug(), inPlug()->boundPlug() ) ||
+				filter->sceneAffectsMatch( inPlug(), inPlug()->transformPlug() ) ||
+				filter->sceneAffectsMatch( inPlug(), inPlug()->attributesPlug() ) ||
+				filter->sceneAffectsMatch( inPlug(), inPlug()->objectPlug() ) ||
+				filter->sceneAffectsMatch( inPlug(), inPlug()->childNamesPlug() )
+			)
+			{
+				// As for Prune, we make a single call to filterHash() in hashSet(),
+				// which wouldn't be sufficient for filters that vary based on data
+				// within the scene hierarchy.
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+void Encapsulate::hashObject( const ScenePath &path, const Gaffer::Context *context, const ScenePlug *parent, IECore::MurmurHash &h ) const
+{
+	if( !( filterValue( context ) & Filter::ExactMatch ) )
+	{
+		// pass through
+		h = inPlug()->objectPlug()->hash();
+		return;
+	}
+
+	// Hashing the whole subtree would defeat the purpose of
+	// encapsulating it, so instead we use the dirty count of
+	// the input, which changes whenever anything upstream does.
+	// The context accounts for everything else the subtree
+	// may depend on.
+	FilteredSceneProcessor::hashObject( path, context, parent, h );
+	h.append( inPlug()->dirtyCount() );
+	h.append( context->hash() );
+}
+
+IECore::ConstObjectPtr Encapsulate::computeObject( const ScenePath &path, const Gaffer::Context *context, const ScenePlug *parent ) const
+{
+	if( !( filterValue( context ) & Filter::ExactMatch ) )
+	{
+		return inPlug()->objectPlug()->getValue();
+	}
+
+	return new Capsule(
+		inPlug(),
+		path,
+		*context,
+		parent->objectPlug()->hash(),
+		inPlug()->boundPlug()->getValue()
+	);
+}
+
+void Encapsulate::hashChildNames( const ScenePath &path, const Gaffer::Context *context, const ScenePlug *parent, IECore::MurmurHash &h ) const
+{
+	if( filterValue( context ) & Filter::ExactMatch )
+	{
+		h = inPlug()->childNamesPlug()->defaultHash();
+	}
+	else
+	{
+		// pass through
+		h = inPlug()->childNamesPlug()->hash();
+	}
+}
+
+IECore::ConstInternedStringVectorDataPtr Encapsulate::computeChildNames( const ScenePath &path, const Gaffer::Context *context, const ScenePlug *parent ) const
+{
+	if( filterValue( context ) & Filter::ExactMatch )
+	{
+		return inPlug()->childNamesPlug()->defaultValue();
+	}
+	else
+	{
+		return inPlug()->childNamesPlug()->getValue();
+	}
+}
+
+void Encapsulate::hashSet( const IECore::InternedString &setName, const Gaffer::Context *context, const ScenePlug *parent, IECore::MurmurHash &h ) const
+{
+	FilteredSceneProcessor::hashSet( setName, context, parent, h );
+	inPlug()->setPlug()->hash( h );
+
+	// See comments in Prune::hashSet().
+	ContextPtr c = filterContext( context );
+	c->remove( ScenePlug::scenePathContextName );
+	Context::Scope s( c.get() );
+	filterPlug()->hash( h );
+}
+
+GafferScene::ConstPathMatcherDataPtr Encapsulate::computeSet( const IECore::InternedString &setName, const Gaffer::Context *context, const ScenePlug *parent ) const
+{
+	ConstPathMatcherDataPtr inputSetData = inPlug()->setPlug()->getValue();
+	const PathMatcher &inputSet = inputSetData->readable();
+	if( inputSet.isEmpty() )
+	{
+		return inputSetData;
+	}
+
+	PathMatcherDataPtr outputSetData = inputSetData->copy();
+	PathMatcher &outputSet = outputSetData->writable();
+
+	ContextPtr tmpContext = filterContext( context );
+	Context::Scope scopedContext( tmpContext.get() );
+
+	for( PathMatcher::RawIterator pIt = inputSet.begin(), peIt = inputSet.end(); pIt != peIt; )
+	{
+		tmpContext->set( ScenePlug::scenePathContextName, *pIt );
+		const int m = filterPlug()->getValue();
+		if( m & Filter::ExactMatch )
+		{
+			// The descendants of this path are encapsulated, so
+			// are removed from the set, but the path itself
+			// remains.
+			const bool inSet = pIt.exactMatch();
+			outputSet.prune( *pIt );
+			if( inSet )
+			{
+				outputSet.addPath( *pIt );
+			}
+			pIt.prune();
+			++pIt;
+		}
+		else if( m & Filter::DescendantMatch )
+		{
+			// Continue to find the encapsulated descendants.
+			++pIt;
+		}
+		else
+		{
+			// Nothing at or below this path is encapsulated.
+			pIt.prune();
+			++pIt;
+		}
+	}
+
+	return outputSetData;
+}
@@ -39,6 +39,7 @@
 #include "Gaffer/StringPlug.h"
 
 #include "GafferScene/ExternalProcedural.h"
+#include "GafferScene/ArchiveAlgo.h"
 
 using namespace Imath;
 using namespace Gaffer;
@@ -55,6 +56,7 @@ ExternalProcedural::ExternalProcedural( const std::string &name )
 	addChild( new StringPlug( "fileName" ) );
 	addChild( new Box3fPlug( "bound", Plug::In, Box3f( V3f( -0.5 ), V3f( 0.5 ) ) ) );
 	addChild( new CompoundDataPlug( "parameters" ) );
+	addChild( new BoolPlug( "useArchiveBound", Plug::In, false ) );
 }
 
 ExternalProcedural::~ExternalProcedural()
@@ -91,6 +93,16 @@ const Gaffer::CompoundDataPlug *ExternalProcedural::parametersPlug() const
 	return getChild<CompoundDataPlug>( g_firstPlugIndex + 2 );
 }
 
+Gaffer::BoolPlug *ExternalProcedural::useArchiveBoundPlug()
+{
+	return getChild<BoolPlug>( g_firstPlugIndex + 3 );
+}
+
+const Gaffer::BoolPlug *ExternalProcedural::useArchiveBoundPlug() const
+{
+	return getChild<BoolPlug>( g_firstPlugIndex + 3 );
+}
+
 void ExternalProcedural::affects( const Gaffer::Plug *input, AffectedPlugsContainer &outputs ) const
 {
 	ObjectSource::affects( input, outputs );
@@ -98,7 +110,8 @@ void ExternalProcedural::affects( const Gaffer::Plug *input, AffectedPlugsContai
 	if(
 		input == fileNamePlug() ||
 		boundPlug()->isAncestorOf( input ) ||
-		parametersPlug()->isAncestorOf( input )
+		parametersPlug()->isAncestorOf( input ) ||
+		input == useArchiveBoundPlug()
 	)
 	{
 		outputs.push_back( sourcePlug() );
@@ -110,11 +123,29 @@ void ExternalProcedural::hashSource( const Gaffer::Context *context, IECore::Mur
 	fileNamePlug()->hash( h );
 	boundPlug()->hash( h );
 	parametersPlug()->hash( h );
+	if( useArchiveBoundPlug()->getValue() )
+	{
+		ArchiveAlgo::hash( fileNamePlug()->getValue(), h );
+	}
 }
 
 IECore::ConstObjectPtr ExternalProcedural::computeSource( const Context *context ) const
 {
-	IECore::ExternalProceduralPtr result = new IECore::ExternalProcedural( fileNamePlug()->getValue(), boundPlug()->getValue() );
-	parametersPlug()->fillCompoundData( result->parameters()->writable() );
+	const std::string fileName = fileNamePlug()->getValue();
+
+	Box3f bound;
+	if( useArchiveBoundPlug()->getValue() )
+	{
+		bound = ArchiveAlgo::bound( fileName );
+	}
+	if( bound.isEmpty() )
+	{
+		bound = boundPlug()->getValue();
+	}
+
+	IECore::ExternalProceduralPtr result = new IECore::ExternalProcedural( fileName, bound );
+	// The parameters are shared with the plug's cache rather
+	// than copied, which is fine because our result is const.
+	result->parameters()->writable() = parametersPlug()->compoundData()->readable();
 	return result;
 }
@@ -34,6 +34,9 @@
 //
 //////////////////////////////////////////////////////////////////////////
 
+#include "tbb/blocked_range.h"
+#include "tbb/parallel_for.h"
+
 #include "GafferScene/FilterResults.h"
 #include "GafferScene/ScenePlug.h"
 #include "GafferScene/Filter.h"
@@ -43,6 +46,67 @@ using namespace IECore;
 using namespace Gaffer;
 using namespace GafferScene;
 
+//////////////////////////////////////////////////////////////////////////
+// Internal utilities
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+// Evaluates a plug at each of the children of a location
+// in parallel, storing the hashes or values in `results`.
+template<typename Result>
+class ChildEvaluator
+{
+
+	public :
+
+		ChildEvaluator( const PathMatcherDataPlug *plug, const Context *context, const ScenePlug::ScenePath &parentPath, const std::vector<InternedString> &childNames, std::vector<Result> &results )
+			:	m_plug( plug ), m_context( context ), m_parentPath( parentPath ), m_childNames( childNames ), m_results( results )
+		{
+		}
+
+		void operator() ( const tbb::blocked_range<size_t> &r ) const
+		{
+			ScenePlug::ScenePath childPath = m_parentPath;
+			childPath.push_back( InternedString() ); // Space for the child name
+
+			Context::EditableScope scope( m_context );
+			for( size_t i = r.begin(); i != r.end(); ++i )
+			{
+				Canceller::check( m_context->canceller() );
+				childPath.back() = m_childNames[i];
+				scope.set( ScenePlug::scenePathContextName, childPath );
+				evaluate( m_results[i] );
+			}
+		}
+
+	private :
+
+		void evaluate( IECore::MurmurHash &result ) const
+		{
+			result = m_plug->hash();
+		}
+
+		void evaluate( ConstPathMatcherDataPtr &result ) const
+		{
+			result = m_plug->getValue();
+		}
+
+		const PathMatcherDataPlug *m_plug;
+		const Context *m_context;
+		const ScenePlug::ScenePath &m_parentPath;
+		const std::vector<InternedString> &m_childNames;
+		std::vector<Result> &m_results;
+
+};
+
+} // namespace
+
+//////////////////////////////////////////////////////////////////////////
+// FilterResults
+//////////////////////////////////////////////////////////////////////////
+
 size_t FilterResults::g_firstPlugIndex = 0;
 
 IE_CORE_DEFINERUNTIMETYPED( FilterResults )
@@ -54,6 +118,7 @@ FilterResults::FilterResults( const std::string &name )
 	addChild( new ScenePlug( "scene" ) );
 	addChild( new FilterPlug( "filter" ) );
 	addChild( new PathMatcherDataPlug( "out", Gaffer::Plug::Out, new PathMatcherData ) );
+	addChild( new PathMatcherDataPlug( "__internalOut", Gaffer::Plug::Out, new PathMatcherData ) );
 }
 
 FilterResults::~FilterResults()
@@ -90,6 +155,16 @@ const PathMatcherDataPlug *FilterResults::outPlug() const
 	return getChild<PathMatcherDataPlug>( g_firstPlugIndex + 2 );
 }
 
+PathMatcherDataPlug *FilterResults::internalOutPlug()
+{
+	return getChild<PathMatcherDataPlug>( g_firstPlugIndex + 3 );
+}
+
+const PathMatcherDataPlug *FilterResults::internalOutPlug() const
+{
+	return getChild<PathMatcherDataPlug>( g_firstPlugIndex + 3 );
+}
+
 void FilterResults::affects( const Gaffer::Plug *input, AffectedPlugsContainer &outputs ) const
 {
 	ComputeNode::affects( input, outputs );
@@ -102,8 +177,16 @@ void FilterResults::affects( const Gaffer::Plug *input, AffectedPlugsContainer &
 		{
 			outputs.push_back( filterPlug() );
 		}
+		if( input == scenePlug->childNamesPlug() )
+		{
+			outputs.push_back( internalOutPlug() );
+		}
 	}
 	else if( input == filterPlug() )
+	{
+		outputs.push_back( internalOutPlug() );
+	}
+	else if( input == internalOutPlug() )
 	{
 		outputs.push_back( outPlug() );
 	}
@@ -115,36 +198,76 @@ void FilterResults::hash( const Gaffer::ValuePlug *output, const Gaffer::Context
 
 	if( output == outPlug() )
 	{
-		/// \todo This is potentially incredibly expensive, because depending
-		/// on the filter it might visit every single location of a scene.
-		/// Do better. Possibilities include :
-		///
-		/// - Using an __internalOut plug to do the work, and ensuring that the
-		///   computation of the out plug pulls on __internalOut with a context
-		///   which is as clean as possible (removing scene:path, scene:set,
-		///   image:tileOrigin and image:channelName). This would give the hash
-		///   cache a better chance of mitigating the expense.
-		/// - Adding protected Filter virtual methods to perform all the work
-		///   and exposing them via public methods on FilterPlug. Filters such
-		///   as SetFilter could then have much faster implementations given
-		///   their specific knowledge of the situation.
-		/// - Using David Minor's "poor man's hash" trick whereby the dirty
-		///   count of the input scene is used as a substitute for the true
-		///   hash.
-		/// - Coming up with a way of cheaply computing a hierarchy hash,
-		///   that mythical beast that solves all our problems.
-		PathMatcherDataPtr data = new PathMatcherData;
-		SceneAlgo::matchingPaths( filterPlug(), scenePlug(), data->writable() );
-		data->hash( h );
+		Context::EditableScope scope( context );
+		scope.set( Filter::inputSceneContextName, (uint64_t)scenePlug() );
+		scope.set( ScenePlug::scenePathContextName, ScenePlug::ScenePath() );
+		internalOutPlug()->hash( h );
+	}
+	else if( output == internalOutPlug() )
+	{
+		filterPlug()->hash( h );
+		const unsigned match = filterPlug()->getValue();
+		if( match & Filter::DescendantMatch )
+		{
+			scenePlug()->childNamesPlug()->hash( h );
+			ConstInternedStringVectorDataPtr childNamesData = scenePlug()->childNamesPlug()->getValue();
+			const std::vector<InternedString> &childNames = childNamesData->readable();
+
+			std::vector<IECore::MurmurHash> childHashes( childNames.size() );
+			const ScenePlug::ScenePath &path = context->get<ScenePlug::ScenePath>( ScenePlug::scenePathContextName );
+			ChildEvaluator<IECore::MurmurHash> evaluator( internalOutPlug(), context, path, childNames, childHashes );
+			tbb::parallel_for( tbb::blocked_range<size_t>( 0, childNames.size() ), evaluator );
+
+			for( std::vector<IECore::MurmurHash>::const_iterator it = childHashes.begin(), eIt = childHashes.end(); it != eIt; ++it )
+			{
+				h.append( *it );
+			}
+		}
 	}
 }
 
 void FilterResults::compute( Gaffer::ValuePlug *output, const Gaffer::Context *context ) const
 {
 	if( output == outPlug() )
+	{
+		Context::EditableScope scope( context );
+		scope.set( Filter::inputSceneContextName, (uint64_t)scenePlug() );
+		scope.set( ScenePlug::scenePathContextName, ScenePlug::ScenePath() );
+		static_cast<PathMatcherDataPlug *>( output )->setValue( internalOutPlug()->getValue() );
+		return;
+	}
+	else if( output == internalOutPlug() )
 	{
 		PathMatcherDataPtr data = new PathMatcherData;
-		SceneAlgo::matchingPaths( filterPlug(), scenePlug(), data->writable() );
+		PathMatcher &result = data->writable();
+
+		const unsigned match = filterPlug()->getValue();
+		if( match & Filter::ExactMatch )
+		{
+			result.addPath( ScenePlug::ScenePath() );
+		}
+
+		if( match & Filter::DescendantMatch )
+		{
+			ConstInternedStringVectorDataPtr childNamesData = scenePlug()->childNamesPlug()->getValue();
+			const std::vector<InternedString> &childNames = childNamesData->readable();
+
+			std::vector<ConstPathMatcherDataPtr> childResults( childNames.size() );
+			const ScenePlug::ScenePath &path = context->get<ScenePlug::ScenePath>( ScenePlug::scenePathContextName );
+			ChildEvaluator<ConstPathMatcherDataPtr> evaluator( internalOutPlug(), context, path, childNames, childResults );
+			tbb::parallel_for( tbb::blocked_range<size_t>( 0, childNames.size() ), evaluator );
+
+			// Graft the child results in below their names. PathMatcher
+			// shares the child trees rather than copying them, so this
+			// is cheap.
+			ScenePlug::ScenePath childPath( 1 );
+			for( size_t i = 0, e = childNames.size(); i < e; ++i )
+			{
+				childPath.back() = childNames[i];
+				result.addPaths( childResults[i]->readable(), childPath );
+			}
+		}
+
 		static_cast<PathMatcherDataPlug *>( output )->setValue( data );
 		return;
 	}
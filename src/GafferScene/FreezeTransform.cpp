@@ -34,13 +34,12 @@
 //
 //////////////////////////////////////////////////////////////////////////
 
-#include "IECore/TransformOp.h"
-#include "IECore/DespatchTypedData.h"
 #include "IECore/Primitive.h"
 
 #include "Gaffer/Context.h"
 
 #include "GafferScene/FreezeTransform.h"
+#include "GafferScene/PrimitiveAlgo.h"
 
 using namespace std;
 using namespace Imath;
@@ -236,27 +235,8 @@ IECore::ConstObjectPtr FreezeTransform::computeObject( const ScenePath &path, co
 
 		PrimitivePtr outputPrimitive = inputPrimitive->copy();
 
-		/// \todo This is a pain - we need functionality in Cortex to just automatically apply
-		/// the transform to all appropriate primitive variables, without having to manually
-		/// list them. At the same time, we could add a PrimitiveAlgo.h file to Cortex, allowing
-		/// us to apply a transform without having to create an Op to do it.
-		vector<string> primVarNames;
-		for( PrimitiveVariableMap::const_iterator it = inputPrimitive->variables.begin(), eIt = inputPrimitive->variables.end(); it != eIt; ++it )
-		{
-			if( despatchTraitsTest<TypeTraits::IsFloatVec3VectorTypedData>( it->second.data.get() ) )
-			{
-				primVarNames.push_back( it->first );
-			}
-		}
-
 		const M44f transform = transformPlug()->getValue();
-
-		TransformOpPtr transformOp = new TransformOp;
-		transformOp->inputParameter()->setValue( outputPrimitive );
-		transformOp->copyParameter()->setTypedValue( false );
-		transformOp->matrixParameter()->setValue( new M44fData( transform ) );
-		transformOp->primVarsParameter()->setTypedValue( primVarNames );
-		transformOp->operate();
+		PrimitiveAlgo::transformPrimitive( outputPrimitive.get(), transform );
 
 		return outputPrimitive;
 	}
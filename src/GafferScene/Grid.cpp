@@ -285,7 +285,7 @@ void Grid::hashAttributes( const ScenePath &path, const Gaffer::Context *context
 		}
 		return;
 	}
-	h = outPlug()->attributesPlug()->defaultValue()->Object::hash();
+	h = outPlug()->attributesPlug()->defaultHash();
 }
 
 IECore::ConstCompoundObjectPtr Grid::computeAttributes( const SceneNode::ScenePath &path, const Gaffer::Context *context, const ScenePlug *parent ) const
@@ -350,7 +350,7 @@ void Grid::hashObject( const SceneNode::ScenePath &path, const Gaffer::Context *
 	}
 	else
 	{
-		h = outPlug()->objectPlug()->defaultValue()->hash();
+		h = outPlug()->objectPlug()->defaultHash();
 	}
 }
 
@@ -457,7 +457,7 @@ IECore::ConstInternedStringVectorDataPtr Grid::computeChildNames( const SceneNod
 
 void Grid::hashGlobals( const Gaffer::Context *context, const ScenePlug *parent, IECore::MurmurHash &h ) const
 {
-	h = outPlug()->globalsPlug()->defaultValue()->Object::hash();
+	h = outPlug()->globalsPlug()->defaultHash();
 }
 
 IECore::ConstCompoundObjectPtr Grid::computeGlobals( const Gaffer::Context *context, const ScenePlug *parent ) const
@@ -467,7 +467,7 @@ IECore::ConstCompoundObjectPtr Grid::computeGlobals( const Gaffer::Context *cont
 
 void Grid::hashSetNames( const Gaffer::Context *context, const ScenePlug *parent, IECore::MurmurHash &h ) const
 {
-	h = outPlug()->setNamesPlug()->defaultValue()->Object::hash();
+	h = outPlug()->setNamesPlug()->defaultHash();
 
 }
 
@@ -478,7 +478,7 @@ IECore::ConstInternedStringVectorDataPtr Grid::computeSetNames( const Gaffer::Co
 
 void Grid::hashSet( const IECore::InternedString &setName, const Gaffer::Context *context, const ScenePlug *parent, IECore::MurmurHash &h ) const
 {
-	h = outPlug()->setPlug()->defaultValue()->Object::hash();
+	h = outPlug()->setPlug()->defaultHash();
 }
 
 GafferScene::ConstPathMatcherDataPtr Grid::computeSet( const IECore::InternedString &setName, const Gaffer::Context *context, const ScenePlug *parent ) const
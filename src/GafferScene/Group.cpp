@@ -37,6 +37,7 @@
 
 #include "boost/lexical_cast.hpp"
 #include "boost/regex.hpp"
+#include "boost/unordered_set.hpp"
 
 #include "OpenEXR/ImathBoxAlgo.h"
 
@@ -57,6 +58,53 @@ using namespace IECore;
 using namespace Gaffer;
 using namespace GafferScene;
 
+//////////////////////////////////////////////////////////////////////////
+// Internal utilities
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+// InternedStrings are unique, so can be hashed by address.
+struct InternedStringHash
+{
+
+	size_t operator()( const InternedString &s ) const
+	{
+		return boost::hash<const char *>()( s.c_str() );
+	}
+
+};
+
+typedef boost::unordered_set<InternedString, InternedStringHash> NameSet;
+
+// Appends the hashes of the specified child plug of every input,
+// computing them in parallel. With many inputs this is significantly
+// quicker than hashing them one by one.
+template<typename PlugType>
+void hashInputs( const ArrayPlug *inPlugs, const PlugType *(ScenePlug::*child)() const, IECore::MurmurHash &h )
+{
+	vector<const ValuePlug *> plugs;
+	plugs.reserve( inPlugs->children().size() );
+	for( ScenePlugIterator it( inPlugs ); !it.done(); ++it )
+	{
+		plugs.push_back( ((**it).*child)() );
+	}
+
+	vector<IECore::MurmurHash> hashes;
+	ValuePlug::hashes( plugs, vector<const Context *>(), hashes );
+	for( vector<IECore::MurmurHash>::const_iterator it = hashes.begin(), eIt = hashes.end(); it != eIt; ++it )
+	{
+		h.append( *it );
+	}
+}
+
+} // namespace
+
+//////////////////////////////////////////////////////////////////////////
+// Group
+//////////////////////////////////////////////////////////////////////////
+
 IE_CORE_DEFINERUNTIMETYPED( Group );
 
 size_t Group::g_firstPlugIndex = 0;
@@ -167,10 +215,7 @@ void Group::hash( const Gaffer::ValuePlug *output, const Gaffer::Context *contex
 		ContextPtr tmpContext = new Context( *context, Context::Borrowed );
 		tmpContext->set( ScenePlug::scenePathContextName, ScenePath() );
 		Context::Scope scopedContext( tmpContext.get() );
-		for( ScenePlugIterator it( inPlugs() ); !it.done(); ++it )
-		{
-			(*it)->childNamesPlug()->hash( h );
-		}
+		hashInputs( inPlugs(), &ScenePlug::childNamesPlug, h );
 	}
 }
 
@@ -190,10 +235,7 @@ void Group::hashBound( const ScenePath &path, const Gaffer::Context *context, co
 	if( path.size() == 0 ) // "/"
 	{
 		SceneProcessor::hashBound( path, context, parent, h );
-		for( ScenePlugIterator it( inPlugs() ); !it.done(); ++it )
-		{
-			(*it)->boundPlug()->hash( h );
-		}
+		hashInputBounds( h );
 		transformPlug()->hash( h );
 	}
 	else if( path.size() == 1 ) // "/group"
@@ -202,10 +244,7 @@ void Group::hashBound( const ScenePath &path, const Gaffer::Context *context, co
 		ContextPtr tmpContext = new Context( *context, Context::Borrowed );
 		tmpContext->set( ScenePlug::scenePathContextName, ScenePath() );
 		Context::Scope scopedContext( tmpContext.get() );
-		for( ScenePlugIterator it( inPlugs() ); !it.done(); ++it )
-		{
-			(*it)->boundPlug()->hash( h );
-		}
+		hashInputBounds( h );
 	}
 	else // "/group/..."
 	{
@@ -216,6 +255,25 @@ void Group::hashBound( const ScenePath &path, const Gaffer::Context *context, co
 	}
 }
 
+void Group::hashInputBounds( IECore::MurmurHash &h ) const
+{
+	// The input bounds are independent of one another, so we
+	// hash them in parallel, appending in input order to keep
+	// the result stable.
+	std::vector<const ValuePlug *> plugs;
+	for( ScenePlugIterator it( inPlugs() ); !it.done(); ++it )
+	{
+		plugs.push_back( (*it)->boundPlug() );
+	}
+
+	std::vector<IECore::MurmurHash> hashes;
+	ValuePlug::hashes( plugs, std::vector<const Context *>(), hashes );
+	for( std::vector<IECore::MurmurHash>::const_iterator it = hashes.begin(), eIt = hashes.end(); it != eIt; ++it )
+	{
+		h.append( *it );
+	}
+}
+
 Imath::Box3f Group::computeBound( const ScenePath &path, const Gaffer::Context *context, const ScenePlug *parent ) const
 {
 	if( path.size() <= 1 )
@@ -384,10 +442,7 @@ IECore::ConstInternedStringVectorDataPtr Group::computeChildNames( const ScenePa
 void Group::hashSetNames( const Gaffer::Context *context, const ScenePlug *parent, IECore::MurmurHash &h ) const
 {
 	SceneProcessor::hashSetNames( context, parent, h );
-	for( ScenePlugIterator it( inPlugs() ); !it.done(); ++it )
-	{
-		(*it)->setNamesPlug()->hash( h );
-	}
+	hashInputs( inPlugs(), &ScenePlug::setNamesPlug, h );
 }
 
 IECore::ConstInternedStringVectorDataPtr Group::computeSetNames( const Gaffer::Context *context, const ScenePlug *parent ) const
@@ -416,10 +471,7 @@ IECore::ConstInternedStringVectorDataPtr Group::computeSetNames( const Gaffer::C
 void Group::hashSet( const IECore::InternedString &setName, const Gaffer::Context *context, const ScenePlug *parent, IECore::MurmurHash &h ) const
 {
 	SceneProcessor::hashSet( setName, context, parent, h );
-	for( ScenePlugIterator it( inPlugs() ); !it.done(); ++it )
-	{
-		(*it)->setPlug()->hash( h );
-	}
+	hashInputs( inPlugs(), &ScenePlug::setPlug, h );
 	mappingPlug()->hash( h );
 	namePlug()->hash( h );
 }
@@ -431,6 +483,15 @@ GafferScene::ConstPathMatcherDataPtr Group::computeSet( const IECore::InternedSt
 	ConstCompoundObjectPtr mapping = boost::static_pointer_cast<const CompoundObject>( mappingPlug()->getValue() );
 	const ObjectVector *forwardMappings = mapping->member<ObjectVector>( "__GroupForwardMappings", true /* throw if missing */ );
 
+	// Compute all the input sets in parallel up front, so that
+	// the getValue() calls below are just cache lookups.
+	vector<const ValuePlug *> inputSetPlugs;
+	for( ScenePlugIterator it( inPlugs() ); !it.done(); ++it )
+	{
+		inputSetPlugs.push_back( (*it)->setPlug() );
+	}
+	ValuePlug::prefetch( inputSetPlugs, vector<const Context *>() );
+
 	PathMatcherDataPtr resultData = new PathMatcherData;
 	PathMatcher &result = resultData->writable();
 	for( size_t i = 0, e = inPlugs()->children().size(); i < e; i++ )
@@ -485,7 +546,20 @@ IECore::ObjectPtr Group::computeMapping( const Gaffer::Context *context ) const
 	boost::regex namePrefixSuffixRegex( "^(.*[^0-9]+)([0-9]+)$" );
 	boost::format namePrefixSuffixFormatter( "%s%d" );
 
-	set<InternedString> allNames;
+	// Compute the child names for all inputs in parallel, so
+	// that the loop below only retrieves them from the cache.
+	{
+		Context::EditableScope scope( context );
+		scope.set( ScenePlug::scenePathContextName, ScenePath() );
+		vector<const ValuePlug *> childNamesPlugs;
+		for( ScenePlugIterator it( inPlugs() ); !it.done(); ++it )
+		{
+			childNamesPlugs.push_back( (*it)->childNamesPlug() );
+		}
+		ValuePlug::prefetch( childNamesPlugs, vector<const Context *>() );
+	}
+
+	NameSet allNames;
 	for( ScenePlugIterator it( inPlugs() ); !it.done(); ++it )
 	{
 		ConstInternedStringVectorDataPtr inChildNamesData = (*it)->childNames( ScenePath() );
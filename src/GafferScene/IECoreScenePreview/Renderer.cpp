@@ -87,6 +87,11 @@ Renderer::ObjectInterface::~ObjectInterface()
 
 }
 
+IECore::CompoundDataPtr Renderer::statistics() const
+{
+	return new IECore::CompoundData;
+}
+
 const std::vector<IECore::InternedString> &Renderer::types()
 {
 	return ::types();
@@ -59,6 +59,8 @@ IE_CORE_DEFINERUNTIMETYPED( Instancer );
 
 size_t Instancer::g_firstPlugIndex = 0;
 
+static InternedString g_instancerIdContextName( "instancer:id" );
+
 Instancer::Instancer( const std::string &name )
 	:	BranchCreator( name )
 {
@@ -126,16 +128,16 @@ struct Instancer::BoundHash
 
 	void operator() ( const blocked_range<size_t> &r )
 	{
-		ContextPtr ic = new Context( *m_context, Context::Borrowed );
-		Context::Scope scopedContext( ic.get() );
+		Context::EditableScope scope( m_context );
 
 		ScenePath branchChildPath( m_branchPath );
 		branchChildPath.push_back( InternedString() ); // where we'll place the instance index
 
 		for( size_t i=r.begin(); i!=r.end(); ++i )
 		{
+			Canceller::check( m_context->canceller() );
 			branchChildPath[branchChildPath.size()-1] = InternedString( i );
-			m_instancer->fillInstanceContext( ic.get(), branchChildPath, i );
+			m_instancer->fillInstanceContext( scope, branchChildPath, i );
 			m_instancer->instancePlug()->boundPlug()->hash( m_hash );
 			// no need to hash transform of instance because we know all
 			// root transforms are identity.
@@ -161,6 +163,15 @@ struct Instancer::BoundHash
 
 };
 
+Gaffer::ValuePlug::CachePolicy Instancer::computeCachePolicy( const Gaffer::ValuePlug *output ) const
+{
+	if( output == outPlug()->boundPlug() )
+	{
+		return ValuePlug::TaskIsolation;
+	}
+	return BranchCreator::computeCachePolicy( output );
+}
+
 void Instancer::hashBranchBound( const ScenePath &parentPath, const ScenePath &branchPath, const Gaffer::Context *context, IECore::MurmurHash &h ) const
 {
 	if( branchPath.size() <= 1 )
@@ -172,7 +183,10 @@ void Instancer::hashBranchBound( const ScenePath &parentPath, const ScenePath &b
 		ConstV3fVectorDataPtr p = sourcePoints( parentPath );
 		if( p )
 		{
-			p->hash( h );
+			// The points are derived entirely from the source object,
+			// so we use its hash rather than rehashing the potentially
+			// huge point array every time.
+			h.append( inPlug()->objectHash( parentPath ) );
 
 			ScenePath branchChildPath( branchPath );
 			if( branchChildPath.size() == 0 )
@@ -191,8 +205,8 @@ void Instancer::hashBranchBound( const ScenePath &parentPath, const ScenePath &b
 	}
 	else
 	{
-		ContextPtr ic = instanceContext( context, branchPath );
-		Context::Scope scopedContext( ic.get() );
+		Context::EditableScope scope( context );
+		fillInstanceContext( scope, branchPath );
 		h = instancePlug()->boundPlug()->hash();
 	}
 }
@@ -212,16 +226,16 @@ struct Instancer::BoundUnion
 
 	void operator() ( const blocked_range<size_t> &r )
 	{
-		ContextPtr ic = new Context( *m_context, Context::Borrowed );
-		Context::Scope scopedContext( ic.get() );
+		Context::EditableScope scope( m_context );
 
 		ScenePath branchChildPath( m_branchPath );
 		branchChildPath.push_back( InternedString() ); // where we'll place the instance index
 
 		for( size_t i=r.begin(); i!=r.end(); ++i )
 		{
+			Canceller::check( m_context->canceller() );
 			branchChildPath[branchChildPath.size()-1] = InternedString( i );
-			m_instancer->fillInstanceContext( ic.get(), branchChildPath, i );
+			m_instancer->fillInstanceContext( scope, branchChildPath, i );
 
 			Box3f branchChildBound = m_instancer->instancePlug()->boundPlug()->getValue();
 			branchChildBound = transform( branchChildBound, m_instancer->instanceTransform( m_p, i ) );
@@ -277,8 +291,8 @@ Imath::Box3f Instancer::computeBranchBound( const ScenePath &parentPath, const S
 	}
 	else
 	{
-		ContextPtr ic = instanceContext( context, branchPath );
-		Context::Scope scopedContext( ic.get() );
+		Context::EditableScope scope( context );
+		fillInstanceContext( scope, branchPath );
 		return instancePlug()->boundPlug()->getValue();
 	}
 }
@@ -299,8 +313,8 @@ void Instancer::hashBranchTransform( const ScenePath &parentPath, const ScenePat
 	}
 	else
 	{
-		ContextPtr ic = instanceContext( context, branchPath );
-		Context::Scope scopedContext( ic.get() );
+		Context::EditableScope scope( context );
+		fillInstanceContext( scope, branchPath );
 		h = instancePlug()->transformPlug()->hash();
 	}
 }
@@ -321,8 +335,8 @@ Imath::M44f Instancer::computeBranchTransform( const ScenePath &parentPath, cons
 	}
 	else
 	{
-		ContextPtr ic = instanceContext( context, branchPath );
-		Context::Scope scopedContext( ic.get() );
+		Context::EditableScope scope( context );
+		fillInstanceContext( scope, branchPath );
 		return instancePlug()->transformPlug()->getValue();
 	}
 }
@@ -332,12 +346,12 @@ void Instancer::hashBranchAttributes( const ScenePath &parentPath, const ScenePa
 	if( branchPath.size() <= 1 )
 	{
 		// "/" or "/name"
-		h = outPlug()->attributesPlug()->defaultValue()->Object::hash();
+		h = outPlug()->attributesPlug()->defaultHash();
 	}
 	else
 	{
-		ContextPtr ic = instanceContext( context, branchPath );
-		Context::Scope scopedContext( ic.get() );
+		Context::EditableScope scope( context );
+		fillInstanceContext( scope, branchPath );
 		h = instancePlug()->attributesPlug()->hash();
 	}
 }
@@ -351,8 +365,8 @@ IECore::ConstCompoundObjectPtr Instancer::computeBranchAttributes( const ScenePa
 	}
 	else
 	{
-		ContextPtr ic = instanceContext( context, branchPath );
-		Context::Scope scopedContext( ic.get() );
+		Context::EditableScope scope( context );
+		fillInstanceContext( scope, branchPath );
 		return instancePlug()->attributesPlug()->getValue();
 	}
 }
@@ -362,12 +376,12 @@ void Instancer::hashBranchObject( const ScenePath &parentPath, const ScenePath &
 	if( branchPath.size() <= 1 )
 	{
 		// "/" or "/name"
-		h = outPlug()->objectPlug()->defaultValue()->Object::hash();
+		h = outPlug()->objectPlug()->defaultHash();
 	}
 	else
 	{
-		ContextPtr ic = instanceContext( context, branchPath );
-		Context::Scope scopedContext( ic.get() );
+		Context::EditableScope scope( context );
+		fillInstanceContext( scope, branchPath );
 		h = instancePlug()->objectPlug()->hash();
 	}
 }
@@ -381,8 +395,8 @@ IECore::ConstObjectPtr Instancer::computeBranchObject( const ScenePath &parentPa
 	}
 	else
 	{
-		ContextPtr ic = instanceContext( context, branchPath );
-		Context::Scope scopedContext( ic.get() );
+		Context::EditableScope scope( context );
+		fillInstanceContext( scope, branchPath );
 		return instancePlug()->objectPlug()->getValue();
 	}
 }
@@ -404,8 +418,8 @@ void Instancer::hashBranchChildNames( const ScenePath &parentPath, const ScenePa
 	else
 	{
 		// "/name/..."
-		ContextPtr ic = instanceContext( context, branchPath );
-		Context::Scope scopedContext( ic.get() );
+		Context::EditableScope scope( context );
+		fillInstanceContext( scope, branchPath );
 		h = instancePlug()->childNamesPlug()->hash();
 	}
 }
@@ -446,8 +460,8 @@ IECore::ConstInternedStringVectorDataPtr Instancer::computeBranchChildNames( con
 	}
 	else
 	{
-		ContextPtr ic = instanceContext( context, branchPath );
-		Context::Scope scopedContext( ic.get() );
+		Context::EditableScope scope( context );
+		fillInstanceContext( scope, branchPath );
 		return instancePlug()->childNamesPlug()->getValue();
 	}
 }
@@ -468,32 +482,21 @@ int Instancer::instanceIndex( const ScenePath &branchPath ) const
 	return boost::lexical_cast<int>( branchPath[1].value() );
 }
 
-Gaffer::ContextPtr Instancer::instanceContext( const Gaffer::Context *parentContext, const ScenePath &branchPath ) const
-{
-	assert( branchPath.size() >= 2 );
-
-	ContextPtr result = new Context( *parentContext, Context::Borrowed );
-	fillInstanceContext( result.get(), branchPath );
-
-	return result;
-}
-
-void Instancer::fillInstanceContext( Gaffer::Context *instanceContext, const ScenePath &branchPath ) const
+void Instancer::fillInstanceContext( Gaffer::Context::EditableScope &scope, const ScenePath &branchPath ) const
 {
 	assert( branchPath.size() >= 2 );
 
-	fillInstanceContext( instanceContext, branchPath, instanceIndex( branchPath ) );
+	fillInstanceContext( scope, branchPath, instanceIndex( branchPath ) );
 }
 
-void Instancer::fillInstanceContext( Gaffer::Context *instanceContext, const ScenePath &branchPath, int instanceId ) const
+void Instancer::fillInstanceContext( Gaffer::Context::EditableScope &scope, const ScenePath &branchPath, int instanceId ) const
 {
 	assert( branchPath.size() >= 2 );
 
-	ScenePath instancePath;
-	instancePath.insert( instancePath.end(), branchPath.begin() + 2, branchPath.end() );
-	instanceContext->set( ScenePlug::scenePathContextName, instancePath );
+	ScenePath instancePath( branchPath.begin() + 2, branchPath.end() );
+	scope.set( ScenePlug::scenePathContextName, instancePath );
 
-	instanceContext->set( "instancer:id", instanceId );
+	scope.set( g_instancerIdContextName, instanceId );
 }
 
 Imath::M44f Instancer::instanceTransform( const IECore::V3fVectorData *p, int instanceId ) const
@@ -61,6 +61,52 @@ using namespace GafferScene;
 
 IE_CORE_DEFINERUNTIMETYPED( InteractiveRender );
 
+namespace
+{
+
+typedef std::map<IECore::InternedString, IECore::MurmurHash> AttributeHashes;
+
+// Returns the attributes which must be output to update a location last
+// output with the specified member hashes, and updates the hashes to match.
+// When only state (shaders etc) has changed, we output just the changed
+// members, so that a shader tweak doesn't resend everything else. If any
+// plain attribute has changed we output the lot, because 3delight shaders
+// only see attributes declared before them. Returns NULL if nothing needs
+// outputting.
+ConstCompoundObjectPtr changedAttributes( const CompoundObject *attributes, AttributeHashes &hashes )
+{
+	CompoundObjectPtr changed = new CompoundObject;
+	bool dataChanged = false;
+
+	AttributeHashes newHashes;
+	for( CompoundObject::ObjectMap::const_iterator it = attributes->members().begin(), eIt = attributes->members().end(); it != eIt; ++it )
+	{
+		const MurmurHash h = it->second->hash();
+		newHashes[it->first] = h;
+
+		AttributeHashes::const_iterator hIt = hashes.find( it->first );
+		if( hIt == hashes.end() || hIt->second != h )
+		{
+			changed->members()[it->first] = it->second;
+			dataChanged = dataChanged || runTimeCast<const Data>( it->second.get() );
+		}
+	}
+	hashes.swap( newHashes );
+
+	if( dataChanged )
+	{
+		return attributes;
+	}
+	else if( changed->members().empty() )
+	{
+		return NULL;
+	}
+
+	return changed;
+}
+
+} // namespace
+
 //////////////////////////////////////////////////////////////////////////
 // SceneGraph implementation
 //
@@ -122,6 +168,10 @@ class InteractiveRender::SceneGraph
 		// hashes as of the most recent evaluation:
 		IECore::MurmurHash m_attributesHash;
 		IECore::MurmurHash m_childNamesHash;
+		// Hashes of the individual attributes as of the most recent
+		// edit. These are only computed once a location has been edited,
+		// so the initial build doesn't pay for them.
+		AttributeHashes m_attributeHashes;
 
 		// actual scene data:
 		IECore::ConstCompoundObjectPtr m_attributes;
@@ -657,12 +707,13 @@ class InteractiveRender::SceneGraphEvaluatorFilter : public tbb::filter
 				if( m_update )
 				{
 					// we're re-traversing this location, so lets only recompute attributes where
-					// their hashes change:
+					// their hashes change, and only output the individual attributes that changed:
 
 					IECore::MurmurHash attributesHash = m_scene->attributesPlug()->hash();
 					if( attributesHash != s->m_attributesHash )
 					{
-						s->m_attributes = m_scene->attributesPlug()->getValue( &attributesHash );
+						ConstCompoundObjectPtr attributes = m_scene->attributesPlug()->getValue( &attributesHash );
+						s->m_attributes = changedAttributes( attributes.get(), s->m_attributeHashes );
 						s->m_attributesHash = attributesHash;
 					}
 				}
@@ -34,6 +34,9 @@
 //
 //////////////////////////////////////////////////////////////////////////
 
+#include "tbb/blocked_range.h"
+#include "tbb/parallel_for.h"
+
 #include "OpenEXR/ImathFun.h"
 
 #include "IECore/Primitive.h"
@@ -50,6 +53,60 @@ using namespace IECore;
 using namespace Gaffer;
 using namespace GafferScene;
 
+//////////////////////////////////////////////////////////////////////////
+// Internal utilities
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+struct Projector
+{
+
+	Projector( const vector<V3f> &p, const M44f &objectToCamera, float tanFOV, const Box2f &screenWindow, vector<float> &s, vector<float> &t )
+		:	m_p( p ), m_objectToCamera( objectToCamera ), m_tanFOV( tanFOV ), m_screenWindow( screenWindow ), m_s( s ), m_t( t )
+	{
+	}
+
+	void operator()( const tbb::blocked_range<size_t> &r ) const
+	{
+		for( size_t i = r.begin(); i != r.end(); ++i )
+		{
+			V3f pCamera = m_p[i] * m_objectToCamera;
+			V2f pScreen;
+			if( m_tanFOV > 0.0f )
+			{
+				// perspective
+				const float d = pCamera.z * m_tanFOV;
+				pScreen = V2f( pCamera.x / d, pCamera.y / d );
+			}
+			else
+			{
+				// orthographic
+				pScreen = V2f( pCamera.x, pCamera.y );
+			}
+			m_s[i] = lerpfactor( pScreen.x, m_screenWindow.min.x, m_screenWindow.max.x );
+			m_t[i] = lerpfactor( pScreen.y, m_screenWindow.min.y, m_screenWindow.max.y );
+		}
+	}
+
+	private :
+
+		const vector<V3f> &m_p;
+		const M44f m_objectToCamera;
+		const float m_tanFOV;
+		const Box2f m_screenWindow;
+		vector<float> &m_s;
+		vector<float> &m_t;
+
+};
+
+} // namespace
+
+//////////////////////////////////////////////////////////////////////////
+// MapProjection
+//////////////////////////////////////////////////////////////////////////
+
 IE_CORE_DEFINERUNTIMETYPED( MapProjection );
 
 size_t MapProjection::g_firstPlugIndex = 0;
@@ -199,27 +256,13 @@ IECore::ConstObjectPtr MapProjection::computeProcessedObject( const ScenePath &p
 	const vector<V3f> &p = pData->readable();
 	vector<float> &s = sData->writable();
 	vector<float> &t = tData->writable();
-	s.reserve( p.size() );
-	t.reserve( p.size() );
+	s.resize( p.size() );
+	t.resize( p.size() );
 
-	for( size_t i = 0, e = p.size(); i < e; ++i )
-	{
-		V3f pCamera = p[i] * objectToCamera;
-		V2f pScreen;
-		if( tanFOV > 0.0f )
-		{
-			// perspective
-			const float d = pCamera.z * tanFOV;
-			pScreen = V2f( pCamera.x / d, pCamera.y / d );
-		}
-		else
-		{
-			// orthographic
-			pScreen = V2f( pCamera.x, pCamera.y );
-		}
-		s.push_back( lerpfactor( pScreen.x, screenWindow.min.x, screenWindow.max.x ) );
-		t.push_back( lerpfactor( pScreen.y, screenWindow.min.y, screenWindow.max.y ) );
-	}
+	tbb::parallel_for(
+		tbb::blocked_range<size_t>( 0, p.size(), 10000 ),
+		Projector( p, objectToCamera, tanFOV, screenWindow, s, t )
+	);
 
 	return result;
 }
@@ -0,0 +1,427 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2017, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//      * Redistributions of source code must retain the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer.
+//
+//      * Redistributions in binary form must reproduce the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer in the documentation and/or other materials provided with
+//        the distribution.
+//
+//      * Neither the name of John Haddon nor the names of
+//        any other contributors to this software may be used to endorse or
+//        promote products derived from this software without specific prior
+//        written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#include "tbb/blocked_range.h"
+#include "tbb/parallel_for.h"
+
+#include "boost/format.hpp"
+
+#include "OpenEXR/ImathFun.h"
+
+#include "IECore/VectorTypedData.h"
+
+#include "GafferScene/MeshAlgo.h"
+
+using namespace std;
+using namespace Imath;
+using namespace IECore;
+using namespace GafferScene;
+
+//////////////////////////////////////////////////////////////////////////
+// Internal utilities
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+// Faces and vertices smaller in number than this are processed
+// in a single task, as the overhead of parallelism would outweigh
+// the gains.
+const size_t g_grainSize = 10000;
+
+// Connectivity used to accumulate per-face values onto vertices
+// without contention between threads. Per-face values are first
+// computed in parallel into a separate slot for each face-vertex
+// (corner), and then each vertex sums the corners which reference
+// it, again in parallel. This avoids both atomics and per-thread
+// accumulation buffers, which would be prohibitively large for
+// production meshes.
+struct Topology
+{
+
+	Topology( const MeshPrimitive *mesh )
+	{
+		const vector<int> &verticesPerFace = mesh->verticesPerFace()->readable();
+		const vector<int> &vertexIds = mesh->vertexIds()->readable();
+		const size_t numVertices = mesh->variableSize( PrimitiveVariable::Vertex );
+
+		faceOffsets.resize( verticesPerFace.size() );
+		int offset = 0;
+		for( size_t i = 0, e = verticesPerFace.size(); i < e; ++i )
+		{
+			faceOffsets[i] = offset;
+			offset += verticesPerFace[i];
+		}
+
+		vertexCornerOffsets.resize( numVertices + 1, 0 );
+		for( vector<int>::const_iterator it = vertexIds.begin(), eIt = vertexIds.end(); it != eIt; ++it )
+		{
+			vertexCornerOffsets[*it + 1]++;
+		}
+		for( size_t i = 1; i <= numVertices; ++i )
+		{
+			vertexCornerOffsets[i] += vertexCornerOffsets[i-1];
+		}
+
+		vertexCorners.resize( vertexIds.size() );
+		vector<int> next( vertexCornerOffsets.begin(), vertexCornerOffsets.end() - 1 );
+		for( size_t i = 0, e = vertexIds.size(); i < e; ++i )
+		{
+			vertexCorners[next[vertexIds[i]]++] = i;
+		}
+	}
+
+	// Index of the first corner of each face.
+	vector<int> faceOffsets;
+	// The corners for vertex `i` are stored in `vertexCorners`
+	// in the range [ vertexCornerOffsets[i], vertexCornerOffsets[i+1] ).
+	vector<int> vertexCornerOffsets;
+	vector<int> vertexCorners;
+
+};
+
+float cornerAngle( const V3f &p, const V3f &pPrevious, const V3f &pNext )
+{
+	V3f e0 = pNext - p;
+	V3f e1 = pPrevious - p;
+	const float l0 = e0.length();
+	const float l1 = e1.length();
+	if( l0 == 0.0f || l1 == 0.0f )
+	{
+		return 0.0f;
+	}
+	return acosf( clamp( e0.dot( e1 ) / ( l0 * l1 ), -1.0f, 1.0f ) );
+}
+
+// Computes the normal for each face using Newell's method, and stores
+// it for each corner, weighted by the angle at that corner.
+struct CornerNormals
+{
+
+	CornerNormals( const MeshPrimitive *mesh, const vector<V3f> &p, const Topology &topology, vector<V3f> &cornerNormals )
+		:	m_verticesPerFace( mesh->verticesPerFace()->readable() ),
+			m_vertexIds( mesh->vertexIds()->readable() ),
+			m_p( p ),
+			m_topology( topology ),
+			m_cornerNormals( cornerNormals )
+	{
+	}
+
+	void operator()( const tbb::blocked_range<size_t> &r ) const
+	{
+		for( size_t f = r.begin(); f != r.end(); ++f )
+		{
+			const int numCorners = m_verticesPerFace[f];
+			const int *ids = &m_vertexIds[m_topology.faceOffsets[f]];
+
+			V3f faceNormal( 0 );
+			for( int i = 0; i < numCorners; ++i )
+			{
+				const V3f &p0 = m_p[ids[i]];
+				const V3f &p1 = m_p[ids[(i+1)%numCorners]];
+				faceNormal.x += ( p0.y - p1.y ) * ( p0.z + p1.z );
+				faceNormal.y += ( p0.z - p1.z ) * ( p0.x + p1.x );
+				faceNormal.z += ( p0.x - p1.x ) * ( p0.y + p1.y );
+			}
+			faceNormal.normalize();
+
+			V3f *cornerNormals = &m_cornerNormals[m_topology.faceOffsets[f]];
+			for( int i = 0; i < numCorners; ++i )
+			{
+				const float angle = cornerAngle(
+					m_p[ids[i]],
+					m_p[ids[(i+numCorners-1)%numCorners]],
+					m_p[ids[(i+1)%numCorners]]
+				);
+				cornerNormals[i] = faceNormal * angle;
+			}
+		}
+	}
+
+	private :
+
+		const vector<int> &m_verticesPerFace;
+		const vector<int> &m_vertexIds;
+		const vector<V3f> &m_p;
+		const Topology &m_topology;
+		vector<V3f> &m_cornerNormals;
+
+};
+
+// Computes u and v tangents for each face, by summing the
+// tangents of a triangle fan, and stores them for each corner.
+struct CornerTangents
+{
+
+	CornerTangents( const MeshPrimitive *mesh, const vector<V3f> &p, const vector<float> &u, const vector<float> &v, bool faceVarying, const Topology &topology, vector<V3f> &cornerUTangents, vector<V3f> &cornerVTangents )
+		:	m_verticesPerFace( mesh->verticesPerFace()->readable() ),
+			m_vertexIds( mesh->vertexIds()->readable() ),
+			m_p( p ),
+			m_u( u ),
+			m_v( v ),
+			m_faceVarying( faceVarying ),
+			m_topology( topology ),
+			m_cornerUTangents( cornerUTangents ),
+			m_cornerVTangents( cornerVTangents )
+	{
+	}
+
+	void operator()( const tbb::blocked_range<size_t> &r ) const
+	{
+		for( size_t f = r.begin(); f != r.end(); ++f )
+		{
+			const int numCorners = m_verticesPerFace[f];
+			const int faceOffset = m_topology.faceOffsets[f];
+			const int *ids = &m_vertexIds[faceOffset];
+
+			V3f uTangent( 0 );
+			V3f vTangent( 0 );
+			for( int i = 1; i < numCorners - 1; ++i )
+			{
+				const V3f &p0 = m_p[ids[0]];
+				const V3f e1 = m_p[ids[i]] - p0;
+				const V3f e2 = m_p[ids[i+1]] - p0;
+
+				const int uv0 = m_faceVarying ? faceOffset : ids[0];
+				const int uv1 = m_faceVarying ? faceOffset + i : ids[i];
+				const int uv2 = m_faceVarying ? faceOffset + i + 1 : ids[i+1];
+
+				const float du1 = m_u[uv1] - m_u[uv0];
+				const float dv1 = m_v[uv1] - m_v[uv0];
+				const float du2 = m_u[uv2] - m_u[uv0];
+				const float dv2 = m_v[uv2] - m_v[uv0];
+
+				const float d = du1 * dv2 - du2 * dv1;
+				if( d == 0.0f )
+				{
+					continue;
+				}
+
+				uTangent += ( e1 * dv2 - e2 * dv1 ) / d;
+				vTangent += ( e2 * du1 - e1 * du2 ) / d;
+			}
+
+			for( int i = 0; i < numCorners; ++i )
+			{
+				m_cornerUTangents[faceOffset + i] = uTangent;
+				m_cornerVTangents[faceOffset + i] = vTangent;
+			}
+		}
+	}
+
+	private :
+
+		const vector<int> &m_verticesPerFace;
+		const vector<int> &m_vertexIds;
+		const vector<V3f> &m_p;
+		const vector<float> &m_u;
+		const vector<float> &m_v;
+		const bool m_faceVarying;
+		const Topology &m_topology;
+		vector<V3f> &m_cornerUTangents;
+		vector<V3f> &m_cornerVTangents;
+
+};
+
+// Sums the corner values for each vertex, normalising the result.
+struct VertexSum
+{
+
+	VertexSum( const Topology &topology, const vector<V3f> &cornerValues, vector<V3f> &result )
+		:	m_topology( topology ), m_cornerValues( cornerValues ), m_result( result )
+	{
+	}
+
+	void operator()( const tbb::blocked_range<size_t> &r ) const
+	{
+		for( size_t v = r.begin(); v != r.end(); ++v )
+		{
+			V3f sum( 0 );
+			for( int i = m_topology.vertexCornerOffsets[v], e = m_topology.vertexCornerOffsets[v+1]; i < e; ++i )
+			{
+				sum += m_cornerValues[m_topology.vertexCorners[i]];
+			}
+			m_result[v] = sum.normalize();
+		}
+	}
+
+	private :
+
+		const Topology &m_topology;
+		const vector<V3f> &m_cornerValues;
+		vector<V3f> &m_result;
+
+};
+
+// Removes the component of each tangent in the direction of the normal.
+struct Orthogonalise
+{
+
+	Orthogonalise( const vector<V3f> &normals, vector<V3f> &tangents )
+		:	m_normals( normals ), m_tangents( tangents )
+	{
+	}
+
+	void operator()( const tbb::blocked_range<size_t> &r ) const
+	{
+		for( size_t i = r.begin(); i != r.end(); ++i )
+		{
+			const V3f &n = m_normals[i];
+			V3f &t = m_tangents[i];
+			t = ( t - n * n.dot( t ) ).normalize();
+		}
+	}
+
+	private :
+
+		const vector<V3f> &m_normals;
+		vector<V3f> &m_tangents;
+
+};
+
+const vector<V3f> &positions( const MeshPrimitive *mesh, const std::string &position )
+{
+	const V3fVectorData *pData = mesh->variableData<V3fVectorData>( position, PrimitiveVariable::Vertex );
+	if( !pData || pData->readable().size() != mesh->variableSize( PrimitiveVariable::Vertex ) )
+	{
+		throw InvalidArgumentException( boost::str( boost::format( "MeshAlgo : Mesh has no Vertex \"%s\" primitive variable" ) % position ) );
+	}
+	return pData->readable();
+}
+
+const vector<float> &uvs( const MeshPrimitive *mesh, const std::string &name, bool &faceVarying )
+{
+	PrimitiveVariableMap::const_iterator it = mesh->variables.find( name );
+	const FloatVectorData *data = it != mesh->variables.end() ? runTimeCast<const FloatVectorData>( it->second.data.get() ) : NULL;
+	if(
+		!data ||
+		( it->second.interpolation != PrimitiveVariable::Vertex && it->second.interpolation != PrimitiveVariable::FaceVarying ) ||
+		data->readable().size() != mesh->variableSize( it->second.interpolation )
+	)
+	{
+		throw InvalidArgumentException( boost::str( boost::format( "MeshAlgo : Mesh has no Vertex or FaceVarying float \"%s\" primitive variable" ) % name ) );
+	}
+	faceVarying = it->second.interpolation == PrimitiveVariable::FaceVarying;
+	return data->readable();
+}
+
+V3fVectorDataPtr vertexNormals( const MeshPrimitive *mesh, const vector<V3f> &p, const Topology &topology )
+{
+	vector<V3f> cornerNormals( mesh->vertexIds()->readable().size() );
+	tbb::parallel_for(
+		tbb::blocked_range<size_t>( 0, mesh->numFaces(), g_grainSize ),
+		CornerNormals( mesh, p, topology, cornerNormals )
+	);
+
+	V3fVectorDataPtr result = new V3fVectorData;
+	result->setInterpretation( GeometricData::Normal );
+	result->writable().resize( p.size() );
+	tbb::parallel_for(
+		tbb::blocked_range<size_t>( 0, p.size(), g_grainSize ),
+		VertexSum( topology, cornerNormals, result->writable() )
+	);
+
+	return result;
+}
+
+} // namespace
+
+//////////////////////////////////////////////////////////////////////////
+// Public implementation
+//////////////////////////////////////////////////////////////////////////
+
+IECore::PrimitiveVariable GafferScene::MeshAlgo::calculateNormals( const IECore::MeshPrimitive *mesh, const std::string &position )
+{
+	const vector<V3f> &p = positions( mesh, position );
+	const Topology topology( mesh );
+	return PrimitiveVariable( PrimitiveVariable::Vertex, vertexNormals( mesh, p, topology ) );
+}
+
+std::pair<IECore::PrimitiveVariable, IECore::PrimitiveVariable> GafferScene::MeshAlgo::calculateTangents(
+	const IECore::MeshPrimitive *mesh,
+	const std::string &uName,
+	const std::string &vName,
+	bool orthoTangents,
+	const std::string &position
+)
+{
+	const vector<V3f> &p = positions( mesh, position );
+
+	bool uFaceVarying, vFaceVarying;
+	const vector<float> &u = uvs( mesh, uName, uFaceVarying );
+	const vector<float> &v = uvs( mesh, vName, vFaceVarying );
+	if( uFaceVarying != vFaceVarying )
+	{
+		throw InvalidArgumentException( boost::str( boost::format( "MeshAlgo : \"%s\" and \"%s\" have different interpolations" ) % uName % vName ) );
+	}
+
+	const Topology topology( mesh );
+	const size_t numCorners = mesh->vertexIds()->readable().size();
+
+	vector<V3f> cornerUTangents( numCorners );
+	vector<V3f> cornerVTangents( numCorners );
+	tbb::parallel_for(
+		tbb::blocked_range<size_t>( 0, mesh->numFaces(), g_grainSize ),
+		CornerTangents( mesh, p, u, v, uFaceVarying, topology, cornerUTangents, cornerVTangents )
+	);
+
+	V3fVectorDataPtr uTangentsData = new V3fVectorData;
+	uTangentsData->setInterpretation( GeometricData::Vector );
+	vector<V3f> &uTangents = uTangentsData->writable();
+	uTangents.resize( p.size() );
+
+	V3fVectorDataPtr vTangentsData = new V3fVectorData;
+	vTangentsData->setInterpretation( GeometricData::Vector );
+	vector<V3f> &vTangents = vTangentsData->writable();
+	vTangents.resize( p.size() );
+
+	const tbb::blocked_range<size_t> vertexRange( 0, p.size(), g_grainSize );
+	tbb::parallel_for( vertexRange, VertexSum( topology, cornerUTangents, uTangents ) );
+	tbb::parallel_for( vertexRange, VertexSum( topology, cornerVTangents, vTangents ) );
+
+	if( orthoTangents )
+	{
+		ConstV3fVectorDataPtr normalsData = vertexNormals( mesh, p, topology );
+		const vector<V3f> &normals = normalsData->readable();
+		tbb::parallel_for( vertexRange, Orthogonalise( normals, uTangents ) );
+		tbb::parallel_for( vertexRange, Orthogonalise( normals, vTangents ) );
+	}
+
+	return std::make_pair(
+		PrimitiveVariable( PrimitiveVariable::Vertex, uTangentsData ),
+		PrimitiveVariable( PrimitiveVariable::Vertex, vTangentsData )
+	);
+}
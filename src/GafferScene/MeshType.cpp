@@ -35,11 +35,11 @@
 //////////////////////////////////////////////////////////////////////////
 
 #include "IECore/MeshPrimitive.h"
-#include "IECore/MeshNormalsOp.h"
 
 #include "Gaffer/StringPlug.h"
 
 #include "GafferScene/MeshType.h"
+#include "GafferScene/MeshAlgo.h"
 
 using namespace IECore;
 using namespace Gaffer;
@@ -161,10 +161,7 @@ IECore::ConstObjectPtr MeshType::computeProcessedObject( const ScenePath &path,
 
 	if( doNormals )
 	{
-		IECore::MeshNormalsOpPtr normalOp = new IECore::MeshNormalsOp();
-		normalOp->inputParameter()->setValue( result );
-		normalOp->copyParameter()->setTypedValue( false );
-		normalOp->operate();
+		result->variables["N"] = MeshAlgo::calculateNormals( result.get() );
 	}
 
 	return result;
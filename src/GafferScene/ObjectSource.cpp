@@ -38,6 +38,7 @@
 
 #include "IECore/NullObject.h"
 
+#include "Gaffer/Context.h"
 #include "Gaffer/StringPlug.h"
 #include "Gaffer/TransformPlug.h"
 #include "Gaffer/StringAlgo.h"
@@ -156,7 +157,7 @@ void ObjectSource::compute( Gaffer::ValuePlug *output, const Gaffer::Context *co
 
 void ObjectSource::hashAttributes( const SceneNode::ScenePath &path, const Gaffer::Context *context, const ScenePlug *parent, IECore::MurmurHash &h ) const
 {
-	h = parent->attributesPlug()->defaultValue()->Object::hash();
+	h = parent->attributesPlug()->defaultHash();
 }
 
 IECore::ConstCompoundObjectPtr ObjectSource::computeAttributes( const SceneNode::ScenePath &path, const Gaffer::Context *context, const ScenePlug *parent ) const
@@ -208,7 +209,7 @@ void ObjectSource::hashObject( const SceneNode::ScenePath &path, const Gaffer::C
 {
 	if( path.size() != 1 )
 	{
-		h = parent->objectPlug()->defaultValue()->hash();
+		h = parent->objectPlug()->defaultHash();
 		return;
 	}
 
@@ -234,7 +235,7 @@ void ObjectSource::hashChildNames( const SceneNode::ScenePath &path, const Gaffe
 		namePlug()->hash( h );
 		return;
 	}
-	h = parent->childNamesPlug()->defaultValue()->Object::hash();
+	h = parent->childNamesPlug()->defaultHash();
 }
 
 void ObjectSource::hashStandardSetNames( const Gaffer::Context *context, IECore::MurmurHash &h ) const
@@ -262,7 +263,7 @@ IECore::ConstInternedStringVectorDataPtr ObjectSource::computeChildNames( const
 
 void ObjectSource::hashGlobals( const Gaffer::Context *context, const ScenePlug *parent, IECore::MurmurHash &h ) const
 {
-	h = parent->globalsPlug()->defaultValue()->Object::hash();
+	h = parent->globalsPlug()->defaultHash();
 }
 
 IECore::ConstCompoundObjectPtr ObjectSource::computeGlobals( const Gaffer::Context *context, const ScenePlug *parent ) const
@@ -298,7 +299,7 @@ void ObjectSource::hashSet( const IECore::InternedString &setName, const Gaffer:
 	}
 	else
 	{
-		h = outPlug()->setPlug()->defaultValue()->Object::hash();
+		h = outPlug()->setPlug()->defaultHash();
 	}
 }
 
@@ -334,3 +335,49 @@ bool ObjectSource::setNameValid( const IECore::InternedString &setName ) const
 	Gaffer::StringAlgo::tokenize( setsPlug()->getValue(), ' ', setNames );
 	return std::find( setNames.begin(), setNames.end(), setName ) != setNames.end();
 }
+
+bool ObjectSource::contextDependencies( const Gaffer::ValuePlug *output, const Gaffer::Context *context, std::vector<IECore::InternedString> &variables ) const
+{
+	for( Gaffer::RecursiveInputPlugIterator it( this ); !it.done(); ++it )
+	{
+		const Gaffer::Plug *plug = it->get();
+		if( plug->children().size() )
+		{
+			continue;
+		}
+
+		const Gaffer::Plug *source = plug->source<Gaffer::Plug>();
+		if( source->direction() == Gaffer::Plug::Out && IECore::runTimeCast<const Gaffer::ComputeNode>( source->node() ) )
+		{
+			// Value is computed, and may vary with any variable.
+			return false;
+		}
+
+		const Gaffer::StringPlug *stringPlug = IECore::runTimeCast<const Gaffer::StringPlug>( plug );
+		if( stringPlug && stringPlug->hasSubstitutions() )
+		{
+			return false;
+		}
+	}
+
+	variables.push_back( ScenePlug::scenePathContextName );
+	variables.push_back( ScenePlug::setNameContextName );
+	variables.push_back( ScenePlug::levelOfDetailContextName );
+	return true;
+}
+
+Imath::V2i ObjectSource::levelOfDetailDivisions( const Imath::V2i &divisions, const Imath::V2i &minimum, const Gaffer::Context *context )
+{
+	const int lod = context->get<int>( ScenePlug::levelOfDetailContextName, 0 );
+	if( lod <= 0 )
+	{
+		return divisions;
+	}
+
+	// Avoid undefined behaviour for silly levels of detail.
+	const int shift = std::min( lod, 30 );
+	return Imath::V2i(
+		std::max( divisions.x >> shift, minimum.x ),
+		std::max( divisions.y >> shift, minimum.y )
+	);
+}
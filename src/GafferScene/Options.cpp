@@ -90,12 +90,13 @@ IECore::ConstCompoundObjectPtr Options::computeProcessedGlobals( const Gaffer::C
 		return inputGlobals;
 	}
 
-	IECore::CompoundObjectPtr result = new IECore::CompoundObject;
-	// Since we're not going to modify any existing members (only add new ones),
-	// and our result becomes const on returning it, we can directly reference
-	// the input members in our result without copying. Be careful not to modify
-	// them though!
-	result->members() = inputGlobals->members();
+	// We only make a new CompoundObject once we know we have something to
+	// add, so that globals pass through unchanged when all our options are
+	// disabled. Since we're not going to modify any existing members (only
+	// add new ones), and our result becomes const on returning it, we can
+	// directly reference the input members in our result without copying.
+	// Be careful not to modify them though!
+	IECore::CompoundObjectPtr result;
 
 	const std::string prefix = computePrefix( context );
 
@@ -105,10 +106,20 @@ IECore::ConstCompoundObjectPtr Options::computeProcessedGlobals( const Gaffer::C
 		IECore::DataPtr d = p->memberDataAndName( it->get(), name );
 		if( d )
 		{
+			if( !result )
+			{
+				result = new IECore::CompoundObject;
+				result->members() = inputGlobals->members();
+			}
 			result->members()[prefix + name] = d;
 		}
 	}
 
+	if( !result )
+	{
+		return inputGlobals;
+	}
+
 	return result;
 }
 
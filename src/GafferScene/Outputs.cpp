@@ -179,12 +179,12 @@ IECore::ConstCompoundObjectPtr Outputs::computeProcessedGlobals( const Gaffer::C
 		return inputGlobals;
 	}
 
-	IECore::CompoundObjectPtr result = new IECore::CompoundObject;
-	// Since we're not going to modify any existing members (only add new ones),
-	// and our result becomes const on returning it, we can directly reference
-	// the input members in our result without copying. Be careful not to modify
-	// them though!
-	result->members() = inputGlobals->members();
+	// As for Options, we only make a new CompoundObject once we know
+	// we have something to add. Since we're not going to modify any
+	// existing members (only add new ones), and our result becomes const
+	// on returning it, we can directly reference the input members in
+	// our result without copying. Be careful not to modify them though!
+	IECore::CompoundObjectPtr result;
 
 	// add our outputs to the result
 	for( InputValuePlugIterator it( dsp ); !it.done(); ++it )
@@ -214,11 +214,21 @@ IECore::ConstCompoundObjectPtr Outputs::computeProcessedGlobals( const Gaffer::C
 			{
 				DisplayPtr d = new Display( fileName, type, data );
 				outputPlug->getChild<CompoundDataPlug>( "parameters" )->fillCompoundData( d->parameters() );
+				if( !result )
+				{
+					result = new IECore::CompoundObject;
+					result->members() = inputGlobals->members();
+				}
 				result->members()["output:" + name] = d;
 			}
 		}
 	}
 
+	if( !result )
+	{
+		return inputGlobals;
+	}
+
 	return result;
 }
 
@@ -107,6 +107,10 @@ void PathFilter::plugDirtied( const Gaffer::Plug *plug )
 			ConstStringVectorDataPtr paths = pathsPlug()->getValue();
 			m_pathMatcher = new PathMatcherData;
 			m_pathMatcher->writable().init( paths->readable().begin(), paths->readable().end() );
+			// Hashing the PathMatcher means visiting every path in
+			// it, and we do that for every location we are asked to
+			// match, so we compute the hash once up front.
+			m_pathMatcherHash = m_pathMatcher->Object::hash();
 		}
 	}
 }
@@ -160,10 +164,17 @@ void PathFilter::hashMatch( const ScenePlug *scene, const Gaffer::Context *conte
 	}
 	if( m_pathMatcher )
 	{
-		m_pathMatcher->hash( h );
+		h.append( m_pathMatcherHash );
 	}
 	else
 	{
+		// The paths can't meaningfully depend on the location being matched,
+		// so we evaluate the PathMatcher in a context without it. This means
+		// that a single PathMatcher is built and cached per unique list of
+		// paths, rather than one per location.
+		Context::EditableScope scope( context );
+		scope.remove( ScenePlug::scenePathContextName );
+		scope.remove( Filter::inputSceneContextName );
 		pathMatcherPlug()->hash( h );
 	}
 }
@@ -176,9 +187,16 @@ unsigned PathFilter::computeMatch( const ScenePlug *scene, const Gaffer::Context
 	{
 		// If we have a precomputed PathMatcher, we use that to compute matches, otherwise
 		// we grab the PathMatcher from the intermediate plug (which is a bit more expensive
-		// as it involves graph evaluations):
+		// as it involves graph evaluations). See hashMatch() for the context we use.
 
-		ConstPathMatcherDataPtr pathMatcher = m_pathMatcher ? m_pathMatcher : pathMatcherPlug()->getValue();
+		ConstPathMatcherDataPtr pathMatcher = m_pathMatcher;
+		if( !pathMatcher )
+		{
+			Context::EditableScope scope( context );
+			scope.remove( ScenePlug::scenePathContextName );
+			scope.remove( Filter::inputSceneContextName );
+			pathMatcher = pathMatcherPlug()->getValue();
+		}
 		return pathMatcher->readable().match( pathData->readable() );
 	}
 	return NoMatch;
@@ -68,14 +68,33 @@ inline bool PathMatcher::Name::operator < ( const Name &other ) const
 // Node implementation
 //////////////////////////////////////////////////////////////////////////
 
+namespace
+{
+
+// Orders pairs by the string held in their first member.
+struct AlphabeticalLess
+{
+
+	template<typename T>
+	bool operator() ( const T &a, const T &b ) const
+	{
+		return strcmp( a.first, b.first ) < 0;
+	}
+
+};
+
+} // namespace
+
 PathMatcher::Node::Node( bool terminator )
 	:	terminator( terminator )
 {
+	hashCacheValid = false;
 }
 
 PathMatcher::Node::Node( const Node &other )
 	:	children( other.children ), terminator( other.terminator )
 {
+	hashCacheValid = false;
 }
 
 PathMatcher::Node::~Node()
@@ -121,14 +140,16 @@ bool PathMatcher::Node::operator == ( const Node &other ) const
 		return false;
 	}
 
-	for( ConstChildMapIterator it = children.begin(), eIt = children.end(); it != eIt; it++ )
+	// Both containers are sorted using the same ordering, so
+	// we can simply walk them in tandem. Subtrees shared between
+	// the two matchers don't need comparing at all.
+	for( ConstChildMapIterator it = children.begin(), eIt = children.end(), oIt = other.children.begin(); it != eIt; ++it, ++oIt )
 	{
-		ConstChildMapIterator oIt = other.children.find( it->first );
-		if( oIt == other.children.end() )
+		if( it->first < oIt->first || oIt->first < it->first )
 		{
 			return false;
 		}
-		if( !(*(it->second) == *(oIt->second) ) )
+		if( it->second != oIt->second && !( *(it->second) == *(oIt->second) ) )
 		{
 			return false;
 		}
@@ -154,6 +175,44 @@ bool PathMatcher::Node::isEmpty()
 	return !terminator && children.empty();
 }
 
+IECore::MurmurHash PathMatcher::Node::hash() const
+{
+	if( hashCacheValid )
+	{
+		return hashCache;
+	}
+
+	IECore::MurmurHash h;
+	h.append( (unsigned char)terminator );
+	h.append( (uint64_t)children.size() );
+
+	// Our children are sorted by InternedString address, which
+	// isn't stable from one process to the next, so we must
+	// visit them in alphabetical order instead.
+	typedef std::vector<std::pair<const char *, const Node *> > SortedChildren;
+	SortedChildren sortedChildren;
+	sortedChildren.reserve( children.size() );
+	for( ConstChildMapIterator it = children.begin(), eIt = children.end(); it != eIt; ++it )
+	{
+		sortedChildren.push_back( SortedChildren::value_type( it->first.name.c_str(), it->second.get() ) );
+	}
+	std::sort( sortedChildren.begin(), sortedChildren.end(), AlphabeticalLess() );
+
+	for( SortedChildren::const_iterator it = sortedChildren.begin(), eIt = sortedChildren.end(); it != eIt; ++it )
+	{
+		h.append( it->first );
+		h.append( it->second->hash() );
+	}
+
+	// Multiple threads may race to compute the hash of a shared
+	// node, but they will all compute the same value, so this is
+	// benign. The flag is atomic so that it is only seen after
+	// the hash itself has been stored.
+	hashCache = h;
+	hashCacheValid = true;
+	return h;
+}
+
 PathMatcher::Node *PathMatcher::Node::leaf()
 {
 	static NodePtr g_leaf = new Node( true );
@@ -210,6 +269,11 @@ bool PathMatcher::operator != ( const PathMatcher &other ) const
 	return !(*this == other );
 }
 
+IECore::MurmurHash PathMatcher::hash() const
+{
+	return m_root->hash();
+}
+
 unsigned PathMatcher::match( const std::string &path ) const
 {
 	if( path.empty() )
@@ -384,6 +448,14 @@ bool PathMatcher::removePath( const std::vector<IECore::InternedString> &path )
 
 bool PathMatcher::addPaths( const PathMatcher &paths )
 {
+	if( m_root->isEmpty() )
+	{
+		// Nothing to merge with, so we can simply share the
+		// other tree. Copy-on-write takes care of the rest.
+		m_root = paths.m_root;
+		return !m_root->isEmpty();
+	}
+
 	bool result = false;
 	NodePtr newRoot = addPathsWalk( m_root.get(), paths.m_root.get(), /* shared = */ false, result );
 	if( newRoot )
@@ -485,6 +557,7 @@ PathMatcher::Node *PathMatcher::writable( Node *node, NodePtr &writableCopy, boo
 {
 	if( !shared )
 	{
+		node->hashCacheValid = false;
 		return node;
 	}
 
@@ -495,6 +568,17 @@ PathMatcher::Node *PathMatcher::writable( Node *node, NodePtr &writableCopy, boo
 	return writableCopy.get();
 }
 
+void PathMatcher::dirtyHash( Node *node, bool changed, bool shared )
+{
+	// If a descendant was edited in place then our own hash is
+	// out of date, even though we haven't been edited directly.
+	// Shared nodes are never edited in place, so are left alone.
+	if( changed && !shared )
+	{
+		node->hashCacheValid = false;
+	}
+}
+
 PathMatcher::NodePtr PathMatcher::addWalk( Node *node, const NameIterator &start, const NameIterator &end, bool shared, bool &added )
 {
 	shared = shared || node->refCount() > 1;
@@ -558,6 +642,8 @@ PathMatcher::NodePtr PathMatcher::addWalk( Node *node, const NameIterator &start
 		writable( node, result, shared )->children[*start] = newChild;
 	}
 
+	dirtyHash( node, added, shared );
+
 	return result;
 }
 
@@ -603,6 +689,8 @@ PathMatcher::NodePtr PathMatcher::removeWalk( Node *node, const NameIterator &st
 		writable( node, result, shared )->children.erase( childIt->first );
 	}
 
+	dirtyHash( node, removed, shared );
+
 	return result;
 }
 
@@ -639,6 +727,8 @@ PathMatcher::NodePtr PathMatcher::addPathsWalk( Node *node, const Node *srcNode,
 		}
 	}
 
+	dirtyHash( node, added, shared );
+
 	return result;
 }
 
@@ -648,6 +738,13 @@ PathMatcher::NodePtr PathMatcher::addPrefixedPathsWalk( Node *node, const Node *
 
 	if( start == end )
 	{
+		if( node->isEmpty() )
+		{
+			// Nothing here yet, so we can graft the source tree
+			// in by reference rather than copying it.
+			added = true;
+			return const_cast<Node *>( srcNode );
+		}
 		// At the end of the prefix path. Defer to addPathsWalk()
 		// to actually add the paths.
 		return addPathsWalk( node, srcNode, shared, added );
@@ -666,6 +763,13 @@ PathMatcher::NodePtr PathMatcher::addPrefixedPathsWalk( Node *node, const Node *
 		// written to.
 		newChild = addPrefixedPathsWalk( child, srcNode, childStart, end, shared, added );
 	}
+	else if( childStart == end )
+	{
+		// No matching child, and the child is where the source
+		// paths belong. Graft the source tree in by reference.
+		newChild = const_cast<Node *>( srcNode );
+		added = true;
+	}
 	else
 	{
 		// No matching child, so make a new one.
@@ -682,6 +786,8 @@ PathMatcher::NodePtr PathMatcher::addPrefixedPathsWalk( Node *node, const Node *
 		writable( node, result, shared )->children[*start] = newChild;
 	}
 
+	dirtyHash( node, added, shared );
+
 	return result;
 }
 
@@ -715,5 +821,7 @@ PathMatcher::NodePtr PathMatcher::removePathsWalk( Node *node, const Node *srcNo
 		}
 	}
 
+	dirtyHash( node, removed, shared );
+
 	return result;
 }
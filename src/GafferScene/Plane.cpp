@@ -80,6 +80,11 @@ const Gaffer::V2iPlug *Plane::divisionsPlug() const
 	return getChild<V2iPlug>( g_firstPlugIndex + 1 );
 }
 
+Imath::V2i Plane::divisions( const Gaffer::Context *context ) const
+{
+	return levelOfDetailDivisions( divisionsPlug()->getValue(), divisionsPlug()->minValue(), context );
+}
+
 void Plane::affects( const Plug *input, AffectedPlugsContainer &outputs ) const
 {
 	ObjectSource::affects( input, outputs );
@@ -93,11 +98,11 @@ void Plane::affects( const Plug *input, AffectedPlugsContainer &outputs ) const
 void Plane::hashSource( const Gaffer::Context *context, IECore::MurmurHash &h ) const
 {
 	dimensionsPlug()->hash( h );
-	divisionsPlug()->hash( h );
+	h.append( divisions( context ) );
 }
 
 IECore::ConstObjectPtr Plane::computeSource( const Context *context ) const
 {
 	V2f dimensions = dimensionsPlug()->getValue();
-	return MeshPrimitive::createPlane( Box2f( -dimensions / 2.0f, dimensions / 2.0f ), divisionsPlug()->getValue() );
+	return MeshPrimitive::createPlane( Box2f( -dimensions / 2.0f, dimensions / 2.0f ), divisions( context ) );
 }
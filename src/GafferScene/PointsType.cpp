@@ -135,7 +135,11 @@ IECore::ConstObjectPtr PointsType::computeProcessedObject( const ScenePath &path
 		}
 	}
 
-	PointsPrimitivePtr result = inputPoints->copy();
+	// Rather than copy the input, we make a new primitive which
+	// references the input's data directly. Only the type is
+	// changed, so all other variables can be shared.
+	PointsPrimitivePtr result = new PointsPrimitive( inputPoints->variableSize( PrimitiveVariable::Vertex ) );
+	result->variables = inputPoints->variables;
 	result->variables["type"] = PrimitiveVariable( PrimitiveVariable::Constant, new StringData( type ) );
 
 	return result;
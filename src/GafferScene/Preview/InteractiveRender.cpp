@@ -721,6 +721,11 @@ const Gaffer::Context *InteractiveRender::getContext() const
 	return m_context.get();
 }
 
+IECore::CompoundDataPtr InteractiveRender::rendererStatistics() const
+{
+	return m_renderer ? m_renderer->statistics() : IECore::CompoundDataPtr();
+}
+
 void InteractiveRender::setContext( Gaffer::ContextPtr context )
 {
 	if( m_context == context )
@@ -822,6 +827,37 @@ void InteractiveRender::update()
 		);
 	}
 
+	// Update the sets before pausing, so that we know whether
+	// or not they really require us to update the render.
+
+	if( requiredState == Running && ( m_dirtyComponents & SceneGraph::SetsComponent ) )
+	{
+		const unsigned changedSets = m_renderSets.update( inPlug() );
+		if( changedSets & RendererAlgo::RenderSets::RenderSetsChanged )
+		{
+			m_dirtyComponents |= SceneGraph::RenderSetsComponent;
+		}
+		if( !( changedSets & ( RendererAlgo::RenderSets::CamerasSetChanged | RendererAlgo::RenderSets::LightsSetChanged ) ) )
+		{
+			// The camera and light sets determine which locations belong
+			// in which scene graph, but if they haven't changed then a
+			// traversal isn't required on their account.
+			m_dirtyComponents &= ~SceneGraph::SetsComponent;
+		}
+	}
+
+	// If we're already running, and nothing we output to the
+	// renderer has changed, then we don't need to pause and
+	// restart it. Restarts can be expensive, and interactive
+	// edits often produce bursts of dirtying which don't affect
+	// the render at all.
+
+	if( requiredState == Running && m_state == Running && !( m_dirtyComponents & ~SceneGraph::BoundComponent ) )
+	{
+		m_dirtyComponents = SceneGraph::NoComponent;
+		return;
+	}
+
 	// We need to pause to make edits, even if we want to
 	// be running in the end.
 	m_renderer->pause();
@@ -843,16 +879,18 @@ void InteractiveRender::update()
 		m_globals = globals;
 	}
 
-	if( m_dirtyComponents & SceneGraph::SetsComponent )
+	for( int i = SceneGraph::FirstType; i <= SceneGraph::LastType; ++i )
 	{
-		if( m_renderSets.update( inPlug() ) & RendererAlgo::RenderSets::RenderSetsChanged )
+		if( !( m_dirtyComponents & ~SceneGraph::BoundComponent ) )
 		{
-			m_dirtyComponents |= SceneGraph::RenderSetsComponent;
+			// Nothing which affects the scene graphs is dirty (bounds
+			// are not output to the renderer), so we can avoid the
+			// cost of traversing the whole scene. This is common
+			// when toggling between paused and running, or when the
+			// sets have been dirtied without actually changing.
+			break;
 		}
-	}
 
-	for( int i = SceneGraph::FirstType; i <= SceneGraph::LastType; ++i )
-	{
 		SceneGraph *sceneGraph = m_sceneGraphs[i].get();
 		if( i == SceneGraph::CameraType && ( m_dirtyComponents & SceneGraph::GlobalsComponent ) )
 		{
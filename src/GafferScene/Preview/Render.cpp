@@ -35,6 +35,8 @@
 //////////////////////////////////////////////////////////////////////////
 
 #include "boost/filesystem.hpp"
+#include "boost/chrono.hpp"
+#include "boost/format.hpp"
 
 #include "IECore/ObjectPool.h"
 
@@ -45,6 +47,7 @@
 
 #include "GafferScene/Preview/Render.h"
 #include "GafferScene/Preview/RendererAlgo.h"
+#include "GafferScene/Filter.h"
 #include "GafferScene/ScenePlug.h"
 #include "GafferScene/SceneNode.h"
 #include "GafferScene/RendererAlgo.h"
@@ -59,6 +62,37 @@ namespace
 {
 
 InternedString g_performanceMonitorOptionName( "option:render:performanceMonitor" );
+InternedString g_cameraContextName( "render:camera" );
+InternedString g_cameraOptionName( "camera" );
+
+typedef boost::chrono::duration<double> Seconds;
+
+std::string formatRendererStatistics( Seconds sceneGenerationTime, Seconds renderTime, const CompoundData *statistics )
+{
+	std::string result;
+	result += boost::str( boost::format( "%-24s : %.3fs\n" ) % "Scene generation" % sceneGenerationTime.count() );
+	result += boost::str( boost::format( "%-24s : %.3fs\n" ) % "Render" % renderTime.count() );
+
+	for( CompoundDataMap::const_iterator it = statistics->readable().begin(), eIt = statistics->readable().end(); it != eIt; ++it )
+	{
+		std::string value;
+		if( const UInt64Data *d = runTimeCast<const UInt64Data>( it->second.get() ) )
+		{
+			value = boost::str( boost::format( "%d" ) % d->readable() );
+		}
+		else if( const DoubleData *d = runTimeCast<const DoubleData>( it->second.get() ) )
+		{
+			value = boost::str( boost::format( "%.3f" ) % d->readable() );
+		}
+		else
+		{
+			value = it->second->typeName();
+		}
+		result += boost::str( boost::format( "%-24s : %s\n" ) % it->first.string() % value );
+	}
+
+	return result;
+}
 
 } // namespace
 
@@ -87,6 +121,7 @@ void Render::construct( const IECore::InternedString &rendererType )
 	addChild( new StringPlug( "fileName" ) );
 	addChild( new ScenePlug( "out", Plug::Out, Plug::Default & ~Plug::Serialisable ) );
 	outPlug()->setInput( inPlug() );
+	addChild( new StringVectorDataPlug( "cameras", Plug::In, new StringVectorData ) );
 }
 
 Render::~Render()
@@ -143,6 +178,16 @@ const ScenePlug *Render::outPlug() const
 	return getChild<ScenePlug>( g_firstPlugIndex + 4 );
 }
 
+Gaffer::StringVectorDataPlug *Render::camerasPlug()
+{
+	return getChild<StringVectorDataPlug>( g_firstPlugIndex + 5 );
+}
+
+const Gaffer::StringVectorDataPlug *Render::camerasPlug() const
+{
+	return getChild<StringVectorDataPlug>( g_firstPlugIndex + 5 );
+}
+
 IECore::MurmurHash Render::hash( const Gaffer::Context *context ) const
 {
 	if( !IECore::runTimeCast<const SceneNode>( inPlug()->source<Plug>()->node() ) )
@@ -169,17 +214,63 @@ IECore::MurmurHash Render::hash( const Gaffer::Context *context ) const
 	h.append( rendererType );
 	h.append( mode );
 	h.append( fileName );
+	camerasPlug()->hash( h );
 
 	return h;
 }
 
 void Render::execute() const
+{
+	executeInternal( /* flushCaches = */ true );
+}
+
+void Render::executeSequence( const std::vector<float> &frames ) const
+{
+	ContextPtr context = new Context( *Context::current(), Context::Borrowed );
+	Context::Scope scopedContext( context.get() );
+
+	for( std::vector<float>::const_iterator it = frames.begin(); it != frames.end(); ++it )
+	{
+		context->setFrame( *it );
+		executeInternal( /* flushCaches = */ it == frames.end() - 1 );
+	}
+}
+
+void Render::executeInternal( bool flushCaches ) const
+{
+	ConstStringVectorDataPtr camerasData = camerasPlug()->getValue();
+	const std::vector<std::string> &cameras = camerasData->readable();
+
+	if( cameras.empty() || static_cast<Mode>( modePlug()->getValue() ) == RenderMode )
+	{
+		executeCameras( cameras, flushCaches );
+		return;
+	}
+
+	// A scene description can only describe a single render, so
+	// we must translate the scene once per camera.
+	for( std::vector<std::string>::const_iterator it = cameras.begin(), eIt = cameras.end(); it != eIt; ++it )
+	{
+		executeCameras( std::vector<std::string>( 1, *it ), flushCaches && it == eIt - 1 );
+	}
+}
+
+void Render::executeCameras( const std::vector<std::string> &cameras, bool flushCaches ) const
 {
 	if( !IECore::runTimeCast<const SceneNode>( inPlug()->source<Plug>()->node() ) )
 	{
 		return;
 	}
 
+	// Everything is evaluated in the context of the first camera. The
+	// globals are reevaluated for each subsequent camera in turn.
+	ContextPtr context = new Context( *Context::current(), Context::Borrowed );
+	Context::Scope scopedContext( context.get() );
+	if( !cameras.empty() )
+	{
+		context->set( g_cameraContextName, cameras.front() );
+	}
+
 	const std::string rendererType = rendererPlug()->getValue();
 	if( rendererType.empty() )
 	{
@@ -228,33 +319,89 @@ void Render::execute() const
 	}
 	Monitor::Scope performanceMonitorScope( performanceMonitor.get() );
 
+	const boost::chrono::high_resolution_clock::time_point startTime = boost::chrono::high_resolution_clock::now();
+
 	RendererAlgo::outputOptions( globals.get(), renderer.get() );
 	RendererAlgo::outputOutputs( globals.get(), renderer.get() );
 
 	RendererAlgo::RenderSets renderSets( inPlug() );
 
+	for( std::vector<std::string>::const_iterator it = cameras.begin(), eIt = cameras.end(); it != eIt; ++it )
+	{
+		ScenePlug::ScenePath cameraPath; ScenePlug::stringToPath( *it, cameraPath );
+		if( !( renderSets.camerasSet().match( cameraPath ) & Filter::ExactMatch ) )
+		{
+			throw IECore::Exception( "Camera \"" + *it + "\" is not in the camera set" );
+		}
+	}
+
 	RendererAlgo::outputCameras( inPlug(), globals.get(), renderSets, renderer.get() );
 	RendererAlgo::outputLights( inPlug(), globals.get(), renderSets, renderer.get() );
+	/// \todo For very large scenes, rendering can't start until the whole
+	/// scene has been output here. A progressive mode would need the
+	/// Renderer API to support deferred expansion, so that we could
+	/// output bounding boxes for unexpanded locations and let the
+	/// renderer call back to us (via Arnold procedurals for instance)
+	/// to expand them on demand.
 	RendererAlgo::outputObjects( inPlug(), globals.get(), renderSets, renderer.get() );
 
 	// Now we have generated the scene, flush Cortex and Gaffer caches to
-	// provide more memory to the renderer.
-	/// \todo This is not ideal. If dispatch is batched then multiple
-	/// renders in the same process might actually benefit from sharing
-	/// the cache. And if executing directly within the gui app
-	/// flushing the caches is definitely not wanted. Since these
-	/// scenarios are currently uncommon, we prioritise the common
-	/// case of performing a single render from within `gaffer execute`,
-	/// but it would be good to do better.
-	ObjectPool::defaultObjectPool()->clear();
-	ValuePlug::clearCache();
-
-	renderer->render();
+	// provide more memory to the renderer. We don't do this for all but
+	// the last frame of a batched sequence, because the following frames
+	// can then output everything that doesn't vary with time straight
+	// from the cache.
+	/// \todo If executing directly within the gui app flushing the
+	/// caches is definitely not wanted. Since this is currently uncommon,
+	/// we prioritise the common case of rendering from within
+	/// `gaffer execute`, but it would be good to do better. It would also
+	/// be good to keep the renderer itself alive across a sequence and
+	/// send only the locations whose hashes change with frame, as
+	/// InteractiveRender does, but batch renderers don't currently
+	/// support edits after `render()`.
+	if( flushCaches )
+	{
+		ObjectPool::defaultObjectPool()->clear();
+		ValuePlug::clearCache();
+	}
+
+	const boost::chrono::high_resolution_clock::time_point sceneGenerationEndTime = boost::chrono::high_resolution_clock::now();
+
+	if( cameras.empty() )
+	{
+		renderer->render();
+	}
+	else
+	{
+		for( std::vector<std::string>::const_iterator it = cameras.begin(), eIt = cameras.end(); it != eIt; ++it )
+		{
+			if( it != cameras.begin() )
+			{
+				context->set( g_cameraContextName, *it );
+				ConstCompoundObjectPtr cameraGlobals = inPlug()->globalsPlug()->getValue();
+				GafferScene::RendererAlgo::createDisplayDirectories( cameraGlobals.get() );
+				RendererAlgo::outputOptions( cameraGlobals.get(), globals.get(), renderer.get() );
+				RendererAlgo::outputOutputs( cameraGlobals.get(), globals.get(), renderer.get() );
+				globals = cameraGlobals;
+			}
+			renderer->option( g_cameraOptionName, new StringData( *it ) );
+			renderer->render();
+		}
+	}
+
+	const boost::chrono::high_resolution_clock::time_point renderEndTime = boost::chrono::high_resolution_clock::now();
+	CompoundDataPtr rendererStatistics = performanceMonitor ? renderer->statistics() : CompoundDataPtr();
+
 	renderer.reset();
 
 	if( performanceMonitor )
 	{
 		std::cerr << "\nPerformance Monitor\n===================\n\n";
 		std::cerr << MonitorAlgo::formatStatistics( *performanceMonitor );
+		std::cerr << "\n\nRenderer Statistics\n===================\n\n";
+		std::cerr << formatRendererStatistics(
+			sceneGenerationEndTime - startTime,
+			renderEndTime - sceneGenerationEndTime,
+			rendererStatistics.get()
+		);
 	}
 }
@@ -35,21 +35,24 @@
 //
 //////////////////////////////////////////////////////////////////////////
 
-#include "tbb/task.h"
 #include "tbb/parallel_reduce.h"
 #include "tbb/blocked_range.h"
+#include "tbb/concurrent_hash_map.h"
 
 #include "boost/algorithm/string/predicate.hpp"
+#include "boost/unordered_map.hpp"
 
 #include "IECore/Interpolator.h"
 #include "IECore/NullObject.h"
 
 #include "Gaffer/Context.h"
+#include "Gaffer/StringAlgo.h"
 
 #include "GafferScene/Preview/RendererAlgo.h"
 #include "GafferScene/ScenePlug.h"
 #include "GafferScene/SceneAlgo.h"
 #include "GafferScene/RendererAlgo.h"
+#include "GafferScene/Capsule.h"
 
 using namespace std;
 using namespace Imath;
@@ -58,130 +61,47 @@ using namespace Gaffer;
 using namespace GafferScene;
 
 //////////////////////////////////////////////////////////////////////////
-// Potential replacement for SceneAlgo::parallelTraverse().
-// The original is pretty limited in that the processing at each
-// location is done in isolation, with no access to parent or child
-// results. This version copy constructs the functor for each location
-// from its parent, allowing state to be maintained through the traversal.
+// RenderSets class
 //////////////////////////////////////////////////////////////////////////
 
 namespace
 {
 
-template<typename Functor>
-class LocationTask : public tbb::task
-{
+InternedString g_camerasSetName( "__cameras" );
+InternedString g_lightsSetName( "__lights" );
+std::string g_renderSetsPrefix( "render:" );
+ConstInternedStringVectorDataPtr g_emptySetsAttribute = new InternedStringVectorData;
+InternedString g_ellipsis( "..." );
 
-	public :
+// InternedStrings are unique, so can be hashed by address.
+struct InternedStringHash
+{
 
-		LocationTask(
-			const GafferScene::ScenePlug *scene,
-			const Gaffer::Context *context,
-			const ScenePlug::ScenePath &path,
-			Functor &f
-		)
-			:	m_scene( scene ), m_context( context ), m_path( path ), m_f( f )
-		{
-		}
+	size_t operator()( const InternedString &s ) const
+	{
+		return boost::hash<const char *>()( s.c_str() );
+	}
 
-		virtual ~LocationTask()
-		{
-		}
+};
 
-		virtual task *execute()
+bool hasWildcards( const PathMatcher &pathMatcher )
+{
+	for( PathMatcher::RawIterator it = pathMatcher.begin(), eIt = pathMatcher.end(); it != eIt; ++it )
+	{
+		if( it->size() )
 		{
-			Gaffer::ContextPtr context = new Gaffer::Context( *m_context, Gaffer::Context::Borrowed );
-			context->set( ScenePlug::scenePathContextName, m_path );
-			Gaffer::Context::Scope scopedContext( context.get() );
-
-			if( !m_f( m_scene, m_path ) )
-			{
-				return NULL;
-			}
-
-			IECore::ConstInternedStringVectorDataPtr childNamesData = m_scene->childNamesPlug()->getValue();
-			const std::vector<IECore::InternedString> &childNames = childNamesData->readable();
-			if( childNames.empty() )
+			const InternedString &name = it->back();
+			if( name == g_ellipsis || StringAlgo::hasWildcards( name.c_str() ) )
 			{
-				return NULL;
+				return true;
 			}
-
-			std::vector<Functor> childFunctors( childNames.size(), m_f );
-
-			set_ref_count( 1 + childNames.size() );
-
-			ScenePlug::ScenePath childPath = m_path;
-			childPath.push_back( IECore::InternedString() ); // space for the child name
-			for( size_t i = 0, e = childNames.size(); i < e; ++i )
-			{
-				childPath.back() = childNames[i];
-				LocationTask *t = new( allocate_child() ) LocationTask( m_scene, m_context, childPath, childFunctors[i] );
-				spawn( *t );
-			}
-			wait_for_all();
-
-			return NULL;
 		}
-
-	private :
-
-		const GafferScene::ScenePlug *m_scene;
-		const Gaffer::Context *m_context;
-		const GafferScene::ScenePlug::ScenePath m_path;
-		Functor &m_f;
-
-};
-
-/// Invokes the Functor at every location in the scene,
-/// visiting parent locations before their children, but
-/// otherwise processing locations in parallel as much
-/// as possible.
-///
-/// Functor should be of the following form.
-///
-/// ```
-/// struct Functor
-/// {
-///
-///	    /// Called to construct a new functor to be used at
-///     /// each child location. This allows state to be
-///     /// accumulated as the scene is traversed, with each
-///     /// parent passing its state to its children.
-///     Functor( const Functor &parent );
-///
-///     /// Called to process a specific location. May return
-///     /// false to prune the traversal, or true to continue
-///     /// to the children.
-///     bool operator()( const ScenePlug *scene, const ScenePlug::ScenePath &path );
-///
-/// };
-/// ```
-template <class Functor>
-void parallelProcessLocations( const GafferScene::ScenePlug *scene, Functor &f )
-{
-	Gaffer::ContextPtr c = new Gaffer::Context( *Gaffer::Context::current(), Gaffer::Context::Borrowed );
-	GafferScene::Filter::setInputScene( c.get(), scene );
-	LocationTask<Functor> *task = new( tbb::task::allocate_root() ) LocationTask<Functor>( scene, c.get(), ScenePlug::ScenePath(), f );
-	tbb::task::spawn_root_and_wait( *task );
+	}
+	return false;
 }
 
 } // namespace
 
-
-//////////////////////////////////////////////////////////////////////////
-// RenderSets class
-//////////////////////////////////////////////////////////////////////////
-
-namespace
-{
-
-InternedString g_camerasSetName( "__cameras" );
-InternedString g_lightsSetName( "__lights" );
-std::string g_renderSetsPrefix( "render:" );
-ConstInternedStringVectorDataPtr g_emptySetsAttribute = new InternedStringVectorData;
-
-} // namespace
-
 namespace GafferScene
 {
 
@@ -206,8 +126,7 @@ struct RenderSets::Updater
 
 	void operator()( const tbb::blocked_range<size_t> &r )
 	{
-		ContextPtr context = new Context( *m_context, Context::Borrowed );
-		Context::Scope scopedContext( context.get() );
+		Context::EditableScope context( m_context );
 
 		for( size_t i=r.begin(); i!=r.end(); ++i )
 		{
@@ -235,7 +154,7 @@ struct RenderSets::Updater
 				potentialChange = LightsSetChanged;
 			}
 
-			context->set( ScenePlug::setNameContextName, n );
+			context.set( ScenePlug::setNameContextName, n );
 			const IECore::MurmurHash &hash = m_scene->setPlug()->hash();
 			if( s->hash != hash )
 			{
@@ -261,6 +180,80 @@ struct RenderSets::Updater
 
 };
 
+struct RenderSets::Membership
+{
+
+	Membership( const Sets &sets )
+	{
+		unsigned index = 0;
+		for( Sets::const_iterator it = sets.begin(), eIt = sets.end(); it != eIt; ++it, ++index )
+		{
+			const PathMatcher &set = it->second.set;
+			if( hasWildcards( set ) )
+			{
+				// We can't represent wildcards in our tree, so we
+				// fall back to matching these sets individually.
+				wildcardedSets.push_back( index );
+				continue;
+			}
+
+			for( PathMatcher::Iterator pIt = set.begin(), pEIt = set.end(); pIt != pEIt; ++pIt )
+			{
+				Node *node = &root;
+				for( vector<InternedString>::const_iterator nIt = pIt->begin(), nEIt = pIt->end(); nIt != nEIt; ++nIt )
+				{
+					NodePtr &child = node->children[*nIt];
+					if( !child )
+					{
+						child.reset( new Node );
+					}
+					node = child.get();
+				}
+				node->sets.push_back( index );
+				// Descendants are members by virtue of
+				// being below this location, so there is
+				// no need to visit them.
+				pIt.prune();
+			}
+		}
+	}
+
+	// A location in the tree, listing the indices
+	// of the sets which contain it.
+	struct Node
+	{
+		typedef boost::shared_ptr<Node> Ptr;
+		typedef boost::unordered_map<InternedString, Ptr, InternedStringHash> ChildMap;
+
+		vector<unsigned> sets;
+		ChildMap children;
+	};
+
+	typedef Node::Ptr NodePtr;
+
+	Node root;
+	vector<unsigned> wildcardedSets;
+
+	// Results interned by the hash of the set
+	// indices they were generated from.
+	struct HashCompare
+	{
+		static size_t hash( const MurmurHash &h )
+		{
+			return boost::hash<MurmurHash>()( h );
+		}
+
+		static bool equal( const MurmurHash &h1, const MurmurHash &h2 )
+		{
+			return h1 == h2;
+		}
+	};
+
+	typedef tbb::concurrent_hash_map<MurmurHash, ConstInternedStringVectorDataPtr, HashCompare> Attributes;
+	Attributes attributes;
+
+};
+
 RenderSets::RenderSets()
 {
 }
@@ -311,12 +304,18 @@ unsigned RenderSets::update( const ScenePlug *scene )
 	Updater updater( scene, Context::current(), *this, changed );
 	parallel_reduce( tbb::blocked_range<size_t>( 0, m_sets.size() + 2 ), updater );
 
+	if( ( updater.changed & RenderSetsChanged ) || !m_membership )
+	{
+		m_membership.reset( new Membership( m_sets ) );
+	}
+
 	return updater.changed;
 }
 
 void RenderSets::clear()
 {
 	m_sets.clear();
+	m_membership.reset();
 	m_camerasSet = Set();
 	m_lightsSet = Set();
 }
@@ -333,21 +332,67 @@ const PathMatcher &RenderSets::lightsSet() const
 
 ConstInternedStringVectorDataPtr RenderSets::setsAttribute( const std::vector<IECore::InternedString> &path ) const
 {
-	InternedStringVectorDataPtr resultData = NULL;
-	vector<InternedString> *result = NULL;
-	for( Sets::const_iterator it = m_sets.begin(), eIt = m_sets.end(); it != eIt; ++it )
+	if( !m_membership )
+	{
+		return g_emptySetsAttribute;
+	}
+
+	// Walk the tree to find the indices of all the sets
+	// containing the path or one of its ancestors.
+
+	vector<unsigned> indices;
+	const Membership::Node *node = &m_membership->root;
+	indices.insert( indices.end(), node->sets.begin(), node->sets.end() );
+	for( vector<InternedString>::const_iterator it = path.begin(), eIt = path.end(); it != eIt; ++it )
 	{
-		if( it->second.set.match( path ) & ( Filter::ExactMatch | Filter::AncestorMatch ) )
+		Membership::Node::ChildMap::const_iterator cIt = node->children.find( *it );
+		if( cIt == node->children.end() )
 		{
-			if( !result )
-			{
-				resultData = new InternedStringVectorData;
-				result = &resultData->writable();
-			}
-			result->push_back( it->second.unprefixedName );
+			break;
+		}
+		node = cIt->second.get();
+		indices.insert( indices.end(), node->sets.begin(), node->sets.end() );
+	}
+
+	for( vector<unsigned>::const_iterator it = m_membership->wildcardedSets.begin(), eIt = m_membership->wildcardedSets.end(); it != eIt; ++it )
+	{
+		if( ( m_sets.begin() + *it )->second.set.match( path ) & ( Filter::ExactMatch | Filter::AncestorMatch ) )
+		{
+			indices.push_back( *it );
 		}
 	}
-	return resultData ? resultData : g_emptySetsAttribute;
+
+	if( indices.empty() )
+	{
+		return g_emptySetsAttribute;
+	}
+
+	// Sorting gives the same order as m_sets,
+	// and a unique identifier for the result.
+
+	std::sort( indices.begin(), indices.end() );
+	MurmurHash h;
+	h.append( &indices.front(), indices.size() );
+
+	Membership::Attributes::const_accessor readAccessor;
+	if( m_membership->attributes.find( readAccessor, h ) )
+	{
+		return readAccessor->second;
+	}
+	readAccessor.release();
+
+	Membership::Attributes::accessor writeAccessor;
+	if( m_membership->attributes.insert( writeAccessor, h ) )
+	{
+		InternedStringVectorDataPtr resultData = new InternedStringVectorData;
+		vector<InternedString> &result = resultData->writable();
+		for( vector<unsigned>::const_iterator it = indices.begin(), eIt = indices.end(); it != eIt; ++it )
+		{
+			result.push_back( ( m_sets.begin() + *it )->second.unprefixedName );
+		}
+		writeAccessor->second = resultData;
+	}
+	return writeAccessor->second;
 }
 
 } // namespace RendererAlgo
@@ -405,11 +450,21 @@ struct LocationOutput
 		m_options.shutter = SceneAlgo::shutter( globals );
 
 		m_transformSamples.push_back( M44f() );
+		m_skipNextLocation = false;
+		m_capsuleRootSize = 0;
 	}
 
 	bool operator()( const ScenePlug *scene, const ScenePlug::ScenePath &path )
 	{
-		updateAttributes( scene, path );
+		if( m_skipNextLocation )
+		{
+			// Root of a Capsule being expanded. Its attributes and
+			// transform were output at the location holding the Capsule.
+			m_skipNextLocation = false;
+			return true;
+		}
+
+		updateAttributes( scene, outputPath( path ) );
 
 		if( const IECore::BoolData *d = m_attributes->member<IECore::BoolData>( g_visibleAttributeName ) )
 		{
@@ -431,6 +486,31 @@ struct LocationOutput
 			return m_renderer;
 		}
 
+		// Prepares a copy of this functor to expand a Capsule found at `path`,
+		// by traversing the Capsule's scene from its root. Locations within the
+		// Capsule are renamed to be relative to `path`, and inherit the current
+		// attributes and transform.
+		void beginCapsule( const Capsule *capsule, const ScenePlug::ScenePath &path )
+		{
+			m_capsulePath = outputPath( path );
+			m_capsuleRootSize = capsule->root().size();
+			m_skipNextLocation = true;
+		}
+
+		// Returns the path to be used in the render for a location
+		// visited during traversal, accounting for any Capsule being
+		// expanded.
+		ScenePlug::ScenePath outputPath( const ScenePlug::ScenePath &path ) const
+		{
+			if( m_capsulePath.empty() )
+			{
+				return path;
+			}
+			ScenePlug::ScenePath result( m_capsulePath );
+			result.insert( result.end(), path.begin() + m_capsuleRootSize, path.end() );
+			return result;
+		}
+
 		Imath::V2f shutter() const
 		{
 			return m_options.shutter;
@@ -592,6 +672,10 @@ struct LocationOutput
 		std::vector<M44f> m_transformSamples;
 		std::vector<float> m_transformTimes;
 
+		bool m_skipNextLocation;
+		ScenePlug::ScenePath m_capsulePath;
+		size_t m_capsuleRootSize;
+
 };
 
 struct CameraOutput : public LocationOutput
@@ -697,7 +781,8 @@ struct ObjectOutput : public LocationOutput
 			return false;
 		}
 
-		if( ( m_cameraSet.match( path ) & Filter::ExactMatch ) || ( m_lightSet.match( path ) & Filter::ExactMatch ) )
+		const ScenePlug::ScenePath renderPath = outputPath( path );
+		if( ( m_cameraSet.match( renderPath ) & Filter::ExactMatch ) || ( m_lightSet.match( renderPath ) & Filter::ExactMatch ) )
 		{
 			return true;
 		}
@@ -709,8 +794,20 @@ struct ObjectOutput : public LocationOutput
 			return true;
 		}
 
+		if( const Capsule *capsule = runTimeCast<const Capsule>( samples[0].get() ) )
+		{
+			// Expand the Capsule in place, in parallel. This is
+			// where the work saved by the Encapsulate node is done,
+			// and only if the render actually needs it.
+			ObjectOutput capsuleOutput( *this );
+			capsuleOutput.beginCapsule( capsule, path );
+			Context::Scope scopedContext( capsule->context() );
+			SceneAlgo::parallelProcessLocations( capsule->scene(), capsuleOutput, capsule->root() );
+			return true;
+		}
+
 		std::string name;
-		ScenePlug::pathToString( path, name );
+		ScenePlug::pathToString( renderPath, name );
 		IECoreScenePreview::Renderer::ObjectInterfacePtr objectInterface;
 		IECoreScenePreview::Renderer::AttributesInterfacePtr attributesInterface = attributes();
 		if( !sampleTimes.size() )
@@ -897,7 +994,7 @@ void outputCameras( const ScenePlug *scene, const IECore::CompoundObject *global
 	}
 
 	CameraOutput output( renderer, globals, renderSets );
-	parallelProcessLocations( scene, output );
+	SceneAlgo::parallelProcessLocations( scene, output );
 
 	if( !cameraOption || cameraOption->readable().empty() )
 	{
@@ -916,13 +1013,13 @@ void outputCameras( const ScenePlug *scene, const IECore::CompoundObject *global
 void outputLights( const ScenePlug *scene, const IECore::CompoundObject *globals, const RenderSets &renderSets, IECoreScenePreview::Renderer *renderer )
 {
 	LightOutput output( renderer, globals, renderSets );
-	parallelProcessLocations( scene, output );
+	SceneAlgo::parallelProcessLocations( scene, output );
 }
 
 void outputObjects( const ScenePlug *scene, const IECore::CompoundObject *globals, const RenderSets &renderSets, IECoreScenePreview::Renderer *renderer )
 {
 	ObjectOutput output( renderer, globals, renderSets );
-	parallelProcessLocations( scene, output );
+	SceneAlgo::parallelProcessLocations( scene, output );
 }
 
 void applyCameraGlobals( IECore::Camera *camera, const IECore::CompoundObject *globals )
@@ -0,0 +1,182 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2017, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//      * Redistributions of source code must retain the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer.
+//
+//      * Redistributions in binary form must reproduce the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer in the documentation and/or other materials provided with
+//        the distribution.
+//
+//      * Neither the name of John Haddon nor the names of
+//        any other contributors to this software may be used to endorse or
+//        promote products derived from this software without specific prior
+//        written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#include "tbb/blocked_range.h"
+#include "tbb/parallel_for.h"
+
+#include "IECore/VectorTypedData.h"
+
+#include "GafferScene/PrimitiveAlgo.h"
+
+using namespace std;
+using namespace Imath;
+using namespace IECore;
+using namespace GafferScene;
+
+//////////////////////////////////////////////////////////////////////////
+// Internal utilities
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+// Kernels for each interpretation. These are deliberately simple
+// loops over contiguous arrays using a matrix hoisted out of the
+// loop, so that they're amenable to vectorisation by the compiler.
+
+struct PointTransformer
+{
+
+	PointTransformer( V3f *data, const M44f &m )
+		:	m_data( data ), m_m( m )
+	{
+	}
+
+	void operator()( const tbb::blocked_range<size_t> &r ) const
+	{
+		const M44f &m = m_m;
+		for( size_t i = r.begin(); i != r.end(); ++i )
+		{
+			const V3f p = m_data[i];
+			const float x = p.x * m[0][0] + p.y * m[1][0] + p.z * m[2][0] + m[3][0];
+			const float y = p.x * m[0][1] + p.y * m[1][1] + p.z * m[2][1] + m[3][1];
+			const float z = p.x * m[0][2] + p.y * m[1][2] + p.z * m[2][2] + m[3][2];
+			const float w = p.x * m[0][3] + p.y * m[1][3] + p.z * m[2][3] + m[3][3];
+			m_data[i] = V3f( x / w, y / w, z / w );
+		}
+	}
+
+	private :
+
+		V3f *m_data;
+		const M44f m_m;
+
+};
+
+// Used for both vectors and normals - for normals the
+// matrix is the inverse transpose.
+struct DirectionTransformer
+{
+
+	DirectionTransformer( V3f *data, const M44f &m )
+		:	m_data( data ), m_m( m )
+	{
+	}
+
+	void operator()( const tbb::blocked_range<size_t> &r ) const
+	{
+		const M44f &m = m_m;
+		for( size_t i = r.begin(); i != r.end(); ++i )
+		{
+			const V3f v = m_data[i];
+			m_data[i] = V3f(
+				v.x * m[0][0] + v.y * m[1][0] + v.z * m[2][0],
+				v.x * m[0][1] + v.y * m[1][1] + v.z * m[2][1],
+				v.x * m[0][2] + v.y * m[1][2] + v.z * m[2][2]
+			);
+		}
+	}
+
+	private :
+
+		V3f *m_data;
+		const M44f m_m;
+
+};
+
+// Arrays smaller than this are processed in a single task,
+// as the overhead of parallelism would outweigh the gains.
+const size_t g_grainSize = 10000;
+
+template<typename Transformer>
+void transform( vector<V3f> &data, const M44f &m )
+{
+	if( data.empty() )
+	{
+		return;
+	}
+
+	Transformer transformer( &data[0], m );
+	tbb::parallel_for( tbb::blocked_range<size_t>( 0, data.size(), g_grainSize ), transformer );
+}
+
+} // namespace
+
+//////////////////////////////////////////////////////////////////////////
+// Public implementation
+//////////////////////////////////////////////////////////////////////////
+
+void GafferScene::PrimitiveAlgo::transformPrimitive( IECore::Primitive *primitive, const Imath::M44f &matrix )
+{
+	M44f normalMatrix;
+	bool haveNormalMatrix = false;
+
+	for( PrimitiveVariableMap::iterator it = primitive->variables.begin(), eIt = primitive->variables.end(); it != eIt; ++it )
+	{
+		V3fVectorData *data = runTimeCast<V3fVectorData>( it->second.data.get() );
+		if( !data )
+		{
+			continue;
+		}
+
+		const GeometricData::Interpretation interpretation = data->getInterpretation();
+		if( interpretation != GeometricData::Point && interpretation != GeometricData::Vector && interpretation != GeometricData::Normal )
+		{
+			continue;
+		}
+
+		// Note that writable() duplicates the data only if it is shared
+		// with another primitive, such as the input to FreezeTransform.
+		vector<V3f> &writable = data->writable();
+		switch( interpretation )
+		{
+			case GeometricData::Point :
+				transform<PointTransformer>( writable, matrix );
+				break;
+			case GeometricData::Vector :
+				transform<DirectionTransformer>( writable, matrix );
+				break;
+			default :
+				if( !haveNormalMatrix )
+				{
+					normalMatrix = matrix.inverse().transposed();
+					haveNormalMatrix = true;
+				}
+				transform<DirectionTransformer>( writable, normalMatrix );
+				break;
+		}
+	}
+}
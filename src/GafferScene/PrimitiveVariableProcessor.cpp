@@ -129,6 +129,28 @@ IECore::ConstObjectPtr PrimitiveVariableProcessor::computeProcessedObject( const
 	const std::string names = namesPlug()->getValue();
 
 	bool invert = invertNamesPlug()->getValue();
+
+	// If none of the variables match, we can pass the input through
+	// untouched rather than paying for a copy.
+	bool matched = false;
+	for( IECore::PrimitiveVariableMap::const_iterator it = inputGeometry->variables.begin(), eIt = inputGeometry->variables.end(); it != eIt; ++it )
+	{
+		if( StringAlgo::matchMultiple( it->first, names ) != invert )
+		{
+			matched = true;
+			break;
+		}
+	}
+
+	if( !matched )
+	{
+		return inputObject;
+	}
+
+	// Note that copying the primitive is relatively cheap, because
+	// Cortex's TypedData shares its storage between copies until it
+	// is modified. Only the variables we actually edit via writable()
+	// will have their arrays duplicated.
 	IECore::PrimitivePtr result = inputGeometry->copy();
 	IECore::PrimitiveVariableMap::iterator next;
 	for( IECore::PrimitiveVariableMap::iterator it = result->variables.begin(); it != result->variables.end(); it = next )
@@ -166,7 +166,7 @@ void Prune::hashChildNames( const ScenePath &path, const Gaffer::Context *contex
 
 	if( m & Filter::ExactMatch )
 	{
-		h = inPlug()->childNamesPlug()->defaultValue()->Object::hash();
+		h = inPlug()->childNamesPlug()->defaultHash();
 	}
 	else if( m & Filter::DescendantMatch )
 	{
@@ -34,6 +34,9 @@
 //
 //////////////////////////////////////////////////////////////////////////
 
+#include "tbb/blocked_range.h"
+#include "tbb/parallel_for.h"
+
 #include "boost/filesystem.hpp"
 #include "boost/algorithm/string/predicate.hpp"
 
@@ -79,6 +82,77 @@ void motionTimes( size_t segments, const V2f &shutter, std::set<float> &times )
 	}
 }
 
+// Makes a copy of the current context for each sample time.
+void sampleContexts( const std::set<float> &times, std::vector<ContextPtr> &contexts, std::vector<const Context *> &contextPointers )
+{
+	const Context *current = Context::current();
+	contexts.reserve( times.size() );
+	contextPointers.reserve( times.size() );
+	for( std::set<float>::const_iterator it = times.begin(), eIt = times.end(); it != eIt; ++it )
+	{
+		ContextPtr context = new Context( *current, Context::Borrowed );
+		context->setFrame( *it );
+		contexts.push_back( context );
+		contextPointers.push_back( context.get() );
+	}
+}
+
+// Hashes the plug at each of the sample times in parallel, returning
+// true if the hashes differ, and false if the plug is static.
+template<typename PlugType>
+bool sampleHashes( const PlugType *plug, const std::vector<const Context *> &contexts, std::vector<MurmurHash> &hashes )
+{
+	const std::vector<const ValuePlug *> plugs( contexts.size(), plug );
+	ValuePlug::hashes( plugs, contexts, hashes );
+	for( std::vector<MurmurHash>::const_iterator it = hashes.begin(), eIt = hashes.end(); it != eIt; ++it )
+	{
+		if( *it != hashes.front() )
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+// Evaluates the plug at each of the sample times in parallel,
+// using the hashes from sampleHashes().
+template<typename PlugType, typename ValueType>
+class SampleEvaluator
+{
+
+	public :
+
+		SampleEvaluator( const PlugType *plug, const std::vector<const Context *> &contexts, const std::vector<MurmurHash> &hashes, std::vector<ValueType> &values )
+			:	m_plug( plug ), m_contexts( contexts ), m_hashes( hashes ), m_values( values )
+		{
+		}
+
+		void operator()( const tbb::blocked_range<size_t> &r ) const
+		{
+			for( size_t i = r.begin(); i != r.end(); ++i )
+			{
+				Context::Scope scopedContext( m_contexts[i] );
+				m_values[i] = m_plug->getValue( &m_hashes[i] );
+			}
+		}
+
+	private :
+
+		const PlugType *m_plug;
+		const std::vector<const Context *> &m_contexts;
+		const std::vector<MurmurHash> &m_hashes;
+		std::vector<ValueType> &m_values;
+
+};
+
+template<typename PlugType, typename ValueType>
+void sampleValues( const PlugType *plug, const std::vector<const Context *> &contexts, const std::vector<MurmurHash> &hashes, std::vector<ValueType> &values )
+{
+	values.resize( contexts.size() );
+	SampleEvaluator<PlugType, ValueType> evaluator( plug, contexts, hashes, values );
+	tbb::parallel_for( tbb::blocked_range<size_t>( 0, contexts.size(), 1 ), evaluator );
+}
+
 } // namespace
 
 //////////////////////////////////////////////////////////////////////////
@@ -489,20 +563,34 @@ void transformSamples( const ScenePlug *scene, size_t segments, const Imath::V2f
 
 	motionTimes( segments, shutter, sampleTimes );
 
-	ContextPtr timeContext = new Context( *Context::current(), Context::Borrowed );
-	Context::Scope scopedTimeContext( timeContext.get() );
+	// The samples are independent of one another, so we evaluate them
+	// in parallel. But if the hashes show that the transform is static,
+	// we need only a single sample.
+
+	vector<ContextPtr> contexts; vector<const Context *> contextPointers;
+	sampleContexts( sampleTimes, contexts, contextPointers );
+
+	vector<MurmurHash> hashes;
+	if( !sampleHashes( scene->transformPlug(), contextPointers, hashes ) )
+	{
+		Context::Scope scopedContext( contextPointers.front() );
+		samples.push_back( scene->transformPlug()->getValue( &hashes.front() ) );
+		sampleTimes.clear();
+		return;
+	}
+
+	sampleValues( scene->transformPlug(), contextPointers, hashes, samples );
 
+	// Different hashes don't guarantee different values,
+	// so we must still check for a static transform.
 	bool moving = false;
-	samples.reserve( sampleTimes.size() );
-	for( std::set<float>::const_iterator it = sampleTimes.begin(), eIt = sampleTimes.end(); it != eIt; ++it )
+	for( std::vector<M44f>::const_iterator it = samples.begin(), eIt = samples.end(); it != eIt; ++it )
 	{
-		timeContext->setFrame( *it );
-		const M44f m = scene->transformPlug()->getValue();
-		if( !moving && !samples.empty() && m != samples.front() )
+		if( *it != samples.front() )
 		{
 			moving = true;
+			break;
 		}
-		samples.push_back( m );
 	}
 
 	if( !moving )
@@ -544,41 +632,51 @@ void objectSamples( const ScenePlug *scene, size_t segments, const Imath::V2f &s
 
 	motionTimes( segments, shutter, sampleTimes );
 
-	ContextPtr timeContext = new Context( *Context::current(), Context::Borrowed );
-	Context::Scope scopedTimeContext( timeContext.get() );
+	vector<ContextPtr> contexts; vector<const Context *> contextPointers;
+	sampleContexts( sampleTimes, contexts, contextPointers );
 
-	bool moving = false;
-	MurmurHash lastHash;
-	samples.reserve( sampleTimes.size() );
-	for( std::set<float>::const_iterator it = sampleTimes.begin(), eIt = sampleTimes.end(); it != eIt; ++it )
+	// If the hashes are all identical then the object is static, and
+	// we evaluate just a single sample rather than making identical
+	// copies for the renderer.
+
+	vector<MurmurHash> hashes;
+	if( !sampleHashes( scene->objectPlug(), contextPointers, hashes ) )
 	{
-		timeContext->setFrame( *it );
+		Context::Scope scopedContext( contextPointers.front() );
+		ConstObjectPtr object = scene->objectPlug()->getValue( &hashes.front() );
+		if( const VisibleRenderable *renderable = runTimeCast<const VisibleRenderable>( object.get() ) )
+		{
+			samples.push_back( renderable );
+		}
+		sampleTimes.clear();
+		return;
+	}
 
-		const MurmurHash objectHash = scene->objectPlug()->hash();
-		ConstObjectPtr object = scene->objectPlug()->getValue( &objectHash );
+	// Otherwise we evaluate all the samples in parallel, since they
+	// are independent of one another.
 
-		if( const Primitive *primitive = runTimeCast<const Primitive>( object.get() ) )
+	vector<ConstObjectPtr> objects;
+	sampleValues( scene->objectPlug(), contextPointers, hashes, objects );
+
+	bool moving = true;
+	samples.reserve( objects.size() );
+	for( vector<ConstObjectPtr>::const_iterator it = objects.begin(), eIt = objects.end(); it != eIt; ++it )
+	{
+		if( const Primitive *primitive = runTimeCast<const Primitive>( it->get() ) )
 		{
-			// We can support multiple samples for these, so check to see
-			// if we actually have something moving.
-			if( !moving && !samples.empty() && objectHash != lastHash )
-			{
-				moving = true;
-			}
+			// We can support multiple samples for these, and we know
+			// from the hashes that something is moving.
 			samples.push_back( primitive );
-			lastHash = objectHash;
-		}
-		else if( const VisibleRenderable *renderable = runTimeCast< const VisibleRenderable >( object.get() ) )
-		{
-			// We can't motion blur these chappies, so just take the one
-			// sample.
-			samples.push_back( renderable );
-			break;
 		}
 		else
 		{
-			// We don't even know what these chappies are, so
-			// don't take any samples at all.
+			// We can't motion blur anything else, so just take the
+			// one sample, assuming it is something we can render at all.
+			moving = false;
+			if( const VisibleRenderable *renderable = runTimeCast< const VisibleRenderable >( it->get() ) )
+			{
+				samples.push_back( renderable );
+			}
 			break;
 		}
 	}
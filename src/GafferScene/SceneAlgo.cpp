@@ -37,6 +37,7 @@
 #include "tbb/spin_mutex.h"
 #include "tbb/task.h"
 #include "tbb/parallel_for.h"
+#include "tbb/parallel_reduce.h"
 
 #include "boost/algorithm/string/predicate.hpp"
 
@@ -493,6 +494,141 @@ IECore::ConstCompoundDataPtr GafferScene::SceneAlgo::sets( const ScenePlug *scen
 	return result;
 }
 
+//////////////////////////////////////////////////////////////////////////
+// Bounds Algo
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+struct ChildBoundsUnion
+{
+
+	ChildBoundsUnion( const ScenePlug *scene, const ScenePlug::ScenePath &path, const std::vector<InternedString> &childNames, const Context *context )
+		:	m_scene( scene ), m_path( path ), m_childNames( childNames ), m_context( context )
+	{
+	}
+
+	ChildBoundsUnion( const ChildBoundsUnion &rhs, tbb::split )
+		:	m_scene( rhs.m_scene ), m_path( rhs.m_path ), m_childNames( rhs.m_childNames ), m_context( rhs.m_context )
+	{
+	}
+
+	void operator()( const tbb::blocked_range<size_t> &r )
+	{
+		Context::EditableScope scope( m_context );
+
+		ScenePlug::ScenePath childPath( m_path );
+		childPath.push_back( InternedString() ); // room for the child name
+
+		for( size_t i = r.begin(); i != r.end(); ++i )
+		{
+			Canceller::check( m_context->canceller() );
+			childPath.back() = m_childNames[i];
+			scope.set( ScenePlug::scenePathContextName, childPath );
+			const Box3f childBound = m_scene->boundPlug()->getValue();
+			m_union.extendBy( Imath::transform( childBound, m_scene->transformPlug()->getValue() ) );
+		}
+	}
+
+	void join( const ChildBoundsUnion &rhs )
+	{
+		m_union.extendBy( rhs.m_union );
+	}
+
+	const Box3f &result() const
+	{
+		return m_union;
+	}
+
+	private :
+
+		const ScenePlug *m_scene;
+		const ScenePlug::ScenePath &m_path;
+		const std::vector<InternedString> &m_childNames;
+		const Context *m_context;
+		Box3f m_union;
+
+};
+
+// Unlike the union, the hash would depend on the order in which
+// the results of parallel_reduce were joined, so we instead store
+// per-child hashes and append them in order afterwards.
+struct ChildBoundsHashes
+{
+
+	ChildBoundsHashes( const ScenePlug *scene, const ScenePlug::ScenePath &path, const std::vector<InternedString> &childNames, const Context *context, std::vector<MurmurHash> &hashes )
+		:	m_scene( scene ), m_path( path ), m_childNames( childNames ), m_context( context ), m_hashes( hashes )
+	{
+	}
+
+	void operator()( const tbb::blocked_range<size_t> &r ) const
+	{
+		Context::EditableScope scope( m_context );
+
+		ScenePlug::ScenePath childPath( m_path );
+		childPath.push_back( InternedString() ); // room for the child name
+
+		for( size_t i = r.begin(); i != r.end(); ++i )
+		{
+			Canceller::check( m_context->canceller() );
+			childPath.back() = m_childNames[i];
+			scope.set( ScenePlug::scenePathContextName, childPath );
+			MurmurHash &h = m_hashes[i];
+			m_scene->boundPlug()->hash( h );
+			m_scene->transformPlug()->hash( h );
+		}
+	}
+
+	private :
+
+		const ScenePlug *m_scene;
+		const ScenePlug::ScenePath &m_path;
+		const std::vector<InternedString> &m_childNames;
+		const Context *m_context;
+		std::vector<MurmurHash> &m_hashes;
+
+};
+
+} // namespace
+
+Imath::Box3f GafferScene::SceneAlgo::unionOfTransformedChildBounds( const ScenePlug *scene, const ScenePlug::ScenePath &path, const IECore::InternedStringVectorData *childNamesData )
+{
+	ConstInternedStringVectorDataPtr computedChildNames;
+	if( !childNamesData )
+	{
+		computedChildNames = scene->childNames( path );
+		childNamesData = computedChildNames.get();
+	}
+	const vector<InternedString> &childNames = childNamesData->readable();
+
+	ChildBoundsUnion unioner( scene, path, childNames, Context::current() );
+	parallel_reduce( tbb::blocked_range<size_t>( 0, childNames.size() ), unioner );
+	return unioner.result();
+}
+
+IECore::MurmurHash GafferScene::SceneAlgo::hashOfTransformedChildBounds( const ScenePlug *scene, const ScenePlug::ScenePath &path, const IECore::InternedStringVectorData *childNamesData )
+{
+	ConstInternedStringVectorDataPtr computedChildNames;
+	if( !childNamesData )
+	{
+		computedChildNames = scene->childNames( path );
+		childNamesData = computedChildNames.get();
+	}
+	const vector<InternedString> &childNames = childNamesData->readable();
+
+	vector<MurmurHash> hashes( childNames.size() );
+	ChildBoundsHashes hasher( scene, path, childNames, Context::current(), hashes );
+	parallel_for( tbb::blocked_range<size_t>( 0, childNames.size() ), hasher );
+
+	MurmurHash result;
+	for( vector<MurmurHash>::const_iterator it = hashes.begin(), eIt = hashes.end(); it != eIt; ++it )
+	{
+		result.append( *it );
+	}
+	return result;
+}
+
 Imath::Box3f GafferScene::SceneAlgo::bound( const IECore::Object *object )
 {
 	if( const IECore::VisibleRenderable *renderable = IECore::runTimeCast<const IECore::VisibleRenderable>( object ) )
@@ -253,6 +253,34 @@ IECore::ConstObjectPtr SceneElementProcessor::computeObject( const ScenePath &pa
 	}
 }
 
+const Gaffer::ValuePlug *SceneElementProcessor::passThrough( const Gaffer::ValuePlug *output, const Gaffer::Context *context ) const
+{
+	const Gaffer::ValuePlug *input = NULL;
+	bool processes = false;
+	if( output == outPlug()->transformPlug() )
+	{
+		input = inPlug()->transformPlug();
+		processes = processesTransform();
+	}
+	else if( output == outPlug()->attributesPlug() )
+	{
+		input = inPlug()->attributesPlug();
+		processes = processesAttributes();
+	}
+	else if( output == outPlug()->objectPlug() )
+	{
+		input = inPlug()->objectPlug();
+		processes = processesObject();
+	}
+
+	if( input && ( !processes || !( filterValue( context ) & Filter::ExactMatch ) ) )
+	{
+		return input;
+	}
+
+	return FilteredSceneProcessor::passThrough( output, context );
+}
+
 bool SceneElementProcessor::processesBound() const
 {
 	return false;
@@ -38,6 +38,7 @@
 #include "Gaffer/Context.h"
 
 #include "GafferScene/SceneNode.h"
+#include "GafferScene/SceneAlgo.h"
 
 using namespace std;
 using namespace Imath;
@@ -357,58 +358,19 @@ IECore::MurmurHash SceneNode::hashOfTransformedChildBounds( const ScenePath &pat
 		computedChildNames = out->childNames( path );
 		childNamesData = computedChildNames.get();
 	}
-	const vector<InternedString> &childNames = childNamesData->readable();
 
-	IECore::MurmurHash result;
-	if( childNames.size() )
-	{
-		ContextPtr tmpContext = new Context( *Context::current(), Context::Borrowed );
-		Context::Scope scopedContext( tmpContext.get() );
-
-		ScenePath childPath( path );
-		childPath.push_back( InternedString() ); // room for the child name
-		for( vector<InternedString>::const_iterator it = childNames.begin(); it != childNames.end(); it++ )
-		{
-			childPath[path.size()] = *it;
-			tmpContext->set( ScenePlug::scenePathContextName, childPath );
-			out->boundPlug()->hash( result );
-			out->transformPlug()->hash( result );
-		}
-	}
-	else
+	if( childNamesData->readable().empty() )
 	{
+		IECore::MurmurHash result;
 		result.append( typeId() );
 		result.append( "emptyBound" );
+		return result;
 	}
-	return result;
+
+	return SceneAlgo::hashOfTransformedChildBounds( out, path, childNamesData );
 }
 
 Imath::Box3f SceneNode::unionOfTransformedChildBounds( const ScenePath &path, const ScenePlug *out, const IECore::InternedStringVectorData *childNamesData ) const
 {
-	ConstInternedStringVectorDataPtr computedChildNames;
-	if( !childNamesData )
-	{
-		computedChildNames = out->childNames( path );
-		childNamesData = computedChildNames.get();
-	}
-	const vector<InternedString> &childNames = childNamesData->readable();
-
-	Box3f result;
-	if( childNames.size() )
-	{
-		ContextPtr tmpContext = new Context( *Context::current(), Context::Borrowed );
-		Context::Scope scopedContext( tmpContext.get() );
-
-		ScenePath childPath( path );
-		childPath.push_back( InternedString() ); // room for the child name
-		for( vector<InternedString>::const_iterator it = childNames.begin(); it != childNames.end(); it++ )
-		{
-			childPath[path.size()] = *it;
-			tmpContext->set( ScenePlug::scenePathContextName, childPath );
-			Box3f childBound = out->boundPlug()->getValue();
-			childBound = transform( childBound, out->transformPlug()->getValue() );
-			result.extendBy( childBound );
-		}
-	}
-	return result;
+	return SceneAlgo::unionOfTransformedChildBounds( out, path, childNamesData );
 }
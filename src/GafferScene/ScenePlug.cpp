@@ -39,6 +39,7 @@
 
 #include "Gaffer/Context.h"
 #include "Gaffer/StringAlgo.h"
+#include "Gaffer/Private/IECorePreview/LRUCache.h"
 
 #include "GafferScene/ScenePlug.h"
 #include "GafferScene/PathMatcherData.h"
@@ -66,6 +67,62 @@ void removeNonGlobalContextVariables( Context *context )
 	context->remove( ScenePlug::scenePathContextName );
 }
 
+// Caches for the accumulated transforms and attributes at each location,
+// keyed by the combined hashes of the location and all its ancestors.
+// These allow fullTransform() and fullAttributes() to reuse the results
+// for shared ancestors, rather than starting again at the root for every
+// location. We only ever use getIfCached() and setIfUncached().
+
+typedef IECorePreview::LRUCache<IECore::MurmurHash, Imath::M44f> FullTransformCache;
+typedef IECorePreview::LRUCache<IECore::MurmurHash, IECore::ConstCompoundObjectPtr> FullAttributesCache;
+
+Imath::M44f fullTransformCacheGetter( const IECore::MurmurHash &h, size_t &cost )
+{
+	throw IECore::Exception( "Unexpected call to fullTransformCacheGetter" );
+}
+
+IECore::ConstCompoundObjectPtr fullAttributesCacheGetter( const IECore::MurmurHash &h, size_t &cost )
+{
+	throw IECore::Exception( "Unexpected call to fullAttributesCacheGetter" );
+}
+
+template<typename T>
+size_t unitCost( const T &value )
+{
+	return 1;
+}
+
+FullTransformCache &fullTransformCache()
+{
+	static FullTransformCache *g_cache = new FullTransformCache( fullTransformCacheGetter, 100000 );
+	return *g_cache;
+}
+
+FullAttributesCache &fullAttributesCache()
+{
+	static FullAttributesCache *g_cache = new FullAttributesCache( fullAttributesCacheGetter, 10000 );
+	return *g_cache;
+}
+
+// Fills `hashes` with the accumulated hash of `plug` at each location
+// from the root down to `scenePath`, so that `hashes[i]` identifies the
+// value at the location with `i + 1` path elements.
+void ancestorHashes( const ValuePlug *plug, const ScenePlug::ScenePath &scenePath, Context::EditableScope &context, std::vector<IECore::MurmurHash> &hashes )
+{
+	hashes.resize( scenePath.size() );
+
+	IECore::MurmurHash h;
+	ScenePlug::ScenePath path;
+	path.reserve( scenePath.size() );
+	for( size_t i = 0, e = scenePath.size(); i < e; ++i )
+	{
+		path.push_back( scenePath[i] );
+		context.set( ScenePlug::scenePathContextName, path );
+		plug->hash( h );
+		hashes[i] = h;
+	}
+}
+
 } // namespace
 
 //////////////////////////////////////////////////////////////////////////
@@ -76,6 +133,7 @@ IE_CORE_DEFINERUNTIMETYPED( ScenePlug );
 
 const IECore::InternedString ScenePlug::scenePathContextName( "scene:path" );
 const IECore::InternedString ScenePlug::setNameContextName( "scene:setName" );
+const IECore::InternedString ScenePlug::levelOfDetailContextName( "scene:lod" );
 
 ScenePlug::ScenePlug( const std::string &name, Direction direction, unsigned flags )
 	:	ValuePlug( name, direction, flags )
@@ -273,32 +331,49 @@ const PathMatcherDataPlug *ScenePlug::setPlug() const
 
 Imath::Box3f ScenePlug::bound( const ScenePath &scenePath ) const
 {
-	ContextPtr tmpContext = new Context( *Context::current(), Context::Borrowed );
-	tmpContext->set( scenePathContextName, scenePath );
-	Context::Scope scopedContext( tmpContext.get() );
+	Context::EditableScope tmpContext( Context::current() );
+	tmpContext.set( scenePathContextName, scenePath );
 	return boundPlug()->getValue();
 }
 
 Imath::M44f ScenePlug::transform( const ScenePath &scenePath ) const
 {
-	ContextPtr tmpContext = new Context( *Context::current(), Context::Borrowed );
-	tmpContext->set( scenePathContextName, scenePath );
-	Context::Scope scopedContext( tmpContext.get() );
+	Context::EditableScope tmpContext( Context::current() );
+	tmpContext.set( scenePathContextName, scenePath );
 	return transformPlug()->getValue();
 }
 
 Imath::M44f ScenePlug::fullTransform( const ScenePath &scenePath ) const
 {
-	ContextPtr tmpContext = new Context( *Context::current(), Context::Borrowed );
-	Context::Scope scopedContext( tmpContext.get() );
+	Context::EditableScope tmpContext( Context::current() );
+
+	std::vector<IECore::MurmurHash> hashes;
+	ancestorHashes( transformPlug(), scenePath, tmpContext, hashes );
+
+	// Find the deepest ancestor we already have a result for.
+
+	FullTransformCache &cache = fullTransformCache();
 
 	Imath::M44f result;
-	ScenePath path( scenePath );
-	while( path.size() )
+	size_t depth = scenePath.size();
+	for( ; depth; --depth )
+	{
+		if( boost::optional<Imath::M44f> cached = cache.getIfCached( hashes[depth-1] ) )
+		{
+			result = *cached;
+			break;
+		}
+	}
+
+	// And accumulate the rest from there, caching as we go.
+
+	ScenePath path( scenePath.begin(), scenePath.begin() + depth );
+	for( ; depth < scenePath.size(); ++depth )
 	{
-		tmpContext->set( scenePathContextName, path );
-		result = result * transformPlug()->getValue();
-		path.pop_back();
+		path.push_back( scenePath[depth] );
+		tmpContext.set( scenePathContextName, path );
+		result = transformPlug()->getValue() * result;
+		cache.setIfUncached( hashes[depth], result, unitCost<Imath::M44f> );
 	}
 
 	return result;
@@ -306,51 +381,79 @@ Imath::M44f ScenePlug::fullTransform( const ScenePath &scenePath ) const
 
 IECore::ConstCompoundObjectPtr ScenePlug::attributes( const ScenePath &scenePath ) const
 {
-	ContextPtr tmpContext = new Context( *Context::current(), Context::Borrowed );
-	tmpContext->set( scenePathContextName, scenePath );
-	Context::Scope scopedContext( tmpContext.get() );
+	Context::EditableScope tmpContext( Context::current() );
+	tmpContext.set( scenePathContextName, scenePath );
 	return attributesPlug()->getValue();
 }
 
 IECore::CompoundObjectPtr ScenePlug::fullAttributes( const ScenePath &scenePath ) const
 {
-	ContextPtr tmpContext = new Context( *Context::current(), Context::Borrowed );
-	Context::Scope scopedContext( tmpContext.get() );
+	Context::EditableScope tmpContext( Context::current() );
+
+	std::vector<IECore::MurmurHash> hashes;
+	ancestorHashes( attributesPlug(), scenePath, tmpContext, hashes );
+
+	// Find the deepest ancestor we already have a result for.
+
+	FullAttributesCache &cache = fullAttributesCache();
+
+	IECore::ConstCompoundObjectPtr parentAttributes;
+	size_t depth = scenePath.size();
+	for( ; depth; --depth )
+	{
+		if( boost::optional<IECore::ConstCompoundObjectPtr> cached = cache.getIfCached( hashes[depth-1] ) )
+		{
+			parentAttributes = *cached;
+			break;
+		}
+	}
+
+	// And accumulate the rest from there, caching as we go. Child
+	// attributes take precedence over those inherited from the parent.
 
 	IECore::CompoundObjectPtr result = new IECore::CompoundObject;
-	IECore::CompoundObject::ObjectMap &resultMembers = result->members();
-	ScenePath path( scenePath );
-	while( path.size() )
+	if( parentAttributes )
 	{
-		tmpContext->set( scenePathContextName, path );
+		result->members() = parentAttributes->members();
+	}
+
+	ScenePath path( scenePath.begin(), scenePath.begin() + depth );
+	for( ; depth < scenePath.size(); ++depth )
+	{
+		path.push_back( scenePath[depth] );
+		tmpContext.set( scenePathContextName, path );
 		IECore::ConstCompoundObjectPtr a = attributesPlug()->getValue();
-		const IECore::CompoundObject::ObjectMap &aMembers = a->members();
-		for( IECore::CompoundObject::ObjectMap::const_iterator it = aMembers.begin(), eIt = aMembers.end(); it != eIt; it++ )
+		if( !a->members().empty() )
 		{
-			if( resultMembers.find( it->first ) == resultMembers.end() )
+			IECore::CompoundObjectPtr accumulated = new IECore::CompoundObject;
+			accumulated->members() = result->members();
+			for( IECore::CompoundObject::ObjectMap::const_iterator it = a->members().begin(), eIt = a->members().end(); it != eIt; ++it )
 			{
-				resultMembers.insert( *it );
+				accumulated->members()[it->first] = it->second;
 			}
+			result = accumulated;
 		}
-		path.pop_back();
+		cache.setIfUncached( hashes[depth], result, unitCost<IECore::ConstCompoundObjectPtr> );
 	}
 
-	return result;
+	// The cached result must not be modified, but we are
+	// returning a non-const object, so we return a shallow copy.
+	IECore::CompoundObjectPtr copy = new IECore::CompoundObject;
+	copy->members() = result->members();
+	return copy;
 }
 
 IECore::ConstObjectPtr ScenePlug::object( const ScenePath &scenePath ) const
 {
-	ContextPtr tmpContext = new Context( *Context::current(), Context::Borrowed );
-	tmpContext->set( scenePathContextName, scenePath );
-	Context::Scope scopedContext( tmpContext.get() );
+	Context::EditableScope tmpContext( Context::current() );
+	tmpContext.set( scenePathContextName, scenePath );
 	return objectPlug()->getValue();
 }
 
 IECore::ConstInternedStringVectorDataPtr ScenePlug::childNames( const ScenePath &scenePath ) const
 {
-	ContextPtr tmpContext = new Context( *Context::current(), Context::Borrowed );
-	tmpContext->set( scenePathContextName, scenePath );
-	Context::Scope scopedContext( tmpContext.get() );
+	Context::EditableScope tmpContext( Context::current() );
+	tmpContext.set( scenePathContextName, scenePath );
 	return childNamesPlug()->getValue();
 }
 
@@ -373,7 +476,7 @@ IECore::ConstInternedStringVectorDataPtr ScenePlug::setNames() const
 ConstPathMatcherDataPtr ScenePlug::set( const IECore::InternedString &setName ) const
 {
 	ContextPtr tmpContext = new Context( *Context::current(), Context::Borrowed );
-	tmpContext->set( setNameContextName, setName );
+	tmpContext.set( setNameContextName, setName );
 	removeNonGlobalContextVariables( tmpContext.get() );
 	Context::Scope scopedContext( tmpContext.get() );
 	return setPlug()->getValue();
@@ -381,76 +484,55 @@ ConstPathMatcherDataPtr ScenePlug::set( const IECore::InternedString &setName )
 
 IECore::MurmurHash ScenePlug::boundHash( const ScenePath &scenePath ) const
 {
-	ContextPtr tmpContext = new Context( *Context::current(), Context::Borrowed );
-	tmpContext->set( scenePathContextName, scenePath );
-	Context::Scope scopedContext( tmpContext.get() );
+	Context::EditableScope tmpContext( Context::current() );
+	tmpContext.set( scenePathContextName, scenePath );
 	return boundPlug()->hash();
 }
 
 IECore::MurmurHash ScenePlug::transformHash( const ScenePath &scenePath ) const
 {
-	ContextPtr tmpContext = new Context( *Context::current(), Context::Borrowed );
-	tmpContext->set( scenePathContextName, scenePath );
-	Context::Scope scopedContext( tmpContext.get() );
+	Context::EditableScope tmpContext( Context::current() );
+	tmpContext.set( scenePathContextName, scenePath );
 	return transformPlug()->hash();
 }
 
 IECore::MurmurHash ScenePlug::fullTransformHash( const ScenePath &scenePath ) const
 {
-	ContextPtr tmpContext = new Context( *Context::current(), Context::Borrowed );
-	Context::Scope scopedContext( tmpContext.get() );
-
-	IECore::MurmurHash result;
-	ScenePath path( scenePath );
-	while( path.size() )
-	{
-		tmpContext->set( scenePathContextName, path );
-		transformPlug()->hash( result );
-		path.pop_back();
-	}
+	Context::EditableScope tmpContext( Context::current() );
 
-	return result;
+	std::vector<IECore::MurmurHash> hashes;
+	ancestorHashes( transformPlug(), scenePath, tmpContext, hashes );
+	return hashes.size() ? hashes.back() : IECore::MurmurHash();
 }
 
 IECore::MurmurHash ScenePlug::attributesHash( const ScenePath &scenePath ) const
 {
-	ContextPtr tmpContext = new Context( *Context::current(), Context::Borrowed );
-	tmpContext->set( scenePathContextName, scenePath );
-	Context::Scope scopedContext( tmpContext.get() );
+	Context::EditableScope tmpContext( Context::current() );
+	tmpContext.set( scenePathContextName, scenePath );
 	return attributesPlug()->hash();
 }
 
 IECore::MurmurHash ScenePlug::fullAttributesHash( const ScenePath &scenePath ) const
 {
-	ContextPtr tmpContext = new Context( *Context::current(), Context::Borrowed );
-	Context::Scope scopedContext( tmpContext.get() );
-
-	IECore::MurmurHash result;
-	ScenePath path( scenePath );
-	while( path.size() )
-	{
-		tmpContext->set( scenePathContextName, path );
-		attributesPlug()->hash( result );
-		path.pop_back();
-	}
+	Context::EditableScope tmpContext( Context::current() );
 
-	return result;
+	std::vector<IECore::MurmurHash> hashes;
+	ancestorHashes( attributesPlug(), scenePath, tmpContext, hashes );
+	return hashes.size() ? hashes.back() : IECore::MurmurHash();
 }
 
 IECore::MurmurHash ScenePlug::objectHash( const ScenePath &scenePath ) const
 {
-	ContextPtr tmpContext = new Context( *Context::current(), Context::Borrowed );
-	tmpContext->set( scenePathContextName, scenePath );
-	Context::Scope scopedContext( tmpContext.get() );
+	Context::EditableScope tmpContext( Context::current() );
+	tmpContext.set( scenePathContextName, scenePath );
 	return objectPlug()->hash();
 
 }
 
 IECore::MurmurHash ScenePlug::childNamesHash( const ScenePath &scenePath ) const
 {
-	ContextPtr tmpContext = new Context( *Context::current(), Context::Borrowed );
-	tmpContext->set( scenePathContextName, scenePath );
-	Context::Scope scopedContext( tmpContext.get() );
+	Context::EditableScope tmpContext( Context::current() );
+	tmpContext.set( scenePathContextName, scenePath );
 	return childNamesPlug()->hash();
 }
 
@@ -473,7 +555,7 @@ IECore::MurmurHash ScenePlug::setNamesHash() const
 IECore::MurmurHash ScenePlug::setHash( const IECore::InternedString &setName ) const
 {
 	ContextPtr tmpContext = new Context( *Context::current(), Context::Borrowed );
-	tmpContext->set( setNameContextName, setName );
+	tmpContext.set( setNameContextName, setName );
 	removeNonGlobalContextVariables( tmpContext.get() );
 	Context::Scope scopedContext( tmpContext.get() );
 	return setPlug()->hash();
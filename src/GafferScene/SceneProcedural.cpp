@@ -35,9 +35,10 @@
 //////////////////////////////////////////////////////////////////////////
 
 #include "tbb/parallel_for.h"
-#include "tbb/task_scheduler_init.h"
+#include "tbb/task_arena.h"
 
 #include "boost/lexical_cast.hpp"
+#include "boost/bind.hpp"
 
 #include "OpenEXR/ImathBoxAlgo.h"
 #include "OpenEXR/ImathFun.h"
@@ -99,56 +100,76 @@ static InternedString g_deformationBlurSegmentsAttributeName( "gaffer:deformatio
 // - We now have 4 side by side renders each trying to take over the machine,
 //   and a not-so-happy IT department.
 //
-// The "solution" to this is to explicitly initialise TBB every time a procedural
-// is invoked, limiting it to a certain number of threads. Problem solved? Maybe.
-// There's another wrinkle, in that TBB is initialised separately for each master
-// thread, and if each master asks for a maximum of N threads, and there are M masters,
-// TBB might actually make up to `M * N` threads, clamped at the number of cores.
-// So with N set to 8, you could still get a single process trying to use the
-// whole machine. In practice, it appears that 3delight perhaps doesn't make great
-// use of procedural concurrency, so the worst case of M procedurals in flight,
-// each trying to use N threads may not occur. What other renderers do in this
-// situation is unknown.
+// Our original "solution" to this was to explicitly initialise TBB every time a
+// procedural was invoked, limiting it to a certain number of threads. But TBB is
+// initialised separately for each master thread, and if each master asks for a
+// maximum of N threads, and there are M masters, TBB might actually make up to
+// `M * N` threads, clamped at the number of cores.
 //
-// I strongly suspect that the long term solution to this is to abandon using
+// We now perform all procedural work inside a single task_arena shared by all
+// master threads. The arena's concurrency is fixed, so no matter how many
+// masters the renderer calls us from, the total number of threads working on
+// Gaffer computes is bounded. Masters which arrive when the arena is full
+// simply queue their work until a slot becomes free.
+//
+// The concurrency limit is taken from the GAFFERSCENE_SCENEPROCEDURAL_THREADS
+// environment variable, so that it can be matched to the thread count given
+// to the renderer. If it is not set, we leave TBB to its own devices.
+//
+// I still suspect that the long term solution to this is to abandon using
 // a procedural hierarchy matching the scene hierarchy, and to do our own
 // threaded traversal of the scene, outputting the results to the renderer via
 // a single master thread. We could then be sure of our resource usage, and
 // also get better performance with renderers unable to make best use of
 // procedural concurrency.
 //
-// In the meantime, we introduce a hack. The GAFFERSCENE_SCENEPROCEDURAL_THREADS
-// environment variable may be used to clamp the number of threads used by any
-// given master thread. We sincerely hope to have a better solution before too
-// long.
-//
 // Worthwhile reading :
 //
 // https://software.intel.com/en-us/blogs/2011/04/09/tbb-initialization-termination-and-resource-management-details-juicy-and-gory/
 //
-void initializeTaskScheduler( tbb::task_scheduler_init &tsi )
+namespace
 {
-	assert( !tsi.is_active() );
 
-	static int g_maxThreads = -1;
-	if( g_maxThreads == -1 )
+tbb::task_arena *createTaskArena()
+{
+	int maxThreads = 0;
+	if( const char *c = getenv( "GAFFERSCENE_SCENEPROCEDURAL_THREADS" ) )
 	{
-		if( const char *c = getenv( "GAFFERSCENE_SCENEPROCEDURAL_THREADS" ) )
-		{
-			g_maxThreads = boost::lexical_cast<int>( c );
-		}
-		else
-		{
-			g_maxThreads = 0;
-		}
+		maxThreads = boost::lexical_cast<int>( c );
 	}
 
-	if( g_maxThreads > 0 )
+	if( maxThreads > 0 )
 	{
-		tsi.initialize( g_maxThreads );
+		// Deliberately leaked, since destroying an arena during
+		// static destruction isn't safe.
+		return new tbb::task_arena( maxThreads );
 	}
+	return NULL;
+}
+
+// Returns the arena used for all procedural work, or NULL
+// if the thread count is unlimited.
+tbb::task_arena *taskArena()
+{
+	static tbb::task_arena *g_arena = createTaskArena();
+	return g_arena;
 }
 
+template<typename F>
+void executeInArena( const F &f )
+{
+	if( tbb::task_arena *arena = taskArena() )
+	{
+		arena->execute( f );
+	}
+	else
+	{
+		f();
+	}
+}
+
+} // namespace
+
 tbb::atomic<int> SceneProcedural::g_pendingSceneProcedurals;
 tbb::mutex SceneProcedural::g_allRenderedMutex;
 
@@ -157,9 +178,12 @@ SceneProcedural::AllRenderedSignal SceneProcedural::g_allRenderedSignal;
 SceneProcedural::SceneProcedural( ConstScenePlugPtr scenePlug, const Gaffer::Context *context, const ScenePlug::ScenePath &scenePath, bool computeBound )
 	:	m_scenePlug( scenePlug ), m_context( new Context( *context ) ), m_scenePath( scenePath ), m_rendered( false )
 {
-	tbb::task_scheduler_init tsi( tbb::task_scheduler_init::deferred );
-	initializeTaskScheduler( tsi );
+	executeInArena( boost::bind( &SceneProcedural::construct, this, computeBound ) );
+	++g_pendingSceneProcedurals;
+}
 
+void SceneProcedural::construct( bool computeBound )
+{
 	// get a reference to the script node to prevent it being destroyed while we're doing a render:
 	m_scriptNode = m_scenePlug->ancestor<ScriptNode>();
 
@@ -196,16 +220,14 @@ SceneProcedural::SceneProcedural( ConstScenePlugPtr scenePlug, const Gaffer::Con
 
 	updateAttributes();
 	initBound( computeBound );
-
-	++g_pendingSceneProcedurals;
 }
 
 SceneProcedural::SceneProcedural( const SceneProcedural &other, const ScenePlug::ScenePath &scenePath )
 	:	m_scenePlug( other.m_scenePlug ), m_context( new Context( *(other.m_context), Context::Shared ) ), m_scenePath( scenePath ),
 		m_options( other.m_options ), m_attributes( other.m_attributes ), m_rendered( false )
 {
-	tbb::task_scheduler_init tsi( tbb::task_scheduler_init::deferred );
-	initializeTaskScheduler( tsi );
+	// Child procedurals are only constructed from within render(),
+	// so we're already executing in the task arena.
 
 	// get a reference to the script node to prevent it being destroyed while we're doing a render:
 	m_scriptNode = m_scenePlug->ancestor<ScriptNode>();
@@ -346,9 +368,11 @@ class SceneProcedural::SceneProceduralCreate
 
 void SceneProcedural::render( Renderer *renderer ) const
 {
-	tbb::task_scheduler_init tsi( tbb::task_scheduler_init::deferred );
-	initializeTaskScheduler( tsi );
+	executeInArena( boost::bind( &SceneProcedural::renderInternal, this, renderer ) );
+}
 
+void SceneProcedural::renderInternal( IECore::Renderer *renderer ) const
+{
 	Context::Scope scopedContext( m_context.get() );
 
 	std::string name;
@@ -153,3 +153,14 @@ void SceneProcessor::compute( Gaffer::ValuePlug *output, const Gaffer::Context *
 		SceneNode::compute( output, context );
 	}
 }
+
+const Gaffer::ValuePlug *SceneProcessor::passThrough( const Gaffer::ValuePlug *output, const Gaffer::Context *context ) const
+{
+	const ScenePlug *scenePlug = output->parent<ScenePlug>();
+	if( scenePlug && !enabledPlug()->getValue() )
+	{
+		return inPlug()->getChild<ValuePlug>( output->getName() );
+	}
+
+	return SceneNode::passThrough( output, context );
+}
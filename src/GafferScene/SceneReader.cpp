@@ -36,6 +36,16 @@
 
 #include "boost/bind.hpp"
 
+#include "tbb/blocked_range.h"
+#include "tbb/parallel_for.h"
+#include "tbb/parallel_reduce.h"
+#include "tbb/enumerable_thread_specific.h"
+#include "tbb/atomic.h"
+
+#include <map>
+
+#include "boost/unordered_map.hpp"
+
 #include "IECore/SharedSceneInterfaces.h"
 #include "IECore/InternedString.h"
 #include "IECore/SceneCache.h"
@@ -43,6 +53,7 @@
 #include "Gaffer/Context.h"
 #include "Gaffer/StringAlgo.h"
 #include "Gaffer/StringPlug.h"
+#include "Gaffer/TypedObjectPlug.h"
 
 #include "GafferScene/SceneReader.h"
 #include "GafferScene/PathMatcherData.h"
@@ -55,6 +66,265 @@ using namespace GafferScene;
 
 typedef boost::tokenizer<boost::char_separator<char> > Tokenizer;
 
+//////////////////////////////////////////////////////////////////////////
+// Internal utilities
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+typedef std::map<InternedString, PathMatcher> Sets;
+
+void loadSetsWalk( const SceneInterface *s, Sets &sets, const Canceller *canceller );
+
+// Merges `src` into `dst`, with the paths in `src` being
+// relative to `prefix`.
+void addSets( Sets &dst, const Sets &src, const vector<InternedString> &prefix )
+{
+	for( Sets::const_iterator it = src.begin(), eIt = src.end(); it != eIt; ++it )
+	{
+		dst[it->first].addPaths( it->second, prefix );
+	}
+}
+
+// Loads the sets for each of the children of a location in parallel,
+// with each task accumulating into its own PathMatchers. Thanks to the
+// structural sharing in PathMatcher, merging the results is cheap.
+class LoadSetsChildren
+{
+
+	public :
+
+		LoadSetsChildren( const SceneInterface *s, const SceneInterface::NameList &childNames, const Canceller *canceller )
+			:	m_scene( s ), m_childNames( childNames ), m_canceller( canceller )
+		{
+		}
+
+		LoadSetsChildren( LoadSetsChildren &other, tbb::split )
+			:	m_scene( other.m_scene ), m_childNames( other.m_childNames ), m_canceller( other.m_canceller )
+		{
+		}
+
+		void operator() ( const tbb::blocked_range<size_t> &r )
+		{
+			vector<InternedString> childPath( 1 );
+			for( size_t i = r.begin(); i != r.end(); ++i )
+			{
+				ConstSceneInterfacePtr child = m_scene->child( m_childNames[i] );
+				Sets childSets;
+				loadSetsWalk( child.get(), childSets, m_canceller );
+				childPath.back() = m_childNames[i];
+				addSets( m_sets, childSets, childPath );
+			}
+		}
+
+		void join( LoadSetsChildren &rhs )
+		{
+			addSets( m_sets, rhs.m_sets, vector<InternedString>() );
+		}
+
+		const Sets &sets() const
+		{
+			return m_sets;
+		}
+
+	private :
+
+		const SceneInterface *m_scene;
+		const SceneInterface::NameList &m_childNames;
+		const Canceller *m_canceller;
+		Sets m_sets;
+
+};
+
+// Fills `sets` with every set in the scene below `s`, in a single
+// traversal, with paths relative to `s`. This is much quicker than
+// traversing once per set when there are many sets, as is often the
+// case for caches where the sets are derived from tags.
+void loadSetsWalk( const SceneInterface *s, Sets &sets, const Canceller *canceller )
+{
+	Canceller::check( canceller );
+
+	SceneInterface::NameList tags;
+	s->readTags( tags, SceneInterface::LocalTag );
+	for( SceneInterface::NameList::const_iterator it = tags.begin(), eIt = tags.end(); it != eIt; ++it )
+	{
+		sets[*it].addPath( vector<InternedString>() );
+	}
+
+	// We only need to recurse if there are tags below us.
+
+	tags.clear();
+	s->readTags( tags, SceneInterface::DescendantTag );
+	if( tags.empty() )
+	{
+		return;
+	}
+
+	SceneInterface::NameList childNames;
+	s->childNames( childNames );
+
+	LoadSetsChildren loadSetsChildren( s, childNames, canceller );
+	tbb::parallel_reduce( tbb::blocked_range<size_t>( 0, childNames.size() ), loadSetsChildren );
+	addSets( sets, loadSetsChildren.sets(), vector<InternedString>() );
+}
+
+// Determines which children have any of the specified tags,
+// storing the results in `matches`.
+class MatchChildTags
+{
+
+	public :
+
+		MatchChildTags( const SceneInterface *s, const vector<InternedString> &childNames, const vector<InternedString> &tags, vector<char> &matches )
+			:	m_scene( s ), m_childNames( childNames ), m_tags( tags ), m_matches( matches )
+		{
+		}
+
+		void operator() ( const tbb::blocked_range<size_t> &r ) const
+		{
+			SceneInterface::NameList childTags;
+			for( size_t i = r.begin(); i != r.end(); ++i )
+			{
+				ConstSceneInterfacePtr child = m_scene->child( m_childNames[i] );
+				childTags.clear();
+				child->readTags( childTags, IECore::SceneInterface::EveryTag );
+
+				bool childMatches = false;
+				for( SceneInterface::NameList::const_iterator tIt = childTags.begin(), tEIt = childTags.end(); tIt != tEIt; ++tIt )
+				{
+					if( find( m_tags.begin(), m_tags.end(), *tIt ) != m_tags.end() )
+					{
+						childMatches = true;
+						break;
+					}
+				}
+
+				m_matches[i] = childMatches;
+			}
+		}
+
+	private :
+
+		const SceneInterface *m_scene;
+		const vector<InternedString> &m_childNames;
+		const vector<InternedString> &m_tags;
+		vector<char> &m_matches;
+
+};
+
+// Each thread opens its own handle for each file it reads, and caches the
+// SceneInterfaces for the locations it visits. This avoids contention on the
+// locks internal to a single shared SceneInterface, and means that a location
+// can be found from its parent rather than by resolving the whole path from
+// the root. SharedSceneInterfaces is deliberately not used for this reason.
+class ThreadScenes
+{
+
+	public :
+
+		ThreadScenes()
+		{
+			clearRequested = 0;
+		}
+
+		ConstSceneInterfacePtr scene( const std::string &fileName, const ScenePlug::ScenePath &path )
+		{
+			if( clearRequested )
+			{
+				m_roots.clear();
+				m_scenes.clear();
+				clearRequested = 0;
+			}
+			return sceneInternal( fileName, path, path.size() );
+		}
+
+		// Flag to request that the per-thread caches are cleared.
+		// We can't clear them directly from another thread, because
+		// they may be in use.
+		tbb::atomic<int> clearRequested;
+
+	private :
+
+		// Returns the SceneInterface for the first `size` elements of `path`.
+		ConstSceneInterfacePtr sceneInternal( const std::string &fileName, const ScenePlug::ScenePath &path, size_t size )
+		{
+			if( !size )
+			{
+				return root( fileName );
+			}
+
+			MurmurHash key;
+			key.append( fileName );
+			key.append( (uint64_t)size );
+			for( size_t i = 0; i < size; ++i )
+			{
+				key.append( path[i] );
+			}
+
+			Scenes::const_iterator it = m_scenes.find( key );
+			if( it != m_scenes.end() )
+			{
+				return it->second;
+			}
+
+			ConstSceneInterfacePtr parent = sceneInternal( fileName, path, size - 1 );
+			ConstSceneInterfacePtr result = parent->child( path[size-1] );
+
+			if( m_scenes.size() >= g_maxScenes )
+			{
+				// Prevent unbounded growth. Locations are cheap to
+				// find again from the root, so there's no need for
+				// anything more sophisticated than clearing the lot.
+				m_scenes.clear();
+			}
+			m_scenes[key] = result;
+			return result;
+		}
+
+		ConstSceneInterfacePtr root( const std::string &fileName )
+		{
+			for( Roots::iterator it = m_roots.begin(), eIt = m_roots.end(); it != eIt; ++it )
+			{
+				if( it->first == fileName )
+				{
+					return it->second;
+				}
+			}
+
+			if( m_roots.size() >= g_maxRoots )
+			{
+				// Close the handles for all files, which also
+				// requires us to forget their locations.
+				m_roots.clear();
+				m_scenes.clear();
+			}
+
+			ConstSceneInterfacePtr result = SceneInterface::create( fileName, IndexedIO::Read );
+			m_roots.push_back( Root( fileName, result ) );
+			return result;
+		}
+
+		typedef std::pair<std::string, ConstSceneInterfacePtr> Root;
+		typedef std::vector<Root> Roots;
+		Roots m_roots;
+
+		typedef boost::unordered_map<MurmurHash, ConstSceneInterfacePtr> Scenes;
+		Scenes m_scenes;
+
+		static const size_t g_maxRoots;
+		static const size_t g_maxScenes;
+
+};
+
+const size_t ThreadScenes::g_maxRoots = 16;
+const size_t ThreadScenes::g_maxScenes = 10000;
+
+typedef tbb::enumerable_thread_specific<ThreadScenes, tbb::cache_aligned_allocator<ThreadScenes>, tbb::ets_key_per_instance> ThreadScenesContainer;
+ThreadScenesContainer g_threadScenes;
+
+} // namespace
+
 IE_CORE_DEFINERUNTIMETYPED( SceneReader );
 
 //////////////////////////////////////////////////////////////////////////
@@ -72,6 +342,7 @@ SceneReader::SceneReader( const std::string &name )
 	addChild( new StringPlug( "fileName" ) );
 	addChild( new IntPlug( "refreshCount" ) );
 	addChild( new StringPlug( "tags" ) );
+	addChild( new ObjectPlug( "__sets", Plug::Out, new CompoundObject ) );
 	plugSetSignal().connect( boost::bind( &SceneReader::plugSet, this, ::_1 ) );
 }
 
@@ -109,12 +380,23 @@ const Gaffer::StringPlug *SceneReader::tagsPlug() const
 	return getChild<StringPlug>( g_firstPlugIndex + 2 );
 }
 
+Gaffer::ObjectPlug *SceneReader::setsPlug()
+{
+	return getChild<ObjectPlug>( g_firstPlugIndex + 3 );
+}
+
+const Gaffer::ObjectPlug *SceneReader::setsPlug() const
+{
+	return getChild<ObjectPlug>( g_firstPlugIndex + 3 );
+}
+
 void SceneReader::affects( const Gaffer::Plug *input, AffectedPlugsContainer &outputs ) const
 {
 	SceneNode::affects( input, outputs );
 
 	if( input == fileNamePlug() || input == refreshCountPlug() )
 	{
+		outputs.push_back( setsPlug() );
 		outputs.push_back( outPlug()->boundPlug() );
 		outputs.push_back( outPlug()->transformPlug() );
 		outputs.push_back( outPlug()->attributesPlug() );
@@ -131,6 +413,39 @@ void SceneReader::affects( const Gaffer::Plug *input, AffectedPlugsContainer &ou
 	}
 }
 
+void SceneReader::hash( const Gaffer::ValuePlug *output, const Gaffer::Context *context, IECore::MurmurHash &h ) const
+{
+	SceneNode::hash( output, context, h );
+
+	if( output == setsPlug() )
+	{
+		fileNamePlug()->hash( h );
+		refreshCountPlug()->hash( h );
+	}
+}
+
+void SceneReader::compute( Gaffer::ValuePlug *output, const Gaffer::Context *context ) const
+{
+	if( output == setsPlug() )
+	{
+		static_cast<ObjectPlug *>( output )->setValue( computeSets( context ) );
+		return;
+	}
+
+	SceneNode::compute( output, context );
+}
+
+Gaffer::ValuePlug::CachePolicy SceneReader::computeCachePolicy( const Gaffer::ValuePlug *output ) const
+{
+	if( output == setsPlug() )
+	{
+		// We use TBB to load the sets in parallel.
+		return ValuePlug::TaskIsolation;
+	}
+
+	return SceneNode::computeCachePolicy( output );
+}
+
 size_t SceneReader::supportedExtensions( std::vector<std::string> &extensions )
 {
 	extensions = SceneInterface::supportedExtensions();
@@ -211,7 +526,7 @@ void SceneReader::hashAttributes( const ScenePath &path, const Gaffer::Context *
 	ConstSceneInterfacePtr s = scene( path );
 	if( !s )
 	{
-		h = parent->attributesPlug()->defaultValue()->Object::hash();
+		h = parent->attributesPlug()->defaultHash();
 		return;
 	}
 
@@ -264,7 +579,7 @@ void SceneReader::hashObject( const ScenePath &path, const Gaffer::Context *cont
 	if( !s || !s->hasObject() )
 	{
 		// no object
-		h = parent->objectPlug()->defaultValue()->hash();
+		h = parent->objectPlug()->defaultHash();
 		return;
 	}
 
@@ -292,7 +607,7 @@ void SceneReader::hashChildNames( const ScenePath &path, const Gaffer::Context *
 	ConstSceneInterfacePtr s = scene( path );
 	if( !s )
 	{
-		h = parent->childNamesPlug()->defaultValue()->Object::hash();
+		h = parent->childNamesPlug()->defaultHash();
 		return;
 	}
 
@@ -331,27 +646,15 @@ IECore::ConstInternedStringVectorDataPtr SceneReader::computeChildNames( const S
 		vector<InternedString> tags;
 		std::copy( tagsTokenizer.begin(), tagsTokenizer.end(), back_inserter( tags ) );
 
+		vector<char> childMatches( result.size(), 0 );
+		tbb::parallel_for( tbb::blocked_range<size_t>( 0, result.size() ), MatchChildTags( s.get(), result, tags, childMatches ) );
+
 		vector<InternedString>::iterator newResultEnd = result.begin();
-		SceneInterface::NameList childTags;
-		for( vector<InternedString>::const_iterator cIt = result.begin(), cEIt = result.end(); cIt != cEIt; ++cIt )
+		for( size_t i = 0, e = result.size(); i < e; ++i )
 		{
-			ConstSceneInterfacePtr child = s->child( *cIt );
-			childTags.clear();
-			child->readTags( childTags, IECore::SceneInterface::EveryTag );
-
-			bool childMatches = false;
-			for( SceneInterface::NameList::const_iterator tIt = childTags.begin(), tEIt = childTags.end(); tIt != tEIt; ++tIt )
-			{
-				if( find( tags.begin(), tags.end(), *tIt ) != tags.end() )
-				{
-					childMatches = true;
-					break;
-				}
-			}
-
-			if( childMatches )
+			if( childMatches[i] )
 			{
-				*newResultEnd++ = *cIt;
+				*newResultEnd++ = result[i];
 			}
 		}
 
@@ -363,7 +666,7 @@ IECore::ConstInternedStringVectorDataPtr SceneReader::computeChildNames( const S
 
 void SceneReader::hashGlobals( const Gaffer::Context *context, const ScenePlug *parent, IECore::MurmurHash &h ) const
 {
-	h = outPlug()->globalsPlug()->defaultValue()->Object::hash();
+	h = outPlug()->globalsPlug()->defaultHash();
 }
 
 IECore::ConstCompoundObjectPtr SceneReader::computeGlobals( const Gaffer::Context *context, const ScenePlug *parent ) const
@@ -400,43 +703,39 @@ void SceneReader::hashSet( const IECore::InternedString &setName, const Gaffer::
 	h.append( setName );
 }
 
-static void loadSetWalk( const SceneInterface *s, const InternedString &setName, PathMatcher &set, const vector<InternedString> &path )
+GafferScene::ConstPathMatcherDataPtr SceneReader::computeSet( const IECore::InternedString &setName, const Gaffer::Context *context, const ScenePlug *parent ) const
 {
-	if( s->hasTag( setName, SceneInterface::LocalTag ) )
+	ConstCompoundObjectPtr sets;
 	{
-		set.addPath( path );
+		Context::EditableScope scope( context );
+		scope.remove( ScenePlug::setNameContextName );
+		sets = boost::static_pointer_cast<const CompoundObject>( setsPlug()->getValue() );
 	}
 
-	// Figure out if we need to recurse by querying descendant tags to see if they include
-	// anything we're interested in.
-
-	if( !s->hasTag( setName, SceneInterface::DescendantTag ) )
+	if( const PathMatcherData *set = sets->member<PathMatcherData>( setName ) )
 	{
-		return;
+		return set;
 	}
 
-	// Recurse to the children.
-
-	SceneInterface::NameList childNames;
-	s->childNames( childNames );
-	vector<InternedString> childPath( path );
-	childPath.push_back( InternedString() ); // room for the child name
-	for( SceneInterface::NameList::const_iterator it = childNames.begin(), eIt = childNames.end(); it != eIt; ++it )
-	{
-		ConstSceneInterfacePtr child = s->child( *it );
-		childPath.back() = *it;
-		loadSetWalk( child.get(), setName, set, childPath );
-	}
+	return parent->setPlug()->defaultValue();
 }
 
-GafferScene::ConstPathMatcherDataPtr SceneReader::computeSet( const IECore::InternedString &setName, const Gaffer::Context *context, const ScenePlug *parent ) const
+IECore::ConstCompoundObjectPtr SceneReader::computeSets( const Gaffer::Context *context ) const
 {
-	PathMatcherDataPtr result = new PathMatcherData;
+	CompoundObjectPtr result = new CompoundObject;
 	ConstSceneInterfacePtr rootScene = scene( ScenePath() );
-	if( rootScene )
+	if( !rootScene )
 	{
-		loadSetWalk( rootScene.get(), setName, result->writable(), ScenePath() );
+		return result;
 	}
+
+	Sets sets;
+	loadSetsWalk( rootScene.get(), sets, context->canceller() );
+	for( Sets::const_iterator it = sets.begin(), eIt = sets.end(); it != eIt; ++it )
+	{
+		result->members()[it->first] = new PathMatcherData( it->second );
+	}
+
 	return result;
 }
 
@@ -449,6 +748,10 @@ void SceneReader::plugSet( Gaffer::Plug *plug )
 	if( plug == refreshCountPlug() )
 	{
 		SharedSceneInterfaces::clear();
+		for( ThreadScenesContainer::iterator it = g_threadScenes.begin(), eIt = g_threadScenes.end(); it != eIt; ++it )
+		{
+			it->clearRequested = 1;
+		}
 		m_lastScene.clear();
 	}
 }
@@ -462,24 +765,13 @@ ConstSceneInterfacePtr SceneReader::scene( const ScenePath &path ) const
 	}
 
 	LastScene &lastScene = m_lastScene.local();
-	if( lastScene.fileName == fileName )
+	if( lastScene.fileName == fileName && lastScene.path == path )
 	{
-		if( lastScene.path == path )
-		{
-			return lastScene.pathScene;
-		}
-		else
-		{
-			lastScene.pathScene = lastScene.fileNameScene->scene( path );
-			lastScene.path = path;
-			return lastScene.pathScene;
-		}
+		return lastScene.pathScene;
 	}
 
-	lastScene.fileNameScene = SharedSceneInterfaces::get( fileName );
+	lastScene.pathScene = g_threadScenes.local().scene( fileName, path );
 	lastScene.fileName = fileName;
-
-	lastScene.pathScene = lastScene.fileNameScene->scene( path );
 	lastScene.path = path;
 
 	return lastScene.pathScene;
@@ -36,6 +36,9 @@
 
 #include "boost/filesystem.hpp"
 
+#include "tbb/blocked_range.h"
+#include "tbb/parallel_for.h"
+
 #include "IECore/SceneInterface.h"
 #include "IECore/Transform.h"
 
@@ -140,7 +143,10 @@ void SceneWriter::executeSequence( const std::vector<float> &frames ) const
 	for ( std::vector<float>::const_iterator it = frames.begin(); it != frames.end(); ++it )
 	{
 		context->setFrame( *it );
-		writeLocation( scene, ScenePlug::ScenePath(), context.get(), output.get(), context->getTime() );
+		context->set( ScenePlug::scenePathContextName, ScenePlug::ScenePath() );
+		LocationData rootData;
+		rootData.evaluate( scene, /* root = */ true );
+		writeLocation( scene, ScenePlug::ScenePath(), rootData, context.get(), output.get(), context->getTime() );
 	}
 }
 
@@ -149,36 +155,96 @@ bool SceneWriter::requiresSequenceExecution() const
 	return true;
 }
 
-void SceneWriter::writeLocation( const GafferScene::ScenePlug *scene, const ScenePlug::ScenePath &scenePath, Context *context, IECore::SceneInterface *output, double time ) const
+// Holds everything we need to write for a single location, so that
+// the values can be computed in parallel before being written serially.
+struct SceneWriter::LocationData
 {
-	context->set( ScenePlug::scenePathContextName, scenePath );
 
-	ConstCompoundObjectPtr attributes = scene->attributesPlug()->getValue();
-	for( CompoundObject::ObjectMap::const_iterator it = attributes->members().begin(), eIt = attributes->members().end(); it != eIt; it++ )
+	// Evaluates the data for the location specified by the current context.
+	void evaluate( const ScenePlug *scene, bool root )
+	{
+		attributes = scene->attributesPlug()->getValue();
+		if( root )
+		{
+			globals = scene->globalsPlug()->getValue();
+		}
+		object = scene->objectPlug()->getValue();
+		bound = scene->boundPlug()->getValue();
+		if( !root )
+		{
+			transform = scene->transformPlug()->getValue();
+		}
+		childNames = scene->childNamesPlug()->getValue();
+	}
+
+	class ChildEvaluator;
+
+	ConstCompoundObjectPtr attributes;
+	ConstCompoundObjectPtr globals;
+	ConstObjectPtr object;
+	Imath::Box3f bound;
+	Imath::M44f transform;
+	ConstInternedStringVectorDataPtr childNames;
+
+};
+
+class SceneWriter::LocationData::ChildEvaluator
+{
+
+	public :
+
+		ChildEvaluator( const ScenePlug *scene, const Context *context, const ScenePlug::ScenePath &parentPath, const vector<InternedString> &childNames, vector<LocationData> &childData )
+			:	m_scene( scene ), m_context( context ), m_parentPath( parentPath ), m_childNames( childNames ), m_childData( childData )
+		{
+		}
+
+		void operator() ( const tbb::blocked_range<size_t> &r ) const
+		{
+			ScenePlug::ScenePath childPath = m_parentPath;
+			childPath.push_back( InternedString() ); // Space for the child name
+
+			Context::EditableScope scope( m_context );
+			for( size_t i = r.begin(); i != r.end(); ++i )
+			{
+				childPath.back() = m_childNames[i];
+				scope.set( ScenePlug::scenePathContextName, childPath );
+				m_childData[i].evaluate( m_scene, /* root = */ false );
+			}
+		}
+
+	private :
+
+		const ScenePlug *m_scene;
+		const Context *m_context;
+		const ScenePlug::ScenePath &m_parentPath;
+		const vector<InternedString> &m_childNames;
+		vector<LocationData> &m_childData;
+
+};
+
+void SceneWriter::writeLocation( const GafferScene::ScenePlug *scene, const ScenePlug::ScenePath &scenePath, const LocationData &data, const Gaffer::Context *context, IECore::SceneInterface *output, double time ) const
+{
+	for( CompoundObject::ObjectMap::const_iterator it = data.attributes->members().begin(), eIt = data.attributes->members().end(); it != eIt; it++ )
 	{
 		output->writeAttribute( it->first, it->second.get(), time );
 	}
 
 	if( scenePath.empty() )
 	{
-		ConstCompoundObjectPtr globals = scene->globalsPlug()->getValue();
-		output->writeAttribute( "gaffer:globals", globals.get(), time );
+		output->writeAttribute( "gaffer:globals", data.globals.get(), time );
 	}
 
-	ConstObjectPtr object = scene->objectPlug()->getValue();
-
-	if( object->typeId() != IECore::NullObjectTypeId && scenePath.size() > 0 )
+	if( data.object->typeId() != IECore::NullObjectTypeId && scenePath.size() > 0 )
 	{
-		output->writeObject( object.get(), time );
+		output->writeObject( data.object.get(), time );
 	}
 
-	Imath::Box3f b = scene->boundPlug()->getValue();
-
+	const Imath::Box3f &b = data.bound;
 	output->writeBound( Imath::Box3d( Imath::V3f( b.min ), Imath::V3f( b.max ) ), time );
 
 	if( scenePath.size() )
 	{
-		Imath::M44f t = scene->transformPlug()->getValue();
+		const Imath::M44f &t = data.transform;
 		Imath::M44d transform(
 			t[0][0], t[0][1], t[0][2], t[0][3],
 			t[1][0], t[1][1], t[1][2], t[1][3],
@@ -189,17 +255,28 @@ void SceneWriter::writeLocation( const GafferScene::ScenePlug *scene, const Scen
 		output->writeTransform( new IECore::M44dData( transform ), time );
 	}
 
-	ConstInternedStringVectorDataPtr childNames = scene->childNamesPlug()->getValue();
+	// Evaluate all the children in parallel, then write them one
+	// by one, recursing to do the same for their children.
+
+	const vector<InternedString> &childNames = data.childNames->readable();
+	vector<LocationData> childData( childNames.size() );
+	LocationData::ChildEvaluator evaluator( scene, context, scenePath, childNames, childData );
+	tbb::parallel_for( tbb::blocked_range<size_t>( 0, childNames.size() ), evaluator );
 
 	ScenePlug::ScenePath childScenePath = scenePath;
 	childScenePath.push_back( InternedString() );
-	for( vector<InternedString>::const_iterator it=childNames->readable().begin(); it!=childNames->readable().end(); it++ )
+	for( size_t i = 0, e = childNames.size(); i < e; ++i )
 	{
-		childScenePath[scenePath.size()] = *it;
+		childScenePath[scenePath.size()] = childNames[i];
+
+		SceneInterfacePtr outputChild = output->child( childNames[i], SceneInterface::CreateIfMissing );
 
-		SceneInterfacePtr outputChild = output->child( *it, SceneInterface::CreateIfMissing );
+		writeLocation( scene, childScenePath, childData[i], context, outputChild.get(), time );
 
-		writeLocation( scene, childScenePath, context, outputChild.get(), time );
+		// Release the data as soon as it has been written, so that
+		// we're holding only the data for the locations on our
+		// path through the hierarchy and their siblings.
+		childData[i] = LocationData();
 	}
 }
 
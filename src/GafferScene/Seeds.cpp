@@ -158,7 +158,7 @@ void Seeds::hashBranchObject( const ScenePath &parentPath, const ScenePath &bran
 		return;
 	}
 
-	h = outPlug()->objectPlug()->defaultValue()->Object::hash();
+	h = outPlug()->objectPlug()->defaultHash();
 }
 
 IECore::ConstObjectPtr Seeds::computeBranchObject( const ScenePath &parentPath, const ScenePath &branchPath, const Gaffer::Context *context ) const
@@ -172,6 +172,15 @@ IECore::ConstObjectPtr Seeds::computeBranchObject( const ScenePath &parentPath,
 			return outPlug()->objectPlug()->defaultValue();
 		}
 
+		/// \todo The distribution is performed serially by PointDistributionOp,
+		/// which is the bottleneck for dense distributions. It would be better
+		/// served by a parallel algorithm in Cortex, partitioning the faces into
+		/// ranges and seeding each range deterministically so that the result
+		/// is independent of the number of threads. We can't do that here
+		/// without duplicating the blue noise distribution PointDistributionOp
+		/// is built on, and changing the points generated for existing scenes.
+		/// Note that the copy of the mesh is cheap, because the primitive
+		/// variable data is shared with the input until it is modified.
 		PointDistributionOpPtr op = new PointDistributionOp();
 		op->meshParameter()->setValue( mesh->copy() );
 		op->densityParameter()->setNumericValue( densityPlug()->getValue() );
@@ -193,7 +202,7 @@ void Seeds::hashBranchChildNames( const ScenePath &parentPath, const ScenePath &
 	}
 	else
 	{
-		h = outPlug()->childNamesPlug()->defaultValue()->Object::hash();
+		h = outPlug()->childNamesPlug()->defaultHash();
 	}
 }
 
@@ -48,6 +48,7 @@
 #include "Gaffer/Metadata.h"
 #include "Gaffer/ScriptNode.h"
 #include "Gaffer/Switch.h"
+#include "Gaffer/Private/IECorePreview/LRUCache.h"
 
 #include "GafferScene/Shader.h"
 
@@ -139,6 +140,33 @@ struct CycleDetector
 
 };
 
+// Cache of converted networks, keyed by the network hash. The
+// hash is cheap to compute because it is built from the (cached)
+// hashes of the upstream plugs, whereas the conversion requires
+// the values of every parameter. Networks are frequently shared
+// by many ShaderAssignments, and are requested for every location
+// they are assigned to, so caching them avoids repeated conversion
+// and means that all assignments share a single ObjectVector. We
+// only ever use getIfCached() and setIfUncached().
+
+typedef IECorePreview::LRUCache<IECore::MurmurHash, IECore::ConstObjectVectorPtr> NetworkCache;
+
+IECore::ConstObjectVectorPtr networkCacheGetter( const IECore::MurmurHash &h, size_t &cost )
+{
+	throw IECore::Exception( "Unexpected call to networkCacheGetter" );
+}
+
+size_t networkCost( const IECore::ConstObjectVectorPtr &network )
+{
+	return 1;
+}
+
+NetworkCache &networkCache()
+{
+	static NetworkCache *g_cache = new NetworkCache( networkCacheGetter, 10000 );
+	return *g_cache;
+}
+
 } // namespace
 
 //////////////////////////////////////////////////////////////////////////
@@ -151,7 +179,7 @@ class Shader::NetworkBuilder
 	public :
 
 		NetworkBuilder( const Shader *rootNode )
-			:	m_rootNode( rootNode ), m_handleCount( 0 )
+			:	m_rootNode( rootNode ), m_building( NULL ), m_handleCount( 0 )
 		{
 		}
 
@@ -170,17 +198,38 @@ class Shader::NetworkBuilder
 
 		IECore::ConstObjectVectorPtr state()
 		{
-			if( !m_state )
+			if( m_state )
+			{
+				return m_state;
+			}
+
+			const IECore::MurmurHash h = stateHash();
+			if( h != IECore::MurmurHash() )
 			{
-				m_state = new IECore::ObjectVector;
-				if( const Gaffer::Plug *p = effectiveParameter( m_rootNode->outPlug() ) )
+				NetworkCache &cache = networkCache();
+				if( boost::optional<IECore::ConstObjectVectorPtr> cached = cache.getIfCached( h ) )
 				{
-					if( isOutputParameter( p ) )
-					{
-						shader( static_cast<const Shader *>( p->node() ) );
-					}
+					m_state = *cached;
+					return m_state;
 				}
 			}
+
+			IECore::ObjectVectorPtr state = new IECore::ObjectVector;
+			m_building = state.get();
+			if( const Gaffer::Plug *p = effectiveParameter( m_rootNode->outPlug() ) )
+			{
+				if( isOutputParameter( p ) )
+				{
+					shader( static_cast<const Shader *>( p->node() ) );
+				}
+			}
+			m_building = NULL;
+
+			m_state = state;
+			if( h != IECore::MurmurHash() )
+			{
+				networkCache().setIfUncached( h, m_state, networkCost );
+			}
 			return m_state;
 		}
 
@@ -284,7 +333,7 @@ class Shader::NetworkBuilder
 			shaderAndHash.shader->blindData()->writable()["gaffer:nodeName"] = new IECore::StringData( shaderNode->nodeNamePlug()->getValue() );
 			shaderAndHash.shader->blindData()->writable()["gaffer:nodeColor"] = new IECore::Color3fData( shaderNode->nodeColorPlug()->getValue() );
 
-			m_state->members().push_back( shaderAndHash.shader );
+			m_building->members().push_back( shaderAndHash.shader );
 
 			return shaderAndHash.shader.get();
 		}
@@ -489,7 +538,9 @@ class Shader::NetworkBuilder
 		}
 
 		const Shader *m_rootNode;
-		IECore::ObjectVectorPtr m_state;
+		IECore::ConstObjectVectorPtr m_state;
+		// The network currently being converted by state().
+		IECore::ObjectVector *m_building;
 
 		struct ShaderAndHash
 		{
@@ -99,12 +99,32 @@ IECore::ConstCompoundObjectPtr ShaderAssignment::computeProcessedAttributes( con
 		return inputAttributes;
 	}
 
+	// Avoid copying the input attributes if they already contain
+	// our shader. The shader attributes come from the compute cache, so
+	// a pointer comparison is sufficient to detect this.
+	const CompoundObject::ObjectMap &inputMembers = inputAttributes->members();
+	bool modified = false;
+	for( CompoundObject::ObjectMap::const_iterator it = attributes->members().begin(), eIt = attributes->members().end(); it != eIt; ++it )
+	{
+		CompoundObject::ObjectMap::const_iterator inputIt = inputMembers.find( it->first );
+		if( inputIt == inputMembers.end() || inputIt->second != it->second )
+		{
+			modified = true;
+			break;
+		}
+	}
+
+	if( !modified )
+	{
+		return inputAttributes;
+	}
+
 	CompoundObjectPtr result = new CompoundObject;
 	// Since we're not going to modify any existing members (only add new ones),
 	// and our result becomes const on returning it, we can directly reference
 	// the input members in our result without copying. Be careful not to modify
 	// them though!
-	result->members() = inputAttributes->members();
+	result->members() = inputMembers;
 	for( CompoundObject::ObjectMap::const_iterator it = attributes->members().begin(), eIt = attributes->members().end(); it != eIt; ++it )
 	{
 		result->members()[it->first] = it->second;
@@ -124,6 +124,11 @@ const Gaffer::V2iPlug *Sphere::divisionsPlug() const
 	return getChild<V2iPlug>( g_firstPlugIndex + 5 );
 }
 
+Imath::V2i Sphere::divisions( const Gaffer::Context *context ) const
+{
+	return levelOfDetailDivisions( divisionsPlug()->getValue(), divisionsPlug()->minValue(), context );
+}
+
 void Sphere::affects( const Plug *input, AffectedPlugsContainer &outputs ) const
 {
 	ObjectSource::affects( input, outputs );
@@ -146,7 +151,7 @@ void Sphere::hashSource( const Gaffer::Context *context, IECore::MurmurHash &h )
 	zMinPlug()->hash( h );
 	zMaxPlug()->hash( h );
 	thetaMaxPlug()->hash( h );
-	divisionsPlug()->hash( h );
+	h.append( divisions( context ) );
 }
 
 IECore::ConstObjectPtr Sphere::computeSource( const Context *context ) const
@@ -164,6 +169,6 @@ IECore::ConstObjectPtr Sphere::computeSource( const Context *context ) const
 	}
 	else
 	{
-		return MeshPrimitive::createSphere( radius, zMin, zMax, thetaMax, divisionsPlug()->getValue() );
+		return MeshPrimitive::createSphere( radius, zMin, zMax, thetaMax, divisions( context ) );
 	}
 }
@@ -34,12 +34,17 @@
 //
 //////////////////////////////////////////////////////////////////////////
 
+#include "boost/functional/hash.hpp"
+
+#include "tbb/mutex.h"
+
 #include "IECore/Font.h"
 #include "IECore/LRUCache.h"
 #include "IECore/MeshPrimitive.h"
 #include "IECore/SearchPath.h"
 
 #include "Gaffer/StringPlug.h"
+#include "Gaffer/Private/IECorePreview/LRUCache.h"
 
 #include "GafferScene/Text.h"
 
@@ -81,6 +86,142 @@ FontCache *fontCache()
 	return c;
 }
 
+// Font::mesh( text ) builds a new mesh by merging the meshes for each
+// character, which is wasteful when only a few characters change from
+// one compute to the next (burnt in frame numbers for instance). We
+// therefore keep our own cache of glyphs, each holding the triangulated
+// mesh for a character along with the advance to the following character,
+// and assemble the final mesh directly from those.
+struct GlyphKey
+{
+
+	GlyphKey( const std::string &font, char character, char next )
+		:	font( font ), character( character ), next( next )
+	{
+	}
+
+	bool operator == ( const GlyphKey &other ) const
+	{
+		return character == other.character && next == other.next && font == other.font;
+	}
+
+	std::string font;
+	char character;
+	// The following character, used to compute a kerned advance,
+	// or 0 for the last character in the text.
+	char next;
+
+};
+
+size_t hash_value( const GlyphKey &key )
+{
+	size_t result = boost::hash<std::string>()( key.font );
+	boost::hash_combine( result, key.character );
+	boost::hash_combine( result, key.next );
+	return result;
+}
+
+struct Glyph
+{
+	ConstMeshPrimitivePtr mesh;
+	ConstV3fVectorDataPtr p;
+	V2f advance;
+};
+
+typedef boost::shared_ptr<const Glyph> ConstGlyphPtr;
+
+ConstGlyphPtr glyphGetter( const GlyphKey &key, size_t &cost )
+{
+	FontPtr font = fontCache()->get( key.font );
+
+	boost::shared_ptr<Glyph> result( new Glyph );
+	{
+		// Fonts cache meshes internally and are not safe
+		// for concurrent use, so we serialise access. This
+		// is only needed when a glyph is first encountered.
+		static tbb::mutex g_mutex;
+		tbb::mutex::scoped_lock lock( g_mutex );
+		result->mesh = font->mesh( key.character );
+		result->advance = key.next ? font->advance( key.character, key.next ) : V2f( 0 );
+	}
+
+	PrimitiveVariableMap::const_iterator it = result->mesh->variables.find( "P" );
+	if( it != result->mesh->variables.end() )
+	{
+		result->p = runTimeCast<const V3fVectorData>( it->second.data );
+	}
+
+	cost = 1;
+	return result;
+}
+
+typedef IECorePreview::LRUCache<GlyphKey, ConstGlyphPtr> GlyphCache;
+
+GlyphCache *glyphCache()
+{
+	static GlyphCache *c = new GlyphCache( glyphGetter, 10000 );
+	return c;
+}
+
+MeshPrimitivePtr mesh( const std::string &fontFileName, const std::string &text )
+{
+	std::vector<ConstGlyphPtr> glyphs;
+	glyphs.reserve( text.size() );
+	size_t numFaces = 0;
+	size_t numVertexIds = 0;
+	size_t numPoints = 0;
+	for( size_t i = 0, e = text.size(); i < e; ++i )
+	{
+		ConstGlyphPtr glyph = glyphCache()->get( GlyphKey( fontFileName, text[i], i + 1 < e ? text[i+1] : 0 ) );
+		glyphs.push_back( glyph );
+		numFaces += glyph->mesh->verticesPerFace()->readable().size();
+		numVertexIds += glyph->mesh->vertexIds()->readable().size();
+		numPoints += glyph->p ? glyph->p->readable().size() : 0;
+	}
+
+	IntVectorDataPtr verticesPerFaceData = new IntVectorData;
+	std::vector<int> &verticesPerFace = verticesPerFaceData->writable();
+	verticesPerFace.reserve( numFaces );
+
+	IntVectorDataPtr vertexIdsData = new IntVectorData;
+	std::vector<int> &vertexIds = vertexIdsData->writable();
+	vertexIds.reserve( numVertexIds );
+
+	V3fVectorDataPtr pData = new V3fVectorData;
+	std::vector<V3f> &p = pData->writable();
+	p.reserve( numPoints );
+
+	V3f pen( 0 );
+	for( std::vector<ConstGlyphPtr>::const_iterator it = glyphs.begin(), eIt = glyphs.end(); it != eIt; ++it )
+	{
+		const Glyph &glyph = **it;
+
+		const std::vector<int> &glyphVerticesPerFace = glyph.mesh->verticesPerFace()->readable();
+		verticesPerFace.insert( verticesPerFace.end(), glyphVerticesPerFace.begin(), glyphVerticesPerFace.end() );
+
+		const int offset = p.size();
+		const std::vector<int> &glyphVertexIds = glyph.mesh->vertexIds()->readable();
+		for( std::vector<int>::const_iterator vIt = glyphVertexIds.begin(), veIt = glyphVertexIds.end(); vIt != veIt; ++vIt )
+		{
+			vertexIds.push_back( *vIt + offset );
+		}
+
+		if( glyph.p )
+		{
+			const std::vector<V3f> &glyphP = glyph.p->readable();
+			for( std::vector<V3f>::const_iterator pIt = glyphP.begin(), peIt = glyphP.end(); pIt != peIt; ++pIt )
+			{
+				p.push_back( *pIt + pen );
+			}
+		}
+
+		pen.x += glyph.advance.x;
+		pen.y += glyph.advance.y;
+	}
+
+	return new MeshPrimitive( verticesPerFaceData, vertexIdsData, "linear", pData );
+}
+
 } // namespace Detail
 
 } // namespace GafferScene
@@ -150,6 +291,5 @@ IECore::ConstObjectPtr Text::computeSource( const Context *context ) const
 		return outPlug()->objectPlug()->defaultValue();
 	}
 
-	FontPtr font = Detail::fontCache()->get( fontFileName );
-	return font->mesh( text );
+	return Detail::mesh( fontFileName, text );
 }
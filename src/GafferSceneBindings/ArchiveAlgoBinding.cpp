@@ -0,0 +1,98 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2017, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//      * Redistributions of source code must retain the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer.
+//
+//      * Redistributions in binary form must reproduce the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer in the documentation and/or other materials provided with
+//        the distribution.
+//
+//      * Neither the name of John Haddon nor the names of
+//        any other contributors to this software may be used to endorse or
+//        promote products derived from this software without specific prior
+//        written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#include "boost/python.hpp"
+
+#include "IECorePython/ScopedGILRelease.h"
+
+#include "GafferScene/ArchiveAlgo.h"
+
+#include "GafferSceneBindings/ArchiveAlgoBinding.h"
+
+using namespace boost::python;
+using namespace GafferScene;
+
+namespace
+{
+
+IECore::CompoundDataPtr metadataWrapper( const std::string &fileName, bool copy )
+{
+	IECorePython::ScopedGILRelease r;
+	IECore::ConstCompoundDataPtr result = ArchiveAlgo::metadata( fileName );
+	if( !result )
+	{
+		return NULL;
+	}
+	return copy ? result->copy() : boost::const_pointer_cast<IECore::CompoundData>( result );
+}
+
+Imath::Box3f boundWrapper( const std::string &fileName )
+{
+	IECorePython::ScopedGILRelease r;
+	return ArchiveAlgo::bound( fileName );
+}
+
+IECore::MurmurHash hashWrapper( const std::string &fileName )
+{
+	IECore::MurmurHash h;
+	ArchiveAlgo::hash( fileName, h );
+	return h;
+}
+
+} // namespace
+
+namespace GafferSceneBindings
+{
+
+void bindArchiveAlgo()
+{
+	object module( borrowed( PyImport_AddModule( "GafferScene.ArchiveAlgo" ) ) );
+	scope().attr( "ArchiveAlgo" ) = module;
+	scope moduleScope( module );
+
+	def(
+		"metadata",
+		&metadataWrapper,
+		( arg( "fileName" ), arg( "_copy" ) = true )
+	);
+	def( "bound", &boundWrapper );
+	def( "hash", &hashWrapper );
+	def( "getMetadataCacheSizeLimit", &ArchiveAlgo::getMetadataCacheSizeLimit );
+	def( "setMetadataCacheSizeLimit", &ArchiveAlgo::setMetadataCacheSizeLimit );
+	def( "clearMetadataCache", &ArchiveAlgo::clearMetadataCache );
+}
+
+} // namespace GafferSceneBindings
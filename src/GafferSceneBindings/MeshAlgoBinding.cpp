@@ -0,0 +1,91 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2017, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//      * Redistributions of source code must retain the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer.
+//
+//      * Redistributions in binary form must reproduce the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer in the documentation and/or other materials provided with
+//        the distribution.
+//
+//      * Neither the name of John Haddon nor the names of
+//        any other contributors to this software may be used to endorse or
+//        promote products derived from this software without specific prior
+//        written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#include "boost/python.hpp"
+
+#include "IECorePython/ScopedGILRelease.h"
+
+#include "GafferScene/MeshAlgo.h"
+
+#include "GafferSceneBindings/MeshAlgoBinding.h"
+
+using namespace boost::python;
+using namespace IECore;
+using namespace GafferScene;
+
+namespace
+{
+
+PrimitiveVariable calculateNormalsWrapper( const MeshPrimitive *mesh, const std::string &position )
+{
+	IECorePython::ScopedGILRelease r;
+	return MeshAlgo::calculateNormals( mesh, position );
+}
+
+tuple calculateTangentsWrapper( const MeshPrimitive *mesh, const std::string &uName, const std::string &vName, bool orthoTangents, const std::string &position )
+{
+	std::pair<PrimitiveVariable, PrimitiveVariable> result;
+	{
+		IECorePython::ScopedGILRelease r;
+		result = MeshAlgo::calculateTangents( mesh, uName, vName, orthoTangents, position );
+	}
+	return make_tuple( result.first, result.second );
+}
+
+} // namespace
+
+namespace GafferSceneBindings
+{
+
+void bindMeshAlgo()
+{
+	object module( borrowed( PyImport_AddModule( "GafferScene.MeshAlgo" ) ) );
+	scope().attr( "MeshAlgo" ) = module;
+	scope moduleScope( module );
+
+	def(
+		"calculateNormals",
+		&calculateNormalsWrapper,
+		( arg( "mesh" ), arg( "position" ) = "P" )
+	);
+	def(
+		"calculateTangents",
+		&calculateTangentsWrapper,
+		( arg( "mesh" ), arg( "uName" ) = "s", arg( "vName" ) = "t", arg( "orthoTangents" ) = true, arg( "position" ) = "P" )
+	);
+}
+
+} // namespace GafferSceneBindings
@@ -136,6 +136,7 @@ void GafferSceneBindings::bindPathMatcher()
 		.def( "paths", &paths )
 		.def( "match", (unsigned (PathMatcher ::*)( const std::vector<IECore::InternedString> & ) const)&PathMatcher::match )
 		.def( "match", (unsigned (PathMatcher ::*)( const std::string & ) const)&PathMatcher::match )
+		.def( "hash", &PathMatcher::hash )
 		.def( "__repr__", &pathMatcherRepr )
 		.def( self == self )
 		.def( self != self )
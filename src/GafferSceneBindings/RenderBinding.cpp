@@ -184,6 +184,7 @@ void GafferSceneBindings::bindRender()
 			scope s = GafferBindings::NodeClass<GafferScene::Preview::InteractiveRender>()
 				.def( "getContext", &previewInteractiveRenderGetContext )
 				.def( "setContext", &GafferScene::Preview::InteractiveRender::setContext )
+				.def( "rendererStatistics", &GafferScene::Preview::InteractiveRender::rendererStatistics )
 			;
 
 			enum_<GafferScene::Preview::InteractiveRender::State>( "State" )
@@ -254,6 +255,8 @@ void GafferSceneBindings::bindRender()
 			.def( "render", &Renderer::render )
 			.def( "pause", &Renderer::pause )
 
+			.def( "statistics", &Renderer::statistics )
+
 		;
 
 	}
@@ -36,6 +36,8 @@
 
 #include "boost/python.hpp"
 
+#include "IECorePython/ScopedGILRelease.h"
+
 #include "GafferBindings/DependencyNodeBinding.h"
 
 #include "GafferScene/Shader.h"
@@ -52,8 +54,21 @@ using namespace GafferScene;
 namespace
 {
 
+IECore::MurmurHash attributesHash( const Shader &s )
+{
+	IECorePython::ScopedGILRelease gilRelease;
+	return s.attributesHash();
+}
+
+void attributesHash2( const Shader &s, IECore::MurmurHash &h )
+{
+	IECorePython::ScopedGILRelease gilRelease;
+	s.attributesHash( h );
+}
+
 IECore::CompoundObjectPtr attributes( const Shader &s, bool copy=true )
 {
+	IECorePython::ScopedGILRelease gilRelease;
 	IECore::ConstCompoundObjectPtr o = s.attributes();
 	if( copy )
 	{
@@ -65,8 +80,21 @@ IECore::CompoundObjectPtr attributes( const Shader &s, bool copy=true )
 	}
 }
 
+IECore::MurmurHash stateHash( const Shader &s )
+{
+	IECorePython::ScopedGILRelease gilRelease;
+	return s.stateHash();
+}
+
+void stateHash2( const Shader &s, IECore::MurmurHash &h )
+{
+	IECorePython::ScopedGILRelease gilRelease;
+	s.stateHash( h );
+}
+
 IECore::ObjectVectorPtr state( const Shader &s, bool copy=true )
 {
+	IECorePython::ScopedGILRelease gilRelease;
 	IECore::ConstObjectVectorPtr o = s.state();
 	if( copy )
 	{
@@ -84,11 +112,11 @@ void GafferSceneBindings::bindShader()
 {
 
 	GafferBindings::DependencyNodeClass<Shader>()
-		.def( "attributesHash", (IECore::MurmurHash (Shader::*)() const )&Shader::attributesHash )
-		.def( "attributesHash", (void (Shader::*)( IECore::MurmurHash &h ) const )&Shader::attributesHash )
+		.def( "attributesHash", &attributesHash )
+		.def( "attributesHash", &attributesHash2 )
 		.def( "attributes", &attributes, ( boost::python::arg_( "_copy" ) = true ) )
-		.def( "stateHash", (IECore::MurmurHash (Shader::*)() const )&Shader::stateHash )
-		.def( "stateHash", (void (Shader::*)( IECore::MurmurHash &h ) const )&Shader::stateHash )
+		.def( "stateHash", &stateHash )
+		.def( "stateHash", &stateHash2 )
 		.def( "state", &state, ( boost::python::arg_( "_copy" ) = true ) )
 	;
 
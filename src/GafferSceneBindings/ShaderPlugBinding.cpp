@@ -38,6 +38,8 @@
 
 #include "IECore/MurmurHash.h"
 
+#include "IECorePython/ScopedGILRelease.h"
+
 #include "GafferBindings/PlugBinding.h"
 
 #include "GafferScene/ShaderPlug.h"
@@ -53,8 +55,15 @@ using namespace GafferSceneBindings;
 namespace
 {
 
+IECore::MurmurHash attributesHash( const ShaderPlug &p )
+{
+	IECorePython::ScopedGILRelease gilRelease;
+	return p.attributesHash();
+}
+
 IECore::CompoundObjectPtr attributes( const ShaderPlug &p, bool copy=true )
 {
+	IECorePython::ScopedGILRelease gilRelease;
 	IECore::ConstCompoundObjectPtr o = p.attributes();
 	if( copy )
 	{
@@ -81,7 +90,7 @@ void GafferSceneBindings::bindShaderPlug()
 			)
 		)
 		// value accessors
-		.def( "attributesHash", &ShaderPlug::attributesHash )
+		.def( "attributesHash", &attributesHash )
 		.def( "attributes", &attributes )
 	;
 
@@ -91,6 +91,7 @@
 #include "GafferSceneBindings/SetBinding.h"
 #include "GafferSceneBindings/FreezeTransformBinding.h"
 #include "GafferSceneBindings/SceneAlgoBinding.h"
+#include "GafferSceneBindings/ArchiveAlgoBinding.h"
 #include "GafferSceneBindings/CoordinateSystemBinding.h"
 #include "GafferSceneBindings/DeleteGlobalsBinding.h"
 #include "GafferSceneBindings/ExternalProceduralBinding.h"
@@ -107,6 +108,8 @@
 #include "GafferSceneBindings/LightTweaksBinding.h"
 #include "GafferSceneBindings/LightToCameraBinding.h"
 #include "GafferSceneBindings/FilterResultsBinding.h"
+#include "GafferSceneBindings/EncapsulateBinding.h"
+#include "GafferSceneBindings/MeshAlgoBinding.h"
 
 using namespace boost::python;
 using namespace GafferBindings;
@@ -182,6 +185,7 @@ BOOST_PYTHON_MODULE( _GafferScene )
 	bindSet();
 	bindFreezeTransform();
 	bindSceneAlgo();
+	bindArchiveAlgo();
 	bindCoordinateSystem();
 	bindExternalProcedural();
 	bindScenePath();
@@ -195,5 +199,7 @@ BOOST_PYTHON_MODULE( _GafferScene )
 	bindLightTweaks();
 	bindLightToCamera();
 	bindFilterResults();
+	bindEncapsulate();
+	bindMeshAlgo();
 
 }
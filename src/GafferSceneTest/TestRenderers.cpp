@@ -0,0 +1,372 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2017, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//      * Redistributions of source code must retain the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer.
+//
+//      * Redistributions in binary form must reproduce the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer in the documentation and/or other materials provided with
+//        the distribution.
+//
+//      * Neither the name of John Haddon nor the names of
+//        any other contributors to this software may be used to endorse or
+//        promote products derived from this software without specific prior
+//        written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#include "tbb/mutex.h"
+
+#include "IECore/SimpleTypedData.h"
+
+#include "GafferScene/Preview/RendererAlgo.h"
+
+#include "GafferSceneTest/TestRenderers.h"
+
+using namespace std;
+using namespace Imath;
+using namespace IECore;
+using namespace IECoreScenePreview;
+using namespace GafferScene;
+
+//////////////////////////////////////////////////////////////////////////
+// NullRenderer
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+class NullAttributes : public Renderer::AttributesInterface
+{
+
+};
+
+class NullObject : public Renderer::ObjectInterface
+{
+
+	public :
+
+		virtual void transform( const Imath::M44f &transform )
+		{
+		}
+
+		virtual void transform( const std::vector<Imath::M44f> &samples, const std::vector<float> &times )
+		{
+		}
+
+		virtual bool attributes( const Renderer::AttributesInterface *attributes )
+		{
+			return true;
+		}
+
+};
+
+class NullRenderer : public Renderer
+{
+
+	public :
+
+		NullRenderer( RenderType renderType, const std::string &fileName )
+		{
+		}
+
+		virtual void option( const IECore::InternedString &name, const IECore::Data *value )
+		{
+		}
+
+		virtual void output( const IECore::InternedString &name, const Output *output )
+		{
+		}
+
+		virtual AttributesInterfacePtr attributes( const IECore::CompoundObject *attributes )
+		{
+			return new NullAttributes;
+		}
+
+		virtual ObjectInterfacePtr camera( const std::string &name, const IECore::Camera *camera, const AttributesInterface *attributes )
+		{
+			return new NullObject;
+		}
+
+		virtual ObjectInterfacePtr light( const std::string &name, const IECore::Object *object, const AttributesInterface *attributes )
+		{
+			return new NullObject;
+		}
+
+		virtual ObjectInterfacePtr object( const std::string &name, const IECore::Object *object, const AttributesInterface *attributes )
+		{
+			return new NullObject;
+		}
+
+		virtual ObjectInterfacePtr object( const std::string &name, const std::vector<const IECore::Object *> &samples, const std::vector<float> &times, const AttributesInterface *attributes )
+		{
+			return new NullObject;
+		}
+
+		virtual void render()
+		{
+		}
+
+		virtual void pause()
+		{
+		}
+
+	private :
+
+		static Renderer::TypeDescription<NullRenderer> g_typeDescription;
+
+};
+
+Renderer::TypeDescription<NullRenderer> NullRenderer::g_typeDescription( "Null" );
+
+} // namespace
+
+//////////////////////////////////////////////////////////////////////////
+// CapturingRenderer
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+InternedString g_typeName( "type" );
+InternedString g_attributesHashName( "attributesHash" );
+InternedString g_samplesName( "samples" );
+InternedString g_transformName( "transform" );
+
+class CapturedAttributes : public Renderer::AttributesInterface
+{
+
+	public :
+
+		CapturedAttributes( const IECore::CompoundObject *attributes )
+			:	m_hash( attributes->hash() )
+		{
+		}
+
+		const IECore::MurmurHash &hash() const
+		{
+			return m_hash;
+		}
+
+	private :
+
+		IECore::MurmurHash m_hash;
+
+};
+
+// Each CapturedObject writes only to its own record, so no
+// locking is required here.
+class CapturedObject : public Renderer::ObjectInterface
+{
+
+	public :
+
+		CapturedObject( CompoundDataPtr record )
+			:	m_record( record )
+		{
+		}
+
+		virtual void transform( const Imath::M44f &transform )
+		{
+			m_record->writable()[g_transformName] = new M44fData( transform );
+		}
+
+		virtual void transform( const std::vector<Imath::M44f> &samples, const std::vector<float> &times )
+		{
+			m_record->writable()[g_transformName] = new M44fData( samples.front() );
+		}
+
+		virtual bool attributes( const Renderer::AttributesInterface *attributes )
+		{
+			m_record->writable()[g_attributesHashName] = new StringData(
+				static_cast<const CapturedAttributes *>( attributes )->hash().toString()
+			);
+			return true;
+		}
+
+	private :
+
+		CompoundDataPtr m_record;
+
+};
+
+class CapturingRenderer : public Renderer
+{
+
+	public :
+
+		CapturingRenderer( RenderType renderType, const std::string &fileName )
+			:	m_capture( new CompoundData )
+		{
+		}
+
+		virtual void option( const IECore::InternedString &name, const IECore::Data *value )
+		{
+		}
+
+		virtual void output( const IECore::InternedString &name, const Output *output )
+		{
+		}
+
+		virtual AttributesInterfacePtr attributes( const IECore::CompoundObject *attributes )
+		{
+			return new CapturedAttributes( attributes );
+		}
+
+		virtual ObjectInterfacePtr camera( const std::string &name, const IECore::Camera *camera, const AttributesInterface *attributes )
+		{
+			return capture( name, "camera", 1, attributes );
+		}
+
+		virtual ObjectInterfacePtr light( const std::string &name, const IECore::Object *object, const AttributesInterface *attributes )
+		{
+			return capture( name, "light", 1, attributes );
+		}
+
+		virtual ObjectInterfacePtr object( const std::string &name, const IECore::Object *object, const AttributesInterface *attributes )
+		{
+			return capture( name, "object", 1, attributes );
+		}
+
+		virtual ObjectInterfacePtr object( const std::string &name, const std::vector<const IECore::Object *> &samples, const std::vector<float> &times, const AttributesInterface *attributes )
+		{
+			return capture( name, "object", samples.size(), attributes );
+		}
+
+		virtual void render()
+		{
+		}
+
+		virtual void pause()
+		{
+		}
+
+		virtual IECore::CompoundDataPtr statistics() const
+		{
+			size_t cameras = 0, lights = 0, objects = 0;
+
+			tbb::mutex::scoped_lock lock( m_captureMutex );
+			for( CompoundDataMap::const_iterator it = m_capture->readable().begin(), eIt = m_capture->readable().end(); it != eIt; ++it )
+			{
+				const std::string &type = static_cast<const CompoundData *>( it->second.get() )->member<StringData>( g_typeName )->readable();
+				if( type == "camera" )
+				{
+					cameras++;
+				}
+				else if( type == "light" )
+				{
+					lights++;
+				}
+				else
+				{
+					objects++;
+				}
+			}
+
+			CompoundDataPtr result = new CompoundData;
+			result->writable()["cameras"] = new UInt64Data( cameras );
+			result->writable()["lights"] = new UInt64Data( lights );
+			result->writable()["objects"] = new UInt64Data( objects );
+			return result;
+		}
+
+		const CompoundData *captured() const
+		{
+			return m_capture.get();
+		}
+
+	private :
+
+		ObjectInterfacePtr capture( const std::string &name, const std::string &type, int samples, const AttributesInterface *attributes )
+		{
+			CompoundDataPtr record = new CompoundData;
+			record->writable()[g_typeName] = new StringData( type );
+			record->writable()[g_samplesName] = new IntData( samples );
+			record->writable()[g_transformName] = new M44fData();
+
+			ObjectInterfacePtr result = new CapturedObject( record );
+			result->attributes( attributes );
+
+			tbb::mutex::scoped_lock lock( m_captureMutex );
+			m_capture->writable()[name] = record;
+
+			return result;
+		}
+
+		mutable tbb::mutex m_captureMutex;
+		CompoundDataPtr m_capture;
+
+		static Renderer::TypeDescription<CapturingRenderer> g_typeDescription;
+
+};
+
+Renderer::TypeDescription<CapturingRenderer> CapturingRenderer::g_typeDescription( "Capturing" );
+
+} // namespace
+
+//////////////////////////////////////////////////////////////////////////
+// Public API
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+RendererPtr renderScene( const GafferScene::ScenePlug *scene, const std::string &rendererType )
+{
+	RendererPtr renderer = Renderer::create( rendererType );
+	if( !renderer )
+	{
+		throw IECore::Exception( "Renderer \"" + rendererType + "\" is not registered" );
+	}
+
+	ConstCompoundObjectPtr globals = scene->globalsPlug()->getValue();
+	Preview::RendererAlgo::outputOptions( globals.get(), renderer.get() );
+	Preview::RendererAlgo::outputOutputs( globals.get(), renderer.get() );
+
+	Preview::RendererAlgo::RenderSets renderSets( scene );
+	Preview::RendererAlgo::outputCameras( scene, globals.get(), renderSets, renderer.get() );
+	Preview::RendererAlgo::outputLights( scene, globals.get(), renderSets, renderer.get() );
+	Preview::RendererAlgo::outputObjects( scene, globals.get(), renderSets, renderer.get() );
+
+	renderer->render();
+
+	return renderer;
+}
+
+} // namespace
+
+IECore::CompoundDataPtr GafferSceneTest::outputScene( const GafferScene::ScenePlug *scene, const std::string &rendererType )
+{
+	RendererPtr renderer = renderScene( scene, rendererType );
+	if( const CapturingRenderer *capturingRenderer = dynamic_cast<const CapturingRenderer *>( renderer.get() ) )
+	{
+		return capturingRenderer->captured()->copy();
+	}
+
+	return NULL;
+}
+
+IECore::CompoundDataPtr GafferSceneTest::outputSceneStatistics( const GafferScene::ScenePlug *scene, const std::string &rendererType )
+{
+	RendererPtr renderer = renderScene( scene, rendererType );
+	return renderer->statistics();
+}
@@ -61,6 +61,28 @@ struct SceneEvaluateFunctor
 	}
 };
 
+struct SceneHashFunctor
+{
+	bool operator()( const GafferScene::ScenePlug *scene, const GafferScene::ScenePlug::ScenePath &path )
+	{
+		scene->transformPlug()->hash();
+		scene->boundPlug()->hash();
+		scene->attributesPlug()->hash();
+		scene->objectPlug()->hash();
+		return true;
+	}
+};
+
+struct SceneFullTransformAndAttributesFunctor
+{
+	bool operator()( const GafferScene::ScenePlug *scene, const GafferScene::ScenePlug::ScenePath &path )
+	{
+		scene->fullTransform( path );
+		scene->fullAttributes( path );
+		return true;
+	}
+};
+
 void traverseOnDirty( const Gaffer::Plug *dirtiedPlug, ConstScenePlugPtr scene )
 {
 	if( dirtiedPlug == scene.get() )
@@ -94,6 +116,18 @@ void GafferSceneTest::traverseScene( GafferScene::ScenePlug *scenePlug )
 	traverseScene( const_cast<const ScenePlug *>( scenePlug ) );
 }
 
+void GafferSceneTest::traverseSceneHashes( const GafferScene::ScenePlug *scenePlug )
+{
+	SceneHashFunctor f;
+	SceneAlgo::parallelTraverse( scenePlug, f );
+}
+
+void GafferSceneTest::traverseSceneFullTransformsAndAttributes( const GafferScene::ScenePlug *scenePlug )
+{
+	SceneFullTransformAndAttributesFunctor f;
+	SceneAlgo::parallelTraverse( scenePlug, f );
+}
+
 boost::signals::connection GafferSceneTest::connectTraverseSceneToPlugDirtiedSignal( const GafferScene::ConstScenePlugPtr &scene )
 {
 	const Node *node = scene->node();
@@ -47,6 +47,8 @@
 #include "GafferSceneTest/TestLight.h"
 #include "GafferSceneTest/ScenePlugTest.h"
 #include "GafferSceneTest/PathMatcherTest.h"
+#include "GafferSceneTest/TestRenderers.h"
+#include "GafferSceneTest/RenderSetsTest.h"
 
 using namespace boost::python;
 using namespace GafferSceneTest;
@@ -57,6 +59,30 @@ static void traverseSceneWrapper( const GafferScene::ScenePlug *scenePlug )
 	traverseScene( scenePlug );
 }
 
+static void traverseSceneHashesWrapper( const GafferScene::ScenePlug *scenePlug )
+{
+	IECorePython::ScopedGILRelease gilRelease;
+	traverseSceneHashes( scenePlug );
+}
+
+static void traverseSceneFullTransformsAndAttributesWrapper( const GafferScene::ScenePlug *scenePlug )
+{
+	IECorePython::ScopedGILRelease gilRelease;
+	traverseSceneFullTransformsAndAttributes( scenePlug );
+}
+
+static IECore::CompoundDataPtr outputSceneWrapper( const GafferScene::ScenePlug *scenePlug, const std::string &rendererType )
+{
+	IECorePython::ScopedGILRelease gilRelease;
+	return outputScene( scenePlug, rendererType );
+}
+
+static IECore::CompoundDataPtr outputSceneStatisticsWrapper( const GafferScene::ScenePlug *scenePlug, const std::string &rendererType )
+{
+	IECorePython::ScopedGILRelease gilRelease;
+	return outputSceneStatistics( scenePlug, rendererType );
+}
+
 BOOST_PYTHON_MODULE( _GafferSceneTest )
 {
 
@@ -65,14 +91,21 @@ BOOST_PYTHON_MODULE( _GafferSceneTest )
 	GafferBindings::NodeClass<TestLight>();
 
 	def( "traverseScene", &traverseSceneWrapper );
+	def( "traverseSceneHashes", &traverseSceneHashesWrapper );
+	def( "traverseSceneFullTransformsAndAttributes", &traverseSceneFullTransformsAndAttributesWrapper );
 	def( "connectTraverseSceneToPlugDirtiedSignal", &connectTraverseSceneToPlugDirtiedSignal );
 	def( "connectTraverseSceneToContextChangedSignal", &connectTraverseSceneToContextChangedSignal );
 	def( "connectTraverseSceneToPreDispatchSignal", &connectTraverseSceneToPreDispatchSignal );
 
+	def( "outputScene", &outputSceneWrapper );
+	def( "outputSceneStatistics", &outputSceneStatisticsWrapper );
+
 	def( "testManyStringToPathCalls", &testManyStringToPathCalls );
 
 	def( "testPathMatcherRawIterator", &testPathMatcherRawIterator );
 	def( "testPathMatcherIteratorPrune", &testPathMatcherIteratorPrune );
 	def( "testPathMatcherFind", &testPathMatcherFind );
 
+	def( "renderSetsAttributes", &renderSetsAttributes );
+
 }
@@ -41,6 +41,8 @@
 #include "IECoreGL/CurvesPrimitive.h"
 #include "IECoreGL/Group.h"
 
+#include "Gaffer/Private/IECorePreview/LRUCache.h"
+
 #include "GafferSceneUI/ObjectVisualiser.h"
 
 using namespace std;
@@ -50,6 +52,28 @@ using namespace GafferSceneUI;
 namespace
 {
 
+// Cache of visualisations keyed by camera hash, so that identical
+// cameras share a single renderable. We only ever use getIfCached()
+// and setIfUncached().
+
+typedef IECorePreview::LRUCache<IECore::MurmurHash, IECoreGL::ConstRenderablePtr> VisualisationCache;
+
+IECoreGL::ConstRenderablePtr visualisationCacheGetter( const IECore::MurmurHash &h, size_t &cost )
+{
+	throw IECore::Exception( "Unexpected call to visualisationCacheGetter" );
+}
+
+size_t visualisationCost( const IECoreGL::ConstRenderablePtr &visualisation )
+{
+	return 1;
+}
+
+VisualisationCache &visualisationCache()
+{
+	static VisualisationCache *g_cache = new VisualisationCache( visualisationCacheGetter, 1000 );
+	return *g_cache;
+}
+
 class CameraVisualiser : public ObjectVisualiser
 {
 
@@ -73,6 +97,26 @@ class CameraVisualiser : public ObjectVisualiser
 				return NULL;
 			}
 
+			const IECore::MurmurHash hash = camera->Object::hash();
+			VisualisationCache &cache = visualisationCache();
+			if( boost::optional<IECoreGL::ConstRenderablePtr> cached = cache.getIfCached( hash ) )
+			{
+				return *cached;
+			}
+
+			IECoreGL::ConstRenderablePtr result = visualiseInternal( camera );
+			cache.setIfUncached( hash, result, visualisationCost );
+			return result;
+		}
+
+	protected :
+
+		static ObjectVisualiserDescription<CameraVisualiser> g_visualiserDescription;
+
+	private :
+
+		IECoreGL::ConstRenderablePtr visualiseInternal( const IECore::Camera *camera ) const
+		{
 			IECore::CameraPtr fullCamera = camera->copy();
 			fullCamera->addStandardParameters();
 
@@ -180,10 +224,6 @@ class CameraVisualiser : public ObjectVisualiser
 			return group;
 		}
 
-	protected :
-
-		static ObjectVisualiserDescription<CameraVisualiser> g_visualiserDescription;
-
 };
 
 ObjectVisualiser::ObjectVisualiserDescription<CameraVisualiser> CameraVisualiser::g_visualiserDescription;
@@ -36,6 +36,7 @@
 
 #include "boost/container/flat_map.hpp"
 #include "boost/algorithm/string/predicate.hpp"
+#include "boost/bind.hpp"
 
 #include "IECore/Light.h"
 #include "IECore/Shader.h"
@@ -43,6 +44,9 @@
 #include "IECoreGL/CurvesPrimitive.h"
 #include "IECoreGL/Group.h"
 
+#include "Gaffer/Metadata.h"
+#include "Gaffer/Private/IECorePreview/LRUCache.h"
+
 #include "GafferSceneUI/LightVisualiser.h"
 #include "GafferSceneUI/AttributeVisualiser.h"
 #include "GafferSceneUI/StandardLightVisualiser.h"
@@ -73,6 +77,45 @@ const LightVisualiser *standardLightVisualiser()
 	return l.get();
 }
 
+// Cache of visualisations, keyed by the hash of the attribute name and
+// light shader. Light rigs typically contain many lights with identical
+// shaders, and the visualisations are in local space, so they can be
+// shared between all locations. Visualisers take their behaviour from
+// metadata, so we clear the cache whenever that changes. We only ever
+// use getIfCached() and setIfUncached().
+
+typedef std::pair<IECoreGL::ConstRenderablePtr, IECoreGL::ConstStatePtr> Visualisation;
+typedef IECorePreview::LRUCache<IECore::MurmurHash, Visualisation> VisualisationCache;
+
+Visualisation visualisationCacheGetter( const IECore::MurmurHash &h, size_t &cost )
+{
+	throw IECore::Exception( "Unexpected call to visualisationCacheGetter" );
+}
+
+size_t visualisationCost( const Visualisation &visualisation )
+{
+	return 1;
+}
+
+void clearVisualisationCache();
+
+VisualisationCache *createVisualisationCache()
+{
+	Gaffer::Metadata::valueChangedSignal().connect( boost::bind( &clearVisualisationCache ) );
+	return new VisualisationCache( visualisationCacheGetter, 10000 );
+}
+
+VisualisationCache &visualisationCache()
+{
+	static VisualisationCache *g_cache = createVisualisationCache();
+	return *g_cache;
+}
+
+void clearVisualisationCache()
+{
+	visualisationCache().clear();
+}
+
 /// Class for visualisation of lights. All lights in Gaffer are represented
 /// as IECore::Shader objects, but we need to visualise them differently
 /// depending on their shader name (accessed using `IECore::Shader::getName()`). A
@@ -152,8 +195,23 @@ IECoreGL::ConstRenderablePtr AttributeVisualiserForLights::visualise( const IECo
 			visualiser = visIt->second.get();
 		}
 
+		IECore::MurmurHash visualisationHash = shaderVector->Object::hash();
+		visualisationHash.append( it->first );
+
 		IECoreGL::ConstStatePtr curState = NULL;
-		IECoreGL::ConstRenderablePtr curVis = visualiser->visualise( it->first, shaderVector, curState );
+		IECoreGL::ConstRenderablePtr curVis = NULL;
+
+		VisualisationCache &cache = visualisationCache();
+		if( boost::optional<Visualisation> cached = cache.getIfCached( visualisationHash ) )
+		{
+			curVis = cached->first;
+			curState = cached->second;
+		}
+		else
+		{
+			curVis = visualiser->visualise( it->first, shaderVector, curState );
+			cache.setIfUncached( visualisationHash, Visualisation( curVis, curState ), visualisationCost );
+		}
 
 		if( curVis )
 		{
@@ -198,4 +256,5 @@ LightVisualiser::~LightVisualiser()
 void LightVisualiser::registerLightVisualiser( const IECore::InternedString &attributeName, const IECore::InternedString &shaderName, ConstLightVisualiserPtr visualiser )
 {
 	lightVisualisers()[AttributeAndShaderNames( attributeName, shaderName )] = visualiser;
+	clearVisualisationCache();
 }
@@ -34,7 +34,10 @@
 //
 //////////////////////////////////////////////////////////////////////////
 
+#include <set>
+
 #include "tbb/task.h"
+#include "tbb/tick_count.h"
 #include "tbb/concurrent_unordered_set.h"
 
 #include "boost/bind.hpp"
@@ -127,6 +130,157 @@ void doPendingReferenceRemovals()
 
 } // namespace
 
+//////////////////////////////////////////////////////////////////////////
+// Culling
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+// Decides how a location should be drawn, given its bound and
+// the matrix which takes it into clip space. Also limits the time
+// spent drawing renderables for the first time in each frame. That
+// is when IECoreGL uploads their buffers to the GPU, which can take
+// a long time after a large update, so once the limit is reached we
+// draw proxies instead and continue in the next frame.
+class Culler
+{
+
+	public :
+
+		enum Result
+		{
+			// Entirely outside the view.
+			Culled,
+			// Too small on screen to be worth drawing in full,
+			// so it should be drawn as a bounding box.
+			Proxy,
+			Full,
+			// Entirely inside the view. Only returned when
+			// requested via the constructor, for use in drag
+			// selection, where such locations can be accepted
+			// without drawing them.
+			Contained
+		};
+
+		Culler( const V2f &viewportSize, float proxyThreshold, float uploadTimeLimit, unsigned selectionPass = 0, bool testContainment = false )
+			:	m_viewportSize( viewportSize ), m_proxyThreshold( proxyThreshold ),
+				m_uploadTimeLimit( uploadTimeLimit ), m_uploadTime( 0.0 ), m_uploadsDeferred( false ),
+				m_selectionPass( selectionPass ), m_testContainment( testContainment )
+		{
+		}
+
+		Result test( const Box3f &bound, const M44f &toClip ) const
+		{
+			if( bound.isEmpty() )
+			{
+				// We don't know what extent the location
+				// has, so must draw it regardless.
+				return Full;
+			}
+
+			unsigned outside = 63;
+			unsigned clipped = 0;
+			bool inFront = true;
+			Box2f ndcBound;
+			for( int i = 0; i < 8; ++i )
+			{
+				const V4f p(
+					i & 1 ? bound.max.x : bound.min.x,
+					i & 2 ? bound.max.y : bound.min.y,
+					i & 4 ? bound.max.z : bound.min.z,
+					1.0f
+				);
+				const V4f c = p * toClip;
+
+				unsigned outcode = 0;
+				outcode |= c.x < -c.w ? 1 : 0;
+				outcode |= c.x > c.w ? 2 : 0;
+				outcode |= c.y < -c.w ? 4 : 0;
+				outcode |= c.y > c.w ? 8 : 0;
+				outcode |= c.z < -c.w ? 16 : 0;
+				outcode |= c.z > c.w ? 32 : 0;
+				outside &= outcode;
+				clipped |= outcode;
+
+				if( c.w > 0.0f )
+				{
+					ndcBound.extendBy( V2f( c.x / c.w, c.y / c.w ) );
+				}
+				else
+				{
+					inFront = false;
+				}
+			}
+
+			if( outside )
+			{
+				// All corners are outside the same clipping plane.
+				return Culled;
+			}
+
+			if( m_testContainment && !clipped )
+			{
+				return Contained;
+			}
+
+			if( m_proxyThreshold > 0.0f && inFront )
+			{
+				const V2f rasterSize = ndcBound.size() * 0.5f * m_viewportSize;
+				if( std::max( rasterSize.x, rasterSize.y ) < m_proxyThreshold )
+				{
+					return Proxy;
+				}
+			}
+
+			return Full;
+		}
+
+		bool mayUpload()
+		{
+			if( m_uploadTimeLimit > 0.0f && m_uploadTime > m_uploadTimeLimit )
+			{
+				m_uploadsDeferred = true;
+				return false;
+			}
+			return true;
+		}
+
+		void uploaded( double seconds )
+		{
+			m_uploadTime += seconds;
+		}
+
+		/// True if mayUpload() returned false at least once,
+		/// meaning another frame is needed to finish drawing.
+		bool uploadsDeferred() const
+		{
+			return m_uploadsDeferred;
+		}
+
+		/// Identifies the selection render being performed, so
+		/// that selection ids from previous renders can be ignored.
+		unsigned selectionPass() const
+		{
+			return m_selectionPass;
+		}
+
+	private :
+
+		V2f m_viewportSize;
+		float m_proxyThreshold;
+
+		float m_uploadTimeLimit;
+		double m_uploadTime;
+		bool m_uploadsDeferred;
+
+		unsigned m_selectionPass;
+		bool m_testContainment;
+
+};
+
+} // namespace
+
 //////////////////////////////////////////////////////////////////////////
 // SceneGraph implementation
 //
@@ -162,7 +316,7 @@ class SceneGadget::SceneGraph
 	public :
 
 		SceneGraph()
-			:	m_selected( false ), m_visible( true ), m_expanded( false )
+			:	m_renderableDrawn( false ), m_selectionId( 0 ), m_selectionPass( 0 ), m_selectionContained( false ), m_selected( false ), m_visible( true ), m_expanded( false ), m_dirtyFlags( 0 ), m_pending( false )
 		{
 		}
 
@@ -171,7 +325,7 @@ class SceneGadget::SceneGraph
 			clear();
 		}
 
-		void render( IECoreGL::State *currentState, IECoreGL::Selector *selector = NULL ) const
+		void render( IECoreGL::State *currentState, Culler &culler, const M44f &parentToClip, IECoreGL::Selector *selector = NULL ) const
 		{
 			if( !m_visible || !valid() )
 			{
@@ -179,6 +333,25 @@ class SceneGadget::SceneGraph
 			}
 
 			const bool haveTransform = m_transform != M44f();
+			const M44f toClip = haveTransform ? m_transform * parentToClip : parentToClip;
+			const Culler::Result cullerResult = culler.test( m_cullBound, toClip );
+			if( cullerResult == Culler::Culled )
+			{
+				return;
+			}
+
+			if( selector )
+			{
+				m_selectionPass = culler.selectionPass();
+				m_selectionContained = cullerResult == Culler::Contained;
+				if( m_selectionContained )
+				{
+					// Everything here is selected, so there's
+					// no need to draw it.
+					return;
+				}
+			}
+
 			if( haveTransform )
 			{
 				glPushMatrix();
@@ -194,25 +367,14 @@ class SceneGadget::SceneGraph
 						m_selectionId = selector->loadName();
 					}
 
-					if( m_renderable )
-					{
-						m_renderable->render( currentState );
-					}
-
-					if( m_attributesRenderable )
-					{
-						m_attributesRenderable->render( currentState );
-					}
-
-					if( m_boundRenderable )
+					if( cullerResult == Culler::Proxy )
 					{
 						IECoreGL::State::ScopedBinding wireframeScope( wireframeState(), *currentState );
-						m_boundRenderable->render( currentState );
+						proxyRenderable()->render( currentState );
 					}
-
-					for( std::vector<SceneGraph *>::const_iterator it = m_children.begin(), eIt = m_children.end(); it != eIt; ++it )
+					else
 					{
-						(*it)->render( currentState, selector );
+						renderFull( currentState, culler, toClip, selector );
 					}
 				}
 
@@ -228,14 +390,25 @@ class SceneGadget::SceneGraph
 			applySelectionWalk( selection, rootPath, true );
 		}
 
-		bool pathFromSelectionId( GLuint selectionId, ScenePlug::ScenePath &path ) const
+		bool pathFromSelectionId( GLuint selectionId, unsigned selectionPass, ScenePlug::ScenePath &path ) const
 		{
 			path.clear();
-			const bool result = pathFromSelectionIdWalk( selectionId, path );
+			const bool result = pathFromSelectionIdWalk( selectionId, selectionPass, path );
 			std::reverse( path.begin(), path.end() );
 			return result;
 		}
 
+		/// Adds the paths of all locations hit by a selection render, including
+		/// those which were entirely contained within the selection region and
+		/// were therefore accepted without being drawn. Unlike pathFromSelectionId(),
+		/// a single walk is made no matter how many hits there are, and only the
+		/// locations visited by the selection render are considered.
+		size_t pathsFromSelection( const std::set<GLuint> &selectionIds, unsigned selectionPass, PathMatcher &paths ) const
+		{
+			ScenePlug::ScenePath path;
+			return pathsFromSelectionWalk( selectionIds, selectionPass, false, path, paths );
+		}
+
 		const Box3f &bound() const
 		{
 			return m_bound;
@@ -272,14 +445,159 @@ class SceneGadget::SceneGraph
 			deferReferenceRemoval( m_renderable );
 			deferReferenceRemoval( m_boundRenderable );
 			deferReferenceRemoval( m_attributesRenderable );
+			deferReferenceRemoval( m_proxyRenderable );
 			clearChildren();
 			m_objectHash = m_attributesHash = IECore::MurmurHash();
+			m_dirtyFlags = 0;
+			m_pending = false;
+		}
+
+		/// True if this location or any of its descendants
+		/// has updates outstanding from an update which ran
+		/// out of time.
+		bool pending() const
+		{
+			return m_pending;
 		}
 
 	private :
 
 		friend class UpdateTask;
 
+		void renderFull( IECoreGL::State *currentState, Culler &culler, const M44f &toClip, IECoreGL::Selector *selector ) const
+		{
+			if( m_renderable )
+			{
+				renderRenderable( currentState, culler );
+			}
+
+			if( m_attributesRenderable )
+			{
+				m_attributesRenderable->render( currentState );
+			}
+
+			if( m_boundRenderable )
+			{
+				IECoreGL::State::ScopedBinding wireframeScope( wireframeState(), *currentState );
+				m_boundRenderable->render( currentState );
+			}
+
+			// Runs of children which share the same object and state, as
+			// produced by the Instancer or Duplicate nodes for instance,
+			// are drawn with a single state binding between them.
+
+			for( size_t i = 0, e = m_children.size(); i < e; )
+			{
+				size_t runEnd = i + 1;
+				if( m_children[i]->instanceable() )
+				{
+					while( runEnd < e && m_children[runEnd]->instanceMatches( *m_children[i] ) )
+					{
+						++runEnd;
+					}
+				}
+
+				if( runEnd - i > 1 )
+				{
+					renderInstances( i, runEnd, currentState, culler, toClip, selector );
+				}
+				else
+				{
+					m_children[i]->render( currentState, culler, toClip, selector );
+				}
+
+				i = runEnd;
+			}
+		}
+
+		void renderRenderable( IECoreGL::State *currentState, Culler &culler ) const
+		{
+			if( m_renderableDrawn )
+			{
+				m_renderable->render( currentState );
+				return;
+			}
+
+			if( !culler.mayUpload() )
+			{
+				IECoreGL::State::ScopedBinding wireframeScope( wireframeState(), *currentState );
+				proxyRenderable()->render( currentState );
+				return;
+			}
+
+			const tbb::tick_count startTime = tbb::tick_count::now();
+			m_renderable->render( currentState );
+			culler.uploaded( ( tbb::tick_count::now() - startTime ).seconds() );
+			m_renderableDrawn = true;
+		}
+
+		// Returns true if this location is a simple leaf that can
+		// be drawn as part of a run of identical siblings.
+		bool instanceable() const
+		{
+			return
+				m_visible && valid() && m_renderable &&
+				m_children.empty() && !m_attributesRenderable && !m_boundRenderable
+			;
+		}
+
+		bool instanceMatches( const SceneGraph &other ) const
+		{
+			return
+				instanceable() &&
+				m_renderable == other.m_renderable &&
+				m_state == other.m_state &&
+				m_selected == other.m_selected
+			;
+		}
+
+		void renderInstances( size_t begin, size_t end, IECoreGL::State *currentState, Culler &culler, const M44f &parentToClip, IECoreGL::Selector *selector ) const
+		{
+			const SceneGraph *first = m_children[begin];
+			IECoreGL::State::ScopedBinding scope( *first->m_state, *currentState );
+			IECoreGL::State::ScopedBinding selectionScope( selectionState(), *currentState, first->m_selected );
+
+			for( size_t i = begin; i < end; ++i )
+			{
+				const SceneGraph *instance = m_children[i];
+				const Culler::Result cullerResult = culler.test( instance->m_cullBound, instance->m_transform * parentToClip );
+				if( cullerResult == Culler::Culled )
+				{
+					continue;
+				}
+
+				if( selector )
+				{
+					instance->m_selectionPass = culler.selectionPass();
+					instance->m_selectionContained = cullerResult == Culler::Contained;
+					if( instance->m_selectionContained )
+					{
+						continue;
+					}
+				}
+
+				glPushMatrix();
+				glMultMatrixf( instance->m_transform.getValue() );
+
+					if( selector )
+					{
+						instance->m_selectionId = selector->loadName();
+					}
+
+					if( cullerResult == Culler::Proxy )
+					{
+						IECoreGL::State::ScopedBinding wireframeScope( wireframeState(), *currentState );
+						instance->proxyRenderable()->render( currentState );
+					}
+					else
+					{
+						instance->renderRenderable( currentState, culler );
+					}
+
+				glPopMatrix();
+			}
+		}
+
 		void clearChildren()
 		{
 			for( std::vector<SceneGraph *>::const_iterator it = m_children.begin(), eIt = m_children.end(); it != eIt; ++it )
@@ -304,9 +622,16 @@ class SceneGadget::SceneGraph
 			}
 		}
 
-		bool pathFromSelectionIdWalk( GLuint selectionId, ScenePlug::ScenePath &path ) const
+		bool pathFromSelectionIdWalk( GLuint selectionId, unsigned selectionPass, ScenePlug::ScenePath &path ) const
 		{
-			if( m_selectionId == selectionId )
+			if( m_selectionPass != selectionPass )
+			{
+				// Not visited by the selection render, so
+				// neither we nor our children can be hit.
+				return false;
+			}
+
+			if( m_selectionId == selectionId && !m_selectionContained )
 			{
 				path.push_back( m_name );
 				return true;
@@ -317,7 +642,7 @@ class SceneGadget::SceneGraph
 				{
 					/// \todo Should be able to prune recursion based on knowledge that child
 					/// selection ids are always greater than parent selection ids.
-					if( (*it)->pathFromSelectionIdWalk( selectionId, path ) )
+					if( (*it)->pathFromSelectionIdWalk( selectionId, selectionPass, path ) )
 					{
 						if( m_name != IECore::InternedString() )
 						{
@@ -331,6 +656,80 @@ class SceneGadget::SceneGraph
 			return false;
 		}
 
+		// Computes the bound used for culling, which unlike m_bound
+		// must also include any attribute visualisations.
+		void updateCullBound()
+		{
+			m_cullBound = m_bound;
+			if( m_attributesRenderable )
+			{
+				m_cullBound.extendBy( m_attributesRenderable->bound() );
+			}
+			for( std::vector<SceneGraph *>::const_iterator it = m_children.begin(), eIt = m_children.end(); it != eIt; ++it )
+			{
+				m_cullBound.extendBy( transform( (*it)->m_cullBound, (*it)->m_transform ) );
+			}
+		}
+
+		// Returns a box for drawing in place of this location when
+		// it is too small to be worth drawing in full. This is only
+		// called from render(), so we can create it lazily on the main
+		// thread without worrying about concurrent access.
+		const IECoreGL::Renderable *proxyRenderable() const
+		{
+			if( !m_proxyRenderable || m_proxyBound != m_cullBound )
+			{
+				IECore::CurvesPrimitivePtr curvesBound = IECore::CurvesPrimitive::createBox( m_cullBound );
+				m_proxyRenderable = boost::static_pointer_cast<const IECoreGL::Renderable>(
+					IECoreGL::CachedConverter::defaultCachedConverter()->convert( curvesBound.get() )
+				);
+				m_proxyBound = m_cullBound;
+			}
+			return m_proxyRenderable.get();
+		}
+
+		size_t pathsFromSelectionWalk( const std::set<GLuint> &selectionIds, unsigned selectionPass, bool contained, ScenePlug::ScenePath &path, PathMatcher &paths ) const
+		{
+			if( !m_visible || !valid() )
+			{
+				return 0;
+			}
+
+			if( !contained )
+			{
+				if( m_selectionPass != selectionPass )
+				{
+					return 0;
+				}
+				contained = m_selectionContained;
+			}
+
+			size_t result = 0;
+			if( contained )
+			{
+				// Accept everything that would have drawn
+				// something, had we rendered it.
+				if( m_renderable || m_attributesRenderable || m_boundRenderable )
+				{
+					result += paths.addPath( path );
+				}
+			}
+			else if( selectionIds.find( m_selectionId ) != selectionIds.end() )
+			{
+				result += paths.addPath( path );
+			}
+
+			path.push_back( IECore::InternedString() ); // space for the child name
+			for( std::vector<SceneGraph *>::const_iterator it = m_children.begin(), eIt = m_children.end(); it != eIt; ++it )
+			{
+				path.back() = (*it)->m_name;
+				result += (*it)->pathsFromSelectionWalk( selectionIds, selectionPass, contained, path, paths );
+			}
+			path.pop_back();
+
+			return result;
+		}
+
 		static const IECoreGL::State &selectionState()
 		{
 			static IECoreGL::StatePtr s;
@@ -357,14 +756,21 @@ class SceneGadget::SceneGraph
 		}
 
 		Imath::Box3f m_bound;
+		Imath::Box3f m_cullBound;
 		Imath::M44f m_transform;
 		IECore::InternedString m_name;
 		IECoreGL::ConstStatePtr m_state;
 		IECoreGL::ConstRenderablePtr m_renderable;
+		// False until m_renderable has been drawn for the first time.
+		mutable bool m_renderableDrawn;
 		IECoreGL::ConstRenderablePtr m_boundRenderable;
 		IECoreGL::ConstRenderablePtr m_attributesRenderable;
+		mutable IECoreGL::ConstRenderablePtr m_proxyRenderable;
+		mutable Imath::Box3f m_proxyBound;
 		std::vector<SceneGraph *> m_children;
 		mutable GLuint m_selectionId;
+		mutable unsigned m_selectionPass;
+		mutable bool m_selectionContained;
 		bool m_selected;
 		bool m_visible;
 		bool m_expanded;
@@ -372,6 +778,11 @@ class SceneGadget::SceneGraph
 		IECore::MurmurHash m_objectHash;
 		IECore::MurmurHash m_attributesHash;
 
+		// Dirty flags for updates which have been
+		// deferred to a subsequent call to updateSceneGraph().
+		unsigned m_dirtyFlags;
+		bool m_pending;
+
 };
 
 class SceneGadget::UpdateTask : public tbb::task
@@ -391,18 +802,50 @@ class SceneGadget::UpdateTask : public tbb::task
 			AllDirty = BoundDirty | TransformDirty | AttributesDirty | ObjectDirty | ChildNamesDirty | ExpansionDirty
 		};
 
-		UpdateTask( const SceneGadget *sceneGadget, SceneGraph *sceneGraph, unsigned dirtyFlags, const ScenePlug::ScenePath &scenePath )
+		UpdateTask( const SceneGadget *sceneGadget, SceneGraph *sceneGraph, unsigned dirtyFlags, const ScenePlug::ScenePath &scenePath, bool deferrable = false )
 			:	m_sceneGadget( sceneGadget ),
 				m_sceneGraph( sceneGraph ),
 				m_dirtyFlags( dirtyFlags ),
-				m_scenePath( scenePath )
+				m_scenePath( scenePath ),
+				m_deferrable( deferrable )
 		{
 		}
 
 		virtual task *execute()
 		{
+			// Pick up any updates left over from a previous
+			// update which ran out of time, and early out if
+			// there is nothing to do here or below.
+
+			m_dirtyFlags |= m_sceneGraph->m_dirtyFlags;
+			if( !m_dirtyFlags && !m_sceneGraph->m_pending )
+			{
+				return NULL;
+			}
+
+			// If we've exceeded the time allowed for the update, then
+			// store our dirty flags, so the next update can continue
+			// from here. Until then we'll be drawn in our previous state,
+			// or as part of our parent's bounding box if we're new. We
+			// are only deferrable if our parent did some work, which ensures
+			// that each update makes progress no matter how small the budget.
+
+			if( m_deferrable && m_dirtyFlags && m_sceneGadget->updateTimeExceeded() )
+			{
+				m_sceneGraph->m_dirtyFlags = m_dirtyFlags;
+				m_sceneGraph->m_pending = true;
+				return NULL;
+			}
+
+			m_sceneGraph->m_dirtyFlags = NothingDirty;
+			m_sceneGraph->m_pending = false;
+
 			ContextPtr context = new Context( *m_sceneGadget->m_context, Context::Borrowed );
 			context->set( ScenePlug::scenePathContextName, m_scenePath );
+			if( m_sceneGadget->m_levelOfDetail )
+			{
+				context->set( ScenePlug::levelOfDetailContextName, m_sceneGadget->m_levelOfDetail );
+			}
 			Context::Scope scopedContext( context.get() );
 
 			// Update attributes, and compute visibility.
@@ -466,6 +909,7 @@ class SceneGadget::UpdateTask : public tbb::task
 				{
 					IECore::ConstObjectPtr object = m_sceneGadget->m_scene->objectPlug()->getValue( &objectHash );
 					deferReferenceRemoval( m_sceneGraph->m_renderable );
+					m_sceneGraph->m_renderableDrawn = false;
 					if( !object->isInstanceOf( IECore::NullObjectTypeId ) )
 					{
 						m_sceneGraph->m_renderable = objectToRenderable( object.get() );
@@ -521,6 +965,7 @@ class SceneGadget::UpdateTask : public tbb::task
 						IECoreGL::CachedConverter::defaultCachedConverter()->convert( curvesBound.get() )
 					);
 				}
+				m_sceneGraph->updateCullBound();
 				return NULL;
 			}
 
@@ -564,7 +1009,7 @@ class SceneGadget::UpdateTask : public tbb::task
 				for( std::vector<SceneGraph *>::const_iterator it = m_sceneGraph->m_children.begin(), eIt = m_sceneGraph->m_children.end(); it != eIt; ++it )
 				{
 					childPath.back() = (*it)->m_name;
-					UpdateTask *t = new( allocate_child() ) UpdateTask( m_sceneGadget, *it, m_dirtyFlags, childPath );
+					UpdateTask *t = new( allocate_child() ) UpdateTask( m_sceneGadget, *it, m_dirtyFlags, childPath, /* deferrable = */ m_dirtyFlags != NothingDirty );
 					spawn( *t );
 				}
 
@@ -577,8 +1022,24 @@ class SceneGadget::UpdateTask : public tbb::task
 			{
 				const Box3f childBound = transform( (*it)->m_bound, (*it)->m_transform );
 				m_sceneGraph->m_bound.extendBy( childBound );
+				m_sceneGraph->m_pending = m_sceneGraph->m_pending || (*it)->m_pending;
 			}
 
+			// And if some of the children are still pending, draw
+			// our full bounding box to stand in for them until
+			// they are complete.
+
+			if( m_sceneGraph->m_pending )
+			{
+				m_sceneGraph->m_bound.extendBy( m_sceneGadget->m_scene->boundPlug()->getValue() );
+				IECore::CurvesPrimitivePtr curvesBound = IECore::CurvesPrimitive::createBox( m_sceneGraph->m_bound );
+				m_sceneGraph->m_boundRenderable = boost::static_pointer_cast<const IECoreGL::Renderable>(
+					IECoreGL::CachedConverter::defaultCachedConverter()->convert( curvesBound.get() )
+				);
+			}
+
+			m_sceneGraph->updateCullBound();
+
 			return NULL;
 		}
 
@@ -604,6 +1065,7 @@ class SceneGadget::UpdateTask : public tbb::task
 		SceneGraph *m_sceneGraph;
 		unsigned m_dirtyFlags;
 		ScenePlug::ScenePath m_scenePath;
+		bool m_deferrable;
 
 };
 
@@ -618,6 +1080,12 @@ SceneGadget::SceneGadget()
 		m_dirtyFlags( UpdateTask::AllDirty ),
 		m_expandedPaths( new PathMatcherData ),
 		m_minimumExpansionDepth( 0 ),
+		m_proxyThreshold( 0.0f ),
+		m_uploadBudget( 0.0f ),
+		m_updateBudget( 0.0f ),
+		m_levelOfDetail( 0 ),
+		m_updateTimeLimit( 0.0f ),
+		m_selectionPass( 0 ),
 		m_baseState( new IECoreGL::State( true ) ),
 		m_sceneGraph( new SceneGraph ),
 		m_selection( new PathMatcherData )
@@ -709,6 +1177,63 @@ size_t SceneGadget::getMinimumExpansionDepth() const
 	return m_minimumExpansionDepth;
 }
 
+void SceneGadget::setProxyThreshold( float pixels )
+{
+	if( pixels == m_proxyThreshold )
+	{
+		return;
+	}
+	m_proxyThreshold = pixels;
+	requestRender();
+}
+
+float SceneGadget::getProxyThreshold() const
+{
+	return m_proxyThreshold;
+}
+
+void SceneGadget::setUploadBudget( float seconds )
+{
+	m_uploadBudget = seconds;
+}
+
+float SceneGadget::getUploadBudget() const
+{
+	return m_uploadBudget;
+}
+
+void SceneGadget::setUpdateBudget( float seconds )
+{
+	m_updateBudget = seconds;
+}
+
+float SceneGadget::getUpdateBudget() const
+{
+	return m_updateBudget;
+}
+
+bool SceneGadget::updatePending() const
+{
+	return m_dirtyFlags || m_sceneGraph->pending();
+}
+
+void SceneGadget::setLevelOfDetail( int levelOfDetail )
+{
+	if( levelOfDetail == m_levelOfDetail )
+	{
+		return;
+	}
+
+	m_levelOfDetail = levelOfDetail;
+	m_dirtyFlags = UpdateTask::AllDirty;
+	requestRender();
+}
+
+int SceneGadget::getLevelOfDetail() const
+{
+	return m_levelOfDetail;
+}
+
 IECoreGL::State *SceneGadget::baseState()
 {
 	return m_baseState.get();
@@ -729,7 +1254,7 @@ bool SceneGadget::objectAt( const IECore::LineSegment3f &lineInGadgetSpace, Gaff
 		return false;
 	}
 
-	return m_sceneGraph->pathFromSelectionId( selection[0].name, path );
+	return m_sceneGraph->pathFromSelectionId( selection[0].name, m_selectionPass, path );
 }
 
 size_t SceneGadget::objectsAt(
@@ -743,20 +1268,19 @@ size_t SceneGadget::objectsAt(
 	std::vector<IECoreGL::HitRecord> selection;
 	{
 		ViewportGadget::SelectionScope selectionScope( corner0InGadgetSpace, corner1InGadgetSpace, this, selection, IECoreGL::Selector::OcclusionQuery );
-		renderSceneGraph( selectionScope.baseState() );
+		// Occlusion queries don't consider depth, so any location
+		// entirely within the selection region is known to be selected,
+		// and can be accepted without being drawn.
+		renderSceneGraph( selectionScope.baseState(), /* testContainment = */ true );
 	}
 
-	size_t result = 0;
-	ScenePlug::ScenePath path;
+	std::set<GLuint> selectionIds;
 	for( std::vector<IECoreGL::HitRecord>::const_iterator it = selection.begin(), eIt = selection.end(); it != eIt; ++it )
 	{
-		if( m_sceneGraph->pathFromSelectionId( it->name, path ) )
-		{
-			result += paths.addPath( path );
-		}
+		selectionIds.insert( it->name );
 	}
 
-	return result;
+	return m_sceneGraph->pathsFromSelection( selectionIds, m_selectionPass, paths );
 }
 
 const GafferScene::PathMatcherData *SceneGadget::getSelection() const
@@ -773,7 +1297,7 @@ void SceneGadget::setSelection( ConstPathMatcherDataPtr selection )
 
 Imath::Box3f SceneGadget::selectionBound() const
 {
-	updateSceneGraph();
+	updateSceneGraph( /* complete = */ true );
 	return m_sceneGraph->selectionBound();
 }
 
@@ -796,7 +1320,7 @@ std::string SceneGadget::getToolTip( const IECore::LineSegment3f &line ) const
 
 Imath::Box3f SceneGadget::bound() const
 {
-	updateSceneGraph();
+	updateSceneGraph( /* complete = */ true );
 	return m_sceneGraph->bound();
 }
 
@@ -852,9 +1376,9 @@ void SceneGadget::contextChanged( const IECore::InternedString &name )
 	}
 }
 
-void SceneGadget::updateSceneGraph() const
+void SceneGadget::updateSceneGraph( bool complete ) const
 {
-	if( !m_dirtyFlags )
+	if( !updatePending() )
 	{
 		return;
 	}
@@ -866,15 +1390,18 @@ void SceneGadget::updateSceneGraph() const
 		m_dirtyFlags = UpdateTask::AllDirty;
 	}
 
+	m_updateStartTime = tbb::tick_count::now();
+	m_updateTimeLimit = complete ? 0.0f : m_updateBudget;
+
 	try
 	{
 		UpdateTask *task = new( tbb::task::allocate_root() ) UpdateTask( this, m_sceneGraph.get(), m_dirtyFlags, ScenePlug::ScenePath() );
 		tbb::task::spawn_root_and_wait( *task );
 
-		if( m_dirtyFlags && UpdateTask::ChildNamesDirty )
-		{
-			m_sceneGraph->applySelection( m_selection->readable() );
-		}
+		// New locations may have been created by this update or by
+		// the continuation of a previous one, so we must always
+		// reapply the selection.
+		m_sceneGraph->applySelection( m_selection->readable() );
 	}
 	catch( const std::exception& e )
 	{
@@ -889,19 +1416,58 @@ void SceneGadget::updateSceneGraph() const
 	// flags (see above) to ensure that the next update is a complete
 	// one.
 	m_dirtyFlags = UpdateTask::NothingDirty;
+
+	if( m_sceneGraph->pending() )
+	{
+		// We ran out of time, so schedule another render in which we
+		// can continue the update. We can't request the render directly
+		// because we may be in the middle of rendering already.
+		executeOnUIThread( boost::bind( &Gadget::requestRender, GadgetPtr( const_cast<SceneGadget *>( this ) ) ) );
+	}
 }
 
-void SceneGadget::renderSceneGraph( const IECoreGL::State *stateToBind ) const
+bool SceneGadget::updateTimeExceeded() const
+{
+	return m_updateTimeLimit > 0.0f && ( tbb::tick_count::now() - m_updateStartTime ).seconds() > m_updateTimeLimit;
+}
+
+void SceneGadget::renderSceneGraph( const IECoreGL::State *stateToBind, bool testContainment ) const
 {
 	GLint prevProgram;
 	glGetIntegerv( GL_CURRENT_PROGRAM, &prevProgram );
 	glPushAttrib( GL_ALL_ATTRIB_BITS );
 
+	// Locations are culled against the current view, and drawn as
+	// proxies if they are too small. We don't use proxies during
+	// selection though, because the selection projection doesn't give
+	// a meaningful screen size.
+
+	M44f modelView, projection;
+	glGetFloatv( GL_MODELVIEW_MATRIX, modelView.getValue() );
+	glGetFloatv( GL_PROJECTION_MATRIX, projection.getValue() );
+
+	GLint viewport[4];
+	glGetIntegerv( GL_VIEWPORT, viewport );
+
+	IECoreGL::Selector *selector = IECoreGL::Selector::currentSelector();
+	if( selector )
+	{
+		m_selectionPass++;
+	}
+
+	Culler culler(
+		V2f( viewport[2], viewport[3] ),
+		selector ? 0.0f : m_proxyThreshold,
+		selector ? 0.0f : m_uploadBudget,
+		m_selectionPass,
+		selector && testContainment
+	);
+
 	try
 	{
 		IECoreGL::State::bindBaseState();
 		stateToBind->bind();
-		m_sceneGraph->render( const_cast<IECoreGL::State *>( stateToBind ), IECoreGL::Selector::currentSelector() );
+		m_sceneGraph->render( const_cast<IECoreGL::State *>( stateToBind ), culler, modelView * projection, selector );
 	}
 	catch( const std::exception& e )
 	{
@@ -910,4 +1476,9 @@ void SceneGadget::renderSceneGraph( const IECoreGL::State *stateToBind ) const
 
 	glPopAttrib();
 	glUseProgram( prevProgram );
+
+	if( culler.uploadsDeferred() )
+	{
+		executeOnUIThread( boost::bind( &Gadget::requestRender, GadgetPtr( const_cast<SceneGadget *>( this ) ) ) );
+	}
 }
@@ -1123,6 +1123,11 @@ SceneView::SceneView( const std::string &name )
 
 	addChild( new IntPlug( "minimumExpansionDepth", Plug::In, 0, 0, Imath::limits<int>::max(), Plug::Default & ~Plug::AcceptsInputs ) );
 
+	ValuePlugPtr prefetch = new ValuePlug( "prefetch", Plug::In, Plug::Default & ~Plug::AcceptsInputs );
+	prefetch->addChild( new BoolPlug( "enabled", Plug::In, false, Plug::Default & ~Plug::AcceptsInputs ) );
+	prefetch->addChild( new IntPlug( "frames", Plug::In, 10, 1, Imath::limits<int>::max(), Plug::Default & ~Plug::AcceptsInputs ) );
+	addChild( prefetch );
+
 	plugSetSignal().connect( boost::bind( &SceneView::plugSet, this, ::_1 ) );
 
 	// set up our gadgets
@@ -1131,6 +1136,10 @@ SceneView::SceneView( const std::string &name )
 	viewportGadget()->keyPressSignal().connect( boost::bind( &SceneView::keyPress, this, ::_1, ::_2 ) );
 
 	m_sceneGadget->setContext( getContext() );
+	m_sceneGadget->setUpdateBudget( 0.1f );
+	m_sceneGadget->setProxyThreshold( 2.0f );
+	m_sceneGadget->setUploadBudget( 0.05f );
+	m_sceneGadget->setLevelOfDetail( 1 );
 
 	m_drawingMode = boost::make_shared<DrawingMode>( this );
 	m_shadingMode = boost::make_shared<ShadingMode>( this );
@@ -1192,6 +1201,16 @@ const Gaffer::IntPlug *SceneView::minimumExpansionDepthPlug() const
 	return getChild<IntPlug>( g_firstPlugIndex );
 }
 
+Gaffer::ValuePlug *SceneView::prefetchPlug()
+{
+	return getChild<ValuePlug>( g_firstPlugIndex + 1 );
+}
+
+const Gaffer::ValuePlug *SceneView::prefetchPlug() const
+{
+	return getChild<ValuePlug>( g_firstPlugIndex + 1 );
+}
+
 Gaffer::ValuePlug *SceneView::lookThroughPlug()
 {
 	return m_lookThrough->plug();
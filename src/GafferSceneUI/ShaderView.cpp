@@ -68,10 +68,10 @@ using namespace GafferSceneUI;
 namespace
 {
 
-typedef boost::container::flat_map<IECore::InternedString, ShaderView::RendererCreator> Renderers;
-Renderers &renderers()
+typedef boost::container::flat_map<IECore::InternedString, ShaderView::RendererCreator> RendererCreators;
+RendererCreators &rendererCreators()
 {
-	static Renderers r;
+	static RendererCreators r;
 	return r;
 }
 
@@ -296,6 +296,13 @@ void ShaderView::updateRenderer()
 		return;
 	}
 
+	if( m_renderer )
+	{
+		// Pause rather than destroy the current renderer, so that it
+		// can be resumed if we return to a shader of the same type.
+		m_renderer->getChild<IntPlug>( "state" )->setValue( InteractiveRender::Paused );
+	}
+
 	m_renderer = NULL;
 	m_rendererShaderPrefix = shaderPrefix;
 	if( !inPlug<Plug>()->getInput<Plug>() )
@@ -303,17 +310,27 @@ void ShaderView::updateRenderer()
 		return;
 	}
 
-	const Renderers &r = renderers();
-	Renderers::const_iterator it = r.find( shaderPrefix );
-	if( it == r.end() )
+	Renderers::const_iterator it = m_renderers.find( shaderPrefix );
+	if( it != m_renderers.end() )
 	{
-		return;
+		// Reuse previously created renderer
+		m_renderer = it->second;
 	}
+	else
+	{
+		const RendererCreators &r = rendererCreators();
+		RendererCreators::const_iterator cIt = r.find( shaderPrefix );
+		if( cIt == r.end() )
+		{
+			return;
+		}
 
-	m_renderer = it->second();
-	m_renderer->getChild<ScenePlug>( "in" )->setInput(
-		m_imageConverter->getChild<SceneNode>( "Outputs" )->outPlug()
-	);
+		m_renderer = cIt->second();
+		m_renderer->getChild<ScenePlug>( "in" )->setInput(
+			m_imageConverter->getChild<SceneNode>( "Outputs" )->outPlug()
+		);
+		m_renderers[shaderPrefix] = m_renderer;
+	}
 
 	updateRendererContext();
 }
@@ -338,7 +355,7 @@ void ShaderView::updateRendererState()
 	}
 
 	m_renderer->getChild<IntPlug>( "state" )->setValue(
-		viewportGadget()->visible() ? InteractiveRender::Running : InteractiveRender::Stopped
+		viewportGadget()->visible() ? InteractiveRender::Running : InteractiveRender::Paused
 	);
 }
 
@@ -429,7 +446,7 @@ void ShaderView::preRender()
 
 void ShaderView::registerRenderer( const std::string &shaderPrefix, RendererCreator rendererCreator )
 {
-	renderers()[shaderPrefix] = rendererCreator;
+	rendererCreators()[shaderPrefix] = rendererCreator;
 }
 
 void ShaderView::registerScene( const std::string &shaderPrefix, const std::string &name, const std::string &fileName )
@@ -88,6 +88,15 @@ BOOST_PYTHON_MODULE( _GafferSceneUI )
 		.def( "getExpandedPaths", &SceneGadget::getExpandedPaths, return_value_policy<CastToIntrusivePtr>() )
 		.def( "setMinimumExpansionDepth", &SceneGadget::setMinimumExpansionDepth )
 		.def( "getMinimumExpansionDepth", &SceneGadget::getMinimumExpansionDepth )
+		.def( "setProxyThreshold", &SceneGadget::setProxyThreshold )
+		.def( "getProxyThreshold", &SceneGadget::getProxyThreshold )
+		.def( "setUploadBudget", &SceneGadget::setUploadBudget )
+		.def( "getUploadBudget", &SceneGadget::getUploadBudget )
+		.def( "setUpdateBudget", &SceneGadget::setUpdateBudget )
+		.def( "getUpdateBudget", &SceneGadget::getUpdateBudget )
+		.def( "setLevelOfDetail", &SceneGadget::setLevelOfDetail )
+		.def( "getLevelOfDetail", &SceneGadget::getLevelOfDetail )
+		.def( "updatePending", &SceneGadget::updatePending )
 		.def( "baseState", &SceneGadget::baseState, return_value_policy<CastToIntrusivePtr>() )
 		.def( "objectAt", &objectAt )
 		.def( "objectsAt", &SceneGadget::objectsAt )
@@ -145,3 +145,40 @@ void GafferTest::testScopingNullContext()
 		}
 	}
 }
+
+// Tests that EditableScope provides the expected values and hashes,
+// and that contexts it hands out remain valid after the scope is closed.
+void GafferTest::testEditableScope()
+{
+	ContextPtr base = new Context();
+	base->set( "a", 1 );
+	base->set( "b", std::string( "b" ) );
+	const MurmurHash baseHash = base->hash();
+
+	ConstContextPtr captured;
+	for( int i = 0; i < 1000; ++i )
+	{
+		Context::EditableScope scope( base.get() );
+		GAFFERTEST_ASSERT( Context::current() == scope.context() );
+		GAFFERTEST_ASSERT( scope.context()->hash() == baseHash );
+
+		scope.set( "a", i );
+		GAFFERTEST_ASSERT( Context::current()->get<int>( "a" ) == i );
+		GAFFERTEST_ASSERT( Context::current()->get<std::string>( "b" ) == "b" );
+
+		ContextPtr expected = new Context( *base );
+		expected->set( "a", i );
+		GAFFERTEST_ASSERT( scope.context()->hash() == expected->hash() );
+
+		if( i == 500 )
+		{
+			captured = scope.context();
+		}
+	}
+
+	GAFFERTEST_ASSERT( Context::current() != captured.get() );
+	GAFFERTEST_ASSERT( captured->get<int>( "a" ) == 500 );
+	GAFFERTEST_ASSERT( captured->get<std::string>( "b" ) == "b" );
+	GAFFERTEST_ASSERT( base->get<int>( "a" ) == 1 );
+	GAFFERTEST_ASSERT( base->hash() == baseHash );
+}
@@ -0,0 +1,273 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2017, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//      * Redistributions of source code must retain the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer.
+//
+//      * Redistributions in binary form must reproduce the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer in the documentation and/or other materials provided with
+//        the distribution.
+//
+//      * Neither the name of John Haddon nor the names of
+//        any other contributors to this software may be used to endorse or
+//        promote products derived from this software without specific prior
+//        written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+
+#include "boost/lexical_cast.hpp"
+
+#include "IECore/Timer.h"
+
+#include "Gaffer/Context.h"
+#include "Gaffer/Node.h"
+#include "Gaffer/NumericPlug.h"
+#include "Gaffer/Process.h"
+#include "Gaffer/StringPlug.h"
+
+#include "GafferTest/Assert.h"
+#include "GafferTest/Microbenchmarks.h"
+#include "GafferTest/MultiplyNode.h"
+
+using namespace std;
+using namespace boost;
+using namespace IECore;
+using namespace Gaffer;
+using namespace GafferTest;
+
+namespace
+{
+
+// Process has only a protected constructor, so we
+// need a trivial subclass to be able to make one.
+class BenchmarkProcess : public Process
+{
+
+	public :
+
+		BenchmarkProcess( const Plug *plug )
+			:	Process( g_type, plug )
+		{
+		}
+
+	private :
+
+		static InternedString g_type;
+
+};
+
+InternedString BenchmarkProcess::g_type( "benchmark" );
+
+double nanosecondsPerOperation( Timer &timer, int iterations )
+{
+	return timer.stop() * 1e9 / std::max( iterations, 1 );
+}
+
+} // namespace
+
+double GafferTest::benchmarkProcessConstruction( int iterations )
+{
+	IntPlugPtr plug = new IntPlug;
+
+	Timer t;
+	for( int i = 0; i < iterations; ++i )
+	{
+		BenchmarkProcess process( plug.get() );
+	}
+
+	return nanosecondsPerOperation( t, iterations );
+}
+
+double GafferTest::benchmarkHashCacheHits( int iterations )
+{
+	MultiplyNodePtr node = new MultiplyNode;
+	const MurmurHash h = node->productPlug()->hash();
+
+	Timer t;
+	for( int i = 0; i < iterations; ++i )
+	{
+		GAFFERTEST_ASSERT( node->productPlug()->hash() == h );
+	}
+
+	return nanosecondsPerOperation( t, iterations );
+}
+
+double GafferTest::benchmarkHashCacheMisses( int iterations )
+{
+	MultiplyNodePtr node = new MultiplyNode;
+	ContextPtr context = new Context;
+
+	// A fresh value for a context variable gives a context
+	// hash that the cache hasn't seen, even though the
+	// result doesn't depend on it.
+	const InternedString name( "benchmark:iteration" );
+	Timer t;
+	for( int i = 0; i < iterations; ++i )
+	{
+		Context::EditableScope scope( context.get() );
+		scope.set( name, i );
+		node->productPlug()->hash();
+	}
+
+	return nanosecondsPerOperation( t, iterations );
+}
+
+double GafferTest::benchmarkComputeCacheHits( int iterations )
+{
+	MultiplyNodePtr node = new MultiplyNode;
+	node->op1Plug()->setValue( 2 );
+	node->op2Plug()->setValue( 3 );
+	GAFFERTEST_ASSERT( node->productPlug()->getValue() == 6 );
+
+	Timer t;
+	for( int i = 0; i < iterations; ++i )
+	{
+		GAFFERTEST_ASSERT( node->productPlug()->getValue() == 6 );
+	}
+
+	return nanosecondsPerOperation( t, iterations );
+}
+
+double GafferTest::benchmarkContextCreation( int iterations )
+{
+	ContextPtr base = new Context;
+	const InternedString name( "benchmark:iteration" );
+
+	Timer t;
+	for( int i = 0; i < iterations; ++i )
+	{
+		ContextPtr context = new Context( *base, Context::Borrowed );
+		context->set( name, i );
+	}
+
+	return nanosecondsPerOperation( t, iterations );
+}
+
+double GafferTest::benchmarkContextSet( int iterations )
+{
+	ContextPtr context = new Context;
+	const InternedString name( "benchmark:iteration" );
+	context->set( name, -1 );
+
+	Timer t;
+	for( int i = 0; i < iterations; ++i )
+	{
+		context->set( name, i );
+	}
+
+	return nanosecondsPerOperation( t, iterations );
+}
+
+double GafferTest::benchmarkContextHash( int iterations )
+{
+	// A typical context has a moderate number
+	// of variables, so we use a working set of 20.
+	ContextPtr context = new Context;
+	for( int i = 0; i < 20; ++i )
+	{
+		context->set( InternedString( "benchmark:key" + lexical_cast<string>( i ) ), i );
+	}
+
+	const InternedString name( "benchmark:iteration" );
+	Timer t;
+	for( int i = 0; i < iterations; ++i )
+	{
+		context->set( name, i );
+		context->hash();
+	}
+
+	return nanosecondsPerOperation( t, iterations );
+}
+
+double GafferTest::benchmarkStringPlugSubstitutions( int iterations )
+{
+	NodePtr node = new Node;
+	StringPlugPtr plug = new StringPlug;
+	node->addChild( plug );
+	plug->setValue( "${cookingMethod} me a ${foodType}" );
+
+	ContextPtr context = new Context;
+	context->set( "foodType", std::string( "kipper" ) );
+	context->set( "cookingMethod", std::string( "smoke" ) );
+	Context::Scope scope( context.get() );
+
+	// Substitutions are only performed when a plug is
+	// evaluated as part of a process.
+	BenchmarkProcess process( plug.get() );
+
+	Timer t;
+	for( int i = 0; i < iterations; ++i )
+	{
+		GAFFERTEST_ASSERT( plug->getValue() == "smoke me a kipper" );
+	}
+
+	return nanosecondsPerOperation( t, iterations );
+}
+
+double GafferTest::benchmarkDirtyPropagation( int iterations )
+{
+	const int numNodes = 100;
+
+	NodePtr parent = new Node;
+	vector<MultiplyNode *> nodes;
+	for( int i = 0; i < numNodes; ++i )
+	{
+		MultiplyNodePtr node = new MultiplyNode;
+		parent->addChild( node );
+		if( nodes.size() )
+		{
+			node->op1Plug()->setInput( nodes.back()->productPlug() );
+		}
+		nodes.push_back( node.get() );
+	}
+
+	Timer t;
+	for( int i = 0; i < iterations; ++i )
+	{
+		nodes.front()->op1Plug()->setValue( i );
+	}
+
+	return nanosecondsPerOperation( t, iterations * numNodes );
+}
+
+double GafferTest::benchmarkChildLookup( int iterations )
+{
+	const int numChildren = 100;
+
+	NodePtr node = new Node;
+	vector<InternedString> names;
+	for( int i = 0; i < numChildren; ++i )
+	{
+		names.push_back( "child" + lexical_cast<string>( i ) );
+		node->addChild( new IntPlug( names.back() ) );
+	}
+
+	Timer t;
+	for( int i = 0; i < iterations; ++i )
+	{
+		GAFFERTEST_ASSERT( node->getChild<IntPlug>( names[i % numChildren] ) );
+	}
+
+	return nanosecondsPerOperation( t, iterations );
+}
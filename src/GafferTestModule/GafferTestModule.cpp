@@ -46,6 +46,7 @@
 #include "GafferTest/ContextTest.h"
 #include "GafferTest/ComputeNodeTest.h"
 #include "GafferTest/DownstreamIteratorTest.h"
+#include "GafferTest/Microbenchmarks.h"
 
 using namespace boost::python;
 using namespace GafferTest;
@@ -56,6 +57,66 @@ static void testMetadataThreadingWrapper()
 	testMetadataThreading();
 }
 
+static double benchmarkProcessConstructionWrapper( int iterations )
+{
+	IECorePython::ScopedGILRelease gilRelease;
+	return benchmarkProcessConstruction( iterations );
+}
+
+static double benchmarkHashCacheHitsWrapper( int iterations )
+{
+	IECorePython::ScopedGILRelease gilRelease;
+	return benchmarkHashCacheHits( iterations );
+}
+
+static double benchmarkHashCacheMissesWrapper( int iterations )
+{
+	IECorePython::ScopedGILRelease gilRelease;
+	return benchmarkHashCacheMisses( iterations );
+}
+
+static double benchmarkComputeCacheHitsWrapper( int iterations )
+{
+	IECorePython::ScopedGILRelease gilRelease;
+	return benchmarkComputeCacheHits( iterations );
+}
+
+static double benchmarkContextCreationWrapper( int iterations )
+{
+	IECorePython::ScopedGILRelease gilRelease;
+	return benchmarkContextCreation( iterations );
+}
+
+static double benchmarkContextSetWrapper( int iterations )
+{
+	IECorePython::ScopedGILRelease gilRelease;
+	return benchmarkContextSet( iterations );
+}
+
+static double benchmarkContextHashWrapper( int iterations )
+{
+	IECorePython::ScopedGILRelease gilRelease;
+	return benchmarkContextHash( iterations );
+}
+
+static double benchmarkStringPlugSubstitutionsWrapper( int iterations )
+{
+	IECorePython::ScopedGILRelease gilRelease;
+	return benchmarkStringPlugSubstitutions( iterations );
+}
+
+static double benchmarkDirtyPropagationWrapper( int iterations )
+{
+	IECorePython::ScopedGILRelease gilRelease;
+	return benchmarkDirtyPropagation( iterations );
+}
+
+static double benchmarkChildLookupWrapper( int iterations )
+{
+	IECorePython::ScopedGILRelease gilRelease;
+	return benchmarkChildLookup( iterations );
+}
+
 BOOST_PYTHON_MODULE( _GafferTest )
 {
 
@@ -68,7 +129,19 @@ BOOST_PYTHON_MODULE( _GafferTest )
 	def( "testManySubstitutions", &testManySubstitutions );
 	def( "testManyEnvironmentSubstitutions", &testManyEnvironmentSubstitutions );
 	def( "testScopingNullContext", &testScopingNullContext );
+	def( "testEditableScope", &testEditableScope );
 	def( "testComputeNodeThreading", &testComputeNodeThreading );
 	def( "testDownstreamIterator", &testDownstreamIterator );
 
+	def( "benchmarkProcessConstruction", &benchmarkProcessConstructionWrapper, ( arg( "iterations" ) = 1000000 ) );
+	def( "benchmarkHashCacheHits", &benchmarkHashCacheHitsWrapper, ( arg( "iterations" ) = 1000000 ) );
+	def( "benchmarkHashCacheMisses", &benchmarkHashCacheMissesWrapper, ( arg( "iterations" ) = 100000 ) );
+	def( "benchmarkComputeCacheHits", &benchmarkComputeCacheHitsWrapper, ( arg( "iterations" ) = 1000000 ) );
+	def( "benchmarkContextCreation", &benchmarkContextCreationWrapper, ( arg( "iterations" ) = 1000000 ) );
+	def( "benchmarkContextSet", &benchmarkContextSetWrapper, ( arg( "iterations" ) = 1000000 ) );
+	def( "benchmarkContextHash", &benchmarkContextHashWrapper, ( arg( "iterations" ) = 1000000 ) );
+	def( "benchmarkStringPlugSubstitutions", &benchmarkStringPlugSubstitutionsWrapper, ( arg( "iterations" ) = 100000 ) );
+	def( "benchmarkDirtyPropagation", &benchmarkDirtyPropagationWrapper, ( arg( "iterations" ) = 1000 ) );
+	def( "benchmarkChildLookup", &benchmarkChildLookupWrapper, ( arg( "iterations" ) = 1000000 ) );
+
 }
@@ -62,6 +62,7 @@
 #include "GafferUI/StandardGraphLayout.h"
 #include "GafferUI/Pointer.h"
 #include "GafferUI/BackdropNodeGadget.h"
+#include "GafferUI/StandardNodeGadget.h"
 
 using namespace GafferUI;
 using namespace Imath;
@@ -75,6 +76,53 @@ using namespace std;
 namespace
 {
 
+// Size of the cells in the spatial index of child gadgets. Typical
+// nodes are around 10 units wide.
+const float g_childIndexCellSize = 20.0f;
+// Children overlapping more cells than this are not placed in
+// cells at all, and are instead tested individually. This avoids
+// a handful of long connections bloating the index.
+const int g_childIndexMaxCells = 64;
+// When a single unit in gadget space is smaller than this many pixels,
+// nodes are drawn with reduced detail - their names and nodules would
+// be unreadably small anyway.
+const float g_lowDetailPixelsPerUnit = 2.0f;
+// Roots with more nodes than this have the creation of NodeGadgets
+// for positioned nodes deferred until they become visible.
+const size_t g_deferredCreationThreshold = 200;
+// Deferred NodeGadgets are created when within this fraction of the
+// visible region's size from it, so that they are ready before they
+// scroll into view, and so that connections from offscreen nodes
+// are drawn.
+const float g_deferredCreationMargin = 0.5f;
+
+// Returns the region visible to the current GL projection, in the
+// local space of the current modelview. Because selection rendering
+// narrows the projection to the picking region, this also provides
+// culling during selection.
+Box2f visibleRegion()
+{
+	M44f modelView, projection;
+	glGetFloatv( GL_MODELVIEW_MATRIX, modelView.getValue() );
+	glGetFloatv( GL_PROJECTION_MATRIX, projection.getValue() );
+	const M44f ndcToGadget = ( modelView * projection ).inverse();
+
+	Box2f result;
+	for( int i = 0; i < 8; ++i )
+	{
+		const V3f ndc( i & 1 ? 1 : -1, i & 2 ? 1 : -1, i & 4 ? 1 : -1 );
+		V3f p;
+		ndcToGadget.multVecMatrix( ndc, p );
+		result.extendBy( V2f( p.x, p.y ) );
+	}
+	return result;
+}
+
+int childIndexCellCoordinate( float f )
+{
+	return (int)floorf( f / g_childIndexCellSize );
+}
+
 bool readOnly( const Gaffer::StandardSet *set )
 {
 	for( size_t i = 0, s = set->size(); i < s; ++i )
@@ -103,8 +151,9 @@ static const InternedString g_outputConnectionsMinimisedPlugName( "__uiOutputCon
 IE_CORE_DEFINERUNTIMETYPED( GraphGadget );
 
 GraphGadget::GraphGadget( Gaffer::NodePtr root, Gaffer::SetPtr filter )
-	:	m_dragStartPosition( 0 ), m_lastDragPosition( 0 ), m_dragMode( None ), m_dragReconnectCandidate( NULL ), m_dragReconnectSrcNodule( NULL ), m_dragReconnectDstNodule( NULL )
+	:	m_childIndexDirty( true ), m_dragStartPosition( 0 ), m_lastDragPosition( 0 ), m_dragMode( None ), m_dragReconnectCandidate( NULL ), m_dragReconnectSrcNodule( NULL ), m_dragReconnectDstNodule( NULL )
 {
+	renderRequestSignal().connect( boost::bind( &GraphGadget::renderRequested, this, ::_1 ) );
 	keyPressSignal().connect( boost::bind( &GraphGadget::keyPressed, this, ::_1,  ::_2 ) );
 	buttonPressSignal().connect( boost::bind( &GraphGadget::buttonPress, this, ::_1,  ::_2 ) );
 	buttonReleaseSignal().connect( boost::bind( &GraphGadget::buttonRelease, this, ::_1,  ::_2 ) );
@@ -229,22 +278,32 @@ void GraphGadget::setFilter( Gaffer::SetPtr filter )
 
 NodeGadget *GraphGadget::nodeGadget( const Gaffer::Node *node )
 {
-	return findNodeGadget( node );
+	return materialiseNodeGadget( node );
 }
 
 const NodeGadget *GraphGadget::nodeGadget( const Gaffer::Node *node ) const
 {
-	return findNodeGadget( node );
+	// Creating a deferred gadget doesn't change what we represent,
+	// so we allow it from const methods.
+	return const_cast<GraphGadget *>( this )->materialiseNodeGadget( node );
 }
 
 ConnectionGadget *GraphGadget::connectionGadget( const Gaffer::Plug *dstPlug )
 {
+	if( !m_deferredNodes.empty() )
+	{
+		materialiseNodeGadget( dstPlug->node() );
+		if( const Gaffer::Plug *input = dstPlug->getInput<Gaffer::Plug>() )
+		{
+			materialiseNodeGadget( input->node() );
+		}
+	}
 	return findConnectionGadget( dstPlug );
 }
 
 const ConnectionGadget *GraphGadget::connectionGadget( const Gaffer::Plug *dstPlug ) const
 {
-	return findConnectionGadget( dstPlug );
+	return const_cast<GraphGadget *>( this )->connectionGadget( dstPlug );
 }
 
 size_t GraphGadget::connectionGadgets( const Gaffer::Plug *plug, std::vector<ConnectionGadget *> &connections, const Gaffer::Set *excludedNodes )
@@ -618,26 +677,60 @@ ConnectionGadget *GraphGadget::reconnectionGadgetAt( const NodeGadget *gadget, c
 	return NULL;
 }
 
+Imath::Box3f GraphGadget::bound() const
+{
+	Box3f result = ContainerGadget::bound();
+	for( DeferredNodeMap::const_iterator it = m_deferredNodes.begin(), eIt = m_deferredNodes.end(); it != eIt; ++it )
+	{
+		result.extendBy( V3f( it->second.position.x, it->second.position.y, 0 ) );
+	}
+	return result;
+}
+
 void GraphGadget::doRender( const Style *style ) const
 {
 	glDisable( GL_DEPTH_TEST );
 
+	// find out what is visible, so we can avoid rendering
+	// everything else.
+
+	const Box2f region = visibleRegion();
+	if( !m_deferredNodes.empty() && !IECoreGL::Selector::currentSelector() )
+	{
+		// Selection renders use a narrowed region, and anything
+		// they could hit has already been created by a regular
+		// render, so we only create deferred gadgets here.
+		const_cast<GraphGadget *>( this )->materialiseNodeGadgets( region );
+	}
+
+	std::vector<size_t> visible;
+	visibleChildren( region, visible );
+
+	bool lowDetail = false;
+	if( !IECoreGL::Selector::currentSelector() )
+	{
+		GLint viewport[4];
+		glGetIntegerv( GL_VIEWPORT, viewport );
+		lowDetail = viewport[2] / region.size().x < g_lowDetailPixelsPerUnit;
+	}
+
 	// render backdrops before anything else
 	/// \todo Perhaps we need a more general layering system as part
 	/// of the Gadget system, to allow Gadgets to choose their own layering,
 	/// and perhaps to also allow one gadget to draw into multiple layers.
-	for( ChildContainer::const_iterator it=children().begin(); it!=children().end(); it++ )
+	for( std::vector<size_t>::const_iterator it = visible.begin(), eIt = visible.end(); it != eIt; ++it )
 	{
-		if( (*it)->isInstanceOf( (IECore::TypeId)BackdropNodeGadgetTypeId ) )
+		const Gadget *child = getChild<Gadget>( *it );
+		if( child->isInstanceOf( (IECore::TypeId)BackdropNodeGadgetTypeId ) )
 		{
-			static_cast<const Gadget *>( it->get() )->render( style );
+			child->render( style );
 		}
 	}
 
 	// then render connections so they go underneath the nodes
-	for( ChildContainer::const_iterator it=children().begin(); it!=children().end(); it++ )
+	for( std::vector<size_t>::const_iterator it = visible.begin(), eIt = visible.end(); it != eIt; ++it )
 	{
-		ConnectionGadget *c = IECore::runTimeCast<ConnectionGadget>( it->get() );
+		const ConnectionGadget *c = IECore::runTimeCast<const ConnectionGadget>( getChild<Gadget>( *it ) );
 		if ( c && c != m_dragReconnectCandidate )
 		{
 			c->render( style );
@@ -670,12 +763,34 @@ void GraphGadget::doRender( const Style *style ) const
 		}
 	}
 
-	// then render the rest on top
-	for( ChildContainer::const_iterator it=children().begin(); it!=children().end(); it++ )
+	// then render the rest on top, batching up all the
+	// node and plug labels to be drawn together at the end.
 	{
-		if( !((*it)->isInstanceOf( ConnectionGadget::staticTypeId() )) && !((*it)->isInstanceOf( (IECore::TypeId)BackdropNodeGadgetTypeId )) )
+		Style::TextBatchScope textBatchScope( style );
+		for( std::vector<size_t>::const_iterator it = visible.begin(), eIt = visible.end(); it != eIt; ++it )
 		{
-			static_cast<const Gadget *>( it->get() )->render( style );
+			const Gadget *child = getChild<Gadget>( *it );
+			if( child->isInstanceOf( ConnectionGadget::staticTypeId() ) || child->isInstanceOf( (IECore::TypeId)BackdropNodeGadgetTypeId ) )
+			{
+				continue;
+			}
+
+			const StandardNodeGadget *standardNodeGadget = lowDetail ? IECore::runTimeCast<const StandardNodeGadget>( child ) : NULL;
+			if( standardNodeGadget )
+			{
+				// just draw the frame, omitting the name and nodules.
+				const Box3f b = child->transformedBound( this );
+				style->renderNodeFrame(
+					Box2f( V2f( b.min.x, b.min.y ), V2f( b.max.x, b.max.y ) ),
+					0.0f,
+					standardNodeGadget->getHighlighted() ? Style::HighlightedState : Style::NormalState,
+					standardNodeGadget->userColor()
+				);
+			}
+			else
+			{
+				child->render( style );
+			}
 		}
 	}
 
@@ -693,6 +808,108 @@ void GraphGadget::doRender( const Style *style ) const
 
 }
 
+void GraphGadget::renderRequested( Gadget *gadget )
+{
+	m_childIndexDirty = true;
+}
+
+void GraphGadget::updateChildIndex() const
+{
+	if( !m_childIndexDirty )
+	{
+		return;
+	}
+
+	m_childIndexCells.clear();
+	m_childIndexUnbounded.clear();
+	m_childBounds.clear();
+
+	const ChildContainer &c = children();
+	m_childBounds.reserve( c.size() );
+	for( size_t i = 0, e = c.size(); i < e; ++i )
+	{
+		const Box3f b = static_cast<const Gadget *>( c[i].get() )->transformedBound( this );
+		m_childBounds.push_back( b.isEmpty() ? Box2f() : Box2f( V2f( b.min.x, b.min.y ), V2f( b.max.x, b.max.y ) ) );
+
+		const Box2f &b2 = m_childBounds.back();
+		if( b2.isEmpty() )
+		{
+			m_childIndexUnbounded.push_back( i );
+			continue;
+		}
+
+		const V2i minCell( childIndexCellCoordinate( b2.min.x ), childIndexCellCoordinate( b2.min.y ) );
+		const V2i maxCell( childIndexCellCoordinate( b2.max.x ), childIndexCellCoordinate( b2.max.y ) );
+		if( ( maxCell.x - minCell.x + 1 ) * ( maxCell.y - minCell.y + 1 ) > g_childIndexMaxCells )
+		{
+			m_childIndexUnbounded.push_back( i );
+			continue;
+		}
+
+		for( int y = minCell.y; y <= maxCell.y; ++y )
+		{
+			for( int x = minCell.x; x <= maxCell.x; ++x )
+			{
+				m_childIndexCells[ChildIndexCell( x, y )].push_back( i );
+			}
+		}
+	}
+
+	m_childIndexDirty = false;
+}
+
+void GraphGadget::visibleChildren( const Imath::Box2f &region, std::vector<size_t> &children ) const
+{
+	updateChildIndex();
+
+	children.insert( children.end(), m_childIndexUnbounded.begin(), m_childIndexUnbounded.end() );
+
+	const V2i minCell( childIndexCellCoordinate( region.min.x ), childIndexCellCoordinate( region.min.y ) );
+	const V2i maxCell( childIndexCellCoordinate( region.max.x ), childIndexCellCoordinate( region.max.y ) );
+	if( (size_t)( maxCell.x - minCell.x + 1 ) * (size_t)( maxCell.y - minCell.y + 1 ) > m_childIndexCells.size() )
+	{
+		// Zoomed out so far that visiting the occupied cells
+		// is cheaper than visiting the visible ones.
+		for( ChildIndexCells::const_iterator it = m_childIndexCells.begin(), eIt = m_childIndexCells.end(); it != eIt; ++it )
+		{
+			if( it->first.first >= minCell.x && it->first.first <= maxCell.x && it->first.second >= minCell.y && it->first.second <= maxCell.y )
+			{
+				children.insert( children.end(), it->second.begin(), it->second.end() );
+			}
+		}
+	}
+	else
+	{
+		for( int y = minCell.y; y <= maxCell.y; ++y )
+		{
+			for( int x = minCell.x; x <= maxCell.x; ++x )
+			{
+				ChildIndexCells::const_iterator it = m_childIndexCells.find( ChildIndexCell( x, y ) );
+				if( it != m_childIndexCells.end() )
+				{
+					children.insert( children.end(), it->second.begin(), it->second.end() );
+				}
+			}
+		}
+	}
+
+	// Remove duplicates from children spanning several cells, and
+	// anything that overlaps the cells without overlapping the region.
+	std::sort( children.begin(), children.end() );
+	children.erase( std::unique( children.begin(), children.end() ), children.end() );
+
+	std::vector<size_t>::iterator out = children.begin();
+	for( std::vector<size_t>::const_iterator it = children.begin(), eIt = children.end(); it != eIt; ++it )
+	{
+		const Box2f &b = m_childBounds[*it];
+		if( b.isEmpty() || b.intersects( region ) )
+		{
+			*out++ = *it;
+		}
+	}
+	children.erase( out, children.end() );
+}
+
 bool GraphGadget::keyPressed( GadgetPtr gadget, const KeyEvent &event )
 {
 	if( event.key == "D" )
@@ -724,7 +941,7 @@ void GraphGadget::rootChildAdded( Gaffer::GraphComponent *root, Gaffer::GraphCom
 	Gaffer::Node *node = IECore::runTimeCast<Gaffer::Node>( child );
 	if( node && ( !m_filter || m_filter->contains( node ) ) )
 	{
-		if( !findNodeGadget( node ) )
+		if( !findNodeGadget( node ) && !isDeferred( node ) )
 		{
 			if( NodeGadget *g = addNodeGadget( node ) )
 			{
@@ -770,7 +987,7 @@ void GraphGadget::filterMemberAdded( Gaffer::Set *set, IECore::RunTimeTyped *mem
 	Gaffer::Node *node = IECore::runTimeCast<Gaffer::Node>( member );
 	if( node && node->parent<Gaffer::Node>() == m_root )
 	{
-		if( !findNodeGadget( node ) )
+		if( !findNodeGadget( node ) && !isDeferred( node ) )
 		{
 			if( NodeGadget * g = addNodeGadget( node ) )
 			{
@@ -818,6 +1035,19 @@ void GraphGadget::inputChanged( Gaffer::Plug *dstPlug )
 void GraphGadget::plugSet( Gaffer::Plug *plug )
 {
 	const InternedString &name = plug->getName();
+
+	DeferredNodeMap::iterator deferredIt = m_deferredNodes.find( plug->node() );
+	if( deferredIt != m_deferredNodes.end() )
+	{
+		if( name==g_positionPlugName )
+		{
+			deferredIt->second.position = getNodePosition( plug->node() );
+		}
+		// Anything else will be taken into account when the
+		// gadget is created.
+		return;
+	}
+
 	if( name==g_positionPlugName )
 	{
 		Gaffer::Node *node = plug->node();
@@ -1401,14 +1631,40 @@ void GraphGadget::updateGraph()
 		}
 	}
 
-	// now make sure we have gadgets for all the nodes we're meant to display
+	for( DeferredNodeMap::iterator it = m_deferredNodes.begin(); it != m_deferredNodes.end(); )
+	{
+		const Gaffer::Node *node = it->first;
+		it++; // increment now as the iterator will be invalidated by removeNodeGadget()
+		if( (m_filter && !m_filter->contains( node )) || node->parent<Gaffer::Node>() != m_root )
+		{
+			removeNodeGadget( node );
+		}
+	}
+
+	// now make sure we have gadgets for all the nodes we're meant to display,
+	// deferring the creation of positioned ones if there are a lot of them.
+
+	size_t numNodes = 0;
+	for( Gaffer::NodeIterator it( m_root.get() ); !it.done(); ++it )
+	{
+		numNodes++;
+	}
+	const bool defer = numNodes > g_deferredCreationThreshold;
+
 	for( Gaffer::NodeIterator it( m_root.get() ); !it.done(); ++it )
 	{
 		if( !m_filter || m_filter->contains( it->get() ) )
 		{
-			if( !findNodeGadget( it->get() ) )
+			if( !findNodeGadget( it->get() ) && !isDeferred( it->get() ) )
 			{
-				addNodeGadget( it->get() );
+				if( defer && hasNodePosition( it->get() ) )
+				{
+					deferNodeGadget( it->get() );
+				}
+				else
+				{
+					addNodeGadget( it->get() );
+				}
 			}
 		}
 	}
@@ -1452,6 +1708,8 @@ NodeGadget *GraphGadget::addNodeGadget( Gaffer::Node *node )
 
 void GraphGadget::removeNodeGadget( const Gaffer::Node *node )
 {
+	m_deferredNodes.erase( node );
+
 	NodeGadgetMap::iterator it = m_nodeGadgets.find( node );
 	if( it!=m_nodeGadgets.end() )
 	{
@@ -1471,6 +1729,60 @@ NodeGadget *GraphGadget::findNodeGadget( const Gaffer::Node *node ) const
 	return it->second.gadget;
 }
 
+void GraphGadget::deferNodeGadget( Gaffer::Node *node )
+{
+	DeferredNodeEntry &entry = m_deferredNodes[node];
+	entry.node = node;
+	entry.position = getNodePosition( node );
+	entry.plugSetConnection = node->plugSetSignal().connect( boost::bind( &GraphGadget::plugSet, this, ::_1 ) );
+}
+
+bool GraphGadget::isDeferred( const Gaffer::Node *node ) const
+{
+	return m_deferredNodes.find( node ) != m_deferredNodes.end();
+}
+
+NodeGadget *GraphGadget::materialiseNodeGadget( const Gaffer::Node *node )
+{
+	DeferredNodeMap::iterator it = m_deferredNodes.find( node );
+	if( it == m_deferredNodes.end() )
+	{
+		return findNodeGadget( node );
+	}
+
+	Gaffer::Node *n = it->second.node;
+	m_deferredNodes.erase( it );
+
+	NodeGadget *g = addNodeGadget( n );
+	if( g )
+	{
+		addConnectionGadgets( g );
+	}
+	return g;
+}
+
+void GraphGadget::materialiseNodeGadgets( const Imath::Box2f &region )
+{
+	Box2f expandedRegion = region;
+	const V2f margin = region.size() * g_deferredCreationMargin;
+	expandedRegion.min -= margin;
+	expandedRegion.max += margin;
+
+	std::vector<const Gaffer::Node *> toMaterialise;
+	for( DeferredNodeMap::const_iterator it = m_deferredNodes.begin(), eIt = m_deferredNodes.end(); it != eIt; ++it )
+	{
+		if( expandedRegion.intersects( it->second.position ) )
+		{
+			toMaterialise.push_back( it->first );
+		}
+	}
+
+	for( std::vector<const Gaffer::Node *>::const_iterator it = toMaterialise.begin(), eIt = toMaterialise.end(); it != eIt; ++it )
+	{
+		materialiseNodeGadget( *it );
+	}
+}
+
 void GraphGadget::updateNodeGadgetTransform( NodeGadget *nodeGadget )
 {
 	Gaffer::Node *node = nodeGadget->node();
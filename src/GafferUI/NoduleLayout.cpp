@@ -35,6 +35,8 @@
 //
 //////////////////////////////////////////////////////////////////////////
 
+#include <limits>
+
 #include "boost/bind.hpp"
 #include "boost/algorithm/string/predicate.hpp"
 
@@ -323,6 +325,12 @@ bool visible( const Plug *plug, IECore::InternedString section )
 	return true;
 }
 
+IECore::InternedString noduleType( const Plug *plug )
+{
+	IECore::ConstStringDataPtr typeData = Metadata::value<IECore::StringData>( plug, g_noduleTypeKey );
+	return typeData ? typeData->readable() : "GafferUI::StandardNodule";
+}
+
 } // namespace
 
 //////////////////////////////////////////////////////////////////////////
@@ -332,7 +340,7 @@ bool visible( const Plug *plug, IECore::InternedString section )
 IE_CORE_DEFINERUNTIMETYPED( NoduleLayout );
 
 NoduleLayout::NoduleLayout( Gaffer::GraphComponentPtr parent, IECore::InternedString section )
-	:	Gadget(), m_parent( parent ), m_section( section )
+	:	Gadget(), m_parent( parent ), m_section( section ), m_maxIndex( std::numeric_limits<int>::min() )
 {
 	LinearContainerPtr noduleContainer = new LinearContainer(
 		"__noduleContainer",
@@ -403,9 +411,12 @@ const LinearContainer *NoduleLayout::noduleContainer() const
 
 void NoduleLayout::childAdded( Gaffer::GraphComponent *child )
 {
-	if( IECore::runTimeCast<Gaffer::Plug>( child ) )
+	if( Plug *plug = IECore::runTimeCast<Gaffer::Plug>( child ) )
 	{
-		updateNoduleLayout();
+		if( !appendNodule( plug ) )
+		{
+			updateNoduleLayout();
+		}
 	}
 }
 
@@ -491,9 +502,7 @@ void NoduleLayout::updateNodules( std::vector<Nodule *> &nodules, std::vector<No
 
 		if( ::visible( plug, m_section ) )
 		{
-			IECore::InternedString type;
-			IECore::ConstStringDataPtr typeData = Metadata::value<IECore::StringData>( plug, g_noduleTypeKey );
-			type = typeData ? typeData->readable() : "GafferUI::StandardNodule";
+			const IECore::InternedString type = noduleType( plug );
 
 			if( it != m_nodules.end() && it->second.type == type )
 			{
@@ -551,6 +560,7 @@ void NoduleLayout::updateNodules( std::vector<Nodule *> &nodules, std::vector<No
 
 	// Sort ready for layout.
 	sort( sortedNodules.begin(), sortedNodules.end() );
+	m_maxIndex = sortedNodules.size() ? sortedNodules.back().index : std::numeric_limits<int>::min();
 	for( vector<IndexAndNodule>::const_iterator it = sortedNodules.begin(), eIt = sortedNodules.end(); it != eIt; ++it )
 	{
 		nodules.push_back( it->nodule );
@@ -592,6 +602,45 @@ void NoduleLayout::updateNoduleLayout()
 	}
 }
 
+bool NoduleLayout::appendNodule( Gaffer::Plug *plug )
+{
+	if( plug != m_parent->children().back() )
+	{
+		return false;
+	}
+
+	if( boost::starts_with( plug->getName().string(), "__" ) || !::visible( plug, m_section ) )
+	{
+		// Wouldn't get a nodule from a full update either.
+		return true;
+	}
+
+	LinearContainer *c = noduleContainer();
+	const int plugIndex = index( plug, c->children().size() );
+	if( plugIndex < m_maxIndex )
+	{
+		// Would be sorted before an existing nodule.
+		return false;
+	}
+
+	NodulePtr nodule = Nodule::create( plug );
+	m_nodules[plug] = TypeAndNodule( noduleType( plug ), nodule );
+	if( !nodule )
+	{
+		return true;
+	}
+
+	c->addChild( nodule );
+	m_maxIndex = plugIndex;
+
+	if( NodeGadget *nodeGadget = ancestor<NodeGadget>() )
+	{
+		nodeGadget->noduleAddedSignal()( nodeGadget, nodule.get() );
+	}
+
+	return true;
+}
+
 void NoduleLayout::updateSpacing()
 {
 	noduleContainer()->setSpacing( spacing( m_parent.get(), m_section ) );
@@ -36,6 +36,7 @@
 //////////////////////////////////////////////////////////////////////////
 
 #include <cassert>
+#include <algorithm>
 
 #include "boost/graph/adjacency_list.hpp"
 
@@ -130,12 +131,6 @@ class Constraint
 			LessThanOrEqualTo
 		};
 
-		/// \todo Remove - it's only here so we can call m_constraints.resize()
-		/// to remove the collision constraints.
-		Constraint()
-		{
-		}
-
 		// Enforces p - q ( ==, >=, <= ) d in direction v
 		Constraint( V2f *p, V2f *q, Type type, float d, const V2f &v, float w = 0.5 )
 			:	m_p( p ), m_q( q ), m_type( type ), m_d( d ), m_v( v ), m_w( w )
@@ -184,7 +179,10 @@ class LayoutEngine
 				m_nodeSeparation( 2.0f * nodeSeparationScale ),
 				m_springStiffness( 0.1 ),
 				m_maxIterations( 10000 ),
-				m_constraintsIterations( 10 )
+				m_constraintsIterations( 10 ),
+				m_collisionMargin( m_nodeSeparation ),
+				m_orderingSweeps( 8 ),
+				m_collisionConstraintsValid( false )
 		{
 
 			// Convert the visible graph into our internal boost::graph format.
@@ -484,11 +482,187 @@ class LayoutEngine
 			m_constraints.clear();
 		}
 
+		/// Replaces the positions of all unpinned nodes with a layered
+		/// placement, in which nodes are arranged in rows according to
+		/// their vertical connections, and each row is ordered to reduce
+		/// crossings. This is much cheaper than untangling the graph with
+		/// solve(), and gives solve() a starting point close to its final
+		/// result, which is what makes layout of large graphs practical.
+		void layerNodes()
+		{
+			// Gather the unpinned vertices - these are
+			// the only ones we will move.
+
+			vector<LayerVertex> layerVertices;
+			std::map<VertexDescriptor, size_t> indices;
+			V2f centroid( 0 );
+
+			VertexIteratorRange v = vertices( m_graph );
+			for( VertexIterator it = v.first; it != v.second; ++it )
+			{
+				const Vertex &vt = m_graph[*it];
+				if( vt.pinned )
+				{
+					continue;
+				}
+				indices[*it] = layerVertices.size();
+				layerVertices.push_back( LayerVertex( *it ) );
+				centroid += vt.position;
+			}
+
+			if( layerVertices.empty() )
+			{
+				return;
+			}
+
+			centroid /= layerVertices.size();
+
+			// Find the downward connections between them. These define
+			// the layers - all other connections are left for solve()
+			// to deal with.
+
+			const Direction down( 0, -1 );
+			EdgeIteratorRange e = edges( m_graph );
+			for( EdgeIterator it = e.first; it != e.second; ++it )
+			{
+				if( m_graph[*it].idealDirection != down )
+				{
+					continue;
+				}
+
+				std::map<VertexDescriptor, size_t>::const_iterator s = indices.find( source( *it, m_graph ) );
+				std::map<VertexDescriptor, size_t>::const_iterator t = indices.find( target( *it, m_graph ) );
+				if( s == indices.end() || t == indices.end() || s == t )
+				{
+					continue;
+				}
+
+				layerVertices[s->second].successors.push_back( t->second );
+				layerVertices[t->second].predecessors.push_back( s->second );
+			}
+
+			// Assign each vertex to a layer one below its lowest
+			// predecessor. Vertices on cycles never become ready,
+			// and are left in the top layer.
+
+			vector<size_t> numPendingPredecessors( layerVertices.size() );
+			vector<size_t> ready;
+			for( size_t i = 0; i < layerVertices.size(); ++i )
+			{
+				numPendingPredecessors[i] = layerVertices[i].predecessors.size();
+				if( !numPendingPredecessors[i] )
+				{
+					ready.push_back( i );
+				}
+			}
+
+			int numLayers = 1;
+			while( !ready.empty() )
+			{
+				const LayerVertex &lv = layerVertices[ready.back()];
+				ready.pop_back();
+				numLayers = max( numLayers, lv.layer + 1 );
+				for( vector<size_t>::const_iterator it = lv.successors.begin(), eIt = lv.successors.end(); it != eIt; ++it )
+				{
+					LayerVertex &successor = layerVertices[*it];
+					successor.layer = max( successor.layer, lv.layer + 1 );
+					if( --numPendingPredecessors[*it] == 0 )
+					{
+						ready.push_back( *it );
+					}
+				}
+			}
+
+			// Group the vertices into layers, using their current
+			// horizontal positions as the initial ordering.
+
+			vector<vector<size_t> > layers( numLayers );
+			for( size_t i = 0; i < layerVertices.size(); ++i )
+			{
+				layers[layerVertices[i].layer].push_back( i );
+				layerVertices[i].sortKey = m_graph[layerVertices[i].descriptor].position.x;
+			}
+
+			for( vector<vector<size_t> >::iterator it = layers.begin(), eIt = layers.end(); it != eIt; ++it )
+			{
+				sortLayer( *it, layerVertices );
+			}
+
+			// Reorder each layer by the barycentre of its neighbours in
+			// the layers already visited, sweeping alternately down and
+			// up the graph. Each sweep costs one visit per edge plus a
+			// sort per layer, rather than the all-pairs comparisons made
+			// by exact crossing minimisation.
+
+			for( int sweep = 0; sweep < m_orderingSweeps; ++sweep )
+			{
+				const bool downwards = sweep % 2 == 0;
+				for( int l = 1; l < numLayers; ++l )
+				{
+					vector<size_t> &layer = layers[downwards ? l : numLayers - 1 - l];
+					for( vector<size_t>::const_iterator it = layer.begin(), eIt = layer.end(); it != eIt; ++it )
+					{
+						LayerVertex &lv = layerVertices[*it];
+						const vector<size_t> &neighbours = downwards ? lv.predecessors : lv.successors;
+						if( neighbours.empty() )
+						{
+							// Keep current position.
+							lv.sortKey = lv.order;
+							continue;
+						}
+						float sum = 0.0f;
+						for( vector<size_t>::const_iterator nIt = neighbours.begin(), nEIt = neighbours.end(); nIt != nEIt; ++nIt )
+						{
+							sum += layerVertices[*nIt].order;
+						}
+						lv.sortKey = sum / neighbours.size();
+					}
+					sortLayer( layer, layerVertices );
+				}
+			}
+
+			// Stack the layers one below another, spacing out the nodes in
+			// each, and then recentre the result on the original centroid
+			// so that the nodes stay roughly where they were.
+
+			V2f newCentroid( 0 );
+			float y = 0.0f;
+			for( vector<vector<size_t> >::const_iterator it = layers.begin(), eIt = layers.end(); it != eIt; ++it )
+			{
+				float width = 0.0f;
+				float height = 0.0f;
+				for( vector<size_t>::const_iterator vIt = it->begin(), vEIt = it->end(); vIt != vEIt; ++vIt )
+				{
+					const Box2f &bound = m_graph[layerVertices[*vIt].descriptor].bound;
+					width += bound.size().x + m_nodeSeparation;
+					height = max( height, bound.size().y );
+				}
+
+				float x = -0.5f * width;
+				for( vector<size_t>::const_iterator vIt = it->begin(), vEIt = it->end(); vIt != vEIt; ++vIt )
+				{
+					Vertex &vt = m_graph[layerVertices[*vIt].descriptor];
+					vt.position = V2f( x - vt.bound.min.x, y - vt.bound.max.y );
+					newCentroid += vt.position;
+					x += vt.bound.size().x + m_nodeSeparation;
+				}
+
+				y -= height + m_edgeLength;
+			}
+
+			newCentroid /= layerVertices.size();
+			for( vector<LayerVertex>::const_iterator it = layerVertices.begin(), eIt = layerVertices.end(); it != eIt; ++it )
+			{
+				m_graph[it->descriptor].position += centroid - newCentroid;
+			}
+		}
+
 		void solve( bool withCollisions )
 		{
 			VertexIteratorRange v = vertices( m_graph );
 
-			size_t numConstraints = m_constraints.size();
+			m_collisionConstraints.clear();
+			m_collisionConstraintsValid = false;
 			for( int i = 0; i < m_maxIterations; ++i )
 			{
 				for( VertexIterator it = v.first; it != v.second; ++it )
@@ -498,13 +672,12 @@ class LayoutEngine
 				}
 
 				applySprings();
-				applyConstraints( m_constraintsIterations );
+				applyConstraints( m_constraintsIterations, false );
 
 				if( withCollisions )
 				{
-					addCollisionConstraints();
-					applyConstraints( m_constraintsIterations );
-					m_constraints.resize( numConstraints );
+					updateCollisionConstraints();
+					applyConstraints( m_constraintsIterations, true );
 				}
 
 				float maxMovement = 0;
@@ -581,6 +754,7 @@ class LayoutEngine
 
 			// State variables for use in solve().
 			V2f previousPosition;
+			V2f collisionPosition;
 			V2f force;
 		};
 
@@ -615,6 +789,50 @@ class LayoutEngine
 
 		typedef std::map<const Node *, VertexDescriptor> NodesToVertices;
 
+		// Working state for layerNodes().
+		struct LayerVertex
+		{
+			LayerVertex( VertexDescriptor d )
+				:	descriptor( d ), layer( 0 ), order( 0.0f ), sortKey( 0.0f )
+			{
+			}
+
+			VertexDescriptor descriptor;
+			int layer;
+			// Index within layer.
+			float order;
+			float sortKey;
+			vector<size_t> predecessors;
+			vector<size_t> successors;
+		};
+
+		struct LayerVertexLess
+		{
+			LayerVertexLess( const vector<LayerVertex> *layerVertices )
+				:	m_layerVertices( layerVertices )
+			{
+			}
+
+			bool operator () ( size_t v1, size_t v2 ) const
+			{
+				return (*m_layerVertices)[v1].sortKey < (*m_layerVertices)[v2].sortKey;
+			}
+
+			private :
+
+				const vector<LayerVertex> *m_layerVertices;
+
+		};
+
+		void sortLayer( vector<size_t> &layer, vector<LayerVertex> &layerVertices )
+		{
+			stable_sort( layer.begin(), layer.end(), LayerVertexLess( &layerVertices ) );
+			for( size_t i = 0; i < layer.size(); ++i )
+			{
+				layerVertices[layer[i]].order = i;
+			}
+		}
+
 		void addSiblingConstraints( VertexDescriptor vertex, const Direction &edgeDirection )
 		{
 			// find all the edges pointing in the specified direction.
@@ -689,6 +907,54 @@ class LayoutEngine
 			);
 		}
 
+		// Collision constraints are found for all nodes within
+		// m_collisionMargin of each other, and are then reused until
+		// some node has moved by more than half that margin. Because
+		// the constraints are inequalities, those between nodes which
+		// aren't yet touching have no effect, but are ready in case
+		// the nodes move into contact. This gives the same result as
+		// finding the collisions on every iteration, without the cost
+		// of rebuilding the tree each time.
+		void updateCollisionConstraints()
+		{
+			if( m_collisionConstraintsValid )
+			{
+				const float threshold = m_collisionMargin / 2.0f;
+				VertexIteratorRange v = vertices( m_graph );
+				for( VertexIterator it = v.first; it != v.second; ++it )
+				{
+					const Vertex &vt = m_graph[*it];
+					if(
+						fabs( vt.position.x - vt.collisionPosition.x ) > threshold ||
+						fabs( vt.position.y - vt.collisionPosition.y ) > threshold
+					)
+					{
+						m_collisionConstraintsValid = false;
+						break;
+					}
+				}
+			}
+
+			if( m_collisionConstraintsValid )
+			{
+				return;
+			}
+
+			const size_t numConstraints = m_constraints.size();
+			addCollisionConstraints();
+			m_collisionConstraints.assign( m_constraints.begin() + numConstraints, m_constraints.end() );
+			m_constraints.erase( m_constraints.begin() + numConstraints, m_constraints.end() );
+
+			VertexIteratorRange v = vertices( m_graph );
+			for( VertexIterator it = v.first; it != v.second; ++it )
+			{
+				Vertex &vt = m_graph[*it];
+				vt.collisionPosition = vt.position;
+			}
+
+			m_collisionConstraintsValid = true;
+		}
+
 		void addCollisionConstraints()
 		{
 			// build a tree for making fast bound intersection queries
@@ -710,14 +976,19 @@ class LayoutEngine
 
 			Box2fTree tree( bounds.begin(), bounds.end() );
 
-			// find colliding bounds, and add constraints to separate them
+			// find colliding bounds, and add constraints to separate them.
+			// we include bounds which are within m_collisionMargin of
+			// colliding, so that updateCollisionConstraints() can reuse
+			// the constraints over several iterations.
+
+			const V2f margin( m_collisionMargin );
 
 			typedef vector<Box2f>::const_iterator BoundIterator;
 			vector<BoundIterator> intersectingBounds;
 			for( BoundIterator it = bounds.begin(), eIt = bounds.end(); it != eIt; ++it )
 			{
 				intersectingBounds.clear();
-				tree.intersectingBounds( *it, intersectingBounds );
+				tree.intersectingBounds( Box2f( it->min - margin, it->max + margin ), intersectingBounds );
 				for( vector<BoundIterator>::const_iterator bIt = intersectingBounds.begin(); bIt != intersectingBounds.end(); ++bIt )
 				{
 					size_t bound1Index = it - bounds.begin();
@@ -801,7 +1072,7 @@ class LayoutEngine
 			return foundHorizontalConnection ? 1 : 0;
 		}
 
-		void applyConstraints( size_t iterations )
+		void applyConstraints( size_t iterations, bool withCollisions )
 		{
 			for( size_t i = 0; i < iterations; ++i )
 			{
@@ -809,6 +1080,13 @@ class LayoutEngine
 				{
 					it->apply();
 				}
+				if( withCollisions )
+				{
+					for( std::vector<Constraint>::const_iterator it = m_collisionConstraints.begin(), eIt = m_collisionConstraints.end(); it != eIt; ++it )
+					{
+						it->apply();
+					}
+				}
 			}
 		}
 
@@ -896,12 +1174,17 @@ class LayoutEngine
 		NodesToVertices m_nodesToVertices;
 
 		std::vector<Constraint> m_constraints;
+		std::vector<Constraint> m_collisionConstraints;
 
 		const float m_edgeLength;
 		const float m_nodeSeparation;
 		const float m_springStiffness;
 		const int m_maxIterations;
 		const int m_constraintsIterations;
+		const float m_collisionMargin;
+		const int m_orderingSweeps;
+
+		bool m_collisionConstraintsValid;
 
 };
 
@@ -914,7 +1197,7 @@ class LayoutEngine
 IE_CORE_DEFINERUNTIMETYPED( StandardGraphLayout )
 
 StandardGraphLayout::StandardGraphLayout()
-	:	m_connectionScale( 1.0f ), m_nodeSeparationScale( 1.0f )
+	:	m_connectionScale( 1.0f ), m_nodeSeparationScale( 1.0f ), m_layeredLayout( false )
 {
 }
 
@@ -1006,6 +1289,11 @@ void StandardGraphLayout::layoutNodes( GraphGadget *graph, Gaffer::Set *nodes )
 		layout.pinNodes( nodes, true /* invert */ );
 	}
 
+	if( m_layeredLayout )
+	{
+		layout.layerNodes();
+	}
+
 	// do a first round of layout without worrying about
 	// collisions between nodes.
 
@@ -1223,3 +1511,13 @@ float StandardGraphLayout::getNodeSeparationScale() const
 {
 	return m_nodeSeparationScale;
 }
+
+void StandardGraphLayout::setLayeredLayout( bool layered )
+{
+	m_layeredLayout = layered;
+}
+
+bool StandardGraphLayout::getLayeredLayout() const
+{
+	return m_layeredLayout;
+}
@@ -62,6 +62,7 @@ using namespace std;
 IE_CORE_DEFINERUNTIMETYPED( StandardStyle );
 
 StandardStyle::StandardStyle()
+	:	m_textBatchDepth( 0 )
 {
 	setFont( LabelText, FontLoader::defaultFontLoader()->load( "VeraBd.ttf" ) );
 	setFontScale( LabelText, 1.0f );
@@ -126,6 +127,80 @@ Imath::Box3f StandardStyle::textBound( TextType textType, const std::string &tex
 }
 
 void StandardStyle::renderText( TextType textType, const std::string &text, State state ) const
+{
+	// We can't defer text during selection, because the
+	// Selector needs it drawn while the current name is loaded.
+	if( m_textBatchDepth && !IECoreGL::Selector::currentSelector() )
+	{
+		m_textBatches[textType].push_back( BatchedText() );
+		BatchedText &batchedText = m_textBatches[textType].back();
+		batchedText.text = text;
+		glGetFloatv( GL_PROJECTION_MATRIX, batchedText.projection.getValue() );
+		glGetFloatv( GL_MODELVIEW_MATRIX, batchedText.transform.getValue() );
+		return;
+	}
+
+	bindText( textType );
+	renderTextSprites( textType, text );
+}
+
+void StandardStyle::beginTextBatch() const
+{
+	m_textBatchDepth++;
+}
+
+void StandardStyle::endTextBatch() const
+{
+	if( !m_textBatchDepth || --m_textBatchDepth )
+	{
+		return;
+	}
+
+	// Text may have been drawn in raster space for HUDs,
+	// so we must restore the projection as well as the
+	// transform.
+
+	glMatrixMode( GL_PROJECTION );
+	glPushMatrix();
+	glMatrixMode( GL_MODELVIEW );
+	glPushMatrix();
+
+		const M44f *projection = NULL;
+		for( int textType = 0; textType < LastText; ++textType )
+		{
+			std::vector<BatchedText> &batch = m_textBatches[textType];
+			if( batch.empty() )
+			{
+				continue;
+			}
+
+			bindText( (TextType)textType );
+			for( std::vector<BatchedText>::const_iterator it = batch.begin(), eIt = batch.end(); it != eIt; ++it )
+			{
+				if( !projection || *projection != it->projection )
+				{
+					glMatrixMode( GL_PROJECTION );
+					glLoadMatrixf( it->projection.getValue() );
+					glMatrixMode( GL_MODELVIEW );
+					projection = &(it->projection);
+				}
+				glLoadMatrixf( it->transform.getValue() );
+				renderTextSprites( (TextType)textType, it->text );
+			}
+		}
+
+	glMatrixMode( GL_PROJECTION );
+	glPopMatrix();
+	glMatrixMode( GL_MODELVIEW );
+	glPopMatrix();
+
+	for( int textType = 0; textType < LastText; ++textType )
+	{
+		m_textBatches[textType].clear();
+	}
+}
+
+void StandardStyle::bindText( TextType textType ) const
 {
 	glEnable( GL_TEXTURE_2D );
 	glActiveTexture( GL_TEXTURE0 );
@@ -145,7 +220,10 @@ void StandardStyle::renderText( TextType textType, const std::string &text, Stat
 	glUniform1i( g_textureTypeParameter, 2 );
 
 	glColor( m_colors[ForegroundColor] );
+}
 
+void StandardStyle::renderTextSprites( TextType textType, const std::string &text ) const
+{
 	glPushMatrix();
 
 		glScalef( m_fontScales[textType], m_fontScales[textType], m_fontScales[textType] );
@@ -55,6 +55,25 @@ Style::~Style()
 {
 }
 
+void Style::beginTextBatch() const
+{
+}
+
+void Style::endTextBatch() const
+{
+}
+
+Style::TextBatchScope::TextBatchScope( const Style *style )
+	:	m_style( style )
+{
+	m_style->beginTextBatch();
+}
+
+Style::TextBatchScope::~TextBatchScope()
+{
+	m_style->endTextBatch();
+}
+
 Style::UnarySignal &Style::changedSignal()
 {
 	return m_changedSignal;
@@ -38,8 +38,14 @@
 #include "boost/python/suite/indexing/container_utils.hpp"
 
 #include "boost/date_time/posix_time/conversion.hpp"
+#include "boost/shared_ptr.hpp"
+
+#include "tbb/task.h"
+#include "tbb/mutex.h"
 
 #include "QtCore/QAbstractItemModel"
+#include "QtCore/QCoreApplication"
+#include "QtCore/QEvent"
 #include "QtCore/QAbstractItemModel"
 #include "QtCore/QModelIndex"
 #include "QtCore/QVariant"
@@ -70,6 +76,7 @@ namespace
 {
 
 IECore::InternedString g_namePropertyName( "name" );
+const QEvent::Type g_childItemsEventType = (QEvent::Type)QEvent::registerEventType();
 
 // Abstract class for extracting QVariants from Path objects
 // in order to populate columns in the PathMode. Column
@@ -348,6 +355,8 @@ class PathModel : public QAbstractItemModel
 		PathModel( QObject *parent = NULL )
 			:	QAbstractItemModel( parent ),
 				m_rootItem( new Item( NULL, 0, NULL ) ),
+				m_generation( 0 ),
+				m_dispatcher( new Dispatcher( this ) ),
 				m_flat( true ),
 				m_sortColumn( -1 ),
 				m_sortOrder( Qt::AscendingOrder )
@@ -356,6 +365,11 @@ class PathModel : public QAbstractItemModel
 
 		~PathModel()
 		{
+			{
+				// Stop any outstanding tasks from posting to us.
+				tbb::mutex::scoped_lock lock( m_dispatcher->mutex );
+				m_dispatcher->model = NULL;
+			}
 			delete m_rootItem;
 		}
 
@@ -384,6 +398,9 @@ class PathModel : public QAbstractItemModel
 			beginResetModel();
 			delete m_rootItem;
 			m_rootItem = new Item( root, 0, NULL );
+			// Invalidates the results of any tasks
+			// computing children for the old items.
+			m_generation++;
 			endResetModel();
 		}
 
@@ -437,7 +454,7 @@ class PathModel : public QAbstractItemModel
 			for( size_t i = rootPath->names().size(); i < path->names().size(); ++i )
 			{
 				bool foundNextItem = false;
-				const std::vector<Item *> &childItems = item->childItems( this );
+				const std::vector<Item *> &childItems = item->childItems( this, /* wait = */ true );
 				for( std::vector<Item *>::const_iterator it = childItems.begin(), eIt = childItems.end(); it != eIt; ++it )
 				{
 					if( (*it)->path()->names()[i] == path->names()[i] )
@@ -457,6 +474,16 @@ class PathModel : public QAbstractItemModel
 			return result;
 		}
 
+		/// Children are usually computed in the background, so
+		/// rowCount() returns 0 until they are ready. This computes
+		/// them immediately instead, for use when the caller needs
+		/// the rows right now.
+		void waitForChildren( const QModelIndex &parentIndex )
+		{
+			Item *item = parentIndex.isValid() ? static_cast<Item *>( parentIndex.internalPointer() ) : m_rootItem;
+			item->childItems( this, /* wait = */ true );
+		}
+
 		///////////////////////////////////////////////////////////////////
 		// QAbstractItemModel implementation - this is what Qt cares about
 		///////////////////////////////////////////////////////////////////
@@ -545,15 +572,121 @@ class PathModel : public QAbstractItemModel
 			layoutChanged();
 		}
 
+		virtual bool event( QEvent *event )
+		{
+			if( event->type() != g_childItemsEventType )
+			{
+				return QAbstractItemModel::event( event );
+			}
+
+			ChildItemsEvent *childItemsEvent = static_cast<ChildItemsEvent *>( event );
+			if( childItemsEvent->generation == m_generation )
+			{
+				childItemsEvent->item->setChildItems( this, childItemsEvent->children );
+			}
+			return true;
+		}
+
 	private :
 
+		struct Item;
+
+		// Computing children can be very expensive, for instance for a
+		// ScenePath with many children, or a FileSystemPath for a big
+		// directory. We therefore compute them in a background task, and
+		// post the results back to the UI thread in a ChildItemsEvent.
+		// The Dispatcher is shared between the model and its tasks, so
+		// the tasks don't post events to a model that has been destroyed.
+		struct Dispatcher
+		{
+
+			Dispatcher( PathModel *model )
+				:	model( model )
+			{
+			}
+
+			tbb::mutex mutex;
+			PathModel *model;
+
+		};
+
+		typedef boost::shared_ptr<Dispatcher> DispatcherPtr;
+
+		struct ChildItemsEvent : public QEvent
+		{
+
+			ChildItemsEvent( Item *item, unsigned generation, std::vector<Gaffer::PathPtr> &children )
+				:	QEvent( g_childItemsEventType ), item( item ), generation( generation )
+			{
+				this->children.swap( children );
+			}
+
+			Item *item;
+			unsigned generation;
+			std::vector<Gaffer::PathPtr> children;
+
+		};
+
+		class ChildItemsTask : public tbb::task
+		{
+
+			public :
+
+				ChildItemsTask( DispatcherPtr dispatcher, Item *item, unsigned generation, Gaffer::PathPtr path )
+					:	m_dispatcher( dispatcher ), m_item( item ), m_generation( generation ), m_path( path )
+				{
+				}
+
+				virtual task *execute()
+				{
+					std::vector<Gaffer::PathPtr> children;
+					PathModel::computeChildren( m_path.get(), children );
+
+					tbb::mutex::scoped_lock lock( m_dispatcher->mutex );
+					if( m_dispatcher->model )
+					{
+						QCoreApplication::postEvent( m_dispatcher->model, new ChildItemsEvent( m_item, m_generation, children ) );
+					}
+					return NULL;
+				}
+
+			private :
+
+				DispatcherPtr m_dispatcher;
+				// Only dereferenced by the model, and only if
+				// m_generation shows it is still valid.
+				Item *m_item;
+				unsigned m_generation;
+				Gaffer::PathPtr m_path;
+
+		};
+
+		static void computeChildren( const Gaffer::Path *path, std::vector<Gaffer::PathPtr> &children )
+		{
+			try
+			{
+				path->children( children );
+			}
+			catch( const std::exception &e )
+			{
+				IECore::msg( IECore::Msg::Error, "PathListingWidget", e.what() );
+			}
+		}
+
+		void requestChildItems( Item *item ) const
+		{
+			// We use enqueue() rather than spawn() so that the task runs without
+			// anyone waiting for it, and doesn't hold up the UI thread.
+			tbb::task::enqueue( *new( tbb::task::allocate_root() ) ChildItemsTask( m_dispatcher, item, m_generation, item->path() ) );
+		}
+
 		// A single item in the PathModel - stores a path and caches
 		// data extracted from it to provide the model content.
 		struct Item
 		{
 
 			Item( Gaffer::PathPtr path, int row, Item *parent )
-				:	m_path( path ), m_parent( parent ), m_row( row ), m_dataDone( false ), m_childItemsDone( false )
+				:	m_path( path ), m_parent( parent ), m_row( row ), m_dataDone( false ), m_childItemsDone( false ), m_childItemsRequested( false )
 			{
 			}
 
@@ -600,30 +733,70 @@ class PathModel : public QAbstractItemModel
 				}
 			}
 
-			std::vector<Item *> &childItems( const PathModel *model )
+			// Returns the child items. Unless `wait` is true, these
+			// are computed in the background, and an empty list is returned
+			// until setChildItems() is called with the result.
+			std::vector<Item *> &childItems( const PathModel *model, bool wait = false )
 			{
-				if( !m_childItemsDone && m_path )
+				if( m_childItemsDone )
+				{
+					return m_childItems;
+				}
+
+				if( !m_path )
+				{
+					m_childItemsDone = true;
+				}
+				else if( wait )
 				{
 					std::vector<Gaffer::PathPtr> children;
-					try
-					{
-						m_path->children( children );
-					}
-					catch( const std::exception &e )
-					{
-						IECore::msg( IECore::Msg::Error, "PathListingWidget", e.what() );
-					}
+					PathModel::computeChildren( m_path.get(), children );
+					setChildItems( const_cast<PathModel *>( model ), children );
+				}
+				else if( !m_childItemsRequested )
+				{
+					m_childItemsRequested = true;
+					model->requestChildItems( this );
+				}
 
-					for( std::vector<Gaffer::PathPtr>::const_iterator it = children.begin(), eIt = children.end(); it != eIt; ++it )
-					{
-						m_childItems.push_back( new Item( *it, it - children.begin(), this ) );
-					}
-					// If the model is sorted, then we need to apply that same
-					// sorting to the new items - see comment for PathModel::sort().
-					sort( model );
+				return m_childItems;
+			}
+
+			void setChildItems( PathModel *model, const std::vector<Gaffer::PathPtr> &children )
+			{
+				if( m_childItemsDone )
+				{
+					// Already computed by a call to `childItems( model, true )`
+					// while the background task was running.
+					return;
 				}
+
 				m_childItemsDone = true;
-				return m_childItems;
+				if( children.empty() )
+				{
+					return;
+				}
+
+				// The view only knows about our rows if we're the root, or the model
+				// is a tree. Otherwise there's nobody to notify.
+				const bool notify = !m_parent || !model->m_flat;
+				if( notify )
+				{
+					model->beginInsertRows( m_parent ? model->createIndex( m_row, 0, this ) : QModelIndex(), 0, children.size() - 1 );
+				}
+
+				for( std::vector<Gaffer::PathPtr>::const_iterator it = children.begin(), eIt = children.end(); it != eIt; ++it )
+				{
+					m_childItems.push_back( new Item( *it, it - children.begin(), this ) );
+				}
+				// If the model is sorted, then we need to apply that same
+				// sorting to the new items - see comment for PathModel::sort().
+				sort( model );
+
+				if( notify )
+				{
+					model->endInsertRows();
+				}
 			}
 
 			void sort( const PathModel *model )
@@ -766,11 +939,14 @@ class PathModel : public QAbstractItemModel
 				std::vector<QVariant> m_decorationData;
 
 				bool m_childItemsDone;
+				bool m_childItemsRequested;
 				std::vector<Item *> m_childItems;
 
 		};
 
 		Item *m_rootItem;
+		unsigned m_generation;
+		DispatcherPtr m_dispatcher;
 		bool m_flat;
 		std::vector<ColumnPtr> m_columns;
 		int m_sortColumn;
@@ -856,6 +1032,7 @@ list getExpandedPaths( uint64_t treeViewAddress )
 
 void propagateExpandedWalk( QTreeView *treeView, PathModel *model, QModelIndex index, bool expanded, int numLevels )
 {
+	model->waitForChildren( index );
 	for( int i = 0, e = model->rowCount( index ); i < e; ++i )
 	{
 		QModelIndex childIndex = model->index( i, 0, index );
@@ -869,6 +1046,9 @@ void propagateExpandedWalk( QTreeView *treeView, PathModel *model, QModelIndex i
 
 void propagateExpanded( uint64_t treeViewAddress, uint64_t modelIndexAddress, bool expanded, int numLevels )
 {
+	// Children are computed synchronously here, so we release
+	// the GIL in case that ends up calling into python.
+	IECorePython::ScopedGILRelease r;
 	QTreeView *treeView = reinterpret_cast<QTreeView *>( treeViewAddress );
 	PathModel *model = dynamic_cast<PathModel *>( treeView->model() );
 	if( !model )
@@ -54,5 +54,7 @@ void GafferUIBindings::bindStandardGraphLayout()
 		.def( "getConnectionScale", &StandardGraphLayout::getConnectionScale )
 		.def( "setNodeSeparationScale", &StandardGraphLayout::setNodeSeparationScale )
 		.def( "getNodeSeparationScale", &StandardGraphLayout::getNodeSeparationScale )
+		.def( "setLayeredLayout", &StandardGraphLayout::setLayeredLayout )
+		.def( "getLayeredLayout", &StandardGraphLayout::getLayeredLayout )
 	;
 }
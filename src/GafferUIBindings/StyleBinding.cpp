@@ -74,6 +74,8 @@ void GafferUIBindings::bindStyle()
 		.def( "textBound", &Style::textBound )
 		.def( "renderText", &Style::renderText )
 		.def( "renderWrappedText", &Style::renderWrappedText )
+		.def( "beginTextBatch", &Style::beginTextBatch )
+		.def( "endTextBatch", &Style::endTextBatch )
 
 		.def( "renderFrame", &Style::renderFrame )
 		.def( "renderSelectionBox", &Style::renderSelectionBox )
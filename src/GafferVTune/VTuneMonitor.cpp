@@ -0,0 +1,221 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2017, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//      * Redistributions of source code must retain the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer.
+//
+//      * Redistributions in binary form must reproduce the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer in the documentation and/or other materials provided with
+//        the distribution.
+//
+//      * Neither the name of John Haddon nor the names of
+//        any other contributors to this software may be used to endorse or
+//        promote products derived from this software without specific prior
+//        written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#include "ittnotify.h"
+
+#include "tbb/concurrent_hash_map.h"
+
+#include "boost/lexical_cast.hpp"
+
+#include "IECore/SimpleTypedData.h"
+#include "IECore/VectorTypedData.h"
+
+#include "Gaffer/Context.h"
+#include "Gaffer/Node.h"
+#include "Gaffer/Plug.h"
+#include "Gaffer/Process.h"
+
+#include "GafferVTune/VTuneMonitor.h"
+
+using namespace std;
+using namespace IECore;
+using namespace Gaffer;
+using namespace GafferVTune;
+
+//////////////////////////////////////////////////////////////////////////
+// Internal utilities
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+__itt_domain *domain()
+{
+	static __itt_domain *g_domain = __itt_domain_create( "org.gafferhq.gaffer" );
+	return g_domain;
+}
+
+// ITT string handles are never freed, and creating them involves a lock,
+// so we keep our own cache keyed by the string.
+typedef tbb::concurrent_hash_map<string, __itt_string_handle *> StringHandles;
+StringHandles g_stringHandles;
+
+__itt_string_handle *stringHandle( const string &s )
+{
+	{
+		StringHandles::const_accessor readAccessor;
+		if( g_stringHandles.find( readAccessor, s ) )
+		{
+			return readAccessor->second;
+		}
+	}
+
+	StringHandles::accessor writeAccessor;
+	if( g_stringHandles.insert( writeAccessor, s ) )
+	{
+		writeAccessor->second = __itt_string_handle_create( s.c_str() );
+	}
+	return writeAccessor->second;
+}
+
+const InternedString g_computeProcessType( "computeNode:compute" );
+
+string valueString( const Data *data )
+{
+	switch( data->typeId() )
+	{
+		case StringDataTypeId :
+			return static_cast<const StringData *>( data )->readable();
+		case InternedStringDataTypeId :
+			return static_cast<const InternedStringData *>( data )->readable().string();
+		case FloatDataTypeId :
+			return boost::lexical_cast<string>( static_cast<const FloatData *>( data )->readable() );
+		case IntDataTypeId :
+			return boost::lexical_cast<string>( static_cast<const IntData *>( data )->readable() );
+		case V2iDataTypeId :
+		{
+			const Imath::V2i &v = static_cast<const V2iData *>( data )->readable();
+			return boost::lexical_cast<string>( v.x ) + " " + boost::lexical_cast<string>( v.y );
+		}
+		case InternedStringVectorDataTypeId :
+		{
+			// Format paths as in ScenePlug::pathToString(), without
+			// depending on GafferScene.
+			const vector<InternedString> &path = static_cast<const InternedStringVectorData *>( data )->readable();
+			if( path.empty() )
+			{
+				return "/";
+			}
+			string result;
+			for( vector<InternedString>::const_iterator it = path.begin(), eIt = path.end(); it != eIt; ++it )
+			{
+				result += "/" + it->string();
+			}
+			return result;
+		}
+		default :
+			return data->typeName();
+	}
+}
+
+} // namespace
+
+//////////////////////////////////////////////////////////////////////////
+// VTuneMonitor
+//////////////////////////////////////////////////////////////////////////
+
+VTuneMonitor::VTuneMonitor( bool computeOnly, const std::vector<IECore::InternedString> &variableNames )
+	:	m_computeOnly( computeOnly ), m_variableNames( variableNames )
+{
+}
+
+VTuneMonitor::~VTuneMonitor()
+{
+}
+
+bool VTuneMonitor::getComputeOnly() const
+{
+	return m_computeOnly;
+}
+
+const std::vector<IECore::InternedString> &VTuneMonitor::variableNames() const
+{
+	return m_variableNames;
+}
+
+const std::vector<IECore::InternedString> &VTuneMonitor::defaultVariableNames()
+{
+	static std::vector<IECore::InternedString> g_names;
+	if( g_names.empty() )
+	{
+		g_names.push_back( "frame" );
+		g_names.push_back( "scene:path" );
+		g_names.push_back( "image:channelName" );
+		g_names.push_back( "image:tileOrigin" );
+	}
+	return g_names;
+}
+
+bool VTuneMonitor::monitored( const Gaffer::Process *process ) const
+{
+	// The domain flags are only set while a collector is attached
+	// and recording.
+	if( !domain()->flags )
+	{
+		return false;
+	}
+	return !m_computeOnly || process->type() == g_computeProcessType;
+}
+
+void VTuneMonitor::processStarted( const Gaffer::Process *process )
+{
+	if( !monitored( process ) )
+	{
+		return;
+	}
+
+	const Plug *plug = process->plug();
+	const Node *node = plug->node();
+
+	__itt_domain *d = domain();
+	__itt_task_begin(
+		d, __itt_null, __itt_null,
+		stringHandle( process->type().string() + " : " + ( node ? node->typeName() : plug->typeName() ) )
+	);
+
+	const string plugName = plug->fullName();
+	__itt_metadata_str_add( d, __itt_null, stringHandle( "plug" ), plugName.c_str(), plugName.size() );
+
+	const Context *context = Context::current();
+	for( vector<InternedString>::const_iterator it = m_variableNames.begin(), eIt = m_variableNames.end(); it != eIt; ++it )
+	{
+		if( const Data *data = context->get<Data>( *it, NULL ) )
+		{
+			const string value = valueString( data );
+			__itt_metadata_str_add( d, __itt_null, stringHandle( it->string() ), value.c_str(), value.size() );
+		}
+	}
+}
+
+void VTuneMonitor::processFinished( const Gaffer::Process *process )
+{
+	if( !monitored( process ) )
+	{
+		return;
+	}
+
+	__itt_task_end( domain() );
+}
@@ -0,0 +1,88 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2017, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//      * Redistributions of source code must retain the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer.
+//
+//      * Redistributions in binary form must reproduce the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer in the documentation and/or other materials provided with
+//        the distribution.
+//
+//      * Neither the name of John Haddon nor the names of
+//        any other contributors to this software may be used to endorse or
+//        promote products derived from this software without specific prior
+//        written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#include "boost/python.hpp"
+#include "boost/python/suite/indexing/container_utils.hpp"
+
+#include "GafferVTune/VTuneMonitor.h"
+
+using namespace boost::python;
+using namespace GafferVTune;
+
+namespace
+{
+
+VTuneMonitor *vtuneMonitorConstructor( bool computeOnly, object pythonVariableNames )
+{
+	if( pythonVariableNames == object() )
+	{
+		return new VTuneMonitor( computeOnly );
+	}
+
+	std::vector<std::string> names;
+	boost::python::container_utils::extend_container( names, pythonVariableNames );
+	std::vector<IECore::InternedString> variableNames( names.begin(), names.end() );
+	return new VTuneMonitor( computeOnly, variableNames );
+}
+
+list variableNames( const VTuneMonitor &m )
+{
+	list result;
+	for( std::vector<IECore::InternedString>::const_iterator it = m.variableNames().begin(), eIt = m.variableNames().end(); it != eIt; ++it )
+	{
+		result.append( it->string() );
+	}
+	return result;
+}
+
+} // namespace
+
+BOOST_PYTHON_MODULE( _GafferVTune )
+{
+
+	class_<VTuneMonitor, bases<Gaffer::Monitor>, boost::noncopyable>( "VTuneMonitor", no_init )
+		.def( "__init__", make_constructor( vtuneMonitorConstructor, default_call_policies(),
+				(
+					arg( "computeOnly" ) = false,
+					arg( "variableNames" ) = object()
+				)
+			)
+		)
+		.def( "getComputeOnly", &VTuneMonitor::getComputeOnly )
+		.def( "variableNames", &variableNames )
+	;
+
+}
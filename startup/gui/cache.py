@@ -35,8 +35,13 @@
 #
 ##########################################################################
 
+import IECoreGL
+
 import Gaffer
 import GafferImage
+import GafferUI
+
+QtCore = GafferUI._qtImport( "QtCore" )
 
 # add plugs to the preferences node
 
@@ -45,6 +50,11 @@ preferences["cache"] = Gaffer.CompoundPlug()
 preferences["cache"]["enabled"] = Gaffer.BoolPlug( defaultValue = True )
 preferences["cache"]["memoryLimit"] = Gaffer.IntPlug( defaultValue = Gaffer.ValuePlug.getCacheMemoryLimit() / ( 1024 * 1024 ) )
 preferences["cache"]["imageReaderMemoryLimit"] = Gaffer.IntPlug( defaultValue = GafferImage.OpenImageIOReader.getCacheMemoryLimit() / ( 1024 * 1024 ) )
+preferences["cache"]["viewerMemoryLimit"] = Gaffer.IntPlug( defaultValue = IECoreGL.CachedConverter.defaultCachedConverter().getMaxMemory() / ( 1024 * 1024 ) )
+preferences["cache"]["totalMemoryLimit"] = Gaffer.IntPlug( defaultValue = 0, minValue = 0 )
+preferences["cache"]["memoryPriority"] = Gaffer.FloatPlug( defaultValue = Gaffer.MemoryGovernor.getPriority( "computeCache" ), minValue = 0 )
+preferences["cache"]["imageReaderMemoryPriority"] = Gaffer.FloatPlug( defaultValue = Gaffer.MemoryGovernor.getPriority( "imageReaderCache" ), minValue = 0 )
+preferences["cache"]["viewerMemoryPriority"] = Gaffer.FloatPlug( defaultValue = 1, minValue = 0 )
 
 Gaffer.Metadata.registerPlugValue(
 	preferences["cache"]["memoryLimit"],
@@ -64,6 +74,60 @@ Gaffer.Metadata.registerPlugValue(
 	persistent = False
 )
 
+Gaffer.Metadata.registerPlugValue(
+	preferences["cache"]["viewerMemoryLimit"],
+	"description",
+	"""
+	Controls the memory limit for the cache of OpenGL geometry
+	that the Viewer draws. This isn't affected by the enabled setting,
+	because without it the Viewer must convert every object again
+	each time the scene is updated.
+	""",
+	persistent = False
+)
+
+Gaffer.Metadata.registerPlugValue(
+	preferences["cache"]["totalMemoryLimit"],
+	"description",
+	"""
+	When non-zero, the individual memory limits above are ignored,
+	and this total budget is divided between all the caches according
+	to their priorities below. The caches are trimmed automatically
+	if the rest of Gaffer comes under memory pressure.
+	""",
+	persistent = False
+)
+
+for name in ( "memoryPriority", "imageReaderMemoryPriority", "viewerMemoryPriority" ) :
+	Gaffer.Metadata.registerPlugValue(
+		preferences["cache"][name],
+		"description",
+		"""
+		The relative share of the total memory limit given to
+		this cache. Only used when the total memory limit is
+		non-zero.
+		""",
+		persistent = False
+	)
+
+# The viewer cache is in IECoreGL, which doesn't provide
+# a measure of its usage, so we assume that it is full.
+
+__viewerCache = IECoreGL.CachedConverter.defaultCachedConverter()
+Gaffer.MemoryGovernor.registerCache(
+	"viewerCache",
+	__viewerCache.getMaxMemory,
+	__viewerCache.setMaxMemory,
+	preferences["cache"]["viewerMemoryPriority"].getValue()
+)
+
+# Update the governor periodically, so that it can respond
+# to memory pressure.
+
+__governorTimer = QtCore.QTimer()
+__governorTimer.setInterval( 2000 )
+__governorTimer.timeout.connect( Gaffer.MemoryGovernor.update )
+
 # update cache settings when they change
 
 def __plugSet( plug ) :
@@ -77,7 +141,21 @@ def __plugSet( plug ) :
 		memoryLimit = 0
 		imageReaderMemoryLimit = 0
 
+	totalMemoryLimit = plug["totalMemoryLimit"].getValue() * 1024 * 1024
+	if totalMemoryLimit and plug["enabled"].getValue() :
+		Gaffer.MemoryGovernor.setPriority( "computeCache", plug["memoryPriority"].getValue() )
+		Gaffer.MemoryGovernor.setPriority( "imageReaderCache", plug["imageReaderMemoryPriority"].getValue() )
+		Gaffer.MemoryGovernor.setPriority( "viewerCache", plug["viewerMemoryPriority"].getValue() )
+		Gaffer.MemoryGovernor.setMemoryLimit( totalMemoryLimit )
+		Gaffer.MemoryGovernor.update()
+		__governorTimer.start()
+		return
+
+	__governorTimer.stop()
+	Gaffer.MemoryGovernor.setMemoryLimit( 0 )
+
 	Gaffer.ValuePlug.setCacheMemoryLimit( memoryLimit )
 	GafferImage.OpenImageIOReader.setCacheMemoryLimit( imageReaderMemoryLimit )
+	IECoreGL.CachedConverter.defaultCachedConverter().setMaxMemory( plug["viewerMemoryLimit"].getValue() * 1024 * 1024 )
 
 preferences.plugSetSignal().connect( __plugSet, scoped = False )